@@ -182,6 +182,33 @@ public:
   /// Override if the algorithm is not part of the Mantid distribution.
   const std::string helpURL() const override { return ""; }
 
+  /// function to return whether the algorithm may run at the same time as
+  /// other algorithms, e.g. in a DataflowExecutor. A default implementation is
+  /// provided. Override if the algorithm uses a library that is not thread safe.
+  virtual bool threadSafe() const { return true; }
+
+  /// function to return whether the base processGroups() may run the
+  /// algorithm on the members of a group concurrently. A default
+  /// implementation is provided. Override if separate instances of a thread
+  /// safe algorithm can process different members at the same time.
+  virtual bool canProcessGroupsConcurrently() const { return false; }
+
+  /// function to return whether the outputs of the algorithm depend only on
+  /// its inputs, so that they may be taken from the result cache. A default
+  /// implementation is provided. Override if the algorithm is expensive,
+  /// deterministic and has no side effects.
+  virtual bool cacheable() const { return false; }
+
+  /// function to return the names of an input and an output workspace
+  /// property that may refer to the same workspace, so that a child algorithm
+  /// given the only reference to its input modifies it rather than a copy. A
+  /// default implementation is provided. Override if the algorithm handles its
+  /// output being its input for the current property values.
+  virtual std::pair<std::string, std::string>
+  inPlaceWorkspaceProperties() const {
+    return {};
+  }
+
   template <typename T, typename = typename std::enable_if<std::is_convertible<
                             T *, MatrixWorkspace *>::value>::type>
   std::tuple<boost::shared_ptr<T>, Indexing::SpectrumIndexSet>
@@ -415,6 +442,7 @@ private:
                             IndexType type, const T2 &list);
   void lockWorkspaces();
   void unlockWorkspaces();
+  void setUpInPlaceExecution();
 
   void linkHistoryWithLastChild();
 
@@ -426,6 +454,15 @@ private:
 
   bool doCallProcessGroups(Mantid::Types::Core::DateAndTime &start_time);
 
+  boost::shared_ptr<Algorithm>
+  createGroupMemberAlgorithm(size_t entry, bool reportProgress,
+                             std::vector<std::string> &outputWSNames);
+  void executeGroupMember(IAlgorithm &alg, size_t entry) const;
+  size_t groupConcurrency() const;
+  void executeGroupMembersConcurrently(
+      const std::vector<boost::shared_ptr<Algorithm>> &algorithms,
+      size_t nthreads);
+
   void fillHistory(const std::vector<Workspace_sptr> &outputWorkspaces);
 
   // Report that the algorithm has completed.
@@ -10,9 +10,12 @@
 //----------------------------------------------------------------------
 // Includes
 //----------------------------------------------------------------------
+#include "MantidAPI/DeferredLibraries.h"
 #include "MantidAPI/DllConfig.h"
 #include "MantidKernel/DynamicFactory.h"
 #include "MantidKernel/SingletonHolder.h"
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <unordered_set>
 #include <vector>
@@ -29,6 +32,22 @@ struct AlgorithmDescriptor {
   std::string alias;    ///< alias
 };
 
+/// What is known of an algorithm before the library registering it is
+/// opened, recorded in the plugin manifest so that the Python simple API can
+/// wrap it without creating it
+struct DeferredAlgorithm {
+  /// Algorithm name
+  std::string name;
+  /// Aliases of the highest version
+  std::string alias;
+  /// Name of the method it adds to workspaces, if any
+  std::string workspaceMethodName;
+  /// Workspace types that have the method
+  std::vector<std::string> workspaceMethodOn;
+  /// Property the workspace calling the method is passed to
+  std::string workspaceMethodInputProperty;
+};
+
 //----------------------------------------------------------------------
 // Forward declarations
 //----------------------------------------------------------------------
@@ -75,9 +94,10 @@ public:
     boost::shared_ptr<IAlgorithm> tempAlg = instantiator->createInstance();
     const int version = extractAlgVersion(tempAlg);
     const std::string className = extractAlgName(tempAlg);
-    typename VersionMap::const_iterator it = m_vmap.find(className);
     if (!className.empty()) {
       const std::string key = createName(className, version);
+      std::lock_guard<std::mutex> lock(m_vmapMutex);
+      typename VersionMap::const_iterator it = m_vmap.find(className);
       if (it == m_vmap.end()) {
         m_vmap[className] = version;
       } else {
@@ -100,6 +120,11 @@ public:
     }
     return std::make_pair(className, version);
   }
+  /// Record an unopened library that registers the algorithm
+  void subscribeDeferred(const DeferredAlgorithm &algorithm,
+                         const std::string &library);
+  /// The algorithms whose libraries have not been opened yet
+  std::vector<DeferredAlgorithm> getDeferredAlgorithms() const;
   /// Unsubscribe the given algorithm
   void unsubscribe(const std::string &algorithmName, const int version);
   /// Does an algorithm of the given name and version exist
@@ -108,6 +133,8 @@ public:
   /// Get the algorithm names and version - mangled use decodeName to separate
   const std::vector<std::string> getKeys() const override;
   const std::vector<std::string> getKeys(bool includeHidden) const;
+  const std::vector<std::string> getKeys(bool includeHidden,
+                                         bool openDeferred) const;
 
   /// Returns the highest version of the algorithm currently registered
   int highestVersion(const std::string &algorithmName) const;
@@ -135,6 +162,8 @@ private:
   /// Extract the version of an algorithm
   int extractAlgVersion(const boost::shared_ptr<IAlgorithm> alg) const;
 
+  /// Look up the highest registered version of an algorithm
+  bool latestVersion(const std::string &algorithmName, int &version) const;
   /// Create an algorithm object with the specified name
   boost::shared_ptr<Algorithm> createAlgorithm(const std::string &name,
                                                const int version) const;
@@ -152,6 +181,12 @@ private:
   using VersionMap = std::map<std::string, int>;
   /// The map holding the registered class names and their highest versions
   VersionMap m_vmap;
+  /// Deferred algorithms keyed by name
+  std::map<std::string, DeferredAlgorithm> m_deferredAlgorithms;
+  /// Guards the map of versions and of deferred algorithms
+  mutable std::mutex m_vmapMutex;
+  /// Libraries to open when the algorithms they register are looked up
+  mutable DeferredLibraries m_deferred;
 };
 
 using AlgorithmFactory = Mantid::Kernel::SingletonHolder<AlgorithmFactoryImpl>;
@@ -18,6 +18,7 @@
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
 #include <ctime>
+#include <map>
 #include <set>
 #include <vector>
 
@@ -31,12 +32,19 @@ class AlgorithmHistory;
 using AlgorithmHistory_sptr = boost::shared_ptr<AlgorithmHistory>;
 using AlgorithmHistory_const_sptr = boost::shared_ptr<const AlgorithmHistory>;
 using AlgorithmHistories = std::vector<AlgorithmHistory_sptr>;
+/// The algorithm history groups written to a NeXus file, keyed by the uuid
+/// of their history, with the name of the group and a link to it
+using AlgorithmHistoryNexusLinks =
+    std::map<std::string, std::pair<std::string, NXlink>>;
 
 /** @class AlgorithmHistory AlgorithmHistory.h API/MAntidAPI/AlgorithmHistory.h
 
     This class stores information about the Command History used by algorithms
    on a workspace.
 
+    A history is shared by every workspace descending from the execution it
+   records and must not be changed once it has been added to a workspace.
+
     @author Dickon Champion, ISIS, RAL
     @date 21/01/2008
     */
@@ -114,7 +122,8 @@ public:
   /// Create an child algorithm from a history record at a given index
   boost::shared_ptr<IAlgorithm> getChildAlgorithm(const size_t index) const;
   /// Write this history object to a nexus file
-  void saveNexus(::NeXus::File *file, int &algCount) const;
+  void saveNexus(::NeXus::File *file, int &algCount,
+                 AlgorithmHistoryNexusLinks *links = nullptr) const;
   // Set the execution count
   void setExecCount(std::size_t execCount) { m_execCount = execCount; }
   /// Set data on history after it is created
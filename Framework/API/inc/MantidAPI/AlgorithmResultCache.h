@@ -0,0 +1,59 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_API_ALGORITHMRESULTCACHE_H_
+#define MANTID_API_ALGORITHMRESULTCACHE_H_
+
+#include "MantidAPI/DllConfig.h"
+
+#include <cstdint>
+#include <string>
+
+namespace Mantid {
+namespace API {
+class Algorithm;
+class Workspace;
+
+/** AlgorithmResultCache keeps the outputs of algorithm executions in a
+  directory on disk so that an execution with the same inputs can take them
+  from there instead of running again.
+
+  An execution is keyed by the name and version of the algorithm, the values
+  of its input properties and a hash of the contents of its input workspaces.
+  Each entry is a subdirectory named by the key holding the output
+  workspaces in the NeXus processed format and the values of any other
+  output properties. When the entries take more than the size limit the
+  least recently used are removed.
+
+  Only algorithms that declare themselves Algorithm::cacheable() are keyed.
+  Executions with in/out workspaces, or with inputs or outputs whose contents
+  can not be hashed or saved, are never cached.
+*/
+class MANTID_API_DLL AlgorithmResultCache {
+public:
+  AlgorithmResultCache(const std::string &directory, uint64_t maxSize);
+
+  static std::string key(const Algorithm &alg);
+  static std::string contentHash(const Workspace &workspace);
+
+  bool restore(Algorithm &alg, const std::string &key) const;
+  bool store(const Algorithm &alg, const std::string &key) const;
+  uint64_t size() const;
+
+private:
+  void evict() const;
+  std::string entryPath(const std::string &key) const;
+
+  /// The directory holding the entries
+  std::string m_directory;
+  /// The size in bytes the entries may take
+  uint64_t m_maxSize;
+};
+
+} // namespace API
+} // namespace Mantid
+
+#endif /* MANTID_API_ALGORITHMRESULTCACHE_H_ */
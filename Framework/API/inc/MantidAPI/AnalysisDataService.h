@@ -12,11 +12,14 @@
 //----------------------------------------------------------------------
 #include "MantidAPI/DllConfig.h"
 #include "MantidAPI/Workspace.h"
+#include "MantidAPI/WorkspaceMemoryLedger.h"
 #include "MantidKernel/DataService.h"
 #include "MantidKernel/SingletonHolder.h"
 
 #include <Poco/AutoPtr.h>
 
+#include <mutex>
+
 namespace Mantid {
 
 namespace API {
@@ -98,6 +101,8 @@ public:
   /// workspace object is added to the service
   void add(const std::string &name,
            const boost::shared_ptr<API::Workspace> &workspace) override;
+  /// Overridden addBatch member to attach the names to the workspaces
+  void addBatch(const std::vector<NamedObject> &workspaces) override;
   /// Overridden addOrReplace member to attach the name to the workspace when
   /// a workspace object is added to the service
   void
@@ -108,6 +113,17 @@ public:
   virtual void rename(const std::string &oldName, const std::string &newName);
   /// Overridden remove member to delete its name held by the workspace itself
   virtual void remove(const std::string &name);
+  /// Overridden removeBatch member to delete the names held by the workspaces
+  void removeBatch(const std::vector<std::string> &names) override;
+  /// Overridden retrieve member to reload a workspace that has been spilled
+  Workspace_sptr retrieve(const std::string &name) const override;
+  /// Overridden getObjects member to reload the workspaces that have been
+  /// spilled
+  std::vector<Workspace_sptr>
+  getObjects(Kernel::DataServiceHidden includeHidden =
+                 Kernel::DataServiceHidden::Auto) const override;
+  /// Overridden clear member to reset the memory ledger
+  void clear() override;
 
   /** Retrieve a workspace and cast it to the given WSTYPE
    *
@@ -121,8 +137,7 @@ public:
     // Get as a bare workspace
     try {
       // Cast to the desired type and return that.
-      return boost::dynamic_pointer_cast<WSTYPE>(
-          Kernel::DataService<API::Workspace>::retrieve(name));
+      return boost::dynamic_pointer_cast<WSTYPE>(retrieve(name));
 
     } catch (Kernel::Exception::NotFoundError &) {
       throw;
@@ -141,13 +156,40 @@ public:
   void removeFromGroup(const std::string &groupName, const std::string &wsName);
   //@}
 
-  /// Return a lookup of the top level items
+  /// Return a lookup of the top level items. Workspaces spilled to disk are
+  /// not reloaded: they are represented by a stand-in holding their name,
+  /// type and title until they are retrieved.
   std::map<std::string, Workspace_sptr> topLevelItems() const;
   void shutdown() override;
 
+  /** @name Memory accounting */
+  //@{
+  void setMemoryBudget(size_t bytes);
+  size_t memoryBudget() const;
+  const WorkspaceMemoryLedger &memoryLedger() const;
+  //@}
+
 private:
   /// Checks the name is valid, throwing if not
   void verifyName(const std::string &name);
+  /// Add the members of a group that are not yet in the service
+  void addGroupMembers(const std::string &name, WorkspaceGroup &group);
+  /// Record a workspace in the ledger and keep within the memory budget
+  void account(const std::string &name, const Workspace_sptr &workspace);
+  /// Refresh the ledger entries of the workspaces held in memory
+  void refreshMemoryLedger();
+  /// Spill least recently used workspaces until within the memory budget
+  void enforceMemoryBudget(const std::string &keep);
+  /// Write a workspace to a scratch file and release it from memory
+  bool spill(const std::string &name, const Workspace_sptr &workspace);
+  /// Load a spilled workspace back into memory
+  Workspace_sptr reload(const std::string &name);
+  /// Is the workspace a placeholder for one spilled to disk
+  static bool isSpilledPlaceholder(const Workspace_sptr &workspace);
+  /// Load the workspace a placeholder stands in for
+  Workspace_sptr resolve(const Workspace_sptr &placeholder) const;
+  /// Delete the scratch file of a spilled workspace
+  void discardSpillFile(const std::string &name);
 
   friend struct Mantid::Kernel::CreateUsingNew<AnalysisDataServiceImpl>;
   /// Constructor
@@ -161,6 +203,12 @@ private:
 
   /// The string of illegal characters
   std::string m_illegalChars;
+  /// Account of the memory held by each workspace
+  mutable WorkspaceMemoryLedger m_memoryLedger;
+  /// Memory in bytes the workspaces may hold before spilling. 0 is unlimited
+  size_t m_memoryBudget;
+  /// Serializes spilling and reloading of workspaces
+  mutable std::recursive_mutex m_spillMutex;
 };
 
 using AnalysisDataService =
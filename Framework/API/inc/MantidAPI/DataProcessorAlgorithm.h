@@ -20,6 +20,8 @@
 
 namespace Mantid {
 namespace API {
+class DataflowExecutor;
+
 /**
 
    Data processor algorithm to be used as a parent to workflow algorithms.
@@ -64,6 +66,7 @@ protected:
                  const std::string &outputFile);
   bool isMainThread();
   int getNThreads();
+  void executeDataflow(DataflowExecutor &graph);
 
   /// Divide a matrix workspace by another matrix workspace
   MatrixWorkspace_sptr divide(const MatrixWorkspace_sptr lhs,
@@ -0,0 +1,97 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_API_DATAFLOWEXECUTOR_H_
+#define MANTID_API_DATAFLOWEXECUTOR_H_
+
+#include "MantidAPI/DllConfig.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+class Algorithm;
+
+/** DataflowExecutor runs a set of configured algorithms as a directed
+  acyclic graph, executing independent branches concurrently.
+
+  Dependencies come from two sources:
+  - explicit connections, which pass the workspace in an output property of
+    one algorithm to an input property of another once the first has run.
+    This is how the outputs of child algorithms are passed on.
+  - workspace names (or workspace objects) shared by the workspace properties
+    of the algorithms. These order the algorithms as if they were run one
+    after another in the order they were added, e.g. an algorithm reading a
+    workspace waits for the algorithm writing it.
+
+  Algorithms that are not thread safe, see Algorithm::threadSafe(), or that
+  are given workspaces that are not thread safe, never run at the same time as
+  each other but may run alongside thread-safe ones.
+
+  If an algorithm fails the algorithms depending on it are not run, the ones
+  already running are allowed to finish and the first error is rethrown.
+  After a successful run the durations of the algorithms and the critical
+  path through the graph are available.
+*/
+class MANTID_API_DLL DataflowExecutor {
+public:
+  /// Identifies an algorithm in the graph
+  using NodeId = size_t;
+
+  NodeId add(const boost::shared_ptr<Algorithm> &algorithm);
+  void connect(NodeId producer, const std::string &outputProperty,
+               NodeId consumer, const std::string &inputProperty);
+  void addDependency(NodeId node, NodeId prerequisite);
+
+  void execute(int maxThreads = 0);
+
+  /// @return The number of algorithms in the graph
+  size_t size() const { return m_nodes.size(); }
+  const boost::shared_ptr<Algorithm> &algorithm(NodeId node) const;
+  double duration(NodeId node) const;
+  std::vector<NodeId> criticalPath() const;
+  double criticalPathDuration() const;
+  std::string criticalPathReport() const;
+
+private:
+  /// A workspace passed from one algorithm to another
+  struct Connection {
+    NodeId producer;
+    std::string outputProperty;
+    std::string inputProperty;
+  };
+  /// An algorithm and its place in the graph
+  struct Node {
+    boost::shared_ptr<Algorithm> algorithm;
+    std::vector<Connection> inputs;
+    std::vector<NodeId> prerequisites;
+    std::vector<NodeId> dependents;
+    /// Prerequisites that have not finished yet
+    size_t pending = 0;
+    bool threadSafe = true;
+    /// Wall clock run time in seconds
+    double duration = 0.;
+  };
+
+  void addEdge(NodeId from, NodeId to);
+  void inferEdges();
+  std::vector<NodeId> topologicalOrder() const;
+  void prepare(Node &node);
+  void checkNode(NodeId node) const;
+
+  std::vector<Node> m_nodes;
+  /// The order the algorithms can be run in sequentially
+  std::vector<NodeId> m_order;
+  bool m_executed = false;
+};
+
+} // namespace API
+} // namespace Mantid
+
+#endif /* MANTID_API_DATAFLOWEXECUTOR_H_ */
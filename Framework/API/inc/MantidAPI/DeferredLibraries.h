@@ -0,0 +1,51 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_API_DEFERREDLIBRARIES_H_
+#define MANTID_API_DEFERREDLIBRARIES_H_
+
+#include "MantidAPI/DllConfig.h"
+#include "MantidKernel/CaseInsensitiveMap.h"
+
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+
+/** DeferredLibraries tracks plugin libraries that have not been opened yet
+  but are known, from the plugin manifest, to register a given name with a
+  factory. The factory asks for the libraries providing a name to be opened
+  the first time the name is looked up and is not registered.
+
+  Names are compared case insensitively. The opening of deferred libraries
+  is serialised across all factories and each library is opened once. The
+  factories guard their own registrations so lookups of other names can
+  proceed while a library registers.
+*/
+class MANTID_API_DLL DeferredLibraries {
+public:
+  void add(const std::string &name, const std::string &library);
+  bool open(const std::string &name);
+  bool openAll();
+  bool empty() const;
+  std::vector<std::string> names() const;
+
+private:
+  bool isDeferred(const std::string &name) const;
+  bool openLibraries(const std::set<std::string> &libraries) const;
+
+  /// Unopened libraries keyed by a name they register
+  Kernel::CaseInsensitiveMap<std::set<std::string>> m_libraries;
+  mutable std::mutex m_mutex;
+};
+
+} // namespace API
+} // namespace Mantid
+
+#endif /* MANTID_API_DEFERREDLIBRARIES_H_ */
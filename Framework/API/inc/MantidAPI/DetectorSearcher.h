@@ -24,7 +24,7 @@
   search strategies are used depending on the instrument's geometry.
 
   1) For rectangular detector geometries the InstrumentRayTracer class is used
-  to recursively search the instrument tree.
+  to search a bounding volume hierarchy over all the detectors.
 
   2) For geometries which do not use rectangular detectors ray tracing to every
   component is very expensive. In this case it is quicker to use a
@@ -48,6 +48,9 @@ public:
                    const Geometry::DetectorInfo &detInfo);
   /// Find a detector that intsects with the given Qlab vector
   DetectorSearchResult findDetectorIndex(const Kernel::V3D &q);
+  /// Find the detectors that intersect with each of many Qlab vectors
+  std::vector<DetectorSearchResult>
+  findDetectorIndices(const std::vector<Kernel::V3D> &qs);
 
 private:
   /// Attempt to find a detector using a full instrument ray tracing strategy
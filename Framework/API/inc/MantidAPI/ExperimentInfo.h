@@ -236,6 +236,7 @@ private:
   mutable std::unordered_map<detid_t, size_t> m_det2group;
   void cacheDefaultDetectorGrouping() const; // Not thread-safe
   void invalidateAllSpectrumDefinitions();
+  void invalidateSpectrumGeometry() const;
   mutable std::once_flag m_defaultDetectorGroupingCached;
 
   mutable std::unique_ptr<Beamline::SpectrumInfo> m_spectrumInfo;
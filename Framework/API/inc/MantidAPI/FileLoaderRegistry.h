@@ -8,6 +8,7 @@
 #define MANTID_API_FILELOADERREGISTRY_H_
 
 #include "MantidAPI/AlgorithmFactory.h"
+#include "MantidAPI/DeferredLibraries.h"
 #include "MantidAPI/IFileLoader.h"
 #include "MantidKernel/SingletonHolder.h"
 
@@ -69,6 +70,8 @@ public:
 
   /// Unsubscribe a named algorithm and version from the loader registration
   void unsubscribe(const std::string &name, const int version = -1);
+  /// Record an unopened library that registers file loaders
+  void subscribeDeferred(const std::string &library);
 
   /// Returns the name of an Algorithm that can load the given filename
   const boost::shared_ptr<IAlgorithm>
@@ -125,6 +128,8 @@ private:
   std::vector<std::multimap<std::string, int>> m_names;
   /// Total number of names registered
   size_t m_totalSize;
+  /// Libraries to open before searching for a loader
+  mutable DeferredLibraries m_deferred;
 
   /// Reference to a logger
   mutable Kernel::Logger m_log;
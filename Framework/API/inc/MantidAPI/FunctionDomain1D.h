@@ -12,6 +12,7 @@
 //----------------------------------------------------------------------
 #include "MantidAPI/FunctionDomain.h"
 
+#include <atomic>
 #include <vector>
 
 namespace Mantid {
@@ -47,6 +48,8 @@ public:
   void setPeakRadius(int radius);
   /// Get the peak radius.
   int getPeakRadius() const;
+  /// Check if the values are in ascending order.
+  bool isSorted() const;
 
 protected:
   /// Protected constructor, shouldn't be created directly. Use
@@ -56,6 +59,7 @@ protected:
   void resetData(const double *x, size_t n) {
     m_data = x;
     m_n = n;
+    m_sorted = -1;
   }
 
 private:
@@ -65,6 +69,8 @@ private:
   size_t m_n;
   /// A peak radius that IPeakFunctions should use
   int m_peakRadius;
+  /// 1 if the values are sorted, 0 if not, -1 if not checked yet
+  mutable std::atomic<int> m_sorted;
 };
 
 /**
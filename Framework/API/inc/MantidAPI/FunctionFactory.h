@@ -10,6 +10,7 @@
 //----------------------------------------------------------------------
 // Includes
 //----------------------------------------------------------------------
+#include "MantidAPI/DeferredLibraries.h"
 #include "MantidAPI/DllConfig.h"
 #include "MantidKernel/DynamicFactory.h"
 #include "MantidKernel/SingletonHolder.h"
@@ -56,7 +57,8 @@ public:
 
   /// Query available functions based on the template type
   template <typename FunctionType>
-  const std::vector<std::string> &getFunctionNames() const;
+  const std::vector<std::string> &
+  getFunctionNames(bool openDeferred = true) const;
   /// Get function names that can be used by generic fitting GUIs
   std::vector<std::string> getFunctionNamesGUI() const;
   // Unhide the base class version (to satisfy the intel compiler)
@@ -67,6 +69,13 @@ public:
                      ErrorIfExists);
 
   void unsubscribe(const std::string &className);
+  /// Record an unopened library that registers the named function
+  void subscribeDeferred(const std::string &className,
+                         const std::string &library);
+  /// The names of the functions whose libraries have not been opened yet
+  std::vector<std::string> getDeferredFunctionNames() const;
+  /// Get the names of all functions, opening any deferred libraries
+  const std::vector<std::string> getKeys() const override;
 
 private:
   friend struct Mantid::Kernel::CreateUsingNew<FunctionFactoryImpl>;
@@ -107,15 +116,25 @@ private:
 
   mutable std::map<std::string, std::vector<std::string>> m_cachedFunctionNames;
   mutable std::mutex m_mutex;
+  /// Libraries to open when the functions they register are looked up
+  mutable DeferredLibraries m_deferred;
 };
 
 /**
  * Query available functions based on the template type
  * @tparam FunctionType :: The type of the functions to list
+ * @param openDeferred :: If false the functions of the libraries not opened
+ * yet are left out, see getDeferredFunctionNames
  * @returns A vector of the names of the functions matching the template type
  */
 template <typename FunctionType>
-const std::vector<std::string> &FunctionFactoryImpl::getFunctionNames() const {
+const std::vector<std::string> &
+FunctionFactoryImpl::getFunctionNames(bool openDeferred) const {
+  // Opening libraries subscribes functions and clears the cache so it must
+  // happen before the cache is used. The cache only ever holds the functions
+  // registered so far.
+  if (openDeferred)
+    m_deferred.openAll();
   std::lock_guard<std::mutex> _lock(m_mutex);
 
   const std::string soughtType(typeid(FunctionType).name());
@@ -125,7 +144,8 @@ const std::vector<std::string> &FunctionFactoryImpl::getFunctionNames() const {
 
   // Create the entry in the cache and work with it directly
   std::vector<std::string> &typeNames = m_cachedFunctionNames[soughtType];
-  const std::vector<std::string> names = this->getKeys();
+  const std::vector<std::string> names =
+      Kernel::DynamicFactory<IFunction>::getKeys();
   std::copy_if(names.cbegin(), names.cend(), std::back_inserter(typeNames),
                [this](const std::string &name) {
                  boost::shared_ptr<IFunction> func = this->createFunction(name);
@@ -11,6 +11,8 @@
 #include "MantidKernel/FileDescriptor.h"
 #include "MantidKernel/NexusDescriptor.h"
 
+#include <type_traits>
+
 namespace Mantid {
 namespace API {
 
@@ -27,6 +29,10 @@ public:
   /// Returns a value indicating whether or not loader wants to load multiple
   /// files into a single workspace
   virtual bool loadMutipleAsOne() { return false; }
+  /// NeXus loaders share the HDF5 library, which is not built thread safe
+  bool threadSafe() const override {
+    return !std::is_same<DescriptorType, Kernel::NexusDescriptor>::value;
+  }
 };
 
 } // namespace API
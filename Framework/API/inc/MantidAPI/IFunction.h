@@ -355,6 +355,9 @@ public:
   /// enogh to store domain.size() values.
   virtual void function(const FunctionDomain &domain,
                         FunctionValues &values) const = 0;
+  /// Adds the function values for all arguments in the domain to values.
+  virtual void functionAdd(const FunctionDomain &domain,
+                           FunctionValues &values) const;
   /// Derivatives of function with respect to active parameters.
   virtual void functionDeriv(const FunctionDomain &domain, Jacobian &jacobian);
 
@@ -56,6 +56,10 @@ public:
   virtual void function1D(double *out, const double *xValues,
                           const size_t nData) const = 0;
 
+  /// Add the function values to out
+  virtual void function1DAdd(double *out, const double *xValues,
+                             const size_t nData) const;
+
   /// Function to calculate the derivatives of the data set
   virtual void derivative1D(double *out, const double *xValues,
                             const size_t nData, const size_t order) const;
@@ -72,6 +76,9 @@ protected:
   template <typename EvaluationMethod>
   void calcNumericalDerivative1D(Jacobian *jacobian, EvaluationMethod func1D,
                                  const double *xValues, const size_t nData);
+  /// Add the function values for a point domain through function1DAdd
+  void functionAdd1D(const FunctionDomain &domain,
+                     FunctionValues &values) const;
   /// Calculate histogram data for the given bin boundaries.
   virtual void histogram1D(double *out, double left, const double *right,
                            const size_t nBins) const;
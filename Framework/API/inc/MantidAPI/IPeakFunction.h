@@ -27,6 +27,10 @@ public:
 
   void function(const FunctionDomain &domain,
                 FunctionValues &values) const override;
+  void functionAdd(const FunctionDomain &domain,
+                   FunctionValues &values) const override;
+  void functionDeriv(const FunctionDomain &domain,
+                     Jacobian &jacobian) override;
 
   /// Returns the peak FWHM
   virtual double fwhm() const = 0;
@@ -44,6 +48,9 @@ public:
   void function1D(double *out, const double *xValues,
                   const size_t nData) const override;
   /// General implementation of the method for all peaks.
+  void function1DAdd(double *out, const double *xValues,
+                     const size_t nData) const override;
+  /// General implementation of the method for all peaks.
   void functionDeriv1D(Jacobian *out, const double *xValues,
                        const size_t nData) override;
 
@@ -78,6 +85,18 @@ public:
         "Generic intensity fixing isn't implemented for this function.");
   }
 
+protected:
+  /// The distance from the centre beyond which the peak is not evaluated
+  virtual double localExtent() const;
+  /// Get the indices [first, last) of the points of a domain that may lie
+  /// within localExtent() of the centre
+  std::pair<size_t, size_t>
+  getLocalRange(const FunctionDomain1D &domain) const;
+  /// Get the indices [first, last) of the points closer than dx to the centre
+  std::pair<size_t, size_t> getLocalRange(const double *xValues,
+                                          const size_t nData,
+                                          double dx) const;
+
 private:
   /// Set new peak radius
   void setPeakRadius(int r) const;
@@ -80,7 +80,7 @@ public:
   // void functionLocal(double* out, const double* xValues, const size_t
   // nData)const;
 
-  /// Calculate function in a range
+  /// Add the function to out within the peak range. xValues are sorted.
   using IFunction1D::function;
   virtual void function(std::vector<double> &out,
                         const std::vector<double> &xValues) const = 0;
@@ -60,6 +60,9 @@ public:
                         std::vector<size_t> &domains) const;
   /// Get number of domains required by this function
   size_t getNumberDomains() const override;
+  /// Get the active parameters the values on each domain depend on
+  std::vector<std::vector<size_t>>
+  getActiveDependencies(size_t nDomains) const;
   /// Create a list of equivalent functions
   std::vector<IFunction_sptr> createEquivalentFunctions() const override;
 
@@ -0,0 +1,92 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_API_PLUGINMANIFEST_H_
+#define MANTID_API_PLUGINMANIFEST_H_
+
+#include "MantidAPI/AlgorithmFactory.h"
+#include "MantidAPI/DllConfig.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+
+/** PluginManifest caches what each plugin library registers with the
+  algorithm and function factories and the file loader registry, so that
+  libraries can be opened on demand rather than all at start up.
+
+  A library seen for the first time, or one whose size or modification time
+  has changed, is opened and the names it registered are recorded. On later
+  runs the recorded names are subscribed to the factories as deferred
+  entries and the library is only opened when one of them is looked up.
+  The aliases and workspace method of each algorithm are recorded too so
+  that the Python simple API can wrap it without opening the library.
+
+  Libraries that register nothing with these factories, or that also
+  register with any other factory, are always opened at start up as their
+  side effects cannot be replayed.
+
+  The manifest is a text file with one block per library:
+  @verbatim
+  library <size> <modification time> <path>
+  algorithm <name>
+  alias <aliases>
+  method <name> <input property> <comma separated workspace types>
+  function <name>
+  loaders
+  @endverbatim
+  with the fields separated by tabs. The optional alias and method lines
+  belong to the algorithm above them.
+*/
+class MANTID_API_DLL PluginManifest {
+public:
+  /// What a library registered when it was opened
+  struct Registrations {
+    /// The algorithms registered
+    std::vector<DeferredAlgorithm> algorithms;
+    /// Names of the fit functions registered
+    std::vector<std::string> functions;
+    /// True if any of the algorithms are file loaders
+    bool loaders = false;
+    /// True if the library registered anything else, so must be opened
+    bool eager = false;
+  };
+
+  explicit PluginManifest(const std::string &filename);
+
+  bool deferLibrary(const std::string &path) const;
+  void openAndRecord(const std::string &path);
+  void record(const std::string &path, const Registrations &registrations);
+  const Registrations *find(const std::string &path) const;
+  void save() const;
+
+private:
+  /// A recorded library and the file details it was recorded against
+  struct Entry {
+    uint64_t size = 0;
+    int64_t modified = 0;
+    Registrations registrations;
+  };
+  void load();
+  static bool fileDetails(const std::string &path, uint64_t &size,
+                          int64_t &modified);
+
+  /// The manifest file
+  std::string m_filename;
+  /// Recorded libraries keyed by full path
+  std::map<std::string, Entry> m_entries;
+  /// True if the entries differ from the file
+  bool m_modified;
+};
+
+} // namespace API
+} // namespace Mantid
+
+#endif /* MANTID_API_PLUGINMANIFEST_H_ */
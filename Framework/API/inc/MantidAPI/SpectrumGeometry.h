@@ -0,0 +1,94 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_API_SPECTRUMGEOMETRY_H_
+#define MANTID_API_SPECTRUMGEOMETRY_H_
+
+#include "MantidAPI/DllConfig.h"
+
+#include <exception>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+class ComponentInfo;
+}
+namespace API {
+class SpectrumInfo;
+
+/** SpectrumGeometry holds the geometry of every spectrum of a workspace in
+  contiguous arrays indexed by workspace index, for algorithms that need the
+  same values for all spectra. It is returned by SpectrumInfo::geometry(),
+  which computes it in parallel on first use and again after the detector
+  grouping, DetectorInfo or ComponentInfo have changed.
+
+  Values that are not defined for a spectrum, such as the scattering angle of
+  a monitor or anything for a spectrum without detectors, are NaN in the
+  arrays. So are values SpectrumInfo threw computing; the per-spectrum
+  accessors of L2 and the scattering angles rethrow those exceptions, as
+  SpectrumInfo would, for monitors too. The solid angles are only computed
+  when they are asked for.
+*/
+class MANTID_API_DLL SpectrumGeometry {
+public:
+  explicit SpectrumGeometry(const SpectrumInfo &spectrumInfo);
+
+  void computeSolidAngles(const SpectrumInfo &spectrumInfo,
+                          const Geometry::ComponentInfo &componentInfo);
+
+  /// The number of spectra
+  size_t size() const { return m_l2.size(); }
+  /// The distance from the source to the sample
+  double l1() const { return m_l1; }
+  /// Non-zero for spectra with at least one detector
+  const std::vector<char> &hasDetectors() const { return m_hasDetectors; }
+  /// Non-zero for spectra whose detectors are all monitors
+  const std::vector<char> &isMonitor() const { return m_isMonitor; }
+  /// Non-zero for spectra whose detectors are all masked
+  const std::vector<char> &isMasked() const { return m_isMasked; }
+  /// The mean distance from the sample to the detectors
+  const std::vector<double> &l2() const { return m_l2; }
+  double l2(const size_t index) const;
+  /// The mean scattering angle in radians
+  const std::vector<double> &twoTheta() const { return m_twoTheta; }
+  double twoTheta(const size_t index) const;
+  /// The mean signed scattering angle in radians
+  const std::vector<double> &signedTwoTheta() const {
+    return m_signedTwoTheta;
+  }
+  double signedTwoTheta(const size_t index) const;
+  /// The azimuthal angle of the mean detector position in radians
+  const std::vector<double> &phi() const { return m_phi; }
+  /// The factor converting d-spacing to time-of-flight, without offsets
+  const std::vector<double> &difc() const { return m_difc; }
+  /// The total solid angle of the detectors seen from the sample. Empty
+  /// unless computeSolidAngles() has been called.
+  const std::vector<double> &solidAngle() const { return m_solidAngle; }
+
+private:
+  static double valueAt(const std::vector<double> &values,
+                        const std::vector<std::exception_ptr> &errors,
+                        const size_t index);
+
+  double m_l1;
+  std::vector<char> m_hasDetectors;
+  std::vector<char> m_isMonitor;
+  std::vector<char> m_isMasked;
+  std::vector<double> m_l2;
+  std::vector<double> m_twoTheta;
+  std::vector<double> m_signedTwoTheta;
+  std::vector<double> m_phi;
+  std::vector<double> m_difc;
+  std::vector<double> m_solidAngle;
+  /// What SpectrumInfo threw computing L2 and the angles of each spectrum
+  std::vector<std::exception_ptr> m_l2Errors;
+  std::vector<std::exception_ptr> m_angleErrors;
+};
+
+} // namespace API
+} // namespace Mantid
+
+#endif /* MANTID_API_SPECTRUMGEOMETRY_H_ */
@@ -30,6 +30,7 @@ class ParameterMap;
 } // namespace Geometry
 namespace API {
 class ExperimentInfo;
+class SpectrumGeometry;
 
 /** API::SpectrumInfo is an intermediate step towards a SpectrumInfo that is
   part of Instrument-2.0. The aim is to provide a nearly identical interface
@@ -84,6 +85,9 @@ public:
   Kernel::V3D samplePosition() const;
   double l1() const;
 
+  boost::shared_ptr<const SpectrumGeometry>
+  geometry(const bool withSolidAngles = false) const;
+
   SpectrumInfoIterator<SpectrumInfo> begin();
   SpectrumInfoIterator<SpectrumInfo> end();
   const SpectrumInfoIterator<const SpectrumInfo> cbegin() const;
@@ -92,9 +96,11 @@ public:
   friend class ExperimentInfo;
 
 private:
+  struct GeometryCache;
   const Geometry::IDetector &getDetector(const size_t index) const;
   const SpectrumDefinition &
   checkAndGetSpectrumDefinition(const size_t index) const;
+  void invalidateGeometry() const;
 
   const ExperimentInfo &m_experimentInfo;
   Geometry::DetectorInfo &m_detectorInfo;
@@ -102,6 +108,8 @@ private:
   mutable std::vector<boost::shared_ptr<const Geometry::IDetector>>
       m_lastDetector;
   mutable std::vector<size_t> m_lastIndex;
+  /// Shared with copies so that they see the same invalidations
+  boost::shared_ptr<GeometryCache> m_geometryCache;
 };
 
 using SpectrumInfoIt = SpectrumInfoIterator<SpectrumInfo>;
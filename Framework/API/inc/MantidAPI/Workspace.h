@@ -13,6 +13,11 @@
 #include "MantidKernel/Exception.h"
 #include "MantidParallel/StorageMode.h"
 
+#include <boost/weak_ptr.hpp>
+
+#include <utility>
+#include <vector>
+
 namespace Mantid {
 
 namespace Kernel {
@@ -79,6 +84,14 @@ public:
   virtual size_t getMemorySize() const = 0;
   /// Returns the memory footprint in sensible units
   std::string getMemorySizeAsStr() const;
+  /// A block of memory, identified by the object owning it, that may be
+  /// shared. An empty owner stands for the reporting workspace itself.
+  struct MemoryBlock {
+    boost::weak_ptr<const void> owner;
+    size_t bytes;
+  };
+  /// Append the blocks of memory held by the workspace
+  virtual void getMemoryBlocks(std::vector<MemoryBlock> &blocks) const;
 
   /// Returns a reference to the WorkspaceHistory
   WorkspaceHistory &history() { return *m_history; }
@@ -49,6 +49,7 @@ public:
 
   /// Return the memory size of all workspaces in this group and subgroups
   size_t getMemorySize() const override;
+  void getMemoryBlocks(std::vector<MemoryBlock> &blocks) const override;
   /// Sort the internal data structure according to member name
   void sortMembersByName();
   /// Adds a workspace to the group.
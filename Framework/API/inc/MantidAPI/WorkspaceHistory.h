@@ -12,6 +12,7 @@
 //----------------------------------------------------------------------
 #include "MantidAPI/AlgorithmHistory.h"
 #include "MantidKernel/EnvironmentHistory.h"
+#include "MantidKernel/cow_ptr.h"
 #include <ctime>
 #include <set>
 
@@ -30,6 +31,10 @@ class HistoryView;
 /** This class stores information about the Workspace History used by algorithms
   on a workspace and the environment history.
 
+  The list of algorithm histories is shared between copies until one of them
+  is changed, and an empty history given the history of another shares its
+  list, so the workspaces of a processing chain do not each hold a copy.
+
   @author Dickon Champion, ISIS, RAL
   @date 21/01/2008
 */
@@ -74,7 +79,8 @@ public:
   void printSelf(std::ostream &, const int indent = 0) const;
 
   /// Save the workspace history to a nexus file
-  void saveNexus(::NeXus::File *file) const;
+  void saveNexus(::NeXus::File *file,
+                 AlgorithmHistoryNexusLinks *links = nullptr) const;
   /// Load the workspace history from a nexus file
   void loadNexus(::NeXus::File *file);
 
@@ -90,7 +96,7 @@ private:
   /// The environment of the workspace
   const Kernel::EnvironmentHistory m_environment;
   /// The algorithms which have been called on the workspace
-  Mantid::API::AlgorithmHistories m_algorithms;
+  Kernel::cow_ptr<AlgorithmHistories> m_algorithms;
 };
 
 MANTID_API_DLL std::ostream &operator<<(std::ostream &,
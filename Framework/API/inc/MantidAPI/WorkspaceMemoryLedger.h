@@ -0,0 +1,94 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_API_WORKSPACEMEMORYLEDGER_H_
+#define MANTID_API_WORKSPACEMEMORYLEDGER_H_
+
+#include "MantidAPI/DllConfig.h"
+#include "MantidAPI/Workspace.h"
+#include "MantidKernel/DataService.h"
+
+#include <boost/smart_ptr/owner_less.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+
+/** WorkspaceMemoryLedger keeps account of the memory held by named
+  workspaces. Each workspace reports the blocks of memory it holds through
+  Workspace::getMemoryBlocks and a block shared between several workspaces,
+  e.g. a histogram array held through a Kernel::cow_ptr, is only counted once
+  in the total. Blocks are identified by a weak reference to their owner
+  rather than by address, so a block that has been released cannot be
+  mistaken for a new one allocated at the same address. Blocks a workspace
+  modifies in place are only seen when it is recorded or updated again.
+
+  The ledger also records when each workspace was last accessed and whether
+  it has been spilled to a file, or could not be, so that the
+  AnalysisDataService can decide which workspaces to move out of memory when
+  a budget is exceeded.
+  The class is thread-safe.
+*/
+class MANTID_API_DLL WorkspaceMemoryLedger {
+public:
+  void record(const std::string &name, const Workspace_const_sptr &workspace);
+  void update(const std::string &name, const Workspace_const_sptr &workspace);
+  void remove(const std::string &name);
+  void rename(const std::string &oldName, const std::string &newName);
+  void clear();
+  void touch(const std::string &name);
+
+  size_t memoryOf(const std::string &name) const;
+  size_t totalMemory() const;
+  std::vector<std::string> leastRecentlyUsed() const;
+
+  void markSpilled(const std::string &name, const std::string &filename);
+  bool isSpilled(const std::string &name) const;
+  std::string spillFile(const std::string &name) const;
+  void markUnspillable(const std::string &name);
+  bool isUnspillable(const std::string &name) const;
+
+private:
+  /// Identifies a block by the control block of its owner
+  using BlockOwner = boost::weak_ptr<const void>;
+  /// The accounting information for a single named workspace
+  struct Entry {
+    std::vector<BlockOwner> blocks;
+    size_t bytes = 0;
+    uint64_t lastAccess = 0;
+    std::string spillFile;
+    bool unspillable = false;
+  };
+  /// The size of a block and the number of entries that hold it
+  struct Block {
+    size_t bytes = 0;
+    size_t holders = 0;
+  };
+  void holdBlocks(Entry &entry,
+                  const std::vector<Workspace::MemoryBlock> &blocks);
+  void releaseBlocks(Entry &entry);
+
+  /// Entries keyed by workspace name, using the same ordering as the ADS
+  std::map<std::string, Entry, Kernel::CaseInsensitiveCmp> m_entries;
+  /// Every block held by any entry
+  std::map<BlockOwner, Block, boost::owner_less<BlockOwner>> m_blocks;
+  /// The sum of the sizes of all distinct blocks
+  size_t m_total = 0;
+  /// Monotonic counter used to order accesses
+  uint64_t m_clock = 0;
+  mutable std::mutex m_mutex;
+};
+
+} // namespace API
+} // namespace Mantid
+
+#endif /* MANTID_API_WORKSPACEMEMORYLEDGER_H_ */
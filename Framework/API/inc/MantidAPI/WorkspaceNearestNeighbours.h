@@ -9,6 +9,7 @@
 
 #include "MantidAPI/DllConfig.h"
 #include "MantidGeometry/IDTypes.h"
+#include "MantidKernel/NearestNeighbours.h"
 #include "MantidKernel/V3D.h"
 // Boost graphing
 #ifndef Q_MOC_RUN
@@ -32,11 +33,9 @@ class SpectrumInfo;
  * instrument geometry. This class can be queried through calls to the
  * getNeighbours() function on a Detector object.
  *
- * This class uses the ANN Library, from David M Mount and Sunil Arya which
- * is incorporated into Mantid's Kernel module. Mantid uses version 1.1.2
- * of this library.
- * ANN is available from <http://www.cs.umd.edu/~mount/ANN/> and is released
- * under the GNU LGPL.
+ * The detector positions are indexed once by a Kernel::NearestNeighbours
+ * k-d tree which is reused whenever the neighbour graph is rebuilt and to
+ * answer queries for radii beyond the current graph.
  *
  * Known potential issue: boost's graph has an issue that may cause compilation
  * errors in some circumstances in the current version of boost used by
@@ -85,6 +84,9 @@ private:
   /// detector
   std::map<specnum_t, Mantid::Kernel::V3D>
   defaultNeighbours(const specnum_t spectrum) const;
+  /// Query the tree for all neighbours within a radius of specified detector
+  std::map<specnum_t, Mantid::Kernel::V3D>
+  neighboursWithinRadius(const specnum_t spectrum, const double radius) const;
   /// The current number of nearest neighbours
   int m_noNeighbours;
   /// The largest value of the distance to a nearest neighbour
@@ -99,8 +101,10 @@ private:
   boost::property_map<Graph, boost::edge_name_t>::type m_edgeLength;
   /// V3D for scaling
   Kernel::V3D m_scale;
-  /// Cached radius value. used to avoid uncessary recalculations.
-  mutable double m_radius;
+  /// Scaled positions of the detectors, in graph vertex order
+  std::vector<Eigen::Vector3d> m_points;
+  /// Search tree over m_points
+  std::unique_ptr<Kernel::NearestNeighbours<3>> m_tree;
   /// Flag indicating that masked detectors should be ignored
   bool m_bIgnoreMaskedDetectors;
 };
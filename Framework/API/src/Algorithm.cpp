@@ -9,6 +9,7 @@
 #include "MantidAPI/AlgorithmHistory.h"
 #include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/AlgorithmProxy.h"
+#include "MantidAPI/AlgorithmResultCache.h"
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/DeprecatedAlgorithm.h"
 #include "MantidAPI/IWorkspaceProperty.h"
@@ -19,6 +20,7 @@
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/EmptyValues.h"
+#include "MantidKernel/LogMessageBuffer.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/Strings.h"
@@ -27,6 +29,7 @@
 
 #include "MantidParallel/Communicator.h"
 
+#include <boost/optional.hpp>
 #include <boost/weak_ptr.hpp>
 
 #include <MantidKernel/StringTokenizer.h>
@@ -38,7 +41,10 @@
 
 #include <json/json.h>
 
+#include <atomic>
 #include <map>
+#include <mutex>
+#include <thread>
 
 // Index property handling template definitions
 #include "MantidAPI/Algorithm.tcc"
@@ -66,6 +72,24 @@ public:
 private:
   const std::string &m_value;
 };
+
+/// Serializes child algorithms, which may run concurrently, adding their
+/// history to a parent
+std::mutex g_childHistoryMutex;
+
+/// The result cache set in the properties if the algorithm may use it
+boost::optional<AlgorithmResultCache> resultCache(const Algorithm &alg) {
+  if (!alg.cacheable() || alg.communicator().size() > 1)
+    return boost::none;
+  auto &config = ConfigService::Instance();
+  const auto directory = config.getString("algorithms.cache.directory");
+  if (directory.empty())
+    return boost::none;
+  const double maxSizeMB =
+      config.getValue<double>("algorithms.cache.maxsizeMB").get_value_or(1024.);
+  return AlgorithmResultCache(
+      directory, static_cast<uint64_t>(std::max(maxSizeMB, 0.) * 1024 * 1024));
+}
 } // namespace
 
 // Doxygen can't handle member specialization at the moment:
@@ -460,6 +484,45 @@ void Algorithm::lockWorkspaces() {
 }
 
 //---------------------------------------------------------------------------------------------
+/**
+ * Give the output property of inPlaceWorkspaceProperties() the workspace of
+ * the input property when nothing outside the algorithm holds the input, so
+ * that the algorithm takes its path for an output that is its input and
+ * modifies the workspace rather than a copy. Only child algorithms, whose
+ * caller can hand over the only reference by releasing its own after
+ * setProperty(), execute in place this way.
+ */
+void Algorithm::setUpInPlaceExecution() {
+  if (!isChild())
+    return;
+  const auto names = inPlaceWorkspaceProperties();
+  if (names.first.empty() || names.second.empty())
+    return;
+  const auto input =
+      dynamic_cast<IWorkspaceProperty *>(getPointerToProperty(names.first));
+  auto *outputProp = getPointerToProperty(names.second);
+  const auto output = dynamic_cast<IWorkspaceProperty *>(outputProp);
+  if (!input || !output || outputProp->direction() != Direction::Output ||
+      output->getWorkspace())
+    return;
+  const auto workspace = input->getWorkspace();
+  if (!workspace || dynamic_cast<const WorkspaceGroup *>(workspace.get()))
+    return;
+  // Held by the input property, here and by the cached input histories
+  const auto references =
+      2 + std::count(m_inputWorkspaceHistories.cbegin(),
+                     m_inputWorkspaceHistories.cend(), workspace);
+  if (workspace.use_count() != references)
+    return;
+  if (!outputProp->setDataItem(workspace).empty()) {
+    // Not a valid output, e.g. of the wrong type
+    outputProp->setDataItem(Workspace_sptr());
+    return;
+  }
+  getLogger().debug() << "Executing in place on the workspace of "
+                      << names.first << "\n";
+}
+
 /** Unlock any previously locked workspaces
  *
  */
@@ -613,6 +676,7 @@ bool Algorithm::executeInternal() {
     return doCallProcessGroups(startTime);
   }
 
+  setUpInPlaceExecution();
   // Read or write locks every input/output workspace
   this->lockWorkspaces();
   timingInit += timer.elapsed(resetTimer);
@@ -626,8 +690,17 @@ bool Algorithm::executeInternal() {
       }
 
       startTime = Mantid::Types::Core::DateAndTime::getCurrentTime();
-      // Call the concrete algorithm's exec method
-      this->exec(executionMode);
+      // Call the concrete algorithm's exec method, unless the outputs of an
+      // earlier execution with the same inputs are in the result cache
+      const auto cache = resultCache(*this);
+      const auto cacheKey = cache ? AlgorithmResultCache::key(*this) : "";
+      if (cache && cache->restore(*this, cacheKey)) {
+        getLogger().information("Outputs taken from the result cache\n");
+      } else {
+        this->exec(executionMode);
+        if (cache)
+          cache->store(*this, cacheKey);
+      }
       registerFeatureUsage();
       // Check for a cancellation request in case the concrete algorithm doesn't
       interruption_point();
@@ -1366,6 +1439,7 @@ void Algorithm::fillHistory(
   }
   // this is a child algorithm, but we still want to keep the history.
   else if (m_recordHistoryForChild && m_parentHistory) {
+    std::lock_guard<std::mutex> lock(g_childHistoryMutex);
     m_parentHistory->addChildHistory(m_history);
   }
 }
@@ -1399,135 +1473,269 @@ bool Algorithm::processGroups() {
     }
   }
 
+  // ------------ Fill in the output workspace group ------------------
+  // this has to be done after execute() because a workspace must exist
+  // when it is added to a group
+  std::vector<std::vector<std::string>> outputWSNames(m_groupSize);
+  auto addToOutputGroups = [&](size_t entry) {
+    for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
+      Property *prop =
+          dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp]);
+      if (prop && prop->value().empty())
+        continue;
+      // And add it to the output group
+      outGroups[owp]->add(outputWSNames[entry][owp]);
+    }
+  };
+
+  const size_t nthreads = groupConcurrency();
+  if (nthreads > 1) {
+    // Configure every entry first and fill the groups in entry order so the
+    // output does not depend on the order the entries finish in
+    std::vector<Algorithm_sptr> algorithms;
+    algorithms.reserve(m_groupSize);
+    for (size_t entry = 0; entry < m_groupSize; entry++)
+      algorithms.push_back(
+          createGroupMemberAlgorithm(entry, false, outputWSNames[entry]));
+    executeGroupMembersConcurrently(algorithms, nthreads);
+    for (size_t entry = 0; entry < m_groupSize; entry++)
+      addToOutputGroups(entry);
+  } else {
+    // Go through each entry in the input group(s)
+    for (size_t entry = 0; entry < m_groupSize; entry++) {
+      auto alg = createGroupMemberAlgorithm(entry, true, outputWSNames[entry]);
+      executeGroupMember(*alg, entry);
+      addToOutputGroups(entry);
+    }
+  }
+
+  // restore group notifications
+  for (auto &outGroup : outGroups) {
+    outGroup->observeADSNotifications(true);
+  }
+
+  return true;
+}
+
+/**
+ * Create a child algorithm that looks like this one to process one entry of
+ * the input group(s)
+ * @param entry :: The index of the entry in the group(s)
+ * @param reportProgress :: If true the child reports its progress as its
+ * share of the progress of this algorithm
+ * @param outputWSNames :: Set to the names of the output workspaces, one for
+ * each output workspace property
+ * @return The configured child algorithm
+ */
+Algorithm_sptr
+Algorithm::createGroupMemberAlgorithm(size_t entry, bool reportProgress,
+                                      std::vector<std::string> &outputWSNames) {
   double progress_proportion = 1.0 / static_cast<double>(m_groupSize);
-  // Go through each entry in the input group(s)
-  for (size_t entry = 0; entry < m_groupSize; entry++) {
-    // use create Child Algorithm that look like this one
-    Algorithm_sptr alg_sptr = this->createChildAlgorithm(
-        this->name(), progress_proportion * static_cast<double>(entry),
-        progress_proportion * (1 + static_cast<double>(entry)),
-        this->isLogging(), this->version());
-    // Make a child algorithm and turn off history recording for it, but always
-    // store result in the ADS
-    alg_sptr->setChild(true);
-    alg_sptr->setAlwaysStoreInADS(true);
-    alg_sptr->enableHistoryRecordingForChild(false);
-    alg_sptr->setRethrows(true);
-
-    IAlgorithm *alg = alg_sptr.get();
-    // Set all non-workspace properties
-    this->copyNonWorkspaceProperties(alg, int(entry) + 1);
-
-    std::string outputBaseName;
-
-    // ---------- Set all the input workspaces ----------------------------
-    for (size_t iwp = 0; iwp < m_unrolledInputWorkspaces.size(); iwp++) {
-      std::vector<Workspace_sptr> &thisGroup = m_unrolledInputWorkspaces[iwp];
-      if (!thisGroup.empty()) {
-        // By default (for a single group) point to the first/only workspace
-        Workspace_sptr ws = thisGroup[0];
-
-        if ((m_singleGroup == int(iwp)) || m_singleGroup < 0) {
-          // Either: this is the single group
-          // OR: all inputs are groups
-          // ... so get then entry^th workspace in this group
-          ws = thisGroup[entry];
-        }
-        // Append the names together
-        if (!outputBaseName.empty())
-          outputBaseName += "_";
-        outputBaseName += ws->getName();
-
-        // Set the property using the name of that workspace
-        if (Property *prop =
-                dynamic_cast<Property *>(m_inputWorkspaceProps[iwp])) {
-          if (ws->getName().empty()) {
-            alg->setProperty(prop->name(), ws);
-          } else {
-            alg->setPropertyValue(prop->name(), ws->getName());
-          }
-        } else {
-          throw std::logic_error("Found a Workspace property which doesn't "
-                                 "inherit from Property.");
-        }
-      } // not an empty (i.e. optional) input
-    }   // for each InputWorkspace property
+  // use create Child Algorithm that look like this one
+  Algorithm_sptr alg_sptr = this->createChildAlgorithm(
+      this->name(),
+      reportProgress ? progress_proportion * static_cast<double>(entry) : -1.,
+      reportProgress ? progress_proportion * (1 + static_cast<double>(entry))
+                     : -1.,
+      this->isLogging(), this->version());
+  // Make a child algorithm and turn off history recording for it, but always
+  // store result in the ADS
+  alg_sptr->setChild(true);
+  alg_sptr->setAlwaysStoreInADS(true);
+  alg_sptr->enableHistoryRecordingForChild(false);
+  alg_sptr->setRethrows(true);
+
+  IAlgorithm *alg = alg_sptr.get();
+  // Set all non-workspace properties
+  this->copyNonWorkspaceProperties(alg, int(entry) + 1);
+
+  std::string outputBaseName;
+
+  // ---------- Set all the input workspaces ----------------------------
+  for (size_t iwp = 0; iwp < m_unrolledInputWorkspaces.size(); iwp++) {
+    std::vector<Workspace_sptr> &thisGroup = m_unrolledInputWorkspaces[iwp];
+    if (!thisGroup.empty()) {
+      // By default (for a single group) point to the first/only workspace
+      Workspace_sptr ws = thisGroup[0];
+
+      if ((m_singleGroup == int(iwp)) || m_singleGroup < 0) {
+        // Either: this is the single group
+        // OR: all inputs are groups
+        // ... so get then entry^th workspace in this group
+        ws = thisGroup[entry];
+      }
+      // Append the names together
+      if (!outputBaseName.empty())
+        outputBaseName += "_";
+      outputBaseName += ws->getName();
 
-    std::vector<std::string> outputWSNames(m_pureOutputWorkspaceProps.size());
-    // ---------- Set all the output workspaces ----------------------------
-    for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
+      // Set the property using the name of that workspace
       if (Property *prop =
-              dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp])) {
-        // Default name = "in1_in2_out"
-        const std::string inName = prop->value();
-        if (inName.empty())
-          continue;
-        std::string outName;
-        if (m_groupsHaveSimilarNames) {
-          outName.append(inName).append("_").append(
-              Strings::toString(entry + 1));
+              dynamic_cast<Property *>(m_inputWorkspaceProps[iwp])) {
+        if (ws->getName().empty()) {
+          alg->setProperty(prop->name(), ws);
         } else {
-          outName.append(outputBaseName).append("_").append(inName);
-        }
-
-        auto inputProp = std::find_if(m_inputWorkspaceProps.begin(),
-                                      m_inputWorkspaceProps.end(),
-                                      WorkspacePropertyValueIs(inName));
-
-        // Overwrite workspaces in any input property if they have the same
-        // name as an output (i.e. copy name button in algorithm dialog used)
-        // (only need to do this for a single input, multiple will be handled
-        // by ADS)
-        if (inputProp != m_inputWorkspaceProps.end()) {
-          const auto &inputGroup =
-              m_unrolledInputWorkspaces[inputProp -
-                                        m_inputWorkspaceProps.begin()];
-          if (!inputGroup.empty())
-            outName = inputGroup[entry]->getName();
+          alg->setPropertyValue(prop->name(), ws->getName());
         }
-        // Except if all inputs had similar names, then the name is "out_1"
-
-        // Set in the output
-        alg->setPropertyValue(prop->name(), outName);
-
-        outputWSNames[owp] = outName;
       } else {
         throw std::logic_error("Found a Workspace property which doesn't "
                                "inherit from Property.");
       }
-    } // for each OutputWorkspace property
+    } // not an empty (i.e. optional) input
+  }   // for each InputWorkspace property
+
+  outputWSNames.assign(m_pureOutputWorkspaceProps.size(), "");
+  // ---------- Set all the output workspaces ----------------------------
+  for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
+    if (Property *prop =
+            dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp])) {
+      // Default name = "in1_in2_out"
+      const std::string inName = prop->value();
+      if (inName.empty())
+        continue;
+      std::string outName;
+      if (m_groupsHaveSimilarNames) {
+        outName.append(inName).append("_").append(
+            Strings::toString(entry + 1));
+      } else {
+        outName.append(outputBaseName).append("_").append(inName);
+      }
 
-    // ------------ Execute the algo --------------
-    try {
-      alg->execute();
-    } catch (std::exception &e) {
-      std::ostringstream msg;
-      msg << "Execution of " << this->name() << " for group entry "
-          << (entry + 1) << " failed: ";
-      msg << e.what(); // Add original message
-      throw std::runtime_error(msg.str());
-    }
+      auto inputProp = std::find_if(m_inputWorkspaceProps.begin(),
+                                    m_inputWorkspaceProps.end(),
+                                    WorkspacePropertyValueIs(inName));
+
+      // Overwrite workspaces in any input property if they have the same
+      // name as an output (i.e. copy name button in algorithm dialog used)
+      // (only need to do this for a single input, multiple will be handled
+      // by ADS)
+      if (inputProp != m_inputWorkspaceProps.end()) {
+        const auto &inputGroup =
+            m_unrolledInputWorkspaces[inputProp -
+                                      m_inputWorkspaceProps.begin()];
+        if (!inputGroup.empty())
+          outName = inputGroup[entry]->getName();
+      }
+      // Except if all inputs had similar names, then the name is "out_1"
 
-    // ------------ Fill in the output workspace group ------------------
-    // this has to be done after execute() because a workspace must exist
-    // when it is added to a group
-    for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
-      Property *prop =
-          dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp]);
-      if (prop && prop->value().empty())
-        continue;
-      // And add it to the output group
-      outGroups[owp]->add(outputWSNames[owp]);
+      // Set in the output
+      alg->setPropertyValue(prop->name(), outName);
+
+      outputWSNames[owp] = outName;
+    } else {
+      throw std::logic_error("Found a Workspace property which doesn't "
+                             "inherit from Property.");
     }
+  } // for each OutputWorkspace property
+  return alg_sptr;
+}
 
-  } // for each entry in each group
+/**
+ * Execute the child algorithm processing one entry of the input group(s)
+ * @param alg :: The child algorithm
+ * @param entry :: The index of the entry in the group(s)
+ * @throws std::runtime_error naming the entry if the child fails
+ */
+void Algorithm::executeGroupMember(IAlgorithm &alg, size_t entry) const {
+  try {
+    alg.execute();
+  } catch (std::exception &e) {
+    std::ostringstream msg;
+    msg << "Execution of " << this->name() << " for group entry "
+        << (entry + 1) << " failed: ";
+    msg << e.what(); // Add original message
+    throw std::runtime_error(msg.str());
+  }
+}
 
-  // restore group notifications
-  for (auto &outGroup : outGroups) {
-    outGroup->observeADSNotifications(true);
+/**
+ * The number of group entries processGroups() may process at once. This is
+ * more than one only if "algorithms.groups.concurrency" allows it, the
+ * algorithm opts in with canProcessGroupsConcurrently() and the algorithm and
+ * all of its input workspaces are thread safe.
+ * @return The number of entries to process at once
+ */
+size_t Algorithm::groupConcurrency() const {
+  if (m_groupSize < 2 || !canProcessGroupsConcurrently() || !threadSafe())
+    return 1;
+  const int configured = ConfigService::Instance()
+                             .getValue<int>("algorithms.groups.concurrency")
+                             .get_value_or(1);
+  if (configured == 1)
+    return 1;
+  for (const auto &group : m_unrolledInputWorkspaces) {
+    for (const auto &ws : group) {
+      if (ws && !ws->threadSafe())
+        return 1;
+    }
   }
+  const int limit = configured > 0 ? configured : PARALLEL_GET_MAX_THREADS;
+  return std::min(m_groupSize, static_cast<size_t>(std::max(limit, 1)));
+}
 
-  return true;
+/**
+ * Execute the child algorithms processing the entries of the input group(s),
+ * several at a time. The OpenMP threads are shared out between them. Once an
+ * entry fails no further entries are started and the error from the failed
+ * entry with the lowest index is rethrown. The messages logged while an
+ * entry runs are held back and sent in entry order, as the serial loop would.
+ * @param algorithms :: The child algorithm for each entry
+ * @param nthreads :: The number of entries to process at once
+ */
+void Algorithm::executeGroupMembersConcurrently(
+    const std::vector<Algorithm_sptr> &algorithms, size_t nthreads) {
+  const int ompThreads =
+      std::max(1, PARALLEL_GET_MAX_THREADS / static_cast<int>(nthreads));
+  std::vector<std::exception_ptr> failures(algorithms.size());
+  std::atomic<size_t> next(0);
+  std::atomic<bool> failed(false);
+  // The messages each entry logs are held back and sent in entry order
+  std::vector<Kernel::LogMessageBuffer> messages(algorithms.size());
+  std::vector<bool> done(algorithms.size(), false);
+  size_t nextToLog(0);
+  std::mutex progressMutex;
+  size_t finished(0);
+
+  auto worker = [&]() {
+    PARALLEL_SET_NUM_THREADS(ompThreads);
+    while (!failed && !m_cancel) {
+      const size_t entry = next++;
+      if (entry >= algorithms.size())
+        break;
+      {
+        Kernel::LogMessageBuffer::Capture capture(messages[entry]);
+        try {
+          executeGroupMember(*algorithms[entry], entry);
+        } catch (...) {
+          failures[entry] = std::current_exception();
+          failed = true;
+        }
+      }
+      std::lock_guard<std::mutex> lock(progressMutex);
+      done[entry] = true;
+      while (nextToLog < algorithms.size() && done[nextToLog])
+        messages[nextToLog++].flush();
+      ++finished;
+      progress(static_cast<double>(finished) /
+               static_cast<double>(algorithms.size()));
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(nthreads);
+  for (size_t i = 0; i < nthreads; ++i)
+    threads.emplace_back(worker);
+  for (auto &thread : threads)
+    thread.join();
+  // Entries after one that never started have not been sent yet
+  for (; nextToLog < algorithms.size(); ++nextToLog)
+    messages[nextToLog].flush();
+
+  for (const auto &failure : failures) {
+    if (failure)
+      std::rethrow_exception(failure);
+  }
+  interruption_point();
 }
 
 //--------------------------------------------------------------------------------------------
@@ -42,16 +42,14 @@ AlgorithmFactoryImpl::~AlgorithmFactoryImpl() = default;
 boost::shared_ptr<Algorithm>
 AlgorithmFactoryImpl::create(const std::string &name,
                              const int &version) const {
+  m_deferred.open(name);
   int local_version = version;
   if (version < 0) {
     if (version == -1) // get latest version since not supplied
     {
-      auto it = m_vmap.find(name);
       if (!name.empty()) {
-        if (it == m_vmap.end())
+        if (!latestVersion(name, local_version))
           throw std::runtime_error("Algorithm not registered " + name);
-        else
-          local_version = it->second;
       } else
         throw std::runtime_error(
             "Algorithm not registered (empty algorithm name)");
@@ -60,20 +58,55 @@ AlgorithmFactoryImpl::create(const std::string &name,
   try {
     return this->createAlgorithm(name, local_version);
   } catch (Kernel::Exception::NotFoundError &) {
-    auto it = m_vmap.find(name);
-    if (it == m_vmap.end())
+    int latest(0);
+    if (!latestVersion(name, latest))
       throw std::runtime_error("algorithm not registered " + name);
     else {
       g_log.error() << "algorithm " << name << " version " << version
                     << " is not registered \n";
-      g_log.error() << "the latest registered version is " << it->second
-                    << '\n';
+      g_log.error() << "the latest registered version is " << latest << '\n';
       throw std::runtime_error("algorithm not registered " +
                                createName(name, local_version));
     }
   }
 }
 
+/**
+ * Record that a plugin library, not yet opened, registers an algorithm. The
+ * library is opened the first time the algorithm is looked up.
+ * @param algorithm :: What is known of the algorithm without creating it
+ * @param library :: The full path to the library registering it
+ */
+void AlgorithmFactoryImpl::subscribeDeferred(const DeferredAlgorithm &algorithm,
+                                             const std::string &library) {
+  {
+    std::lock_guard<std::mutex> lock(m_vmapMutex);
+    m_deferredAlgorithms[algorithm.name] = algorithm;
+  }
+  m_deferred.add(algorithm.name, library);
+}
+
+/**
+ * List the algorithms known from the plugin manifest whose libraries have not
+ * been opened. Looking any of them up opens its library.
+ * @returns What is known of each algorithm
+ */
+std::vector<DeferredAlgorithm>
+AlgorithmFactoryImpl::getDeferredAlgorithms() const {
+  const auto names = m_deferred.names();
+  std::vector<DeferredAlgorithm> algorithms;
+  std::lock_guard<std::mutex> lock(m_vmapMutex);
+  for (const auto &name : names) {
+    // The library may have been opened for another of its algorithms
+    if (m_vmap.find(name) != m_vmap.end())
+      continue;
+    const auto algorithm = m_deferredAlgorithms.find(name);
+    if (algorithm != m_deferredAlgorithms.end())
+      algorithms.push_back(algorithm->second);
+  }
+  return algorithms;
+}
+
 /**
  * Override the unsubscribe method so that it knows how algorithm names are
  * encoded in the factory
@@ -86,6 +119,7 @@ void AlgorithmFactoryImpl::unsubscribe(const std::string &algorithmName,
   try {
     Kernel::DynamicFactory<Algorithm>::unsubscribe(key);
     // Update version map accordingly
+    std::lock_guard<std::mutex> lock(m_vmapMutex);
     auto it = m_vmap.find(algorithmName);
     if (it != m_vmap.end()) {
       int highest_version = it->second;
@@ -111,15 +145,33 @@ void AlgorithmFactoryImpl::unsubscribe(const std::string &algorithmName,
  */
 bool AlgorithmFactoryImpl::exists(const std::string &algorithmName,
                                   const int version) {
+  m_deferred.open(algorithmName);
   if (version == -1) // Find anything
   {
-    return (m_vmap.find(algorithmName) != m_vmap.end());
+    int latest(0);
+    return latestVersion(algorithmName, latest);
   } else {
     std::string key = this->createName(algorithmName, version);
     return Kernel::DynamicFactory<Algorithm>::exists(key);
   }
 }
 
+/**
+ * Look up the highest version of an algorithm in the version map
+ * @param algorithmName :: The name of the algorithm
+ * @param version :: Set to the highest version if the algorithm is found
+ * @returns True if the algorithm is registered
+ */
+bool AlgorithmFactoryImpl::latestVersion(const std::string &algorithmName,
+                                         int &version) const {
+  std::lock_guard<std::mutex> lock(m_vmapMutex);
+  auto it = m_vmap.find(algorithmName);
+  if (it == m_vmap.end())
+    return false;
+  version = it->second;
+  return true;
+}
+
 /** Creates a mangled name for interal storage
  * @param name :: the name of the Algrorithm
  * @param version :: the version of the algroithm
@@ -177,6 +229,22 @@ const std::vector<std::string> AlgorithmFactoryImpl::getKeys() const {
  */
 const std::vector<std::string>
 AlgorithmFactoryImpl::getKeys(bool includeHidden) const {
+  return getKeys(includeHidden, true);
+}
+
+/**
+ * Return the keys used for identifying algorithms, optionally leaving the
+ * libraries of deferred algorithms unopened.
+ * @param includeHidden true includes the hidden algorithm names and is faster
+ * @param openDeferred If false only the algorithms of the libraries opened so
+ * far are listed, see getDeferredAlgorithms for the others
+ * @returns The strings used to identify individual algorithms
+ */
+const std::vector<std::string>
+AlgorithmFactoryImpl::getKeys(bool includeHidden, bool openDeferred) const {
+  // Listing everything requires every deferred library to be opened
+  if (openDeferred)
+    m_deferred.openAll();
   // Start with those subscribed with the factory and add the cleanly
   // constructed algorithm keys
   std::vector<std::string> names = Kernel::DynamicFactory<Algorithm>::getKeys();
@@ -230,9 +298,10 @@ AlgorithmFactoryImpl::getKeys(bool includeHidden) const {
  */
 int AlgorithmFactoryImpl::highestVersion(
     const std::string &algorithmName) const {
-  auto viter = m_vmap.find(algorithmName);
-  if (viter != m_vmap.end())
-    return viter->second;
+  m_deferred.open(algorithmName);
+  int latest(0);
+  if (latestVersion(algorithmName, latest))
+    return latest;
   else {
     throw std::invalid_argument(
         "AlgorithmFactory::highestVersion() - Unknown algorithm '" +
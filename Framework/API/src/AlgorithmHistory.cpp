@@ -27,6 +27,14 @@ using Types::Core::DateAndTime;
 namespace {
 /// The generator for algorithm history UUIDs
 static boost::uuids::random_generator uuidGen;
+
+/// The number of histories nested below a history
+size_t countDescendants(const AlgorithmHistory &history) {
+  size_t count(0);
+  for (const auto &child : history.getChildHistories())
+    count += 1 + countDescendants(*child);
+  return count;
+}
 } // namespace
 
 /** Constructor
@@ -289,24 +297,43 @@ std::ostream &operator<<(std::ostream &os, const AlgorithmHistory &AH) {
 /** Write out this history record to file.
  * @param file :: The handle to the nexus file to save to
  * @param algCount :: Counter of the number of algorithms written to file.
+ * @param links :: If given, the groups already written to the file. A history
+ * already written under the same name is linked to rather than written again
+ * and the groups written are added.
  */
-void AlgorithmHistory::saveNexus(::NeXus::File *file, int &algCount) const {
+void AlgorithmHistory::saveNexus(::NeXus::File *file, int &algCount,
+                                 AlgorithmHistoryNexusLinks *links) const {
   std::stringstream algNumber;
   ++algCount;
   algNumber << "MantidAlgorithm_"
             << algCount; // history entry names start at 1 not 0
+  const std::string groupName = algNumber.str();
+
+  // A link takes the name of its target so this history can only be linked
+  // to a group written with the same name
+  if (links) {
+    const auto saved = links->find(m_uuid);
+    if (saved != links->end() && saved->second.first == groupName) {
+      auto link = saved->second.second;
+      file->makeLink(link);
+      algCount += static_cast<int>(countDescendants(*this));
+      return;
+    }
+  }
 
   std::stringstream algData;
   printSelf(algData);
 
-  file->makeGroup(algNumber.str(), "NXnote", true);
+  file->makeGroup(groupName, "NXnote", true);
+  if (links)
+    links->emplace(m_uuid, std::make_pair(groupName, file->getGroupID()));
   file->writeData("author", std::string("mantid"));
   file->writeData("description", std::string("Mantid Algorithm data"));
   file->writeData("data", algData.str());
 
   // child algorithms
   for (auto &history : m_childHistories) {
-    history->saveNexus(file, algCount);
+    history->saveNexus(file, algCount, links);
   }
   file->closeGroup();
 }
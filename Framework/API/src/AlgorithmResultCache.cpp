@@ -0,0 +1,527 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/AlgorithmResultCache.h"
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/AlgorithmHistory.h"
+#include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/Axis.h"
+#include "MantidAPI/Column.h"
+#include "MantidAPI/FileProperty.h"
+#include "MantidAPI/IEventList.h"
+#include "MantidAPI/IEventWorkspace.h"
+#include "MantidAPI/ITableWorkspace.h"
+#include "MantidAPI/IWorkspaceProperty.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAPI/Run.h"
+#include "MantidAPI/Sample.h"
+#include "MantidAPI/WorkspaceGroup.h"
+#include "MantidAPI/WorkspaceHistory.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/Material.h"
+#include "MantidKernel/TimeSeriesProperty.h"
+#include "MantidKernel/Unit.h"
+
+#include <Poco/DigestEngine.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/SHA1Engine.h>
+#include <Poco/TemporaryFile.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+
+namespace Mantid {
+namespace API {
+namespace {
+/// static logger
+Kernel::Logger g_log("AlgorithmResultCache");
+
+/// The file in each entry listing the outputs it holds
+const std::string OUTPUTS_FILE("outputs.txt");
+
+/// Accumulates a SHA-1 digest of values and strings
+class Digest {
+public:
+  void add(const std::string &value) {
+    addValue(value.size());
+    m_engine.update(value);
+  }
+  template <typename T> void addValue(const T &value) {
+    m_engine.update(&value, sizeof(T));
+  }
+  template <typename T> void addVector(const std::vector<T> &values) {
+    addValue(values.size());
+    if (!values.empty())
+      m_engine.update(values.data(), values.size() * sizeof(T));
+  }
+  std::string hex() {
+    return Poco::DigestEngine::digestToHex(m_engine.digest());
+  }
+
+private:
+  Poco::SHA1Engine m_engine;
+};
+
+/// Add the steps that produced a workspace. This stands in for the parts of
+/// a workspace, such as the sample environment, that are not hashed directly.
+void addHistory(Digest &digest, const WorkspaceHistory &history) {
+  for (const auto &algorithm : history.getAlgorithmHistories()) {
+    digest.add(algorithm->name());
+    digest.addValue(algorithm->version());
+    for (const auto &property : algorithm->getProperties()) {
+      digest.add(property->name());
+      digest.add(property->value());
+    }
+  }
+}
+
+void addRun(Digest &digest, const Run &run) {
+  for (const auto *log : run.getProperties()) {
+    digest.add(log->name());
+    if (const auto *series =
+            dynamic_cast<const Kernel::TimeSeriesProperty<double> *>(log)) {
+      // Avoid formatting long series as strings
+      digest.addVector(series->valuesAsVector());
+      for (const auto &time : series->timesAsVector())
+        digest.addValue(time.totalNanoseconds());
+    } else {
+      digest.add(log->value());
+    }
+  }
+}
+
+void addV3D(Digest &digest, const Kernel::V3D &vector) {
+  digest.addValue(vector.X());
+  digest.addValue(vector.Y());
+  digest.addValue(vector.Z());
+}
+
+void addSample(Digest &digest, const Sample &sample) {
+  digest.add(sample.getName());
+  const auto &material = sample.getMaterial();
+  digest.add(material.name());
+  digest.addValue(material.numberDensity());
+  digest.addValue(material.temperature());
+  digest.addValue(material.pressure());
+  digest.addValue(material.totalScatterXSection());
+  digest.addValue(material.absorbXSection());
+  const auto &shape = sample.getShape();
+  digest.add(shape.id());
+  if (shape.hasValidShape()) {
+    Geometry::detail::ShapeInfo::GeometryShape type;
+    std::vector<Kernel::V3D> vectors;
+    double radius(0.), height(0.);
+    shape.GetObjectGeom(type, vectors, radius, height);
+    digest.addValue(type);
+    for (const auto &vector : vectors)
+      addV3D(digest, vector);
+    digest.addValue(radius);
+    digest.addValue(height);
+    const auto &box = shape.getBoundingBox();
+    addV3D(digest, box.minPoint());
+    addV3D(digest, box.maxPoint());
+  }
+  digest.addValue(sample.getThickness());
+  digest.addValue(sample.getHeight());
+  digest.addValue(sample.getWidth());
+}
+
+void addInstrument(Digest &digest, const MatrixWorkspace &workspace) {
+  const auto instrument = workspace.getInstrument();
+  digest.add(instrument->getName());
+  digest.add(instrument->getFilename());
+  digest.addValue(instrument->getValidFromDate().totalNanoseconds());
+  digest.add(workspace.constInstrumentParameters().asString());
+  const auto &detectorInfo = workspace.detectorInfo();
+  for (size_t i = 0; i < detectorInfo.size(); ++i) {
+    addV3D(digest, detectorInfo.position(i));
+    const auto rotation = detectorInfo.rotation(i);
+    digest.addValue(rotation.real());
+    digest.addValue(rotation.imagI());
+    digest.addValue(rotation.imagJ());
+    digest.addValue(rotation.imagK());
+    digest.addValue(detectorInfo.isMasked(i));
+  }
+}
+
+void addMatrixWorkspace(Digest &digest, const MatrixWorkspace &workspace) {
+  const auto numberOfHistograms = workspace.getNumberHistograms();
+  digest.addValue(numberOfHistograms);
+  const auto xUnit = workspace.getAxis(0)->unit();
+  digest.add(xUnit ? xUnit->unitID() : "");
+  digest.add(workspace.YUnit());
+  digest.addValue(workspace.isDistribution());
+
+  const auto *events = dynamic_cast<const IEventWorkspace *>(&workspace);
+  for (size_t i = 0; i < numberOfHistograms; ++i) {
+    const auto &spectrum = workspace.getSpectrum(i);
+    digest.addValue(spectrum.getSpectrumNo());
+    const auto &detectorIDs = spectrum.getDetectorIDs();
+    digest.addVector(
+        std::vector<detid_t>(detectorIDs.cbegin(), detectorIDs.cend()));
+    digest.addVector(spectrum.readX());
+    if (events) {
+      const auto &eventList = events->getSpectrum(i);
+      digest.addVector(eventList.getTofs());
+      digest.addVector(eventList.getWeights());
+      digest.addVector(eventList.getWeightErrors());
+      for (const auto &pulseTime : eventList.getPulseTimes())
+        digest.addValue(pulseTime.totalNanoseconds());
+    } else {
+      digest.addVector(spectrum.readY());
+      digest.addVector(spectrum.readE());
+      if (spectrum.hasDx())
+        digest.addVector(spectrum.readDx());
+    }
+    if (workspace.hasMaskedBins(i)) {
+      for (const auto &bin : workspace.maskedBins(i)) {
+        digest.addValue(bin.first);
+        digest.addValue(bin.second);
+      }
+    }
+  }
+
+  const auto *verticalAxis = workspace.getAxis(1);
+  if (verticalAxis->isNumeric()) {
+    for (size_t i = 0; i < verticalAxis->length(); ++i)
+      digest.addValue((*verticalAxis)(i));
+  }
+  addInstrument(digest, workspace);
+  addSample(digest, workspace.sample());
+  addRun(digest, workspace.run());
+}
+
+void addTable(Digest &digest, const ITableWorkspace &table) {
+  digest.addValue(table.rowCount());
+  for (size_t col = 0; col < table.columnCount(); ++col) {
+    const auto column = table.getColumn(col);
+    digest.add(column->name());
+    digest.add(column->type());
+    std::ostringstream cells;
+    for (size_t row = 0; row < table.rowCount(); ++row) {
+      column->print(row, cells);
+      cells << '\n';
+    }
+    digest.add(cells.str());
+  }
+}
+
+/// Add a workspace to a digest. Returns false if it can not be hashed.
+bool addWorkspace(Digest &digest, const Workspace &workspace) {
+  digest.add(workspace.id());
+  if (const auto *group = dynamic_cast<const WorkspaceGroup *>(&workspace)) {
+    for (size_t i = 0; i < group->size(); ++i) {
+      if (!addWorkspace(digest, *group->getItem(i)))
+        return false;
+    }
+  } else if (const auto *matrix =
+                 dynamic_cast<const MatrixWorkspace *>(&workspace)) {
+    addMatrixWorkspace(digest, *matrix);
+  } else if (const auto *table =
+                 dynamic_cast<const ITableWorkspace *>(&workspace)) {
+    addTable(digest, *table);
+  } else {
+    return false;
+  }
+  addHistory(digest, workspace.getHistory());
+  return true;
+}
+
+/// The path of a file or directory in a directory
+std::string pathIn(const std::string &directory, const std::string &name) {
+  Poco::Path path(directory);
+  path.makeDirectory();
+  path.setFileName(name);
+  return path.toString();
+}
+
+/// The total size of the files in a directory
+uint64_t directorySize(const Poco::File &directory) {
+  std::vector<Poco::File> files;
+  directory.list(files);
+  uint64_t size(0);
+  for (const auto &file : files)
+    size += file.getSize();
+  return size;
+}
+
+/// Remove a directory, logging rather than throwing on failure
+void removeDirectory(const std::string &path) {
+  try {
+    Poco::File directory(path);
+    if (directory.exists())
+      directory.remove(true);
+  } catch (Poco::Exception &ex) {
+    g_log.warning() << "Unable to remove " << path << ": "
+                    << ex.displayText() << '\n';
+  }
+}
+} // namespace
+
+/**
+ * Constructor
+ * @param directory :: The directory holding the entries. It is created when
+ * the first entry is stored.
+ * @param maxSize :: The size in bytes the entries may take
+ */
+AlgorithmResultCache::AlgorithmResultCache(const std::string &directory,
+                                           uint64_t maxSize)
+    : m_directory(directory), m_maxSize(maxSize) {}
+
+/**
+ * Key an execution of an algorithm whose properties have been set
+ * @param alg :: The algorithm
+ * @return The key, or an empty string if the execution can not be cached
+ */
+std::string AlgorithmResultCache::key(const Algorithm &alg) {
+  if (!alg.cacheable())
+    return "";
+  Digest digest;
+  digest.add(alg.name());
+  digest.addValue(alg.version());
+  for (const auto *prop : alg.getProperties()) {
+    // Outputs are ignored so that the names they are given do not matter
+    if (prop->direction() == Kernel::Direction::Output)
+      continue;
+    digest.add(prop->name());
+    if (const auto *wsProp = dynamic_cast<const IWorkspaceProperty *>(prop)) {
+      if (prop->direction() == Kernel::Direction::InOut)
+        return "";
+      const auto workspace = wsProp->getWorkspace();
+      if (!workspace) {
+        digest.add(prop->value());
+        continue;
+      }
+      const auto hash = contentHash(*workspace);
+      if (hash.empty())
+        return "";
+      digest.add(hash);
+      continue;
+    }
+    digest.add(prop->value());
+    // A file may change without its name changing
+    const auto *fileProp = dynamic_cast<const FileProperty *>(prop);
+    if (fileProp && fileProp->isLoadProperty() && !prop->value().empty()) {
+      try {
+        Poco::File file(prop->value());
+        if (file.exists()) {
+          digest.addValue(static_cast<uint64_t>(file.getSize()));
+          digest.addValue(file.getLastModified().epochMicroseconds());
+        }
+      } catch (Poco::Exception &) {
+        return "";
+      }
+    }
+  }
+  return digest.hex();
+}
+
+/**
+ * Hash the contents of a workspace. The hash covers the data, the spectrum
+ * to detector mapping, the instrument and its parameters, the sample, the
+ * logs and the history of the workspace.
+ * @param workspace :: A matrix workspace, table workspace or group of them
+ * @return The hash, or an empty string for other workspace types
+ */
+std::string AlgorithmResultCache::contentHash(const Workspace &workspace) {
+  Digest digest;
+  if (!addWorkspace(digest, workspace))
+    return "";
+  return digest.hex();
+}
+
+/**
+ * Set the outputs of an algorithm from the cache
+ * @param alg :: The algorithm, with its input properties set
+ * @param key :: The key of the execution, see key()
+ * @return True if the entry was found and the outputs have been set. If
+ * false the outputs are left untouched.
+ */
+bool AlgorithmResultCache::restore(Algorithm &alg,
+                                   const std::string &key) const {
+  if (key.empty())
+    return false;
+  const auto entry = entryPath(key);
+  std::vector<std::pair<std::string, Workspace_sptr>> workspaces;
+  std::vector<std::pair<std::string, std::string>> values;
+  try {
+    std::ifstream outputs(pathIn(entry, OUTPUTS_FILE).c_str());
+    if (!outputs)
+      return false;
+    // Load everything before setting any output so a damaged entry leaves
+    // the algorithm untouched
+    std::string line;
+    while (std::getline(outputs, line)) {
+      const auto tab = line.find('\t');
+      const std::string kind = line.substr(0, tab);
+      const std::string rest =
+          tab == std::string::npos ? "" : line.substr(tab + 1);
+      if (kind == "workspace") {
+        auto loader =
+            AlgorithmManager::Instance().createUnmanaged("LoadNexusProcessed");
+        loader->initialize();
+        loader->setChild(true);
+        loader->setLogging(false);
+        loader->setPropertyValue("Filename", pathIn(entry, rest + ".nxs"));
+        loader->setPropertyValue("OutputWorkspace", "__cached_" + rest);
+        loader->execute();
+        Workspace_sptr workspace = loader->getProperty("OutputWorkspace");
+        // The history is rebuilt for this execution as usual
+        workspace->history().clearHistory();
+        workspaces.emplace_back(rest, workspace);
+      } else if (kind == "value") {
+        const auto valueTab = rest.find('\t');
+        if (valueTab == std::string::npos)
+          throw std::runtime_error("Malformed " + OUTPUTS_FILE);
+        values.emplace_back(rest.substr(0, valueTab),
+                            rest.substr(valueTab + 1));
+      } else {
+        throw std::runtime_error("Malformed " + OUTPUTS_FILE);
+      }
+    }
+  } catch (std::exception &ex) {
+    g_log.warning() << "Unable to restore " << alg.name()
+                    << " from the result cache entry " << entry << ": "
+                    << ex.what() << '\n';
+    return false;
+  }
+
+  for (const auto &workspace : workspaces)
+    alg.setProperty(workspace.first, workspace.second);
+  for (const auto &value : values)
+    alg.setPropertyValue(value.first, value.second);
+  try {
+    // Mark the entry as recently used
+    Poco::File(entry).setLastModified(Poco::Timestamp());
+  } catch (Poco::Exception &) {
+  }
+  return true;
+}
+
+/**
+ * Store the outputs of an executed algorithm, then remove the least recently
+ * used entries if the cache is over its size limit
+ * @param alg :: The algorithm, after exec() has run
+ * @param key :: The key of the execution, see key()
+ * @return True if the outputs are in the cache
+ */
+bool AlgorithmResultCache::store(const Algorithm &alg,
+                                 const std::string &key) const {
+  if (key.empty())
+    return false;
+  const auto entry = entryPath(key);
+  // Entries are written to a staging directory and renamed so that a
+  // partial entry is never seen
+  const auto staging = Poco::TemporaryFile::tempName(m_directory);
+  try {
+    if (Poco::File(entry).exists())
+      return true;
+    Poco::File(staging).createDirectories();
+    std::ofstream outputs(pathIn(staging, OUTPUTS_FILE).c_str());
+    for (const auto *prop : alg.getProperties()) {
+      if (prop->direction() != Kernel::Direction::Output)
+        continue;
+      if (const auto *wsProp = dynamic_cast<const IWorkspaceProperty *>(prop)) {
+        const auto workspace = wsProp->getWorkspace();
+        if (!workspace)
+          continue;
+        if (dynamic_cast<const WorkspaceGroup *>(workspace.get()))
+          throw std::runtime_error("Output groups are not cached");
+        auto saver =
+            AlgorithmManager::Instance().createUnmanaged("SaveNexusProcessed");
+        saver->initialize();
+        saver->setChild(true);
+        saver->setLogging(false);
+        saver->setProperty("InputWorkspace", workspace);
+        saver->setPropertyValue("Filename",
+                                pathIn(staging, prop->name() + ".nxs"));
+        saver->execute();
+        outputs << "workspace\t" << prop->name() << '\n';
+      } else {
+        const auto value = prop->value();
+        if (value.find('\n') != std::string::npos)
+          throw std::runtime_error("Output " + prop->name() +
+                                   " spans several lines");
+        outputs << "value\t" << prop->name() << '\t' << value << '\n';
+      }
+    }
+    outputs.close();
+    if (!outputs)
+      throw std::runtime_error("Unable to write " + OUTPUTS_FILE);
+    Poco::File(staging).renameTo(entry);
+  } catch (std::exception &ex) {
+    g_log.debug() << "Not caching the outputs of " << alg.name() << ": "
+                  << ex.what() << '\n';
+    removeDirectory(staging);
+    return false;
+  }
+  evict();
+  return true;
+}
+
+/**
+ * @return The size in bytes of the entries in the cache
+ */
+uint64_t AlgorithmResultCache::size() const {
+  Poco::File directory(m_directory);
+  if (!directory.exists())
+    return 0;
+  std::vector<Poco::File> entries;
+  directory.list(entries);
+  uint64_t total(0);
+  for (const auto &entry : entries) {
+    if (entry.isDirectory())
+      total += directorySize(entry);
+  }
+  return total;
+}
+
+/// Remove the least recently used entries until the cache fits its limit
+void AlgorithmResultCache::evict() const {
+  std::vector<std::tuple<Poco::Timestamp, uint64_t, std::string>> entries;
+  uint64_t total(0);
+  try {
+    std::vector<Poco::File> files;
+    Poco::File(m_directory).list(files);
+    for (const auto &file : files) {
+      // Skip staging directories of entries being stored
+      if (!file.isDirectory() ||
+          !Poco::File(pathIn(file.path(), OUTPUTS_FILE)).exists())
+        continue;
+      const auto size = directorySize(file);
+      entries.emplace_back(file.getLastModified(), size, file.path());
+      total += size;
+    }
+  } catch (Poco::Exception &ex) {
+    // Another process may be removing entries at the same time
+    g_log.debug() << "Unable to list the result cache: " << ex.displayText()
+                  << '\n';
+    return;
+  }
+  if (total <= m_maxSize)
+    return;
+  std::sort(entries.begin(), entries.end());
+  for (const auto &entry : entries) {
+    if (total <= m_maxSize)
+      break;
+    removeDirectory(std::get<2>(entry));
+    total -= std::get<1>(entry);
+  }
+}
+
+/// @return The path of the directory holding an entry
+std::string AlgorithmResultCache::entryPath(const std::string &key) const {
+  return pathIn(m_directory, key);
+}
+
+} // namespace API
+} // namespace Mantid
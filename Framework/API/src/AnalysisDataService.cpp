@@ -5,13 +5,53 @@
 //     & Institut Laue - Langevin
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/WorkspaceGroup.h"
+#include "MantidKernel/ConfigService.h"
+
+#include <boost/make_shared.hpp>
+
+#include <Poco/Exception.h>
+#include <Poco/File.h>
+#include <Poco/TemporaryFile.h>
+
+#include <exception>
 #include <iterator>
 #include <sstream>
 
 namespace Mantid {
 namespace API {
 
+namespace {
+/// Logger
+Kernel::Logger g_memoryLog("AnalysisDataService");
+
+/**
+ * Stands in for a workspace that has been written to a scratch file. It keeps
+ * the name visible in the service while the data are out of memory. It is
+ * replaced by the reloaded workspace when retrieved.
+ */
+class SpilledWorkspace : public Workspace {
+public:
+  SpilledWorkspace(const Workspace &original)
+      : Workspace(original), m_id(original.id()) {}
+  const std::string id() const override { return m_id; }
+  const std::string toString() const override {
+    return "A " + m_id + " currently spilled to disk\n";
+  }
+  size_t getMemorySize() const override { return 0; }
+
+private:
+  SpilledWorkspace *doClone() const override {
+    throw std::runtime_error("Cannot clone a spilled workspace.");
+  }
+  SpilledWorkspace *doCloneEmpty() const override {
+    throw std::runtime_error("Cannot clone a spilled workspace.");
+  }
+  const std::string m_id;
+};
+} // namespace
+
 //-------------------------------------------------------------------------
 // Nested class methods
 //-------------------------------------------------------------------------
@@ -78,26 +118,45 @@ void AnalysisDataServiceImpl::add(
   if (workspace)
     workspace->setName(name);
   Kernel::DataService<API::Workspace>::add(name, workspace);
+  account(name, workspace);
 
   // if a group is added add its members as well
-  auto group = boost::dynamic_pointer_cast<WorkspaceGroup>(workspace);
-  if (!group)
-    return;
-  group->observeADSNotifications(true);
-  for (size_t i = 0; i < group->size(); ++i) {
-    auto ws = group->getItem(i);
-    std::string wsName = ws->getName();
-    // if anonymous make up a name and add
-    if (wsName.empty()) {
-      wsName = name + "_" + std::to_string(i + 1);
-    } else if (doesExist(wsName)) { // if ws is already there do nothing
-      wsName.clear();
-    }
-    // add member workspace if needed
-    if (!wsName.empty()) {
-      add(wsName, ws);
-    }
+  if (auto group = boost::dynamic_pointer_cast<WorkspaceGroup>(workspace))
+    addGroupMembers(name, *group);
+}
+
+/**
+ * Overridden addBatch member to attach the names to the workspaces. The
+ * members of any groups are added too.
+ * @param workspaces Pairs of names and shared pointers to the workspaces
+ */
+void AnalysisDataServiceImpl::addBatch(
+    const std::vector<NamedObject> &workspaces) {
+  for (const auto &item : workspaces) {
+    verifyName(item.first);
+  }
+  for (const auto &item : workspaces) {
+    if (item.second)
+      item.second->setName(item.first);
+  }
+  std::exception_ptr error;
+  try {
+    Kernel::DataService<API::Workspace>::addBatch(workspaces);
+  } catch (const std::runtime_error &) {
+    // account for those that were added before reporting the failure
+    error = std::current_exception();
+  }
+  for (const auto &item : workspaces) {
+    if (!Kernel::DataService<API::Workspace>::doesExist(item.first) ||
+        Kernel::DataService<API::Workspace>::retrieve(item.first) !=
+            item.second)
+      continue;
+    account(item.first, item.second);
+    if (auto group = boost::dynamic_pointer_cast<WorkspaceGroup>(item.second))
+      addGroupMembers(item.first, *group);
   }
+  if (error)
+    std::rethrow_exception(error);
 }
 
 /**
@@ -116,7 +175,9 @@ void AnalysisDataServiceImpl::addOrReplace(
   // Attach the name to the workspace
   if (workspace)
     workspace->setName(name);
+  discardSpillFile(name);
   Kernel::DataService<API::Workspace>::addOrReplace(name, workspace);
+  account(name, workspace);
 
   // if a group is added add its members as well
   auto group = boost::dynamic_pointer_cast<WorkspaceGroup>(workspace);
@@ -147,9 +208,12 @@ void AnalysisDataServiceImpl::addOrReplace(
  */
 void AnalysisDataServiceImpl::rename(const std::string &oldName,
                                      const std::string &newName) {
+  if (doesExist(oldName))
+    discardSpillFile(newName);
   Kernel::DataService<API::Workspace>::rename(oldName, newName);
+  m_memoryLedger.rename(oldName, newName);
   // Attach the new name to the workspace
-  auto ws = retrieve(newName);
+  auto ws = Kernel::DataService<API::Workspace>::retrieve(newName);
   ws->setName(newName);
 }
 
@@ -161,16 +225,93 @@ void AnalysisDataServiceImpl::rename(const std::string &oldName,
 void AnalysisDataServiceImpl::remove(const std::string &name) {
   Workspace_sptr ws;
   try {
-    ws = retrieve(name);
+    ws = Kernel::DataService<API::Workspace>::retrieve(name);
   } catch (const Kernel::Exception::NotFoundError &) {
     // do nothing - remove will do what's needed
   }
+  discardSpillFile(name);
   Kernel::DataService<API::Workspace>::remove(name);
+  m_memoryLedger.remove(name);
   if (ws) {
     ws->setName("");
   }
 }
 
+/**
+ * Overridden removeBatch member to delete the names held by the workspaces.
+ * @param names The names of the workspaces to remove.
+ */
+void AnalysisDataServiceImpl::removeBatch(
+    const std::vector<std::string> &names) {
+  std::vector<Workspace_sptr> workspaces;
+  workspaces.reserve(names.size());
+  for (const auto &name : names) {
+    if (!Kernel::DataService<API::Workspace>::doesExist(name))
+      continue;
+    workspaces.push_back(Kernel::DataService<API::Workspace>::retrieve(name));
+    discardSpillFile(name);
+  }
+  Kernel::DataService<API::Workspace>::removeBatch(names);
+  for (const auto &name : names) {
+    m_memoryLedger.remove(name);
+  }
+  for (const auto &ws : workspaces) {
+    ws->setName("");
+  }
+}
+
+/**
+ * Overridden retrieve member. Marks the workspace as recently used and, if it
+ * has been spilled to disk, loads it back into memory before returning it.
+ * @param name The name of the workspace
+ * @return A pointer to the workspace
+ * @throws Kernel::Exception::NotFoundError if the name does not exist
+ */
+Workspace_sptr
+AnalysisDataServiceImpl::retrieve(const std::string &name) const {
+  auto ws = Kernel::DataService<API::Workspace>::retrieve(name);
+  if (m_memoryLedger.isSpilled(name)) {
+    ws = resolve(ws);
+  } else {
+    m_memoryLedger.touch(name);
+  }
+  return ws;
+}
+
+/**
+ * Overridden getObjects member. Workspaces that have been spilled to disk are
+ * loaded back so that only real workspaces are returned.
+ * @param includeHidden Whether to include hidden workspaces
+ * @return The workspaces in the service ordered by name
+ */
+std::vector<Workspace_sptr> AnalysisDataServiceImpl::getObjects(
+    Kernel::DataServiceHidden includeHidden) const {
+  auto workspaces =
+      Kernel::DataService<API::Workspace>::getObjects(includeHidden);
+  for (auto &ws : workspaces) {
+    if (isSpilledPlaceholder(ws))
+      ws = resolve(ws);
+  }
+  return workspaces;
+}
+
+/**
+ * Overridden clear member. Removes all workspaces, any scratch files of
+ * spilled workspaces and resets the memory ledger.
+ */
+void AnalysisDataServiceImpl::clear() {
+  {
+    std::lock_guard<std::recursive_mutex> lock(m_spillMutex);
+    for (const auto &name :
+         getObjectNames(Kernel::DataServiceSort::Unsorted,
+                        Kernel::DataServiceHidden::Include)) {
+      discardSpillFile(name);
+    }
+    m_memoryLedger.clear();
+  }
+  Kernel::DataService<API::Workspace>::clear();
+}
+
 /**
  * @brief Given a list of names retrieve the corresponding workspace handles
  * @param names A list of names of workspaces, if any does not exist then
@@ -186,9 +327,13 @@ std::vector<Workspace_sptr> AnalysisDataServiceImpl::retrieveWorkspaces(
   using WorkspacesVector = std::vector<Workspace_sptr>;
   WorkspacesVector workspaces;
   workspaces.reserve(names.size());
-  std::transform(
-      std::begin(names), std::end(names), std::back_inserter(workspaces),
-      [this](const std::string &name) { return this->retrieve(name); });
+  // Look every name up before loading anything back from disk so that a
+  // missing name is reported without reloading the others first
+  std::transform(std::begin(names), std::end(names),
+                 std::back_inserter(workspaces),
+                 [this](const std::string &name) {
+                   return Kernel::DataService<API::Workspace>::retrieve(name);
+                 });
   assert(names.size() == workspaces.size());
   if (unrollGroups) {
     using IteratorDifference =
@@ -208,6 +353,12 @@ std::vector<Workspace_sptr> AnalysisDataServiceImpl::retrieveWorkspaces(
       }
     }
   }
+  for (auto &ws : workspaces) {
+    if (isSpilledPlaceholder(ws))
+      ws = resolve(ws);
+    else
+      m_memoryLedger.touch(ws->getName());
+  }
   return workspaces;
 }
 
@@ -222,7 +373,7 @@ void AnalysisDataServiceImpl::sortGroupByName(const std::string &groupName) {
                              " is not a workspace group.");
   }
   group->sortMembersByName();
-  notificationCenter.postNotification(new GroupUpdatedNotification(groupName));
+  postNotification(new GroupUpdatedNotification(groupName));
 }
 
 /**
@@ -239,7 +390,7 @@ void AnalysisDataServiceImpl::addToGroup(const std::string &groupName,
   }
   auto ws = retrieve(wsName);
   group->addWorkspace(ws);
-  notificationCenter.postNotification(new GroupUpdatedNotification(groupName));
+  postNotification(new GroupUpdatedNotification(groupName));
 }
 
 /**
@@ -284,7 +435,7 @@ void AnalysisDataServiceImpl::removeFromGroup(const std::string &groupName,
                              " does not containt workspace " + wsName);
   }
   group->removeByADS(wsName);
-  notificationCenter.postNotification(new GroupUpdatedNotification(groupName));
+  postNotification(new GroupUpdatedNotification(groupName));
 }
 
 /**
@@ -301,7 +452,8 @@ AnalysisDataServiceImpl::topLevelItems() const {
   for (const auto &topLevelName : topLevelNames) {
     try {
       const std::string &name = topLevelName;
-      auto ws = this->retrieve(topLevelName);
+      // Listing the items must not load spilled workspaces back
+      auto ws = Kernel::DataService<API::Workspace>::retrieve(topLevelName);
       topLevel.emplace(name, ws);
       if (auto group = boost::dynamic_pointer_cast<WorkspaceGroup>(ws)) {
         group->reportMembers(groupMembers);
@@ -323,7 +475,32 @@ AnalysisDataServiceImpl::topLevelItems() const {
   return topLevel;
 }
 
-void AnalysisDataServiceImpl::shutdown() { clear(); }
+/**
+ * Overridden shutdown member. Removes all workspaces and waits for any
+ * notifications still to be delivered asynchronously.
+ */
+void AnalysisDataServiceImpl::shutdown() {
+  Kernel::DataService<API::Workspace>::shutdown();
+}
+
+/**
+ * Set the memory the workspaces in the service may hold before the least
+ * recently used ones are spilled to disk. The initial value is taken from the
+ * AnalysisDataService.MemoryBudgetMB configuration key.
+ * @param bytes The budget in bytes. 0 means unlimited.
+ */
+void AnalysisDataServiceImpl::setMemoryBudget(size_t bytes) {
+  m_memoryBudget = bytes;
+  enforceMemoryBudget("");
+}
+
+/// @return The memory budget in bytes. 0 means unlimited.
+size_t AnalysisDataServiceImpl::memoryBudget() const { return m_memoryBudget; }
+
+/// @return The ledger accounting for the memory held by each workspace
+const WorkspaceMemoryLedger &AnalysisDataServiceImpl::memoryLedger() const {
+  return m_memoryLedger;
+}
 
 //-------------------------------------------------------------------------
 // Private methods
@@ -335,7 +512,12 @@ void AnalysisDataServiceImpl::shutdown() { clear(); }
 AnalysisDataServiceImpl::AnalysisDataServiceImpl()
     : Mantid::Kernel::DataService<Mantid::API::Workspace>(
           "AnalysisDataService"),
-      m_illegalChars() {}
+      m_illegalChars(), m_memoryLedger(), m_memoryBudget(0) {
+  const auto budgetMB = Kernel::ConfigService::Instance().getValue<double>(
+      "AnalysisDataService.MemoryBudgetMB");
+  if (budgetMB.get_value_or(0.) > 0.)
+    m_memoryBudget = static_cast<size_t>(budgetMB.get() * 1024. * 1024.);
+}
 
 // The following is commented using /// rather than /** to stop the compiler
 // complaining
@@ -359,6 +541,31 @@ void AnalysisDataServiceImpl::setIllegalCharacterList(
   m_illegalChars = illegalChars;
 }
 
+/**
+ * Add the members of a group that are not yet in the service. Anonymous
+ * members are named after the group.
+ * @param name The name of the group
+ * @param group The group that has been added
+ */
+void AnalysisDataServiceImpl::addGroupMembers(const std::string &name,
+                                              WorkspaceGroup &group) {
+  group.observeADSNotifications(true);
+  for (size_t i = 0; i < group.size(); ++i) {
+    auto ws = group.getItem(i);
+    std::string wsName = ws->getName();
+    // if anonymous make up a name and add
+    if (wsName.empty()) {
+      wsName = name + "_" + std::to_string(i + 1);
+    } else if (doesExist(wsName)) { // if ws is already there do nothing
+      wsName.clear();
+    }
+    // add member workspace if needed
+    if (!wsName.empty()) {
+      add(wsName, ws);
+    }
+  }
+}
+
 /**
  * Checks the name is valid
  * @param name A string containing the name to check. If the name is invalid a
@@ -371,5 +578,179 @@ void AnalysisDataServiceImpl::verifyName(const std::string &name) {
   }
 }
 
+/**
+ * Record the memory held by a workspace that has just been stored and spill
+ * others if the budget is exceeded.
+ * @param name The name the workspace is stored under
+ * @param workspace The stored workspace
+ */
+void AnalysisDataServiceImpl::account(const std::string &name,
+                                      const Workspace_sptr &workspace) {
+  m_memoryLedger.record(name, workspace);
+  enforceMemoryBudget(name);
+}
+
+/**
+ * Refresh the ledger entries of the workspaces held in memory. Workspaces
+ * are commonly modified in place after they have been stored so the blocks
+ * recorded when they were added may no longer be the ones they hold.
+ */
+void AnalysisDataServiceImpl::refreshMemoryLedger() {
+  for (const auto &name :
+       getObjectNames(Kernel::DataServiceSort::Unsorted,
+                      Kernel::DataServiceHidden::Include)) {
+    if (m_memoryLedger.isSpilled(name))
+      continue;
+    try {
+      const auto ws = Kernel::DataService<API::Workspace>::retrieve(name);
+      m_memoryLedger.update(name, ws);
+    } catch (const Kernel::Exception::NotFoundError &) {
+      // removed by another thread
+    }
+  }
+}
+
+/**
+ * Spill the least recently used workspaces until the memory held is within
+ * the budget. The ledger is refreshed first so that the decision is based on
+ * the memory the workspaces hold now. Only workspaces referenced by nothing
+ * but the service are spilled since spilling anything else would not release
+ * memory. Groups are never spilled, their members are handled individually.
+ * @param keep The name of a workspace that must stay in memory
+ */
+void AnalysisDataServiceImpl::enforceMemoryBudget(const std::string &keep) {
+  if (m_memoryBudget == 0)
+    return;
+  std::lock_guard<std::recursive_mutex> lock(m_spillMutex);
+  refreshMemoryLedger();
+  for (const auto &name : m_memoryLedger.leastRecentlyUsed()) {
+    if (m_memoryLedger.totalMemory() <= m_memoryBudget)
+      break;
+    if (boost::iequals(name, keep))
+      continue;
+    Workspace_sptr ws;
+    try {
+      ws = Kernel::DataService<API::Workspace>::retrieve(name);
+    } catch (const Kernel::Exception::NotFoundError &) {
+      continue;
+    }
+    // The service and the local variable are the only owners
+    if (ws->isGroup() || ws.use_count() > 2)
+      continue;
+    if (!spill(name, ws)) // do not try again until the workspace changes
+      m_memoryLedger.markUnspillable(name);
+  }
+}
+
+/**
+ * Write a workspace to a scratch file in the NeXus processed format and
+ * replace it in the service with a placeholder.
+ * @param name The name of the workspace
+ * @param workspace The workspace to spill
+ * @return True if the workspace was spilled
+ */
+bool AnalysisDataServiceImpl::spill(const std::string &name,
+                                    const Workspace_sptr &workspace) {
+  const auto directory = Kernel::ConfigService::Instance().getString(
+      "AnalysisDataService.SpillDirectory");
+  const auto filename = Poco::TemporaryFile::tempName(directory) + ".nxs";
+  try {
+    auto saver =
+        AlgorithmManager::Instance().createUnmanaged("SaveNexusProcessed");
+    saver->initialize();
+    saver->setChild(true);
+    saver->setLogging(false);
+    saver->setProperty("InputWorkspace", workspace);
+    saver->setPropertyValue("Filename", filename);
+    saver->execute();
+  } catch (const std::exception &exc) {
+    g_memoryLog.warning() << "Unable to spill workspace '" << name
+                          << "' to disk, it will be kept in memory: "
+                          << exc.what() << '\n';
+    Poco::File file(filename);
+    if (file.exists())
+      file.remove();
+    return false;
+  }
+  auto placeholder = boost::make_shared<SpilledWorkspace>(*workspace);
+  placeholder->setName(name);
+  replaceSilently(name, placeholder);
+  m_memoryLedger.markSpilled(name, filename);
+  g_memoryLog.debug() << "Spilled workspace '" << name << "' to " << filename
+                      << '\n';
+  return true;
+}
+
+/**
+ * Load a spilled workspace from its scratch file and put it back in the
+ * service under its name. Other workspaces may be spilled to make room.
+ * @param name The name of the workspace
+ * @return The reloaded workspace
+ * @throws std::runtime_error if the workspace cannot be loaded
+ */
+Workspace_sptr AnalysisDataServiceImpl::reload(const std::string &name) {
+  std::lock_guard<std::recursive_mutex> lock(m_spillMutex);
+  const auto filename = m_memoryLedger.spillFile(name);
+  if (filename.empty()) // another thread got here first
+    return Kernel::DataService<API::Workspace>::retrieve(name);
+
+  auto loader =
+      AlgorithmManager::Instance().createUnmanaged("LoadNexusProcessed");
+  loader->initialize();
+  loader->setChild(true);
+  loader->setLogging(false);
+  loader->setPropertyValue("Filename", filename);
+  loader->setPropertyValue("OutputWorkspace", name);
+  loader->execute();
+  Workspace_sptr ws = loader->getProperty("OutputWorkspace");
+  ws->setName(name);
+  replaceSilently(name, ws);
+  account(name, ws);
+  Poco::File(filename).remove();
+  g_memoryLog.debug() << "Reloaded workspace '" << name << "' from "
+                      << filename << '\n';
+  return ws;
+}
+
+/**
+ * @param workspace A workspace stored in the service
+ * @return True if the workspace stands in for one spilled to disk
+ */
+bool AnalysisDataServiceImpl::isSpilledPlaceholder(
+    const Workspace_sptr &workspace) {
+  return dynamic_cast<const SpilledWorkspace *>(workspace.get()) != nullptr;
+}
+
+/**
+ * Load the workspace a placeholder stands in for back into memory.
+ * @param placeholder The placeholder stored in the service
+ * @return The reloaded workspace, or the workspace now stored under the name
+ * if it has changed in the meantime
+ */
+Workspace_sptr
+AnalysisDataServiceImpl::resolve(const Workspace_sptr &placeholder) const {
+  // Reloading restores the content the service is expected to hold so it
+  // is logically const
+  return const_cast<AnalysisDataServiceImpl *>(this)->reload(
+      placeholder->getName());
+}
+
+/**
+ * Delete the scratch file of a workspace if it has been spilled.
+ * @param name The name of the workspace
+ */
+void AnalysisDataServiceImpl::discardSpillFile(const std::string &name) {
+  const auto filename = m_memoryLedger.spillFile(name);
+  if (filename.empty())
+    return;
+  try {
+    Poco::File file(filename);
+    if (file.exists())
+      file.remove();
+  } catch (const Poco::Exception &) {
+    g_memoryLog.warning() << "Unable to remove spill file " << filename << '\n';
+  }
+}
+
 } // Namespace API
 } // Namespace Mantid
@@ -145,18 +145,17 @@ void CompositeFunction::setMatrixWorkspace(
   }
 }
 
-/** Function you want to fit to.
+/** Function you want to fit to. The members add their values straight into
+ * the output.
  *  @param domain :: An instance of FunctionDomain with the function arguments.
  *  @param values :: A FunctionValues instance for storing the calculated
  * values.
  */
 void CompositeFunction::function(const FunctionDomain &domain,
                                  FunctionValues &values) const {
-  FunctionValues tmp(domain);
   values.zeroCalculated();
   for (size_t iFun = 0; iFun < nFunctions(); ++iFun) {
-    m_functions[iFun]->function(domain, tmp);
-    values += tmp;
+    m_functions[iFun]->functionAdd(domain, values);
   }
 }
 
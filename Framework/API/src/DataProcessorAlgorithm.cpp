@@ -8,6 +8,7 @@
 #include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/AlgorithmProperty.h"
 #include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/DataflowExecutor.h"
 #include "MantidAPI/FileFinder.h"
 #include "MantidAPI/IEventWorkspace.h"
 #include "MantidAPI/ITableWorkspace.h"
@@ -305,6 +306,19 @@ void GenericDataProcessorAlgorithm<Base>::saveNexus(
   }
 }
 
+/**
+ * Run a graph of child algorithms created with createChildAlgorithm,
+ * executing the branches that do not depend on each other concurrently. The
+ * critical path through the graph is logged.
+ * @param graph :: The child algorithms and their dependencies
+ */
+template <class Base>
+void GenericDataProcessorAlgorithm<Base>::executeDataflow(
+    DataflowExecutor &graph) {
+  graph.execute();
+  Base::getLogger().information() << graph.criticalPathReport() << '\n';
+}
+
 /// Return true if we are running on the main thread
 template <class Base> bool GenericDataProcessorAlgorithm<Base>::isMainThread() {
   bool mainThread;
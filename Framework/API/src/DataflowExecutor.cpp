@@ -0,0 +1,415 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/DataflowExecutor.h"
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/IWorkspaceProperty.h"
+#include "MantidAPI/Workspace.h"
+#include "MantidKernel/CaseInsensitiveMap.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Timer.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace Mantid {
+namespace API {
+namespace {
+/// The algorithms reading and writing a workspace, in the order added
+struct Access {
+  bool written = false;
+  DataflowExecutor::NodeId writer = 0;
+  std::vector<DataflowExecutor::NodeId> readers;
+};
+
+/// @return The workspace property with the given name or nullptr
+IWorkspaceProperty *workspaceProperty(const Algorithm &algorithm,
+                                      const std::string &name) {
+  return dynamic_cast<IWorkspaceProperty *>(
+      algorithm.getPointerToProperty(name));
+}
+} // namespace
+
+/**
+ * Add an algorithm to the graph. It should be initialized and have its
+ * properties set, other than inputs supplied by connections.
+ * @param algorithm :: The algorithm
+ * @return The identifier of the algorithm in the graph
+ * @throws std::invalid_argument if the algorithm is null or already added
+ */
+DataflowExecutor::NodeId
+DataflowExecutor::add(const boost::shared_ptr<Algorithm> &algorithm) {
+  if (!algorithm)
+    throw std::invalid_argument("DataflowExecutor::add - null algorithm");
+  if (std::any_of(m_nodes.cbegin(), m_nodes.cend(),
+                  [&algorithm](const Node &node) {
+                    return node.algorithm == algorithm;
+                  }))
+    throw std::invalid_argument("DataflowExecutor::add - " +
+                                algorithm->name() + " has already been added");
+  Node node;
+  node.algorithm = algorithm;
+  m_nodes.push_back(std::move(node));
+  return m_nodes.size() - 1;
+}
+
+/**
+ * Pass the workspace in an output property of one algorithm to an input
+ * property of another once the first has run.
+ * @param producer :: The algorithm creating the workspace
+ * @param outputProperty :: The name of its output workspace property
+ * @param consumer :: The algorithm using the workspace
+ * @param inputProperty :: The name of its input workspace property
+ * @throws std::invalid_argument if the properties are not workspace
+ * properties with suitable directions
+ */
+void DataflowExecutor::connect(NodeId producer,
+                               const std::string &outputProperty,
+                               NodeId consumer,
+                               const std::string &inputProperty) {
+  checkNode(producer);
+  checkNode(consumer);
+  const auto &output =
+      *m_nodes[producer].algorithm->getPointerToProperty(outputProperty);
+  if (!dynamic_cast<const IWorkspaceProperty *>(&output) ||
+      output.direction() == Kernel::Direction::Input)
+    throw std::invalid_argument("DataflowExecutor::connect - " +
+                                outputProperty +
+                                " is not an output workspace property");
+  const auto &input =
+      *m_nodes[consumer].algorithm->getPointerToProperty(inputProperty);
+  if (!dynamic_cast<const IWorkspaceProperty *>(&input) ||
+      input.direction() == Kernel::Direction::Output)
+    throw std::invalid_argument("DataflowExecutor::connect - " + inputProperty +
+                                " is not an input workspace property");
+  m_nodes[consumer].inputs.push_back(
+      Connection{producer, outputProperty, inputProperty});
+  addEdge(producer, consumer);
+}
+
+/**
+ * Make an algorithm wait for another that it does not share a workspace with
+ * @param node :: The algorithm that must wait
+ * @param prerequisite :: The algorithm that must run first
+ */
+void DataflowExecutor::addDependency(NodeId node, NodeId prerequisite) {
+  checkNode(node);
+  checkNode(prerequisite);
+  addEdge(prerequisite, node);
+}
+
+/**
+ * Run the algorithms, starting each as soon as the ones it depends on have
+ * finished.
+ * @param maxThreads :: The maximum number of algorithms to run at once. If
+ * less than 1 the number of OpenMP threads is used.
+ * @throws std::runtime_error if the graph has a cycle or has already been
+ * executed. Rethrows the first error raised by an algorithm.
+ */
+void DataflowExecutor::execute(int maxThreads) {
+  if (m_executed)
+    throw std::runtime_error("DataflowExecutor has already been executed");
+  m_executed = true;
+  inferEdges();
+  m_order = topologicalOrder();
+
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::deque<NodeId> ready;
+  std::exception_ptr failure;
+  size_t running(0);
+  bool serialRunning(false);
+
+  for (auto &node : m_nodes)
+    node.pending = node.prerequisites.size();
+  for (NodeId id = 0; id < m_nodes.size(); ++id) {
+    if (m_nodes[id].pending == 0) {
+      prepare(m_nodes[id]);
+      ready.push_back(id);
+    }
+  }
+
+  auto worker = [&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      auto next = ready.end();
+      if (!failure)
+        next = std::find_if(ready.begin(), ready.end(), [&](NodeId id) {
+          return m_nodes[id].threadSafe || !serialRunning;
+        });
+      if (next == ready.end()) {
+        // With nothing running every ready algorithm could be started, so
+        // there is nothing left to do
+        if (running == 0)
+          break;
+        changed.wait(lock);
+        continue;
+      }
+      const NodeId id = *next;
+      ready.erase(next);
+      auto &node = m_nodes[id];
+      ++running;
+      if (!node.threadSafe)
+        serialRunning = true;
+      lock.unlock();
+
+      std::exception_ptr error;
+      Kernel::Timer timer;
+      try {
+        if (!node.algorithm->execute())
+          throw std::runtime_error("Algorithm " + node.algorithm->name() +
+                                   " failed to execute");
+      } catch (...) {
+        error = std::current_exception();
+      }
+      const double duration = timer.elapsed_no_reset();
+
+      lock.lock();
+      node.duration = duration;
+      --running;
+      if (!node.threadSafe)
+        serialRunning = false;
+      if (error) {
+        if (!failure)
+          failure = error;
+      } else {
+        for (const auto dependent : node.dependents) {
+          if (--m_nodes[dependent].pending > 0)
+            continue;
+          try {
+            prepare(m_nodes[dependent]);
+            ready.push_back(dependent);
+          } catch (...) {
+            if (!failure)
+              failure = std::current_exception();
+          }
+        }
+      }
+      changed.notify_all();
+    }
+    changed.notify_all();
+  };
+
+  const size_t nthreads = std::min(
+      m_nodes.size(),
+      static_cast<size_t>(maxThreads > 0 ? maxThreads
+                                         : PARALLEL_GET_MAX_THREADS));
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < nthreads; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (auto &thread : threads)
+    thread.join();
+
+  if (failure)
+    std::rethrow_exception(failure);
+}
+
+/**
+ * @param node :: An algorithm in the graph
+ * @return The algorithm
+ */
+const boost::shared_ptr<Algorithm> &
+DataflowExecutor::algorithm(NodeId node) const {
+  checkNode(node);
+  return m_nodes[node].algorithm;
+}
+
+/**
+ * @param node :: An algorithm in the graph
+ * @return The wall clock time the algorithm took to run in seconds
+ */
+double DataflowExecutor::duration(NodeId node) const {
+  checkNode(node);
+  return m_nodes[node].duration;
+}
+
+/**
+ * The critical path is the chain of dependent algorithms with the longest
+ * total run time. It bounds the time the graph takes to run however many
+ * threads are used.
+ * @return The algorithms on the critical path in the order they ran
+ */
+std::vector<DataflowExecutor::NodeId> DataflowExecutor::criticalPath() const {
+  if (m_order.empty())
+    return {};
+  // The longest time to finish each algorithm and the prerequisite it waited
+  // for longest
+  std::vector<double> finish(m_nodes.size(), 0.);
+  std::vector<NodeId> previous(m_nodes.size(), m_nodes.size());
+  for (const auto id : m_order) {
+    const auto &node = m_nodes[id];
+    double start(0.);
+    for (const auto prerequisite : node.prerequisites) {
+      if (previous[id] == m_nodes.size() || finish[prerequisite] > start) {
+        start = finish[prerequisite];
+        previous[id] = prerequisite;
+      }
+    }
+    finish[id] = start + node.duration;
+  }
+  NodeId last = static_cast<NodeId>(
+      std::max_element(finish.cbegin(), finish.cend()) - finish.cbegin());
+  std::vector<NodeId> path;
+  for (; last != m_nodes.size(); last = previous[last])
+    path.push_back(last);
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+/// @return The total run time of the algorithms on the critical path
+double DataflowExecutor::criticalPathDuration() const {
+  double total(0.);
+  for (const auto id : criticalPath())
+    total += m_nodes[id].duration;
+  return total;
+}
+
+/// @return A description of the critical path suitable for logging
+std::string DataflowExecutor::criticalPathReport() const {
+  std::ostringstream report;
+  report << std::fixed << std::setprecision(2) << "Critical path: ";
+  const auto path = criticalPath();
+  for (auto id = path.cbegin(); id != path.cend(); ++id) {
+    if (id != path.cbegin())
+      report << " -> ";
+    report << m_nodes[*id].algorithm->name() << " (" << m_nodes[*id].duration
+           << "s)";
+  }
+  double total(0.);
+  for (const auto &node : m_nodes)
+    total += node.duration;
+  report << ". " << criticalPathDuration() << "s of " << total
+         << "s spent in " << m_nodes.size() << " algorithms";
+  return report.str();
+}
+
+/// Record that one algorithm must finish before another starts
+void DataflowExecutor::addEdge(NodeId from, NodeId to) {
+  if (from == to)
+    throw std::invalid_argument(
+        "DataflowExecutor - an algorithm cannot depend on itself");
+  auto &prerequisites = m_nodes[to].prerequisites;
+  if (std::find(prerequisites.cbegin(), prerequisites.cend(), from) !=
+      prerequisites.cend())
+    return;
+  prerequisites.push_back(from);
+  m_nodes[from].dependents.push_back(to);
+}
+
+/**
+ * Order algorithms sharing a workspace as they would be if run one after
+ * another in the order they were added.
+ */
+void DataflowExecutor::inferEdges() {
+  Kernel::CaseInsensitiveMap<Access> accesses;
+  for (NodeId id = 0; id < m_nodes.size(); ++id) {
+    const auto &node = m_nodes[id];
+    for (const auto property : node.algorithm->getProperties()) {
+      const auto *wsProperty = dynamic_cast<IWorkspaceProperty *>(property);
+      if (!wsProperty)
+        continue;
+      // Inputs set by a connection are ordered by the connection
+      const auto &name = property->name();
+      if (std::any_of(node.inputs.cbegin(), node.inputs.cend(),
+                      [&name](const Connection &connection) {
+                        return connection.inputProperty == name;
+                      }))
+        continue;
+      // Workspaces are identified by name or, if not named, by object
+      std::string key = property->value();
+      if (key.empty()) {
+        const auto workspace = wsProperty->getWorkspace();
+        if (!workspace)
+          continue;
+        std::ostringstream address;
+        address << '\0' << workspace.get();
+        key = address.str();
+      }
+      auto &access = accesses[key];
+      const auto direction = property->direction();
+      if (direction != Kernel::Direction::Output) {
+        if (access.written && access.writer != id)
+          addEdge(access.writer, id);
+        access.readers.push_back(id);
+      }
+      if (direction != Kernel::Direction::Input) {
+        if (access.written && access.writer != id)
+          addEdge(access.writer, id);
+        for (const auto reader : access.readers) {
+          if (reader != id)
+            addEdge(reader, id);
+        }
+        access.readers.clear();
+        access.written = true;
+        access.writer = id;
+      }
+    }
+  }
+}
+
+/**
+ * @return The algorithms in an order respecting all the dependencies
+ * @throws std::runtime_error if the dependencies form a cycle
+ */
+std::vector<DataflowExecutor::NodeId>
+DataflowExecutor::topologicalOrder() const {
+  std::vector<size_t> pending(m_nodes.size());
+  std::vector<NodeId> order;
+  order.reserve(m_nodes.size());
+  for (NodeId id = 0; id < m_nodes.size(); ++id) {
+    pending[id] = m_nodes[id].prerequisites.size();
+    if (pending[id] == 0)
+      order.push_back(id);
+  }
+  for (size_t i = 0; i < order.size(); ++i) {
+    for (const auto dependent : m_nodes[order[i]].dependents) {
+      if (--pending[dependent] == 0)
+        order.push_back(dependent);
+    }
+  }
+  if (order.size() != m_nodes.size())
+    throw std::runtime_error(
+        "DataflowExecutor - the algorithm dependencies form a cycle");
+  return order;
+}
+
+/**
+ * Set the inputs of an algorithm from the algorithms it is connected to and
+ * decide whether it may run alongside other algorithms.
+ * @param node :: An algorithm whose prerequisites have all run
+ */
+void DataflowExecutor::prepare(Node &node) {
+  auto &algorithm = *node.algorithm;
+  for (const auto &connection : node.inputs) {
+    const auto &producer = *m_nodes[connection.producer].algorithm;
+    Workspace_sptr workspace =
+        workspaceProperty(producer, connection.outputProperty)->getWorkspace();
+    algorithm.setProperty(connection.inputProperty, workspace);
+  }
+  node.threadSafe = algorithm.threadSafe();
+  for (const auto property : algorithm.getProperties()) {
+    const auto *wsProperty = dynamic_cast<IWorkspaceProperty *>(property);
+    if (wsProperty && !Kernel::threadSafe(wsProperty->getWorkspace().get()))
+      node.threadSafe = false;
+  }
+}
+
+/// @throws std::out_of_range if the node is not in the graph
+void DataflowExecutor::checkNode(NodeId node) const {
+  if (node >= m_nodes.size())
+    throw std::out_of_range("DataflowExecutor - unknown algorithm " +
+                            std::to_string(node));
+}
+
+} // namespace API
+} // namespace Mantid
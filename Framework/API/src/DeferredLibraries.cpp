@@ -0,0 +1,133 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/DeferredLibraries.h"
+#include "MantidKernel/LibraryManager.h"
+#include "MantidKernel/Logger.h"
+
+namespace Mantid {
+namespace API {
+namespace {
+/// static logger
+Kernel::Logger g_log("DeferredLibraries");
+
+/// Serialises the opening of deferred libraries across all the factories
+/// since one library registers with several of them
+std::recursive_mutex &openingMutex() {
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+
+/// The deferred libraries that have been opened. Only accessed with the
+/// opening mutex held.
+std::set<std::string> &openedLibraries() {
+  static std::set<std::string> opened;
+  return opened;
+}
+} // namespace
+
+/**
+ * Record that a library registers a name when it is opened
+ * @param name :: The name registered by the library
+ * @param library :: The full path to the library
+ */
+void DeferredLibraries::add(const std::string &name,
+                            const std::string &library) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_libraries[name].insert(library);
+}
+
+/**
+ * Open the libraries that register a name. A name stays deferred until its
+ * libraries have been opened so another thread looking it up meanwhile
+ * waits for the registrations rather than finding nothing.
+ * @param name :: The name being looked up
+ * @return True if any library was opened
+ */
+bool DeferredLibraries::open(const std::string &name) {
+  if (!isDeferred(name))
+    return false;
+  std::lock_guard<std::recursive_mutex> opening(openingMutex());
+  std::set<std::string> libraries;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto entry = m_libraries.find(name);
+    if (entry == m_libraries.end()) // opened by another thread
+      return false;
+    libraries = entry->second;
+  }
+  const bool opened = openLibraries(libraries);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_libraries.erase(name);
+  return opened;
+}
+
+/**
+ * Open every deferred library, e.g. before listing everything registered
+ * @return True if any library was opened
+ */
+bool DeferredLibraries::openAll() {
+  if (empty())
+    return false;
+  std::lock_guard<std::recursive_mutex> opening(openingMutex());
+  std::set<std::string> libraries;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto &entry : m_libraries)
+      libraries.insert(entry.second.cbegin(), entry.second.cend());
+  }
+  const bool opened = openLibraries(libraries);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_libraries.clear();
+  return opened;
+}
+
+/// @return True if there are no deferred libraries
+bool DeferredLibraries::empty() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_libraries.empty();
+}
+
+/// @return The names waiting for a library to be opened. Some may have been
+/// registered meanwhile by opening their library for another name.
+std::vector<std::string> DeferredLibraries::names() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::vector<std::string> names;
+  names.reserve(m_libraries.size());
+  for (const auto &entry : m_libraries)
+    names.push_back(entry.first);
+  return names;
+}
+
+/**
+ * @param name :: A name registered by a library
+ * @return True if the name is waiting for a library to be opened
+ */
+bool DeferredLibraries::isDeferred(const std::string &name) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_libraries.find(name) != m_libraries.end();
+}
+
+/// Open a set of libraries, once each, reporting any that fail. Must be
+/// called with the opening mutex held.
+bool DeferredLibraries::openLibraries(
+    const std::set<std::string> &libraries) const {
+  bool opened = false;
+  for (const auto &library : libraries) {
+    // Another factory may have opened it already
+    if (!openedLibraries().insert(library).second)
+      continue;
+    g_log.debug("Opening deferred library " + library);
+    if (Kernel::LibraryManager::Instance().openLibrary(library))
+      opened = true;
+    else
+      g_log.error("Failed to open library " + library);
+  }
+  return opened;
+}
+
+} // namespace API
+} // namespace Mantid
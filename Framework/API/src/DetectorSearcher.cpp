@@ -6,8 +6,10 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidAPI/DetectorSearcher.h"
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Objects/DetectorBVH.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/NearestNeighbours.h"
+#include "MantidKernel/make_unique.h"
 
 #include <tuple>
 
@@ -118,6 +120,46 @@ DetectorSearcher::findDetectorIndex(const V3D &q) {
   }
 }
 
+/** Find the indices of the detectors for many vectors in Qlab space
+ *
+ * With the ray tracing strategy all the rays are traced in parallel.
+ *
+ * @param qs :: the Qlab vectors to find detectors for
+ * @return tuple with data <detector found, detector index> for each vector
+ */
+std::vector<DetectorSearcher::DetectorSearchResult>
+DetectorSearcher::findDetectorIndices(const std::vector<V3D> &qs) {
+  std::vector<DetectorSearchResult> results;
+  results.reserve(qs.size());
+  if (!m_usingFullRayTrace) {
+    for (const auto &q : qs)
+      results.push_back(findDetectorIndex(q));
+    return results;
+  }
+
+  std::vector<V3D> directions;
+  directions.reserve(qs.size());
+  for (const auto &q : qs) {
+    if (!q.nullVector())
+      directions.push_back(convertQtoDirection(q));
+  }
+  const auto detIndices = m_rayTracer->traceDetectorsFromSample(directions);
+  auto detIndex = detIndices.cbegin();
+  for (const auto &q : qs) {
+    if (q.nullVector()) {
+      results.emplace_back(false, 0);
+      continue;
+    }
+    const auto index = *detIndex++;
+    if (index == Geometry::DetectorBVH::NO_DETECTOR ||
+        m_detInfo.isMasked(index) || m_detInfo.isMonitor(index))
+      results.emplace_back(false, 0);
+    else
+      results.emplace_back(true, index);
+  }
+  return results;
+}
+
 /** Find the index of a detector given a vector in Qlab space using a ray
  * tracing search strategy
  *
@@ -129,14 +171,11 @@ DetectorSearcher::findDetectorIndex(const V3D &q) {
 DetectorSearcher::DetectorSearchResult
 DetectorSearcher::searchUsingInstrumentRayTracing(const V3D &q) {
   const auto direction = convertQtoDirection(q);
-  m_rayTracer->traceFromSample(direction);
-  const auto det = m_rayTracer->getDetectorResult();
+  const auto detIndex = m_rayTracer->traceDetectorFromSample(direction);
 
-  if (!det)
+  if (detIndex == Geometry::DetectorBVH::NO_DETECTOR)
     return std::make_tuple(false, 0);
 
-  const auto detIndex = m_detInfo.indexOf(det->getID());
-
   if (m_detInfo.isMasked(detIndex) || m_detInfo.isMonitor(detIndex))
     return std::make_tuple(false, 0);
 
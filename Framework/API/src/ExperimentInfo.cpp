@@ -553,6 +553,7 @@ void ExperimentInfo::setDetectorGrouping(
   }
   m_spectrumInfo->setSpectrumDefinition(index, std::move(specDef));
   m_spectrumDefinitionNeedsUpdate.at(index) = 0;
+  invalidateSpectrumGeometry();
 }
 
 /** Update detector grouping for spectrum with given index.
@@ -1212,6 +1213,7 @@ void ExperimentInfo::invalidateSpectrumDefinition(const size_t index) {
   // This uses a vector of char, such that flags for different indices can be
   // set from different threads (std::vector<bool> is not thread-safe).
   m_spectrumDefinitionNeedsUpdate.at(index) = 1;
+  invalidateSpectrumGeometry();
 }
 
 void ExperimentInfo::updateSpectrumDefinitionIfNecessary(
@@ -1265,6 +1267,13 @@ size_t ExperimentInfo::groupOfDetectorID(const detid_t detID) const {
 void ExperimentInfo::invalidateAllSpectrumDefinitions() {
   std::fill(m_spectrumDefinitionNeedsUpdate.begin(),
             m_spectrumDefinitionNeedsUpdate.end(), 1);
+  invalidateSpectrumGeometry();
+}
+
+/// Marks the geometry cached by SpectrumInfo as out of date.
+void ExperimentInfo::invalidateSpectrumGeometry() const {
+  if (m_spectrumInfoWrapper)
+    m_spectrumInfoWrapper->invalidateGeometry();
 }
 
 /** Save the object to an open NeXus file.
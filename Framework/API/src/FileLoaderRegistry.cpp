@@ -92,6 +92,15 @@ void FileLoaderRegistryImpl::unsubscribe(const std::string &name,
   }
 }
 
+/**
+ * Record that a plugin library, not yet opened, registers file loaders. All
+ * such libraries are opened before the loaders are searched.
+ * @param library The full path to the library
+ */
+void FileLoaderRegistryImpl::subscribeDeferred(const std::string &library) {
+  m_deferred.add(library, library);
+}
+
 /**
  * Queries each registered algorithm and asks it how confident it is that it can
  * load the given file. The name of the one with the highest confidence is
@@ -106,6 +115,7 @@ FileLoaderRegistryImpl::chooseLoader(const std::string &filename) const {
   using Kernel::NexusDescriptor;
 
   m_log.debug() << "Trying to find loader for '" << filename << "'\n";
+  m_deferred.openAll();
 
   IAlgorithm_sptr bestLoader;
   if (NexusDescriptor::isHDF(filename)) {
@@ -140,6 +150,7 @@ bool FileLoaderRegistryImpl::canLoad(const std::string &algorithmName,
   using Kernel::FileDescriptor;
   using Kernel::NexusDescriptor;
 
+  m_deferred.openAll();
   // Check if it is in one of our lists
   bool nexus(false), nonHDF(false);
   if (m_names[Nexus].find(algorithmName) != m_names[Nexus].end())
@@ -8,6 +8,7 @@
 #include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/InstrumentDataService.h"
+#include "MantidAPI/PluginManifest.h"
 #include "MantidAPI/WorkspaceGroup.h"
 
 #include "MantidKernel/Exception.h"
@@ -53,6 +54,10 @@ Kernel::Logger g_log("FrameworkManager");
 const char *PLUGINS_DIR_KEY = "framework.plugins.directory";
 /// Key to define the location of the plugins to exclude from loading
 const char *PLUGINS_EXCLUDE_KEY = "framework.plugins.exclude";
+/// Key to turn on opening plugins when they are first used
+const char *PLUGINS_LAZY_KEY = "framework.plugins.lazy";
+/// Name of the file caching what each plugin registers
+const char *PLUGINS_MANIFEST_FILE = "PluginManifest.txt";
 } // namespace
 
 /** This is a function called every time NeXuS raises an error.
@@ -403,8 +408,24 @@ void FrameworkManagerImpl::loadPluginsUsingKey(const std::string &locationKey,
     boost::split(excludes, excludeStr, boost::is_any_of(";"));
     g_log.debug("Loading libraries from '" + pluginDir + "', excluding '" +
                 excludeStr + "'");
-    LibraryManager::Instance().openLibraries(
-        pluginDir, LibraryManagerImpl::NonRecursive, excludes);
+    if (Kernel::ConfigService::Instance()
+            .getValue<bool>(PLUGINS_LAZY_KEY)
+            .get_value_or(false)) {
+      // Only open the libraries the manifest does not know about or that
+      // have changed. The rest are opened when first used.
+      auto &libraryManager = LibraryManager::Instance();
+      PluginManifest manifest(cfgSvc.getUserPropertiesDir() +
+                              PLUGINS_MANIFEST_FILE);
+      for (const auto &library : libraryManager.findLibraries(
+               pluginDir, LibraryManagerImpl::NonRecursive, excludes)) {
+        if (!manifest.deferLibrary(library))
+          manifest.openAndRecord(library);
+      }
+      manifest.save();
+    } else {
+      LibraryManager::Instance().openLibraries(
+          pluginDir, LibraryManagerImpl::NonRecursive, excludes);
+    }
   } else {
     g_log.debug("No library directory found in key \"" + locationKey + "\"");
   }
@@ -9,12 +9,14 @@
 //----------------------------------------------------------------------
 #include "MantidAPI/FunctionDomain1D.h"
 
+#include <algorithm>
+
 namespace Mantid {
 namespace API {
 
 /// The constructor
 FunctionDomain1D::FunctionDomain1D(const double *x, size_t n)
-    : m_data(x), m_n(n), m_peakRadius(0) {}
+    : m_data(x), m_n(n), m_peakRadius(0), m_sorted(-1) {}
 
 /// Convert to a vector
 std::vector<double> FunctionDomain1D::toVector() const {
@@ -36,6 +38,19 @@ void FunctionDomain1D::setPeakRadius(int radius) { m_peakRadius = radius; }
  */
 int FunctionDomain1D::getPeakRadius() const { return m_peakRadius; }
 
+/**
+ * Check if the values are in ascending order, in which case functions can
+ * find the points in an interval by bisection. The check is done once.
+ */
+bool FunctionDomain1D::isSorted() const {
+  int sorted = m_sorted.load(std::memory_order_relaxed);
+  if (sorted < 0) {
+    sorted = std::is_sorted(m_data, m_data + m_n) ? 1 : 0;
+    m_sorted.store(sorted, std::memory_order_relaxed);
+  }
+  return sorted == 1;
+}
+
 /**
  * Create a domain from a vector.
  * @param xvalues :: Vector with function arguments to be copied from.
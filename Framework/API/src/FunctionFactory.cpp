@@ -33,6 +33,8 @@ FunctionFactoryImpl::FunctionFactoryImpl()
 
 IFunction_sptr
 FunctionFactoryImpl::createFunction(const std::string &type) const {
+  if (!exists(type))
+    m_deferred.open(type);
   IFunction_sptr fun = create(type);
   fun->initialize();
   return fun;
@@ -394,5 +396,34 @@ void FunctionFactoryImpl::unsubscribe(const std::string &className) {
   Kernel::DynamicFactory<IFunction>::unsubscribe(className);
 }
 
+/**
+ * Record that a plugin library, not yet opened, registers a function. The
+ * library is opened the first time the function is created.
+ * @param className :: The name of the function
+ * @param library :: The full path to the library registering it
+ */
+void FunctionFactoryImpl::subscribeDeferred(const std::string &className,
+                                            const std::string &library) {
+  m_deferred.add(className, library);
+}
+
+/// @returns The names of the functions known from the plugin manifest whose
+/// libraries have not been opened. Creating any of them opens its library.
+std::vector<std::string> FunctionFactoryImpl::getDeferredFunctionNames() const {
+  std::vector<std::string> names;
+  for (auto &name : m_deferred.names()) {
+    // The library may have been opened for another of its functions
+    if (!Kernel::DynamicFactory<IFunction>::exists(name))
+      names.push_back(std::move(name));
+  }
+  return names;
+}
+
+/// @returns The names of all registered functions
+const std::vector<std::string> FunctionFactoryImpl::getKeys() const {
+  m_deferred.openAll();
+  return Kernel::DynamicFactory<IFunction>::getKeys();
+}
+
 } // namespace API
 } // namespace Mantid
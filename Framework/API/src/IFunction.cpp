@@ -108,6 +108,20 @@ bool IFunction::cancellationRequestReceived() const {
     return false;
 }
 
+/** Base class implementation evaluates the function into a temporary buffer
+ * and adds it to the values. Functions that can accumulate their values
+ * directly override it to save the buffer and the extra pass over the data.
+ * @param domain :: The domain of the function
+ * @param values :: The values to add the function values to. They must be of
+ * the same size as the domain.
+ */
+void IFunction::functionAdd(const FunctionDomain &domain,
+                            FunctionValues &values) const {
+  FunctionValues tmp(domain);
+  function(domain, tmp);
+  values += tmp;
+}
+
 /** Base class implementation calculates the derivatives numerically.
  * @param domain :: The domain of the function
  * @param jacobian :: A Jacobian matrix. It is expected to have dimensions of
@@ -53,6 +53,45 @@ void IFunction1D::function(const FunctionDomain &domain,
              d1d->size());
 }
 
+/**
+ * Add the function values to the output. The default implementation
+ * evaluates function1D into a buffer and adds it.
+ * @param out :: The values to add to
+ * @param xValues :: X values for data points
+ * @param nData :: Number of data points
+ */
+void IFunction1D::function1DAdd(double *out, const double *xValues,
+                                const size_t nData) const {
+  std::vector<double> tmp(nData);
+  function1D(tmp.data(), xValues, nData);
+  for (size_t i = 0; i < nData; ++i) {
+    out[i] += tmp[i];
+  }
+}
+
+/**
+ * Helper for the functions that override functionAdd to accumulate their
+ * values directly: point domains go to function1DAdd, any other domain is
+ * evaluated by function() into a buffer.
+ * @param domain :: The domain of the function
+ * @param values :: The values to add the function values to
+ */
+void IFunction1D::functionAdd1D(const FunctionDomain &domain,
+                                FunctionValues &values) const {
+  auto d1d = dynamic_cast<const FunctionDomain1D *>(&domain);
+  if (!d1d || dynamic_cast<const FunctionDomain1DHistogram *>(&domain)) {
+    IFunction::functionAdd(domain, values);
+    return;
+  }
+  if (values.size() != d1d->size()) {
+    throw std::runtime_error("Cannot add values: sizes do not match");
+  }
+  if (d1d->size() == 0)
+    return;
+  function1DAdd(values.getPointerToCalculated(0), d1d->getPointerAt(0),
+                d1d->size());
+}
+
 void IFunction1D::functionDeriv(const FunctionDomain &domain,
                                 Jacobian &jacobian) {
   auto histoDomain = dynamic_cast<const FunctionDomain1DHistogram *>(&domain);
@@ -8,6 +8,7 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidAPI/IPeakFunction.h"
+#include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionFactory.h"
 #include "MantidAPI/FunctionParameterDecorator.h"
 #include "MantidAPI/IFunction1D.tcc"
@@ -17,8 +18,10 @@
 
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <vector>
 
 namespace Mantid {
 namespace API {
@@ -97,14 +100,151 @@ const int MAX_PEAK_RADIUS = std::numeric_limits<int>::max();
 /**
  * Constructor.
  */
-IPeakFunction::IPeakFunction() : m_peakRadius(MAX_PEAK_RADIUS) {}
+IPeakFunction::IPeakFunction()
+    : m_peakRadius(MAX_PEAK_RADIUS) {}
 
+/**
+ * Calculate the peak on a domain. On a sorted domain only the points within
+ * the peak radius are evaluated and the rest are set to 0.
+ * @param domain :: The domain of the function
+ * @param values :: The values to set
+ */
 void IPeakFunction::function(const FunctionDomain &domain,
                              FunctionValues &values) const {
-  auto peakRadius =
-      dynamic_cast<const FunctionDomain1D &>(domain).getPeakRadius();
-  setPeakRadius(peakRadius);
-  IFunction1D::function(domain, values);
+  const auto &domain1D = dynamic_cast<const FunctionDomain1D &>(domain);
+  setPeakRadius(domain1D.getPeakRadius());
+  const auto range = getLocalRange(domain1D);
+  if (range.first == 0 && range.second == domain1D.size()) {
+    IFunction1D::function(domain, values);
+    return;
+  }
+  double *out = values.getPointerToCalculated(0);
+  std::fill(out, out + range.first, 0.0);
+  std::fill(out + range.second, out + domain1D.size(), 0.0);
+  if (range.first == range.second)
+    return;
+  function1D(out + range.first, domain1D.getPointerAt(range.first),
+             range.second - range.first);
+}
+
+/**
+ * Add the peak to the values of a composite function. Only the points
+ * within the peak radius are touched.
+ * @param domain :: The domain of the function
+ * @param values :: The values to add the peak values to
+ */
+void IPeakFunction::functionAdd(const FunctionDomain &domain,
+                                FunctionValues &values) const {
+  const auto &domain1D = dynamic_cast<const FunctionDomain1D &>(domain);
+  setPeakRadius(domain1D.getPeakRadius());
+  const auto range = getLocalRange(domain1D);
+  if (range.first == 0 && range.second == domain1D.size()) {
+    functionAdd1D(domain, values);
+    return;
+  }
+  if (values.size() != domain1D.size()) {
+    throw std::runtime_error("Cannot add values: sizes do not match");
+  }
+  if (range.first == range.second)
+    return;
+  function1DAdd(values.getPointerToCalculated(range.first),
+                domain1D.getPointerAt(range.first),
+                range.second - range.first);
+}
+
+/**
+ * Calculate the derivatives. On a sorted domain only the points within the
+ * peak radius are evaluated and the rest are set to 0.
+ * @param domain :: The domain of the function
+ * @param jacobian :: The Jacobian to set the derivatives in
+ */
+void IPeakFunction::functionDeriv(const FunctionDomain &domain,
+                                  Jacobian &jacobian) {
+  const auto &domain1D = dynamic_cast<const FunctionDomain1D &>(domain);
+  setPeakRadius(domain1D.getPeakRadius());
+  const auto range = getLocalRange(domain1D);
+  if (range.first == 0 && range.second == domain1D.size()) {
+    IFunction1D::functionDeriv(domain, jacobian);
+    return;
+  }
+  const size_t np = this->nParams();
+  auto zeroRows = [&jacobian, np](size_t from, size_t to) {
+    for (size_t i = from; i < to; ++i) {
+      for (size_t ip = 0; ip < np; ++ip) {
+        jacobian.set(i, ip, 0.0);
+      }
+    }
+  };
+  zeroRows(0, range.first);
+  zeroRows(range.second, domain1D.size());
+  if (range.first == range.second)
+    return;
+  PartialJacobian1 J(&jacobian, static_cast<int>(range.first));
+  functionDeriv1D(&J, domain1D.getPointerAt(range.first),
+                  range.second - range.first);
+}
+
+/**
+ * The distance from the centre beyond which the peak is not evaluated. By
+ * default this is the peak radius in units of the FWHM.
+ */
+double IPeakFunction::localExtent() const {
+  return fabs(m_peakRadius * this->fwhm());
+}
+
+/**
+ * Find the points of a domain that may lie within localExtent() of the
+ * centre. If the domain is sorted these are found by bisection. Otherwise,
+ * for a histogram domain or if the extent is not a positive finite number,
+ * the whole domain is returned and the points are found when the peak is
+ * evaluated.
+ * @param domain :: The domain the peak is evaluated on
+ * @return :: The index of the first point in the range and one past the last
+ */
+std::pair<size_t, size_t>
+IPeakFunction::getLocalRange(const FunctionDomain1D &domain) const {
+  const size_t nData = domain.size();
+  if (nData == 0 || !domain.isSorted() ||
+      dynamic_cast<const FunctionDomain1DHistogram *>(&domain)) {
+    return std::make_pair(size_t(0), nData);
+  }
+  const double dx = localExtent();
+  if (!(dx > 0.0) || !std::isfinite(dx)) {
+    return std::make_pair(size_t(0), nData);
+  }
+  const double c = this->centre();
+  const double *xValues = domain.getPointerAt(0);
+  const double *end = xValues + nData;
+  const double *first = std::upper_bound(xValues, end, c - dx);
+  const double *last = std::lower_bound(first, end, c + dx);
+  return std::make_pair(static_cast<size_t>(first - xValues),
+                        static_cast<size_t>(last - xValues));
+}
+
+/**
+ * Find the points closer than dx to the peak centre by checking every
+ * point.
+ * @param xValues :: X values for data points
+ * @param nData :: Number of data points
+ * @param dx :: The distance from the centre
+ * @return :: The index of the first point in the range and one past the last
+ */
+std::pair<size_t, size_t> IPeakFunction::getLocalRange(const double *xValues,
+                                                       const size_t nData,
+                                                       double dx) const {
+  const double c = this->centre();
+  size_t first = nData;
+  size_t last = 0;
+  for (size_t i = 0; i < nData; ++i) {
+    if (fabs(xValues[i] - c) < dx) {
+      if (first == nData)
+        first = i;
+      last = i + 1;
+    }
+  }
+  if (first == nData)
+    return std::make_pair(nData, nData);
+  return std::make_pair(first, last);
 }
 
 /**
@@ -119,22 +259,36 @@ void IPeakFunction::function(const FunctionDomain &domain,
  */
 void IPeakFunction::function1D(double *out, const double *xValues,
                                const size_t nData) const {
-  double c = this->centre();
-  double dx = fabs(m_peakRadius * this->fwhm());
-  int i0 = -1;
-  int n = 0;
-  for (size_t i = 0; i < nData; ++i) {
-    if (fabs(xValues[i] - c) < dx) {
-      if (i0 < 0)
-        i0 = static_cast<int>(i);
-      ++n;
-    } else {
-      out[i] = 0.0;
-    }
-  }
-  if (i0 < 0 || n == 0)
+  const auto range = getLocalRange(xValues, nData, localExtent());
+  std::fill(out, out + range.first, 0.0);
+  std::fill(out + range.second, out + nData, 0.0);
+  if (range.first == range.second)
     return;
-  this->functionLocal(out + i0, xValues + i0, n);
+  this->functionLocal(out + range.first, xValues + range.first,
+                      range.second - range.first);
+}
+
+/**
+ * General implementation of the method for all peaks. Adds the peak values
+ * to the output within a certain number of FWHMs around the peak centre and
+ * leaves the outside points unchanged.
+ * Calls functionLocal() to compute the actual values
+ * @param out :: Output function values to add to
+ * @param xValues :: X values for data points
+ * @param nData :: Number of data points
+ */
+void IPeakFunction::function1DAdd(double *out, const double *xValues,
+                                  const size_t nData) const {
+  const auto range = getLocalRange(xValues, nData, localExtent());
+  const size_t n = range.second - range.first;
+  if (n == 0)
+    return;
+  std::vector<double> tmp(n);
+  this->functionLocal(tmp.data(), xValues + range.first, n);
+  out += range.first;
+  for (size_t i = 0; i < n; ++i) {
+    out[i] += tmp[i];
+  }
 }
 
 /**
@@ -150,25 +304,22 @@ void IPeakFunction::function1D(double *out, const double *xValues,
  */
 void IPeakFunction::functionDeriv1D(Jacobian *out, const double *xValues,
                                     const size_t nData) {
-  double c = this->centre();
-  double dx = fabs(m_peakRadius * this->fwhm());
-  int i0 = -1;
-  int n = 0;
-  for (size_t i = 0; i < nData; ++i) {
-    if (fabs(xValues[i] - c) < dx) {
-      if (i0 < 0)
-        i0 = static_cast<int>(i);
-      ++n;
-    } else {
-      for (size_t ip = 0; ip < this->nParams(); ++ip) {
+  const auto range = getLocalRange(xValues, nData, localExtent());
+  const size_t np = this->nParams();
+  auto zeroRows = [out, np](size_t from, size_t to) {
+    for (size_t i = from; i < to; ++i) {
+      for (size_t ip = 0; ip < np; ++ip) {
         out->set(i, ip, 0.0);
       }
     }
-  }
-  if (i0 < 0 || n == 0)
+  };
+  zeroRows(0, range.first);
+  zeroRows(range.second, nData);
+  if (range.first == range.second)
     return;
-  PartialJacobian1 J(out, i0);
-  this->functionDerivLocal(&J, xValues + i0, n);
+  PartialJacobian1 J(out, static_cast<int>(range.first));
+  this->functionDerivLocal(&J, xValues + range.first,
+                           range.second - range.first);
 }
 
 void IPeakFunction::setPeakRadius(int r) const {
@@ -82,7 +82,7 @@ void ITableWorkspace::modified() {
   ITableWorkspace_sptr tws = boost::dynamic_pointer_cast<ITableWorkspace>(ws);
   if (!tws)
     return;
-  AnalysisDataService::Instance().notificationCenter.postNotification(
+  AnalysisDataService::Instance().postNotification(
       new Kernel::DataService<API::Workspace>::AfterReplaceNotification(
           this->getName(), tws));
 }
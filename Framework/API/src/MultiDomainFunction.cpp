@@ -11,8 +11,10 @@
 #include "MantidAPI/CompositeDomain.h"
 #include "MantidAPI/Expression.h"
 #include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/ParameterTie.h"
 
 #include <boost/lexical_cast.hpp>
+#include <algorithm>
 #include <set>
 
 namespace Mantid {
@@ -106,6 +108,49 @@ size_t MultiDomainFunction::getNumberDomains() const {
   return getMaxIndex() + 1;
 }
 
+/**
+ * Find the active parameters the values on each domain depend on: the active
+ * parameters of the members applying to the domain and the active parameters
+ * that the tied parameters of these members are tied to.
+ * @param nDomains :: The number of domains
+ * @return :: The sorted indices of the active parameters for each domain
+ */
+std::vector<std::vector<size_t>>
+MultiDomainFunction::getActiveDependencies(size_t nDomains) const {
+  const size_t np = nParams();
+  std::vector<std::vector<size_t>> dependencies(nDomains);
+  std::vector<size_t> domains;
+  for (size_t iDomain = 0; iDomain < nDomains; ++iDomain) {
+    std::vector<size_t> toVisit;
+    for (size_t iFun = 0; iFun < nFunctions(); ++iFun) {
+      getDomainIndices(iFun, nDomains, domains);
+      if (std::find(domains.begin(), domains.end(), iDomain) == domains.end())
+        continue;
+      for (size_t ip = 0; ip < getFunction(iFun)->nParams(); ++ip) {
+        toVisit.push_back(paramOffset(iFun) + ip);
+      }
+    }
+    std::vector<bool> visited(np, false);
+    std::set<size_t> active;
+    while (!toVisit.empty()) {
+      const size_t ip = toVisit.back();
+      toVisit.pop_back();
+      if (ip >= np || visited[ip])
+        continue;
+      visited[ip] = true;
+      if (isActive(ip)) {
+        active.insert(ip);
+      } else if (auto tie = getTie(ip)) {
+        for (const auto &ref : tie->getRHSParameters()) {
+          toVisit.push_back(getParameterIndex(ref));
+        }
+      }
+    }
+    dependencies[iDomain].assign(active.begin(), active.end());
+  }
+  return dependencies;
+}
+
 /// Function you want to fit to.
 /// @param domain :: The buffer for writing the calculated values. Must be big
 /// enough to accept dataSize() values
@@ -0,0 +1,324 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/PluginManifest.h"
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/AlgorithmFactory.h"
+#include "MantidAPI/ArchiveSearchFactory.h"
+#include "MantidAPI/CatalogFactory.h"
+#include "MantidAPI/ColumnFactory.h"
+#include "MantidAPI/ConstraintFactory.h"
+#include "MantidAPI/CostFunctionFactory.h"
+#include "MantidAPI/DomainCreatorFactory.h"
+#include "MantidAPI/FileLoaderRegistry.h"
+#include "MantidAPI/FuncMinimizerFactory.h"
+#include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/ImplicitFunctionFactory.h"
+#include "MantidAPI/ImplicitFunctionParameterParserFactory.h"
+#include "MantidAPI/ImplicitFunctionParserFactory.h"
+#include "MantidAPI/LiveListenerFactory.h"
+#include "MantidAPI/RemoteJobManagerFactory.h"
+#include "MantidAPI/ScriptRepositoryFactory.h"
+#include "MantidAPI/TransformScaleFactory.h"
+#include "MantidAPI/WorkspaceFactory.h"
+#include "MantidKernel/LibraryManager.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/UnitFactory.h"
+
+#include <Poco/File.h>
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/join.hpp>
+#include <boost/algorithm/string/split.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+namespace Mantid {
+namespace API {
+namespace {
+/// static logger
+Kernel::Logger g_log("PluginManifest");
+
+/// The names registered with the algorithm factory, without versions
+std::set<std::string> algorithmNames() {
+  auto &factory = AlgorithmFactory::Instance();
+  std::set<std::string> names;
+  // The base class method does not open deferred libraries
+  for (const auto &key : factory.Kernel::DynamicFactory<Algorithm>::getKeys())
+    names.insert(factory.decodeName(key).first);
+  return names;
+}
+
+/// The names registered with the function factory
+std::set<std::string> functionNames() {
+  const auto keys =
+      FunctionFactory::Instance().Kernel::DynamicFactory<IFunction>::getKeys();
+  return std::set<std::string>(keys.cbegin(), keys.cend());
+}
+
+/// The number of entries in the factories a library can not be deferred for
+size_t otherRegistrations() {
+  return ArchiveSearchFactory::Instance().getKeys().size() +
+         CatalogFactory::Instance().getKeys().size() +
+         ColumnFactory::Instance().getKeys().size() +
+         ConstraintFactory::Instance().getKeys().size() +
+         CostFunctionFactory::Instance().getKeys().size() +
+         DomainCreatorFactory::Instance().getKeys().size() +
+         FuncMinimizerFactory::Instance().getKeys().size() +
+         ImplicitFunctionFactory::Instance().getKeys().size() +
+         ImplicitFunctionParameterParserFactory::Instance().getKeys().size() +
+         ImplicitFunctionParserFactory::Instance().getKeys().size() +
+         LiveListenerFactory::Instance().getKeys().size() +
+         RemoteJobManagerFactory::Instance().getKeys().size() +
+         ScriptRepositoryFactory::Instance().getKeys().size() +
+         TransformScaleFactory::Instance().getKeys().size() +
+         WorkspaceFactory::Instance().getKeys().size() +
+         Kernel::UnitFactory::Instance().getKeys().size();
+}
+
+/**
+ * Describe a newly registered algorithm for the simple API. Only the highest
+ * version is created, and not initialized, as the simple API wraps that.
+ * @param name :: The name of the algorithm
+ * @return What the simple API needs to know of the algorithm
+ */
+DeferredAlgorithm describeAlgorithm(const std::string &name) {
+  const auto algorithm = AlgorithmFactory::Instance().create(name, -1);
+  DeferredAlgorithm description;
+  description.name = name;
+  description.alias = algorithm->alias();
+  description.workspaceMethodName = algorithm->workspaceMethodName();
+  description.workspaceMethodOn = algorithm->workspaceMethodOn();
+  description.workspaceMethodInputProperty =
+      algorithm->workspaceMethodInputProperty();
+  return description;
+}
+
+/// The names in after that are not in before
+std::vector<std::string> added(const std::set<std::string> &before,
+                               const std::set<std::string> &after) {
+  std::vector<std::string> names;
+  std::set_difference(after.cbegin(), after.cend(), before.cbegin(),
+                      before.cend(), std::back_inserter(names));
+  return names;
+}
+} // namespace
+
+/**
+ * Constructor. Reads the manifest if it exists.
+ * @param filename :: The full path to the manifest file
+ */
+PluginManifest::PluginManifest(const std::string &filename)
+    : m_filename(filename), m_entries(), m_modified(false) {
+  load();
+}
+
+/**
+ * Subscribe the names registered by a library to the factories without
+ * opening it, if its recorded entry is still current.
+ * @param path :: The full path to the library
+ * @return True if the library was deferred, false if it must be opened
+ */
+bool PluginManifest::deferLibrary(const std::string &path) const {
+  const auto entry = m_entries.find(path);
+  if (entry == m_entries.end())
+    return false;
+  uint64_t size(0);
+  int64_t modified(0);
+  if (!fileDetails(path, size, modified) || size != entry->second.size ||
+      modified != entry->second.modified)
+    return false;
+  const auto &registrations = entry->second.registrations;
+  if (registrations.eager || (registrations.algorithms.empty() &&
+                              registrations.functions.empty()))
+    return false;
+
+  auto &algorithmFactory = AlgorithmFactory::Instance();
+  for (const auto &algorithm : registrations.algorithms)
+    algorithmFactory.subscribeDeferred(algorithm, path);
+  auto &functionFactory = FunctionFactory::Instance();
+  for (const auto &name : registrations.functions)
+    functionFactory.subscribeDeferred(name, path);
+  if (registrations.loaders)
+    FileLoaderRegistry::Instance().subscribeDeferred(path);
+  g_log.debug("Deferred opening " + path);
+  return true;
+}
+
+/**
+ * Open a library and record what it registers
+ * @param path :: The full path to the library
+ */
+void PluginManifest::openAndRecord(const std::string &path) {
+  const auto algorithmsBefore = algorithmNames();
+  const auto functionsBefore = functionNames();
+  const auto loadersBefore = FileLoaderRegistry::Instance().size();
+  const auto othersBefore = otherRegistrations();
+
+  if (!Kernel::LibraryManager::Instance().openLibrary(path))
+    return;
+
+  Registrations registrations;
+  registrations.functions = added(functionsBefore, functionNames());
+  registrations.loaders =
+      FileLoaderRegistry::Instance().size() != loadersBefore;
+  registrations.eager = otherRegistrations() != othersBefore;
+  for (const auto &name : added(algorithmsBefore, algorithmNames())) {
+    try {
+      registrations.algorithms.push_back(describeAlgorithm(name));
+    } catch (std::exception &exc) {
+      // Without a description the library can not be wrapped unopened
+      g_log.warning("Unable to describe algorithm " + name + ": " +
+                    exc.what());
+      registrations.eager = true;
+    }
+  }
+  record(path, registrations);
+}
+
+/**
+ * Record what a library registers against its current size and
+ * modification time
+ * @param path :: The full path to the library
+ * @param registrations :: The names it registers
+ */
+void PluginManifest::record(const std::string &path,
+                            const Registrations &registrations) {
+  Entry entry;
+  if (!fileDetails(path, entry.size, entry.modified))
+    return;
+  entry.registrations = registrations;
+  m_entries[path] = std::move(entry);
+  m_modified = true;
+}
+
+/**
+ * @param path :: The full path to a library
+ * @return The recorded registrations of the library or nullptr if there are
+ * none
+ */
+const PluginManifest::Registrations *
+PluginManifest::find(const std::string &path) const {
+  const auto entry = m_entries.find(path);
+  return entry == m_entries.end() ? nullptr : &entry->second.registrations;
+}
+
+/// Write the manifest if anything has been recorded since it was read
+void PluginManifest::save() const {
+  if (!m_modified)
+    return;
+  std::ofstream file(m_filename.c_str());
+  if (!file) {
+    g_log.warning("Unable to write plugin manifest " + m_filename);
+    return;
+  }
+  for (const auto &entry : m_entries) {
+    const auto &registrations = entry.second.registrations;
+    file << "library\t" << entry.second.size << '\t' << entry.second.modified
+         << '\t' << entry.first << '\n';
+    for (const auto &algorithm : registrations.algorithms) {
+      file << "algorithm\t" << algorithm.name << '\n';
+      if (!algorithm.alias.empty())
+        file << "alias\t" << algorithm.alias << '\n';
+      if (!algorithm.workspaceMethodName.empty())
+        file << "method\t" << algorithm.workspaceMethodName << '\t'
+             << algorithm.workspaceMethodInputProperty << '\t'
+             << boost::algorithm::join(algorithm.workspaceMethodOn, ",")
+             << '\n';
+    }
+    for (const auto &name : registrations.functions)
+      file << "function\t" << name << '\n';
+    if (registrations.loaders)
+      file << "loaders\n";
+    if (registrations.eager)
+      file << "eager\n";
+  }
+}
+
+/// Read the manifest file, ignoring it if it is missing or malformed
+void PluginManifest::load() {
+  std::ifstream file(m_filename.c_str());
+  if (!file)
+    return;
+  std::map<std::string, Entry> entries;
+  Entry *current(nullptr);
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty())
+      continue;
+    const auto tab = line.find('\t');
+    const std::string kind = line.substr(0, tab);
+    const std::string value =
+        tab == std::string::npos ? "" : line.substr(tab + 1);
+    if (kind == "library") {
+      std::istringstream fields(value);
+      Entry entry;
+      std::string path;
+      fields >> entry.size >> entry.modified;
+      if (!fields || fields.get() != '\t' || !std::getline(fields, path) ||
+          path.empty()) {
+        g_log.warning("Ignoring malformed plugin manifest " + m_filename);
+        return;
+      }
+      current = &(entries[path] = entry);
+    } else if (!current) {
+      g_log.warning("Ignoring malformed plugin manifest " + m_filename);
+      return;
+    } else if (kind == "algorithm") {
+      DeferredAlgorithm algorithm;
+      algorithm.name = value;
+      current->registrations.algorithms.push_back(std::move(algorithm));
+    } else if (kind == "alias" &&
+               !current->registrations.algorithms.empty()) {
+      current->registrations.algorithms.back().alias = value;
+    } else if (kind == "method" &&
+               !current->registrations.algorithms.empty()) {
+      auto &algorithm = current->registrations.algorithms.back();
+      std::vector<std::string> fields;
+      boost::split(fields, value, boost::is_any_of("\t"));
+      fields.resize(3);
+      algorithm.workspaceMethodName = fields[0];
+      algorithm.workspaceMethodInputProperty = fields[1];
+      if (!fields[2].empty())
+        boost::split(algorithm.workspaceMethodOn, fields[2],
+                     boost::is_any_of(","));
+    } else if (kind == "function") {
+      current->registrations.functions.push_back(value);
+    } else if (kind == "loaders") {
+      current->registrations.loaders = true;
+    } else {
+      // Anything not understood means the library can not be deferred
+      current->registrations.eager = true;
+    }
+  }
+  m_entries.swap(entries);
+}
+
+/**
+ * Get the size and modification time of a file
+ * @param path :: The full path to the file
+ * @param size :: Set to the size in bytes
+ * @param modified :: Set to the modification time in microseconds
+ * @return False if the file does not exist
+ */
+bool PluginManifest::fileDetails(const std::string &path, uint64_t &size,
+                                 int64_t &modified) {
+  try {
+    Poco::File file(path);
+    if (!file.exists())
+      return false;
+    size = file.getSize();
+    modified = file.getLastModified().epochMicroseconds();
+    return true;
+  } catch (Poco::Exception &) {
+    return false;
+  }
+}
+
+} // namespace API
+} // namespace Mantid
@@ -0,0 +1,126 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/SpectrumGeometry.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidTypes/SpectrumDefinition.h"
+
+#include <cmath>
+#include <limits>
+
+namespace Mantid {
+namespace API {
+
+/**
+ * Compute the geometry of all the spectra
+ * @param spectrumInfo :: The SpectrumInfo of the workspace
+ */
+SpectrumGeometry::SpectrumGeometry(const SpectrumInfo &spectrumInfo) {
+  const size_t nspectra = spectrumInfo.size();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  try {
+    m_l1 = spectrumInfo.l1();
+  } catch (std::exception &) {
+    // An instrument without a source or sample has no defined geometry
+    m_l1 = nan;
+  }
+  m_hasDetectors.resize(nspectra, 0);
+  m_isMonitor.resize(nspectra, 0);
+  m_isMasked.resize(nspectra, 0);
+  m_l2.resize(nspectra, nan);
+  m_twoTheta.resize(nspectra, nan);
+  m_signedTwoTheta.resize(nspectra, nan);
+  m_phi.resize(nspectra, nan);
+  m_difc.resize(nspectra, nan);
+  m_l2Errors.resize(nspectra);
+  m_angleErrors.resize(nspectra);
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < static_cast<int64_t>(nspectra); ++i) {
+    if (!spectrumInfo.hasDetectors(i))
+      continue;
+    m_hasDetectors[i] = 1;
+    m_isMonitor[i] = spectrumInfo.isMonitor(i);
+    m_isMasked[i] = spectrumInfo.isMasked(i);
+    // Nothing may be thrown out of the parallel loop, so what SpectrumInfo
+    // throws is kept for the accessors to rethrow
+    try {
+      m_l2[i] = spectrumInfo.l2(i);
+      const auto position = spectrumInfo.position(i);
+      m_phi[i] = std::atan2(position.Y(), position.X());
+    } catch (std::exception &) {
+      m_l2Errors[i] = std::current_exception();
+    }
+    try {
+      // Throws for monitors
+      m_twoTheta[i] = spectrumInfo.twoTheta(i);
+      m_signedTwoTheta[i] = spectrumInfo.signedTwoTheta(i);
+      m_difc[i] = 1. / Geometry::Conversion::tofToDSpacingFactor(
+                           m_l1, m_l2[i], m_twoTheta[i], 0.);
+    } catch (std::exception &) {
+      m_angleErrors[i] = std::current_exception();
+    }
+  }
+}
+
+/// The mean distance from the sample to the detectors of the spectrum with
+/// the given index. Throws what SpectrumInfo threw computing it.
+double SpectrumGeometry::l2(const size_t index) const {
+  return valueAt(m_l2, m_l2Errors, index);
+}
+
+/// The mean scattering angle in radians of the spectrum with the given index.
+/// Throws what SpectrumInfo threw computing it.
+double SpectrumGeometry::twoTheta(const size_t index) const {
+  return valueAt(m_twoTheta, m_angleErrors, index);
+}
+
+/// The mean signed scattering angle in radians of the spectrum with the given
+/// index. Throws what SpectrumInfo threw computing it.
+double SpectrumGeometry::signedTwoTheta(const size_t index) const {
+  return valueAt(m_signedTwoTheta, m_angleErrors, index);
+}
+
+/// Returns the value at index, rethrowing the error recorded for it if any
+double
+SpectrumGeometry::valueAt(const std::vector<double> &values,
+                          const std::vector<std::exception_ptr> &errors,
+                          const size_t index) {
+  if (errors.at(index))
+    std::rethrow_exception(errors[index]);
+  return values[index];
+}
+
+/**
+ * Compute the solid angles of the detectors of each spectrum as seen from
+ * the sample
+ * @param spectrumInfo :: The SpectrumInfo of the workspace
+ * @param componentInfo :: The ComponentInfo of the workspace
+ */
+void SpectrumGeometry::computeSolidAngles(
+    const SpectrumInfo &spectrumInfo,
+    const Geometry::ComponentInfo &componentInfo) {
+  const size_t nspectra = size();
+  const auto samplePosition = spectrumInfo.samplePosition();
+  m_solidAngle.assign(nspectra, std::numeric_limits<double>::quiet_NaN());
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < static_cast<int64_t>(nspectra); ++i) {
+    if (!m_hasDetectors[i] || m_isMonitor[i])
+      continue;
+    double solidAngle(0.);
+    // Detector indices are the component indices of the detectors
+    for (const auto &index : spectrumInfo.spectrumDefinition(i))
+      solidAngle += componentInfo.solidAngle(index.first, samplePosition);
+    m_solidAngle[i] = solidAngle;
+  }
+}
+
+} // namespace API
+} // namespace Mantid
@@ -6,8 +6,10 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/ExperimentInfo.h"
+#include "MantidAPI/SpectrumGeometry.h"
 #include "MantidAPI/SpectrumInfoIterator.h"
 #include "MantidBeamline/SpectrumInfo.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
 #include "MantidGeometry/Instrument/DetectorGroup.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidKernel/Exception.h"
@@ -15,17 +17,32 @@
 #include "MantidTypes/SpectrumDefinition.h"
 
 #include <algorithm>
+#include <atomic>
 #include <boost/make_shared.hpp>
+#include <mutex>
 
 namespace Mantid {
 namespace API {
 
+/// The geometry of the spectra, computed on first use
+struct SpectrumInfo::GeometryCache {
+  std::mutex mutex;
+  boost::shared_ptr<const SpectrumGeometry> geometry;
+  /// Cleared when the spectrum definitions change
+  std::atomic<bool> isValid{false};
+  /// The change counts of DetectorInfo and ComponentInfo the geometry was
+  /// computed with
+  size_t detectorChanges{0};
+  size_t componentChanges{0};
+};
+
 SpectrumInfo::SpectrumInfo(const Beamline::SpectrumInfo &spectrumInfo,
                            const ExperimentInfo &experimentInfo,
                            Geometry::DetectorInfo &detectorInfo)
     : m_experimentInfo(experimentInfo), m_detectorInfo(detectorInfo),
       m_spectrumInfo(spectrumInfo), m_lastDetector(PARALLEL_GET_MAX_THREADS),
-      m_lastIndex(PARALLEL_GET_MAX_THREADS, -1) {}
+      m_lastIndex(PARALLEL_GET_MAX_THREADS, -1),
+      m_geometryCache(boost::make_shared<GeometryCache>()) {}
 
 // Defined as default in source for forward declaration with std::unique_ptr.
 SpectrumInfo::~SpectrumInfo() = default;
@@ -148,6 +165,36 @@ Kernel::V3D SpectrumInfo::samplePosition() const {
 /// Returns L1 (distance from source to sample).
 double SpectrumInfo::l1() const { return m_detectorInfo.l1(); }
 
+/** Returns the geometry of all spectra in contiguous arrays, computing it if
+ * it has not been computed since the last change to the detector grouping or
+ * to the DetectorInfo or ComponentInfo, which includes the masking. The
+ * returned geometry stays valid when it is recomputed.
+ *
+ * @param withSolidAngles :: If true the solid angles are also computed
+ */
+boost::shared_ptr<const SpectrumGeometry>
+SpectrumInfo::geometry(const bool withSolidAngles) const {
+  auto &cache = *m_geometryCache;
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  // Compared on every call, so changes made through a reference to either
+  // object held since before the last computation are seen
+  const auto detectorChanges = m_detectorInfo.changeCount();
+  const auto componentChanges = m_experimentInfo.componentInfo().changeCount();
+  if (!cache.isValid.exchange(true) || !cache.geometry ||
+      cache.detectorChanges != detectorChanges ||
+      cache.componentChanges != componentChanges) {
+    cache.geometry = boost::make_shared<SpectrumGeometry>(*this);
+    cache.detectorChanges = detectorChanges;
+    cache.componentChanges = componentChanges;
+  }
+  if (withSolidAngles && cache.geometry->solidAngle().empty()) {
+    auto geometry = boost::make_shared<SpectrumGeometry>(*cache.geometry);
+    geometry->computeSolidAngles(*this, m_experimentInfo.componentInfo());
+    cache.geometry = std::move(geometry);
+  }
+  return cache.geometry;
+}
+
 const Geometry::IDetector &SpectrumInfo::getDetector(const size_t index) const {
   size_t thread = static_cast<size_t>(PARALLEL_THREAD_NUMBER);
   if (m_lastIndex[thread] == index)
@@ -190,6 +237,11 @@ SpectrumInfo::checkAndGetSpectrumDefinition(const size_t index) const {
   return spectrumDefinition(index);
 }
 
+/// Marks the geometry as out of date. May be called from any thread.
+void SpectrumInfo::invalidateGeometry() const {
+  m_geometryCache->isValid = false;
+}
+
 // Begin method for iterator
 SpectrumInfoIt SpectrumInfo::begin() { return SpectrumInfoIt(*this, 0); }
 
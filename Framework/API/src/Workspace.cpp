@@ -64,6 +64,18 @@ const std::string &Workspace::getComment() const { return m_comment; }
  */
 const std::string &Workspace::getName() const { return m_name; }
 
+/**
+ * Append the blocks of memory held by the workspace. Workspaces that share
+ * data with other workspaces, e.g. through Kernel::cow_ptr, should report
+ * each shared buffer as a separate block so that it can be counted once.
+ * The memory held directly by the workspace object is reported with an
+ * empty owner. The default reports the whole workspace as such a block.
+ * @param blocks :: A list to append the blocks to
+ */
+void Workspace::getMemoryBlocks(std::vector<MemoryBlock> &blocks) const {
+  blocks.push_back({{}, getMemorySize()});
+}
+
 /**
  * Check whether other algorithms have been applied to the
  * workspace by checking the history length.
@@ -492,6 +492,23 @@ size_t WorkspaceGroup::getMemorySize() const {
   return total;
 }
 
+/**
+ * Append the memory blocks of all members. A group holds no data of its own.
+ * The blocks a member reports as its own are attributed to the member.
+ * @param blocks :: A list to append the blocks to
+ */
+void WorkspaceGroup::getMemoryBlocks(std::vector<MemoryBlock> &blocks) const {
+  std::lock_guard<std::recursive_mutex> _lock(m_mutex);
+  for (const auto &workspace : m_workspaces) {
+    const auto first = blocks.size();
+    workspace->getMemoryBlocks(blocks);
+    for (auto i = first; i < blocks.size(); ++i) {
+      if (blocks[i].owner.expired())
+        blocks[i].owner = workspace;
+    }
+  }
+}
+
 } // namespace API
 } // namespace Mantid
 
@@ -59,18 +59,17 @@ WorkspaceHistory::WorkspaceHistory() : m_environment() {}
 WorkspaceHistory::~WorkspaceHistory() = default;
 
 /**
-  Standard Copy Constructor
+  Standard Copy Constructor. The list of algorithms is shared with the copy
+  until either is changed.
   @param A :: WorkspaceHistory Item to copy
  */
 WorkspaceHistory::WorkspaceHistory(const WorkspaceHistory &A)
-    : m_environment(A.m_environment) {
-  m_algorithms = A.m_algorithms;
-}
+    : m_environment(A.m_environment), m_algorithms(A.m_algorithms) {}
 
 /// Returns a const reference to the algorithmHistory
 const Mantid::API::AlgorithmHistories &
 WorkspaceHistory::getAlgorithmHistories() const {
-  return m_algorithms;
+  return *m_algorithms;
 }
 /// Returns a const reference to the EnvironmentHistory
 const Kernel::EnvironmentHistory &
@@ -84,6 +83,13 @@ void WorkspaceHistory::addHistory(const WorkspaceHistory &otherHistory) {
   if (this == &otherHistory) {
     return;
   }
+  // Nothing to merge: share the other list rather than copying it. This is
+  // the common case of an output taking the history of its input.
+  if (m_algorithms->empty() ||
+      m_algorithms.get() == otherHistory.m_algorithms.get()) {
+    m_algorithms = otherHistory.m_algorithms;
+    return;
+  }
 
   // Merge the histories
   const AlgorithmHistories &otherAlgorithms =
@@ -102,11 +108,12 @@ void WorkspaceHistory::addHistory(const WorkspaceHistory &otherHistory) {
   //   "the constructor actually construct a new node for every element, before
   //   checking its value to determine if it should actually be inserted."
   UniqueAlgorithmHistories uniqueHistories;
-  for (const auto &algorithmHistory : m_algorithms) {
+  for (const auto &algorithmHistory : *m_algorithms) {
     uniqueHistories.insert(algorithmHistory);
   }
-  m_algorithms.assign(std::begin(uniqueHistories), std::end(uniqueHistories));
-  std::sort(std::begin(m_algorithms), std::end(m_algorithms),
+  auto &algorithms = m_algorithms.access();
+  algorithms.assign(std::begin(uniqueHistories), std::end(uniqueHistories));
+  std::sort(std::begin(algorithms), std::end(algorithms),
             AlgorithmHistorySearch());
 }
 
@@ -114,24 +121,26 @@ void WorkspaceHistory::addHistory(const WorkspaceHistory &otherHistory) {
 void WorkspaceHistory::addHistory(AlgorithmHistory_sptr algHistory) {
   // Assume it is always sorted as algorithm history should only be inserted in
   // the correct order
-  m_algorithms.emplace_back(std::move(algHistory));
+  m_algorithms.access().emplace_back(std::move(algHistory));
 }
 
 /*
  Return the history length
  */
-size_t WorkspaceHistory::size() const { return m_algorithms.size(); }
+size_t WorkspaceHistory::size() const { return m_algorithms->size(); }
 
 /**
  * Query if the history is empty or not
  * @returns True if the list is empty, false otherwise
  */
-bool WorkspaceHistory::empty() const { return m_algorithms.empty(); }
+bool WorkspaceHistory::empty() const { return m_algorithms->empty(); }
 
 /**
  * Empty the list of algorithm history objects.
  */
-void WorkspaceHistory::clearHistory() { m_algorithms.clear(); }
+void WorkspaceHistory::clearHistory() {
+  m_algorithms = boost::make_shared<AlgorithmHistories>();
+}
 
 /**
  * Retrieve an algorithm history by index
@@ -145,7 +154,7 @@ WorkspaceHistory::getAlgorithmHistory(const size_t index) const {
     throw std::out_of_range(
         "WorkspaceHistory::getAlgorithmHistory() - Index out of range");
   }
-  return *std::next(m_algorithms.cbegin(), index);
+  return *std::next(m_algorithms->cbegin(), index);
 }
 
 /**
@@ -174,7 +183,7 @@ WorkspaceHistory::getAlgorithm(const size_t index) const {
  * @returns A shared pointer to the algorithm
  */
 boost::shared_ptr<IAlgorithm> WorkspaceHistory::lastAlgorithm() const {
-  if (m_algorithms.empty()) {
+  if (m_algorithms->empty()) {
     throw std::out_of_range(
         "WorkspaceHistory::lastAlgorithm() - History contains no algorithms.");
   }
@@ -189,7 +198,7 @@ boost::shared_ptr<IAlgorithm> WorkspaceHistory::lastAlgorithm() const {
 void WorkspaceHistory::printSelf(std::ostream &os, const int indent) const {
   os << std::string(indent, ' ') << m_environment << '\n';
   os << std::string(indent, ' ') << "Histories:\n";
-  for (const auto &algorithm : m_algorithms) {
+  for (const auto &algorithm : *m_algorithms) {
     os << '\n';
     algorithm->printSelf(os, indent + 2);
   }
@@ -201,8 +210,11 @@ void WorkspaceHistory::printSelf(std::ostream &os, const int indent) const {
  * Code taken from NexusFileIO.cpp on May 14, 2012.
  *
  * @param file :: previously opened NXS file.
+ * @param links :: If given, the algorithm history groups already written to
+ * the file, which are linked to rather than written again.
  */
-void WorkspaceHistory::saveNexus(::NeXus::File *file) const {
+void WorkspaceHistory::saveNexus(::NeXus::File *file,
+                                 AlgorithmHistoryNexusLinks *links) const {
   file->makeGroup("process", "NXprocess", true);
   std::stringstream output;
 
@@ -224,8 +236,8 @@ void WorkspaceHistory::saveNexus(::NeXus::File *file) const {
 
   // Algorithm History
   int algCount = 0;
-  for (const auto &algorithm : m_algorithms) {
-    algorithm->saveNexus(file, algCount);
+  for (const auto &algorithm : *m_algorithms) {
+    algorithm->saveNexus(file, algCount, links);
   }
 
   // close process group
@@ -496,7 +508,7 @@ std::ostream &operator<<(std::ostream &os, const WorkspaceHistory &WH) {
 }
 
 bool WorkspaceHistory::operator==(const WorkspaceHistory &otherHistory) const {
-  return m_algorithms == otherHistory.m_algorithms;
+  return *m_algorithms == *otherHistory.m_algorithms;
 }
 
 } // namespace API
@@ -0,0 +1,274 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/WorkspaceMemoryLedger.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace API {
+
+namespace {
+/**
+ * Collect the distinct blocks of memory held by a workspace. The blocks it
+ * reports as its own are attributed to the workspace object.
+ * @param workspace :: The workspace to query
+ * @return The blocks, each owner listed once
+ */
+std::vector<Workspace::MemoryBlock>
+distinctBlocks(const Workspace_const_sptr &workspace) {
+  std::vector<Workspace::MemoryBlock> reported;
+  workspace->getMemoryBlocks(reported);
+  for (auto &item : reported) {
+    if (item.owner.expired())
+      item.owner = workspace;
+  }
+  // A block may be reported several times, e.g. an X array shared by all
+  // spectra. Keep the first occurrence of each owner.
+  const boost::owner_less<boost::weak_ptr<const void>> before;
+  std::stable_sort(reported.begin(), reported.end(),
+                   [&before](const Workspace::MemoryBlock &lhs,
+                             const Workspace::MemoryBlock &rhs) {
+                     return before(lhs.owner, rhs.owner);
+                   });
+  reported.erase(std::unique(reported.begin(), reported.end(),
+                             [&before](const Workspace::MemoryBlock &lhs,
+                                       const Workspace::MemoryBlock &rhs) {
+                               return !before(lhs.owner, rhs.owner) &&
+                                      !before(rhs.owner, lhs.owner);
+                             }),
+                 reported.end());
+  return reported;
+}
+} // namespace
+
+/**
+ * Record the memory held by a named workspace. The entry is marked as the
+ * most recently used and any spill information, including a failure to
+ * spill, is cleared.
+ * @param name :: The name of the workspace
+ * @param workspace :: The workspace stored under the name
+ */
+void WorkspaceMemoryLedger::record(const std::string &name,
+                                   const Workspace_const_sptr &workspace) {
+  const auto reported = distinctBlocks(workspace);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto &entry = m_entries[name];
+  holdBlocks(entry, reported);
+  entry.spillFile.clear();
+  entry.unspillable = false;
+  entry.lastAccess = ++m_clock;
+}
+
+/**
+ * Refresh the memory held by a workspace that may have been modified in
+ * place since it was recorded. Its usage order and spill information are
+ * left untouched. Unknown and spilled workspaces are ignored.
+ * @param name :: The name of the workspace
+ * @param workspace :: The workspace stored under the name
+ */
+void WorkspaceMemoryLedger::update(const std::string &name,
+                                   const Workspace_const_sptr &workspace) {
+  const auto reported = distinctBlocks(workspace);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_entries.find(name);
+  if (it == m_entries.end() || !it->second.spillFile.empty())
+    return;
+  holdBlocks(it->second, reported);
+}
+
+/**
+ * Stop accounting for a workspace
+ * @param name :: The name of the workspace
+ */
+void WorkspaceMemoryLedger::remove(const std::string &name) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_entries.find(name);
+  if (it == m_entries.end())
+    return;
+  releaseBlocks(it->second);
+  m_entries.erase(it);
+}
+
+/**
+ * Move the accounting of a workspace to a new name. An entry already stored
+ * under the new name is discarded.
+ * @param oldName :: The current name of the workspace
+ * @param newName :: The new name of the workspace
+ */
+void WorkspaceMemoryLedger::rename(const std::string &oldName,
+                                   const std::string &newName) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_entries.find(oldName);
+  if (it == m_entries.end())
+    return;
+  auto entry = std::move(it->second);
+  m_entries.erase(it);
+  auto target = m_entries.find(newName);
+  if (target != m_entries.end()) {
+    releaseBlocks(target->second);
+    target->second = std::move(entry);
+  } else {
+    m_entries.emplace(newName, std::move(entry));
+  }
+}
+
+/// Forget all entries
+void WorkspaceMemoryLedger::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+  m_blocks.clear();
+  m_total = 0;
+}
+
+/**
+ * Mark a workspace as the most recently used
+ * @param name :: The name of the workspace
+ */
+void WorkspaceMemoryLedger::touch(const std::string &name) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_entries.find(name);
+  if (it != m_entries.end())
+    it->second.lastAccess = ++m_clock;
+}
+
+/**
+ * @param name :: The name of the workspace
+ * @return The number of bytes held by the workspace, including blocks it
+ * shares with other workspaces. Zero if unknown or spilled.
+ */
+size_t WorkspaceMemoryLedger::memoryOf(const std::string &name) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_entries.find(name);
+  return it != m_entries.end() ? it->second.bytes : 0;
+}
+
+/// @return The number of bytes held by all workspaces, counting shared blocks
+/// once
+size_t WorkspaceMemoryLedger::totalMemory() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_total;
+}
+
+/// @return The names of the workspaces held in memory that may be spilled,
+/// ordered from the least to the most recently used
+std::vector<std::string> WorkspaceMemoryLedger::leastRecentlyUsed() const {
+  std::vector<std::pair<uint64_t, std::string>> inMemory;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    inMemory.reserve(m_entries.size());
+    for (const auto &item : m_entries) {
+      if (item.second.spillFile.empty() && !item.second.unspillable)
+        inMemory.emplace_back(item.second.lastAccess, item.first);
+    }
+  }
+  std::sort(inMemory.begin(), inMemory.end());
+  std::vector<std::string> names;
+  names.reserve(inMemory.size());
+  for (auto &item : inMemory)
+    names.emplace_back(std::move(item.second));
+  return names;
+}
+
+/**
+ * Record that a workspace has been written to a file and no longer holds
+ * any memory.
+ * @param name :: The name of the workspace
+ * @param filename :: The file holding the workspace
+ */
+void WorkspaceMemoryLedger::markSpilled(const std::string &name,
+                                        const std::string &filename) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto &entry = m_entries[name];
+  releaseBlocks(entry);
+  entry.spillFile = filename;
+}
+
+/**
+ * @param name :: The name of the workspace
+ * @return True if the workspace has been spilled to a file
+ */
+bool WorkspaceMemoryLedger::isSpilled(const std::string &name) const {
+  return !spillFile(name).empty();
+}
+
+/**
+ * @param name :: The name of the workspace
+ * @return The file the workspace was spilled to, empty if it is in memory
+ */
+std::string WorkspaceMemoryLedger::spillFile(const std::string &name) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_entries.find(name);
+  return it != m_entries.end() ? it->second.spillFile : std::string();
+}
+
+/**
+ * Record that a workspace could not be written to a file. It is no longer
+ * offered for spilling until a workspace is recorded under its name again.
+ * @param name :: The name of the workspace
+ */
+void WorkspaceMemoryLedger::markUnspillable(const std::string &name) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_entries.find(name);
+  if (it != m_entries.end())
+    it->second.unspillable = true;
+}
+
+/**
+ * @param name :: The name of the workspace
+ * @return True if spilling the workspace has failed
+ */
+bool WorkspaceMemoryLedger::isUnspillable(const std::string &name) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_entries.find(name);
+  return it != m_entries.end() && it->second.unspillable;
+}
+
+/**
+ * Replace the blocks held by an entry. Must be called with the mutex held.
+ * @param entry :: The entry to update
+ * @param blocks :: The distinct blocks the entry now holds
+ */
+void WorkspaceMemoryLedger::holdBlocks(
+    Entry &entry, const std::vector<Workspace::MemoryBlock> &blocks) {
+  // Take the new references first so that blocks kept by the entry are not
+  // dropped from the total in between. A block may have been resized in
+  // place so its latest size replaces the one recorded.
+  for (const auto &item : blocks) {
+    auto &block = m_blocks[item.owner];
+    m_total = m_total - block.bytes + item.bytes;
+    block.bytes = item.bytes;
+    ++block.holders;
+  }
+  releaseBlocks(entry);
+  entry.blocks.reserve(blocks.size());
+  for (const auto &item : blocks) {
+    entry.blocks.push_back(item.owner);
+    entry.bytes += item.bytes;
+  }
+}
+
+/**
+ * Drop the references an entry holds on its blocks. Must be called with the
+ * mutex held.
+ * @param entry :: The entry to release
+ */
+void WorkspaceMemoryLedger::releaseBlocks(Entry &entry) {
+  for (const auto &owner : entry.blocks) {
+    auto it = m_blocks.find(owner);
+    if (it == m_blocks.end())
+      continue;
+    if (--it->second.holders == 0) {
+      m_total -= it->second.bytes;
+      m_blocks.erase(it);
+    }
+  }
+  entry.blocks.clear();
+  entry.bytes = 0;
+}
+
+} // namespace API
+} // namespace Mantid
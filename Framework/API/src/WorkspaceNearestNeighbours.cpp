@@ -9,10 +9,9 @@
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/DetectorGroup.h"
 #include "MantidGeometry/Objects/BoundingBox.h"
-// Nearest neighbours library
-#include "MantidKernel/ANN/ANN.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Timer.h"
+#include "MantidKernel/make_unique.h"
 
 namespace Mantid {
 using namespace Geometry;
@@ -20,6 +19,19 @@ namespace API {
 using Kernel::V3D;
 using Mantid::detid_t;
 
+namespace {
+/// Convert a position held by the search tree to a V3D
+V3D toV3D(const Eigen::Vector3d &point) {
+  return V3D(point[0], point[1], point[2]);
+}
+
+/// The search tree reports the detector itself, and any other at exactly the
+/// same position, at zero distance. These are not neighbours.
+bool isSelfMatch(const std::tuple<Eigen::Vector3d, size_t, double> &found) {
+  return std::get<2>(found) == 0.;
+}
+} // namespace
+
 /**
  * Constructor
  * @param nNeighbours :: Number of neighbours to use
@@ -36,7 +48,7 @@ WorkspaceNearestNeighbours::WorkspaceNearestNeighbours(
     : m_spectrumInfo(spectrumInfo),
       m_spectrumNumbers(std::move(spectrumNumbers)),
       m_noNeighbours(nNeighbours),
-      m_cutoff(std::numeric_limits<double>::lowest()), m_radius(0.),
+      m_cutoff(std::numeric_limits<double>::lowest()),
       m_bIgnoreMaskedDetectors(ignoreMaskedDetectors) {
   this->build(m_noNeighbours);
 }
@@ -69,7 +81,6 @@ WorkspaceNearestNeighbours::neighboursInRadius(const specnum_t spectrum,
         "NearestNeighbours::neighbours - Invalid radius parameter.");
   }
 
-  std::map<specnum_t, V3D> result;
   if (radius == 0.0) {
     const int eightNearest = 8;
     if (m_noNeighbours != eightNearest) {
@@ -79,24 +90,14 @@ WorkspaceNearestNeighbours::neighboursInRadius(const specnum_t spectrum,
       // Cast is necessary as the user should see this as a const member
       const_cast<WorkspaceNearestNeighbours *>(this)->build(eightNearest);
     }
-    result = defaultNeighbours(spectrum);
-  } else if (radius > m_cutoff && m_radius != radius) {
-    // We might have to see how efficient this ends up being.
-    int neighbours = m_noNeighbours + 1;
-    while (true) {
-      try {
-        const_cast<WorkspaceNearestNeighbours *>(this)->build(neighbours);
-      } catch (std::invalid_argument &) {
-        break;
-      }
-      if (radius < m_cutoff)
-        break;
-      else
-        neighbours += 1;
-    }
+    return defaultNeighbours(spectrum);
+  }
+  // The graph may not hold every neighbour within a larger radius
+  if (radius > m_cutoff) {
+    return neighboursWithinRadius(spectrum, radius);
   }
-  m_radius = radius;
 
+  std::map<specnum_t, V3D> result;
   std::map<detid_t, V3D> nearest = defaultNeighbours(spectrum);
   for (std::map<specnum_t, V3D>::const_iterator cit = nearest.begin();
        cit != nearest.end(); ++cit) {
@@ -121,8 +122,7 @@ void WorkspaceNearestNeighbours::build(const int noNeighbours) {
     throw std::runtime_error(
         "NearestNeighbours::build - Cannot find any spectra");
   }
-  const int nspectra =
-      static_cast<int>(indices.size()); // ANN only deals with integers
+  const int nspectra = static_cast<int>(indices.size());
   if (noNeighbours >= nspectra) {
     throw std::invalid_argument(
         "NearestNeighbours::build - Invalid number of neighbours");
@@ -133,65 +133,64 @@ void WorkspaceNearestNeighbours::build(const int noNeighbours) {
   m_specToVertex.clear();
   m_noNeighbours = noNeighbours;
 
-  BoundingBox bbox;
-  // Base the scaling on the first detector, should be adequate but we can look
-  // at this
-  const auto &firstDet = m_spectrumInfo.detector(indices.front());
-  firstDet.getBoundingBox(bbox);
-  m_scale = V3D(bbox.width());
-  ANNpointArray dataPoints = annAllocPts(nspectra, 3);
-  MapIV pointNoToVertex;
+  if (!m_tree) {
+    BoundingBox bbox;
+    // Base the scaling on the first detector, should be adequate but we can
+    // look at this
+    const auto &firstDet = m_spectrumInfo.detector(indices.front());
+    firstDet.getBoundingBox(bbox);
+    m_scale = V3D(bbox.width());
+    m_points.reserve(indices.size());
+    for (const auto i : indices) {
+      const V3D pos = m_spectrumInfo.position(i) / m_scale;
+      m_points.emplace_back(pos.X(), pos.Y(), pos.Z());
+    }
+    m_tree = Kernel::make_unique<Kernel::NearestNeighbours<3>>(m_points);
+  }
 
-  int pointNo = 0;
+  // Vertices are added in point order so a point's index in the tree is also
+  // its vertex descriptor
   for (const auto i : indices) {
     const specnum_t spectrum = m_spectrumNumbers[i];
-    V3D pos = m_spectrumInfo.position(i) / m_scale;
-    dataPoints[pointNo][0] = pos.X();
-    dataPoints[pointNo][1] = pos.Y();
-    dataPoints[pointNo][2] = pos.Z();
     Vertex vertex = boost::add_vertex(spectrum, m_graph);
-    pointNoToVertex[pointNo] = vertex;
     m_specToVertex[spectrum] = vertex;
-    ++pointNo;
   }
 
-  auto annTree = std::make_unique<ANNkd_tree>(dataPoints, nspectra, 3);
-  pointNo = 0;
-  // Run the nearest neighbour search on each detector, reusing the arrays
-  // Set size initially to avoid array index error when testing in debug mode
-  std::vector<ANNidx> nnIndexList(m_noNeighbours);
-  std::vector<ANNdist> nnDistList(m_noNeighbours);
-
-  for (const auto idx : indices) {
-    ANNpoint scaledPos = dataPoints[pointNo];
-    annTree->annkSearch(scaledPos,      // Point to search nearest neighbours of
-                        m_noNeighbours, // Number of neighbours to find (8)
-                        nnIndexList.data(), // Index list of results
-                        nnDistList.data(), // List of distances to each of these
-                        0.0 // Error bound (?) is this the radius to search in?
-    );
+  // Search for the neighbours of every detector at once, allowing for the
+  // detector itself being found
+  const auto numNeighbours = static_cast<size_t>(m_noNeighbours);
+  auto nearest = m_tree->findNearest(m_points, numNeighbours + 1);
+  for (size_t pointNo = 0; pointNo < m_points.size(); ++pointNo) {
+    auto &found = nearest[pointNo];
+    while (true) {
+      const auto selfMatches = static_cast<size_t>(
+          std::count_if(found.cbegin(), found.cend(), isSelfMatch));
+      if (found.size() >= numNeighbours + selfMatches ||
+          found.size() == m_points.size())
+        break;
+      // Other detectors share this position. Search again for more.
+      found = m_tree->findNearest(m_points[pointNo], numNeighbours + selfMatches);
+    }
+
     // The distances that are returned are in our scaled coordinate
     // system. We store the real space ones.
-    const V3D realPos = V3D(scaledPos[0], scaledPos[1], scaledPos[2]) * m_scale;
-    for (int i = 0; i < m_noNeighbours; i++) {
-      ANNidx index = nnIndexList[i];
-      V3D neighbour = V3D(dataPoints[index][0], dataPoints[index][1],
-                          dataPoints[index][2]) *
-                      m_scale;
-      V3D distance = neighbour - realPos;
+    const V3D realPos = toV3D(m_points[pointNo]) * m_scale;
+    size_t added = 0;
+    for (const auto &neighbour : found) {
+      if (isSelfMatch(neighbour))
+        continue;
+      if (added++ == numNeighbours)
+        break;
+      V3D distance = toV3D(std::get<0>(neighbour)) * m_scale - realPos;
       double separation = distance.norm();
-      boost::add_edge(m_specToVertex[m_spectrumNumbers[idx]], // from
-                      pointNoToVertex[index],                 // to
+      boost::add_edge(pointNo,                 // from
+                      std::get<1>(neighbour), // to
                       distance, m_graph);
       if (separation > m_cutoff) {
         m_cutoff = separation;
       }
     }
-    pointNo++;
   }
-  annDeallocPts(dataPoints);
-  annClose();
-  pointNoToVertex.clear();
 
   m_vertexID = get(boost::vertex_name, m_graph);
   m_edgeLength = get(boost::edge_name, m_graph);
@@ -227,6 +226,42 @@ WorkspaceNearestNeighbours::defaultNeighbours(const specnum_t spectrum) const {
   }
 }
 
+/**
+ * Returns a map of the spectrum numbers to all detectors within a given
+ * distance of the detector specified in the argument.
+ * @param spectrum :: The spectrum number
+ * @param radius :: cut-off distance for detectors to return
+ * @return map of spectrum number to distance
+ * @throw NotFoundError if the spectrum is not recognised
+ */
+std::map<specnum_t, V3D>
+WorkspaceNearestNeighbours::neighboursWithinRadius(const specnum_t spectrum,
+                                                   const double radius) const {
+  auto vertex = m_specToVertex.find(spectrum);
+  if (vertex == m_specToVertex.end()) {
+    throw Mantid::Kernel::Exception::NotFoundError(
+        "NearestNeighbours: Unable to find spectrum in vertex map", spectrum);
+  }
+
+  // The tree is searched in scaled coordinates. Search the sphere that
+  // contains the real space one and filter the results.
+  const double smallestScale =
+      std::min(std::min(m_scale.X(), m_scale.Y()), m_scale.Z());
+  const auto &point = m_points[vertex->second];
+  const V3D realPos = toV3D(point) * m_scale;
+  std::map<specnum_t, V3D> result;
+  for (const auto &neighbour :
+       m_tree->findInRadius(point, radius / smallestScale)) {
+    if (isSelfMatch(neighbour))
+      continue;
+    const V3D distance = toV3D(std::get<0>(neighbour)) * m_scale - realPos;
+    if (distance.norm() <= radius) {
+      result[specnum_t(m_vertexID[std::get<1>(neighbour)])] = distance;
+    }
+  }
+  return result;
+}
+
 /// Returns the list of valid spectrum indices
 std::vector<size_t> WorkspaceNearestNeighbours::getSpectraDetectors() {
   std::vector<size_t> indices;
@@ -0,0 +1,199 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_API_ALGORITHMRESULTCACHETEST_H_
+#define MANTID_API_ALGORITHMRESULTCACHETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/AlgorithmResultCache.h"
+#include "MantidAPI/WorkspaceProperty.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/make_unique.h"
+#include "MantidTestHelpers/FakeObjects.h"
+
+#include <Poco/File.h>
+#include <Poco/TemporaryFile.h>
+
+using namespace Mantid::API;
+using Mantid::Kernel::ConfigService;
+using Mantid::Kernel::Direction;
+
+namespace {
+/// Sums the first spectrum of its input, counting how often it runs
+class CachedTestAlgorithm : public Algorithm {
+public:
+  const std::string name() const override { return "CachedTestAlgorithm"; }
+  int version() const override { return 1; }
+  const std::string summary() const override { return "Test"; }
+  bool cacheable() const override { return m_cacheable; }
+
+  void init() override {
+    declareProperty(Mantid::Kernel::make_unique<WorkspaceProperty<>>(
+        "InputWorkspace", "", Direction::Input));
+    declareProperty("Factor", 1.0);
+    declareProperty("Result", 0.0, Direction::Output);
+  }
+  void exec() override {
+    ++executions;
+    MatrixWorkspace_const_sptr ws = getProperty("InputWorkspace");
+    const double factor = getProperty("Factor");
+    double sum(0.);
+    for (const auto y : ws->readY(0))
+      sum += y;
+    setProperty("Result", factor * sum);
+  }
+
+  int executions = 0;
+  bool m_cacheable = true;
+};
+
+boost::shared_ptr<WorkspaceTester> makeWorkspace(double value) {
+  auto ws = boost::make_shared<WorkspaceTester>();
+  ws->initialize(2, 4, 3);
+  for (size_t i = 0; i < ws->getNumberHistograms(); ++i)
+    ws->dataY(i).assign(3, value);
+  return ws;
+}
+} // namespace
+
+class AlgorithmResultCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static AlgorithmResultCacheTest *createSuite() {
+    return new AlgorithmResultCacheTest();
+  }
+  static void destroySuite(AlgorithmResultCacheTest *suite) { delete suite; }
+
+  void setUp() override {
+    m_directory = Poco::TemporaryFile::tempName();
+    Poco::File(m_directory).createDirectories();
+  }
+
+  void tearDown() override { Poco::File(m_directory).remove(true); }
+
+  void test_key_depends_on_inputs_but_not_on_outputs() {
+    auto ws = makeWorkspace(1.);
+    CachedTestAlgorithm first;
+    configure(first, ws, 2.);
+    CachedTestAlgorithm second;
+    configure(second, Workspace_sptr(ws->clone()), 2.);
+    second.setProperty("Result", 5.);
+    CachedTestAlgorithm otherFactor;
+    configure(otherFactor, ws, 3.);
+    CachedTestAlgorithm otherData;
+    configure(otherData, makeWorkspace(2.), 2.);
+
+    const auto key = AlgorithmResultCache::key(first);
+    TS_ASSERT(!key.empty());
+    TS_ASSERT_EQUALS(AlgorithmResultCache::key(second), key);
+    TS_ASSERT_DIFFERS(AlgorithmResultCache::key(otherFactor), key);
+    TS_ASSERT_DIFFERS(AlgorithmResultCache::key(otherData), key);
+  }
+
+  void test_algorithms_that_are_not_cacheable_have_no_key() {
+    CachedTestAlgorithm alg;
+    configure(alg, makeWorkspace(1.), 1.);
+    alg.m_cacheable = false;
+    TS_ASSERT(AlgorithmResultCache::key(alg).empty());
+  }
+
+  void test_content_hash_changes_with_masking() {
+    auto ws = makeWorkspace(1.);
+    const auto hash = AlgorithmResultCache::contentHash(*ws);
+    TS_ASSERT_EQUALS(AlgorithmResultCache::contentHash(*ws->clone()), hash);
+    ws->flagMasked(0, 1);
+    TS_ASSERT_DIFFERS(AlgorithmResultCache::contentHash(*ws), hash);
+  }
+
+  void test_store_and_restore_outputs() {
+    AlgorithmResultCache cache(m_directory, 1024 * 1024);
+    CachedTestAlgorithm alg;
+    configure(alg, makeWorkspace(1.), 2.);
+    const auto key = AlgorithmResultCache::key(alg);
+    TS_ASSERT(!cache.restore(alg, key));
+    alg.execute();
+    TS_ASSERT(cache.store(alg, key));
+    TS_ASSERT_LESS_THAN(0, cache.size());
+
+    CachedTestAlgorithm restored;
+    configure(restored, makeWorkspace(1.), 2.);
+    TS_ASSERT(cache.restore(restored, key));
+    const double result = restored.getProperty("Result");
+    TS_ASSERT_EQUALS(result, 6.);
+    TS_ASSERT_EQUALS(restored.executions, 0);
+  }
+
+  void test_least_recently_used_entries_are_evicted() {
+    AlgorithmResultCache unlimited(m_directory, 1024 * 1024);
+    std::vector<std::string> keys;
+    for (int i = 0; i < 3; ++i) {
+      CachedTestAlgorithm alg;
+      configure(alg, makeWorkspace(1.), static_cast<double>(i));
+      keys.emplace_back(AlgorithmResultCache::key(alg));
+      alg.execute();
+      unlimited.store(alg, keys.back());
+    }
+    // Make the first entry the least recently used
+    Poco::Timestamp anHourAgo;
+    anHourAgo -= Poco::Timestamp::TimeDiff(3600) * 1000000;
+    Poco::File(m_directory + "/" + keys.front()).setLastModified(anHourAgo);
+
+    // There is only room for the existing entries
+    AlgorithmResultCache limited(m_directory, unlimited.size());
+    CachedTestAlgorithm alg;
+    configure(alg, makeWorkspace(1.), 3.);
+    alg.execute();
+    const auto key = AlgorithmResultCache::key(alg);
+    TS_ASSERT(limited.store(alg, key));
+    TS_ASSERT_LESS_THAN_EQUALS(limited.size(), unlimited.size());
+
+    CachedTestAlgorithm oldest;
+    configure(oldest, makeWorkspace(1.), 0.);
+    TS_ASSERT(!limited.restore(oldest, keys.front()));
+    CachedTestAlgorithm newest;
+    configure(newest, makeWorkspace(1.), 3.);
+    TS_ASSERT(limited.restore(newest, key));
+  }
+
+  void test_execute_uses_the_cache_when_it_is_enabled() {
+    auto &config = ConfigService::Instance();
+    const std::string directory =
+        config.getString("algorithms.cache.directory");
+    config.setString("algorithms.cache.directory", m_directory);
+    auto ws = makeWorkspace(1.);
+
+    CachedTestAlgorithm first;
+    configure(first, ws, 2.);
+    first.execute();
+    CachedTestAlgorithm second;
+    configure(second, ws, 2.);
+    second.execute();
+    config.setString("algorithms.cache.directory", directory);
+
+    TS_ASSERT_EQUALS(first.executions, 1);
+    TS_ASSERT_EQUALS(second.executions, 0);
+    TS_ASSERT(second.isExecuted());
+    const double result = second.getProperty("Result");
+    TS_ASSERT_EQUALS(result, 6.);
+  }
+
+private:
+  void configure(CachedTestAlgorithm &alg, const Workspace_sptr &ws,
+                 double factor) {
+    alg.initialize();
+    alg.setChild(true);
+    alg.setRethrows(true);
+    alg.setProperty("InputWorkspace", ws);
+    alg.setProperty("Factor", factor);
+  }
+
+  std::string m_directory;
+};
+
+#endif /* MANTID_API_ALGORITHMRESULTCACHETEST_H_ */
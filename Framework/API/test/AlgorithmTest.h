@@ -20,6 +20,7 @@
 #include "MantidAPI/WorkspaceHistory.h"
 #include "MantidAPI/WorkspaceProperty.h"
 #include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/ReadLock.h"
 #include "MantidKernel/RebinParamsValidator.h"
@@ -78,6 +79,15 @@ public:
 };
 DECLARE_ALGORITHM(StubbedWorkspaceAlgorithm)
 
+class ConcurrentGroupsAlgorithm : public StubbedWorkspaceAlgorithm {
+public:
+  const std::string name() const override {
+    return "ConcurrentGroupsAlgorithm";
+  }
+  bool canProcessGroupsConcurrently() const override { return true; }
+};
+DECLARE_ALGORITHM(ConcurrentGroupsAlgorithm)
+
 class StubbedWorkspaceAlgorithm2 : public Algorithm {
 public:
   StubbedWorkspaceAlgorithm2() : Algorithm() {}
@@ -196,6 +206,33 @@ public:
 
 DECLARE_ALGORITHM(IndexingAlgorithm)
 
+class InPlaceAlgorithm : public Algorithm {
+public:
+  const std::string name() const override { return "InPlaceAlgorithm"; }
+  int version() const override { return 1; }
+  const std::string summary() const override { return "Test in place"; }
+  std::pair<std::string, std::string>
+  inPlaceWorkspaceProperties() const override {
+    return {"InputWorkspace", "OutputWorkspace"};
+  }
+
+  void init() override {
+    declareProperty(make_unique<WorkspaceProperty<MatrixWorkspace>>(
+        "InputWorkspace", "", Direction::Input));
+    declareProperty(make_unique<WorkspaceProperty<MatrixWorkspace>>(
+        "OutputWorkspace", "", Direction::Output));
+  }
+
+  void exec() override {
+    MatrixWorkspace_sptr input = getProperty("InputWorkspace");
+    MatrixWorkspace_sptr output = getProperty("OutputWorkspace");
+    if (output != input)
+      output = input->clone();
+    output->dataY(0)[0] += 1.;
+    setProperty("OutputWorkspace", output);
+  }
+};
+
 class AlgorithmTest : public CxxTest::TestSuite {
 public:
   // This pair of boilerplate methods prevent the suite being created statically
@@ -680,6 +717,44 @@ public:
     TS_ASSERT_EQUALS(ws3->getTitle(), "A_3+B_3+charlie");
   }
 
+  /// Entries processed concurrently keep their order in the output group and
+  /// each records the history of the parent
+  void test_processGroups_concurrently() {
+    auto &config = ConfigService::Instance();
+    const std::string concurrency =
+        config.getString("algorithms.groups.concurrency");
+    config.setString("algorithms.groups.concurrency", "3");
+    makeWorkspaceGroup("A", "A_1,A_2,A_3,A_4,A_5,A_6,A_7,A_8");
+    makeWorkspaceGroup("B", "");
+
+    ConcurrentGroupsAlgorithm alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace1", "A");
+    alg.setPropertyValue("InputWorkspace2", "B");
+    alg.setPropertyValue("Number", "234");
+    alg.setPropertyValue("OutputWorkspace1", "D");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    config.setString("algorithms.groups.concurrency", concurrency);
+    TS_ASSERT(alg.isExecuted());
+
+    auto group =
+        AnalysisDataService::Instance().retrieveWS<WorkspaceGroup>("D");
+    TS_ASSERT_EQUALS(group->getNumberOfEntries(), 8);
+    for (int i = 0; i < group->getNumberOfEntries(); ++i) {
+      const std::string suffix = std::to_string(i + 1);
+      auto ws = group->getItem(i);
+      TS_ASSERT_EQUALS(ws->getName(), "D_" + suffix);
+      TS_ASSERT_EQUALS(ws->getTitle(), "A_" + suffix + "+B+");
+      const auto &history = ws->getHistory();
+      TS_ASSERT_EQUALS(history.size(), 1);
+      auto algHistory = history.getAlgorithmHistory(history.size() - 1);
+      TS_ASSERT_EQUALS(algHistory->name(), "ConcurrentGroupsAlgorithm");
+      TS_ASSERT_EQUALS(algHistory->getPropertyValue("InputWorkspace1"), "A");
+      TS_ASSERT_EQUALS(algHistory->getPropertyValue("OutputWorkspace1"), "D");
+      TS_ASSERT_EQUALS(algHistory->childHistorySize(), 0);
+    }
+  }
+
   /// One input is a group, rest are singles
   void test_processGroups_onlyOneGroup() {
     WorkspaceGroup_sptr group =
@@ -995,6 +1070,38 @@ public:
         std::runtime_error);
   }
 
+  void test_child_executes_in_place_when_it_holds_the_only_reference() {
+    auto input = boost::make_shared<WorkspaceTester>();
+    input->initialize(1, 2, 1);
+    const auto *address = input.get();
+    InPlaceAlgorithm alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setProperty("InputWorkspace", MatrixWorkspace_sptr(std::move(input)));
+    alg.setPropertyValue("OutputWorkspace", "out");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+
+    MatrixWorkspace_sptr output = alg.getProperty("OutputWorkspace");
+    TS_ASSERT_EQUALS(output.get(), address);
+    TS_ASSERT_EQUALS(output->readY(0)[0], 1.);
+  }
+
+  void test_child_does_not_execute_in_place_on_a_shared_input() {
+    auto input = boost::make_shared<WorkspaceTester>();
+    input->initialize(1, 2, 1);
+    InPlaceAlgorithm alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setProperty("InputWorkspace", input);
+    alg.setPropertyValue("OutputWorkspace", "out");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+
+    MatrixWorkspace_sptr output = alg.getProperty("OutputWorkspace");
+    TS_ASSERT_DIFFERS(output, input);
+    TS_ASSERT_EQUALS(output->readY(0)[0], 1.);
+    TS_ASSERT_EQUALS(input->readY(0)[0], 0.);
+  }
+
   void testIndexingAlgorithm_failExistingIndexProperty() {
     IndexingAlgorithm indexAlg;
     indexAlg.init();
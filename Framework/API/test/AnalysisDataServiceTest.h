@@ -31,6 +31,16 @@ private:
   }
 };
 using MockWorkspace_sptr = boost::shared_ptr<MockWorkspace>;
+
+/// A workspace whose size can change after it has been stored
+class ResizableWorkspace : public MockWorkspace {
+public:
+  size_t getMemorySize() const override { return m_size; }
+  void resize(size_t bytes) { m_size = bytes; }
+
+private:
+  size_t m_size = 1;
+};
 } // namespace
 
 class AnalysisDataServiceTest : public CxxTest::TestSuite {
@@ -500,6 +510,79 @@ public:
     TS_ASSERT(!ads.doesExist("null_workspace"));
   }
 
+  void test_memory_ledger_follows_the_service() {
+    const auto &ledger = ads.memoryLedger();
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 0);
+    addToADS("one");
+    addToADS("two");
+    TS_ASSERT_EQUALS(ledger.memoryOf("one"), 1);
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 2);
+
+    ads.rename("one", "three");
+    TS_ASSERT_EQUALS(ledger.memoryOf("one"), 0);
+    TS_ASSERT_EQUALS(ledger.memoryOf("three"), 1);
+
+    ads.remove("two");
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 1);
+    ads.clear();
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 0);
+  }
+
+  void test_group_members_are_counted_once() {
+    addGroupToADS("group");
+    TS_ASSERT_EQUALS(ads.memoryLedger().memoryOf("group"), 2);
+    TS_ASSERT_EQUALS(ads.memoryLedger().totalMemory(), 2);
+  }
+
+  void test_retrieve_marks_workspace_as_recently_used() {
+    addToADS("one");
+    addToADS("two");
+    ads.retrieve("one");
+    const std::vector<std::string> expected{"two", "one"};
+    TS_ASSERT_EQUALS(ads.memoryLedger().leastRecentlyUsed(), expected);
+  }
+
+  void test_workspace_that_cannot_be_spilled_is_not_tried_again() {
+    // The saving algorithm is not available here so spilling fails
+    ads.setMemoryBudget(1);
+    addToADS("one");
+    addToADS("two");
+    const auto &ledger = ads.memoryLedger();
+    TS_ASSERT(ledger.isUnspillable("one"));
+    TS_ASSERT(!ledger.isSpilled("one"));
+    TS_ASSERT_EQUALS(ledger.leastRecentlyUsed(),
+                     std::vector<std::string>(1, "two"));
+
+    // Replacing the workspace makes it a candidate again
+    addOrReplaceToADS("one");
+    TS_ASSERT(!ledger.isUnspillable("one"));
+    TS_ASSERT(ledger.isUnspillable("two"));
+    TS_ASSERT_EQUALS(ads.retrieve("one")->id(), "MockWorkspace");
+    ads.setMemoryBudget(0);
+  }
+
+  void test_workspace_modified_in_place_is_counted_again_under_a_budget() {
+    ads.setMemoryBudget(1000);
+    auto one = boost::make_shared<ResizableWorkspace>();
+    ads.add("one", one);
+    one->resize(500);
+    addToADS("two");
+    const auto &ledger = ads.memoryLedger();
+    TS_ASSERT_EQUALS(ledger.memoryOf("one"), 500);
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 501);
+    TS_ASSERT(!ledger.isUnspillable("one"));
+    ads.setMemoryBudget(0);
+  }
+
+  void test_topLevelItems_and_getObjects_do_not_change_the_usage_order() {
+    addToADS("b");
+    addToADS("a");
+    ads.topLevelItems();
+    ads.getObjects();
+    const std::vector<std::string> expected{"b", "a"};
+    TS_ASSERT_EQUALS(ads.memoryLedger().leastRecentlyUsed(), expected);
+  }
+
 private:
   /// If replace=true then usea addOrReplace
   void doAddingOnInvalidNameTests(bool replace) {
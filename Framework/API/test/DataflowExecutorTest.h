@@ -0,0 +1,229 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_API_DATAFLOWEXECUTORTEST_H_
+#define MANTID_API_DATAFLOWEXECUTORTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/DataflowExecutor.h"
+#include "MantidAPI/WorkspaceProperty.h"
+#include "MantidKernel/make_unique.h"
+#include "MantidTestHelpers/FakeObjects.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace Mantid::API;
+using Mantid::Kernel::Direction;
+
+namespace {
+/// Records which algorithms ran, in what order and how many at once
+struct RunRecord {
+  std::mutex mutex;
+  std::vector<std::string> order;
+  std::atomic<int> running{0};
+  std::atomic<int> maxRunning{0};
+  std::atomic<int> serialRunning{0};
+  std::atomic<int> maxSerialRunning{0};
+};
+
+void recordMax(std::atomic<int> &current, std::atomic<int> &maximum) {
+  int value = ++current;
+  int seen = maximum;
+  while (value > seen && !maximum.compare_exchange_weak(seen, value)) {
+  }
+}
+
+class DataflowTestAlgorithm : public Algorithm {
+public:
+  DataflowTestAlgorithm(RunRecord &record, const std::string &label,
+                        int sleepMs = 0, bool isThreadSafe = true,
+                        bool fail = false)
+      : m_record(record), m_label(label), m_sleepMs(sleepMs),
+        m_threadSafe(isThreadSafe), m_fail(fail) {}
+  const std::string name() const override { return "DataflowTestAlgorithm"; }
+  int version() const override { return 1; }
+  const std::string summary() const override { return "Test"; }
+  bool threadSafe() const override { return m_threadSafe; }
+
+  void init() override {
+    declareProperty(Mantid::Kernel::make_unique<WorkspaceProperty<Workspace>>(
+        "InputWorkspace", "", Direction::Input, PropertyMode::Optional));
+    declareProperty(Mantid::Kernel::make_unique<WorkspaceProperty<Workspace>>(
+        "OutputWorkspace", "", Direction::Output, PropertyMode::Optional));
+  }
+  void exec() override {
+    recordMax(m_record.running, m_record.maxRunning);
+    if (!m_threadSafe)
+      recordMax(m_record.serialRunning, m_record.maxSerialRunning);
+    std::this_thread::sleep_for(std::chrono::milliseconds(m_sleepMs));
+    {
+      std::lock_guard<std::mutex> lock(m_record.mutex);
+      m_record.order.push_back(m_label);
+    }
+    if (!m_threadSafe)
+      --m_record.serialRunning;
+    --m_record.running;
+    if (m_fail)
+      throw std::runtime_error("Failed on purpose");
+    Workspace_sptr input = getProperty("InputWorkspace");
+    Workspace_sptr output =
+        input ? input : boost::make_shared<WorkspaceTester>();
+    setProperty("OutputWorkspace", output);
+  }
+
+private:
+  RunRecord &m_record;
+  std::string m_label;
+  int m_sleepMs;
+  bool m_threadSafe;
+  bool m_fail;
+};
+} // namespace
+
+class DataflowExecutorTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static DataflowExecutorTest *createSuite() {
+    return new DataflowExecutorTest();
+  }
+  static void destroySuite(DataflowExecutorTest *suite) { delete suite; }
+
+  void test_independent_algorithms_run_concurrently() {
+    RunRecord record;
+    DataflowExecutor graph;
+    graph.add(makeAlgorithm(record, "a", 200));
+    graph.add(makeAlgorithm(record, "b", 200));
+    TS_ASSERT_THROWS_NOTHING(graph.execute(2));
+    TS_ASSERT_EQUALS(record.order.size(), 2);
+    TS_ASSERT_EQUALS(record.maxRunning, 2);
+  }
+
+  void test_connected_algorithms_run_in_order_and_pass_workspaces() {
+    RunRecord record;
+    DataflowExecutor graph;
+    const auto second = graph.add(makeAlgorithm(record, "second"));
+    const auto first = graph.add(makeAlgorithm(record, "first", 50));
+    graph.connect(first, "OutputWorkspace", second, "InputWorkspace");
+    TS_ASSERT_THROWS_NOTHING(graph.execute(2));
+
+    const std::vector<std::string> expected{"first", "second"};
+    TS_ASSERT_EQUALS(record.order, expected);
+    Workspace_sptr produced =
+        graph.algorithm(first)->getProperty("OutputWorkspace");
+    Workspace_sptr consumed =
+        graph.algorithm(second)->getProperty("InputWorkspace");
+    TS_ASSERT(produced);
+    TS_ASSERT_EQUALS(produced, consumed);
+  }
+
+  void test_algorithms_sharing_a_named_workspace_keep_their_order() {
+    auto &ads = AnalysisDataService::Instance();
+    ads.addOrReplace("DataflowExecutorTest_ws",
+                     boost::make_shared<WorkspaceTester>());
+    RunRecord record;
+    DataflowExecutor graph;
+    // The first overwrites the workspace the second reads
+    auto writer = makeAlgorithm(record, "writer", 50);
+    writer->setChild(false);
+    writer->setPropertyValue("OutputWorkspace", "DataflowExecutorTest_ws");
+    auto reader = makeAlgorithm(record, "reader");
+    reader->setChild(false);
+    reader->setPropertyValue("InputWorkspace", "DataflowExecutorTest_ws");
+    graph.add(writer);
+    graph.add(reader);
+    TS_ASSERT_THROWS_NOTHING(graph.execute(2));
+
+    const std::vector<std::string> expected{"writer", "reader"};
+    TS_ASSERT_EQUALS(record.order, expected);
+    ads.remove("DataflowExecutorTest_ws");
+  }
+
+  void test_algorithms_that_are_not_thread_safe_do_not_overlap() {
+    RunRecord record;
+    DataflowExecutor graph;
+    for (int i = 0; i < 4; ++i) {
+      graph.add(makeAlgorithm(record, "unsafe", 50, false));
+      graph.add(makeAlgorithm(record, "safe", 50));
+    }
+    TS_ASSERT_THROWS_NOTHING(graph.execute(4));
+    TS_ASSERT_EQUALS(record.order.size(), 8);
+    TS_ASSERT_EQUALS(record.maxSerialRunning, 1);
+  }
+
+  void test_failure_stops_dependents_and_is_rethrown() {
+    RunRecord record;
+    DataflowExecutor graph;
+    const auto failing =
+        graph.add(makeAlgorithm(record, "failing", 0, true, true));
+    const auto dependent = graph.add(makeAlgorithm(record, "dependent"));
+    graph.connect(failing, "OutputWorkspace", dependent, "InputWorkspace");
+    TS_ASSERT_THROWS(graph.execute(2), const std::runtime_error &);
+    TS_ASSERT(!graph.algorithm(dependent)->isExecuted());
+  }
+
+  void test_cycle_throws() {
+    RunRecord record;
+    DataflowExecutor graph;
+    const auto a = graph.add(makeAlgorithm(record, "a"));
+    const auto b = graph.add(makeAlgorithm(record, "b"));
+    graph.addDependency(a, b);
+    graph.addDependency(b, a);
+    TS_ASSERT_THROWS(graph.execute(), const std::runtime_error &);
+    TS_ASSERT(record.order.empty());
+  }
+
+  void test_connect_checks_property_directions() {
+    RunRecord record;
+    DataflowExecutor graph;
+    const auto a = graph.add(makeAlgorithm(record, "a"));
+    const auto b = graph.add(makeAlgorithm(record, "b"));
+    TS_ASSERT_THROWS(graph.connect(a, "InputWorkspace", b, "InputWorkspace"),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(graph.connect(a, "OutputWorkspace", b, "OutputWorkspace"),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(graph.connect(a, "OutputWorkspace", 5, "InputWorkspace"),
+                     const std::out_of_range &);
+  }
+
+  void test_critical_path_follows_the_longest_chain() {
+    RunRecord record;
+    DataflowExecutor graph;
+    const auto first = graph.add(makeAlgorithm(record, "first", 100));
+    const auto second = graph.add(makeAlgorithm(record, "second", 100));
+    graph.add(makeAlgorithm(record, "short", 10));
+    graph.connect(first, "OutputWorkspace", second, "InputWorkspace");
+    TS_ASSERT_THROWS_NOTHING(graph.execute(2));
+
+    const std::vector<DataflowExecutor::NodeId> expected{first, second};
+    TS_ASSERT_EQUALS(graph.criticalPath(), expected);
+    TS_ASSERT_LESS_THAN(0.19, graph.criticalPathDuration());
+    TS_ASSERT_DIFFERS(graph.criticalPathReport().find("DataflowTestAlgorithm"),
+                      std::string::npos);
+  }
+
+private:
+  boost::shared_ptr<Algorithm> makeAlgorithm(RunRecord &record,
+                                             const std::string &label,
+                                             int sleepMs = 0,
+                                             bool threadSafe = true,
+                                             bool fail = false) {
+    auto alg = boost::make_shared<DataflowTestAlgorithm>(record, label, sleepMs,
+                                                         threadSafe, fail);
+    alg->initialize();
+    alg->setChild(true);
+    alg->setRethrows(true);
+    return alg;
+  }
+};
+
+#endif /* MANTID_API_DATAFLOWEXECUTORTEST_H_ */
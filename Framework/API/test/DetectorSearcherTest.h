@@ -135,6 +135,30 @@ public:
     }
   }
 
+  void test_search_rectangular_in_batch() {
+    auto inst =
+        ComponentCreationHelper::createTestInstrumentRectangular2(1, 100);
+    ExperimentInfo expInfo;
+    expInfo.setInstrument(inst);
+    const auto &info = expInfo.detectorInfo();
+
+    DetectorSearcher searcher(inst, info);
+    std::vector<V3D> qs;
+    for (size_t pointNo = 0; pointNo < info.size(); ++pointNo) {
+      qs.push_back(convertDetectorPositionToQ(info.detector(pointNo)));
+    }
+    // a null vector is never found
+    qs.emplace_back(0., 0., 0.);
+
+    const auto results = searcher.findDetectorIndices(qs);
+    TS_ASSERT_EQUALS(results.size(), qs.size())
+    for (size_t pointNo = 0; pointNo < info.size(); ++pointNo) {
+      TS_ASSERT(std::get<0>(results[pointNo]))
+      TS_ASSERT_EQUALS(std::get<1>(results[pointNo]), pointNo)
+    }
+    TS_ASSERT(!std::get<0>(results.back()))
+  }
+
   V3D convertDetectorPositionToQ(const IDetector &det) {
     const auto tt1 = det.getTwoTheta(V3D(0, 0, 0), V3D(0, 0, 1)); // two theta
     const auto ph1 = det.getPhi();                                // phi
@@ -191,6 +215,35 @@ public:
     TS_ASSERT_EQUALS(hitCount, 246)
   }
 
+  void test_rectangular_in_batch() {
+    auto inst =
+        ComponentCreationHelper::createTestInstrumentRectangular2(1, 100);
+    ExperimentInfo expInfo;
+    expInfo.setInstrument(inst);
+    const auto &info = expInfo.detectorInfo();
+
+    DetectorSearcher searcher(inst, info);
+
+    // the same directions as test_rectangular
+    std::vector<V3D> qs;
+    for (int i = 0; i < 100; ++i) {
+      for (int j = 0; j < 100; ++j) {
+        for (int k = 0; k < 50; ++k) {
+          qs.emplace_back(-1 + i * 0.1, -1 + j * 0.1, 0.1 + k * 0.1);
+        }
+      }
+    }
+
+    const auto results = searcher.findDetectorIndices(qs);
+    const auto hitCount =
+        std::count_if(results.cbegin(), results.cend(),
+                      [](const DetectorSearcher::DetectorSearchResult &result) {
+                        return std::get<0>(result);
+                      });
+
+    TS_ASSERT_EQUALS(hitCount, 246)
+  }
+
   void test_cylindrical() {
     auto inst = ComponentCreationHelper::createTestInstrumentCylindrical(
         3, V3D(0, 0, -1), V3D(0, 0, 0), 1.6, 1.0);
@@ -56,6 +56,18 @@ public:
     checkDomainVector(domain);
   }
 
+  void test_Domain1D_isSorted() {
+    FunctionDomain1DView domain(data.data(), data.size());
+    TS_ASSERT(domain.isSorted());
+    std::vector<double> unsorted(data.rbegin(), data.rend());
+    FunctionDomain1DVector reversed(unsorted);
+    TS_ASSERT(!reversed.isSorted());
+    FunctionDomain1DVector copy(reversed);
+    TS_ASSERT(!copy.isSorted());
+    copy = FunctionDomain1DVector(data);
+    TS_ASSERT(copy.isSorted());
+  }
+
   void test_Domain1DSpectra() {
     FunctionDomain1DSpectrum domain(12, data);
     checkDomainVector(domain);
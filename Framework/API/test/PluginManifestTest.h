@@ -0,0 +1,174 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_API_PLUGINMANIFESTTEST_H_
+#define MANTID_API_PLUGINMANIFESTTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/AlgorithmFactory.h"
+#include "MantidAPI/PluginManifest.h"
+#include "MantidTestHelpers/ScopedFileHelper.h"
+
+#include <algorithm>
+#include <fstream>
+
+using Mantid::API::AlgorithmFactory;
+using Mantid::API::DeferredAlgorithm;
+using Mantid::API::PluginManifest;
+using ScopedFileHelper::ScopedFile;
+
+class PluginManifestTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static PluginManifestTest *createSuite() { return new PluginManifestTest(); }
+  static void destroySuite(PluginManifestTest *suite) { delete suite; }
+
+  void test_unknown_library_is_not_deferred() {
+    ScopedFile manifestFile("", "PluginManifestTest_unknown.txt");
+    ScopedFile library("not a library", "PluginManifestTest_unknown.so");
+    PluginManifest manifest(manifestFile.getFileName());
+    TS_ASSERT(!manifest.find(library.getFileName()));
+    TS_ASSERT(!manifest.deferLibrary(library.getFileName()));
+  }
+
+  void test_recorded_registrations_are_saved_and_loaded() {
+    ScopedFile manifestFile("", "PluginManifestTest_saved.txt");
+    ScopedFile library("not a library", "PluginManifestTest_saved.so");
+    {
+      PluginManifest manifest(manifestFile.getFileName());
+      manifest.record(library.getFileName(), registrations());
+      manifest.save();
+    }
+    PluginManifest manifest(manifestFile.getFileName());
+    const auto *loaded = manifest.find(library.getFileName());
+    TS_ASSERT(loaded);
+    if (!loaded)
+      return;
+    const auto expected = registrations();
+    TS_ASSERT_EQUALS(loaded->algorithms.size(), 2);
+    for (size_t i = 0; i < loaded->algorithms.size(); ++i) {
+      const auto &algorithm = loaded->algorithms[i];
+      const auto &expectedAlgorithm = expected.algorithms[i];
+      TS_ASSERT_EQUALS(algorithm.name, expectedAlgorithm.name);
+      TS_ASSERT_EQUALS(algorithm.alias, expectedAlgorithm.alias);
+      TS_ASSERT_EQUALS(algorithm.workspaceMethodName,
+                       expectedAlgorithm.workspaceMethodName);
+      TS_ASSERT_EQUALS(algorithm.workspaceMethodInputProperty,
+                       expectedAlgorithm.workspaceMethodInputProperty);
+      TS_ASSERT_EQUALS(algorithm.workspaceMethodOn,
+                       expectedAlgorithm.workspaceMethodOn);
+    }
+    TS_ASSERT_EQUALS(loaded->functions, expected.functions);
+    TS_ASSERT_EQUALS(loaded->loaders, expected.loaders);
+    TS_ASSERT_EQUALS(loaded->eager, expected.eager);
+  }
+
+  void test_deferred_library_is_opened_when_an_algorithm_is_looked_up() {
+    ScopedFile manifestFile("", "PluginManifestTest_deferred.txt");
+    ScopedFile library("not a library", "PluginManifestTest_deferred.so");
+    PluginManifest manifest(manifestFile.getFileName());
+    PluginManifest::Registrations algorithmOnly;
+    algorithmOnly.algorithms.push_back(
+        algorithm("PluginManifestTestAlgorithm"));
+    manifest.record(library.getFileName(), algorithmOnly);
+    TS_ASSERT(manifest.deferLibrary(library.getFileName()));
+    // The file is not a real library so opening it fails and the algorithm
+    // stays unregistered, but the lookup must not throw
+    TS_ASSERT_THROWS_NOTHING(
+        AlgorithmFactory::Instance().exists("PluginManifestTestAlgorithm"));
+    TS_ASSERT(
+        !AlgorithmFactory::Instance().exists("PluginManifestTestAlgorithm"));
+  }
+
+  void test_deferred_algorithms_are_listed_without_opening_the_library() {
+    ScopedFile manifestFile("", "PluginManifestTest_listed.txt");
+    ScopedFile library("not a library", "PluginManifestTest_listed.so");
+    PluginManifest manifest(manifestFile.getFileName());
+    PluginManifest::Registrations listed;
+    listed.algorithms.push_back(
+        algorithm("PluginManifestTestListed", "ListedAlias", "listed"));
+    manifest.record(library.getFileName(), listed);
+    TS_ASSERT(manifest.deferLibrary(library.getFileName()));
+
+    auto &factory = AlgorithmFactory::Instance();
+    const auto keys = factory.getKeys(true, false);
+    TS_ASSERT(std::none_of(keys.cbegin(), keys.cend(),
+                           [&factory](const std::string &key) {
+                             return factory.decodeName(key).first ==
+                                    "PluginManifestTestListed";
+                           }));
+    const auto deferred = factory.getDeferredAlgorithms();
+    const auto found =
+        std::find_if(deferred.cbegin(), deferred.cend(),
+                     [](const DeferredAlgorithm &algorithm) {
+                       return algorithm.name == "PluginManifestTestListed";
+                     });
+    TS_ASSERT(found != deferred.cend());
+    if (found == deferred.cend())
+      return;
+    TS_ASSERT_EQUALS(found->alias, "ListedAlias");
+    TS_ASSERT_EQUALS(found->workspaceMethodName, "listed");
+    TS_ASSERT_EQUALS(found->workspaceMethodInputProperty, "InputWorkspace");
+    const std::vector<std::string> types{"MatrixWorkspace", "IMDWorkspace"};
+    TS_ASSERT_EQUALS(found->workspaceMethodOn, types);
+  }
+
+  void test_changed_library_is_not_deferred() {
+    ScopedFile manifestFile("", "PluginManifestTest_changed.txt");
+    ScopedFile library("not a library", "PluginManifestTest_changed.so");
+    PluginManifest manifest(manifestFile.getFileName());
+    manifest.record(library.getFileName(), registrations());
+    std::ofstream(library.getFileName().c_str(), std::ios::app) << "changed";
+    TS_ASSERT(!manifest.deferLibrary(library.getFileName()));
+  }
+
+  void test_library_with_other_registrations_is_not_deferred() {
+    ScopedFile manifestFile("", "PluginManifestTest_eager.txt");
+    ScopedFile library("not a library", "PluginManifestTest_eager.so");
+    PluginManifest manifest(manifestFile.getFileName());
+    auto eager = registrations();
+    eager.eager = true;
+    manifest.record(library.getFileName(), eager);
+    TS_ASSERT(!manifest.deferLibrary(library.getFileName()));
+  }
+
+  void test_malformed_manifest_is_ignored() {
+    ScopedFile manifestFile("algorithm\tNoLibrary\n",
+                            "PluginManifestTest_malformed.txt");
+    ScopedFile library("not a library", "PluginManifestTest_malformed.so");
+    PluginManifest manifest(manifestFile.getFileName());
+    TS_ASSERT(!manifest.deferLibrary(library.getFileName()));
+  }
+
+private:
+  static DeferredAlgorithm algorithm(const std::string &name,
+                                     const std::string &alias = "",
+                                     const std::string &method = "") {
+    DeferredAlgorithm algorithm;
+    algorithm.name = name;
+    algorithm.alias = alias;
+    if (!method.empty()) {
+      algorithm.workspaceMethodName = method;
+      algorithm.workspaceMethodInputProperty = "InputWorkspace";
+      algorithm.workspaceMethodOn = {"MatrixWorkspace", "IMDWorkspace"};
+    }
+    return algorithm;
+  }
+
+  PluginManifest::Registrations registrations() const {
+    PluginManifest::Registrations registrations;
+    registrations.algorithms = {
+        algorithm("PluginManifestTestAlgorithm"),
+        algorithm("PluginManifestTestMethod", "TestAlias", "testMethod")};
+    registrations.functions = {"PluginManifestTestFunction"};
+    registrations.loaders = true;
+    return registrations;
+  }
+};
+
+#endif /* MANTID_API_PLUGINMANIFESTTEST_H_ */
@@ -9,10 +9,12 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "MantidAPI/SpectrumGeometry.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/SpectrumInfoIterator.h"
 #include "MantidBeamline/SpectrumInfo.h"
 #include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
 #include "MantidGeometry/Instrument/Detector.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidKernel/MultiThreaded.h"
@@ -24,6 +26,7 @@ using namespace Mantid;
 using namespace Mantid::Geometry;
 using namespace Mantid::API;
 using namespace Mantid::Kernel;
+using Mantid::Geometry::Conversion::tofToDSpacingFactor;
 
 namespace {
 constexpr size_t GroupOfDets2And3 = 0;
@@ -595,6 +598,109 @@ public:
     TS_ASSERT(spectrumInfo.cbegin()->isMasked() == true);
   }
 
+  void test_geometry() {
+    const auto &spectrumInfo = m_workspace.spectrumInfo();
+    const auto geometry = spectrumInfo.geometry();
+    TS_ASSERT_EQUALS(geometry->size(), 5);
+    TS_ASSERT_EQUALS(geometry->l1(), spectrumInfo.l1());
+    for (size_t i = 0; i < 5; ++i) {
+      TS_ASSERT_EQUALS(geometry->hasDetectors()[i], 1);
+      TS_ASSERT_EQUALS(geometry->isMonitor()[i] != 0,
+                       spectrumInfo.isMonitor(i));
+      TS_ASSERT_EQUALS(geometry->isMasked()[i] != 0, spectrumInfo.isMasked(i));
+      TS_ASSERT_EQUALS(geometry->l2()[i], spectrumInfo.l2(i));
+    }
+    for (size_t i = 0; i < 3; ++i) {
+      TS_ASSERT_EQUALS(geometry->twoTheta()[i], spectrumInfo.twoTheta(i));
+      TS_ASSERT_EQUALS(geometry->signedTwoTheta()[i],
+                       spectrumInfo.signedTwoTheta(i));
+      TS_ASSERT_EQUALS(geometry->phi()[i], m_workspace.getDetector(i)->getPhi());
+      TS_ASSERT_DELTA(geometry->difc()[i],
+                      1. / tofToDSpacingFactor(spectrumInfo.l1(),
+                                               spectrumInfo.l2(i),
+                                               spectrumInfo.twoTheta(i), 0.),
+                      1e-10);
+    }
+    // Monitors have no scattering angle
+    TS_ASSERT(std::isnan(geometry->twoTheta()[3]));
+    TS_ASSERT(std::isnan(geometry->difc()[4]));
+    TS_ASSERT(geometry->solidAngle().empty());
+  }
+
+  void test_grouped_geometry() {
+    const auto &spectrumInfo = m_grouped.spectrumInfo();
+    const auto geometry = spectrumInfo.geometry(true);
+    TS_ASSERT_EQUALS(geometry->l2()[GroupOfDets2And3],
+                     spectrumInfo.l2(GroupOfDets2And3));
+    TS_ASSERT_EQUALS(geometry->twoTheta()[GroupOfDets1And2],
+                     spectrumInfo.twoTheta(GroupOfDets1And2));
+    TS_ASSERT_EQUALS(geometry->isMasked()[GroupOfDets1And4], 1);
+    TS_ASSERT_EQUALS(geometry->isMonitor()[GroupOfDets4And5], 1);
+    const auto &componentInfo = m_grouped.componentInfo();
+    const auto samplePosition = spectrumInfo.samplePosition();
+    double solidAngle(0.);
+    for (const auto &index : spectrumInfo.spectrumDefinition(GroupOfDets2And3))
+      solidAngle += componentInfo.solidAngle(index.first, samplePosition);
+    TS_ASSERT_DELTA(geometry->solidAngle()[GroupOfDets2And3], solidAngle,
+                    1e-12);
+  }
+
+  void test_geometry_is_recomputed_after_changes() {
+    auto ws = makeDefaultWorkspace();
+    auto &spectrumInfo = ws.mutableSpectrumInfo();
+    const auto before = spectrumInfo.geometry();
+    TS_ASSERT_EQUALS(spectrumInfo.geometry(), before);
+
+    spectrumInfo.setMasked(1, true);
+    const auto masked = spectrumInfo.geometry();
+    TS_ASSERT_DIFFERS(masked, before);
+    TS_ASSERT_EQUALS(masked->isMasked()[1], 1);
+    // The earlier geometry is unchanged
+    TS_ASSERT_EQUALS(before->isMasked()[1], 0);
+
+    const auto detIndex = spectrumInfo.spectrumDefinition(1)[0].first;
+    ws.mutableDetectorInfo().setPosition(detIndex, V3D(0.0, 0.0, 10.0));
+    TS_ASSERT_EQUALS(spectrumInfo.geometry()->l2()[1], spectrumInfo.l2(1));
+    TS_ASSERT_DIFFERS(spectrumInfo.geometry()->l2()[1], masked->l2()[1]);
+
+    ws.getSpectrum(1).setDetectorIDs({2, 3});
+    TS_ASSERT_EQUALS(ws.spectrumInfo().geometry()->l2()[1],
+                     ws.spectrumInfo().l2(1));
+  }
+
+  void test_geometry_sees_changes_through_references_held_before() {
+    auto ws = makeDefaultWorkspace();
+    auto &detectorInfo = ws.mutableDetectorInfo();
+    auto &componentInfo = ws.mutableComponentInfo();
+    const auto &spectrumInfo = ws.spectrumInfo();
+    const auto before = spectrumInfo.geometry();
+    const auto detIndex = spectrumInfo.spectrumDefinition(1)[0].first;
+
+    detectorInfo.setMasked(detIndex, true);
+    const auto masked = spectrumInfo.geometry();
+    TS_ASSERT_DIFFERS(masked, before);
+    TS_ASSERT_EQUALS(masked->isMasked()[1], 1);
+
+    componentInfo.setPosition(detIndex, V3D(0.0, 0.0, 10.0));
+    const auto moved = spectrumInfo.geometry();
+    TS_ASSERT_DIFFERS(moved, masked);
+    TS_ASSERT_EQUALS(moved->l2(1), spectrumInfo.l2(1));
+    TS_ASSERT_DIFFERS(moved->l2(1), masked->l2(1));
+  }
+
+  void test_geometry_rethrows_what_SpectrumInfo_throws() {
+    const auto &spectrumInfo = m_workspace.spectrumInfo();
+    const auto geometry = spectrumInfo.geometry();
+    TS_ASSERT_EQUALS(geometry->l2(3), spectrumInfo.l2(3));
+    TS_ASSERT_EQUALS(geometry->twoTheta(0), spectrumInfo.twoTheta(0));
+    TS_ASSERT_EQUALS(geometry->signedTwoTheta(2),
+                     spectrumInfo.signedTwoTheta(2));
+    // Monitors
+    TS_ASSERT_THROWS(geometry->twoTheta(3), std::logic_error);
+    TS_ASSERT_THROWS(geometry->signedTwoTheta(4), std::logic_error);
+    TS_ASSERT_THROWS(geometry->twoTheta(5), std::out_of_range);
+  }
+
 private:
   WorkspaceTester m_workspace;
   WorkspaceTester m_workspaceNoInstrument;
@@ -136,6 +136,29 @@ public:
     TS_ASSERT_THROWS(emptyHistory.lastAlgorithm(), std::out_of_range);
     TS_ASSERT_THROWS(emptyHistory.getAlgorithm(1), std::out_of_range);
   }
+
+  void test_Histories_Share_Their_List_Until_One_Is_Changed() {
+    WorkspaceHistory original;
+    original.addHistory(boost::make_shared<AlgorithmHistory>(
+        "FirstAlgorithm", 1, "207ca8f8-fee0-49ce-86c8-7842a7313c2e"));
+
+    WorkspaceHistory copy(original);
+    WorkspaceHistory output;
+    output.addHistory(original);
+    TS_ASSERT_EQUALS(&copy.getAlgorithmHistories(),
+                     &original.getAlgorithmHistories());
+    TS_ASSERT_EQUALS(&output.getAlgorithmHistories(),
+                     &original.getAlgorithmHistories());
+
+    output.addHistory(boost::make_shared<AlgorithmHistory>(
+        "SecondAlgorithm", 1, "a1e2d4c0-3f2b-4d6e-9c8a-1b2c3d4e5f60",
+        Mantid::Types::Core::DateAndTime::getCurrentTime(), -1.0, 1));
+    TS_ASSERT_EQUALS(output.size(), 2);
+    TS_ASSERT_EQUALS(original.size(), 1);
+    TS_ASSERT_EQUALS(copy.size(), 1);
+    TS_ASSERT_EQUALS(output.getAlgorithmHistory(0),
+                     original.getAlgorithmHistory(0));
+  }
 };
 
 class WorkspaceHistoryTestPerformance : public CxxTest::TestSuite {
@@ -0,0 +1,220 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_API_WORKSPACEMEMORYLEDGERTEST_H_
+#define MANTID_API_WORKSPACEMEMORYLEDGERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/WorkspaceMemoryLedger.h"
+
+#include <boost/make_shared.hpp>
+
+using Mantid::API::Workspace;
+using Mantid::API::WorkspaceMemoryLedger;
+
+namespace {
+/// Reports a settable set of memory blocks
+class BlockWorkspace : public Workspace {
+public:
+  BlockWorkspace(std::vector<MemoryBlock> blocks)
+      : Workspace(), m_blocks(std::move(blocks)) {}
+  void setBlocks(std::vector<MemoryBlock> blocks) {
+    m_blocks = std::move(blocks);
+  }
+  const std::string id() const override { return "BlockWorkspace"; }
+  const std::string toString() const override { return ""; }
+  size_t getMemorySize() const override { return 0; }
+  void getMemoryBlocks(std::vector<MemoryBlock> &blocks) const override {
+    blocks.insert(blocks.end(), m_blocks.begin(), m_blocks.end());
+  }
+
+private:
+  BlockWorkspace *doClone() const override {
+    throw std::runtime_error("Cloning of BlockWorkspace is not implemented.");
+  }
+  BlockWorkspace *doCloneEmpty() const override {
+    throw std::runtime_error("Cloning of BlockWorkspace is not implemented.");
+  }
+  std::vector<MemoryBlock> m_blocks;
+};
+
+boost::shared_ptr<BlockWorkspace>
+makeWorkspace(std::vector<Workspace::MemoryBlock> blocks) {
+  return boost::make_shared<BlockWorkspace>(std::move(blocks));
+}
+} // namespace
+
+class WorkspaceMemoryLedgerTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static WorkspaceMemoryLedgerTest *createSuite() {
+    return new WorkspaceMemoryLedgerTest();
+  }
+  static void destroySuite(WorkspaceMemoryLedgerTest *suite) { delete suite; }
+
+  void test_record_sums_blocks() {
+    WorkspaceMemoryLedger ledger;
+    auto ws = makeWorkspace({{m_storage[0], 100}, {m_storage[1], 20}});
+    ledger.record("ws", ws);
+    TS_ASSERT_EQUALS(ledger.memoryOf("ws"), 120);
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 120);
+  }
+
+  void test_block_repeated_within_a_workspace_is_counted_once() {
+    WorkspaceMemoryLedger ledger;
+    auto ws = makeWorkspace(
+        {{m_storage[0], 100}, {m_storage[1], 20}, {m_storage[0], 100}});
+    ledger.record("ws", ws);
+    TS_ASSERT_EQUALS(ledger.memoryOf("ws"), 120);
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 120);
+  }
+
+  void test_block_shared_between_workspaces_is_counted_once_in_total() {
+    WorkspaceMemoryLedger ledger;
+    auto ws1 = makeWorkspace({{m_storage[0], 100}, {m_storage[1], 20}});
+    auto ws2 = makeWorkspace({{m_storage[0], 100}, {m_storage[2], 30}});
+    ledger.record("ws1", ws1);
+    ledger.record("ws2", ws2);
+    TS_ASSERT_EQUALS(ledger.memoryOf("ws1"), 120);
+    TS_ASSERT_EQUALS(ledger.memoryOf("ws2"), 130);
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 150);
+
+    ledger.remove("ws1");
+    TS_ASSERT_EQUALS(ledger.memoryOf("ws1"), 0);
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 130);
+    ledger.remove("ws2");
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 0);
+  }
+
+  void test_record_replaces_previous_entry() {
+    WorkspaceMemoryLedger ledger;
+    ledger.record("ws", makeWorkspace({{m_storage[0], 100}}));
+    ledger.record("ws", makeWorkspace({{m_storage[1], 10}}));
+    TS_ASSERT_EQUALS(ledger.memoryOf("ws"), 10);
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 10);
+  }
+
+  void test_names_are_case_insensitive() {
+    WorkspaceMemoryLedger ledger;
+    ledger.record("Ws", makeWorkspace({{m_storage[0], 100}}));
+    TS_ASSERT_EQUALS(ledger.memoryOf("wS"), 100);
+  }
+
+  void test_rename_moves_entry_and_discards_target() {
+    WorkspaceMemoryLedger ledger;
+    ledger.record("a", makeWorkspace({{m_storage[0], 100}}));
+    ledger.record("b", makeWorkspace({{m_storage[1], 10}}));
+    ledger.rename("a", "b");
+    TS_ASSERT_EQUALS(ledger.memoryOf("a"), 0);
+    TS_ASSERT_EQUALS(ledger.memoryOf("b"), 100);
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 100);
+  }
+
+  void test_leastRecentlyUsed_orders_by_access() {
+    WorkspaceMemoryLedger ledger;
+    ledger.record("a", makeWorkspace({{m_storage[0], 1}}));
+    ledger.record("b", makeWorkspace({{m_storage[1], 1}}));
+    ledger.record("c", makeWorkspace({{m_storage[2], 1}}));
+    ledger.touch("a");
+    const std::vector<std::string> expected{"b", "c", "a"};
+    TS_ASSERT_EQUALS(ledger.leastRecentlyUsed(), expected);
+  }
+
+  void test_spilled_entries_hold_no_memory_and_are_not_candidates() {
+    WorkspaceMemoryLedger ledger;
+    ledger.record("a", makeWorkspace({{m_storage[0], 100}}));
+    ledger.record("b", makeWorkspace({{m_storage[1], 10}}));
+    ledger.markSpilled("a", "a.nxs");
+    TS_ASSERT(ledger.isSpilled("a"));
+    TS_ASSERT(!ledger.isSpilled("b"));
+    TS_ASSERT_EQUALS(ledger.spillFile("a"), "a.nxs");
+    TS_ASSERT_EQUALS(ledger.memoryOf("a"), 0);
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 10);
+    TS_ASSERT_EQUALS(ledger.leastRecentlyUsed(),
+                     std::vector<std::string>(1, "b"));
+
+    // Recording the reloaded workspace brings it back into memory
+    ledger.record("a", makeWorkspace({{m_storage[2], 50}}));
+    TS_ASSERT(!ledger.isSpilled("a"));
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 60);
+  }
+
+  void test_unspillable_entries_are_not_candidates_until_recorded_again() {
+    WorkspaceMemoryLedger ledger;
+    ledger.record("a", makeWorkspace({{m_storage[0], 100}}));
+    ledger.record("b", makeWorkspace({{m_storage[1], 10}}));
+    ledger.markUnspillable("a");
+    TS_ASSERT(ledger.isUnspillable("a"));
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 110);
+    TS_ASSERT_EQUALS(ledger.leastRecentlyUsed(),
+                     std::vector<std::string>(1, "b"));
+
+    ledger.record("a", makeWorkspace({{m_storage[0], 100}}));
+    TS_ASSERT(!ledger.isUnspillable("a"));
+    const std::vector<std::string> expected{"b", "a"};
+    TS_ASSERT_EQUALS(ledger.leastRecentlyUsed(), expected);
+  }
+
+  void test_released_block_is_not_mistaken_for_a_new_one() {
+    WorkspaceMemoryLedger ledger;
+    auto owner = boost::make_shared<char>();
+    ledger.record("a", makeWorkspace({{owner, 100}}));
+    owner.reset();
+    // The new block may well be allocated at the same address
+    owner = boost::make_shared<char>();
+    ledger.record("b", makeWorkspace({{owner, 20}}));
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 120);
+  }
+
+  void test_own_memory_is_attributed_to_the_workspace() {
+    WorkspaceMemoryLedger ledger;
+    auto ws1 = makeWorkspace({{{}, 100}});
+    auto ws2 = makeWorkspace({{{}, 10}});
+    ledger.record("a", ws1);
+    ledger.record("b", ws2);
+    ledger.record("c", ws1);
+    TS_ASSERT_EQUALS(ledger.memoryOf("c"), 100);
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 110);
+  }
+
+  void test_update_refreshes_blocks_but_not_the_usage_order() {
+    WorkspaceMemoryLedger ledger;
+    auto ws = makeWorkspace({{m_storage[0], 100}});
+    ledger.record("a", ws);
+    ledger.record("b", makeWorkspace({{m_storage[1], 10}}));
+    ws->setBlocks({{m_storage[0], 150}, {m_storage[2], 30}});
+    ledger.update("a", ws);
+    TS_ASSERT_EQUALS(ledger.memoryOf("a"), 180);
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 190);
+    const std::vector<std::string> expected{"a", "b"};
+    TS_ASSERT_EQUALS(ledger.leastRecentlyUsed(), expected);
+
+    ledger.markSpilled("a", "a.nxs");
+    ledger.update("a", ws);
+    TS_ASSERT(ledger.isSpilled("a"));
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 10);
+    ledger.update("unknown", ws);
+    TS_ASSERT_EQUALS(ledger.memoryOf("unknown"), 0);
+  }
+
+  void test_clear() {
+    WorkspaceMemoryLedger ledger;
+    ledger.record("a", makeWorkspace({{m_storage[0], 100}}));
+    ledger.clear();
+    TS_ASSERT_EQUALS(ledger.totalMemory(), 0);
+    TS_ASSERT(ledger.leastRecentlyUsed().empty());
+  }
+
+private:
+  /// Owners of the fake blocks
+  std::vector<boost::shared_ptr<char>> m_storage{
+      boost::make_shared<char>(), boost::make_shared<char>(),
+      boost::make_shared<char>()};
+};
+
+#endif /* MANTID_API_WORKSPACEMEMORYLEDGERTEST_H_ */
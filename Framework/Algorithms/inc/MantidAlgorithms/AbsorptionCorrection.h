@@ -78,6 +78,8 @@ public:
            "and single scattering in a generic sample shape. The sample shape "
            "can be defined by the CreateSampleShape algorithm.";
   }
+  /// The outputs depend only on the inputs so may be taken from the cache
+  bool cacheable() const override { return true; }
 
 protected:
   /** A virtual function in which additional properties of an algorithm should
@@ -44,6 +44,8 @@ class DLLExport BinaryOperation : public API::Algorithm {
 public:
   /// Algorithm's category for identification overriding a virtual method
   const std::string category() const override { return "Arithmetic"; }
+  std::pair<std::string, std::string>
+  inPlaceWorkspaceProperties() const override;
 
   /** BinaryOperationTable: a list of ints.
    * Index into vector: workspace index in the lhs;
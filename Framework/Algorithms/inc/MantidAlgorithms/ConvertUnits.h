@@ -12,6 +12,9 @@
 #include "MantidKernel/Unit.h"
 
 namespace Mantid {
+namespace API {
+class SpectrumGeometry;
+}
 namespace Algorithms {
 /** Converts the units in which a workspace is represented.
     Only implemented for histogram data, so far.
@@ -66,6 +69,12 @@ public:
   }
   /// Algorithm's category for identification overriding a virtual method
   const std::string category() const override { return "Transforms\\Units"; }
+  /// Members of a group can be processed concurrently
+  bool canProcessGroupsConcurrently() const override { return true; }
+  std::pair<std::string, std::string>
+  inPlaceWorkspaceProperties() const override {
+    return {"InputWorkspace", "OutputWorkspace"};
+  }
 
 protected:
   /// Reverses the workspace if X values are in descending order
@@ -105,6 +114,7 @@ protected:
 
   /// Internal function to gather detector specific L2, theta and efixed values
   bool getDetectorValues(const API::SpectrumInfo &spectrumInfo,
+                         const API::SpectrumGeometry &geometry,
                          const Kernel::Unit &outputUnit, int emode,
                          const API::MatrixWorkspace &ws, const bool signedTheta,
                          int64_t wsIndex, double &efixed, double &l2,
@@ -34,6 +34,14 @@ struct FitFunction {
   API::IBackgroundFunction_sptr bkgdfunction;
 };
 
+/// The Fit algorithm and functions that one thread reuses for all the spectra
+/// it fits
+struct PeakFitter {
+  API::IAlgorithm_sptr fit;
+  API::IPeakFunction_sptr peakfunction;
+  API::IBackgroundFunction_sptr bkgdfunction;
+};
+
 class PeakFitResult {
 public:
   PeakFitResult(size_t num_peaks, size_t num_params);
@@ -120,6 +128,9 @@ private:
   /// suites of method to fit peaks
   std::vector<boost::shared_ptr<FitPeaksAlgorithm::PeakFitResult>> fitPeaks();
 
+  /// get the fitter of the calling thread
+  FitPeaksAlgorithm::PeakFitter &getPeakFitter();
+
   /// fit peaks in a same spectrum
   void fitSpectrumPeaks(
       size_t wi, const std::vector<double> &expected_peak_centers,
@@ -271,6 +282,8 @@ private:
   API::IBackgroundFunction_sptr m_bkgdFunction;
   /// Linear background function for high background fitting
   API::IBackgroundFunction_sptr m_linearBackgroundFunction;
+  /// Fit algorithm and function instances of each thread
+  std::vector<FitPeaksAlgorithm::PeakFitter> m_peakFitters;
 
   /// Minimzer
   std::string m_minimizer;
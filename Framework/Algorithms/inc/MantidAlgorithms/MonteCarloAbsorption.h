@@ -47,6 +47,8 @@ public:
     return "Calculates attenuation due to absorption and scattering in a "
            "sample & its environment using a Monte Carlo.";
   }
+  /// The outputs depend only on the inputs so may be taken from the cache
+  bool cacheable() const override { return true; }
 
 private:
   void init() override;
@@ -56,7 +58,9 @@ private:
   API::MatrixWorkspace_uptr doSimulation(
       const API::MatrixWorkspace &inputWS, const size_t nevents, int nlambda,
       const int seed, const InterpolationOption &interpolateOpt,
-      const bool useSparseInstrument, const size_t maxScatterPtAttempts);
+      const bool useSparseInstrument, const size_t maxScatterPtAttempts,
+      const bool resimulateTracks, const double relativeErrorTolerance,
+      const bool useSobolSequence);
   API::MatrixWorkspace_uptr
   createOutputWorkspace(const API::MatrixWorkspace &inputWS) const;
   std::unique_ptr<IBeamProfile>
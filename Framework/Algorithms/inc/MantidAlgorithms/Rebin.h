@@ -57,6 +57,8 @@ public:
     return {"RebinToWorkspace", "Rebin2D",           "Rebunch",
             "Regroup",          "RebinByPulseTimes", "RebinByTimeAtSample"};
   }
+  /// Members of a group can be processed concurrently
+  bool canProcessGroupsConcurrently() const override { return true; }
 
   static std::vector<double>
   rebinParamsFromInput(const std::vector<double> &inParams,
@@ -10,6 +10,7 @@
 #include "MantidAlgorithms/DllConfig.h"
 #include "MantidAlgorithms/SampleCorrections/MCInteractionVolume.h"
 #include <tuple>
+#include <vector>
 
 namespace Mantid {
 namespace API {
@@ -30,16 +31,29 @@ class IBeamProfile;
 
   The error on all points is defined to be \f$\frac{1}{\sqrt{N}}\f$, where N is
   the number of events generated.
+
+  Alternatively the correction can be calculated for many wavelengths at once.
+  Each event then traces its tracks only once and attenuates them at every
+  wavelength. The error of each wavelength is the standard error of the mean
+  of its events and, given a relative error tolerance, the simulation stops
+  before all the events are generated once every error is within it.
 */
 class MANTID_ALGORITHMS_DLL MCAbsorptionStrategy {
 public:
   MCAbsorptionStrategy(const IBeamProfile &beamProfile,
                        const API::Sample &sample, size_t nevents,
-                       size_t maxScatterPtAttempts);
+                       size_t maxScatterPtAttempts,
+                       double relativeErrorTolerance = 0.0);
   std::tuple<double, double> calculate(Kernel::PseudoRandomNumberGenerator &rng,
                                        const Kernel::V3D &finalPos,
                                        double lambdaBefore,
                                        double lambdaAfter) const;
+  size_t calculate(Kernel::PseudoRandomNumberGenerator &rng,
+                   const Kernel::V3D &finalPos,
+                   const std::vector<double> &lambdasBefore,
+                   const std::vector<double> &lambdasAfter,
+                   std::vector<double> &attenuationFactors,
+                   std::vector<double> &attFactorErrors) const;
 
 private:
   const IBeamProfile &m_beamProfile;
@@ -47,6 +61,7 @@ private:
   const size_t m_nevents;
   const size_t m_maxScatterAttempts;
   const double m_error;
+  const double m_relativeErrorTolerance;
 };
 
 } // namespace Algorithms
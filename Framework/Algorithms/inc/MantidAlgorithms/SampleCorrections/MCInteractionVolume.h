@@ -10,6 +10,8 @@
 #include "MantidAlgorithms/DllConfig.h"
 #include "MantidGeometry/Objects/BoundingBox.h"
 
+#include <vector>
+
 namespace Mantid {
 namespace API {
 class Sample;
@@ -17,6 +19,7 @@ class Sample;
 namespace Geometry {
 class IObject;
 class SampleEnvironment;
+class Track;
 } // namespace Geometry
 
 namespace Kernel {
@@ -46,6 +49,17 @@ public:
                              const Kernel::V3D &startPos,
                              const Kernel::V3D &endPos, double lambdaBefore,
                              double lambdaAfter) const;
+  bool calculateBeforeAfterTrack(Kernel::PseudoRandomNumberGenerator &rng,
+                                 const Kernel::V3D &startPos,
+                                 const Kernel::V3D &endPos,
+                                 Geometry::Track &beforeScatter,
+                                 Geometry::Track &afterScatter) const;
+  void generateBeforeAfterTrack(Kernel::PseudoRandomNumberGenerator &rng,
+                                const Kernel::V3D &startPos,
+                                const Kernel::V3D &endPos,
+                                Geometry::Track &beforeScatter,
+                                Geometry::Track &afterScatter) const;
+  void interceptSurfaces(std::vector<Geometry::Track> &tracks) const;
 
 private:
   const boost::shared_ptr<Geometry::IObject> m_sample;
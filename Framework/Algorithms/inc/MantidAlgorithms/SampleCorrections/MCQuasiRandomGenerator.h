@@ -0,0 +1,80 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_ALGORITHMS_MCQUASIRANDOMGENERATOR_H_
+#define MANTID_ALGORITHMS_MCQUASIRANDOMGENERATOR_H_
+
+#include "MantidAlgorithms/DllConfig.h"
+#include "MantidKernel/MersenneTwister.h"
+#include "MantidKernel/SobolSequence.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace Algorithms {
+
+/**
+  Supplies the random numbers of Monte Carlo events from a Sobol sequence.
+  Each event takes the next point of the sequence and its coordinates are
+  returned in turn, so the n-th number drawn by every event comes from the
+  same dimension of the sequence. Numbers drawn beyond the dimensions of the
+  sequence, e.g. while a scatter point is rejected and retried, are taken
+  from a Mersenne Twister.
+*/
+class MANTID_ALGORITHMS_DLL MCQuasiRandomGenerator final
+    : public Kernel::PseudoRandomNumberGenerator {
+public:
+  MCQuasiRandomGenerator(const unsigned int ndims, const size_t seedValue);
+
+  /// Start a new event at the next point of the sequence
+  void nextEvent();
+
+  /// Set the seed of the numbers drawn beyond the sequence
+  void setSeed(const size_t seedValue) override;
+  /// Sets the range of the subsequent calls to nextValue()
+  void setRange(const double start, const double end) override;
+  /// Return the next number of the event in the default range
+  inline double nextValue() override { return nextValue(m_start, m_end); }
+  /// Return the next number of the event in the given range
+  double nextValue(double start, double end) override;
+  /// Return the next integer of the event in the given range
+  int nextInt(int start, int end) override;
+  /// Restarts the sequence from its first point
+  void restart() override;
+  /// Saves the current state of the generator
+  void save() override;
+  /// Restores the generator to the last saved point, or the beginning if
+  /// nothing has been saved
+  void restore() override;
+  /// Return the minimum value of the range
+  double min() const override { return m_start; }
+  /// Return the maximum value of the range
+  double max() const override { return m_end; }
+
+private:
+  double nextUnitValue();
+
+  /// The sequence giving the first numbers of each event
+  Kernel::SobolSequence m_sequence;
+  /// The generator of the numbers drawn beyond the sequence
+  Kernel::MersenneTwister m_padding;
+  /// The point of the current event
+  std::vector<double> m_point;
+  /// The index of the next coordinate of the point to return
+  size_t m_nextDimension;
+  /// The point and index at the last save
+  std::vector<double> m_savedPoint;
+  size_t m_savedDimension;
+  /// Minimum in range
+  double m_start;
+  /// Maximum in range
+  double m_end;
+};
+
+} // namespace Algorithms
+} // namespace Mantid
+
+#endif /* MANTID_ALGORITHMS_MCQUASIRANDOMGENERATOR_H_ */
@@ -45,6 +45,10 @@ public:
   const std::string category() const override {
     return "Arithmetic;CorrectionFunctions";
   }
+  std::pair<std::string, std::string>
+  inPlaceWorkspaceProperties() const override {
+    return {"InputWorkspace", "OutputWorkspace"};
+  }
 
 private:
   /// Initialisation code
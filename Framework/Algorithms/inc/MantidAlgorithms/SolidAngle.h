@@ -47,6 +47,8 @@ public:
   const std::string category() const override {
     return "CorrectionFunctions\\InstrumentCorrections";
   }
+  /// The outputs depend only on the inputs so may be taken from the cache
+  bool cacheable() const override { return true; }
 
 private:
   // Overridden Algorithm methods
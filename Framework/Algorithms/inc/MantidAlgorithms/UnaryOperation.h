@@ -39,6 +39,8 @@ public:
     return "Supports the implementation of a Unary operation on an input "
            "workspace.";
   }
+  std::pair<std::string, std::string>
+  inPlaceWorkspaceProperties() const override;
 
 protected:
   // Overridden Algorithm methods
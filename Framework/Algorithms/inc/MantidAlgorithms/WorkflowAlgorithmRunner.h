@@ -11,6 +11,8 @@
 #include "MantidAPI/ITableWorkspace_fwd.h"
 #include "MantidAlgorithms/DllConfig.h"
 
+#include <unordered_set>
+
 namespace Mantid {
 namespace Algorithms {
 
@@ -37,6 +39,12 @@ private:
   /// Execution code
   void exec() override;
 
+  /// Creates and configures the managed algorithm for a row.
+  API::Algorithm_sptr
+  createAlgorithm(API::ITableWorkspace_sptr propertyTable, const size_t row,
+                  const std::unordered_set<std::string> &skippedProperties =
+                      std::unordered_set<std::string>()) const;
+
   /// Configures a row in `setupTable`.
   template <typename QUEUE, typename MAP>
   void
@@ -141,6 +141,21 @@ bool BinaryOperation::handleSpecialDivideMinus() {
   return false;
 }
 
+/** The lhs may be modified in place when it is a histogram workspace at least
+ * as large as the rhs. An output that keeps events or is larger than the lhs
+ * needs a new workspace.
+ * @return The names of the lhs and output properties, or empty names
+ */
+std::pair<std::string, std::string>
+BinaryOperation::inPlaceWorkspaceProperties() const {
+  MatrixWorkspace_const_sptr lhs = getProperty(inputPropName1());
+  MatrixWorkspace_const_sptr rhs = getProperty(inputPropName2());
+  if (!lhs || !rhs || boost::dynamic_pointer_cast<const EventWorkspace>(lhs) ||
+      lhs->size() < rhs->size())
+    return {};
+  return {inputPropName1(), outputPropName()};
+}
+
 /** Executes the algorithm. Will call execEvent() if appropriate.
  *
  *  @throw runtime_error Thrown if algorithm cannot execute
@@ -691,7 +706,7 @@ void BinaryOperation::do2D(bool mismatchedSpectra) {
 
         // Free up memory on the RHS if that is possible
         if (m_ClearRHSWorkspace)
-          const_cast<EventList &>(m_erhs->getSpectrum(rhs_wi)).clear();
+          const_cast<EventWorkspace &>(*m_erhs).clearEventList(rhs_wi);
         PARALLEL_END_INTERUPT_REGION
       }
       PARALLEL_CHECK_INTERUPT_REGION
@@ -725,7 +740,7 @@ void BinaryOperation::do2D(bool mismatchedSpectra) {
 
         // Free up memory on the RHS if that is possible
         if (m_ClearRHSWorkspace)
-          const_cast<EventList &>(m_erhs->getSpectrum(rhs_wi)).clear();
+          const_cast<EventWorkspace &>(*m_erhs).clearEventList(rhs_wi);
 
         PARALLEL_END_INTERUPT_REGION
       }
@@ -768,7 +783,7 @@ void BinaryOperation::do2D(bool mismatchedSpectra) {
 
       // Free up memory on the RHS if that is possible
       if (m_ClearRHSWorkspace)
-        const_cast<EventList &>(m_erhs->getSpectrum(rhs_wi)).clear();
+        const_cast<EventWorkspace &>(*m_erhs).clearEventList(rhs_wi);
 
       PARALLEL_END_INTERUPT_REGION
     }
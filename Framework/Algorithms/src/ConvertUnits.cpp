@@ -8,6 +8,7 @@
 #include "MantidAPI/AlgorithmFactory.h"
 #include "MantidAPI/Axis.h"
 #include "MantidAPI/Run.h"
+#include "MantidAPI/SpectrumGeometry.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceUnitValidator.h"
 #include "MantidDataObjects/EventWorkspace.h"
@@ -389,6 +390,7 @@ ConvertUnits::convertQuickly(API::MatrixWorkspace_const_sptr inputWS,
 
 /** Get the L2, theta and efixed values for a workspace index
  * @param spectrumInfo :: SpectrumInfo of the workspace
+ * @param geometry :: The geometry of the spectra of the workspace
  * @param outputUnit :: The output unit
  * @param emode :: The energy mode
  * @param ws :: The workspace
@@ -400,22 +402,23 @@ ConvertUnits::convertQuickly(API::MatrixWorkspace_const_sptr inputWS,
  * @returns true if lookup successful, false on error
  */
 bool ConvertUnits::getDetectorValues(const API::SpectrumInfo &spectrumInfo,
+                                     const API::SpectrumGeometry &geometry,
                                      const Kernel::Unit &outputUnit, int emode,
                                      const MatrixWorkspace &ws,
                                      const bool signedTheta, int64_t wsIndex,
                                      double &efixed, double &l2,
                                      double &twoTheta) {
-  if (!spectrumInfo.hasDetectors(wsIndex))
+  if (!geometry.hasDetectors()[wsIndex])
     return false;
 
-  l2 = spectrumInfo.l2(wsIndex);
+  l2 = geometry.l2(wsIndex);
 
-  if (!spectrumInfo.isMonitor(wsIndex)) {
+  if (!geometry.isMonitor()[wsIndex]) {
     // The scattering angle for this detector (in radians).
     if (signedTheta)
-      twoTheta = spectrumInfo.signedTwoTheta(wsIndex);
+      twoTheta = geometry.signedTwoTheta(wsIndex);
     else
-      twoTheta = spectrumInfo.twoTheta(wsIndex);
+      twoTheta = geometry.twoTheta(wsIndex);
     // If an indirect instrument, try getting Efixed from the geometry
     if (emode == 2 && efixed == EMPTY_DBL()) // indirect
     {
@@ -518,8 +521,12 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
   double checkl2;
   double checktwoTheta;
   size_t checkIndex = 0;
-  if (getDetectorValues(spectrumInfo, *outputUnit, emode, *inputWS, signedTheta,
-                        checkIndex, checkefixed, checkl2, checktwoTheta)) {
+  // The geometry of all spectra, computed once rather than per spectrum. The
+  // output workspace has the same geometry.
+  const auto geometry = spectrumInfo.geometry();
+  if (getDetectorValues(spectrumInfo, *geometry, *outputUnit, emode, *inputWS,
+                        signedTheta, checkIndex, checkefixed, checkl2,
+                        checktwoTheta)) {
     const double checkdelta = 0.0;
     // copy the X values for the check
     auto checkXValues = inputWS->readX(checkIndex);
@@ -545,8 +552,8 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
     // Now get the detector object for this histogram
     double l2;
     double twoTheta;
-    if (getDetectorValues(outSpectrumInfo, *outputUnit, emode, *outputWS,
-                          signedTheta, i, efixed, l2, twoTheta)) {
+    if (getDetectorValues(outSpectrumInfo, *geometry, *outputUnit, emode,
+                          *outputWS, signedTheta, i, efixed, l2, twoTheta)) {
 
       /// @todo Don't yet consider hold-off (delta)
       const double delta = 0.0;
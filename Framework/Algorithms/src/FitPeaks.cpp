@@ -911,6 +911,10 @@ FitPeaks::fitPeaks() {
   std::vector<boost::shared_ptr<FitPeaksAlgorithm::PeakFitResult>>
       fit_result_vector(num_fit_result);
 
+  // one fitter per thread, created when the thread fits its first spectrum
+  m_peakFitters.clear();
+  m_peakFitters.resize(static_cast<size_t>(PARALLEL_GET_MAX_THREADS));
+
   // cppcheck-suppress syntaxError
   PRAGMA_OMP(parallel for schedule(dynamic, 1) )
   for (int wi = static_cast<int>(m_startWorkspaceIndex);
@@ -932,11 +936,10 @@ FitPeaks::fitPeaks() {
     fitSpectrumPeaks(static_cast<size_t>(wi), expected_peak_centers,
                      fit_result);
 
-    PARALLEL_CRITICAL(FindPeaks_WriteOutput) {
-      writeFitResult(static_cast<size_t>(wi), expected_peak_centers,
-                     fit_result);
-      fit_result_vector[wi - m_startWorkspaceIndex] = fit_result;
-    }
+    // each spectrum owns its rows of the preallocated output workspaces and
+    // its element of the result vector, so no lock is needed to write them
+    writeFitResult(static_cast<size_t>(wi), expected_peak_centers, fit_result);
+    fit_result_vector[wi - m_startWorkspaceIndex] = fit_result;
     prog.report();
 
     PARALLEL_END_INTERUPT_REGION
@@ -947,6 +950,45 @@ FitPeaks::fitPeaks() {
   return fit_result_vector;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Get the Fit algorithm and the peak and background functions of the calling
+ * thread. They are created the first time the thread asks for them and are
+ * then reused for all the spectra that the thread fits.
+ * @return :: the fitter of the calling thread
+ */
+FitPeaksAlgorithm::PeakFitter &FitPeaks::getPeakFitter() {
+  const auto thread = static_cast<size_t>(PARALLEL_THREAD_NUMBER);
+  if (thread >= m_peakFitters.size())
+    throw std::runtime_error("No peak fitter is set up for thread " +
+                             std::to_string(thread));
+  FitPeaksAlgorithm::PeakFitter &fitter = m_peakFitters[thread];
+  if (fitter.fit)
+    return fitter;
+
+  // Set up sub algorithm Fit for peak and background
+  try {
+    fitter.fit = createChildAlgorithm("Fit", -1, -1, false);
+  } catch (Exception::NotFoundError &) {
+    std::stringstream errss;
+    errss << "The FitPeak algorithm requires the CurveFitting library";
+    g_log.error(errss.str());
+    throw std::runtime_error(errss.str());
+  }
+
+  // set up properties of algorithm (reference) 'Fit'
+  fitter.fit->setProperty("Minimizer", m_minimizer);
+  fitter.fit->setProperty("CostFunction", m_costFunction);
+  fitter.fit->setProperty("CalcErrors", true);
+
+  // Clone the function
+  fitter.peakfunction =
+      boost::dynamic_pointer_cast<API::IPeakFunction>(m_peakFunction->clone());
+  fitter.bkgdfunction = boost::dynamic_pointer_cast<API::IBackgroundFunction>(
+      m_bkgdFunction->clone());
+
+  return fitter;
+}
+
 namespace {
 /// Supported peak profiles for observation
 std::vector<std::string> supported_peak_profiles{"Gaussian", "Lorentzian",
@@ -991,6 +1033,15 @@ double numberCounts(const Histogram &histogram, const double xmin,
     total += std::fabs(histogram.y()[i]);
   return total;
 }
+
+/// Reset the parameter values and errors of a function to those of another
+/// function of the same type
+void copyParameters(const IFunction &source, IFunction &target) {
+  for (size_t i = 0; i < source.nParams(); ++i) {
+    target.setParameter(i, source.getParameter(i));
+    target.setError(i, source.getError(i));
+  }
+}
 } // namespace
 
 //----------------------------------------------------------------------------------------------
@@ -1005,28 +1056,14 @@ void FitPeaks::fitSpectrumPeaks(
     return; // don't do anything
   }
 
-  // Set up sub algorithm Fit for peak and background
-  IAlgorithm_sptr peak_fitter; // both peak and background (combo)
-  try {
-    peak_fitter = createChildAlgorithm("Fit", -1, -1, false);
-  } catch (Exception::NotFoundError &) {
-    std::stringstream errss;
-    errss << "The FitPeak algorithm requires the CurveFitting library";
-    g_log.error(errss.str());
-    throw std::runtime_error(errss.str());
-  }
-
-  // Clone the function
-  IPeakFunction_sptr peakfunction =
-      boost::dynamic_pointer_cast<API::IPeakFunction>(m_peakFunction->clone());
-  IBackgroundFunction_sptr bkgdfunction =
-      boost::dynamic_pointer_cast<API::IBackgroundFunction>(
-          m_bkgdFunction->clone());
-
-  // set up properties of algorithm (reference) 'Fit'
-  peak_fitter->setProperty("Minimizer", m_minimizer);
-  peak_fitter->setProperty("CostFunction", m_costFunction);
-  peak_fitter->setProperty("CalcErrors", true);
+  // Reuse the Fit and the functions of this thread, starting from the
+  // parameters of the input functions as a fresh clone would
+  FitPeaksAlgorithm::PeakFitter &fitter = getPeakFitter();
+  IAlgorithm_sptr peak_fitter = fitter.fit; // both peak and background (combo)
+  IPeakFunction_sptr peakfunction = fitter.peakfunction;
+  IBackgroundFunction_sptr bkgdfunction = fitter.bkgdfunction;
+  copyParameters(*m_peakFunction, *peakfunction);
+  copyParameters(*m_bkgdFunction, *bkgdfunction);
 
   // store the peak fit parameters once one works
   bool foundAnyPeak = false;
@@ -1261,12 +1298,10 @@ void FitPeaks::calculateFittedPeaks(
        iws <= static_cast<int64_t>(m_stopWorkspaceIndex); ++iws) {
     PARALLEL_START_INTERUPT_REGION
 
-    // get a copy of peak function and background function
-    IPeakFunction_sptr peak_function =
-        boost::dynamic_pointer_cast<IPeakFunction>(m_peakFunction->clone());
-    IBackgroundFunction_sptr bkgd_function =
-        boost::dynamic_pointer_cast<IBackgroundFunction>(
-            m_bkgdFunction->clone());
+    // all the parameters of the functions of this thread are set below
+    FitPeaksAlgorithm::PeakFitter &fitter = getPeakFitter();
+    IPeakFunction_sptr peak_function = fitter.peakfunction;
+    IBackgroundFunction_sptr bkgd_function = fitter.bkgdfunction;
     boost::shared_ptr<FitPeaksAlgorithm::PeakFitResult> fit_result_i =
         fit_results[iws - m_startWorkspaceIndex];
     // FIXME - This is a just a pure check
@@ -2309,9 +2344,9 @@ void FitPeaks::writeFitResult(
   }
 
   // go through each peak
-  // get a copy of peak function and background function
-  IPeakFunction_sptr peak_function =
-      boost::dynamic_pointer_cast<IPeakFunction>(m_peakFunction->clone());
+  // use the peak function of this thread: its parameters are reset before it
+  // fits the next spectrum
+  IPeakFunction_sptr peak_function = getPeakFitter().peakfunction;
   size_t num_peakfunc_params = peak_function->nParams();
   size_t num_bkgd_params = m_bkgdFunction->nParams();
 
@@ -14,6 +14,7 @@
 #include "MantidAlgorithms/InterpolationOption.h"
 #include "MantidAlgorithms/SampleCorrections/DetectorGridDefinition.h"
 #include "MantidAlgorithms/SampleCorrections/MCAbsorptionStrategy.h"
+#include "MantidAlgorithms/SampleCorrections/MCQuasiRandomGenerator.h"
 #include "MantidAlgorithms/SampleCorrections/RectangularBeamProfile.h"
 #include "MantidAlgorithms/SampleCorrections/SparseInstrument.h"
 #include "MantidDataObjects/Workspace2D.h"
@@ -27,6 +28,7 @@
 #include "MantidKernel/CompositeValidator.h"
 #include "MantidKernel/DeltaEMode.h"
 #include "MantidKernel/EnabledWhenProperty.h"
+#include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MersenneTwister.h"
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/VectorHelper.h"
@@ -44,6 +46,10 @@ constexpr int DEFAULT_NEVENTS = 300;
 constexpr int DEFAULT_SEED = 123456789;
 constexpr int DEFAULT_LATITUDINAL_DETS = 5;
 constexpr int DEFAULT_LONGITUDINAL_DETS = 10;
+/// The random numbers an attempt at an event can draw before any scatter
+/// point is rejected: 2 for the beam, 2 to choose the sample or environment
+/// component and 3 for the scatter point
+constexpr unsigned int QUASI_RANDOM_DIMENSIONS = 7;
 
 /// Energy (meV) to wavelength (angstroms)
 inline double toWavelength(double energy) {
@@ -149,6 +155,33 @@ void MonteCarloAbsorption::init() {
                   "If a scattering point cannot be generated by increasing "
                   "this value then there is most likely a problem with "
                   "the sample geometry.");
+
+  declareProperty("ResimulateTracksForDifferentWavelengths", true,
+                  "Generate new tracks for every simulated wavelength point. "
+                  "If false, the tracks of each event are generated once and "
+                  "attenuated at all the wavelength points of the spectrum, "
+                  "which is much faster but correlates the points.");
+  auto nonNegative = boost::make_shared<Kernel::BoundedValidator<double>>();
+  nonNegative->setLower(0.0);
+  declareProperty("RelativeErrorTolerance", 0.0, nonNegative,
+                  "Stop simulating a spectrum before EventsPerPoint events "
+                  "once the error of every point relative to its correction "
+                  "is below this. The errors are the standard errors of the "
+                  "mean of the events. Zero simulates all the events.");
+  setPropertySettings(
+      "RelativeErrorTolerance",
+      Kernel::make_unique<EnabledWhenProperty>(
+          "ResimulateTracksForDifferentWavelengths",
+          ePropertyCriterion::IS_NOT_DEFAULT));
+
+  const std::vector<std::string> sequences{"MersenneTwister", "Sobol"};
+  declareProperty("RandomNumberSequence", sequences.front(),
+                  boost::make_shared<StringListValidator>(sequences),
+                  "The sequence the random numbers of the events are drawn "
+                  "from. Sobol is a quasi-random sequence that covers the "
+                  "sample more evenly than pseudo-random numbers. SeedValue "
+                  "only seeds the numbers an event draws beyond its point of "
+                  "the Sobol sequence, e.g. to retry scatter points.");
 }
 
 /**
@@ -163,9 +196,15 @@ void MonteCarloAbsorption::exec() {
   interpolateOpt.set(getPropertyValue("Interpolation"));
   const bool useSparseInstrument = getProperty("SparseInstrument");
   const int maxScatterPtAttempts = getProperty("MaxScatterPtAttempts");
-  auto outputWS = doSimulation(*inputWS, static_cast<size_t>(nevents), nlambda,
-                               seed, interpolateOpt, useSparseInstrument,
-                               static_cast<size_t>(maxScatterPtAttempts));
+  const bool resimulateTracks =
+      getProperty("ResimulateTracksForDifferentWavelengths");
+  const double relativeErrorTolerance = getProperty("RelativeErrorTolerance");
+  const bool useSobolSequence =
+      getPropertyValue("RandomNumberSequence") == "Sobol";
+  auto outputWS = doSimulation(
+      *inputWS, static_cast<size_t>(nevents), nlambda, seed, interpolateOpt,
+      useSparseInstrument, static_cast<size_t>(maxScatterPtAttempts),
+      resimulateTracks, relativeErrorTolerance, useSobolSequence);
 
   setProperty("OutputWorkspace", std::move(outputWS));
 }
@@ -184,6 +223,14 @@ std::map<std::string, std::string> MonteCarloAbsorption::validateInputs() {
   if (!nlambdaIssue.empty()) {
     issues["NumberOfWavelengthPoints"] = nlambdaIssue;
   }
+  const bool resimulateTracks =
+      getProperty("ResimulateTracksForDifferentWavelengths");
+  const double relativeErrorTolerance = getProperty("RelativeErrorTolerance");
+  if (resimulateTracks && relativeErrorTolerance > 0.0) {
+    issues["RelativeErrorTolerance"] =
+        "A tolerance can only be given if the tracks are not resimulated for "
+        "different wavelengths.";
+  }
   return issues;
 }
 
@@ -198,12 +245,21 @@ std::map<std::string, std::string> MonteCarloAbsorption::validateInputs() {
  * @param useSparseInstrument If true, use sparse instrument in simulation
  * @param maxScatterPtAttempts The maximum number of tries to generate a
  * scatter point within the object
+ * @param resimulateTracks If false, the tracks of each event are reused for
+ * all the wavelength points of a spectrum
+ * @param relativeErrorTolerance Stop simulating a spectrum once the relative
+ * errors of its points are below this, if positive. Only used if the tracks
+ * are not resimulated.
+ * @param useSobolSequence If true, the events take their random numbers from
+ * a Sobol sequence rather than a Mersenne Twister
  * @return A new workspace containing the correction factors & errors
  */
 MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
     const MatrixWorkspace &inputWS, const size_t nevents, int nlambda,
     const int seed, const InterpolationOption &interpolateOpt,
-    const bool useSparseInstrument, const size_t maxScatterPtAttempts) {
+    const bool useSparseInstrument, const size_t maxScatterPtAttempts,
+    const bool resimulateTracks, const double relativeErrorTolerance,
+    const bool useSobolSequence) {
   auto outputWS = createOutputWorkspace(inputWS);
   const auto inputNbins = static_cast<int>(inputWS.blocksize());
   if (isEmpty(nlambda) || nlambda > inputNbins) {
@@ -243,7 +299,7 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
 
   // Configure strategy
   MCAbsorptionStrategy strategy(*beamProfile, inputWS.sample(), nevents,
-                                maxScatterPtAttempts);
+                                maxScatterPtAttempts, relativeErrorTolerance);
 
   const auto &spectrumInfo = simulationWS.spectrumInfo();
 
@@ -262,13 +318,20 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
     const auto &detPos = spectrumInfo.position(i);
     const double lambdaFixed =
         toWavelength(efixed.value(spectrumInfo.detector(i).getID()));
-    MersenneTwister rng(seed);
+    std::unique_ptr<PseudoRandomNumberGenerator> rng;
+    if (useSobolSequence) {
+      rng = make_unique<MCQuasiRandomGenerator>(QUASI_RANDOM_DIMENSIONS, seed);
+    } else {
+      rng = make_unique<MersenneTwister>(seed);
+    }
 
     auto &outY = simulationWS.mutableY(i);
     const auto lambdas = simulationWS.points(i);
-    // Simulation for each requested wavelength point
+    // The requested wavelength points
+    std::vector<int> simulatedBins;
+    std::vector<double> lambdasIn, lambdasOut;
     for (int j = 0; j < nbins; j += lambdaStepSize) {
-      prog.report(reportMsg);
+      simulatedBins.emplace_back(j);
       const double lambdaStep = lambdas[j];
       double lambdaIn(lambdaStep), lambdaOut(lambdaStep);
       if (efixed.emode() == DeltaEMode::Direct) {
@@ -278,8 +341,8 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
       } else {
         // elastic case already initialized
       }
-      std::tie(outY[j], std::ignore) =
-          strategy.calculate(rng, detPos, lambdaIn, lambdaOut);
+      lambdasIn.emplace_back(lambdaIn);
+      lambdasOut.emplace_back(lambdaOut);
 
       // Ensure we have the last point for the interpolation
       if (lambdaStepSize > 1 && j + lambdaStepSize >= nbins && j + 1 != nbins) {
@@ -287,6 +350,24 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
       }
     }
 
+    if (resimulateTracks) {
+      // Simulation for each requested wavelength point
+      for (size_t k = 0; k < simulatedBins.size(); ++k) {
+        prog.report(reportMsg);
+        std::tie(outY[simulatedBins[k]], std::ignore) =
+            strategy.calculate(*rng, detPos, lambdasIn[k], lambdasOut[k]);
+      }
+    } else {
+      // Simulation for all the requested wavelength points at once
+      std::vector<double> factors, errors;
+      strategy.calculate(*rng, detPos, lambdasIn, lambdasOut, factors, errors);
+      for (size_t k = 0; k < simulatedBins.size(); ++k) {
+        outY[simulatedBins[k]] = factors[k];
+        outE[simulatedBins[k]] = errors[k];
+      }
+      prog.reportIncrement(simulatedBins.size(), reportMsg);
+    }
+
     // Interpolate through points not simulated
     if (!useSparseInstrument && lambdaStepSize > 1) {
       auto histnew = simulationWS.histogram(i);
@@ -18,6 +18,8 @@
 #include "MantidKernel/RebinParamsValidator.h"
 #include "MantidKernel/VectorHelper.h"
 
+#include <unordered_map>
+
 namespace Mantid {
 namespace Algorithms {
 
@@ -36,6 +38,51 @@ using HistogramData::Frequencies;
 using HistogramData::FrequencyStandardDeviations;
 using HistogramData::Histogram;
 
+namespace {
+/**
+ * Compute rebin weights for the X arrays that several spectra share, so that
+ * the overlaps with the new bins are found once per distinct X.
+ * @param inputWS :: The workspace to be rebinned
+ * @param xnew :: The new bin edges
+ * @return The weights for each spectrum, or null where the spectrum's X is not
+ * shared with another or the weights cannot be used
+ */
+std::vector<std::shared_ptr<const VectorHelper::RebinWeights>>
+sharedRebinWeights(const MatrixWorkspace &inputWS, const BinEdges &xnew) {
+  const auto nHist = inputWS.getNumberHistograms();
+  std::unordered_map<const HistogramData::HistogramX *, size_t> users;
+  for (size_t i = 0; i < nHist; ++i)
+    ++users[&inputWS.x(i)];
+
+  std::unordered_map<const HistogramData::HistogramX *,
+                     std::shared_ptr<const VectorHelper::RebinWeights>>
+      weightsByX;
+  std::vector<std::shared_ptr<const VectorHelper::RebinWeights>> weights(nHist);
+  for (size_t i = 0; i < nHist; ++i) {
+    const auto x = &inputWS.x(i);
+    if (users[x] < 2)
+      continue;
+    const auto yMode = inputWS.histogram(i).yMode();
+    if (yMode == Histogram::YMode::Uninitialized)
+      continue;
+    const bool distribution = yMode == Histogram::YMode::Frequencies;
+    auto &shared = weightsByX[x];
+    if (!shared) {
+      try {
+        shared = std::make_shared<const VectorHelper::RebinWeights>(
+            x->rawData(), xnew.rawData(), distribution);
+      } catch (std::invalid_argument &) {
+        // Leave bad bin edges to be reported by HistogramData::rebin
+        users[x] = 0;
+        continue;
+      }
+    }
+    weights[i] = shared;
+  }
+  return weights;
+}
+} // namespace
+
 //---------------------------------------------------------------------------------------------
 // Public static methods
 //---------------------------------------------------------------------------------------------
@@ -249,20 +296,30 @@ void Rebin::exec() {
     if (inputWS->axes() > 1)
       outputWS->replaceAxis(1, inputWS->getAxis(1)->clone(outputWS.get()));
     bool ignoreBinErrors = getProperty("IgnoreBinErrors");
+    const auto weights = sharedRebinWeights(*inputWS, XValues_new);
 
     Progress prog(this, 0.0, 1.0, histnumber);
     PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS, *outputWS))
     for (int hist = 0; hist < histnumber; ++hist) {
       PARALLEL_START_INTERUPT_REGION
 
-      try {
-        outputWS->setHistogram(
-            hist, HistogramData::rebin(inputWS->histogram(hist), XValues_new));
-      } catch (InvalidBinEdgesError &) {
-        if (ignoreBinErrors)
-          outputWS->setBinEdges(hist, XValues_new);
-        else
-          throw;
+      if (weights[hist]) {
+        // X shared with other spectra: reuse the precomputed overlaps
+        weights[hist]->apply(inputWS->y(hist).rawData().data(),
+                             inputWS->e(hist).rawData().data(),
+                             &outputWS->mutableY(hist).front(),
+                             &outputWS->mutableE(hist).front());
+      } else {
+        try {
+          outputWS->setHistogram(
+              hist,
+              HistogramData::rebin(inputWS->histogram(hist), XValues_new));
+        } catch (InvalidBinEdgesError &) {
+          if (ignoreBinErrors)
+            outputWS->setBinEdges(hist, XValues_new);
+          else
+            throw;
+        }
       }
       prog.report(name());
       PARALLEL_END_INTERUPT_REGION
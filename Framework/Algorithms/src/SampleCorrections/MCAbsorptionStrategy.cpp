@@ -6,17 +6,101 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidAlgorithms/SampleCorrections/MCAbsorptionStrategy.h"
 #include "MantidAlgorithms/SampleCorrections/IBeamProfile.h"
+#include "MantidAlgorithms/SampleCorrections/MCQuasiRandomGenerator.h"
+#include "MantidKernel/Material.h"
 #include "MantidKernel/PseudoRandomNumberGenerator.h"
 #include "MantidKernel/V3D.h"
 
 #include "MantidAlgorithms/SampleCorrections/RectangularBeamProfile.h"
 #include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/Track.h"
+
+#include <algorithm>
 
 namespace Mantid {
+using Geometry::Track;
 using Kernel::PseudoRandomNumberGenerator;
 
 namespace Algorithms {
 
+namespace {
+/// The number of events between estimates of the errors
+const size_t CONVERGENCE_CHECK_INTERVAL = 100;
+
+/// Report that no valid track could be generated through the volume
+void throwNoValidTrack(size_t maxScatterAttempts) {
+  throw std::runtime_error("Unable to generate valid track through "
+                           "sample interaction volume after " +
+                           std::to_string(maxScatterAttempts) +
+                           " attempts. Try increasing the maximum "
+                           "threshold or if this does not help then "
+                           "please check the defined shape.");
+}
+
+/**
+ * Start an attempt at an event. A quasi-random generator moves on to the next
+ * point of its sequence, other generators need no action.
+ * @param rng The generator of the random numbers of the event
+ */
+void startEvent(PseudoRandomNumberGenerator &rng) {
+  if (auto quasiRandom = dynamic_cast<MCQuasiRandomGenerator *>(&rng)) {
+    quasiRandom->nextEvent();
+  }
+}
+
+/**
+ * The attenuation coefficients, in \f$m^{-1}\f$, of each material met by the
+ * tracks at a set of wavelengths. They are calculated the first time the
+ * material is met and reused for all later events.
+ */
+class AttenuationCoefficients {
+public:
+  explicit AttenuationCoefficients(const std::vector<double> &lambdas)
+      : m_lambdas(lambdas) {}
+
+  /// Add the exponents of the attenuation along a track at each wavelength
+  void addExponents(const Track &path, std::vector<double> &exponents) {
+    for (const auto &segment : path) {
+      const double length = segment.distInsideObject;
+      const auto &coefficients = of(segment.object->material());
+      for (size_t i = 0; i < exponents.size(); ++i)
+        exponents[i] += coefficients[i] * length;
+    }
+  }
+
+private:
+  const std::vector<double> &of(const Kernel::Material &material) {
+    for (const auto &known : m_coefficients) {
+      if (known.first == &material)
+        return known.second;
+    }
+    std::vector<double> coefficients(m_lambdas.size());
+    for (size_t i = 0; i < m_lambdas.size(); ++i) {
+      coefficients[i] = 100 * material.numberDensity() *
+                        (material.totalScatterXSection(m_lambdas[i]) +
+                         material.absorbXSection(m_lambdas[i]));
+    }
+    m_coefficients.emplace_back(&material, std::move(coefficients));
+    return m_coefficients.back().second;
+  }
+
+  const std::vector<double> &m_lambdas;
+  std::vector<std::pair<const Kernel::Material *, std::vector<double>>>
+      m_coefficients;
+};
+
+/// The standard error of the mean of n events from their sum and sum of
+/// squares
+double standardError(double sum, double sumOfSquares, size_t n) {
+  if (n < 2)
+    return 0.0;
+  const double mean = sum / static_cast<double>(n);
+  const double variance =
+      (sumOfSquares - mean * sum) / static_cast<double>(n - 1);
+  return variance > 0.0 ? std::sqrt(variance / static_cast<double>(n)) : 0.0;
+}
+} // namespace
+
 /**
  * Constructor
  * @param beamProfile A reference to the object the beam profile
@@ -24,21 +108,27 @@ namespace Algorithms {
  * @param nevents The number of Monte Carlo events used in the simulation
  * @param maxScatterPtAttempts The maximum number of tries to generate a random
  * point within the object.
+ * @param relativeErrorTolerance If positive, the simulation of many
+ * wavelengths stops once the error of every wavelength relative to its
+ * correction is below this
  */
 MCAbsorptionStrategy::MCAbsorptionStrategy(const IBeamProfile &beamProfile,
                                            const API::Sample &sample,
                                            size_t nevents,
-                                           size_t maxScatterPtAttempts)
+                                           size_t maxScatterPtAttempts,
+                                           double relativeErrorTolerance)
     : m_beamProfile(beamProfile),
       m_scatterVol(
           MCInteractionVolume(sample, beamProfile.defineActiveRegion(sample))),
       m_nevents(nevents), m_maxScatterAttempts(maxScatterPtAttempts),
-      m_error(1.0 / std::sqrt(m_nevents)) {}
+      m_error(1.0 / std::sqrt(m_nevents)),
+      m_relativeErrorTolerance(relativeErrorTolerance) {}
 
 /**
  * Compute the correction for a final position of the neutron and wavelengths
  * before and after scattering
- * @param rng A reference to a PseudoRandomNumberGenerator
+ * @param rng A reference to a PseudoRandomNumberGenerator. An
+ * MCQuasiRandomGenerator takes a new point for each attempt at an event.
  * @param finalPos Defines the final position of the neutron, assumed to be
  * where it is detected
  * @param lambdaBefore Wavelength, in \f$\\A^-1\f$, before scattering
@@ -54,6 +144,7 @@ MCAbsorptionStrategy::calculate(Kernel::PseudoRandomNumberGenerator &rng,
   for (size_t i = 0; i < m_nevents; ++i) {
     size_t attempts(0);
     do {
+      startEvent(rng);
       const auto neutron = m_beamProfile.generatePoint(rng, scatterBounds);
 
       const double wgt = m_scatterVol.calculateAbsorption(
@@ -65,12 +156,7 @@ MCAbsorptionStrategy::calculate(Kernel::PseudoRandomNumberGenerator &rng,
         break;
       }
       if (attempts == m_maxScatterAttempts) {
-        throw std::runtime_error("Unable to generate valid track through "
-                                 "sample interaction volume after " +
-                                 std::to_string(m_maxScatterAttempts) +
-                                 " attempts. Try increasing the maximum "
-                                 "threshold or if this does not help then "
-                                 "please check the defined shape.");
+        throwNoValidTrack(m_maxScatterAttempts);
       }
     } while (true);
   }
@@ -78,5 +164,105 @@ MCAbsorptionStrategy::calculate(Kernel::PseudoRandomNumberGenerator &rng,
   return make_tuple(factor / static_cast<double>(m_nevents), m_error);
 }
 
+/**
+ * Compute the corrections for a final position of the neutron and several
+ * pairs of wavelengths before and after scattering. The tracks of each event
+ * are generated once and attenuated at all the wavelengths. The tracks of the
+ * events between estimates of the errors are intersected with the sample
+ * together.
+ * @param rng A reference to a PseudoRandomNumberGenerator. An
+ * MCQuasiRandomGenerator takes a new point for each attempt at an event.
+ * @param finalPos Defines the final position of the neutron, assumed to be
+ * where it is detected
+ * @param lambdasBefore Wavelengths, in \f$\\A^-1\f$, before scattering
+ * @param lambdasAfter Wavelengths, in \f$\\A^-1\f$, after scattering, one
+ * for each wavelength before scattering
+ * @param attenuationFactors Filled with the correction factor of each pair
+ * of wavelengths
+ * @param attFactorErrors Filled with the error of each correction factor
+ * @return The number of events simulated
+ */
+size_t MCAbsorptionStrategy::calculate(
+    Kernel::PseudoRandomNumberGenerator &rng, const Kernel::V3D &finalPos,
+    const std::vector<double> &lambdasBefore,
+    const std::vector<double> &lambdasAfter,
+    std::vector<double> &attenuationFactors,
+    std::vector<double> &attFactorErrors) const {
+  if (lambdasBefore.size() != lambdasAfter.size()) {
+    throw std::invalid_argument(
+        "MCAbsorptionStrategy::calculate() - The numbers of wavelengths "
+        "before and after scattering differ.");
+  }
+  const size_t nlambda = lambdasBefore.size();
+  const auto scatterBounds = m_scatterVol.getBoundingBox();
+  AttenuationCoefficients coefficientsBefore(lambdasBefore);
+  AttenuationCoefficients coefficientsAfter(lambdasAfter);
+  std::vector<double> exponents(nlambda), sums(nlambda, 0.0),
+      sumsOfSquares(nlambda, 0.0);
+  std::vector<Track> tracks;
+  size_t nevents(0);
+  while (nevents < m_nevents) {
+    // Generate the tracks of the events up to the next estimate of the errors
+    // and intersect them with the volume together
+    const size_t nbatch =
+        std::min(CONVERGENCE_CHECK_INTERVAL, m_nevents - nevents);
+    tracks.resize(2 * nbatch);
+    for (size_t i = 0; i < nbatch; ++i) {
+      startEvent(rng);
+      const auto neutron = m_beamProfile.generatePoint(rng, scatterBounds);
+      m_scatterVol.generateBeforeAfterTrack(rng, neutron.startPos, finalPos,
+                                            tracks[2 * i], tracks[2 * i + 1]);
+    }
+    m_scatterVol.interceptSurfaces(tracks);
+
+    for (size_t i = 0; i < nbatch; ++i) {
+      auto &beforeScatter = tracks[2 * i];
+      auto &afterScatter = tracks[2 * i + 1];
+      // Retry the events whose track before scattering missed everything
+      size_t attempts(1);
+      while (beforeScatter.count() == 0) {
+        if (attempts == m_maxScatterAttempts) {
+          throwNoValidTrack(m_maxScatterAttempts);
+        }
+        ++attempts;
+        startEvent(rng);
+        const auto neutron = m_beamProfile.generatePoint(rng, scatterBounds);
+        m_scatterVol.calculateBeforeAfterTrack(rng, neutron.startPos, finalPos,
+                                               beforeScatter, afterScatter);
+      }
+
+      std::fill(exponents.begin(), exponents.end(), 0.0);
+      coefficientsBefore.addExponents(beforeScatter, exponents);
+      coefficientsAfter.addExponents(afterScatter, exponents);
+      for (size_t j = 0; j < nlambda; ++j) {
+        const double wgt = std::exp(-exponents[j]);
+        sums[j] += wgt;
+        sumsOfSquares[j] += wgt * wgt;
+      }
+    }
+    nevents += nbatch;
+
+    if (m_relativeErrorTolerance > 0.0 &&
+        nevents % CONVERGENCE_CHECK_INTERVAL == 0) {
+      bool converged(true);
+      for (size_t i = 0; i < nlambda && converged; ++i) {
+        converged = standardError(sums[i], sumsOfSquares[i], nevents) <=
+                    m_relativeErrorTolerance * sums[i] /
+                        static_cast<double>(nevents);
+      }
+      if (converged)
+        break;
+    }
+  }
+
+  attenuationFactors.resize(nlambda);
+  attFactorErrors.resize(nlambda);
+  for (size_t i = 0; i < nlambda; ++i) {
+    attenuationFactors[i] = sums[i] / static_cast<double>(nevents);
+    attFactorErrors[i] = standardError(sums[i], sumsOfSquares[i], nevents);
+  }
+  return nevents;
+}
+
 } // namespace Algorithms
 } // namespace Mantid
@@ -72,21 +72,62 @@ const Geometry::BoundingBox &MCInteractionVolume::getBoundingBox() const {
 }
 
 /**
- * Calculate the attenuation correction factor the volume given a start and
- * end point.
+ * Generate a scatter point and the tracks leading to and away from it. The
+ * tracks are intersected with the sample and the environment.
  * @param rng A reference to a PseudoRandomNumberGenerator producing
  * random number between [0,1]
  * @param startPos Origin of the initial track
  * @param endPos Final position of neutron after scattering (assumed to be
  * outside of the "volume")
- * @param lambdaBefore Wavelength, in \f$\\A^-1\f$, before scattering
- * @param lambdaAfter Wavelength, in \f$\\A^-1\f$, after scattering
- * @return The fraction of the beam that has been attenuated. A negative number
- * indicates the track was not valid.
+ * @param beforeScatter Filled with the track from the scatter point back
+ * towards the start position
+ * @param afterScatter Filled with the track from the scatter point towards
+ * the end position
+ * @return False if the track before scattering did not intersect anything,
+ * in which case the tracks are not valid
  */
-double MCInteractionVolume::calculateAbsorption(
+bool MCInteractionVolume::calculateBeforeAfterTrack(
     Kernel::PseudoRandomNumberGenerator &rng, const Kernel::V3D &startPos,
-    const Kernel::V3D &endPos, double lambdaBefore, double lambdaAfter) const {
+    const Kernel::V3D &endPos, Track &beforeScatter,
+    Track &afterScatter) const {
+  generateBeforeAfterTrack(rng, startPos, endPos, beforeScatter,
+                           afterScatter);
+  int nlinks = m_sample->interceptSurface(beforeScatter);
+  if (m_env) {
+    nlinks += m_env->interceptSurfaces(beforeScatter);
+  }
+  // This should not happen but numerical precision means that it can
+  // occasionally occur with tracks that are very close to the surface
+  if (nlinks == 0) {
+    return false;
+  }
+
+  // Now track to final destination
+  m_sample->interceptSurface(afterScatter);
+  if (m_env) {
+    m_env->interceptSurfaces(afterScatter);
+  }
+  return true;
+}
+
+/**
+ * Generate a scatter point and the tracks leading to and away from it
+ * without intersecting them with anything, e.g. to intersect many of them
+ * together with interceptSurfaces()
+ * @param rng A reference to a PseudoRandomNumberGenerator producing
+ * random number between [0,1]
+ * @param startPos Origin of the initial track
+ * @param endPos Final position of neutron after scattering (assumed to be
+ * outside of the "volume")
+ * @param beforeScatter Reset to the track from the scatter point back
+ * towards the start position
+ * @param afterScatter Reset to the track from the scatter point towards
+ * the end position
+ */
+void MCInteractionVolume::generateBeforeAfterTrack(
+    Kernel::PseudoRandomNumberGenerator &rng, const Kernel::V3D &startPos,
+    const Kernel::V3D &endPos, Track &beforeScatter,
+    Track &afterScatter) const {
   // Generate scatter point. If there is an environment present then
   // first select whether the scattering occurs on the sample or the
   // environment. The attenuation for the path leading to the scatter point
@@ -103,14 +144,56 @@ double MCInteractionVolume::calculateAbsorption(
   }
   auto toStart = startPos - scatterPos;
   toStart.normalize();
-  Track beforeScatter(scatterPos, toStart);
-  int nlinks = m_sample->interceptSurface(beforeScatter);
+  beforeScatter.reset(scatterPos, toStart);
+  beforeScatter.clearIntersectionResults();
+
+  V3D scatteredDirec = endPos - scatterPos;
+  scatteredDirec.normalize();
+  afterScatter.reset(scatterPos, scatteredDirec);
+  afterScatter.clearIntersectionResults();
+}
+
+/**
+ * Intersect a set of tracks with the sample and the environment. A sample
+ * defined by CSG is intersected with all the tracks in one pass over its
+ * surfaces.
+ * @param tracks The tracks to fill with their sections
+ */
+void MCInteractionVolume::interceptSurfaces(std::vector<Track> &tracks) const {
+  if (const auto csgSample =
+          dynamic_cast<const Geometry::CSGObject *>(m_sample.get())) {
+    csgSample->interceptSurfaces(tracks);
+  } else {
+    for (auto &track : tracks) {
+      m_sample->interceptSurface(track);
+    }
+  }
   if (m_env) {
-    nlinks += m_env->interceptSurfaces(beforeScatter);
+    for (auto &track : tracks) {
+      m_env->interceptSurfaces(track);
+    }
   }
-  // This should not happen but numerical precision means that it can
-  // occasionally occur with tracks that are very close to the surface
-  if (nlinks == 0) {
+}
+
+/**
+ * Calculate the attenuation correction factor the volume given a start and
+ * end point.
+ * @param rng A reference to a PseudoRandomNumberGenerator producing
+ * random number between [0,1]
+ * @param startPos Origin of the initial track
+ * @param endPos Final position of neutron after scattering (assumed to be
+ * outside of the "volume")
+ * @param lambdaBefore Wavelength, in \f$\\A^-1\f$, before scattering
+ * @param lambdaAfter Wavelength, in \f$\\A^-1\f$, after scattering
+ * @return The fraction of the beam that has been attenuated. A negative number
+ * indicates the track was not valid.
+ */
+double MCInteractionVolume::calculateAbsorption(
+    Kernel::PseudoRandomNumberGenerator &rng, const Kernel::V3D &startPos,
+    const Kernel::V3D &endPos, double lambdaBefore, double lambdaAfter) const {
+  Track beforeScatter, afterScatter;
+  if (!calculateBeforeAfterTrack(rng, startPos, endPos, beforeScatter,
+                                 afterScatter)) {
     return -1.0;
   }
 
@@ -129,14 +212,6 @@ double MCInteractionVolume::calculateAbsorption(
     return factor;
   };
 
-  // Now track to final destination
-  V3D scatteredDirec = endPos - scatterPos;
-  scatteredDirec.normalize();
-  Track afterScatter(scatterPos, scatteredDirec);
-  m_sample->interceptSurface(afterScatter);
-  if (m_env) {
-    m_env->interceptSurfaces(afterScatter);
-  }
   return calculateAttenuation(beforeScatter, lambdaBefore) *
          calculateAttenuation(afterScatter, lambdaAfter);
 }
@@ -0,0 +1,114 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAlgorithms/SampleCorrections/MCQuasiRandomGenerator.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace Algorithms {
+
+/**
+ * Constructor. No event is started, so numbers are taken from the Mersenne
+ * Twister until nextEvent() is called. The range is set to [0.0, 1.0]
+ * @param ndims The number of dimensions of the sequence, i.e. the numbers of
+ * each event taken from it
+ * @param seedValue The seed of the numbers drawn beyond the sequence
+ */
+MCQuasiRandomGenerator::MCQuasiRandomGenerator(const unsigned int ndims,
+                                               const size_t seedValue)
+    : m_sequence(ndims), m_padding(seedValue), m_point(), m_nextDimension(0),
+      m_savedPoint(), m_savedDimension(0), m_start(0.0), m_end(1.0) {}
+
+/**
+ * Start a new event. The following numbers are the coordinates of the next
+ * point of the sequence.
+ */
+void MCQuasiRandomGenerator::nextEvent() {
+  m_point = m_sequence.nextPoint();
+  m_nextDimension = 0;
+}
+
+/**
+ * (Re-)seed the generator of the numbers drawn beyond the sequence. The
+ * sequence itself does not depend on a seed.
+ * @param seedValue A seed for the generator
+ */
+void MCQuasiRandomGenerator::setSeed(const size_t seedValue) {
+  m_padding.setSeed(seedValue);
+}
+
+/**
+ * Sets the range of the subsequent calls to nextValue()
+ * @param start The lowest value a call to nextValue() will produce
+ * @param end The largest value a call to nextValue() will produce
+ */
+void MCQuasiRandomGenerator::setRange(const double start, const double end) {
+  m_start = start;
+  m_end = end;
+}
+
+/**
+ * Returns the next number of the current event scaled to the given range
+ * @param start Start of the requested range
+ * @param end End of the requested range
+ * @returns The next coordinate of the point of the event, or a pseudo-random
+ * number once they are used up
+ */
+double MCQuasiRandomGenerator::nextValue(double start, double end) {
+  return start + nextUnitValue() * (end - start);
+}
+
+/**
+ * Returns the next integer of the current event
+ * @param start Start of the requested range
+ * @param end End of the requested range
+ * @return An integer in the defined range
+ */
+int MCQuasiRandomGenerator::nextInt(int start, int end) {
+  const auto nvalues = static_cast<double>(end - start + 1);
+  const auto value = start + static_cast<int>(nextUnitValue() * nvalues);
+  return std::min(value, end);
+}
+
+/**
+ * Restarts the sequence from its first point and the Mersenne Twister from
+ * its seed
+ */
+void MCQuasiRandomGenerator::restart() {
+  m_sequence.restart();
+  m_padding.restart();
+  m_point.clear();
+  m_nextDimension = 0;
+}
+
+/// Saves the current state of the generator
+void MCQuasiRandomGenerator::save() {
+  m_sequence.save();
+  m_padding.save();
+  m_savedPoint = m_point;
+  m_savedDimension = m_nextDimension;
+}
+
+/// Restores the generator to the last saved point, or the beginning if nothing
+/// has been saved
+void MCQuasiRandomGenerator::restore() {
+  m_sequence.restore();
+  m_padding.restore();
+  m_point = m_savedPoint;
+  m_nextDimension = m_savedDimension;
+}
+
+/// Return the next number of the event in [0, 1)
+double MCQuasiRandomGenerator::nextUnitValue() {
+  if (m_nextDimension < m_point.size()) {
+    return m_point[m_nextDimension++];
+  }
+  return m_padding.nextValue();
+}
+
+} // namespace Algorithms
+} // namespace Mantid
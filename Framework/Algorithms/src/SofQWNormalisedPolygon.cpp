@@ -7,6 +7,7 @@
 #include "MantidAlgorithms/SofQWNormalisedPolygon.h"
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/SpectrumDetectorMapping.h"
+#include "MantidAPI/SpectrumGeometry.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidAPI/WorkspaceNearestNeighbourInfo.h"
@@ -524,13 +525,13 @@ void SofQWNormalisedPolygon::initAngularCachesPSD(
   m_twoThetaLowers.resize(nHistos);
   m_twoThetaUppers.resize(nHistos);
 
-  const auto &spectrumInfo = workspace.spectrumInfo();
+  const auto geometry = workspace.spectrumInfo().geometry();
 
   for (size_t i = 0; i < nHistos; ++i) {
     m_progress->report("Calculating detector angular widths");
 
     // If no detector found, skip onto the next spectrum
-    if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i)) {
+    if (!geometry->hasDetectors()[i] || geometry->isMonitor()[i]) {
       continue;
     }
 
@@ -542,7 +543,7 @@ void SofQWNormalisedPolygon::initAngularCachesPSD(
     double thetaWidth = std::numeric_limits<double>::lowest();
 
     // Find theta and phi widths
-    const double theta = spectrumInfo.twoTheta(i);
+    const double theta = geometry->twoTheta(i);
 
     const specnum_t deltaPlus1 = inSpec + 1;
     const specnum_t deltaMinus1 = inSpec - 1;
@@ -553,7 +554,7 @@ void SofQWNormalisedPolygon::initAngularCachesPSD(
       specnum_t spec = neighbour.first;
       if (spec == deltaPlus1 || spec == deltaMinus1 || spec == deltaPlusT ||
           spec == deltaMinusT) {
-        const double theta_n = spectrumInfo.twoTheta(spec - 1) * 0.5;
+        const double theta_n = geometry->twoTheta(spec - 1) * 0.5;
 
         const double dTheta = std::abs(theta - theta_n);
         thetaWidth = std::max(thetaWidth, dTheta);
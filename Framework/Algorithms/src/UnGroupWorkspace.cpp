@@ -61,7 +61,7 @@ void UnGroupWorkspace::exec() {
   }
 
   // Notify observers that a WorkspaceGroup is about to be unrolled
-  data_store.notificationCenter.postNotification(
+  data_store.postNotification(
       new Mantid::API::WorkspaceUnGroupingNotification(inputws, wsSptr));
   // Now remove the WorkspaceGroup from the ADS
   data_store.remove(inputws);
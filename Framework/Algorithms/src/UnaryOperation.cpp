@@ -33,6 +33,18 @@ void UnaryOperation::init() {
   defineProperties();
 }
 
+/// The input may be modified in place unless events are to be turned into
+/// histograms
+std::pair<std::string, std::string>
+UnaryOperation::inPlaceWorkspaceProperties() const {
+  if (useHistogram) {
+    MatrixWorkspace_const_sptr input = getProperty(inputPropName());
+    if (boost::dynamic_pointer_cast<const EventWorkspace>(input))
+      return {};
+  }
+  return {inputPropName(), outputPropName()};
+}
+
 /// Executes the algorithm
 void UnaryOperation::exec() {
   // get the input workspaces
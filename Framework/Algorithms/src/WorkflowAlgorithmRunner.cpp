@@ -6,11 +6,13 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidAlgorithms/WorkflowAlgorithmRunner.h"
 
+#include "MantidAPI/DataflowExecutor.h"
 #include "MantidAPI/ITableWorkspace.h"
 #include "MantidKernel/MandatoryValidator.h"
 
 #include <deque>
 #include <unordered_map>
+#include <unordered_set>
 
 using namespace Mantid::API;
 using namespace Mantid::Kernel;
@@ -21,6 +23,7 @@ namespace Algorithms {
 namespace PropertyNames {
 const static std::string ALGORITHM("Algorithm");
 const static std::string IO_MAP("InputOutputMap");
+const static std::string RUN_CONCURRENTLY("RunConcurrently");
 const static std::string SETUP_TABLE("SetupTable");
 } // namespace PropertyNames
 
@@ -100,6 +103,9 @@ void WorkflowAlgorithmRunner::init() {
   declareProperty(make_unique<WorkspaceProperty<ITableWorkspace>>(
                       PropertyNames::IO_MAP.c_str(), "", Direction::Input),
                   "Table workspace mapping algorithm outputs to inputs.");
+  declareProperty(PropertyNames::RUN_CONCURRENTLY, false,
+                  "If true, runs that do not depend on each other are "
+                  "executed at the same time.");
 }
 
 void WorkflowAlgorithmRunner::exec() {
@@ -140,57 +146,102 @@ void WorkflowAlgorithmRunner::exec() {
     configureRow(setupTable, propertyTable, i, queue, ioMap);
   }
 
-  // Execute the algorithm in the order specified by queue.
+  const bool runConcurrently = getProperty(PropertyNames::RUN_CONCURRENTLY);
+  if (!runConcurrently) {
+    // Execute the algorithm in the order specified by queue.
+    while (!queue.empty()) {
+      auto algorithm = createAlgorithm(propertyTable, queue.front());
+      algorithm->execute();
+      if (!algorithm->isExecuted()) {
+        throw std::runtime_error("Workflow algorithm failed to execute.");
+      }
+      queue.pop_front();
+    }
+    return;
+  }
+
+  // Build a graph of the runs. Inputs coming from other runs do not exist
+  // yet so they are passed on by the graph rather than set by name.
+  DataflowExecutor graph;
+  std::unordered_map<size_t, DataflowExecutor::NodeId> nodes;
+  for (const auto row : queue) {
+    std::unordered_set<std::string> linkedInputs;
+    for (const auto &ioPair : ioMap) {
+      const auto &outputId = setupTable->getRef<std::string>(ioPair.first, row);
+      if (!outputId.empty() && !isHardCodedWorkspaceName(outputId)) {
+        linkedInputs.insert(ioPair.first);
+      }
+    }
+    nodes[row] = graph.add(createAlgorithm(propertyTable, row, linkedInputs));
+    for (const auto &input : linkedInputs) {
+      size_t outputRow = -1;
+      setupTable->find(setupTable->getRef<std::string>(input, row), outputRow,
+                       0);
+      graph.connect(nodes.at(outputRow), ioMap.at(input), nodes[row], input);
+    }
+  }
+  graph.execute();
+  g_log.information() << graph.criticalPathReport() << '\n';
+}
+
+/**
+ * Creates the managed algorithm and sets its properties from a row of
+ * `propertyTable`.
+ * @param propertyTable a table containing the final property values
+ * @param row the row in `propertyTable` to use
+ * @param skippedProperties properties not to set
+ * @return an initialized algorithm
+ * @throw std::runtime_error if the algorithm cannot be configured
+ */
+Algorithm_sptr WorkflowAlgorithmRunner::createAlgorithm(
+    ITableWorkspace_sptr propertyTable, const size_t row,
+    const std::unordered_set<std::string> &skippedProperties) const {
   const std::string algorithmName = getProperty(PropertyNames::ALGORITHM);
   auto &algorithmFactory = AlgorithmFactory::Instance();
-  while (!queue.empty()) {
-    const auto row = queue.front();
-    auto algorithm = algorithmFactory.create(
-        algorithmName, algorithmFactory.highestVersion(algorithmName));
-    algorithm->initialize();
-    if (!algorithm->isInitialized()) {
-      throw std::runtime_error("Workflow algorithm failed to initialise.");
+  auto algorithm = algorithmFactory.create(
+      algorithmName, algorithmFactory.highestVersion(algorithmName));
+  algorithm->initialize();
+  if (!algorithm->isInitialized()) {
+    throw std::runtime_error("Workflow algorithm failed to initialise.");
+  }
+  // First column in taskTable is for id.
+  for (size_t col = 1; col < propertyTable->columnCount(); ++col) {
+    const auto column = propertyTable->getColumn(col);
+    const auto &propertyName = column->name();
+    if (skippedProperties.count(propertyName) > 0) {
+      continue;
     }
-    // First column in taskTable is for id.
-    for (size_t col = 1; col < propertyTable->columnCount(); ++col) {
-      const auto column = propertyTable->getColumn(col);
-      const auto &propertyName = column->name();
-      const auto &valueType = column->get_type_info();
-      try {
-        if (valueType == typeid(std::string)) {
-          const auto &value = propertyTable->cell<std::string>(row, col);
-          algorithm->setProperty(propertyName, value);
-        } else if (valueType == typeid(int)) {
-          const auto &value = propertyTable->cell<int>(row, col);
-          algorithm->setProperty(propertyName, static_cast<long>(value));
-        } else if (valueType == typeid(size_t)) {
-          const auto &value = propertyTable->cell<size_t>(row, col);
-          algorithm->setProperty(propertyName, value);
-        } else if (valueType == typeid(float) || valueType == typeid(double)) {
-          const auto &value = propertyTable->cell<double>(row, col);
-          algorithm->setProperty(propertyName, value);
-        } else if (valueType == typeid(bool)) {
-          const auto &value = propertyTable->cell<bool>(row, col);
-          algorithm->setProperty(propertyName, value);
-        } else if (valueType == typeid(Kernel::V3D)) {
-          const auto &value = propertyTable->cell<V3D>(row, col);
-          algorithm->setProperty(propertyName, value);
-        } else {
-          throw std::runtime_error("Unimplemented column type in " +
-                                   PropertyNames::SETUP_TABLE + ": " +
-                                   valueType.name() + '.');
-        }
-      } catch (std::invalid_argument &e) {
-        throw std::runtime_error("While setting properties for algorithm " +
-                                 algorithmName + ": " + e.what());
+    const auto &valueType = column->get_type_info();
+    try {
+      if (valueType == typeid(std::string)) {
+        const auto &value = propertyTable->cell<std::string>(row, col);
+        algorithm->setProperty(propertyName, value);
+      } else if (valueType == typeid(int)) {
+        const auto &value = propertyTable->cell<int>(row, col);
+        algorithm->setProperty(propertyName, static_cast<long>(value));
+      } else if (valueType == typeid(size_t)) {
+        const auto &value = propertyTable->cell<size_t>(row, col);
+        algorithm->setProperty(propertyName, value);
+      } else if (valueType == typeid(float) || valueType == typeid(double)) {
+        const auto &value = propertyTable->cell<double>(row, col);
+        algorithm->setProperty(propertyName, value);
+      } else if (valueType == typeid(bool)) {
+        const auto &value = propertyTable->cell<bool>(row, col);
+        algorithm->setProperty(propertyName, value);
+      } else if (valueType == typeid(Kernel::V3D)) {
+        const auto &value = propertyTable->cell<V3D>(row, col);
+        algorithm->setProperty(propertyName, value);
+      } else {
+        throw std::runtime_error("Unimplemented column type in " +
+                                 PropertyNames::SETUP_TABLE + ": " +
+                                 valueType.name() + '.');
       }
+    } catch (std::invalid_argument &e) {
+      throw std::runtime_error("While setting properties for algorithm " +
+                               algorithmName + ": " + e.what());
     }
-    algorithm->execute();
-    if (!algorithm->isExecuted()) {
-      throw std::runtime_error("Workflow algorithm failed to execute.");
-    }
-    queue.pop_front();
   }
+  return algorithm;
 }
 
 /**
@@ -10,6 +10,7 @@
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 #include <cxxtest/TestSuite.h>
 
+#include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/Axis.h"
 #include "MantidAPI/FrameworkManager.h"
@@ -21,9 +22,12 @@
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidKernel/Memory.h"
 #include "MantidKernel/OptionalBool.h"
 #include "MantidKernel/UnitFactory.h"
 
+#include <algorithm>
+
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
 using namespace Mantid::Algorithms;
@@ -890,7 +894,60 @@ public:
     TS_ASSERT(alg->isExecuted());
   }
 
+  /// The chain executes in place when it hands each workspace on
+  void test_reduction_chain_in_place() {
+    const auto growth = runReductionChain(true);
+    TS_WARN("Memory growth of reduction chain in place: " +
+            std::to_string(growth / (1024 * 1024)) + " MiB");
+  }
+
+  /// The chain copies at each step when the caller keeps the input
+  void test_reduction_chain_with_copies() {
+    const auto growth = runReductionChain(false);
+    TS_WARN("Memory growth of reduction chain with copies: " +
+            std::to_string(growth / (1024 * 1024)) + " MiB");
+  }
+
 private:
+  /** Run ConvertUnits, Scale and ReplaceSpecialValues one after the other
+   * as child algorithms on a large workspace
+   * @param handOver :: Leave the only reference to each workspace with the
+   * next algorithm rather than keeping it until the algorithm has finished
+   * @return The largest growth of the resident memory, in bytes, seen at the
+   * end of a step while its algorithm still holds the input. The peak
+   * resident memory is not used as it only ever grows in a process.
+   */
+  size_t runReductionChain(bool handOver) {
+    MatrixWorkspace_sptr ws =
+        WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(5000,
+                                                                     2000);
+    ws->getAxis(0)->setUnit("TOF");
+    const auto *input = ws.get();
+    const size_t before = MemoryStats().getCurrentRSS();
+    size_t largest(before);
+
+    const std::vector<std::pair<std::string, std::string>> chain{
+        {"ConvertUnits", "Target=Wavelength"},
+        {"Scale", "Factor=2"},
+        {"ReplaceSpecialValues", "NaNValue=0"}};
+    for (const auto &step : chain) {
+      auto alg = AlgorithmManager::Instance().createUnmanaged(step.first);
+      alg->initialize();
+      alg->setChild(true);
+      alg->setRethrows(true);
+      alg->setProperty("InputWorkspace", ws);
+      if (handOver)
+        ws.reset();
+      alg->setPropertyValue("OutputWorkspace", "out");
+      alg->setPropertiesWithString(step.second);
+      alg->execute();
+      ws = alg->getProperty("OutputWorkspace");
+      largest = std::max(largest, MemoryStats().getCurrentRSS());
+    }
+    TS_ASSERT_EQUALS(ws.get() == input, handOver);
+    return largest - before;
+  }
+
   MatrixWorkspace_sptr histWS;
   MatrixWorkspace_sptr eventWS;
 };
@@ -242,6 +242,70 @@ public:
     AnalysisDataService::Instance().remove("PeakParametersWS");
   }
 
+  //----------------------------------------------------------------------------------------------
+  /** Test fitting more spectra than there are threads, such that each thread
+   * fits spectra of different peak profiles one after the other
+   * @brief test_multiPeaksManySpectra
+   */
+  void test_multiPeaksManySpectra() {
+    std::vector<string> peakparnames;
+    std::vector<double> peakparvalues;
+    createGuassParameters(peakparnames, peakparvalues);
+
+    const size_t num_spec = 60;
+    createTestData(m_inputWorkspaceName, num_spec);
+
+    FitPeaks fitpeaks;
+    fitpeaks.initialize();
+    TS_ASSERT_THROWS_NOTHING(
+        fitpeaks.setProperty("InputWorkspace", m_inputWorkspaceName));
+    TS_ASSERT_THROWS_NOTHING(fitpeaks.setProperty("PeakCenters", "5.0, 10.0"));
+    TS_ASSERT_THROWS_NOTHING(
+        fitpeaks.setProperty("FitWindowBoundaryList", "2.5, 6.5, 8.0, 12.0"));
+    TS_ASSERT_THROWS_NOTHING(fitpeaks.setProperty("FitFromRight", true));
+    TS_ASSERT_THROWS_NOTHING(
+        fitpeaks.setProperty("PeakParameterNames", peakparnames));
+    TS_ASSERT_THROWS_NOTHING(
+        fitpeaks.setProperty("PeakParameterValues", peakparvalues));
+    TS_ASSERT_THROWS_NOTHING(fitpeaks.setProperty("HighBackground", false));
+    fitpeaks.setProperty("OutputWorkspace", "PeakPositionsWS");
+    fitpeaks.setProperty("OutputPeakParametersWorkspace", "PeakParametersWS");
+    fitpeaks.setProperty("ConstrainPeakPositions", false);
+
+    fitpeaks.execute();
+    TS_ASSERT(fitpeaks.isExecuted());
+    if (!fitpeaks.isExecuted())
+      return;
+
+    API::MatrixWorkspace_sptr main_out_ws =
+        boost::dynamic_pointer_cast<API::MatrixWorkspace>(
+            AnalysisDataService::Instance().retrieve("PeakPositionsWS"));
+    TS_ASSERT(main_out_ws);
+    TS_ASSERT_EQUALS(main_out_ws->getNumberHistograms(), num_spec);
+    API::ITableWorkspace_sptr param_ws =
+        boost::dynamic_pointer_cast<API::ITableWorkspace>(
+            AnalysisDataService::Instance().retrieve("PeakParametersWS"));
+    TS_ASSERT(param_ws);
+    TS_ASSERT_EQUALS(param_ws->rowCount(), 2 * num_spec);
+
+    // every spectrum gets the peaks of its own profile
+    const double expected_positions[3][2] = {
+        {5.0, 10.0}, {5.01, 9.98}, {5.03, 10.02}};
+    for (size_t i = 0; i < num_spec; ++i) {
+      const auto &fitted_positions = main_out_ws->histogram(i).y();
+      TS_ASSERT_DELTA(fitted_positions[0], expected_positions[i % 3][0],
+                      1.E-6);
+      TS_ASSERT_DELTA(fitted_positions[1], expected_positions[i % 3][1],
+                      1.E-6);
+      TS_ASSERT_EQUALS(param_ws->cell<int>(2 * i, 0), static_cast<int>(i));
+    }
+
+    // clean up
+    AnalysisDataService::Instance().remove(m_inputWorkspaceName);
+    AnalysisDataService::Instance().remove("PeakPositionsWS");
+    AnalysisDataService::Instance().remove("PeakParametersWS");
+  }
+
   //----------------------------------------------------------------------------------------------
   /** Test output of effective peak parameters
    * @brief test_effectivePeakParameters
@@ -941,13 +1005,13 @@ public:
    * ws-index = 0: peak 0 @ 5.00; peak 1  @ 10.00
    * ws-index = 1: peak 0 @ 5.01; peak 1  @  9.98
    * ws-index = 2: peak 0 @ 5.03; peak 1  @ 10.02
+   * Further spectra repeat the 3 above in turn
    * @brief createTestData
    * @param workspacename
+   * @param num_spec :: number of spectra
    */
-  void createTestData(const std::string &workspacename) {
+  void createTestData(const std::string &workspacename, size_t num_spec = 3) {
     // ---- Create the simple workspace -------
-    size_t num_spec = 3;
-
     MatrixWorkspace_sptr WS =
         WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(
             static_cast<int>(num_spec), 300);
@@ -958,38 +1022,33 @@ public:
     for (size_t i = 0; i < num_spec; ++i)
       WS->mutableX(i) *= 0.05;
 
-    // spectrum 1 (ws=0)
-    const auto &xvals = WS->points(0);
-    std::transform(xvals.cbegin(), xvals.cend(), WS->mutableY(0).begin(),
-                   [](const double x) {
-                     return exp(-0.5 * pow((x - 10) / 0.1, 2)) +
-                            2.0 * exp(-0.5 * pow((x - 5) / 0.15, 2)) + 1.E-10;
-                   });
-    const auto &yvals = WS->histogram(0).y();
-    std::transform(yvals.cbegin(), yvals.cend(), WS->mutableE(0).begin(),
-                   [](const double y) { return sqrt(y); });
-
-    if (num_spec > 1) {
-      const auto &xvals1 = WS->points(1);
-      std::transform(xvals1.cbegin(), xvals1.cend(), WS->mutableY(1).begin(),
-                     [](const double x) {
-                       return 2. * exp(-0.5 * pow((x - 9.98) / 0.12, 2)) +
-                              4.0 * exp(-0.5 * pow((x - 5.01) / 0.17, 2));
-                     });
-      const auto &yvals1 = WS->histogram(1).y();
-      std::transform(yvals1.cbegin(), yvals1.cend(), WS->mutableE(1).begin(),
-                     [](const double y) { return sqrt(y); });
-    }
-
-    if (num_spec > 2) {
-      const auto &xvals2 = WS->points(2);
-      std::transform(xvals2.cbegin(), xvals2.cend(), WS->mutableY(2).begin(),
-                     [](const double x) {
-                       return 10 * exp(-0.5 * pow((x - 10.02) / 0.14, 2)) +
-                              3.0 * exp(-0.5 * pow((x - 5.03) / 0.19, 2));
-                     });
-      const auto &yvals2 = WS->histogram(2).y();
-      std::transform(yvals2.cbegin(), yvals2.cend(), WS->mutableE(2).begin(),
+    for (size_t i = 0; i < num_spec; ++i) {
+      const auto &xvals = WS->points(i);
+      auto &yvals = WS->mutableY(i);
+      switch (i % 3) {
+      case 0:
+        std::transform(xvals.cbegin(), xvals.cend(), yvals.begin(),
+                       [](const double x) {
+                         return exp(-0.5 * pow((x - 10) / 0.1, 2)) +
+                                2.0 * exp(-0.5 * pow((x - 5) / 0.15, 2)) +
+                                1.E-10;
+                       });
+        break;
+      case 1:
+        std::transform(xvals.cbegin(), xvals.cend(), yvals.begin(),
+                       [](const double x) {
+                         return 2. * exp(-0.5 * pow((x - 9.98) / 0.12, 2)) +
+                                4.0 * exp(-0.5 * pow((x - 5.01) / 0.17, 2));
+                       });
+        break;
+      default:
+        std::transform(xvals.cbegin(), xvals.cend(), yvals.begin(),
+                       [](const double x) {
+                         return 10 * exp(-0.5 * pow((x - 10.02) / 0.14, 2)) +
+                                3.0 * exp(-0.5 * pow((x - 5.03) / 0.19, 2));
+                       });
+      }
+      std::transform(yvals.cbegin(), yvals.cend(), WS->mutableE(i).begin(),
                      [](const double y) { return sqrt(y); });
     }
 
@@ -1115,4 +1174,39 @@ public:
   }
 };
 
+class FitPeaksTestPerformance : public CxxTest::TestSuite {
+public:
+  static FitPeaksTestPerformance *createSuite() {
+    API::FrameworkManager::Instance();
+    return new FitPeaksTestPerformance();
+  }
+  static void destroySuite(FitPeaksTestPerformance *suite) { delete suite; }
+
+  void setUp() override {
+    FitPeaksTest().createTestData(m_inputWorkspaceName, 3000);
+  }
+
+  void tearDown() override {
+    AnalysisDataService::Instance().remove(m_inputWorkspaceName);
+    AnalysisDataService::Instance().remove("PeakPositionsWS");
+    AnalysisDataService::Instance().remove("PeakParametersWS");
+  }
+
+  void test_fit_two_peaks_in_many_spectra() {
+    FitPeaks fitpeaks;
+    fitpeaks.initialize();
+    fitpeaks.setProperty("InputWorkspace", m_inputWorkspaceName);
+    fitpeaks.setProperty("PeakCenters", "5.0, 10.0");
+    fitpeaks.setProperty("FitWindowBoundaryList", "2.5, 6.5, 8.0, 12.0");
+    fitpeaks.setProperty("HighBackground", false);
+    fitpeaks.setProperty("OutputWorkspace", "PeakPositionsWS");
+    fitpeaks.setProperty("OutputPeakParametersWorkspace", "PeakParametersWS");
+    fitpeaks.execute();
+    TS_ASSERT(fitpeaks.isExecuted());
+  }
+
+private:
+  std::string m_inputWorkspaceName{"FitPeaksTestPerformance_workspace"};
+};
+
 #endif /* MANTID_ALGORITHMS_FITPEAKSTEST_H_ */
@@ -63,6 +63,86 @@ public:
     TS_ASSERT_DELTA(1.0 / std::sqrt(nevents), error, 1e-08);
   }
 
+  void test_Simulation_Of_Several_Wavelengths_Traces_Each_Event_Once() {
+    using Mantid::Kernel::V3D;
+    using namespace MonteCarloTesting;
+    using namespace ::testing;
+
+    auto testSampleSphere = MonteCarloTesting::createTestSample(
+        MonteCarloTesting::TestSampleType::SolidSphere);
+    MockBeamProfile testBeamProfile;
+    EXPECT_CALL(testBeamProfile, defineActiveRegion(_))
+        .WillOnce(Return(testSampleSphere.getShape().getBoundingBox()));
+    const size_t nevents(10), maxTries(100);
+    MCAbsorptionStrategy mcabsorb(testBeamProfile, testSampleSphere, nevents,
+                                  maxTries);
+    // 3 random numbers per event whatever the number of wavelengths, then 3
+    // per event for the single wavelength below
+    MockRNG rng;
+    EXPECT_CALL(rng, nextValue())
+        .Times(Exactly(60))
+        .WillRepeatedly(Return(0.5));
+    const Mantid::Algorithms::IBeamProfile::Ray testRay = {V3D(-2, 0, 0),
+                                                           V3D(1, 0, 0)};
+    EXPECT_CALL(testBeamProfile, generatePoint(_, _))
+        .Times(Exactly(static_cast<int>(2 * nevents)))
+        .WillRepeatedly(Return(testRay));
+    const V3D endPos(0.7, 0.7, 1.4);
+    const std::vector<double> lambdasBefore{2.5, 1.0, 4.0};
+    const std::vector<double> lambdasAfter{3.5, 1.5, 4.0};
+
+    std::vector<double> factors, errors;
+    TS_ASSERT_EQUALS(nevents, mcabsorb.calculate(rng, endPos, lambdasBefore,
+                                                 lambdasAfter, factors,
+                                                 errors));
+    TS_ASSERT_EQUALS(3, factors.size());
+    TS_ASSERT_EQUALS(3, errors.size());
+    TS_ASSERT_DELTA(0.0043828472, factors[0], 1e-08);
+    // Shorter wavelengths are attenuated less
+    TS_ASSERT_LESS_THAN(factors[0], factors[1]);
+    TS_ASSERT_LESS_THAN(factors[2], factors[0]);
+    double factor(0.0);
+    std::tie(factor, std::ignore) = mcabsorb.calculate(
+        rng, endPos, lambdasBefore[1], lambdasAfter[1]);
+    TS_ASSERT_DELTA(factor, factors[1], 1e-12);
+    // Every event is the same
+    for (const auto error : errors) {
+      TS_ASSERT_DELTA(0.0, error, 1e-12);
+    }
+  }
+
+  void test_Simulation_Stops_Once_Errors_Are_Within_Tolerance() {
+    using Mantid::Kernel::V3D;
+    using namespace MonteCarloTesting;
+    using namespace ::testing;
+
+    auto testSampleSphere = MonteCarloTesting::createTestSample(
+        MonteCarloTesting::TestSampleType::SolidSphere);
+    MockBeamProfile testBeamProfile;
+    EXPECT_CALL(testBeamProfile, defineActiveRegion(_))
+        .WillOnce(Return(testSampleSphere.getShape().getBoundingBox()));
+    const size_t nevents(1000), maxTries(100);
+    MCAbsorptionStrategy mcabsorb(testBeamProfile, testSampleSphere, nevents,
+                                  maxTries, 0.01);
+    // Identical events have no error so the first estimate, after 100
+    // events, stops the simulation
+    MockRNG rng;
+    EXPECT_CALL(rng, nextValue())
+        .Times(Exactly(300))
+        .WillRepeatedly(Return(0.5));
+    const Mantid::Algorithms::IBeamProfile::Ray testRay = {V3D(-2, 0, 0),
+                                                           V3D(1, 0, 0)};
+    EXPECT_CALL(testBeamProfile, generatePoint(_, _))
+        .Times(Exactly(100))
+        .WillRepeatedly(Return(testRay));
+    const V3D endPos(0.7, 0.7, 1.4);
+
+    std::vector<double> factors, errors;
+    TS_ASSERT_EQUALS(100, mcabsorb.calculate(rng, endPos, {2.5, 1.0},
+                                             {3.5, 1.5}, factors, errors));
+    TS_ASSERT_DELTA(0.0043828472, factors[0], 1e-08);
+  }
+
   //----------------------------------------------------------------------------
   // Failure cases
   //----------------------------------------------------------------------------
@@ -89,6 +169,26 @@ public:
                      std::runtime_error)
   }
 
+  void test_different_numbers_of_wavelengths_are_not_accepted() {
+    using Mantid::Algorithms::RectangularBeamProfile;
+    using namespace Mantid::Geometry;
+    using namespace Mantid::Kernel;
+    using namespace MonteCarloTesting;
+    using namespace ::testing;
+
+    auto testSampleSphere = MonteCarloTesting::createTestSample(
+        MonteCarloTesting::TestSampleType::SolidSphere);
+    RectangularBeamProfile testBeamProfile(
+        ReferenceFrame(Y, Z, Right, "source"), V3D(), 1, 1);
+    MCAbsorptionStrategy mcabs(testBeamProfile, testSampleSphere, 10, 100);
+    MockRNG rng;
+    EXPECT_CALL(rng, nextValue()).Times(0);
+    std::vector<double> factors, errors;
+    TS_ASSERT_THROWS(mcabs.calculate(rng, V3D(0.7, 0.7, 1.4), {2.5, 1.0},
+                                     {3.5}, factors, errors),
+                     std::invalid_argument)
+  }
+
 private:
   class MockBeamProfile final : public Mantid::Algorithms::IBeamProfile {
   public:
@@ -131,6 +131,34 @@ public:
     Mock::VerifyAndClearExpectations(&rng);
   }
 
+  void test_Tracks_Intersected_Together_Match_Tracks_Intersected_In_Turn() {
+    using Mantid::Geometry::Track;
+    using Mantid::Kernel::MersenneTwister;
+    using Mantid::Kernel::V3D;
+    using namespace MonteCarloTesting;
+
+    const V3D startPos(-2.0, 0.0, 0.0), endPos(0.7, 0.7, 1.4);
+    auto sample = createTestSample(TestSampleType::SamplePlusContainer);
+    MCInteractionVolume interactor(sample,
+                                   sample.getEnvironment().boundingBox());
+    const size_t nevents(20);
+    MersenneTwister batchRNG(1), singleRNG(1);
+    std::vector<Track> tracks(2 * nevents);
+    for (size_t i = 0; i < nevents; ++i) {
+      interactor.generateBeforeAfterTrack(batchRNG, startPos, endPos,
+                                          tracks[2 * i], tracks[2 * i + 1]);
+    }
+    interactor.interceptSurfaces(tracks);
+
+    Track beforeScatter, afterScatter;
+    for (size_t i = 0; i < nevents; ++i) {
+      TS_ASSERT(interactor.calculateBeforeAfterTrack(
+          singleRNG, startPos, endPos, beforeScatter, afterScatter));
+      checkSameLinks(beforeScatter, tracks[2 * i]);
+      checkSameLinks(afterScatter, tracks[2 * i + 1]);
+    }
+  }
+
   //----------------------------------------------------------------------------
   // Failure cases
   //----------------------------------------------------------------------------
@@ -167,6 +195,21 @@ public:
                                                     lambdaBefore, lambdaAfter),
                      std::runtime_error);
   }
+
+private:
+  void checkSameLinks(const Mantid::Geometry::Track &expected,
+                      const Mantid::Geometry::Track &actual) {
+    TS_ASSERT_EQUALS(expected.count(), actual.count());
+    auto actualLink = actual.cbegin();
+    for (const auto &link : expected) {
+      if (actualLink == actual.cend())
+        break;
+      TS_ASSERT_DELTA(link.distInsideObject, actualLink->distInsideObject,
+                      1e-12);
+      TS_ASSERT_EQUALS(link.object, actualLink->object);
+      ++actualLink;
+    }
+  }
 };
 
 #endif /* MANTID_ALGORITHMS_MCINTERACTIONVOLUMETEST_H_ */
@@ -0,0 +1,114 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_ALGORITHMS_MCQUASIRANDOMGENERATORTEST_H_
+#define MANTID_ALGORITHMS_MCQUASIRANDOMGENERATORTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAlgorithms/SampleCorrections/MCQuasiRandomGenerator.h"
+#include "MantidKernel/MersenneTwister.h"
+#include "MantidKernel/SobolSequence.h"
+
+using Mantid::Algorithms::MCQuasiRandomGenerator;
+
+class MCQuasiRandomGeneratorTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MCQuasiRandomGeneratorTest *createSuite() {
+    return new MCQuasiRandomGeneratorTest();
+  }
+  static void destroySuite(MCQuasiRandomGeneratorTest *suite) { delete suite; }
+
+  void test_Each_Event_Takes_Next_Point_Of_Sequence() {
+    MCQuasiRandomGenerator generator(3, 1);
+    Mantid::Kernel::SobolSequence sequence(3);
+    for (size_t event = 0; event < 5; ++event) {
+      generator.nextEvent();
+      const auto &point = sequence.nextPoint();
+      // The event may stop before it has used all of its point
+      for (size_t i = 0; i < 2; ++i) {
+        TS_ASSERT_EQUALS(point[i], generator.nextValue());
+      }
+    }
+  }
+
+  void test_Values_Beyond_Sequence_Are_Pseudo_Random() {
+    const size_t seed(5);
+    MCQuasiRandomGenerator generator(2, seed);
+    Mantid::Kernel::MersenneTwister padding(seed);
+    // Without an event all values are pseudo-random
+    TS_ASSERT_EQUALS(padding.nextValue(), generator.nextValue());
+    generator.nextEvent();
+    generator.nextValue();
+    generator.nextValue();
+    TS_ASSERT_EQUALS(padding.nextValue(), generator.nextValue());
+    TS_ASSERT_EQUALS(padding.nextValue(), generator.nextValue());
+  }
+
+  void test_Values_Are_Scaled_To_Range() {
+    MCQuasiRandomGenerator generator(4, 1);
+    Mantid::Kernel::SobolSequence sequence(4);
+    const auto point = sequence.nextPoint();
+    generator.nextEvent();
+    generator.setRange(2.0, 4.0);
+    TS_ASSERT_EQUALS(2.0, generator.min());
+    TS_ASSERT_EQUALS(4.0, generator.max());
+    TS_ASSERT_DELTA(2.0 + 2.0 * point[0], generator.nextValue(), 1e-12);
+    TS_ASSERT_DELTA(-1.0 + 2.0 * point[1], generator.nextValue(-1.0, 1.0),
+                    1e-12);
+  }
+
+  void test_nextInt_Covers_Whole_Range() {
+    MCQuasiRandomGenerator generator(1, 1);
+    std::vector<int> counts(4, 0);
+    for (size_t event = 0; event < 64; ++event) {
+      generator.nextEvent();
+      const int value = generator.nextInt(1, 4);
+      TS_ASSERT(value >= 1 && value <= 4);
+      ++counts[value - 1];
+    }
+    // The first 64 points of the sequence divide evenly between the values
+    for (const auto count : counts) {
+      TS_ASSERT_EQUALS(16, count);
+    }
+  }
+
+  void test_Restore_Returns_To_Saved_State() {
+    MCQuasiRandomGenerator generator(3, 1);
+    generator.nextEvent();
+    generator.nextValue();
+    generator.save();
+    std::vector<double> expected;
+    for (size_t i = 0; i < 5; ++i) {
+      expected.emplace_back(generator.nextValue());
+    }
+    generator.nextEvent();
+    expected.emplace_back(generator.nextValue());
+
+    generator.restore();
+    std::vector<double> restored;
+    for (size_t i = 0; i < 5; ++i) {
+      restored.emplace_back(generator.nextValue());
+    }
+    generator.nextEvent();
+    restored.emplace_back(generator.nextValue());
+    TS_ASSERT_EQUALS(expected, restored);
+  }
+
+  void test_Restart_Returns_To_First_Point() {
+    MCQuasiRandomGenerator generator(2, 1);
+    generator.nextEvent();
+    const double first = generator.nextValue();
+    generator.nextEvent();
+    generator.restart();
+    generator.nextEvent();
+    TS_ASSERT_EQUALS(first, generator.nextValue());
+  }
+};
+
+#endif /* MANTID_ALGORITHMS_MCQUASIRANDOMGENERATORTEST_H_ */
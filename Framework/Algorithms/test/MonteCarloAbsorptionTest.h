@@ -223,9 +223,88 @@ public:
     TS_ASSERT_DELTA(0.1168965453, outputWS->y(0).back(), delta);
   }
 
+  void test_Tracks_Reused_For_All_Wavelengths() {
+    using Mantid::Kernel::DeltaEMode;
+    TestWorkspaceDescriptor wsProps = {
+        5, 10, Environment::SampleOnly, DeltaEMode::Elastic, -1, -1};
+    auto mcabs = createAlgorithm();
+    TS_ASSERT_THROWS_NOTHING(
+        mcabs->setProperty("InputWorkspace", setUpWS(wsProps)));
+    mcabs->setProperty("ResimulateTracksForDifferentWavelengths", false);
+    mcabs->execute();
+    auto outputWS = getOutputWorkspace(mcabs);
+
+    verifyDimensions(wsProps, outputWS);
+    // The first point uses the same events as when the tracks are
+    // resimulated
+    TS_ASSERT_DELTA(0.6245262704, outputWS->y(0).front(), 1e-05);
+    const size_t middle_index(4);
+    const auto &y = outputWS->y(0);
+    const auto &e = outputWS->e(0);
+    for (size_t i = 0; i < y.size(); ++i) {
+      TS_ASSERT_LESS_THAN(0.0, e[i]);
+      TS_ASSERT_LESS_THAN(e[i], 0.2 * y[i]);
+    }
+    TS_ASSERT_DELTA(0.2770105008, y[middle_index], 5 * e[middle_index]);
+    TS_ASSERT_DELTA(0.1041517761, y.back(), 5 * e.back());
+  }
+
+  void test_Relative_Error_Tolerance_Limits_Errors() {
+    using Mantid::Kernel::DeltaEMode;
+    TestWorkspaceDescriptor wsProps = {
+        5, 10, Environment::SampleOnly, DeltaEMode::Elastic, -1, -1};
+    auto mcabs = createAlgorithm();
+    TS_ASSERT_THROWS_NOTHING(
+        mcabs->setProperty("InputWorkspace", setUpWS(wsProps)));
+    mcabs->setProperty("ResimulateTracksForDifferentWavelengths", false);
+    mcabs->setProperty("EventsPerPoint", 100000);
+    mcabs->setProperty("RelativeErrorTolerance", 0.02);
+    mcabs->execute();
+    auto outputWS = getOutputWorkspace(mcabs);
+
+    const auto &y = outputWS->y(0);
+    const auto &e = outputWS->e(0);
+    for (size_t i = 0; i < y.size(); ++i) {
+      TS_ASSERT_LESS_THAN_EQUALS(e[i], 0.02 * y[i]);
+    }
+  }
+
+  void test_Sobol_Sequence_Agrees_With_Pseudo_Random_Events() {
+    using Mantid::Kernel::DeltaEMode;
+    TestWorkspaceDescriptor wsProps = {
+        5, 10, Environment::SampleOnly, DeltaEMode::Elastic, -1, -1};
+    auto mcabs = createAlgorithm();
+    TS_ASSERT_THROWS_NOTHING(
+        mcabs->setProperty("InputWorkspace", setUpWS(wsProps)));
+    mcabs->setProperty("ResimulateTracksForDifferentWavelengths", false);
+    TS_ASSERT_THROWS_NOTHING(
+        mcabs->setProperty("RandomNumberSequence", "Sobol"));
+    mcabs->execute();
+    auto outputWS = getOutputWorkspace(mcabs);
+
+    verifyDimensions(wsProps, outputWS);
+    const size_t middle_index(4);
+    const auto &y = outputWS->y(0);
+    const auto &e = outputWS->e(0);
+    TS_ASSERT_DELTA(0.6245262704, y.front(), 5 * e.front());
+    TS_ASSERT_DELTA(0.2770105008, y[middle_index], 5 * e[middle_index]);
+    TS_ASSERT_DELTA(0.1041517761, y.back(), 5 * e.back());
+  }
+
   //---------------------------------------------------------------------------
   // Failure cases
   //---------------------------------------------------------------------------
+
+  void test_Relative_Error_Tolerance_Needs_Reused_Tracks() {
+    using Mantid::Kernel::DeltaEMode;
+    TestWorkspaceDescriptor wsProps = {
+        5, 10, Environment::SampleOnly, DeltaEMode::Elastic, -1, -1};
+    auto mcabs = createAlgorithm();
+    TS_ASSERT_THROWS_NOTHING(
+        mcabs->setProperty("InputWorkspace", setUpWS(wsProps)));
+    mcabs->setProperty("RelativeErrorTolerance", 0.01);
+    TS_ASSERT_THROWS(mcabs->execute(), std::runtime_error);
+  }
   void test_Workspace_With_No_Instrument_Is_Not_Accepted() {
     using namespace Mantid::API;
 
@@ -68,56 +68,9 @@ public:
     TS_ASSERT(!algorithm.isExecuted())
   }
 
-  void test_ComplexRun() {
-    // Data flow: input3->id3->id2->id1->output1; input3->id3->id5->output5;
-    // input4->id4->output4
-    auto setupTable = createSetupTableForScale();
-    setupTable->setRowCount(5);
-    setupTable->getRef<std::string>("Id", 0) = "id1";
-    setupTable->getRef<std::string>("InputWorkspace", 0) = "id2";
-    setupTable->getRef<std::string>("OutputWorkspace", 0) = "\"output1\"";
-    const double scaling1 = 2.79;
-    setupTable->getRef<double>("Factor", 0) = scaling1;
-    setupTable->getRef<std::string>("Id", 1) = "id2";
-    setupTable->getRef<std::string>("InputWorkspace", 1) = "id3";
-    setupTable->getRef<std::string>("OutputWorkspace", 1) = "output2";
-    const double scaling2 = -72.5;
-    setupTable->getRef<double>("Factor", 1) = scaling2;
-    setupTable->getRef<std::string>("Id", 2) = "id3";
-    setupTable->getRef<std::string>("InputWorkspace", 2) = "\"input3\"";
-    setupTable->getRef<std::string>("OutputWorkspace", 2) = "output3";
-    const double scaling3 = 0.23;
-    setupTable->getRef<double>("Factor", 2) = scaling3;
-    setupTable->getRef<std::string>("Id", 3) = "id4";
-    setupTable->getRef<std::string>("InputWorkspace", 3) = "\"input4\"";
-    setupTable->getRef<std::string>("OutputWorkspace", 3) = "\"output4\"";
-    const double scaling4 = 4.01;
-    setupTable->getRef<double>("Factor", 3) = scaling4;
-    setupTable->getRef<std::string>("Id", 4) = "id5";
-    setupTable->getRef<std::string>("InputWorkspace", 4) = "id3";
-    setupTable->getRef<std::string>("OutputWorkspace", 4) = "\"output5\"";
-    const double scaling5 = -5.54;
-    setupTable->getRef<double>("Factor", 4) = scaling5;
-    auto inputWs3 = createTestWorkspace("input3");
-    auto inputWs4 = createTestWorkspace("input4");
-    WorkflowAlgorithmRunner algorithm;
-    algorithm.setRethrows(true);
-    TS_ASSERT_THROWS_NOTHING(algorithm.initialize())
-    TS_ASSERT(algorithm.isInitialized())
-    TS_ASSERT_THROWS_NOTHING(algorithm.setProperty("Algorithm", "Scale"))
-    TS_ASSERT_THROWS_NOTHING(algorithm.setProperty("SetupTable", setupTable))
-    TS_ASSERT_THROWS_NOTHING(
-        algorithm.setProperty("InputOutputMap", m_ioMapForScale))
-    TS_ASSERT_THROWS_NOTHING(algorithm.execute())
-    TS_ASSERT(algorithm.isExecuted())
-    assertOutputWorkspace("output1", scaling3 * scaling2 * scaling1);
-    assertOutputWorkspace("output2", scaling3 * scaling2);
-    assertOutputWorkspace("output3", scaling3);
-    assertOutputWorkspace("output4", scaling4);
-    assertOutputWorkspace("output5", scaling3 * scaling5);
-    deleteWorkspace(inputWs3);
-    deleteWorkspace(inputWs4);
-  }
+  void test_ComplexRun() { complexRun(false); }
+
+  void test_ComplexRunConcurrently() { complexRun(true); }
 
   void test_ForcedOutputAsInput() {
     // Data flow: input->spider2->output2; input->spider2->mantid1->output1
@@ -217,6 +170,59 @@ public:
   }
 
 private:
+  void complexRun(const bool runConcurrently) {
+    // Data flow: input3->id3->id2->id1->output1; input3->id3->id5->output5;
+    // input4->id4->output4
+    auto setupTable = createSetupTableForScale();
+    setupTable->setRowCount(5);
+    setupTable->getRef<std::string>("Id", 0) = "id1";
+    setupTable->getRef<std::string>("InputWorkspace", 0) = "id2";
+    setupTable->getRef<std::string>("OutputWorkspace", 0) = "\"output1\"";
+    const double scaling1 = 2.79;
+    setupTable->getRef<double>("Factor", 0) = scaling1;
+    setupTable->getRef<std::string>("Id", 1) = "id2";
+    setupTable->getRef<std::string>("InputWorkspace", 1) = "id3";
+    setupTable->getRef<std::string>("OutputWorkspace", 1) = "output2";
+    const double scaling2 = -72.5;
+    setupTable->getRef<double>("Factor", 1) = scaling2;
+    setupTable->getRef<std::string>("Id", 2) = "id3";
+    setupTable->getRef<std::string>("InputWorkspace", 2) = "\"input3\"";
+    setupTable->getRef<std::string>("OutputWorkspace", 2) = "output3";
+    const double scaling3 = 0.23;
+    setupTable->getRef<double>("Factor", 2) = scaling3;
+    setupTable->getRef<std::string>("Id", 3) = "id4";
+    setupTable->getRef<std::string>("InputWorkspace", 3) = "\"input4\"";
+    setupTable->getRef<std::string>("OutputWorkspace", 3) = "\"output4\"";
+    const double scaling4 = 4.01;
+    setupTable->getRef<double>("Factor", 3) = scaling4;
+    setupTable->getRef<std::string>("Id", 4) = "id5";
+    setupTable->getRef<std::string>("InputWorkspace", 4) = "id3";
+    setupTable->getRef<std::string>("OutputWorkspace", 4) = "\"output5\"";
+    const double scaling5 = -5.54;
+    setupTable->getRef<double>("Factor", 4) = scaling5;
+    auto inputWs3 = createTestWorkspace("input3");
+    auto inputWs4 = createTestWorkspace("input4");
+    WorkflowAlgorithmRunner algorithm;
+    algorithm.setRethrows(true);
+    TS_ASSERT_THROWS_NOTHING(algorithm.initialize())
+    TS_ASSERT(algorithm.isInitialized())
+    TS_ASSERT_THROWS_NOTHING(algorithm.setProperty("Algorithm", "Scale"))
+    TS_ASSERT_THROWS_NOTHING(algorithm.setProperty("SetupTable", setupTable))
+    TS_ASSERT_THROWS_NOTHING(
+        algorithm.setProperty("InputOutputMap", m_ioMapForScale))
+    TS_ASSERT_THROWS_NOTHING(
+        algorithm.setProperty("RunConcurrently", runConcurrently))
+    TS_ASSERT_THROWS_NOTHING(algorithm.execute())
+    TS_ASSERT(algorithm.isExecuted())
+    assertOutputWorkspace("output1", scaling3 * scaling2 * scaling1);
+    assertOutputWorkspace("output2", scaling3 * scaling2);
+    assertOutputWorkspace("output3", scaling3);
+    assertOutputWorkspace("output4", scaling4);
+    assertOutputWorkspace("output5", scaling3 * scaling5);
+    deleteWorkspace(inputWs3);
+    deleteWorkspace(inputWs4);
+  }
+
   ITableWorkspace_sptr m_ioMapForScale;
 
   static void assertOutputWorkspace(const std::string &name,
@@ -75,6 +75,11 @@ private:
                                 const Kernel::DblMatrix &orientedUB,
                                 const Kernel::DblMatrix &goniometerMatrix);
 
+  void
+  addPeakToOutput(const Kernel::V3D &hkl, const Kernel::V3D &q,
+                  const API::DetectorSearcher::DetectorSearchResult &result,
+                  const Kernel::DblMatrix &goniometerMatrix);
+
 private:
   /// Get the predicted detector direction from Q
   std::tuple<Kernel::V3D, double>
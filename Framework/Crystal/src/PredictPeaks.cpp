@@ -358,13 +358,21 @@ void PredictPeaks::exec() {
                            "no extended detector space has been defined\n";
       }
 
+      // Search for the detectors of all the allowed peaks at once
+      std::vector<V3D> allowedHKLs, qs;
       for (auto &possibleHKL : possibleHKLs) {
         if (lambdaFilter.isAllowed(possibleHKL)) {
-          calculateQAndAddToOutput(possibleHKL, orientedUB, goniometerMatrix);
+          allowedHKLs.push_back(possibleHKL);
+          qs.push_back(orientedUB * possibleHKL *
+                       (2.0 * M_PI * m_qConventionFactor));
           ++allowedPeakCount;
         }
         prog.report();
       }
+      const auto results = m_detectorCacheSearch->findDetectorIndices(qs);
+      for (size_t i = 0; i < allowedHKLs.size(); ++i) {
+        addPeakToOutput(allowedHKLs[i], qs[i], results[i], goniometerMatrix);
+      }
 
       logNumberOfPeaksFound(allowedPeakCount);
     }
@@ -571,13 +579,29 @@ void PredictPeaks::calculateQAndAddToOutput(const V3D &hkl,
   // This is in inelastic convention: momentum transfer of the LATTICE!
   // Also, q does have a 2pi factor = it is equal to 2pi/wavelength.
   const auto q = orientedUB * hkl * (2.0 * M_PI * m_qConventionFactor);
+  addPeakToOutput(hkl, q, m_detectorCacheSearch->findDetectorIndex(q),
+                  goniometerMatrix);
+}
+
+/**
+ * Add the peak of an HKL to the output workspace if its diffracted beam hits a
+ * detector, or the extended detector space when that is requested.
+ *
+ * @param hkl :: the HKL of the peak
+ * @param q :: the Qlab vector of the peak
+ * @param result :: the detector found for q by the detector searcher
+ * @param goniometerMatrix :: the goniometer rotation of the peak
+ */
+void PredictPeaks::addPeakToOutput(
+    const V3D &hkl, const V3D &q,
+    const DetectorSearcher::DetectorSearchResult &result,
+    const DblMatrix &goniometerMatrix) {
   const auto params = getPeakParametersFromQ(q);
   const auto detectorDir = std::get<0>(params);
   const auto wl = std::get<1>(params);
 
   const bool useExtendedDetectorSpace =
       getProperty("PredictPeaksOutsideDetectors");
-  const auto result = m_detectorCacheSearch->findDetectorIndex(q);
   const auto hitDetector = std::get<0>(result);
   const auto index = std::get<1>(result);
 
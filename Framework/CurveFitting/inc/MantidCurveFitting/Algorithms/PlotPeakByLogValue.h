@@ -63,6 +63,17 @@ class DLLExport PlotPeakByLogValue : public API::Algorithm {
     std::vector<int> indx; ///< a list of ws indices to fit if i and spec < 0
   };
 
+  /** Structure to identify a single fit
+   */
+  struct FitJob {
+    /// Constructor
+    FitJob(size_t in, int ix, double value)
+        : input(in), wsIndex(ix), logValue(value) {}
+    size_t input;    ///< Index of the InputData of the spectrum
+    int wsIndex;     ///< Workspace index of the spectrum to fit
+    double logValue; ///< The value to plot the parameters against
+  };
+
 public:
   /// Algorithm's name for identification overriding a virtual method
   const std::string name() const override { return "PlotPeakByLogValue"; }
@@ -0,0 +1,69 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_CURVEFITTING_BLOCKARROWSOLVER_H_
+#define MANTID_CURVEFITTING_BLOCKARROWSOLVER_H_
+
+#include "MantidCurveFitting/DllConfig.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace API {
+class IFunction;
+}
+namespace CurveFitting {
+class GSLMatrix;
+class GSLVector;
+
+/** BlockArrowSolver solves the linear systems of a simultaneous fit of a
+  MultiDomainFunction by making use of the structure of its Hessian.
+
+  An active parameter that only the values on a single domain depend on,
+  directly or through ties, is local to that domain: it only couples to the
+  other local parameters of the domain and to the global parameters, which
+  several domains depend on. The Hessian then has a block-arrow form, with a
+  diagonal block B_d for the local parameters of each domain bordered by the
+  rows and columns C_d of the global parameters. The local parameters are
+  eliminated block by block, the Schur complement
+  S = G - sum_d C_d^T B_d^-1 C_d is solved for the global parameters and the
+  local ones are found by back substitution. The cost grows linearly with
+  the number of domains instead of with the cube of the number of
+  parameters.
+*/
+class MANTID_CURVEFITTING_DLL BlockArrowSolver {
+public:
+  BlockArrowSolver() = default;
+  explicit BlockArrowSolver(const API::IFunction &function);
+  BlockArrowSolver(std::vector<std::vector<size_t>> localBlocks,
+                   std::vector<size_t> global);
+
+  /// True if there are at least two blocks of local parameters
+  bool hasBlocks() const { return m_localBlocks.size() > 1; }
+  /// The active indices of the local parameters of each domain
+  const std::vector<std::vector<size_t>> &localBlocks() const {
+    return m_localBlocks;
+  }
+  /// The active indices of the global parameters
+  const std::vector<size_t> &global() const { return m_global; }
+
+  bool hasStructureOf(const GSLMatrix &matrix) const;
+  bool solve(const GSLMatrix &matrix, const GSLVector &rhs,
+             GSLVector &x) const;
+
+private:
+  /// The active indices of the local parameters of each domain
+  std::vector<std::vector<size_t>> m_localBlocks;
+  /// The active indices of the global parameters
+  std::vector<size_t> m_global;
+  /// The number of active parameters
+  size_t m_nActive = 0;
+};
+
+} // namespace CurveFitting
+} // namespace Mantid
+
+#endif /* MANTID_CURVEFITTING_BLOCKARROWSOLVER_H_ */
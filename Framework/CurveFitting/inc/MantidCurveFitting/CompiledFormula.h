@@ -0,0 +1,110 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_CURVEFITTING_COMPILEDFORMULA_H_
+#define MANTID_CURVEFITTING_COMPILEDFORMULA_H_
+
+#include "MantidCurveFitting/DllConfig.h"
+
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+class Jacobian;
+}
+namespace CurveFitting {
+
+/** CompiledFormula compiles a formula of a variable x and named parameters
+  into a program that evaluates it over many values of x at once.
+
+  Each instruction of the program works on arrays holding a block of points,
+  so that evaluating the formula is a sequence of simple loops. The
+  derivatives with respect to the parameters are calculated exactly by
+  forward-mode automatic differentiation in a single pass: every instruction
+  also carries the derivatives of its value with respect to the parameters it
+  depends on.
+
+  The formulas use the syntax of muParser: the operators + - * / ^ and
+  brackets, numbers, the constants _pi and _e and the functions sin, cos,
+  tan, asin, acos, atan, sinh, cosh, tanh, exp, log, ln, log10, log2, sqrt,
+  abs, sign, erf and erfc. The constructor throws std::invalid_argument for
+  anything else, e.g. comparisons, so that the caller can use muParser
+  instead.
+*/
+class MANTID_CURVEFITTING_DLL CompiledFormula {
+public:
+  CompiledFormula(const std::string &formula,
+                  const std::vector<std::string> &parameters);
+
+  void evaluate(const double *x, size_t n, const double *parameters,
+                double *out) const;
+  void derivatives(const double *x, size_t n, const double *parameters,
+                   API::Jacobian &jacobian) const;
+
+  /// The number of instructions in the program
+  size_t size() const { return m_program.size(); }
+
+private:
+  enum class OpCode {
+    Constant,
+    X,
+    Parameter,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Power,
+    Negate,
+    Sin,
+    Cos,
+    Tan,
+    Asin,
+    Acos,
+    Atan,
+    Sinh,
+    Cosh,
+    Tanh,
+    Exp,
+    Log,
+    Log10,
+    Log2,
+    Sqrt,
+    Abs,
+    Sign,
+    Erf,
+    Erfc
+  };
+  /// An instruction works on the results of the instructions a and b
+  struct Instruction {
+    OpCode op;
+    size_t a;
+    size_t b;
+    /// The value of a constant or the index of a parameter
+    double value;
+  };
+  class Parser;
+
+  size_t add(OpCode op, size_t a, size_t b = 0, double value = 0.);
+  static void apply(OpCode op, const double *a, const double *b, size_t n,
+                    double *r);
+  void initialize(const double *parameters,
+                  std::vector<double> &registers) const;
+  void run(const double *x, size_t n, std::vector<double> &registers) const;
+  bool dependsOn(size_t i, size_t parameter) const;
+
+  /// The instructions in the order of execution
+  std::vector<Instruction> m_program;
+  /// The sorted indices of the parameters each instruction depends on
+  std::vector<std::vector<size_t>> m_dependencies;
+  /// The number of parameters
+  size_t m_nParams;
+};
+
+} // namespace CurveFitting
+} // namespace Mantid
+
+#endif /* MANTID_CURVEFITTING_COMPILEDFORMULA_H_ */
@@ -15,6 +15,10 @@
 #include "MantidCurveFitting/GSLVector.h"
 
 namespace Mantid {
+namespace API {
+class CompositeDomain;
+class MultiDomainFunction;
+} // namespace API
 namespace CurveFitting {
 class SeqDomain;
 class ParDomain;
@@ -66,6 +70,12 @@ protected:
                           API::FunctionDomain_sptr domain,
                           API::FunctionValues_sptr values,
                           bool evalDeriv = true, bool evalHessian = true) const;
+  void addValDerivHessianByDomain(API::MultiDomainFunction &function,
+                                  const API::CompositeDomain &domain,
+                                  API::FunctionValues_sptr values,
+                                  bool evalHessian) const;
+  void addToTotals(const GSLVector &der, const GSLMatrix &hessian,
+                   const std::vector<size_t> &indices, bool evalHessian) const;
 
   /// Get mapped weights from FunctionValues
   virtual std::vector<double>
@@ -13,6 +13,8 @@
 #include "MantidCurveFitting/GSLVector.h"
 #include "MantidKernel/System.h"
 
+#include <random>
+
 namespace Mantid {
 namespace CurveFitting {
 namespace CostFunctions {
@@ -29,6 +31,12 @@ namespace FuncMinimisers {
 /** FABADA : Implements the FABADA Algorithm, based on a Adaptive Metropolis
   Algorithm extended with Gibbs Sampling. Designed to obtain the Bayesian
   posterior PDFs
+
+  With NumberOfChains > 1 the minimizer runs other chains concurrently, each
+  one a FABADAMinimizer of its own fitting a clone of the function. The
+  chains are either independent, sharing the chain length and merged in the
+  outputs, or form a ladder of temperatures exchanging their states with
+  this chain (parallel tempering).
 */
 class DLLExport FABADAMinimizer : public API::IFuncMinimizer {
 public:
@@ -54,6 +62,22 @@ public:
                         double &step);
 
 private:
+  /// Do one iteration of FABADA's algorithm for each parameter
+  void step();
+  /// Do one iteration of every chain
+  bool iterateChains();
+  /// Create the chains run together with this one
+  void initOtherChains(size_t nChains);
+  /// Propose exchanges of states along the temperature ladder
+  void exchangeStates();
+  /// Check the convergence of independent chains with R-hat
+  void checkChainsConvergence();
+  /// Mark the chain as converged and start its converged part
+  void setConverged();
+  /// Append the converged parts of the other chains to this chain
+  void mergeChains();
+  /// Set the parameters of the fitting function to the current position
+  void setFunctionParameters();
   /// Returns the step from a Gaussian given sigma = Jump
   double gaussianStep(const double &jump);
   /// Applied to the other parameters first and sequentially, finally to the
@@ -64,6 +88,8 @@ private:
   /// m_changes[ParameterIndex] updated too
   void algorithmDisplacement(const size_t &parameterIndex,
                              const double &chi2New, GSLVector &newParameters);
+  /// Append a position to the chain if it is recorded
+  void appendToChain(const GSLVector &parameters, const double chi2);
   /// Updates the ParameterIndex-th parameter jump if appropriate
   void jumpUpdate(const size_t &parameterIndex);
   /// Check for convergence (including Overexploration convergence), updates
@@ -163,6 +189,24 @@ private:
   std::vector<size_t> m_numInactiveRegenerations;
   /// To track convergence through immobility
   std::vector<int> m_changesOld;
+  /// The random number generator of the chain
+  std::mt19937 m_randomGenerator;
+  /// The index of the chain among the chains run together
+  size_t m_chainIndex;
+  /// The number of converged points of this chain
+  size_t m_chainLength;
+  /// The temperature of the chain once Simulated Annealing is over
+  double m_baseTemperature;
+  /// The length of the chain when Simulated Annealing finished
+  size_t m_annealedLength;
+  /// The chains run together with this one
+  std::vector<boost::shared_ptr<FABADAMinimizer>> m_otherChains;
+  /// Whether each chain, this one first, needs more iterations
+  std::vector<bool> m_running;
+  /// Whether the other chains are hotter replicas of this one
+  bool m_tempering;
+  /// Whether the positions of the chain are kept for the outputs
+  bool m_recordChain;
 };
 
 /// Used to access the setDirty() protected member
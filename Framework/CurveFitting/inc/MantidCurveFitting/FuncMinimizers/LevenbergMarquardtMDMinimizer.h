@@ -11,6 +11,7 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidAPI/IFuncMinimizer.h"
+#include "MantidCurveFitting/BlockArrowSolver.h"
 #include "MantidCurveFitting/GSLMatrix.h"
 #include "MantidCurveFitting/GSLVector.h"
 
@@ -23,7 +24,9 @@ class CostFuncLeastSquares;
 namespace FuncMinimisers {
 /** Implementing Levenberg-Marquardt algorithm. Uses the normal system calculate
     the corrections to the parameters. Expects a cost function that can evaluate
-    the value, the derivatives and the hessian matrix.
+    the value, the derivatives and the hessian matrix. The normal system of a
+    simultaneous fit of a MultiDomainFunction is solved block by block with
+    a BlockArrowSolver.
 
     @author Roman Tolchenov, Tessella plc
 */
@@ -56,6 +59,8 @@ private:
   /// To keep function value
   double m_F;
   std::vector<double> m_D;
+  /// Solves the normal system of a MultiDomainFunction block by block
+  BlockArrowSolver m_blocks;
 };
 
 } // namespace FuncMinimisers
@@ -57,6 +57,8 @@ public:
   const std::string category() const override { return "Peak"; }
   void function1D(double *out, const double *xValues,
                   const size_t nData) const override;
+  void function1DAdd(double *out, const double *xValues,
+                     const size_t nData) const override;
   void functionDeriv1D(API::Jacobian *jacobian, const double *xValues,
                        const size_t nData) override;
 
@@ -69,6 +71,8 @@ protected:
   void functionDerivLocal(API::Jacobian *, const double *,
                           const size_t) override {}
   double expWidth() const;
+  double extent() const;
+  double localExtent() const override { return extent(); }
 };
 
 using BackToBackExponential_sptr = boost::shared_ptr<BackToBackExponential>;
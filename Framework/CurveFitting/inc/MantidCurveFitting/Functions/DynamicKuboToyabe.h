@@ -13,11 +13,15 @@
 #include "MantidAPI/IFunctionMW.h"
 #include "MantidAPI/IFunctionWithLocation.h"
 #include "MantidAPI/IPeakFunction.h"
+#include <boost/shared_ptr.hpp>
 #include <cmath>
+#include <vector>
 
 namespace Mantid {
 namespace CurveFitting {
 namespace Functions {
+class StaticKuboToyabeTable;
+
 /**
  Provide Dynamic Kubo Toyabe function interface to IFunction1D for muon
  scientists.
@@ -62,12 +66,19 @@ protected:
   void setActiveParameter(size_t i, double value) override;
 
 private:
-  // Evaluate DKT function for a given t, G, F, v and eps
-  double getDKT(double t, double G, double F, double v, double eps) const;
+  struct Cache;
+  // The static relaxation in a field stronger than 2 * G, or null
+  boost::shared_ptr<const StaticKuboToyabeTable>
+  fieldTable(double G, double F, double maxTau) const;
+  // The dynamic relaxation at the first n multiples of the bin width
+  boost::shared_ptr<const std::vector<double>>
+  dynamicTable(double G, double F, double v, size_t n) const;
 
   /// Bin width
   double m_eps;
   double m_minEps, m_maxEps;
+  /// The tables of the last evaluation
+  boost::shared_ptr<Cache> m_cache;
 };
 
 } // namespace Functions
@@ -34,6 +34,10 @@ public:
   std::string name() const override { return "LinearBackground"; }
   void function1D(double *out, const double *xValues,
                   const size_t nData) const override;
+  void functionAdd(const API::FunctionDomain &domain,
+                   API::FunctionValues &values) const override;
+  void function1DAdd(double *out, const double *xValues,
+                     const size_t nData) const override;
   void functionDeriv1D(API::Jacobian *out, const double *xValues,
                        const size_t nData) override;
 
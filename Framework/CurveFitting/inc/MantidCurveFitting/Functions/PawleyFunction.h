@@ -115,11 +115,8 @@ public:
   void function(const API::FunctionDomain &domain,
                 API::FunctionValues &values) const override;
 
-  /// Derivates are calculated numerically.
   void functionDeriv(const API::FunctionDomain &domain,
-                     API::Jacobian &jacobian) override {
-    calNumericalDeriv(domain, jacobian);
-  }
+                     API::Jacobian &jacobian) override;
 
   void setPeaks(const std::vector<Kernel::V3D> &hkls, double fwhm,
                 double height) override;
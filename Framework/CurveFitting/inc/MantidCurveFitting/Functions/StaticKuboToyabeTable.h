@@ -0,0 +1,60 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_CURVEFITTING_STATICKUBOTOYABETABLE_H_
+#define MANTID_CURVEFITTING_STATICKUBOTOYABETABLE_H_
+
+#include "MantidCurveFitting/DllConfig.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace CurveFitting {
+namespace Functions {
+
+/** StaticKuboToyabeTable tabulates the static Gaussian Kubo-Toyabe
+  relaxation in a longitudinal field
+
+  P(t) = 1 - 2r(1 - exp(-D^2 t^2 / 2) cos(wt))
+           + 2r^2 w Integral_0^t exp(-D^2 x^2 / 2) sin(wx) dx,   r = D^2 / w^2
+
+  As a function of the reduced time tau = D t it is a master curve that only
+  depends on b = w / D. The integral, which has no closed form, is tabulated
+  once over tau on a grid chosen so that cubic Hermite interpolation, using
+  the exact integrand as the derivative, keeps the error of P(t) below a
+  tolerance. The integrand is negligible beyond tau = 10, where the integral
+  stays constant. As before, the integral is 0 for tau <= 0.
+
+  A table is immutable once built, so it can be shared between threads.
+*/
+class MANTID_CURVEFITTING_DLL StaticKuboToyabeTable {
+public:
+  StaticKuboToyabeTable(double b, double maxTau, double tolerance = 1e-10);
+  /// The relaxation at the reduced time tau (at most maxTau)
+  double operator()(double tau) const;
+  /// The integral of exp(-u^2 / 2) sin(b u) from 0 to tau (at most maxTau)
+  double integral(double tau) const;
+  /// The ratio of the Larmor frequency to the field distribution width
+  double b() const { return m_b; }
+  /// The number of tabulated points
+  size_t size() const { return m_integral.size(); }
+
+private:
+  /// The ratio w / D
+  double m_b;
+  /// The step in tau between the tabulated points
+  double m_step;
+  /// The integral at the tabulated points
+  std::vector<double> m_integral;
+  /// The integrand, i.e. the derivative of the integral, at the points
+  std::vector<double> m_integrand;
+};
+
+} // namespace Functions
+} // namespace CurveFitting
+} // namespace Mantid
+
+#endif /* MANTID_CURVEFITTING_STATICKUBOTOYABETABLE_H_ */
@@ -82,7 +82,8 @@ public:
   /// Get peak's height
   // virtual double height()const;
 
-  using IFunction1D::function;
+  void function(const API::FunctionDomain &domain,
+                API::FunctionValues &values) const override;
   void function(std::vector<double> &out,
                 const std::vector<double> &xValues) const override;
 
@@ -101,6 +102,9 @@ private:
   /// Derivative
   void functionDeriv(const API::FunctionDomain &domain,
                      API::Jacobian &jacobian) override;
+  /// The indices [first, last) of the points within the peak radius
+  std::pair<size_t, size_t>
+  getLocalRange(const API::FunctionDomain1D &domain) const;
 
   /// Overwrite IFunction base class method, which declare function parameters
   void init() override;
@@ -14,16 +14,24 @@
 #include "MantidAPI/ParamFunction.h"
 #include <boost/shared_array.hpp>
 
+#include <memory>
+
 namespace mu {
 class Parser;
 }
 
 namespace Mantid {
 namespace CurveFitting {
+class CompiledFormula;
+
 namespace Functions {
 /**
 A user defined function.
 
+Formulas that CompiledFormula supports are evaluated by a compiled program
+with exact derivatives. Any other formula is evaluated by muParser and
+differentiated numerically.
+
 @author Roman Tolchenov, Tessella plc
 @date 15/01/2010
 */
@@ -46,6 +54,9 @@ public:
   /// Derivatives of function with respect to active parameters
   void functionDeriv(const API::FunctionDomain &domain,
                      API::Jacobian &jacobian) override;
+  /// Exact derivatives of a compiled formula
+  void functionDeriv1D(API::Jacobian *out, const double *xValues,
+                       const size_t nData) override;
 
   /// Returns the number of attributes associated with the function
   size_t nAttributes() const override { return 1; }
@@ -79,6 +90,9 @@ private:
   /// Temporary data storage used in functionDeriv
   mutable boost::shared_array<double> m_tmp1;
 
+  /// The compiled formula, if the formula can be compiled
+  std::unique_ptr<CompiledFormula> m_compiled;
+
   /// mu::Parser callback function for setting variables.
   static double *AddVariable(const char *varName, void *pufun);
 };
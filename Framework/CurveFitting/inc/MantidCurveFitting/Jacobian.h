@@ -73,6 +73,14 @@ public:
   }
   /// overwrite base method
   void zero() override { m_data.assign(m_data.size(), 0.0); }
+  /// Get a pointer to the derivatives at a data point
+  /// @param iY :: The index of the data point
+  const double *getRowPointer(size_t iY) const {
+    if (iY >= m_ny) {
+      throw std::out_of_range("Data index in Jacobian is out of range");
+    }
+    return &m_data[iY * m_np];
+  }
 };
 
 } // namespace CurveFitting
@@ -114,15 +114,10 @@ LeBailFunction::function(const Mantid::HistogramData::HistogramX &xvalues,
   std::vector<double> out(xvalues.size(), 0);
   const auto &xvals = xvalues.rawData();
 
-  // Peaks
+  // Peaks: each one is added to the output within its own range
   if (calpeaks) {
     for (size_t ipk = 0; ipk < m_numPeaks; ++ipk) {
-      // Reset temporary vector for output
-      vector<double> temp(xvalues.size(), 0);
-      IPowderDiffPeakFunction_sptr peak = m_vecPeaks[ipk];
-      peak->function(temp, xvals);
-      transform(out.begin(), out.end(), temp.begin(), out.begin(),
-                ::plus<double>());
+      m_vecPeaks[ipk]->function(out, xvals);
     }
   }
 
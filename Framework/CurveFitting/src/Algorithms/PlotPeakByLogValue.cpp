@@ -33,6 +33,7 @@
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 
 namespace {
@@ -162,6 +163,12 @@ void PlotPeakByLogValue::init() {
 
   declareProperty("IgnoreInvalidData", false,
                   "Flag to ignore infinities, NaNs and data with zero errors.");
+
+  declareProperty("Parallel", false,
+                  "Fit blocks of neighbouring spectra in parallel.\n"
+                  "With the Sequential FitType each block starts from the "
+                  "initial values, so the results can differ slightly from a "
+                  "serial run.");
 }
 
 /**
@@ -220,14 +227,12 @@ void PlotPeakByLogValue::exec() {
 
   setProperty("OutputWorkspace", result);
 
-  std::vector<MatrixWorkspace_sptr> fitWorkspaces;
-  std::vector<ITableWorkspace_sptr> parameterWorkspaces;
-  std::vector<ITableWorkspace_sptr> covarianceWorkspaces;
-
-  double dProg = 1. / static_cast<double>(wsNames.size());
-  double Prog = 0.;
-  for (int i = 0; i < static_cast<int>(wsNames.size()); ++i) {
-    InputData data = getWorkspace(wsNames[i]);
+  // Find the spectra to fit and their log values
+  std::vector<InputData> inputs;
+  std::vector<FitJob> jobs;
+  for (size_t i = 0; i < wsNames.size(); ++i) {
+    inputs.emplace_back(getWorkspace(wsNames[i]));
+    const InputData &data = inputs.back();
 
     if (!data.ws) {
       g_log.warning() << "Cannot access workspace " << wsNames[i].name << '\n';
@@ -249,13 +254,6 @@ void PlotPeakByLogValue::exec() {
       jend = data.indx.back() + 1;
     }
 
-    if (createFitOutput) {
-      covarianceWorkspaces.reserve(covarianceWorkspaces.size() + jend);
-      fitWorkspaces.reserve(fitWorkspaces.size() + jend);
-      parameterWorkspaces.reserve(parameterWorkspaces.size() + jend);
-    }
-
-    dProg /= abs(jend - j);
     for (; j < jend; ++j) {
 
       // Find the log value: it is either a log-file value or simply the
@@ -283,44 +281,92 @@ void PlotPeakByLogValue::exec() {
         }
         logValue = logp->lastValue();
       }
+      jobs.emplace_back(i, j, logValue);
+    }
+  }
+
+  // Every fit has its row in the result table and its place in the outputs
+  const size_t nJobs = jobs.size();
+  result->setRowCount(nJobs);
+  std::vector<std::string> minimizers;
+  minimizers.reserve(nJobs);
+  for (const auto &job : jobs) {
+    minimizers.emplace_back(getMinimizerString(
+        wsNames[job.input].name, std::to_string(job.wsIndex)));
+  }
+  std::vector<MatrixWorkspace_sptr> fitWorkspaces;
+  std::vector<ITableWorkspace_sptr> parameterWorkspaces;
+  std::vector<ITableWorkspace_sptr> covarianceWorkspaces;
+  if (createFitOutput) {
+    fitWorkspaces.resize(nJobs);
+    parameterWorkspaces.resize(nJobs);
+    covarianceWorkspaces.resize(nJobs);
+  }
+
+  const std::string evaluationType = getPropertyValue("EvaluationType");
+  const bool histogramFit = evaluationType == "Histogram";
+  const bool ignoreInvalidData = getProperty("IgnoreInvalidData");
+  const std::string startX = getPropertyValue("StartX");
+  const std::string endX = getPropertyValue("EndX");
+  const std::string costFunction = getPropertyValue("CostFunction");
+  const std::string maxIterations = getPropertyValue("MaxIterations");
+  const std::string peakRadius = getPropertyValue("PeakRadius");
+
+  // The spectra are split into blocks of neighbours, each fitted in turn by
+  // one thread with its own copy of the function. With a single block this
+  // is the serial sequence of fits.
+  const bool parallel = getProperty("Parallel");
+  size_t nBlocks = 1;
+  if (parallel && nJobs > 1) {
+    nBlocks = std::min(nJobs, static_cast<size_t>(PARALLEL_GET_MAX_THREADS));
+  }
+  std::vector<IFunction_sptr> functions{ifun};
+  for (size_t block = 1; block < nBlocks; ++block) {
+    functions.emplace_back(ifun->clone());
+  }
+
+  Progress prog(this, 0.0, 1.0, nJobs);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t block = 0; block < static_cast<int64_t>(nBlocks); ++block) {
+    PARALLEL_START_INTERUPT_REGION
+    IFunction_sptr function = functions[block];
+    const size_t jobBegin = block * nJobs / nBlocks;
+    const size_t jobEnd = (block + 1) * nJobs / nBlocks;
+    for (size_t k = jobBegin; k < jobEnd; ++k) {
+      const FitJob &job = jobs[k];
+      const InputData &data = inputs[job.input];
+      const int j = job.wsIndex;
 
       double chi2;
 
       try {
         if (passWSIndexToFunction) {
-          setWorkspaceIndexAttribute(ifun, j);
+          setWorkspaceIndexAttribute(function, j);
         }
 
         g_log.debug() << "Fitting " << data.ws->getName() << " index " << j
                       << " with \n";
-        g_log.debug() << ifun->asString() << '\n';
+        g_log.debug() << function->asString() << '\n';
 
-        const std::string spectrum_index = std::to_string(j);
         std::string wsBaseName;
 
         if (createFitOutput)
-          wsBaseName = wsNames[i].name + "_" + spectrum_index;
-
-        bool histogramFit = getPropertyValue("EvaluationType") == "Histogram";
-        bool ignoreInvalidData = getProperty("IgnoreInvalidData");
+          wsBaseName = wsNames[job.input].name + "_" + std::to_string(j);
 
         // Fit the function
         auto fit = this->createChildAlgorithm("Fit");
         fit->initialize();
-        fit->setPropertyValue("EvaluationType",
-                              getPropertyValue("EvaluationType"));
-        fit->setProperty("Function", ifun);
+        fit->setPropertyValue("EvaluationType", evaluationType);
+        fit->setProperty("Function", function);
         fit->setProperty("InputWorkspace", data.ws);
         fit->setProperty("WorkspaceIndex", j);
-        fit->setPropertyValue("StartX", getPropertyValue("StartX"));
-        fit->setPropertyValue("EndX", getPropertyValue("EndX"));
+        fit->setPropertyValue("StartX", startX);
+        fit->setPropertyValue("EndX", endX);
         fit->setProperty("IgnoreInvalidData", ignoreInvalidData);
-        fit->setPropertyValue(
-            "Minimizer", getMinimizerString(wsNames[i].name, spectrum_index));
-        fit->setPropertyValue("CostFunction", getPropertyValue("CostFunction"));
-        fit->setPropertyValue("MaxIterations",
-                              getPropertyValue("MaxIterations"));
-        fit->setPropertyValue("PeakRadius", getPropertyValue("PeakRadius"));
+        fit->setPropertyValue("Minimizer", minimizers[k]);
+        fit->setPropertyValue("CostFunction", costFunction);
+        fit->setPropertyValue("MaxIterations", maxIterations);
+        fit->setPropertyValue("PeakRadius", peakRadius);
         fit->setProperty("CalcErrors", true);
         fit->setProperty("CreateOutput", createFitOutput);
         if (!histogramFit) {
@@ -336,19 +382,14 @@ void PlotPeakByLogValue::exec() {
                                    data.ws->getName());
         }
 
-        ifun = fit->getProperty("Function");
+        function = fit->getProperty("Function");
         chi2 = fit->getProperty("OutputChi2overDoF");
 
         if (createFitOutput) {
-          MatrixWorkspace_sptr outputFitWorkspace =
-              fit->getProperty("OutputWorkspace");
-          ITableWorkspace_sptr outputParamWorkspace =
-              fit->getProperty("OutputParameters");
-          ITableWorkspace_sptr outputCovarianceWorkspace =
+          fitWorkspaces[k] = fit->getProperty("OutputWorkspace");
+          parameterWorkspaces[k] = fit->getProperty("OutputParameters");
+          covarianceWorkspaces[k] =
               fit->getProperty("OutputNormalisedCovarianceMatrix");
-          fitWorkspaces.emplace_back(outputFitWorkspace);
-          parameterWorkspaces.emplace_back(outputParamWorkspace);
-          covarianceWorkspaces.emplace_back(outputCovarianceWorkspace);
         }
         g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus")
                       << ' ' << chi2 << '\n';
@@ -357,31 +398,32 @@ void PlotPeakByLogValue::exec() {
         throw;
       }
 
-      // Extract the fitted parameters and put them into the result table
-      TableRow row = result->appendRow();
+      // Put the fitted parameters into the row of this fit
+      TableRow row = result->getRow(k);
       if (isDataName) {
-        row << wsNames[i].name;
+        row << wsNames[job.input].name;
       } else {
-        row << logValue;
+        row << job.logValue;
       }
 
-      for (size_t iPar = 0; iPar < ifun->nParams(); ++iPar) {
-        row << ifun->getParameter(iPar) << ifun->getError(iPar);
+      for (size_t iPar = 0; iPar < function->nParams(); ++iPar) {
+        row << function->getParameter(iPar) << function->getError(iPar);
       }
       row << chi2;
 
-      Prog += dProg;
-      std::string current = std::to_string(i);
-      progress(Prog, ("Fitting Workspace: (" + current + ") - "));
+      std::string current = std::to_string(job.input);
+      prog.report("Fitting Workspace: (" + current + ") - ");
       interruption_point();
 
       if (individual) {
         for (size_t i = 0; i < initialParams.size(); ++i) {
-          ifun->setParameter(i, initialParams[i]);
+          function->setParameter(i, initialParams[i]);
         }
       }
-    } // for(;j < jend;++j)
+    }
+    PARALLEL_END_INTERUPT_REGION
   }
+  PARALLEL_CHECK_INTERUPT_REGION
 
   if (createFitOutput) {
     // collect output of fit for each spectrum into workspace groups
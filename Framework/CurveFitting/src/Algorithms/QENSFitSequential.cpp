@@ -473,6 +473,11 @@ void QENSFitSequential::init() {
 
   declareProperty("IgnoreInvalidData", false,
                   "Flag to ignore infinities, NaNs and data with zero errors.");
+
+  declareProperty("Parallel", false,
+                  "Fit blocks of neighbouring spectra in parallel.\n"
+                  "Each block starts from the initial values, so the results "
+                  "can differ slightly from a serial run.");
 }
 
 std::map<std::string, std::string> QENSFitSequential::validateInputs() {
@@ -737,6 +742,7 @@ ITableWorkspace_sptr QENSFitSequential::performFit(const std::string &input,
   plotPeaks->setProperty("LogValue", getPropertyValue("LogValue"));
   plotPeaks->setProperty("EvaluationType", getPropertyValue("EvaluationType"));
   plotPeaks->setProperty("CostFunction", getPropertyValue("CostFunction"));
+  plotPeaks->setProperty("Parallel", getPropertyValue("Parallel"));
   plotPeaks->executeAsChildAlg();
   return plotPeaks->getProperty("OutputWorkspace");
 }
@@ -0,0 +1,214 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidCurveFitting/BlockArrowSolver.h"
+#include "MantidAPI/MultiDomainFunction.h"
+#include "MantidCurveFitting/GSLMatrix.h"
+#include "MantidCurveFitting/GSLVector.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_linalg.h>
+
+#include <limits>
+#include <stdexcept>
+
+namespace Mantid {
+namespace CurveFitting {
+
+/**
+ * Find the local and global parameters of a function. A parameter is local
+ * if the values on a single domain depend on it, either directly or through
+ * ties. A function that is not a MultiDomainFunction has no blocks.
+ * @param function :: The fitting function
+ */
+BlockArrowSolver::BlockArrowSolver(const API::IFunction &function) {
+  const auto *multiDomain =
+      dynamic_cast<const API::MultiDomainFunction *>(&function);
+  if (!multiDomain) {
+    return;
+  }
+  const size_t nDomains = multiDomain->getNumberDomains();
+  const auto dependencies = multiDomain->getActiveDependencies(nDomains);
+  // The number of domains depending on each parameter and the last of them
+  const size_t np = function.nParams();
+  std::vector<size_t> nDependent(np, 0);
+  std::vector<size_t> lastDomain(np, 0);
+  for (size_t iDomain = 0; iDomain < nDomains; ++iDomain) {
+    for (auto ip : dependencies[iDomain]) {
+      ++nDependent[ip];
+      lastDomain[ip] = iDomain;
+    }
+  }
+  std::vector<std::vector<size_t>> blocks(nDomains);
+  for (size_t ip = 0; ip < np; ++ip) {
+    if (!function.isActive(ip))
+      continue;
+    if (nDependent[ip] == 1) {
+      blocks[lastDomain[ip]].push_back(m_nActive);
+    } else {
+      m_global.push_back(m_nActive);
+    }
+    ++m_nActive;
+  }
+  for (auto &block : blocks) {
+    if (!block.empty())
+      m_localBlocks.emplace_back(std::move(block));
+  }
+}
+
+/**
+ * Constructor
+ * @param localBlocks :: The active indices of the local parameters of each
+ * domain
+ * @param global :: The active indices of the global parameters
+ */
+BlockArrowSolver::BlockArrowSolver(
+    std::vector<std::vector<size_t>> localBlocks, std::vector<size_t> global)
+    : m_localBlocks(std::move(localBlocks)), m_global(std::move(global)) {
+  m_nActive = m_global.size();
+  for (const auto &block : m_localBlocks) {
+    m_nActive += block.size();
+  }
+}
+
+/**
+ * Check that a matrix has the block-arrow form, i.e. that it has the right
+ * size and no coupling between the local parameters of different domains.
+ * @param matrix :: A square matrix over the active parameters
+ */
+bool BlockArrowSolver::hasStructureOf(const GSLMatrix &matrix) const {
+  if (matrix.size1() != m_nActive || matrix.size2() != m_nActive) {
+    return false;
+  }
+  const size_t isGlobal = std::numeric_limits<size_t>::max();
+  std::vector<size_t> blockOf(m_nActive, isGlobal);
+  for (size_t ib = 0; ib < m_localBlocks.size(); ++ib) {
+    for (auto i : m_localBlocks[ib]) {
+      blockOf[i] = ib;
+    }
+  }
+  for (size_t i = 0; i < m_nActive; ++i) {
+    if (blockOf[i] == isGlobal)
+      continue;
+    for (size_t j = 0; j < m_nActive; ++j) {
+      if (blockOf[j] != isGlobal && blockOf[j] != blockOf[i] &&
+          (matrix.get(i, j) != 0.0 || matrix.get(j, i) != 0.0)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * Solve the system of linear equations matrix * x == rhs. The blocks are
+ * eliminated in parallel.
+ * @param matrix :: A matrix with the block-arrow form
+ * @param rhs :: The right-hand side
+ * @param x :: (Output) The solution
+ * @return :: False, leaving x unchanged, if the matrix does not have the
+ * block-arrow form
+ * @throw std::runtime_error if a block or the Schur complement is singular
+ */
+bool BlockArrowSolver::solve(const GSLMatrix &matrix, const GSLVector &rhs,
+                             GSLVector &x) const {
+  if (!hasStructureOf(matrix)) {
+    return false;
+  }
+  const size_t ng = m_global.size();
+  // The Schur complement augmented with its right-hand side: [S | s]
+  GSLMatrix schur;
+  if (ng > 0) {
+    schur.resize(ng, ng + 1);
+  }
+  for (size_t i = 0; i < ng; ++i) {
+    for (size_t j = 0; j < ng; ++j) {
+      schur.set(i, j, matrix.get(m_global[i], m_global[j]));
+    }
+    schur.set(i, ng, rhs.get(m_global[i]));
+  }
+
+  // The solutions of B_d * Y_d == [C_d | r_d] for each block
+  const auto nBlocks = static_cast<int64_t>(m_localBlocks.size());
+  std::vector<GSLMatrix> solutions(m_localBlocks.size());
+  bool singular = false;
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t ib = 0; ib < nBlocks; ++ib) {
+    const auto &block = m_localBlocks[ib];
+    const size_t nb = block.size();
+    GSLMatrix B(nb, nb);
+    GSLMatrix &Y = solutions[ib];
+    Y.resize(nb, ng + 1);
+    for (size_t i = 0; i < nb; ++i) {
+      for (size_t j = 0; j < nb; ++j) {
+        B.set(i, j, matrix.get(block[i], block[j]));
+      }
+      for (size_t j = 0; j < ng; ++j) {
+        Y.set(i, j, matrix.get(block[i], m_global[j]));
+      }
+      Y.set(i, ng, rhs.get(block[i]));
+    }
+    GSLMatrix C;
+    if (ng > 0) {
+      C = GSLMatrix(Y, 0, 0, nb, ng);
+    }
+
+    int s;
+    gsl_permutation *p = gsl_permutation_alloc(nb);
+    gsl_linalg_LU_decomp(B.gsl(), p, &s);
+    for (size_t j = 0; j <= ng; ++j) {
+      auto column = gsl_matrix_column(Y.gsl(), j);
+      if (gsl_linalg_LU_svx(B.gsl(), p, &column.vector) != GSL_SUCCESS) {
+        singular = true;
+      }
+    }
+    gsl_permutation_free(p);
+
+    if (ng > 0) {
+      // S -= C_d^T * B_d^-1 * [C_d | r_d]
+      GSLMatrix product(ng, ng + 1);
+      gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, C.gsl(), Y.gsl(), 0.0,
+                     product.gsl());
+      PARALLEL_CRITICAL(block_arrow_schur) { schur -= product; }
+    }
+  }
+  if (singular) {
+    throw std::runtime_error("Failed to solve system of linear equations: "
+                             "a block of local parameters is singular.");
+  }
+
+  x.resize(m_nActive);
+  GSLVector xGlobal;
+  if (ng > 0) {
+    GSLMatrix S(schur, 0, 0, ng, ng);
+    GSLVector s(ng);
+    for (size_t i = 0; i < ng; ++i) {
+      s.set(i, schur.get(i, ng));
+    }
+    S.solve(s, xGlobal);
+    for (size_t i = 0; i < ng; ++i) {
+      x.set(m_global[i], xGlobal.get(i));
+    }
+  }
+  // Back substitution: x_d = B_d^-1 * r_d - B_d^-1 * C_d * x_g
+  for (size_t ib = 0; ib < m_localBlocks.size(); ++ib) {
+    const auto &block = m_localBlocks[ib];
+    const GSLMatrix &Y = solutions[ib];
+    for (size_t i = 0; i < block.size(); ++i) {
+      double xi = Y.get(i, ng);
+      for (size_t j = 0; j < ng; ++j) {
+        xi -= Y.get(i, j) * xGlobal.get(j);
+      }
+      x.set(block[i], xi);
+    }
+  }
+  return true;
+}
+
+} // namespace CurveFitting
+} // namespace Mantid
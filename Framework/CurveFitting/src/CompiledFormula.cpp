@@ -0,0 +1,684 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidCurveFitting/CompiledFormula.h"
+#include "MantidAPI/Jacobian.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+
+namespace Mantid {
+namespace CurveFitting {
+
+namespace {
+/// The number of points evaluated by each pass through the program
+constexpr size_t CHUNK_SIZE = 256;
+const double LN10 = std::log(10.0);
+const double LN2 = std::log(2.0);
+const double TWO_OVER_SQRT_PI = 2.0 / std::sqrt(M_PI);
+
+/// Apply f to each of n values of a, writing the results to r
+template <typename F>
+void transform(const double *a, size_t n, double *r, F f) {
+  for (size_t i = 0; i < n; ++i) {
+    r[i] = f(a[i]);
+  }
+}
+
+double sign(double a) { return a > 0. ? 1. : (a < 0. ? -1. : 0.); }
+} // namespace
+
+/// Compiles a formula by recursive descent
+class CompiledFormula::Parser {
+public:
+  Parser(CompiledFormula &program, const std::string &formula,
+         const std::vector<std::string> &parameters)
+      : m_program(program), m_formula(formula), m_pos(0) {
+    for (size_t i = 0; i < parameters.size(); ++i) {
+      m_parameters[parameters[i]] = i;
+    }
+  }
+
+  /// Compile the whole formula
+  void compile() {
+    parseSum();
+    skipSpaces();
+    if (m_pos != m_formula.size()) {
+      fail("Unexpected symbol");
+    }
+  }
+
+private:
+  /// sum := product (('+' | '-') product)*
+  size_t parseSum() {
+    auto result = parseProduct();
+    for (;;) {
+      skipSpaces();
+      if (accept('+')) {
+        result = m_program.add(OpCode::Add, result, parseProduct());
+      } else if (accept('-')) {
+        result = m_program.add(OpCode::Subtract, result, parseProduct());
+      } else {
+        return result;
+      }
+    }
+  }
+
+  /// product := unary (('*' | '/') unary)*
+  size_t parseProduct() {
+    auto result = parseUnary();
+    for (;;) {
+      skipSpaces();
+      if (accept('*')) {
+        result = m_program.add(OpCode::Multiply, result, parseUnary());
+      } else if (accept('/')) {
+        result = m_program.add(OpCode::Divide, result, parseUnary());
+      } else {
+        return result;
+      }
+    }
+  }
+
+  /// unary := ('-' | '+') unary | power
+  size_t parseUnary() {
+    skipSpaces();
+    if (accept('-')) {
+      return m_program.add(OpCode::Negate, parseUnary());
+    }
+    if (accept('+')) {
+      return parseUnary();
+    }
+    return parsePower();
+  }
+
+  /// power := primary ('^' ('-' | '+')* primary)?
+  /// A chain of powers is left to muParser, whose associativity is subtle.
+  size_t parsePower() {
+    auto base = parsePrimary();
+    skipSpaces();
+    if (!accept('^')) {
+      return base;
+    }
+    bool negate = false;
+    for (;;) {
+      skipSpaces();
+      if (accept('-')) {
+        negate = !negate;
+      } else if (!accept('+')) {
+        break;
+      }
+    }
+    auto exponent = parsePrimary();
+    if (negate) {
+      exponent = m_program.add(OpCode::Negate, exponent);
+    }
+    skipSpaces();
+    if (peek() == '^') {
+      fail("Chained powers are not supported");
+    }
+    return m_program.add(OpCode::Power, base, exponent);
+  }
+
+  /// primary := number | '(' sum ')' | name '(' sum ')' | name
+  size_t parsePrimary() {
+    skipSpaces();
+    const char c = peek();
+    if (std::isdigit(c) || c == '.') {
+      return parseNumber();
+    }
+    if (accept('(')) {
+      auto result = parseSum();
+      skipSpaces();
+      if (!accept(')')) {
+        fail("Expected ')'");
+      }
+      return result;
+    }
+    if (std::isalpha(c) || c == '_') {
+      const auto name = parseName();
+      skipSpaces();
+      if (accept('(')) {
+        const auto op = functionOpCode(name);
+        auto argument = parseSum();
+        skipSpaces();
+        if (!accept(')')) {
+          fail("Expected ')'");
+        }
+        return m_program.add(op, argument);
+      }
+      return variable(name);
+    }
+    fail("Unexpected symbol");
+    return 0;
+  }
+
+  size_t parseNumber() {
+    const char *begin = m_formula.c_str() + m_pos;
+    char *end = nullptr;
+    const double value = std::strtod(begin, &end);
+    if (end == begin) {
+      fail("Invalid number");
+    }
+    m_pos += static_cast<size_t>(end - begin);
+    return m_program.add(OpCode::Constant, 0, 0, value);
+  }
+
+  std::string parseName() {
+    const size_t begin = m_pos;
+    while (m_pos < m_formula.size() &&
+           (std::isalnum(m_formula[m_pos]) || m_formula[m_pos] == '_')) {
+      ++m_pos;
+    }
+    return m_formula.substr(begin, m_pos - begin);
+  }
+
+  /// The instruction of x, a parameter or a constant
+  size_t variable(const std::string &name) {
+    auto cached = m_variables.find(name);
+    if (cached != m_variables.end()) {
+      return cached->second;
+    }
+    size_t result;
+    auto parameter = m_parameters.find(name);
+    if (name == "x") {
+      result = m_program.add(OpCode::X, 0);
+    } else if (parameter != m_parameters.end()) {
+      result = m_program.add(OpCode::Parameter, 0, 0,
+                             static_cast<double>(parameter->second));
+    } else if (name == "_pi") {
+      result = m_program.add(OpCode::Constant, 0, 0, M_PI);
+    } else if (name == "_e") {
+      result = m_program.add(OpCode::Constant, 0, 0, M_E);
+    } else {
+      throw std::invalid_argument("Unknown variable " + name);
+    }
+    m_variables[name] = result;
+    return result;
+  }
+
+  OpCode functionOpCode(const std::string &name) const {
+    static const std::map<std::string, OpCode> functions = {
+        {"sin", OpCode::Sin},     {"cos", OpCode::Cos},
+        {"tan", OpCode::Tan},     {"asin", OpCode::Asin},
+        {"acos", OpCode::Acos},   {"atan", OpCode::Atan},
+        {"sinh", OpCode::Sinh},   {"cosh", OpCode::Cosh},
+        {"tanh", OpCode::Tanh},   {"exp", OpCode::Exp},
+        {"log", OpCode::Log},     {"ln", OpCode::Log},
+        {"log10", OpCode::Log10}, {"log2", OpCode::Log2},
+        {"sqrt", OpCode::Sqrt},   {"abs", OpCode::Abs},
+        {"sign", OpCode::Sign},   {"erf", OpCode::Erf},
+        {"erfc", OpCode::Erfc}};
+    auto function = functions.find(name);
+    if (function == functions.end()) {
+      throw std::invalid_argument("Function " + name + " is not supported");
+    }
+    return function->second;
+  }
+
+  void skipSpaces() {
+    while (m_pos < m_formula.size() && std::isspace(m_formula[m_pos])) {
+      ++m_pos;
+    }
+  }
+
+  char peek() const { return m_pos < m_formula.size() ? m_formula[m_pos] : 0; }
+
+  bool accept(char c) {
+    if (peek() != c) {
+      return false;
+    }
+    ++m_pos;
+    return true;
+  }
+
+  [[noreturn]] void fail(const std::string &message) const {
+    throw std::invalid_argument(message + " at position " +
+                                std::to_string(m_pos) + " of " + m_formula);
+  }
+
+  CompiledFormula &m_program;
+  const std::string &m_formula;
+  /// The position of the next symbol to read
+  size_t m_pos;
+  /// The index of each parameter
+  std::map<std::string, size_t> m_parameters;
+  /// The instructions of the variables read so far
+  std::map<std::string, size_t> m_variables;
+};
+
+/**
+ * Compile a formula
+ * @param formula :: The formula
+ * @param parameters :: The names of the parameters in the order of their
+ * values
+ * @throw std::invalid_argument if the formula can not be compiled
+ */
+CompiledFormula::CompiledFormula(const std::string &formula,
+                                 const std::vector<std::string> &parameters)
+    : m_nParams(parameters.size()) {
+  Parser(*this, formula, parameters).compile();
+}
+
+/**
+ * Add an instruction to the program. Operations on constants are folded.
+ * @param op :: The operation
+ * @param a :: The first operand
+ * @param b :: The second operand of a binary operation
+ * @param value :: The value of a constant or the index of a parameter
+ * @return :: The index of the instruction
+ */
+size_t CompiledFormula::add(OpCode op, size_t a, size_t b, double value) {
+  const bool isLeaf =
+      op == OpCode::Constant || op == OpCode::X || op == OpCode::Parameter;
+  const bool isBinary = op >= OpCode::Add && op <= OpCode::Power;
+  if (!isLeaf && m_program[a].op == OpCode::Constant &&
+      (!isBinary || m_program[b].op == OpCode::Constant)) {
+    double result;
+    apply(op, &m_program[a].value, &m_program[b].value, 1, &result);
+    return add(OpCode::Constant, 0, 0, result);
+  }
+
+  std::vector<size_t> dependencies;
+  if (op == OpCode::Parameter) {
+    dependencies.push_back(static_cast<size_t>(value));
+  } else if (!isLeaf) {
+    dependencies = m_dependencies[a];
+    if (isBinary) {
+      std::vector<size_t> both;
+      std::set_union(dependencies.begin(), dependencies.end(),
+                     m_dependencies[b].begin(), m_dependencies[b].end(),
+                     std::back_inserter(both));
+      dependencies.swap(both);
+    }
+  }
+  m_program.push_back({op, a, b, value});
+  m_dependencies.emplace_back(std::move(dependencies));
+  return m_program.size() - 1;
+}
+
+/**
+ * Apply an operation to n values of its operands
+ * @param op :: The operation. Not a leaf of the program.
+ * @param a :: The values of the first operand
+ * @param b :: The values of the second operand of a binary operation
+ * @param n :: The number of values
+ * @param r :: (Output) The results
+ */
+void CompiledFormula::apply(OpCode op, const double *a, const double *b,
+                            size_t n, double *r) {
+  switch (op) {
+  case OpCode::Add:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = a[i] + b[i];
+    break;
+  case OpCode::Subtract:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = a[i] - b[i];
+    break;
+  case OpCode::Multiply:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = a[i] * b[i];
+    break;
+  case OpCode::Divide:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = a[i] / b[i];
+    break;
+  case OpCode::Power:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::pow(a[i], b[i]);
+    break;
+  case OpCode::Negate:
+    transform(a, n, r, [](double v) { return -v; });
+    break;
+  case OpCode::Sin:
+    transform(a, n, r, [](double v) { return std::sin(v); });
+    break;
+  case OpCode::Cos:
+    transform(a, n, r, [](double v) { return std::cos(v); });
+    break;
+  case OpCode::Tan:
+    transform(a, n, r, [](double v) { return std::tan(v); });
+    break;
+  case OpCode::Asin:
+    transform(a, n, r, [](double v) { return std::asin(v); });
+    break;
+  case OpCode::Acos:
+    transform(a, n, r, [](double v) { return std::acos(v); });
+    break;
+  case OpCode::Atan:
+    transform(a, n, r, [](double v) { return std::atan(v); });
+    break;
+  case OpCode::Sinh:
+    transform(a, n, r, [](double v) { return std::sinh(v); });
+    break;
+  case OpCode::Cosh:
+    transform(a, n, r, [](double v) { return std::cosh(v); });
+    break;
+  case OpCode::Tanh:
+    transform(a, n, r, [](double v) { return std::tanh(v); });
+    break;
+  case OpCode::Exp:
+    transform(a, n, r, [](double v) { return std::exp(v); });
+    break;
+  case OpCode::Log:
+    transform(a, n, r, [](double v) { return std::log(v); });
+    break;
+  case OpCode::Log10:
+    transform(a, n, r, [](double v) { return std::log10(v); });
+    break;
+  case OpCode::Log2:
+    transform(a, n, r, [](double v) { return std::log2(v); });
+    break;
+  case OpCode::Sqrt:
+    transform(a, n, r, [](double v) { return std::sqrt(v); });
+    break;
+  case OpCode::Abs:
+    transform(a, n, r, [](double v) { return std::fabs(v); });
+    break;
+  case OpCode::Sign:
+    transform(a, n, r, sign);
+    break;
+  case OpCode::Erf:
+    transform(a, n, r, [](double v) { return std::erf(v); });
+    break;
+  case OpCode::Erfc:
+    transform(a, n, r, [](double v) { return std::erfc(v); });
+    break;
+  default:
+    throw std::logic_error("CompiledFormula: not an operation.");
+  }
+}
+
+/**
+ * Fill the registers of the constants and the parameters, which are the
+ * same for all the points.
+ * @param parameters :: The values of the parameters
+ * @param registers :: The registers, CHUNK_SIZE values per instruction
+ */
+void CompiledFormula::initialize(const double *parameters,
+                                 std::vector<double> &registers) const {
+  registers.resize(m_program.size() * CHUNK_SIZE);
+  for (size_t k = 0; k < m_program.size(); ++k) {
+    const auto &instruction = m_program[k];
+    double value;
+    if (instruction.op == OpCode::Constant) {
+      value = instruction.value;
+    } else if (instruction.op == OpCode::Parameter) {
+      value = parameters[static_cast<size_t>(instruction.value)];
+    } else {
+      continue;
+    }
+    auto begin = registers.begin() + k * CHUNK_SIZE;
+    std::fill(begin, begin + CHUNK_SIZE, value);
+  }
+}
+
+/**
+ * Run the program for up to CHUNK_SIZE points
+ * @param x :: The values of x
+ * @param n :: The number of points
+ * @param registers :: The initialized registers. The result of each
+ * instruction is written to its register.
+ */
+void CompiledFormula::run(const double *x, size_t n,
+                          std::vector<double> &registers) const {
+  double *data = registers.data();
+  for (size_t k = 0; k < m_program.size(); ++k) {
+    const auto &instruction = m_program[k];
+    double *r = data + k * CHUNK_SIZE;
+    const double *a = data + instruction.a * CHUNK_SIZE;
+    const double *b = data + instruction.b * CHUNK_SIZE;
+    switch (instruction.op) {
+    case OpCode::Constant:
+    case OpCode::Parameter:
+      break;
+    case OpCode::X:
+      std::copy(x, x + n, r);
+      break;
+    case OpCode::Power:
+      // Squares are common and much cheaper than pow
+      if (m_program[instruction.b].op == OpCode::Constant &&
+          m_program[instruction.b].value == 2.0) {
+        for (size_t i = 0; i < n; ++i)
+          r[i] = a[i] * a[i];
+        break;
+      }
+      apply(instruction.op, a, b, n, r);
+      break;
+    default:
+      apply(instruction.op, a, b, n, r);
+    }
+  }
+}
+
+/// Check if the result of an instruction depends on a parameter
+bool CompiledFormula::dependsOn(size_t i, size_t parameter) const {
+  return std::binary_search(m_dependencies[i].begin(),
+                            m_dependencies[i].end(), parameter);
+}
+
+/**
+ * Evaluate the formula
+ * @param x :: The values of x
+ * @param n :: The number of values
+ * @param parameters :: The values of the parameters
+ * @param out :: (Output) The n values of the formula
+ */
+void CompiledFormula::evaluate(const double *x, size_t n,
+                               const double *parameters, double *out) const {
+  std::vector<double> registers;
+  initialize(parameters, registers);
+  // The result is the last instruction
+  const double *result = registers.data() + (m_program.size() - 1) * CHUNK_SIZE;
+  for (size_t begin = 0; begin < n; begin += CHUNK_SIZE) {
+    const size_t m = std::min(CHUNK_SIZE, n - begin);
+    run(x + begin, m, registers);
+    std::copy(result, result + m, out + begin);
+  }
+}
+
+/**
+ * Calculate the derivatives of the formula with respect to all its
+ * parameters by forward-mode automatic differentiation. Each instruction
+ * applies the chain rule to the derivatives of its operands with respect to
+ * the parameters it depends on.
+ * @param x :: The values of x
+ * @param n :: The number of values
+ * @param parameters :: The values of the parameters
+ * @param jacobian :: (Output) The derivatives
+ */
+void CompiledFormula::derivatives(const double *x, size_t n,
+                                  const double *parameters,
+                                  API::Jacobian &jacobian) const {
+  std::vector<double> registers;
+  initialize(parameters, registers);
+  // The derivatives of instruction k with respect to parameter p start at
+  // (k * m_nParams + p) * CHUNK_SIZE. Those an instruction does not depend
+  // on stay zero.
+  std::vector<double> derivatives(m_program.size() * m_nParams * CHUNK_SIZE);
+  auto deriv = [&](size_t k, size_t p) {
+    return derivatives.data() + (k * m_nParams + p) * CHUNK_SIZE;
+  };
+  for (size_t k = 0; k < m_program.size(); ++k) {
+    if (m_program[k].op == OpCode::Parameter) {
+      double *d = deriv(k, static_cast<size_t>(m_program[k].value));
+      std::fill(d, d + CHUNK_SIZE, 1.0);
+    }
+  }
+  // The derivative of a function of one operand with respect to it
+  std::vector<double> factor(CHUNK_SIZE);
+  std::vector<double> factorB(CHUNK_SIZE);
+  double *f = factor.data();
+  double *fb = factorB.data();
+
+  const size_t last = m_program.size() - 1;
+  for (size_t begin = 0; begin < n; begin += CHUNK_SIZE) {
+    const size_t m = std::min(CHUNK_SIZE, n - begin);
+    run(x + begin, m, registers);
+
+    for (size_t k = 0; k < m_program.size(); ++k) {
+      const auto &instruction = m_program[k];
+      const auto &dependencies = m_dependencies[k];
+      if (dependencies.empty() || instruction.op == OpCode::Parameter)
+        continue;
+      const size_t ia = instruction.a;
+      const size_t ib = instruction.b;
+      const double *r = registers.data() + k * CHUNK_SIZE;
+      const double *a = registers.data() + ia * CHUNK_SIZE;
+      const double *b = registers.data() + ib * CHUNK_SIZE;
+
+      switch (instruction.op) {
+      case OpCode::Add:
+      case OpCode::Subtract: {
+        const double sb = instruction.op == OpCode::Add ? 1.0 : -1.0;
+        for (auto p : dependencies) {
+          double *d = deriv(k, p);
+          const double *da = deriv(ia, p);
+          const double *db = deriv(ib, p);
+          for (size_t i = 0; i < m; ++i)
+            d[i] = da[i] + sb * db[i];
+        }
+        break;
+      }
+      case OpCode::Multiply:
+        for (auto p : dependencies) {
+          double *d = deriv(k, p);
+          const double *da = deriv(ia, p);
+          const double *db = deriv(ib, p);
+          for (size_t i = 0; i < m; ++i)
+            d[i] = da[i] * b[i] + a[i] * db[i];
+        }
+        break;
+      case OpCode::Divide:
+        for (auto p : dependencies) {
+          double *d = deriv(k, p);
+          const double *da = deriv(ia, p);
+          const double *db = deriv(ib, p);
+          for (size_t i = 0; i < m; ++i)
+            d[i] = (da[i] - r[i] * db[i]) / b[i];
+        }
+        break;
+      case OpCode::Power: {
+        // d(a^b) = b * a^(b-1) * da + a^b * ln(a) * db. The logarithm is
+        // only taken if the exponent depends on the parameters.
+        const bool baseVaries = !m_dependencies[ia].empty();
+        const bool exponentVaries = !m_dependencies[ib].empty();
+        if (baseVaries) {
+          for (size_t i = 0; i < m; ++i)
+            f[i] = b[i] * std::pow(a[i], b[i] - 1.0);
+        }
+        if (exponentVaries) {
+          for (size_t i = 0; i < m; ++i)
+            fb[i] = r[i] * std::log(a[i]);
+        }
+        for (auto p : dependencies) {
+          double *d = deriv(k, p);
+          const double *da = deriv(ia, p);
+          const double *db = deriv(ib, p);
+          const bool inA = dependsOn(ia, p);
+          const bool inB = dependsOn(ib, p);
+          for (size_t i = 0; i < m; ++i) {
+            d[i] = (inA ? f[i] * da[i] : 0.0) + (inB ? fb[i] * db[i] : 0.0);
+          }
+        }
+        break;
+      }
+      default: {
+        // A function of a single operand
+        switch (instruction.op) {
+        case OpCode::Negate:
+          std::fill(f, f + m, -1.0);
+          break;
+        case OpCode::Sin:
+          transform(a, m, f, [](double v) { return std::cos(v); });
+          break;
+        case OpCode::Cos:
+          transform(a, m, f, [](double v) { return -std::sin(v); });
+          break;
+        case OpCode::Tan:
+          transform(r, m, f, [](double v) { return 1.0 + v * v; });
+          break;
+        case OpCode::Asin:
+          transform(a, m, f,
+                    [](double v) { return 1.0 / std::sqrt(1 - v * v); });
+          break;
+        case OpCode::Acos:
+          transform(a, m, f,
+                    [](double v) { return -1.0 / std::sqrt(1 - v * v); });
+          break;
+        case OpCode::Atan:
+          transform(a, m, f, [](double v) { return 1.0 / (1.0 + v * v); });
+          break;
+        case OpCode::Sinh:
+          transform(a, m, f, [](double v) { return std::cosh(v); });
+          break;
+        case OpCode::Cosh:
+          transform(a, m, f, [](double v) { return std::sinh(v); });
+          break;
+        case OpCode::Tanh:
+          transform(r, m, f, [](double v) { return 1.0 - v * v; });
+          break;
+        case OpCode::Exp:
+          std::copy(r, r + m, f);
+          break;
+        case OpCode::Log:
+          transform(a, m, f, [](double v) { return 1.0 / v; });
+          break;
+        case OpCode::Log10:
+          transform(a, m, f, [](double v) { return 1.0 / (v * LN10); });
+          break;
+        case OpCode::Log2:
+          transform(a, m, f, [](double v) { return 1.0 / (v * LN2); });
+          break;
+        case OpCode::Sqrt:
+          transform(r, m, f, [](double v) { return 0.5 / v; });
+          break;
+        case OpCode::Abs:
+          transform(a, m, f, sign);
+          break;
+        case OpCode::Sign:
+          std::fill(f, f + m, 0.0);
+          break;
+        case OpCode::Erf:
+          transform(a, m, f, [](double v) {
+            return TWO_OVER_SQRT_PI * std::exp(-v * v);
+          });
+          break;
+        case OpCode::Erfc:
+          transform(a, m, f, [](double v) {
+            return -TWO_OVER_SQRT_PI * std::exp(-v * v);
+          });
+          break;
+        default:
+          throw std::logic_error("CompiledFormula: not an operation.");
+        }
+        for (auto p : dependencies) {
+          double *d = deriv(k, p);
+          const double *da = deriv(ia, p);
+          for (size_t i = 0; i < m; ++i)
+            d[i] = f[i] * da[i];
+        }
+      }
+      }
+    }
+
+    for (size_t p = 0; p < m_nParams; ++p) {
+      const double *d = deriv(last, p);
+      const bool varies = dependsOn(last, p);
+      for (size_t i = 0; i < m; ++i) {
+        jacobian.set(begin + i, p, varies ? d[i] : 0.0);
+      }
+    }
+  }
+}
+
+} // namespace CurveFitting
+} // namespace Mantid
@@ -11,11 +11,18 @@
 #include "MantidAPI/CompositeDomain.h"
 #include "MantidAPI/FunctionValues.h"
 #include "MantidAPI/IConstraint.h"
+#include "MantidAPI/MultiDomainFunction.h"
 #include "MantidCurveFitting/Jacobian.h"
 #include "MantidCurveFitting/SeqDomain.h"
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/MultiThreaded.h"
 
+#include <gsl/gsl_blas.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
 #include <sstream>
 
 namespace Mantid {
@@ -24,6 +31,146 @@ namespace CostFunctions {
 namespace {
 /// static logger
 Kernel::Logger g_log("CostFuncLeastSquares");
+/// The number of data points in a block of the Jacobian
+constexpr size_t BLOCK_SIZE = 256;
+
+/**
+ * Add the contribution of consecutive data points to the sum of squares, the
+ * derivatives and the Hessian.
+ *
+ * The data points are processed in blocks. For each block the weighted rows
+ * of the Jacobian are gathered into a matrix A and the weighted residuals
+ * into a vector r, so that the block adds A^T r to the derivatives and A^T A
+ * to the Hessian through BLAS. Each thread sums its blocks into its own
+ * partial results, which are added to the outputs once at the end.
+ * @param jacobian :: The derivatives at the data points
+ * @param columns :: The columns of the Jacobian to use
+ * @param values :: The function values
+ * @param weights :: The fit weights
+ * @param offset :: The index in values of the first point of the Jacobian
+ * @param ny :: The number of data points in the Jacobian
+ * @param evalHessian :: Flag to evaluate the Hessian
+ * @param der :: (Output) Derivatives to add to, one per column
+ * @param hessian :: (Output) Hessian to add the lower triangle to
+ * @return :: The sum of the squares of the weighted residuals
+ */
+double addBlocks(const Jacobian &jacobian, const std::vector<size_t> &columns,
+                 const API::FunctionValues &values,
+                 const std::vector<double> &weights, size_t offset,
+                 size_t ny, bool evalHessian, GSLVector &der,
+                 GSLMatrix &hessian) {
+  const size_t na = columns.size();
+  double fVal = 0.0;
+  if (na == 0) {
+    for (size_t k = offset; k < offset + ny; ++k) {
+      const double y =
+          (values.getCalculated(k) - values.getFitData(k)) * weights[k];
+      fVal += y * y;
+    }
+    return fVal;
+  }
+  const int64_t nBlocks =
+      static_cast<int64_t>((ny + BLOCK_SIZE - 1) / BLOCK_SIZE);
+  PRAGMA_OMP(parallel if (nBlocks > 1)) {
+    GSLMatrix block(BLOCK_SIZE, na);
+    GSLVector residuals(BLOCK_SIZE);
+    GSLVector partialDer(na);
+    GSLMatrix partialHessian;
+    if (evalHessian) {
+      partialHessian.resize(na, na);
+      partialHessian.zero();
+    }
+    double partialVal = 0.0;
+    PRAGMA_OMP(for schedule(static))
+    for (int64_t iBlock = 0; iBlock < nBlocks; ++iBlock) {
+      const size_t begin = static_cast<size_t>(iBlock) * BLOCK_SIZE;
+      const size_t n = std::min(BLOCK_SIZE, ny - begin);
+      for (size_t i = 0; i < n; ++i) {
+        const size_t k = offset + begin + i;
+        const double w = weights[k];
+        const double y = (values.getCalculated(k) - values.getFitData(k)) * w;
+        partialVal += y * y;
+        residuals.set(i, y);
+        const double *row = jacobian.getRowPointer(begin + i);
+        for (size_t ia = 0; ia < na; ++ia) {
+          block.set(i, ia, row[columns[ia]] * w);
+        }
+      }
+      auto rows = gsl_matrix_submatrix(block.gsl(), 0, 0, n, na);
+      auto r = gsl_vector_subvector(residuals.gsl(), 0, n);
+      gsl_blas_dgemv(CblasTrans, 1.0, &rows.matrix, &r.vector, 1.0,
+                     partialDer.gsl());
+      if (evalHessian) {
+        gsl_blas_dsyrk(CblasLower, CblasTrans, 1.0, &rows.matrix, 1.0,
+                       partialHessian.gsl());
+      }
+    }
+    PARALLEL_CRITICAL(partial_sum) {
+      fVal += partialVal;
+      der += partialDer;
+      if (evalHessian) {
+        hessian += partialHessian;
+      }
+    }
+  }
+  return fVal;
+}
+
+/**
+ * Calculate the numerical derivatives of the members of a composite function
+ * applying to one domain. The steps are the same as in
+ * IFunction::calNumericalDeriv but only these members are evaluated.
+ * @param function :: The composite function
+ * @param members :: The indices of the members applying to the domain
+ * @param domain :: The domain
+ * @param values :: The values of the function on all the domains
+ * @param offset :: The index in values of the first point of the domain
+ * @param params :: The active parameters to differentiate by
+ * @param jacobian :: (Output) The derivatives, one column per parameter
+ */
+void calNumericalDerivByDomain(API::CompositeFunction &function,
+                               const std::vector<size_t> &members,
+                               const API::FunctionDomain &domain,
+                               const API::FunctionValues &values, size_t offset,
+                               const std::vector<size_t> &params,
+                               Jacobian &jacobian) {
+  constexpr double epsilon = std::numeric_limits<double>::epsilon() * 100;
+  constexpr double stepPercentage = 0.001;
+  constexpr double cutoff =
+      100.0 * std::numeric_limits<double>::min() / stepPercentage;
+  const size_t nData = domain.size();
+  API::FunctionValues plusStep(domain);
+  API::FunctionValues memberValues(domain);
+
+  for (size_t ic = 0; ic < params.size(); ++ic) {
+    const size_t iP = params[ic];
+    const double val = function.activeParameter(iP);
+    double step;
+    if (fabs(val) < cutoff) {
+      step = epsilon;
+    } else {
+      step = val * stepPercentage;
+    }
+
+    const double paramPstep = val + step;
+    function.setActiveParameter(iP, paramPstep);
+    function.applyTies();
+    plusStep.zeroCalculated();
+    for (auto iFun : members) {
+      function.getFunction(iFun)->function(domain, memberValues);
+      plusStep.addToCalculated(0, memberValues);
+    }
+    function.setActiveParameter(iP, val);
+    function.applyTies();
+
+    step = paramPstep - val;
+    for (size_t i = 0; i < nData; ++i) {
+      const double diff =
+          plusStep.getCalculated(i) - values.getCalculated(offset + i);
+      jacobian.set(i, ic, diff / step);
+    }
+  }
+}
 } // namespace
 
 DECLARE_COSTFUNCTION(CostFuncLeastSquares, Least squares)
@@ -221,6 +368,12 @@ double CostFuncLeastSquares::valDerivHessian(bool evalDeriv,
 /**
  * Update the cost function, derivatives and hessian by adding values calculated
  * on a domain.
+ *
+ * A MultiDomainFunction on a CompositeDomain is differentiated one domain at
+ * a time, so that only the parameters of the members applying to a domain
+ * are stored for its points instead of all the parameters for all the points.
+ * With numerical derivatives only these members are re-evaluated for a step
+ * of a parameter, and only for the parameters they depend on.
  * @param function :: Function to use to calculate the value and the derivatives
  * @param domain :: The domain.
  * @param values :: The fit function values
@@ -233,69 +386,182 @@ void CostFuncLeastSquares::addValDerivHessian(API::IFunction_sptr function,
                                               bool evalDeriv,
                                               bool evalHessian) const {
   UNUSED_ARG(evalDeriv);
+  auto multiDomainFunction =
+      boost::dynamic_pointer_cast<API::MultiDomainFunction>(function);
+  auto compositeDomain =
+      boost::dynamic_pointer_cast<API::CompositeDomain>(domain);
+  if (multiDomainFunction && compositeDomain) {
+    addValDerivHessianByDomain(*multiDomainFunction, *compositeDomain, values,
+                               evalHessian);
+    return;
+  }
+
   function->function(*domain, *values);
   size_t np = function->nParams(); // number of parameters
   size_t ny = values->size();      // number of data points
   Jacobian jacobian(ny, np);
   function->functionDeriv(*domain, jacobian);
 
-  size_t iActiveP = 0;
-  double fVal = 0.0;
+  std::vector<size_t> activeParams;
+  for (size_t ip = 0; ip < np; ++ip) {
+    if (function->isActive(ip))
+      activeParams.push_back(ip);
+  }
+  const size_t na = activeParams.size();
+  std::vector<double> weights = getFitWeights(values);
+
+  GSLVector der(std::max(na, size_t(1)));
+  GSLMatrix hessian;
+  if (evalHessian && na > 0) {
+    hessian.resize(na, na);
+    hessian.zero();
+  }
+  const double fVal = addBlocks(jacobian, activeParams, *values, weights, 0,
+                                ny, evalHessian, der, hessian);
+
+  // Add the contribution of this domain to the totals
+  std::vector<size_t> indices(na);
+  std::iota(indices.begin(), indices.end(), 0);
+  PARALLEL_CRITICAL(der_set) {
+    m_value += 0.5 * fVal;
+    addToTotals(der, hessian, indices, evalHessian);
+  }
+}
+
+/**
+ * Update the cost function, derivatives and hessian by adding values of a
+ * MultiDomainFunction calculated on a CompositeDomain. The Jacobian of each
+ * domain only holds the parameters of the members applying to it, or with
+ * numerical derivatives the active parameters these members depend on.
+ * @param function :: The function
+ * @param domain :: The domain
+ * @param values :: The fit function values
+ * @param evalHessian :: Flag to evaluate the Hessian
+ */
+void CostFuncLeastSquares::addValDerivHessianByDomain(
+    API::MultiDomainFunction &function, const API::CompositeDomain &domain,
+    API::FunctionValues_sptr values, bool evalHessian) const {
+  function.function(domain, *values);
   std::vector<double> weights = getFitWeights(values);
 
+  // The active index of each parameter, np for the inactive ones
+  const size_t np = function.nParams();
+  std::vector<size_t> activeIndex(np, np);
+  size_t na = 0;
   for (size_t ip = 0; ip < np; ++ip) {
-    if (!function->isActive(ip))
-      continue;
-    double d = 0.0;
-    for (size_t i = 0; i < ny; ++i) {
-      double calc = values->getCalculated(i);
-      double obs = values->getFitData(i);
-      double w = weights[i];
-      double y = (calc - obs) * w;
-      d += y * jacobian.get(i, ip) * w;
-      if (iActiveP == 0) {
-        fVal += y * y;
+    if (function.isActive(ip))
+      activeIndex[ip] = na++;
+  }
+
+  // The members applying to each domain
+  const size_t nDomains = domain.getNParts();
+  std::vector<std::vector<size_t>> members(nDomains);
+  std::vector<size_t> paramOffsets;
+  std::vector<size_t> domainIndices;
+  size_t paramOffset = 0;
+  for (size_t iFun = 0; iFun < function.nFunctions(); ++iFun) {
+    function.getDomainIndices(iFun, nDomains, domainIndices);
+    for (auto iDomain : domainIndices) {
+      members[iDomain].push_back(iFun);
+    }
+    paramOffsets.push_back(paramOffset);
+    paramOffset += function.getFunction(iFun)->nParams();
+  }
+
+  // The active parameters each domain depends on through numerical
+  // derivatives, which follow the ties
+  const bool numDeriv = function.getAttribute("NumDeriv").asBool();
+  std::vector<std::vector<size_t>> dependencies;
+  if (numDeriv) {
+    dependencies = function.getActiveDependencies(nDomains);
+  }
+
+  double fVal = 0.0;
+  size_t offset = 0;
+  for (size_t iDomain = 0; iDomain < nDomains; ++iDomain) {
+    const auto &part = domain.getDomain(iDomain);
+    size_t nColumns = 0;
+    if (numDeriv) {
+      nColumns = dependencies[iDomain].size();
+    } else {
+      for (auto iFun : members[iDomain]) {
+        nColumns += function.getFunction(iFun)->nParams();
       }
     }
+    Jacobian jacobian(part.size(), nColumns);
+    // The columns of the active parameters and their active indices
+    std::vector<size_t> columns;
+    std::vector<size_t> indices;
+    if (numDeriv) {
+      calNumericalDerivByDomain(function, members[iDomain], part, *values,
+                                offset, dependencies[iDomain], jacobian);
+      for (size_t ic = 0; ic < nColumns; ++ic) {
+        columns.push_back(ic);
+        indices.push_back(activeIndex[dependencies[iDomain][ic]]);
+      }
+    } else {
+      size_t column = 0;
+      for (auto iFun : members[iDomain]) {
+        auto member = function.getFunction(iFun);
+        API::PartialJacobian J(&jacobian, column);
+        member->functionDeriv(part, J);
+        for (size_t ip = 0; ip < member->nParams(); ++ip) {
+          const size_t ia = activeIndex[paramOffsets[iFun] + ip];
+          if (ia < na) {
+            columns.push_back(column + ip);
+            indices.push_back(ia);
+          }
+        }
+        column += member->nParams();
+      }
+    }
+
+    const size_t nc = columns.size();
+    GSLVector der(std::max(nc, size_t(1)));
+    GSLMatrix hessian;
+    if (evalHessian && nc > 0) {
+      hessian.resize(nc, nc);
+      hessian.zero();
+    }
+    fVal += addBlocks(jacobian, columns, *values, weights, offset,
+                      part.size(), evalHessian, der, hessian);
     PARALLEL_CRITICAL(der_set) {
-      double der = m_der.get(iActiveP);
-      m_der.set(iActiveP, der + d);
+      addToTotals(der, hessian, indices, evalHessian);
     }
-    ++iActiveP;
+    offset += part.size();
   }
 
-  PARALLEL_ATOMIC
-  m_value += 0.5 * fVal;
+  PARALLEL_CRITICAL(der_set) { m_value += 0.5 * fVal; }
+}
 
-  if (!evalHessian)
+/**
+ * Add the derivatives and the Hessian of a part of the data to the totals.
+ * @param der :: The derivatives
+ * @param hessian :: The lower triangle of the Hessian
+ * @param indices :: The active indices of the parameters of der and hessian
+ * @param evalHessian :: Flag to add the Hessian
+ */
+void CostFuncLeastSquares::addToTotals(const GSLVector &der,
+                                       const GSLMatrix &hessian,
+                                       const std::vector<size_t> &indices,
+                                       bool evalHessian) const {
+  const size_t n = indices.size();
+  for (size_t i = 0; i < n; ++i) {
+    m_der.set(indices[i], m_der.get(indices[i]) + der.get(i));
+  }
+  if (!evalHessian) {
     return;
-
-  size_t i1 = 0;                  // active parameter index
-  for (size_t i = 0; i < np; ++i) // over parameters
-  {
-    if (!function->isActive(i))
-      continue;
-    size_t i2 = 0;                  // active parameter index
-    for (size_t j = 0; j <= i; ++j) // over ~ half of parameters
-    {
-      if (!function->isActive(j))
-        continue;
-      double d = 0.0;
-      for (size_t k = 0; k < ny; ++k) // over fitting data
-      {
-        double w = weights[k];
-        d += jacobian.get(k, i) * jacobian.get(k, j) * w * w;
-      }
-      PARALLEL_CRITICAL(hessian_set) {
-        double h = m_hessian.get(i1, i2);
-        m_hessian.set(i1, i2, h + d);
-        if (i1 != i2) {
-          m_hessian.set(i2, i1, h + d);
-        }
+  }
+  for (size_t i1 = 0; i1 < n; ++i1) {
+    for (size_t i2 = 0; i2 <= i1; ++i2) {
+      const size_t j1 = indices[i1];
+      const size_t j2 = indices[i2];
+      const double h = m_hessian.get(j1, j2) + hessian.get(i1, i2);
+      m_hessian.set(j1, j2, h);
+      if (j1 != j2) {
+        m_hessian.set(j2, j1, h);
       }
-      ++i2;
     }
-    ++i1;
   }
 }
 
@@ -8,6 +8,7 @@
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/CostFunctionFactory.h"
 #include "MantidAPI/FuncMinimizerFactory.h"
+#include "MantidAPI/FunctionValues.h"
 #include "MantidAPI/IFunction.h"
 #include "MantidAPI/ITableWorkspace.h"
 #include "MantidAPI/MatrixWorkspace.h"
@@ -25,6 +26,7 @@
 
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/MersenneTwister.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PseudoRandomNumberGenerator.h"
 #include "MantidKernel/normal_distribution.h"
 
@@ -32,6 +34,9 @@
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
+#include <exception>
+#include <limits>
+#include <numeric>
 #include <random>
 
 namespace Mantid {
@@ -51,8 +56,41 @@ const size_t LOWER_CONVERGENCE_LIMIT = 350;
 const size_t JUMP_CHECKING_RATE = 200;
 // low jump limit
 const double LOW_JUMP_LIMIT = 1e-25;
-// random number generator
-std::mt19937 rng;
+
+/// The potential scale reduction factor (R-hat) of Gelman and Rubin for
+/// chains of equal length. Values close to 1 mean the chains have mixed.
+double potentialScaleReduction(const std::vector<std::vector<double>> &chains) {
+  const auto m = static_cast<double>(chains.size());
+  const auto n = static_cast<double>(chains.front().size());
+  if (m < 2 || n < 2) {
+    return 1.0;
+  }
+  // The mean of the variances within the chains and the variance between
+  // the means of the chains
+  double within = 0.0;
+  std::vector<double> means;
+  for (const auto &chain : chains) {
+    const double mean = std::accumulate(chain.begin(), chain.end(), 0.0) / n;
+    double variance = 0.0;
+    for (auto value : chain) {
+      variance += (value - mean) * (value - mean);
+    }
+    within += variance / (n - 1);
+    means.push_back(mean);
+  }
+  within /= m;
+  const double grandMean =
+      std::accumulate(means.begin(), means.end(), 0.0) / m;
+  double between = 0.0;
+  for (auto mean : means) {
+    between += (mean - grandMean) * (mean - grandMean);
+  }
+  between *= n / (m - 1);
+  if (within == 0.0) {
+    return between == 0.0 ? 1.0 : std::numeric_limits<double>::infinity();
+  }
+  return std::sqrt(((n - 1) / n * within + between / n) / within);
+}
 
 API::MatrixWorkspace_sptr
 createWorkspace(std::vector<double> const &xValues,
@@ -85,7 +123,10 @@ FABADAMinimizer::FABADAMinimizer()
       m_parConverged(), m_criteria(), m_maxIter(0), m_parChanged(),
       m_temperature(0.), m_counterGlobal(0), m_simAnnealingItStep(0),
       m_leftRefrPoints(0), m_tempStep(0.), m_overexploration(false),
-      m_nParams(0), m_numInactiveRegenerations(), m_changesOld() {
+      m_nParams(0), m_numInactiveRegenerations(), m_changesOld(),
+      m_randomGenerator(), m_chainIndex(0), m_chainLength(0),
+      m_baseTemperature(1.0), m_annealedLength(0), m_otherChains(),
+      m_running(), m_tempering(false), m_recordChain(true) {
   declareProperty("ChainLength", static_cast<size_t>(10000),
                   "Length of the converged chain.");
   declareProperty("StepsBetweenValues", 10,
@@ -114,6 +155,23 @@ FABADAMinimizer::FABADAMinimizer()
                   " no error will jump for that (The temperature is"
                   " constant during the convergence period)."
                   " Useful to find the exact minimum.");
+  // Multiple chains properties
+  declareProperty("NumberOfChains", static_cast<size_t>(1),
+                  "Number of Markov chains run concurrently. Independent"
+                  " chains share the chain length and are merged in the"
+                  " outputs.");
+  declareProperty("ParallelTempering", false,
+                  "If the chains other than the first should run at"
+                  " temperatures increasing up to MaximumTemperature and"
+                  " exchange their states with it. Only the first chain is"
+                  " output. Cannot be used with Simulated Annealing.");
+  declareProperty("MaximumRHat", 1.1,
+                  "Independent chains are considered converged when the"
+                  " Gelman-Rubin R-hat of every parameter is below this"
+                  " value. 0 switches the check off.");
+  declareProperty("Seed", 0,
+                  "Seed of the random number generator. Each chain draws"
+                  " its own sequence from it.");
   // Output Properties
   declareProperty("PDF", true, "If the PDF's should be calculated or not.");
   declareProperty("NumberBinsPDF", 20,
@@ -166,6 +224,23 @@ void FABADAMinimizer::initialize(API::ICostFunction_sptr function,
   m_converged = false;
   m_maxIter = maxIterations;
 
+  const int seed = getProperty("Seed");
+  std::seed_seq seeds{seed, static_cast<int>(m_chainIndex)};
+  m_randomGenerator.seed(seeds);
+
+  // Independent chains share the chain length
+  const size_t nChains = getProperty("NumberOfChains");
+  const bool tempering = getProperty("ParallelTempering");
+  m_tempering = nChains > 1 && tempering;
+  m_chainLength = getProperty("ChainLength");
+  if (nChains > 1 && !m_tempering) {
+    m_chainLength = (m_chainLength + nChains - 1) / nChains;
+  }
+  if (m_tempering && getProperty("SimAnnealingApplied")) {
+    throw std::invalid_argument("ParallelTempering cannot be used together"
+                                " with Simulated Annealing.");
+  }
+
   // Initialize member variables related to fitting parameters, such as
   // m_chains, m_jump, etc
   initChainsAndParameters();
@@ -173,6 +248,8 @@ void FABADAMinimizer::initialize(API::ICostFunction_sptr function,
   // Initialize member variables related to simulated annealing, such as
   // m_temperature, m_overexploration, etc
   initSimulatedAnnealing();
+  m_baseTemperature = 1.0;
+  m_annealedLength = m_chain[0].size();
 
   // Variable to calculate the total number of iterations required by the
   // SimulatedAnnealing and the posterior chain plus the burn in required
@@ -189,6 +266,8 @@ void FABADAMinimizer::initialize(API::ICostFunction_sptr function,
         " 350 iterations for the burn-in period. Increase"
         " MaxIterations property");
   }
+
+  initOtherChains(nChains);
 }
 
 /** Do one iteration.
@@ -201,13 +280,27 @@ bool FABADAMinimizer::iterate(size_t /*iteration*/) {
     throw std::runtime_error("Cost function isn't set up.");
   }
 
+  if (!m_otherChains.empty()) {
+    return iterateChains();
+  }
+  step();
+
+  // Evaluates if iterations should continue or not
+  return iterationContinuation();
+
+} // Iterate() end
+
+/** Do one iteration of FABADA's algorithm for each parameter of this chain.
+ *
+ */
+void FABADAMinimizer::step() {
+
   size_t m = m_nParams;
 
   // Just for the last iteration. For doing exactly the indicated
   // number of iterations.
   if (m_converged && m_counter == m_chainIterations - 1) {
-    size_t t = getProperty("ChainLength");
-    m = t % m_nParams;
+    m = m_chainLength % m_nParams;
     if (m == 0)
       m = m_nParams;
   }
@@ -302,11 +395,46 @@ bool FABADAMinimizer::iterate(size_t /*iteration*/) {
   if (m_leftRefrPoints != 0 && m_counter == m_simAnnealingItStep) {
     simAnnealingRefrigeration();
   }
+}
 
-  // Evaluates if iterations should continue or not
-  return iterationContinuation();
+/** Do one iteration of all the chains at the same time. With parallel
+ * tempering the iterations go on until this chain has finished and the hotter
+ * chains then exchange their states with it. Otherwise they go on until every
+ * chain has finished.
+ *
+ * @return :: true if iterations must be continued, false otherwise
+ */
+bool FABADAMinimizer::iterateChains() {
+  const auto nChains = static_cast<int>(m_running.size());
+  std::vector<char> running(nChains, false);
+  std::vector<std::exception_ptr> failures(nChains);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < nChains; ++i) {
+    if (!m_running[i])
+      continue;
+    auto &chain = i == 0 ? *this : *m_otherChains[i - 1];
+    try {
+      chain.step();
+      running[i] = (m_tempering && i > 0) || chain.iterationContinuation();
+    } catch (...) {
+      failures[i] = std::current_exception();
+    }
+  }
+  for (const auto &failure : failures) {
+    if (failure) {
+      std::rethrow_exception(failure);
+    }
+  }
+  m_running.assign(running.begin(), running.end());
 
-} // Iterate() end
+  if (m_tempering) {
+    exchangeStates();
+    return m_running.front();
+  }
+  checkChainsConvergence();
+  return std::find(m_running.begin(), m_running.end(), true) !=
+         m_running.end();
+}
 
 double FABADAMinimizer::costFunctionVal() { return m_chi2; }
 
@@ -315,6 +443,10 @@ double FABADAMinimizer::costFunctionVal() { return m_chi2; }
  */
 void FABADAMinimizer::finalize() {
 
+  if (!m_otherChains.empty() && !m_tempering) {
+    mergeChains();
+  }
+
   // Creating the reduced chain (considering only one each
   // "Steps between values" values)
   size_t chainLength = getProperty("ChainLength");
@@ -385,7 +517,8 @@ void FABADAMinimizer::finalize() {
  * @return :: the step
  */
 double FABADAMinimizer::gaussianStep(const double &jump) {
-  return Kernel::normal_distribution<double>(0.0, std::abs(jump))(rng);
+  return Kernel::normal_distribution<double>(0.0, std::abs(jump))(
+      m_randomGenerator);
 }
 
 /** If the new point is out of its bounds, it is changed to fit in the bound
@@ -493,10 +626,7 @@ void FABADAMinimizer::algorithmDisplacement(const size_t &parameterIndex,
 
   // If new Chi square value is lower, jumping directly to new parameter
   if (chi2New < m_chi2) {
-    for (size_t j = 0; j < m_nParams; j++) {
-      m_chain[j].push_back(newParameters.get(j));
-    }
-    m_chain[m_nParams].push_back(chi2New);
+    appendToChain(newParameters, chi2New);
     m_parameters = newParameters;
     m_chi2 = chi2New;
     m_changes[parameterIndex] += 1;
@@ -508,20 +638,15 @@ void FABADAMinimizer::algorithmDisplacement(const size_t &parameterIndex,
     double prob = exp((m_chi2 - chi2New) / (2.0 * m_temperature));
 
     // Decide if changing or not
-    double p = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    double p =
+        std::uniform_real_distribution<double>(0.0, 1.0)(m_randomGenerator);
     if (p <= prob) {
-      for (size_t j = 0; j < m_nParams; j++) {
-        m_chain[j].push_back(newParameters.get(j));
-      }
-      m_chain[m_nParams].push_back(chi2New);
+      appendToChain(newParameters, chi2New);
       m_parameters = newParameters;
       m_chi2 = chi2New;
       m_changes[parameterIndex] += 1;
     } else {
-      for (size_t j = 0; j < m_nParams; j++) {
-        m_chain[j].push_back(m_parameters.get(j));
-      }
-      m_chain[m_nParams].push_back(m_chi2);
+      appendToChain(m_parameters, m_chi2);
       // Old parameters taken again
       for (size_t j = 0; j < m_nParams; ++j) {
         m_fitFunction->setParameter(j, m_parameters.get(j));
@@ -541,6 +666,21 @@ void FABADAMinimizer::algorithmDisplacement(const size_t &parameterIndex,
   }
 }
 
+/** Append a position to the chain, unless the chain is not output.
+ *
+ * @param parameters :: the values of the fitting parameters
+ * @param chi2 :: the value of chi2 at the parameters
+ */
+void FABADAMinimizer::appendToChain(const GSLVector &parameters,
+                                    const double chi2) {
+  if (!m_recordChain)
+    return;
+  for (size_t j = 0; j < m_nParams; j++) {
+    m_chain[j].push_back(parameters.get(j));
+  }
+  m_chain[m_nParams].push_back(chi2);
+}
+
 /** Updates the parameterIndex-th parameter jump if appropriate
  *
  * @param parameterIndex :: the index of the current parameter
@@ -613,24 +753,11 @@ void FABADAMinimizer::convergenceCheck() {
     // consider only the data of the converged part of the chain, when updating
     // the jump.
     if (t == m_nParams) {
-      m_converged = true;
-
       if (ImmobilityConv)
         g_log.warning() << "Convergence detected through immobility."
                            " It might be a bad convergence.\n";
 
-      m_convPoint = m_counterGlobal * m_nParams + 1;
-      m_counter = 0;
-      for (size_t i = 0; i < m_nParams; ++i) {
-        m_changes[i] = 0;
-      }
-
-      // If done with a different temperature, the error would be
-      // wrongly obtained (because the temperature modifies the
-      // chi-square landscape)
-      // Although keeping ergodicity, more iterations will be needed
-      // because a wrong step is initially used.
-      m_temperature = 1.0;
+      setConverged();
     }
 
     // All parameters should converge at the same iteration
@@ -643,6 +770,28 @@ void FABADAMinimizer::convergenceCheck() {
   }
 }
 
+/** Mark the chain as converged. The counter and the changes' vector are set
+ * to 0, in order to consider only the data of the converged part of the chain
+ * when updating the jump.
+ *
+ */
+void FABADAMinimizer::setConverged() {
+  m_converged = true;
+  m_convPoint = m_counterGlobal * m_nParams + 1;
+  m_counter = 0;
+  for (size_t i = 0; i < m_nParams; ++i) {
+    m_changes[i] = 0;
+  }
+
+  // If done with a different temperature, the error would be
+  // wrongly obtained (because the temperature modifies the
+  // chi-square landscape)
+  // Although keeping ergodicity, more iterations will be needed
+  // because a wrong step is initially used.
+  // The hotter chains of parallel tempering keep their own temperature.
+  m_temperature = m_baseTemperature;
+}
+
 /** Refrigerates the system if appropriate
  *
  */
@@ -660,9 +809,10 @@ void FABADAMinimizer::simAnnealingRefrigeration() {
   // Simulated Annealing variables updated
   --m_leftRefrPoints;
   // To avoid numerical error accumulation
-  if (m_leftRefrPoints == 0)
+  if (m_leftRefrPoints == 0) {
     m_temperature = 1.0;
-  else
+    m_annealedLength = m_chain[0].size();
+  } else
     m_temperature /= m_tempStep;
 }
 
@@ -1067,8 +1217,8 @@ void FABADAMinimizer::initChainsAndParameters() {
     m_parameters.resize(m_nParams);
   }
 
-  size_t n = getProperty("ChainLength");
-  m_chainIterations = size_t(ceil(double(n) / double(m_nParams)));
+  m_chainIterations =
+      size_t(ceil(double(m_chainLength) / double(m_nParams)));
 
   // Save parameter constraints
   for (size_t i = 0; i < m_nParams; ++i) {
@@ -1178,6 +1328,171 @@ void FABADAMinimizer::initSimulatedAnnealing() {
   }
 }
 
+/** Create the chains run together with this one. They fit clones of the
+ * fitting function to the same data, each with its own cost function, and
+ * draw their random numbers from their own sequences.
+ *
+ * @param nChains :: the total number of chains
+ */
+void FABADAMinimizer::initOtherChains(size_t nChains) {
+  m_otherChains.clear();
+  m_running.assign(std::max(nChains, size_t(1)), true);
+
+  // The temperatures of parallel tempering grow geometrically
+  double temperatureStep = 1.0;
+  if (m_tempering) {
+    double maxTemperature = getProperty("MaximumTemperature");
+    maxTemperature = std::abs(maxTemperature);
+    if (maxTemperature <= 1.0) {
+      g_log.warning() << "MaximumTemperature must be greater than 1 for"
+                         " parallel tempering. Default (T = 10.0) taken.\n";
+      maxTemperature = 10.0;
+    }
+    temperatureStep = pow(maxTemperature, 1.0 / double(nChains - 1));
+  }
+
+  for (size_t i = 1; i < nChains; ++i) {
+    auto chain = boost::make_shared<FABADAMinimizer>();
+    for (const auto *property : getProperties()) {
+      if (property->direction() == Kernel::Direction::Input) {
+        chain->setPropertyValue(property->name(), property->value());
+      }
+    }
+    chain->setProperty("NumberOfChains", static_cast<size_t>(1));
+    chain->setProperty("ChainLength", m_chainLength);
+    chain->m_chainIndex = i;
+
+    auto costFunction =
+        boost::dynamic_pointer_cast<CostFunctions::CostFuncLeastSquares>(
+            CostFunctionFactory::Instance().create(m_leastSquares->name()));
+    auto values = boost::make_shared<FunctionValues>(
+        *m_leastSquares->getValues());
+    costFunction->setFittingFunction(m_fitFunction->clone(),
+                                     m_leastSquares->getDomain(), values);
+    chain->initialize(costFunction, m_maxIter);
+
+    chain->m_baseTemperature = pow(temperatureStep, double(i));
+    chain->m_temperature = chain->m_baseTemperature;
+    // The hotter chains are never output and would otherwise grow for as
+    // long as the first chain runs
+    chain->m_recordChain = !m_tempering;
+    m_otherChains.push_back(chain);
+  }
+}
+
+/** Propose to exchange the states of neighbouring chains of the temperature
+ * ladder. Even and odd pairs of chains alternate between iterations. The
+ * exchange keeps each chain sampling its own tempered distribution.
+ *
+ */
+void FABADAMinimizer::exchangeStates() {
+  for (size_t i = m_counterGlobal % 2; i < m_otherChains.size(); i += 2) {
+    auto &colder = i == 0 ? *this : *m_otherChains[i - 1];
+    auto &hotter = *m_otherChains[i];
+    const double exponent = (colder.m_chi2 - hotter.m_chi2) *
+                            (1.0 / colder.m_temperature -
+                             1.0 / hotter.m_temperature) /
+                            2.0;
+    double p =
+        std::uniform_real_distribution<double>(0.0, 1.0)(m_randomGenerator);
+    if (p <= exp(exponent)) {
+      std::swap(colder.m_parameters, hotter.m_parameters);
+      std::swap(colder.m_chi2, hotter.m_chi2);
+      colder.setFunctionParameters();
+      hotter.setFunctionParameters();
+    }
+  }
+}
+
+/** Check the convergence of independent chains with the potential scale
+ * reduction factor (R-hat) of Gelman and Rubin, computed from the second
+ * halves of the chains after Simulated Annealing. When it is below
+ * MaximumRHat for every parameter the chains that have not converged yet are
+ * taken to have converged.
+ *
+ */
+void FABADAMinimizer::checkChainsConvergence() {
+  const double maxRHat = getProperty("MaximumRHat");
+  if (maxRHat <= 0.0 || m_counterGlobal % JUMP_CHECKING_RATE != 0 ||
+      std::find(m_running.begin(), m_running.end(), false) !=
+          m_running.end()) {
+    return;
+  }
+  std::vector<FABADAMinimizer *> chains{this};
+  for (const auto &chain : m_otherChains) {
+    chains.push_back(chain.get());
+  }
+  bool converged = true;
+  size_t length = std::numeric_limits<size_t>::max();
+  for (const auto *chain : chains) {
+    if (chain->m_leftRefrPoints != 0)
+      return;
+    converged = converged && chain->m_converged;
+    length =
+        std::min(length, chain->m_chain[0].size() - chain->m_annealedLength);
+  }
+  if (converged || length <= LOWER_CONVERGENCE_LIMIT * m_nParams)
+    return;
+
+  double rHat = 0.0;
+  std::vector<std::vector<double>> halves(chains.size());
+  for (size_t j = 0; j < m_nParams; ++j) {
+    for (size_t i = 0; i < chains.size(); ++i) {
+      const auto &chain = chains[i]->m_chain[j];
+      halves[i].assign(chain.end() - length / 2, chain.end());
+    }
+    rHat = std::max(rHat, potentialScaleReduction(halves));
+  }
+  if (rHat < maxRHat) {
+    g_log.information() << "Chains converged with R-hat = " << rHat
+                        << " after " << m_counterGlobal << " iterations.\n";
+    for (auto *chain : chains) {
+      if (!chain->m_converged)
+        chain->setConverged();
+    }
+  }
+}
+
+/** Append the converged parts of the other chains to this chain, so that the
+ * outputs describe the posterior sampled by all the chains. The complete
+ * chain output holds the whole of this chain followed by the converged parts
+ * of the others.
+ *
+ */
+void FABADAMinimizer::mergeChains() {
+  std::vector<std::vector<double>> convergedParts(m_otherChains.size() + 1);
+  for (size_t j = 0; j <= m_nParams; ++j) {
+    convergedParts[0].assign(m_chain[j].begin() + m_convPoint,
+                             m_chain[j].end());
+    for (size_t i = 0; i < m_otherChains.size(); ++i) {
+      const auto &chain = *m_otherChains[i];
+      convergedParts[i + 1].assign(chain.m_chain[j].begin() + chain.m_convPoint,
+                                   chain.m_chain[j].end());
+    }
+    if (j < m_nParams) {
+      g_log.information() << "R-hat of parameter "
+                          << m_fitFunction->parameterName(j) << " = "
+                          << potentialScaleReduction(convergedParts) << "\n";
+    }
+    for (size_t i = 1; i < convergedParts.size(); ++i) {
+      m_chain[j].insert(m_chain[j].end(), convergedParts[i].begin(),
+                        convergedParts[i].end());
+    }
+  }
+}
+
+/** Set the parameters of the fitting function to the current position of the
+ * chain and notify the cost function.
+ *
+ */
+void FABADAMinimizer::setFunctionParameters() {
+  for (size_t j = 0; j < m_nParams; ++j) {
+    m_fitFunction->setParameter(j, m_parameters.get(j));
+  }
+  boost::static_pointer_cast<MaleableCostFunction>(m_leastSquares)
+      ->setDirtyInherited();
+}
+
 } // namespace FuncMinimisers
 } // namespace CurveFitting
 } // namespace Mantid
@@ -57,6 +57,7 @@ void LevenbergMarquardtMDMinimizer::initialize(API::ICostFunction_sptr function,
   m_mu = 0;
   m_nu = 2.0;
   m_rho = 1.0;
+  m_blocks = BlockArrowSolver(*m_leastSquares->getFittingFunction());
 }
 
 /// Do one iteration.
@@ -157,7 +158,9 @@ bool LevenbergMarquardtMDMinimizer::iterate(size_t /*iteration*/) {
   // To find dx solve the system of linear equations   H * dx == -m_der
   dd *= -1.0;
   try {
-    H.solve(dd, dx);
+    if (!m_blocks.hasBlocks() || !m_blocks.solve(H, dd, dx)) {
+      H.solve(dd, dx);
+    }
   } catch (std::runtime_error &error) {
     m_errorString = error.what();
     return false;
@@ -10,6 +10,7 @@
 #include "MantidCurveFitting/Functions/BackToBackExponential.h"
 #include "MantidAPI/FunctionFactory.h"
 
+#include <algorithm>
 #include <cmath>
 #include <gsl/gsl_multifit_nlin.h>
 #include <gsl/gsl_sf_erf.h>
@@ -90,55 +91,113 @@ void BackToBackExponential::setFwhm(const double w) {
 
 void BackToBackExponential::function1D(double *out, const double *xValues,
                                        const size_t nData) const {
-  /*
-    const double& I = getParameter("I");
-    const double& a = getParameter("A");
-    const double& b = getParameter("B");
-    const double& x0 = getParameter("X0");
-    const double& s = getParameter("S");
-  */
+  std::fill(out, out + nData, 0.0);
+  function1DAdd(out, xValues, nData);
+}
 
+/**
+ * Add the peak to the output. Points further than the extent of the peak
+ * from its centre are left unchanged.
+ */
+void BackToBackExponential::function1DAdd(double *out, const double *xValues,
+                                          const size_t nData) const {
   const double I = getParameter(0);
   const double a = getParameter(1);
   const double b = getParameter(2);
   const double x0 = getParameter(3);
   const double s = getParameter(4);
 
-  // find the reasonable extent of the peak ~100 fwhm
-  double extent = expWidth();
-  if (s > extent)
-    extent = s;
-  extent *= 100;
-
-  double s2 = s * s;
+  const double extent = this->extent();
+  const double s2 = s * s;
+  const double invSqrt2S = 1.0 / sqrt(2 * s2);
   double normFactor = a * b / (a + b) / 2;
   // Needed for IntegratePeaksMD for cylinder profile fitted with b=0
   if (normFactor == 0.0)
     normFactor = 1.0;
-  for (size_t i = 0; i < nData; i++) {
-    double diff = xValues[i] - x0;
+  const double scale = I * normFactor;
+  const auto range = getLocalRange(xValues, nData, extent);
+  for (size_t i = range.first; i < range.second; i++) {
+    const double diff = xValues[i] - x0;
     if (fabs(diff) < extent) {
       double val = 0.0;
-      double arg1 = a / 2 * (a * s2 + 2 * diff);
-      val += exp(arg1 + gsl_sf_log_erfc((a * s2 + diff) /
-                                        sqrt(2 * s2))); // prevent overflow
-      double arg2 = b / 2 * (b * s2 - 2 * diff);
-      val += exp(arg2 + gsl_sf_log_erfc((b * s2 - diff) /
-                                        sqrt(2 * s2))); // prevent overflow
-      out[i] = I * val * normFactor;
-    } else
-      out[i] = 0.0;
+      const double arg1 = a / 2 * (a * s2 + 2 * diff);
+      val += exp(arg1 + gsl_sf_log_erfc((a * s2 + diff) *
+                                        invSqrt2S)); // prevent overflow
+      const double arg2 = b / 2 * (b * s2 - 2 * diff);
+      val += exp(arg2 + gsl_sf_log_erfc((b * s2 - diff) *
+                                        invSqrt2S)); // prevent overflow
+      out[i] += scale * val;
+    }
   }
 }
 
 /**
- * Evaluate function derivatives numerically.
+ * Evaluate function derivatives analytically. The derivatives of the
+ * complementary error functions combine with their exponential factors into
+ * the gaussian exp(-diff^2/(2 S^2)).
  */
 void BackToBackExponential::functionDeriv1D(Jacobian *jacobian,
                                             const double *xValues,
                                             const size_t nData) {
-  FunctionDomain1DView domain(xValues, nData);
-  this->calNumericalDeriv(domain, *jacobian);
+  const double I = getParameter(0);
+  const double a = getParameter(1);
+  const double b = getParameter(2);
+  const double x0 = getParameter(3);
+  const double s = getParameter(4);
+
+  const double extent = this->extent();
+  const double s2 = s * s;
+  const double invSqrt2S = 1.0 / sqrt(2 * s2);
+  double normFactor = a * b / (a + b) / 2;
+  // derivatives of the normalisation factor with respect to A and B
+  double dNormdA = b * b / (a + b) / (a + b) / 2;
+  double dNormdB = a * a / (a + b) / (a + b) / 2;
+  // Needed for IntegratePeaksMD for cylinder profile fitted with b=0
+  if (normFactor == 0.0) {
+    normFactor = 1.0;
+    dNormdA = 0.0;
+    dNormdB = 0.0;
+  }
+  // 2/sqrt(pi) from the derivative of erfc
+  const double erfcFactor = M_2_SQRTPI;
+  for (size_t i = 0; i < nData; i++) {
+    const double diff = xValues[i] - x0;
+    if (fabs(diff) < extent) {
+      const double e1 = exp(a / 2 * (a * s2 + 2 * diff) +
+                            gsl_sf_log_erfc((a * s2 + diff) * invSqrt2S));
+      const double e2 = exp(b / 2 * (b * s2 - 2 * diff) +
+                            gsl_sf_log_erfc((b * s2 - diff) * invSqrt2S));
+      const double gauss =
+          erfcFactor * exp(-diff * diff / (2 * s2)) * invSqrt2S;
+      const double sum = e1 + e2;
+      jacobian->set(i, 0, normFactor * sum);
+      jacobian->set(i, 1,
+                    I * (dNormdA * sum +
+                         normFactor * (e1 * (a * s2 + diff) - gauss * s2)));
+      jacobian->set(i, 2,
+                    I * (dNormdB * sum +
+                         normFactor * (e2 * (b * s2 - diff) - gauss * s2)));
+      jacobian->set(i, 3, I * normFactor * (b * e2 - a * e1));
+      jacobian->set(i, 4, I * normFactor *
+                              (s * (a * a * e1 + b * b * e2) -
+                               gauss * s * (a + b)));
+    } else {
+      for (size_t j = 0; j < 5; ++j)
+        jacobian->set(i, j, 0.0);
+    }
+  }
+}
+
+/**
+ * The distance from the centre beyond which the peak is taken to be zero:
+ * 100 times the larger of the exponential and gaussian widths.
+ */
+double BackToBackExponential::extent() const {
+  double extent = expWidth();
+  const double s = getParameter(4);
+  if (s > extent)
+    extent = s;
+  return extent * 100;
 }
 
 /**
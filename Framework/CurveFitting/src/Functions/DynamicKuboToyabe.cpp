@@ -8,9 +8,16 @@
 #include "MantidAPI/FunctionFactory.h"
 #include "MantidAPI/Jacobian.h"
 #include "MantidAPI/MatrixWorkspace.h"
+#include "MantidCurveFitting/Functions/StaticKuboToyabeTable.h"
 #include "MantidKernel/PhysicalConstants.h"
+#include "MantidKernel/make_unique.h"
 
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
 #include <iomanip>
+#include <limits>
+#include <mutex>
 #include <sstream>
 #include <vector>
 
@@ -33,111 +40,9 @@ void DynamicKuboToyabe::init() {
   declareParameter("Nu", 0.0, "Hopping rate");
 }
 
-//--------------------------------------------------------------------------------------------------------------------------------------
-// From Numerical Recipes
-
-// Midpoint method
-double midpnt(double func(const double, const double, const double),
-              const double a, const double b, const int n, const double g,
-              const double w0) {
-  // quote & modified from numerical recipe 2nd edtion (page147)
-
-  static double s;
-
-  if (n == 1) {
-    s = (b - a) * func(0.5 * (a + b), g, w0);
-    return (s);
-  } else {
-    double x, tnm, sum, del, ddel;
-    int it, j;
-    for (it = 1, j = 1; j < n - 1; j++)
-      it *= 3;
-    tnm = it;
-    del = (b - a) / (3 * tnm);
-    ddel = del + del;
-    x = a + 0.5 * del;
-    sum = 0.0;
-    for (j = 1; j <= it; j++) {
-      sum += func(x, g, w0);
-      x += ddel;
-      sum += func(x, g, w0);
-      x += del;
-    }
-    s = (s + (b - a) * sum / tnm) / 3.0;
-    return s;
-  }
-}
-
-// Polynomial interpolation
-void polint(double xa[], double ya[], int n, double x, double &y, double &dy) {
-  int i, m, ns = 1;
-  double dif;
-
-  dif = fabs(x - xa[1]);
-  std::vector<double> c(n + 1);
-  std::vector<double> d(n + 1);
-  for (i = 1; i <= n; i++) {
-    double dift;
-    if ((dift = fabs(x - xa[i])) < dif) {
-      ns = i;
-      dif = dift;
-    }
-    c[i] = ya[i];
-    d[i] = ya[i];
-  }
-  y = ya[ns--];
-  for (m = 1; m < n; m++) {
-    for (i = 1; i <= n - m; i++) {
-      double den, ho, hp, w;
-      ho = xa[i] - x;
-      hp = xa[i + m] - x;
-      w = c[i + 1] - d[i];
-      if ((den = ho - hp) == 0.0) { // error message!!!
-        throw std::runtime_error("Error in routin polint");
-      }
-      den = w / den;
-      d[i] = hp * den;
-      c[i] = ho * den;
-    }
-    y += (dy = (2 * (ns) < (n - m) ? c[ns + 1] : d[ns--]));
-  }
-}
-
-// Integration
-double integral(double func(const double, const double, const double),
-                const double a, const double b, const double g,
-                const double w0) {
-
-  const int JMAX = 14;
-  const int JMAXP = JMAX + 1;
-  const int K = 5;
-
-  int j;
-  double ss, dss;
-  double h[JMAXP + 1], s[JMAXP];
-
-  h[1] = 1.0;
-  for (j = 1; j <= JMAX; j++) {
-    s[j] = midpnt(func, a, b, j, g, w0);
-    if (j >= K) {
-      polint(&h[j - K], &s[j - K], K, 0.0, ss, dss);
-      if (fabs(dss) <= fabs(ss))
-        return ss;
-    }
-    h[j + 1] = h[j] / 9.0;
-  }
-  throw std::runtime_error("Too many steps in routine integrate");
-}
-
-// End of Numerical Recipes routines
-//--------------------------------------------------------------------------------------------------------------------------------------
-
-// f1: function to integrate
-double f1(const double x, const double G, const double w0) {
-  // G = Delta in doc
-  // x = dummy time variable
-  return (exp(-G * G * x * x / 2) * sin(w0 * x));
-}
+namespace {
+// Muon gyromagnetic ratio * 2 * PI
+const double GM = 2 * M_PI * PhysicalConstants::MuonGyromagneticRatio;
 
 // Static Zero Field Kubo Toyabe relaxation function
 // Also called Lorentzian Kubo-Toyabe
@@ -147,108 +52,136 @@ double ZFKT(const double x, const double G) {
   return (0.3333333333 + 0.6666666667 * exp(-0.5 * q) * (1 - q));
 }
 
-// Static non-zero field Kubo Toyabe relaxation function
-double HKT(const double x, const double G, const double F) {
-  // q = Delta^2 t^2 in doc
-  const double q = G * G * x * x;
-  // Muon gyromagnetic ratio * 2 * PI
-  const double gm = 2 * M_PI * PhysicalConstants::MuonGyromagneticRatio;
-  // w = omega_0 in doc
-  double w;
-  if (F > 2 * G) {
-    // Use F
-    w = gm * F;
-  } else {
-    // Use G
-    w = gm * 2 * G;
-  }
-  // r = Delta^2/omega_0^2
-  const double r = G * G / w / w;
+// The static relaxation in fields weaker than 2 * Delta, where omega_0 is
+// taken as gm * 2 * Delta. Its master curve is the same for all parameters.
+const StaticKuboToyabeTable &weakFieldTable() {
+  static const StaticKuboToyabeTable table(2 * GM,
+                                           std::numeric_limits<double>::max());
+  return table;
+}
 
-  double ig;
-  if (x > 0 && r > 0) {
-    // Compute integral
-    ig = integral(f1, 0.0, x, G, w);
-  } else {
-    // Integral is 0
-    ig = 0;
+// Static non-zero field Kubo Toyabe relaxation function. The table of the
+// relaxation in a longitudinal Gaussian field is only needed for F > 2 * G.
+double HKT(const double x, const double G, const double F,
+           const StaticKuboToyabeTable *strongField) {
+  if (G == 0.0) {
+    return 1.0;
   }
-
-  const double ktb =
-      (1 - 2 * r * (1 - exp(-q / 2) * cos(w * x)) + 2 * r * r * w * ig);
-
   if (F > 2 * G) {
     // longitudinal Gaussian field
-    return ktb;
-  } else {
-    //
-    const double kz = ZFKT(x, G);
-    return kz + F / 2 / G * (ktb - kz);
+    return (*strongField)(G * x);
   }
+  const double kz = ZFKT(x, G);
+  return kz + F / 2 / G * (weakFieldTable()(G * x) - kz);
+}
+} // namespace
+
+/// The tables of the last evaluation. They are shared by the threads
+/// evaluating the function.
+struct DynamicKuboToyabe::Cache {
+  std::mutex mutex;
+  /// The static relaxation in a strong field and the range it covers
+  boost::shared_ptr<const StaticKuboToyabeTable> field;
+  double fieldMaxTau = 0.;
+  /// The static and dynamic relaxations at multiples of the bin width
+  std::vector<double> gStat;
+  boost::shared_ptr<const std::vector<double>> gDyn;
+  /// The parameters and bin width the relaxations were computed with
+  double G = -1., F = -1., v = -1., eps = -1.;
+};
+
+/** The static relaxation in a longitudinal field stronger than 2 * Delta. The
+ * table is reused while F / G does not change and covers the reduced times.
+ * @param G :: Delta
+ * @param F :: The field
+ * @param maxTau :: The largest reduced time, Delta * t
+ * @return :: The table, or null if the field is not stronger than 2 * Delta
+ */
+boost::shared_ptr<const StaticKuboToyabeTable>
+DynamicKuboToyabe::fieldTable(double G, double F, double maxTau) const {
+  if (!(F > 2 * G) || G == 0.0) {
+    return nullptr;
+  }
+  const double b = GM * F / G;
+  std::lock_guard<std::mutex> lock(m_cache->mutex);
+  auto &table = m_cache->field;
+  if (!table || table->b() != b || m_cache->fieldMaxTau < maxTau) {
+    table = boost::make_shared<StaticKuboToyabeTable>(b, maxTau);
+    m_cache->fieldMaxTau = maxTau;
+  }
+  return table;
 }
 
-// Dynamic Kubo-Toyabe
-double DynamicKuboToyabe::getDKT(double t, double G, double F, double v,
-                                 double eps) const {
-
-  const int tsmax = static_cast<int>(std::ceil(32.768 / eps));
-
-  static double oldG = -1., oldV = -1., oldF = -1., oldEps = -1.;
-
-  const int maxTsmax = static_cast<int>(std::ceil(32.768 / m_minEps));
-  static std::vector<double> gStat(maxTsmax), gDyn(maxTsmax);
-
-  if ((G != oldG) || (v != oldV) || (F != oldF) || (eps != oldEps)) {
-
-    // If G or v or F or eps have changed with respect to the
-    // previous call, we need to re-do the computations
-
-    if (G != oldG || (F != oldF)) {
-
-      // But we only need to
-      // re-compute gStat if G or F have changed
+/** The dynamic Kubo-Toyabe relaxation at the times k * eps, k < n. The static
+ * relaxation is only recomputed if G, F or eps have changed with respect to
+ * the previous call, and the dynamic one if v has changed too.
+ * @param G :: Delta
+ * @param F :: The field
+ * @param v :: The hopping rate
+ * @param n :: The number of times
+ */
+boost::shared_ptr<const std::vector<double>>
+DynamicKuboToyabe::dynamicTable(double G, double F, double v,
+                                size_t n) const {
+  const double eps = m_eps;
+  auto &cache = *m_cache;
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  const bool sameStatic = G == cache.G && F == cache.F && eps == cache.eps;
+  if (sameStatic && v == cache.v && cache.gDyn && cache.gDyn->size() >= n) {
+    return cache.gDyn;
+  }
 
-      // Generate static Kubo-Toyabe
-      if (F == 0) {
-        for (int k = 0; k < tsmax; k++) {
-          gStat[k] = ZFKT(k * eps, G);
-        }
-      } else {
-        for (int k = 0; k < tsmax; k++) {
-          gStat[k] = HKT(k * eps, G, F);
-        }
+  if (!sameStatic || cache.gStat.size() < n) {
+    // Generate static Kubo-Toyabe
+    cache.gStat.resize(n);
+    if (F == 0) {
+      for (size_t k = 0; k < n; k++) {
+        cache.gStat[k] = ZFKT(static_cast<double>(k) * eps, G);
       }
-      // Store new G value
-      oldG = G;
-      // Store new F value
-      oldF = F;
-    }
-
-    // Store new v value
-    oldV = v;
-    // Store new eps value
-    oldEps = eps;
-
-    double hop = v * eps;
-
-    // Generate dynamic Kubo Toyabe
-    for (int k = 0; k < tsmax; k++) {
-      double y = gStat[k];
-      // do integration
-      for (int j = k - 1; j > 0; j--) {
-        y = y * (1 - hop) + hop * gDyn[k - j] * gStat[j];
+    } else {
+      std::unique_ptr<StaticKuboToyabeTable> strongField;
+      if (F > 2 * G && G != 0.0) {
+        strongField = Kernel::make_unique<StaticKuboToyabeTable>(
+            GM * F / G, G * eps * static_cast<double>(n - 1));
+      }
+      for (size_t k = 0; k < n; k++) {
+        cache.gStat[k] =
+            HKT(static_cast<double>(k) * eps, G, F, strongField.get());
       }
-      gDyn[k] = y;
     }
+    cache.G = G;
+    cache.F = F;
+    cache.eps = eps;
   }
 
-  // Interpolate table
-  // If beyond end, extrapolate
-  int x = int(fabs(t) / eps);
-  if (x > tsmax - 2)
-    x = tsmax - 2;
-  double xe = (fabs(t) / eps) - x;
-  return gDyn[x] * (1 - xe) + xe * gDyn[x + 1];
+  // Generate dynamic Kubo Toyabe. The integration
+  //   y = gStat[k]; y = y * (1 - hop) + hop * gDyn[k - j] * gStat[j]
+  // for j from k - 1 down to 1 is expanded into a sum of
+  // weights[j] * gDyn[k - j], weights[j] = hop * (1 - hop)^(j - 1) * gStat[j],
+  // which does not wait for the previous step.
+  const auto &gStat = cache.gStat;
+  const double hop = v * eps;
+  std::vector<double> weights(n);
+  double decay = 1.0;
+  for (size_t j = 1; j < n; j++) {
+    weights[j] = hop * decay * gStat[j];
+    decay *= 1 - hop;
+  }
+  auto table = boost::make_shared<std::vector<double>>(n);
+  auto &gDyn = *table;
+  gDyn[0] = gStat[0];
+  decay = 1.0;
+  for (size_t k = 1; k < n; k++) {
+    double y = decay * gStat[k];
+    for (size_t j = 1; j < k; j++) {
+      y += weights[j] * gDyn[k - j];
+    }
+    gDyn[k] = y;
+    decay *= 1 - hop;
+  }
+  cache.v = v;
+  cache.gDyn = table;
+  return table;
 }
 
 // Dynamic Kubo Toyabe function
@@ -259,6 +192,11 @@ void DynamicKuboToyabe::function1D(double *out, const double *xValues,
   const double &F = fabs(getParameter("Field"));
   const double &v = fabs(getParameter("Nu"));
 
+  double maxTime = 0.0;
+  for (size_t i = 0; i < nData; i++) {
+    maxTime = std::max(maxTime, fabs(xValues[i]));
+  }
+
   // Zero hopping rate
   if (v == 0.0) {
 
@@ -270,17 +208,30 @@ void DynamicKuboToyabe::function1D(double *out, const double *xValues,
     }
     // Non-zero external field
     else {
+      const auto strongField = fieldTable(G, F, G * maxTime);
       for (size_t i = 0; i < nData; i++) {
-        out[i] = A * HKT(xValues[i], G, F);
+        out[i] = A * HKT(xValues[i], G, F, strongField.get());
       }
     }
   }
 
   // Non-zero hopping rate
   else {
+    const double eps = m_eps;
+    const int tsmax = static_cast<int>(std::ceil(32.768 / eps));
+    // Only the times up to the last x are tabulated
+    const int n = std::min(tsmax, int(maxTime / eps) + 2);
+    const auto gDyn = dynamicTable(G, F, v, static_cast<size_t>(n));
 
     for (size_t i = 0; i < nData; i++) {
-      out[i] = A * getDKT(xValues[i], G, F, v, m_eps);
+      // Interpolate table
+      // If beyond end, extrapolate
+      const double t = fabs(xValues[i]);
+      int x = int(t / eps);
+      if (x > tsmax - 2)
+        x = tsmax - 2;
+      double xe = (t / eps) - x;
+      out[i] = A * ((*gDyn)[x] * (1 - xe) + xe * (*gDyn)[x + 1]);
     }
   }
 }
@@ -289,7 +240,8 @@ void DynamicKuboToyabe::function1D(double *out, const double *xValues,
 /** Constructor
  */
 DynamicKuboToyabe::DynamicKuboToyabe()
-    : m_eps(0.05), m_minEps(0.001), m_maxEps(0.1) {}
+    : m_eps(0.05), m_minEps(0.001), m_maxEps(0.1),
+      m_cache(boost::make_shared<Cache>()) {}
 
 //----------------------------------------------------------------------------------------------
 /** Function to calculate derivative numerically
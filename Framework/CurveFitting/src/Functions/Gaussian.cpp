@@ -36,10 +36,11 @@ void Gaussian::functionLocal(double *out, const double *xValues,
   const double height = getParameter("Height");
   const double peakCentre = getParameter("PeakCentre");
   const double weight = pow(1 / getParameter("Sigma"), 2);
+  const double factor = -0.5 * weight;
 
   for (size_t i = 0; i < nData; i++) {
-    double diff = xValues[i] - peakCentre;
-    out[i] = height * exp(-0.5 * diff * diff * weight);
+    const double diff = xValues[i] - peakCentre;
+    out[i] = height * exp(factor * diff * diff);
   }
 }
 
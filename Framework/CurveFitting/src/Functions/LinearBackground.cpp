@@ -37,6 +37,21 @@ void LinearBackground::function1D(double *out, const double *xValues,
   }
 }
 
+void LinearBackground::functionAdd(const FunctionDomain &domain,
+                                   FunctionValues &values) const {
+  functionAdd1D(domain, values);
+}
+
+void LinearBackground::function1DAdd(double *out, const double *xValues,
+                                     const size_t nData) const {
+  const double a0 = getParameter(0);
+  const double a1 = getParameter(1);
+
+  for (size_t i = 0; i < nData; i++) {
+    out[i] += a0 + a1 * xValues[i];
+  }
+}
+
 void LinearBackground::functionDeriv1D(Jacobian *out, const double *xValues,
                                        const size_t nData) {
   for (size_t i = 0; i < nData; i++) {
@@ -81,10 +81,11 @@ void Lorentzian::functionLocal(double *out, const double *xValues,
   const double halfGamma = 0.5 * getParameter("FWHM");
 
   const double invPI = 1.0 / M_PI;
+  const double scale = amplitude * invPI * halfGamma;
+  const double halfGammaSquared = halfGamma * halfGamma;
   for (size_t i = 0; i < nData; i++) {
-    double diff = (xValues[i] - peakCentre);
-    out[i] =
-        amplitude * invPI * halfGamma / (diff * diff + (halfGamma * halfGamma));
+    const double diff = (xValues[i] - peakCentre);
+    out[i] = scale / (diff * diff + halfGammaSquared);
   }
 }
 
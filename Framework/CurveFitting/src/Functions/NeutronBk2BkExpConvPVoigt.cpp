@@ -321,11 +321,11 @@ void NeutronBk2BkExpConvPVoigt::setParameter(const std::string &name,
 }
 
 //----------------------------------------------------------------------------------------------
-/** Function (local) of the vector version
- * @param out: The calculated peak intensities. This is assume to been
- * initialized to the correct length
- * with a value of zero everywhere.
- * @param xValues: The x-values to evaluate the peak at.
+/** Function (local) of the vector version. The peak is added to the output
+ * within its range, which is found by bisection.
+ * @param out: The calculated peak intensities. This is assumed to be
+ * initialized to the correct length.
+ * @param xValues: The x-values to evaluate the peak at, in ascending order.
  */
 void NeutronBk2BkExpConvPVoigt::function(vector<double> &out,
                                          const vector<double> &xValues) const {
@@ -351,8 +351,8 @@ void NeutronBk2BkExpConvPVoigt::function(vector<double> &out,
   // Calcualte
   std::size_t pos(std::distance(xValues.begin(), iter)); // second loop variable
   for (; iter != iter_end; ++iter) {
-    out[pos] = HEIGHT * calOmega(*iter - m_centre, m_eta, m_N, m_Alpha, m_Beta,
-                                 m_fwhm, m_Sigma2, INVERT_SQRT2SIGMA);
+    out[pos] += HEIGHT * calOmega(*iter - m_centre, m_eta, m_N, m_Alpha,
+                                  m_Beta, m_fwhm, m_Sigma2, INVERT_SQRT2SIGMA);
     pos++;
   } // ENDFOR data points
 }
@@ -20,6 +20,9 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/make_shared.hpp>
 
+#include <algorithm>
+#include <limits>
+
 namespace Mantid {
 namespace CurveFitting {
 namespace Functions {
@@ -490,6 +493,99 @@ void PawleyFunction::function(const FunctionDomain &domain,
   }
 }
 
+/**
+ * Calculates the derivatives on the supplied domain
+ *
+ * The derivatives with respect to the profile parameters of a peak are only
+ * non-zero within the peak radius, where the peak function calculates them.
+ * The lattice parameters and ZeroShift move all peaks, so the derivatives
+ * with respect to them are calculated numerically. If any parameter is tied
+ * all derivatives are calculated numerically.
+ *
+ * @param domain :: Function domain.
+ * @param jacobian :: Jacobian to store the derivatives in.
+ */
+void PawleyFunction::functionDeriv(const FunctionDomain &domain,
+                                   Jacobian &jacobian) {
+  auto domain1D = dynamic_cast<const FunctionDomain1D *>(&domain);
+  bool hasTies = false;
+  for (size_t i = 0; i < nParams() && !hasTies; ++i) {
+    hasTies = getTie(i) != nullptr;
+  }
+  if (!domain1D || hasTies) {
+    calNumericalDeriv(domain, jacobian);
+    return;
+  }
+
+  // Lattice parameters and ZeroShift
+  constexpr double epsilon = std::numeric_limits<double>::epsilon() * 100;
+  constexpr double stepPercentage = 0.001;
+  constexpr double cutoff =
+      100.0 * std::numeric_limits<double>::min() / stepPercentage;
+  const size_t nData = domain1D->size();
+  FunctionValues minusStep(domain);
+  FunctionValues plusStep(domain);
+  function(domain, minusStep);
+  const size_t nCellParams = m_pawleyParameterFunction->nParams();
+  for (size_t iP = 0; iP < nCellParams; ++iP) {
+    if (!isActive(iP)) {
+      continue;
+    }
+    const double val = activeParameter(iP);
+    const double step = fabs(val) < cutoff ? epsilon : val * stepPercentage;
+    const double paramPstep = val + step;
+    setActiveParameter(iP, paramPstep);
+    function(domain, plusStep);
+    setActiveParameter(iP, val);
+    for (size_t i = 0; i < nData; ++i) {
+      jacobian.set(i, iP,
+                   (plusStep.getCalculated(i) - minusStep.getCalculated(i)) /
+                       (paramPstep - val));
+    }
+  }
+
+  // Profile parameters of the peaks, at the peak positions of function()
+  UnitCell cell = m_pawleyParameterFunction->getUnitCellFromParameters();
+  double zeroShift = m_pawleyParameterFunction->getParameter("ZeroShift");
+  std::string centreName =
+      m_pawleyParameterFunction->getProfileFunctionCenterParameterName();
+  setPeakPositions(centreName, zeroShift, cell);
+
+  const double *domainBegin = domain1D->getPointerAt(0);
+  const double *domainEnd = domainBegin + nData;
+  size_t offset = nCellParams;
+  for (size_t i = 0; i < m_peakProfileComposite->nFunctions(); ++i) {
+    IPeakFunction_sptr peak = boost::dynamic_pointer_cast<IPeakFunction>(
+        m_peakProfileComposite->getFunction(i));
+
+    double centre = peak->centre();
+    double dx = m_peakRadius * peak->fwhm();
+    auto lb = std::lower_bound(domainBegin, domainEnd, centre - dx);
+    auto ub = std::upper_bound(lb, domainEnd, centre + dx);
+    const auto first = static_cast<size_t>(std::distance(domainBegin, lb));
+    const auto last = static_cast<size_t>(std::distance(domainBegin, ub));
+
+    for (size_t iY = 0; iY < nData; ++iY) {
+      if (iY < first || iY >= last) {
+        for (size_t iP = 0; iP < peak->nParams(); ++iP) {
+          jacobian.set(iY, offset + iP, 0.0);
+        }
+      }
+    }
+    if (first < last) {
+      // Through functionDeriv, which falls back to numerical derivatives for
+      // the profiles that do not implement functionDerivLocal
+      FunctionDomain1DView window(lb, last - first);
+      window.setPeakRadius(domain1D->getPeakRadius());
+      PartialJacobian localJacobian(&jacobian, first, offset);
+      peak->functionDeriv(window, localJacobian);
+    }
+    offset += peak->nParams();
+  }
+
+  setPeakPositions(centreName, 0.0, cell);
+}
+
 /// Removes all peaks from the function.
 void PawleyFunction::clearPeaks() {
   m_peakProfileComposite = boost::dynamic_pointer_cast<CompositeFunction>(
@@ -38,11 +38,15 @@ void PseudoVoigt::functionLocal(double *out, const double *xValues,
   // Gaussian parameter sigma...fwhm/(2*sqrt(2*ln(2)))...gamma/sqrt(2*ln(2))
   double sSquared = gSquared / (2.0 * M_LN2);
 
+  const double gaussFactor = -0.5 / sSquared;
+  const double gaussHeight = h * gFraction;
+  const double lorentzNumerator = h * lFraction * gSquared;
   for (size_t i = 0; i < nData; ++i) {
-    double xDiffSquared = (xValues[i] - x0) * (xValues[i] - x0);
+    const double xDiff = xValues[i] - x0;
+    const double xDiffSquared = xDiff * xDiff;
 
-    out[i] = h * (gFraction * exp(-0.5 * xDiffSquared / sSquared) +
-                  (lFraction * gSquared / (xDiffSquared + gSquared)));
+    out[i] = gaussHeight * exp(gaussFactor * xDiffSquared) +
+             lorentzNumerator / (xDiffSquared + gSquared);
   }
 }
 
@@ -0,0 +1,117 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidCurveFitting/Functions/StaticKuboToyabeTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Mantid {
+namespace CurveFitting {
+namespace Functions {
+
+namespace {
+/// The reduced time beyond which exp(-tau^2 / 2) is negligible
+const double MAX_TAU = 10.0;
+/// The maximum phase of sin(b u) over one integration panel
+const double MAX_PANEL_PHASE = 1.0;
+/// The nodes and weights of the 5-point Gauss-Legendre rule on [-1, 1]
+const double GAUSS_NODES[] = {0.0, 0.5384693101056831, -0.5384693101056831,
+                              0.9061798459386640, -0.9061798459386640};
+const double GAUSS_WEIGHTS[] = {0.5688888888888889, 0.4786286704993665,
+                                0.4786286704993665, 0.2369268850561891,
+                                0.2369268850561891};
+
+double integrand(double u, double b) { return exp(-u * u / 2) * sin(b * u); }
+} // namespace
+
+/**
+ * Tabulate the relaxation.
+ * @param b :: The ratio of the Larmor frequency to the field distribution
+ * width, w / D
+ * @param maxTau :: The largest reduced time the table is used for
+ * @param tolerance :: The largest error of the relaxation
+ * @throw std::invalid_argument if b is not positive
+ */
+StaticKuboToyabeTable::StaticKuboToyabeTable(double b, double maxTau,
+                                             double tolerance)
+    : m_b(b), m_step(0.0) {
+  if (!(b > 0.0)) {
+    throw std::invalid_argument(
+        "StaticKuboToyabeTable: b must be positive.");
+  }
+  // The integral is bounded by sqrt(pi / 2) and enters the relaxation
+  // multiplied by 2 / b^3: in strong fields it can be dropped
+  const double weight = 2.0 / (b * b * b);
+  if (weight * sqrt(M_PI / 2) <= tolerance) {
+    return;
+  }
+  // The error of cubic Hermite interpolation is at most
+  // h^4 / 384 * max|I''''| and |I''''| <= (b + 2)^3
+  m_step = pow(384.0 * tolerance / weight, 0.25) / pow(b + 2, 0.75);
+  maxTau = std::min(std::max(maxTau, 0.0), MAX_TAU);
+  const auto n = static_cast<size_t>(ceil(maxTau / m_step)) + 1;
+  // Integrate each step over panels short compared to a period of sin(b u)
+  const auto nPanels = static_cast<size_t>(
+      ceil(m_step * std::max(b, 1.0) / MAX_PANEL_PHASE));
+  const double halfWidth = m_step / static_cast<double>(nPanels) / 2;
+
+  m_integral.resize(n);
+  m_integrand.resize(n);
+  m_integral[0] = 0.0;
+  m_integrand[0] = 0.0;
+  for (size_t k = 1; k < n; ++k) {
+    double sum = 0.0;
+    double centre = static_cast<double>(k - 1) * m_step + halfWidth;
+    for (size_t panel = 0; panel < nPanels; ++panel) {
+      for (size_t i = 0; i < 5; ++i) {
+        sum += GAUSS_WEIGHTS[i] *
+               integrand(centre + halfWidth * GAUSS_NODES[i], b);
+      }
+      centre += 2 * halfWidth;
+    }
+    m_integral[k] = m_integral[k - 1] + halfWidth * sum;
+    m_integrand[k] = integrand(static_cast<double>(k) * m_step, b);
+  }
+}
+
+/**
+ * Interpolate the integral of exp(-u^2 / 2) sin(b u) from 0 to tau.
+ * @param tau :: The reduced time, D t
+ */
+double StaticKuboToyabeTable::integral(double tau) const {
+  if (tau <= 0.0 || m_integral.empty()) {
+    return 0.0;
+  }
+  const double position = tau / m_step;
+  const size_t last = m_integral.size() - 1;
+  if (position >= static_cast<double>(last)) {
+    return m_integral[last];
+  }
+  const auto k = static_cast<size_t>(position);
+  const double s = position - static_cast<double>(k);
+  const double s2 = s * s;
+  const double s3 = s2 * s;
+  return (2 * s3 - 3 * s2 + 1) * m_integral[k] +
+         (s3 - 2 * s2 + s) * m_step * m_integrand[k] +
+         (3 * s2 - 2 * s3) * m_integral[k + 1] +
+         (s3 - s2) * m_step * m_integrand[k + 1];
+}
+
+/**
+ * The relaxation at a reduced time.
+ * @param tau :: The reduced time, D t
+ */
+double StaticKuboToyabeTable::operator()(double tau) const {
+  const double r = 1.0 / (m_b * m_b);
+  return 1.0 - 2 * r * (1.0 - exp(-tau * tau / 2) * cos(m_b * tau)) +
+         2 * r / m_b * integral(tau);
+}
+
+} // namespace Functions
+} // namespace CurveFitting
+} // namespace Mantid
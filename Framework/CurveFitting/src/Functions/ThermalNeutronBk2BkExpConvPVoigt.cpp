@@ -5,7 +5,9 @@
 //     & Institut Laue - Langevin
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidCurveFitting/Functions/ThermalNeutronBk2BkExpConvPVoigt.h"
+#include "MantidAPI/CompositeFunction.h"
 #include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/FunctionValues.h"
 #include "MantidAPI/ParamFunction.h"
 #include "MantidKernel/EmptyValues.h"
 #include "MantidKernel/Logger.h"
@@ -13,6 +15,7 @@
 #include "MantidKernel/ConfigService.h"
 
 #include <boost/lexical_cast.hpp>
+#include <algorithm>
 #include <cmath>
 #include <gsl/gsl_sf_erf.h>
 
@@ -416,11 +419,32 @@ void ThermalNeutronBk2BkExpConvPVoigt::functionLocal(double *out,
 }
 
 //----------------------------------------------------------------------------------------------
-/** Function (local) of the vector version
- * @param out: The calculated peak intensities. This is assume to been
- * initialized to the correct length
- * with a value of zero everywhere.
- * @param xValues: The x-values to evaluate the peak at.
+/** Calculate the peak on a domain. On a sorted domain the points within the
+ * peak radius are found by bisection and only they are touched.
+ */
+void ThermalNeutronBk2BkExpConvPVoigt::function(const FunctionDomain &domain,
+                                                FunctionValues &values) const {
+  auto domain1D = dynamic_cast<const FunctionDomain1D *>(&domain);
+  if (!domain1D || !domain1D->isSorted() ||
+      dynamic_cast<const FunctionDomain1DHistogram *>(&domain)) {
+    IFunction1D::function(domain, values);
+    return;
+  }
+  const auto range = getLocalRange(*domain1D);
+  double *out = values.getPointerToCalculated(0);
+  std::fill(out, out + range.first, 0.0);
+  std::fill(out + range.second, out + domain1D->size(), 0.0);
+  if (range.first < range.second)
+    functionLocal(out + range.first, domain1D->getPointerAt(range.first),
+                  range.second - range.first);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Function (local) of the vector version. The peak is added to the output
+ * within its range, which is found by bisection.
+ * @param out: The calculated peak intensities. This is assumed to be
+ * initialized to the correct length.
+ * @param xValues: The x-values to evaluate the peak at, in ascending order.
  */
 void ThermalNeutronBk2BkExpConvPVoigt::function(
     vector<double> &out, const vector<double> &xValues) const {
@@ -447,8 +471,8 @@ void ThermalNeutronBk2BkExpConvPVoigt::function(
   // 2. Calcualte
   std::size_t pos(std::distance(xValues.begin(), iter)); // second loop variable
   for (; iter != iter_end; ++iter) {
-    out[pos] = HEIGHT * calOmega(*iter - m_centre, m_eta, m_N, m_Alpha, m_Beta,
-                                 m_fwhm, m_Sigma2, INVERT_SQRT2SIGMA);
+    out[pos] += HEIGHT * calOmega(*iter - m_centre, m_eta, m_N, m_Alpha,
+                                  m_Beta, m_fwhm, m_Sigma2, INVERT_SQRT2SIGMA);
     pos++;
   } // ENDFOR data points
 }
@@ -463,11 +487,49 @@ void ThermalNeutronBk2BkExpConvPVoigt::functionDerivLocal(
       "functionDerivLocal is not implemented for IkedaCarpenterPV.");
 }
 
-/** Calculate derivative of this peak function
+/** Calculate derivative of this peak function. The derivatives are calculated
+ * numerically, on a sorted domain only over the points within the peak radius.
+ * They are zero elsewhere.
  */
 void ThermalNeutronBk2BkExpConvPVoigt::functionDeriv(
     const API::FunctionDomain &domain, API::Jacobian &jacobian) {
-  calNumericalDeriv(domain, jacobian);
+  auto domain1D = dynamic_cast<const FunctionDomain1D *>(&domain);
+  if (!domain1D || !domain1D->isSorted() ||
+      dynamic_cast<const FunctionDomain1DHistogram *>(&domain)) {
+    calNumericalDeriv(domain, jacobian);
+    return;
+  }
+  const auto range = getLocalRange(*domain1D);
+  const size_t np = nParams();
+  for (size_t i = 0; i < domain1D->size(); ++i) {
+    if (i < range.first || i >= range.second) {
+      for (size_t ip = 0; ip < np; ++ip) {
+        jacobian.set(i, ip, 0.0);
+      }
+    }
+  }
+  if (range.first == range.second)
+    return;
+  FunctionDomain1DView localDomain(domain1D->getPointerAt(range.first),
+                                   range.second - range.first);
+  PartialJacobian localJacobian(&jacobian, range.first, 0);
+  calNumericalDeriv(localDomain, localJacobian);
+}
+
+/** The points of a sorted domain within the peak radius, found by bisection
+ * @param domain :: A sorted domain
+ * @return :: The index of the first point in the range and one past the last
+ */
+std::pair<size_t, size_t> ThermalNeutronBk2BkExpConvPVoigt::getLocalRange(
+    const API::FunctionDomain1D &domain) const {
+  const double c = centre();
+  const double dx = fabs(s_peakRadius * fwhm());
+  const double *begin = domain.getPointerAt(0);
+  const double *end = begin + domain.size();
+  const double *first = std::upper_bound(begin, end, c - dx);
+  const double *last = std::lower_bound(first, end, c + dx);
+  return std::make_pair(static_cast<size_t>(first - begin),
+                        static_cast<size_t>(last - begin));
 }
 
 /** Get the center of the peak
@@ -8,9 +8,12 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidCurveFitting/Functions/UserFunction.h"
+#include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionFactory.h"
 #include "MantidAPI/MuParserUtils.h"
+#include "MantidCurveFitting/CompiledFormula.h"
 #include "MantidGeometry/muParser_Silent.h"
+#include "MantidKernel/make_unique.h"
 #include <boost/tokenizer.hpp>
 
 namespace Mantid {
@@ -69,6 +72,7 @@ void UserFunction::setAttribute(const std::string &attName,
   }
 
   m_x_set = false;
+  m_compiled.reset();
   clearAllParameters();
 
   try {
@@ -99,6 +103,16 @@ void UserFunction::setAttribute(const std::string &attName,
   }
 
   m_parser->SetExpr(m_formula);
+
+  std::vector<std::string> names(nParams());
+  for (size_t i = 0; i < nParams(); i++) {
+    names[i] = parameterName(i);
+  }
+  try {
+    m_compiled = Kernel::make_unique<CompiledFormula>(m_formula, names);
+  } catch (std::invalid_argument &) {
+    // Use muParser for formulas that can't be compiled
+  }
 }
 
 /** Calculate the fitting function.
@@ -110,6 +124,14 @@ void UserFunction::setAttribute(const std::string &attName,
  */
 void UserFunction::function1D(double *out, const double *xValues,
                               const size_t nData) const {
+  if (m_compiled) {
+    std::vector<double> parameters(nParams());
+    for (size_t i = 0; i < parameters.size(); i++) {
+      parameters[i] = getParameter(i);
+    }
+    m_compiled->evaluate(xValues, nData, parameters.data(), out);
+    return;
+  }
   for (size_t i = 0; i < nData; i++) {
     m_x = xValues[i];
     out[i] = m_parser->Eval();
@@ -123,7 +145,30 @@ void UserFunction::function1D(double *out, const double *xValues,
  */
 void UserFunction::functionDeriv(const API::FunctionDomain &domain,
                                  API::Jacobian &jacobian) {
-  calNumericalDeriv(domain, jacobian);
+  if (m_compiled && dynamic_cast<const FunctionDomain1D *>(&domain)) {
+    IFunction1D::functionDeriv(domain, jacobian);
+  } else {
+    calNumericalDeriv(domain, jacobian);
+  }
+}
+
+/**
+ * Calculate the exact derivatives of a compiled formula
+ * @param out :: The Jacobian to fill in
+ * @param xValues :: The array of nData x-values
+ * @param nData :: The number of values
+ */
+void UserFunction::functionDeriv1D(API::Jacobian *out, const double *xValues,
+                                   const size_t nData) {
+  if (!m_compiled) {
+    IFunction1D::functionDeriv1D(out, xValues, nData);
+    return;
+  }
+  std::vector<double> parameters(nParams());
+  for (size_t i = 0; i < parameters.size(); i++) {
+    parameters[i] = getParameter(i);
+  }
+  m_compiled->derivatives(xValues, nData, parameters.data(), *out);
 }
 
 } // namespace Functions
@@ -226,6 +226,49 @@ public:
     WorkspaceCreationHelper::removeWS("PlotPeakResult");
   }
 
+  void test_parallel_fits() {
+    createData();
+
+    PlotPeakByLogValue alg;
+    alg.initialize();
+    alg.setPropertyValue("Input",
+                         "PlotPeakGroup_0;PlotPeakGroup_1;PlotPeakGroup_2");
+    alg.setPropertyValue("OutputWorkspace", "PlotPeakResult");
+    alg.setPropertyValue("WorkspaceIndex", "1");
+    alg.setPropertyValue("LogValue", "var");
+    alg.setPropertyValue("FitType", "Individual");
+    alg.setProperty("Parallel", true);
+    alg.setProperty("CreateOutput", true);
+    alg.setPropertyValue("Function", "name=LinearBackground,A0=1,A1=0.3;name="
+                                     "Gaussian,PeakCentre=5,Height=2,Sigma=0."
+                                     "1");
+    alg.execute();
+    TS_ASSERT(alg.isExecuted());
+
+    TWS_type result =
+        WorkspaceCreationHelper::getWS<TableWorkspace>("PlotPeakResult");
+    TS_ASSERT_EQUALS(result->rowCount(), 3);
+    // The rows are in the order of the inputs
+    for (size_t row = 0; row < 3; ++row) {
+      const double i = static_cast<double>(row);
+      TS_ASSERT_DELTA(result->Double(row, 0), 1 + 0.3 * i, 1e-10);
+      TS_ASSERT_DELTA(result->Double(row, 1), 1 + 0.1 * i, 1e-10);
+      TS_ASSERT_DELTA(result->Double(row, 3), 0.3 - 0.02 * i, 1e-10);
+      TS_ASSERT_DELTA(result->Double(row, 5), 2 - 0.2 * i, 1e-10);
+      TS_ASSERT_DELTA(result->Double(row, 7), 5 + 0.03 * i, 1e-10);
+      TS_ASSERT_DELTA(result->Double(row, 9), 0.1 + 0.01 * i, 1e-10);
+    }
+
+    auto fits =
+        AnalysisDataService::Instance().retrieveWS<const WorkspaceGroup>(
+            "PlotPeakResult_Workspaces");
+    TS_ASSERT(fits);
+    TS_ASSERT_EQUALS(fits->getNames().size(), 3);
+
+    deleteData();
+    AnalysisDataService::Instance().clear();
+  }
+
   void testWorkspaceList_plotting_against_ws_names() {
     createData();
 
@@ -0,0 +1,157 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_CURVEFITTING_BLOCKARROWSOLVERTEST_H_
+#define MANTID_CURVEFITTING_BLOCKARROWSOLVERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidCurveFitting/BlockArrowSolver.h"
+#include "MantidCurveFitting/GSLMatrix.h"
+#include "MantidCurveFitting/GSLVector.h"
+
+#include "MantidTestHelpers/MultiDomainFunctionHelper.h"
+
+#include <boost/make_shared.hpp>
+
+using namespace Mantid::CurveFitting;
+using Mantid::API::MultiDomainFunction;
+using Mantid::TestHelpers::MultiDomainFunctionTest_Function;
+
+class BlockArrowSolverTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BlockArrowSolverTest *createSuite() {
+    return new BlockArrowSolverTest();
+  }
+  static void destroySuite(BlockArrowSolverTest *suite) { delete suite; }
+
+  void test_solve_matches_dense_solve() {
+    BlockArrowSolver solver({{0, 1}, {3, 4}, {5}}, {2, 6});
+    auto matrix = makeBlockArrowMatrix(solver);
+    GSLVector rhs{1., -2., 3., 0.5, 4., -1., 2.};
+
+    GSLVector x;
+    TS_ASSERT(solver.solve(matrix, rhs, x));
+    GSLVector expected;
+    GSLMatrix(matrix).solve(rhs, expected);
+    TS_ASSERT_EQUALS(x.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      TS_ASSERT_DELTA(x[i], expected[i], 1e-12);
+    }
+  }
+
+  void test_solve_without_global_parameters() {
+    BlockArrowSolver solver({{0, 2}, {1}}, {});
+    auto matrix = makeBlockArrowMatrix(solver);
+    GSLVector rhs{1., 2., 3.};
+
+    GSLVector x;
+    TS_ASSERT(solver.solve(matrix, rhs, x));
+    GSLVector expected;
+    GSLMatrix(matrix).solve(rhs, expected);
+    for (size_t i = 0; i < expected.size(); ++i) {
+      TS_ASSERT_DELTA(x[i], expected[i], 1e-12);
+    }
+  }
+
+  void test_coupled_blocks_are_not_solved() {
+    BlockArrowSolver solver({{0, 1}, {3, 4}, {5}}, {2, 6});
+    auto matrix = makeBlockArrowMatrix(solver);
+    TS_ASSERT(solver.hasStructureOf(matrix));
+    matrix.set(1, 3, 0.1);
+    matrix.set(3, 1, 0.1);
+    TS_ASSERT(!solver.hasStructureOf(matrix));
+
+    GSLVector rhs(7);
+    GSLVector x{1.};
+    TS_ASSERT(!solver.solve(matrix, rhs, x));
+    TS_ASSERT_EQUALS(x.size(), 1);
+    TS_ASSERT(!solver.hasStructureOf(GSLMatrix(6, 6)));
+  }
+
+  void test_blocks_of_multidomain_function() {
+    auto multi = boost::make_shared<MultiDomainFunction>();
+    for (size_t i = 0; i < 3; ++i) {
+      multi->addFunction(
+          boost::make_shared<MultiDomainFunctionTest_Function>());
+    }
+    multi->setDomainIndices(1, {1});
+    multi->setDomainIndices(2, {2});
+    // The first function applies to all the domains
+    multi->setDomainIndices(0, {0, 1, 2});
+    multi->fix(3);
+
+    BlockArrowSolver solver(*multi);
+    TS_ASSERT(solver.hasBlocks());
+    TS_ASSERT_EQUALS(solver.global(), std::vector<size_t>({0, 1}));
+    TS_ASSERT_EQUALS(solver.localBlocks().size(), 2);
+    TS_ASSERT_EQUALS(solver.localBlocks()[0], std::vector<size_t>({2}));
+    TS_ASSERT_EQUALS(solver.localBlocks()[1], std::vector<size_t>({3, 4}));
+  }
+
+  void test_parameters_tied_to_are_global() {
+    auto multi = boost::make_shared<MultiDomainFunction>();
+    for (size_t i = 0; i < 3; ++i) {
+      multi->addFunction(
+          boost::make_shared<MultiDomainFunctionTest_Function>());
+      multi->setDomainIndex(i, i);
+    }
+    // The values on every domain depend on f0.A through the ties
+    multi->tie("f1.A", "f0.A");
+    multi->tie("f2.A", "f0.A");
+
+    BlockArrowSolver solver(*multi);
+    TS_ASSERT(solver.hasBlocks());
+    TS_ASSERT_EQUALS(solver.global(), std::vector<size_t>({0}));
+    TS_ASSERT_EQUALS(solver.localBlocks().size(), 3);
+    TS_ASSERT_EQUALS(solver.localBlocks()[0], std::vector<size_t>({1}));
+    TS_ASSERT_EQUALS(solver.localBlocks()[1], std::vector<size_t>({2}));
+    TS_ASSERT_EQUALS(solver.localBlocks()[2], std::vector<size_t>({3}));
+  }
+
+  void test_other_functions_have_no_blocks() {
+    MultiDomainFunctionTest_Function function;
+    BlockArrowSolver solver(function);
+    TS_ASSERT(!solver.hasBlocks());
+    TS_ASSERT(solver.global().empty());
+  }
+
+private:
+  /// A symmetric, diagonally dominant matrix with the structure of a solver
+  GSLMatrix makeBlockArrowMatrix(const BlockArrowSolver &solver) {
+    size_t n = solver.global().size();
+    for (const auto &block : solver.localBlocks()) {
+      n += block.size();
+    }
+    std::vector<std::vector<size_t>> groups(solver.localBlocks());
+    for (auto &group : groups) {
+      group.insert(group.end(), solver.global().begin(),
+                   solver.global().end());
+    }
+    GSLMatrix matrix(n, n);
+    matrix.zero();
+    double value = 0.1;
+    for (const auto &group : groups) {
+      for (auto i : group) {
+        for (auto j : group) {
+          if (i < j) {
+            matrix.set(i, j, value);
+            matrix.set(j, i, value);
+            value += 0.05;
+          }
+        }
+      }
+    }
+    for (size_t i = 0; i < n; ++i) {
+      matrix.set(i, i, 10. + static_cast<double>(i));
+    }
+    return matrix;
+  }
+};
+
+#endif /* MANTID_CURVEFITTING_BLOCKARROWSOLVERTEST_H_ */
@@ -0,0 +1,141 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_CURVEFITTING_COMPILEDFORMULATEST_H_
+#define MANTID_CURVEFITTING_COMPILEDFORMULATEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidCurveFitting/CompiledFormula.h"
+#include "MantidCurveFitting/Jacobian.h"
+
+#include <cmath>
+#include <stdexcept>
+
+using Mantid::CurveFitting::CompiledFormula;
+
+class CompiledFormulaTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompiledFormulaTest *createSuite() {
+    return new CompiledFormulaTest();
+  }
+  static void destroySuite(CompiledFormulaTest *suite) { delete suite; }
+
+  void test_evaluate() {
+    CompiledFormula formula("h*exp(-(x-c)^2/(2*s^2)) + b0 + b1*x",
+                            {"h", "c", "s", "b0", "b1"});
+    const std::vector<double> p{3.0, 0.5, 1.5, 0.2, -0.1};
+    // More points than are evaluated in one pass
+    const auto x = makeX(1000);
+    std::vector<double> y(x.size());
+    formula.evaluate(x.data(), x.size(), p.data(), y.data());
+    for (size_t i = 0; i < x.size(); ++i) {
+      const double expected =
+          p[0] * std::exp(-std::pow(x[i] - p[1], 2) / (2 * p[2] * p[2])) +
+          p[3] + p[4] * x[i];
+      TS_ASSERT_DELTA(y[i], expected, 1e-12);
+    }
+  }
+
+  void test_precedence() {
+    TS_ASSERT_DELTA(evaluate("-x^2", 3.0), -9.0, 1e-15);
+    TS_ASSERT_DELTA(evaluate("2^-x", 1.0), 0.5, 1e-15);
+    TS_ASSERT_DELTA(evaluate("x-1-2", 5.0), 2.0, 1e-15);
+    TS_ASSERT_DELTA(evaluate("x/2/4", 8.0), 1.0, 1e-15);
+    TS_ASSERT_DELTA(evaluate("1+2*x^2", 3.0), 19.0, 1e-15);
+    TS_ASSERT_DELTA(evaluate("2*_pi*x", 1.0), 2 * M_PI, 1e-15);
+    TS_ASSERT_DELTA(evaluate("1.5e-1*x + ln(_e)", 2.0), 1.3, 1e-15);
+  }
+
+  void test_derivatives_match_numerical_derivatives() {
+    const std::vector<std::string> names{"a", "b", "c"};
+    const std::vector<std::string> formulas{
+        "a*sin(b*x) + cos(c*x)/b",
+        "exp(-a*x)*sqrt(b + x^2) - c",
+        "tan(a*x) + asin(b/2) + acos(c/3) + atan(a*b*x)",
+        "sinh(a*x) * cosh(b) + tanh(c*x)",
+        "log(a + x^2) + log10(b) + log2(c) + abs(a - x)",
+        "x^a + b^c + a^(b*x)",
+        "erf(a*x) + erfc(b*x) + c*sign(x - 1)"};
+    const std::vector<double> p{0.7, 1.3, 1.9};
+    const auto x = makeX(300);
+    for (const auto &text : formulas) {
+      CompiledFormula formula(text, names);
+      Mantid::CurveFitting::Jacobian jacobian(x.size(), p.size());
+      formula.derivatives(x.data(), x.size(), p.data(), jacobian);
+      for (size_t ip = 0; ip < p.size(); ++ip) {
+        const double step = 1e-6;
+        auto plus = p;
+        plus[ip] += step;
+        auto minus = p;
+        minus[ip] -= step;
+        std::vector<double> yPlus(x.size()), yMinus(x.size());
+        formula.evaluate(x.data(), x.size(), plus.data(), yPlus.data());
+        formula.evaluate(x.data(), x.size(), minus.data(), yMinus.data());
+        for (size_t i = 0; i < x.size(); ++i) {
+          const double expected = (yPlus[i] - yMinus[i]) / (2 * step);
+          TSM_ASSERT_DELTA(text, jacobian.get(i, ip), expected, 1e-6);
+        }
+      }
+    }
+  }
+
+  void test_parameters_the_formula_does_not_use_have_zero_derivatives() {
+    CompiledFormula formula("a*x", {"a", "b"});
+    const std::vector<double> p{2.0, 3.0};
+    const std::vector<double> x{1.0, 2.0};
+    Mantid::CurveFitting::Jacobian jacobian(2, 2);
+    jacobian.set(0, 1, 5.0);
+    formula.derivatives(x.data(), x.size(), p.data(), jacobian);
+    TS_ASSERT_EQUALS(jacobian.get(1, 0), 2.0);
+    TS_ASSERT_EQUALS(jacobian.get(0, 1), 0.0);
+    TS_ASSERT_EQUALS(jacobian.get(1, 1), 0.0);
+  }
+
+  void test_constants_are_folded() {
+    CompiledFormula folded("(1 + 2) * 3 * x", {});
+    CompiledFormula unfolded("x * 9", {});
+    // The operands of the folded operations are left behind
+    TS_ASSERT_EQUALS(folded.size(), 7);
+    TS_ASSERT_EQUALS(unfolded.size(), 3);
+    TS_ASSERT_DELTA(evaluate("(1 + 2) * 3 * x", 2.0), 18.0, 1e-15);
+  }
+
+  void test_unsupported_formulas_throw() {
+    const std::vector<std::string> names{"a"};
+    TS_ASSERT_THROWS(CompiledFormula("x > 0 ? a : 1", names),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompiledFormula("x^2^a", names),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompiledFormula("gamma(x)", names),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompiledFormula("a*y", names),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompiledFormula("sin(x", names),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompiledFormula("", names), const std::invalid_argument &);
+  }
+
+private:
+  std::vector<double> makeX(size_t n) {
+    std::vector<double> x(n);
+    for (size_t i = 0; i < n; ++i) {
+      x[i] = 0.01 + 2.0 * static_cast<double>(i) / static_cast<double>(n);
+    }
+    return x;
+  }
+
+  double evaluate(const std::string &text, double x) {
+    CompiledFormula formula(text, {});
+    double y;
+    formula.evaluate(&x, 1, nullptr, &y);
+    return y;
+  }
+};
+
+#endif /* MANTID_CURVEFITTING_COMPILEDFORMULATEST_H_ */
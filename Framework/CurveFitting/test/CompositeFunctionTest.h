@@ -9,6 +9,8 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include <sstream>
+
 #include "MantidAPI/CompositeFunction.h"
 #include "MantidAPI/FrameworkManager.h"
 #include "MantidAPI/FunctionFactory.h"
@@ -516,6 +518,81 @@ public:
                                       "LinearBackground,A0=0,A1=0,ties=(A0=A1);"
                                       "ties=(f0.Sigma=f1.A1)");
   }
+
+  void test_members_add_their_values() {
+    auto fun = FunctionFactory::Instance().createInitialized(
+        "name=Gaussian,Height=2,PeakCentre=4,Sigma=0.5;"
+        "name=Lorentzian,Amplitude=3,PeakCentre=8,FWHM=1;"
+        "name=PseudoVoigt,Mixing=0.3,Height=1,PeakCentre=12,FWHM=2;"
+        "name=BackToBackExponential,I=5,A=1.6,B=0.5,X0=15,S=0.4;"
+        "name=ExpDecay,Height=1,Lifetime=10;"
+        "name=LinearBackground,A0=1,A1=0.1");
+    auto composite = boost::dynamic_pointer_cast<CompositeFunction>(fun);
+    TS_ASSERT(composite);
+
+    FunctionDomain1DVector domain(0.0, 20.0, 201);
+    domain.setPeakRadius(5);
+    FunctionValues values(domain);
+    composite->function(domain, values);
+
+    FunctionValues expected(domain);
+    expected.zeroCalculated();
+    for (size_t iFun = 0; iFun < composite->nFunctions(); ++iFun) {
+      FunctionValues member(domain);
+      composite->getFunction(iFun)->function(domain, member);
+      expected += member;
+    }
+    for (size_t i = 0; i < domain.size(); ++i) {
+      TS_ASSERT_DELTA(values.getCalculated(i), expected.getCalculated(i),
+                      1e-12);
+    }
+  }
+};
+
+class CompositeFunctionTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompositeFunctionTestPerformance *createSuite() {
+    return new CompositeFunctionTestPerformance();
+  }
+  static void destroySuite(CompositeFunctionTestPerformance *suite) {
+    delete suite;
+  }
+
+  CompositeFunctionTestPerformance() : m_domain(0.0, 1000.0, 20000) {
+    // A powder pattern: many narrow peaks of different shapes on a background
+    std::ostringstream functions;
+    functions << "name=LinearBackground,A0=1,A1=0.001";
+    const std::vector<std::string> peaks{
+        "name=Gaussian,Height=2,Sigma=0.5,PeakCentre=",
+        "name=Lorentzian,Amplitude=3,FWHM=1,PeakCentre=",
+        "name=PseudoVoigt,Mixing=0.5,Height=1,FWHM=1,PeakCentre=",
+        "name=BackToBackExponential,I=5,A=1.6,B=0.5,S=0.4,X0="};
+    for (size_t i = 0; i < 100; ++i) {
+      functions << ";" << peaks[i % peaks.size()] << 5.0 + 9.9 * double(i);
+    }
+    m_function =
+        FunctionFactory::Instance().createInitialized(functions.str());
+  }
+
+  void test_evaluate_composite() {
+    FunctionValues values(m_domain);
+    for (size_t i = 0; i < 50; ++i) {
+      m_function->function(m_domain, values);
+    }
+  }
+
+  void test_derivatives_of_composite() {
+    GSLJacobian jacobian(*m_function, m_domain.size());
+    for (size_t i = 0; i < 5; ++i) {
+      m_function->functionDeriv(m_domain, jacobian);
+    }
+  }
+
+private:
+  FunctionDomain1DVector m_domain;
+  IFunction_sptr m_function;
 };
 
 #endif /*CURVEFITTING_COMPOSITEFUNCTIONTEST_H_*/
@@ -21,6 +21,7 @@
 #include "MantidCurveFitting/Functions/Gaussian.h"
 #include "MantidCurveFitting/Functions/LinearBackground.h"
 #include "MantidCurveFitting/Functions/UserFunction.h"
+#include "MantidCurveFitting/Jacobian.h"
 
 #include <gsl/gsl_blas.h>
 #include <sstream>
@@ -342,6 +343,111 @@ public:
       //}
     }
   }
+
+  void test_derivatives_and_hessian_over_several_blocks() {
+    API::FunctionDomain1D_sptr domain(
+        new API::FunctionDomain1DVector(0.0, 10.0, 1000));
+    API::FunctionValues_sptr values(new API::FunctionValues(*domain));
+    for (size_t i = 0; i < domain->size(); ++i) {
+      const double x = (*domain)[i];
+      values->setFitData(i, 1.0 + 0.1 * x + 3.0 * exp(-(x - 4.0) * (x - 4.0)));
+      values->setFitWeight(i, 1.0 / (1.0 + 0.01 * double(i)));
+    }
+
+    auto fun = boost::make_shared<CompositeFunction>();
+    auto bk = boost::make_shared<LinearBackground>();
+    bk->initialize();
+    bk->setParameter("A0", 0.9);
+    bk->setParameter("A1", 0.12);
+    auto peak = boost::make_shared<Gaussian>();
+    peak->initialize();
+    peak->setParameter("PeakCentre", 4.1);
+    peak->setParameter("Height", 2.8);
+    peak->setParameter("Sigma", 0.8);
+    fun->addFunction(bk);
+    fun->addFunction(peak);
+    fun->fix(3);
+
+    auto costFun = boost::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(fun, domain, values);
+    const GSLVector &der = costFun->getDeriv();
+    const GSLMatrix &hessian = costFun->getHessian();
+    const size_t na = costFun->nParams();
+    TS_ASSERT_EQUALS(na, 4);
+
+    // Calculate them directly
+    fun->function(*domain, *values);
+    Mantid::CurveFitting::Jacobian jacobian(domain->size(), fun->nParams());
+    fun->functionDeriv(*domain, jacobian);
+    const std::vector<size_t> active{0, 1, 2, 4};
+    for (size_t i1 = 0; i1 < na; ++i1) {
+      double d = 0.0;
+      for (size_t k = 0; k < domain->size(); ++k) {
+        const double w = values->getFitWeight(k);
+        d += (values->getCalculated(k) - values->getFitData(k)) * w * w *
+             jacobian.get(k, active[i1]);
+      }
+      TS_ASSERT_DELTA(der.get(i1), d, 1e-10 * std::max(1.0, fabs(d)));
+      for (size_t i2 = 0; i2 < na; ++i2) {
+        double h = 0.0;
+        for (size_t k = 0; k < domain->size(); ++k) {
+          const double w = values->getFitWeight(k);
+          h += jacobian.get(k, active[i1]) * jacobian.get(k, active[i2]) * w *
+               w;
+        }
+        TS_ASSERT_DELTA(hessian.get(i1, i2), h, 1e-10 * std::max(1.0, fabs(h)));
+      }
+    }
+  }
+};
+
+class LeastSquaresTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LeastSquaresTestPerformance *createSuite() {
+    return new LeastSquaresTestPerformance();
+  }
+  static void destroySuite(LeastSquaresTestPerformance *suite) {
+    delete suite;
+  }
+
+  LeastSquaresTestPerformance() {
+    m_domain.reset(new API::FunctionDomain1DVector(0.0, 100.0, 1000000));
+    m_values.reset(new API::FunctionValues(*m_domain));
+    m_values->setFitData(std::vector<double>(m_domain->size(), 1.0));
+    m_values->setFitWeights(1.0);
+
+    // A background and ten peaks: 32 parameters
+    auto fun = boost::make_shared<CompositeFunction>();
+    auto bk = boost::make_shared<LinearBackground>();
+    bk->initialize();
+    fun->addFunction(bk);
+    for (size_t i = 0; i < 10; ++i) {
+      auto peak = boost::make_shared<Gaussian>();
+      peak->initialize();
+      peak->setParameter("PeakCentre", 5.0 + 10.0 * double(i));
+      peak->setParameter("Height", 1.0);
+      peak->setParameter("Sigma", 1.0);
+      fun->addFunction(peak);
+    }
+    m_function = fun;
+  }
+
+  void test_derivatives_and_hessian_of_a_million_points() {
+    auto costFun = boost::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(m_function, m_domain, m_values);
+    for (size_t i = 0; i < 5; ++i) {
+      costFun->valDerivHessian(true, true);
+      // Invalidate the cached values
+      costFun->setParameter(0, costFun->getParameter(0));
+    }
+  }
+
+private:
+  API::FunctionDomain1D_sptr m_domain;
+  API::FunctionValues_sptr m_values;
+  API::IFunction_sptr m_function;
 };
 
 #endif /*CURVEFITTING_LEASTSQUARESTEST_H_*/
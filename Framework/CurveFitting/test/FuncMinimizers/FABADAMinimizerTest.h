@@ -392,7 +392,103 @@ public:
     TS_ASSERT_EQUALS(height, 1.002);
   }
 
+  void test_multiple_chains() {
+    auto ws2 = createExpDecayWorkspace();
+
+    Mantid::API::IFunction_sptr fun(new ExpDecay);
+    fun->setParameter("Height", 8.);
+    fun->setParameter("Lifetime", 1.0);
+
+    Fit fit;
+    fit.initialize();
+    fit.setChild(true);
+    fit.setProperty("Function", fun);
+    fit.setProperty("InputWorkspace", ws2);
+    fit.setProperty("WorkspaceIndex", 0);
+    fit.setProperty("CreateOutput", true);
+    fit.setProperty("MaxIterations", 100000);
+    fit.setProperty("Minimizer", "FABADA,ChainLength=10000,StepsBetweenValues="
+                                 "10,ConvergenceCriteria=0.1,NumberOfChains=4,"
+                                 "PDF=0,Chains=Chain,ConvergedChain="
+                                 "ConvergedChain,Parameters=Parameters");
+
+    TS_ASSERT_THROWS_NOTHING(fit.execute());
+    TS_ASSERT(fit.isExecuted());
+
+    TS_ASSERT_DELTA(fun->getParameter("Height"), 10.0, 0.1);
+    TS_ASSERT_DELTA(fun->getParameter("Lifetime"), 0.5, 0.01);
+    TS_ASSERT_DELTA(fun->getError(0), 0.7, 1e-1);
+    TS_ASSERT_DELTA(fun->getError(1), 0.06, 1e-2);
+
+    // Each chain contributes a quarter of the converged chain
+    MatrixWorkspace_sptr convChain = fit.getProperty("ConvergedChain");
+    TS_ASSERT(convChain);
+    TS_ASSERT_EQUALS(convChain->x(0).size(), 1000);
+    MatrixWorkspace_sptr chain = fit.getProperty("Chains");
+    TS_ASSERT(chain);
+    TS_ASSERT_EQUALS(chain->getNumberHistograms(), fun->nParams() + 1);
+    TS_ASSERT_LESS_THAN(10000, chain->x(0).size());
+
+    ITableWorkspace_sptr param = fit.getProperty("Parameters");
+    TS_ASSERT(param);
+    TS_ASSERT_EQUALS(param->rowCount(), fun->nParams());
+    TS_ASSERT(param->Double(0, 1) == fun->getParameter("Height"));
+  }
+
+  void test_multiple_chains_are_reproducible() {
+    const std::string minimizer = "FABADA,ChainLength=2000,ConvergenceCriteria"
+                                  "=0.1,NumberOfChains=3,PDF=0,Seed=7";
+    auto first = fitExpDecay(minimizer);
+    auto second = fitExpDecay(minimizer);
+    TS_ASSERT_EQUALS(first->getParameter(0), second->getParameter(0));
+    TS_ASSERT_EQUALS(first->getParameter(1), second->getParameter(1));
+    TS_ASSERT_EQUALS(first->getError(0), second->getError(0));
+  }
+
+  void test_single_chain_is_reproducible() {
+    const std::string minimizer = "FABADA,ChainLength=2000,ConvergenceCriteria"
+                                  "=0.1,PDF=0,Seed=3";
+    auto first = fitExpDecay(minimizer);
+    auto second = fitExpDecay(minimizer);
+    TS_ASSERT_EQUALS(first->getParameter(0), second->getParameter(0));
+    TS_ASSERT_EQUALS(first->getParameter(1), second->getParameter(1));
+    TS_ASSERT_EQUALS(first->getError(0), second->getError(0));
+  }
+
+  void test_parallel_tempering() {
+    auto fun = fitExpDecay("FABADA,ChainLength=10000,ConvergenceCriteria=0.1,"
+                           "NumberOfChains=3,ParallelTempering=1,"
+                           "MaximumTemperature=4,PDF=0");
+    TS_ASSERT_DELTA(fun->getParameter("Height"), 10.0, 0.1);
+    TS_ASSERT_DELTA(fun->getParameter("Lifetime"), 0.5, 0.01);
+    TS_ASSERT_DELTA(fun->getError(0), 0.7, 1e-1);
+    TS_ASSERT_DELTA(fun->getError(1), 0.06, 1e-2);
+  }
+
+  void test_parallel_tempering_with_simulated_annealing_throws() {
+    TS_ASSERT_THROWS(fitExpDecay("FABADA,ChainLength=1000,NumberOfChains=2,"
+                                 "ParallelTempering=1,SimAnnealingApplied=1"),
+                     const std::invalid_argument &);
+  }
+
 private:
+  IFunction_sptr fitExpDecay(const std::string &minimizer) {
+    IFunction_sptr fun = boost::make_shared<ExpDecay>();
+    fun->setParameter("Height", 8.);
+    fun->setParameter("Lifetime", 1.0);
+
+    Fit fit;
+    fit.initialize();
+    fit.setChild(true);
+    fit.setRethrows(true);
+    fit.setProperty("Function", fun);
+    fit.setProperty("InputWorkspace", createExpDecayWorkspace());
+    fit.setProperty("MaxIterations", 100000);
+    fit.setProperty("Minimizer", minimizer);
+    fit.execute();
+    return fun;
+  }
+
   MatrixWorkspace_sptr createExpDecayWorkspace() {
     MatrixWorkspace_sptr ws2(new WorkspaceTester);
     ws2->initialize(1, 20, 20);
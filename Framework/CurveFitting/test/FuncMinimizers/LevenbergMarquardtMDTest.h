@@ -468,6 +468,50 @@ public:
     TS_ASSERT_DELTA(multi->getFunction(2)->getParameter("B"), 3, 1e-8);
   }
 
+  void test_multidomain_with_local_parameters() {
+    auto domain = Mantid::TestHelpers::makeMultiDomainDomain3();
+    auto values = boost::make_shared<FunctionValues>(*domain);
+    const double A0 = 0, A1 = 1, A2 = 2;
+    const double B0 = 1, B1 = 2, B2 = 3;
+
+    auto &d0 = static_cast<const FunctionDomain1D &>(domain->getDomain(0));
+    for (size_t i = 0; i < d0.size(); ++i) {
+      values->setFitData(i, A0 + B0 * d0[i]);
+    }
+    auto &d1 = static_cast<const FunctionDomain1D &>(domain->getDomain(1));
+    for (size_t i = 0; i < d1.size(); ++i) {
+      values->setFitData(9 + i, A0 + A1 + (B0 + B1) * d1[i]);
+    }
+    auto &d2 = static_cast<const FunctionDomain1D &>(domain->getDomain(2));
+    for (size_t i = 0; i < d2.size(); ++i) {
+      values->setFitData(19 + i, A0 + A2 + (B0 + B2) * d2[i]);
+    }
+    values->setFitWeights(1);
+
+    // The parameters of the last two functions are local to one domain
+    auto multi = Mantid::TestHelpers::makeMultiDomainFunction3();
+    multi->setDomainIndices(1, {1});
+    multi->setDomainIndices(2, {2});
+
+    boost::shared_ptr<CostFuncLeastSquares> costFun =
+        boost::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(multi, domain, values);
+
+    FuncMinimisers::LevenbergMarquardtMDMinimizer s;
+    s.initialize(costFun);
+    TS_ASSERT(s.minimize());
+
+    TS_ASSERT_EQUALS(s.getError(), "success");
+    TS_ASSERT_DELTA(s.costFunctionVal(), 0, 1e-4);
+
+    TS_ASSERT_DELTA(multi->getFunction(0)->getParameter("A"), 0, 1e-8);
+    TS_ASSERT_DELTA(multi->getFunction(0)->getParameter("B"), 1, 1e-8);
+    TS_ASSERT_DELTA(multi->getFunction(1)->getParameter("A"), 1, 1e-8);
+    TS_ASSERT_DELTA(multi->getFunction(1)->getParameter("B"), 2, 1e-8);
+    TS_ASSERT_DELTA(multi->getFunction(2)->getParameter("A"), 2, 1e-8);
+    TS_ASSERT_DELTA(multi->getFunction(2)->getParameter("B"), 3, 1e-8);
+  }
+
 private:
   double fitBSpline(boost::shared_ptr<IFunction> bsp, std::string func) {
     const double startx = bsp->getAttribute("StartX").asDouble();
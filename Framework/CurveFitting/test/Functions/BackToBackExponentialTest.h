@@ -12,6 +12,7 @@
 #include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionValues.h"
 #include "MantidCurveFitting/Functions/BackToBackExponential.h"
+#include "MantidCurveFitting/Jacobian.h"
 
 #include <cmath>
 
@@ -191,6 +192,27 @@ public:
     TS_ASSERT_EQUALS(b2bExp.intensity(), 3.0);
     TS_ASSERT_EQUALS(b2bExp.getParameter("I"), 3.0);
   }
+
+  void test_analytical_derivatives_match_numerical() {
+    BackToBackExponential b2bExp;
+    b2bExp.initialize();
+    b2bExp.setParameter("I", 3.0);
+    b2bExp.setParameter("A", 1.6);
+    b2bExp.setParameter("B", 0.05);
+    b2bExp.setParameter("X0", 0.3);
+    b2bExp.setParameter("S", 1.2);
+
+    Mantid::API::FunctionDomain1DVector x(-10, 40, 51);
+    Mantid::CurveFitting::Jacobian analytical(x.size(), 5);
+    Mantid::CurveFitting::Jacobian numerical(x.size(), 5);
+    b2bExp.functionDeriv(x, analytical);
+    b2bExp.calNumericalDeriv(x, numerical);
+    for (size_t i = 0; i < x.size(); ++i) {
+      for (size_t j = 0; j < 5; ++j) {
+        TS_ASSERT_DELTA(analytical.get(i, j), numerical.get(i, j), 2e-3);
+      }
+    }
+  }
 };
 
 #endif /*BACKTOBACKEXPONENTIALTEST_H_*/
@@ -133,6 +133,78 @@ public:
     TS_ASSERT_DELTA(y[3], 0.297548, 0.000001);
     TS_ASSERT_DELTA(y[4], 0.177036, 0.000001);
   }
+
+  void testLFZNDKTFunction() {
+    // Test Dynamic Kubo Toyabe (DKT) for a longitudinal field stronger than
+    // 2 Delta (LF) and Zero Nu (ZN)
+    DynamicKuboToyabe dkt;
+    dkt.initialize();
+    dkt.setParameter("Asym", 1.0);
+    dkt.setParameter("Delta", 0.3);
+    dkt.setParameter("Field", 5.0);
+    dkt.setParameter("Nu", 0.0);
+
+    // define 1d domain of 5 points in interval [0,10]
+    Mantid::API::FunctionDomain1DVector x(0, 10, 5);
+    Mantid::API::FunctionValues y(x);
+
+    TS_ASSERT_THROWS_NOTHING(dkt.function(x, y));
+
+    TS_ASSERT_DELTA(y[0], 1.000000, 0.000001);
+    TS_ASSERT_DELTA(y[1], 0.592896, 0.000001);
+    TS_ASSERT_DELTA(y[2], 0.326296, 0.000001);
+    TS_ASSERT_DELTA(y[3], 0.469999, 0.000001);
+    TS_ASSERT_DELTA(y[4], 0.536560, 0.000001);
+  }
+
+  void testLFDKTFunction() {
+    // Test Dynamic Kubo Toyabe (DKT) for a longitudinal field stronger than
+    // 2 Delta (LF) (non-zero Nu)
+    DynamicKuboToyabe dkt;
+    dkt.initialize();
+    dkt.setParameter("Asym", 1.0);
+    dkt.setParameter("Delta", 0.3);
+    dkt.setParameter("Field", 5.0);
+    dkt.setParameter("Nu", 2.0);
+
+    // define 1d domain of 5 points in interval [0,20]
+    Mantid::API::FunctionDomain1DVector x(0, 20, 5);
+    Mantid::API::FunctionValues y(x);
+
+    TS_ASSERT_THROWS_NOTHING(dkt.function(x, y));
+
+    TS_ASSERT_DELTA(y[0], 1.000000, 0.000001);
+    TS_ASSERT_DELTA(y[1], 0.690881, 0.000001);
+    TS_ASSERT_DELTA(y[2], 0.461711, 0.000001);
+    TS_ASSERT_DELTA(y[3], 0.308559, 0.000001);
+    TS_ASSERT_DELTA(y[4], 0.206208, 0.000001);
+  }
+
+  void testTablesAreUpdated() {
+    // The tables of a previous evaluation must not be reused when the
+    // parameters or the range of the domain change
+    DynamicKuboToyabe dkt;
+    dkt.initialize();
+    dkt.setParameter("Asym", 1.0);
+    dkt.setParameter("Delta", 0.39);
+    dkt.setParameter("Field", 0.1);
+    dkt.setParameter("Nu", 0.5);
+
+    Mantid::API::FunctionDomain1DVector shortRange(0, 1, 5);
+    Mantid::API::FunctionValues ignored(shortRange);
+    TS_ASSERT_THROWS_NOTHING(dkt.function(shortRange, ignored));
+    dkt.setParameter("Field", 5.0);
+    dkt.setParameter("Delta", 0.3);
+    TS_ASSERT_THROWS_NOTHING(dkt.function(shortRange, ignored));
+    dkt.setParameter("Nu", 2.0);
+
+    Mantid::API::FunctionDomain1DVector x(0, 20, 5);
+    Mantid::API::FunctionValues y(x);
+    TS_ASSERT_THROWS_NOTHING(dkt.function(x, y));
+
+    TS_ASSERT_DELTA(y[1], 0.690881, 0.000001);
+    TS_ASSERT_DELTA(y[4], 0.206208, 0.000001);
+  }
 };
 
 #endif /*DYNAMICKUBOTOYABETEST_H_*/
@@ -19,6 +19,7 @@
 #include "MantidCurveFitting/Functions/Gaussian.h"
 #include "MantidCurveFitting/Functions/LinearBackground.h"
 #include "MantidCurveFitting/Functions/UserFunction.h"
+#include "MantidKernel/MultiThreaded.h"
 
 using namespace Mantid;
 using namespace Mantid::Kernel;
@@ -171,6 +172,47 @@ public:
     TS_ASSERT_DELTA(fn.intensity(), intensity, 1e-6);
     TS_ASSERT_DELTA(fn.getParameter("Height"), 0.398942, 1e-6);
   }
+
+  void test_sorted_and_unsorted_domains_evaluated_concurrently() {
+    Gaussian fn;
+    fn.initialize();
+    fn.setParameter("Height", 2.0);
+    fn.setParameter("PeakCentre", 10.0);
+    fn.setParameter("Sigma", 0.5);
+    const double extent = 5 * fn.fwhm();
+
+    const size_t nData(201);
+    std::vector<double> sortedX(nData), unsortedX(nData);
+    for (size_t i = 0; i < nData; ++i) {
+      sortedX[i] = 0.1 * static_cast<double>(i);
+    }
+    for (size_t i = 0; i < nData; ++i) {
+      unsortedX[i] = sortedX[(i * 37) % nData];
+    }
+    FunctionDomain1DView sorted(sortedX.data(), nData);
+    FunctionDomain1DView unsorted(unsortedX.data(), nData);
+    sorted.setPeakRadius(5);
+    unsorted.setPeakRadius(5);
+    TS_ASSERT(sorted.isSorted());
+    TS_ASSERT(!unsorted.isSorted());
+
+    // The same function is evaluated on both domains at once
+    std::vector<int> wrongValues(100, 0);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < 100; ++i) {
+      const auto &domain = i % 2 == 0 ? sorted : unsorted;
+      FunctionValues values(domain);
+      fn.function(domain, values);
+      for (size_t j = 0; j < nData; ++j) {
+        const double diff = domain[j] - 10.0;
+        const double expected =
+            std::abs(diff) < extent ? 2.0 * exp(-2.0 * diff * diff) : 0.0;
+        if (std::abs(values.getCalculated(j) - expected) > 1e-12)
+          ++wrongValues[i];
+      }
+    }
+    TS_ASSERT_EQUALS(wrongValues, std::vector<int>(100, 0));
+  }
 };
 
 #endif /*GAUSSIANTEST_H_*/
\ No newline at end of file
@@ -9,15 +9,24 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAPI/WorkspaceFactory.h"
+#include "MantidCurveFitting/Algorithms/Fit.h"
 #include "MantidCurveFitting/Functions/PawleyFunction.h"
+#include "MantidCurveFitting/Jacobian.h"
 #include "MantidGeometry/Crystal/PointGroup.h"
 
+#include <boost/make_shared.hpp>
+
 using namespace Mantid::CurveFitting;
 using namespace Mantid::API;
 using namespace Mantid::Geometry;
 using namespace Mantid::Kernel;
 
 using Mantid::CurveFitting::Functions::PawleyFunction;
+using Mantid::CurveFitting::Functions::PawleyFunction_sptr;
 using Mantid::CurveFitting::Functions::PawleyParameterFunction;
 using Mantid::CurveFitting::Functions::PawleyParameterFunction_sptr;
 
@@ -430,7 +439,103 @@ public:
     TS_ASSERT_EQUALS(parameters->getParameter("Gamma"), 90.0);
   }
 
+  void testPawleyFunctionDerivatives() {
+    PawleyFunction fn;
+    fn.initialize();
+    fn.setLatticeSystem("Cubic");
+    fn.setProfileFunction("Gaussian");
+    fn.setUnitCell("2.5 2.5 2.5");
+    fn.getPawleyParameterFunction()->setParameter("ZeroShift", 0.002);
+
+    fn.addPeak(V3D(1, 1, 1), 0.01, 2.0);
+    fn.addPeak(V3D(2, 0, 0), 0.012, 3.0);
+    fn.addPeak(V3D(2, 2, 0), 0.015, 1.5);
+
+    FunctionDomain1DVector domain(0.8, 1.6, 4001);
+    const size_t np = fn.nParams();
+    Mantid::CurveFitting::Jacobian derivatives(domain.size(), np);
+    Mantid::CurveFitting::Jacobian numerical(domain.size(), np);
+    fn.functionDeriv(domain, derivatives);
+    fn.calNumericalDeriv(domain, numerical);
+
+    for (size_t iP = 0; iP < np; ++iP) {
+      if (!fn.isActive(iP)) {
+        continue;
+      }
+      double scale = 0.0;
+      for (size_t i = 0; i < domain.size(); ++i) {
+        scale = std::max(scale, fabs(numerical.get(i, iP)));
+      }
+      TS_ASSERT(scale > 0.0);
+      for (size_t i = 0; i < domain.size(); ++i) {
+        TSM_ASSERT_DELTA(fn.parameterName(iP), derivatives.get(i, iP),
+                         numerical.get(i, iP), 1e-2 * scale);
+      }
+    }
+  }
+
+  void testPawleyFunctionFitWithIkedaCarpenterPV() {
+    // IkedaCarpenterPV only has numerical derivatives
+    auto reference = getIkedaCarpenterPVPawley(2.5);
+    FunctionDomain1DVector domain(0.8, 1.6, 4001);
+    FunctionValues values(domain);
+    reference->function(domain, values);
+    auto ws = WorkspaceFactory::Instance().create("Workspace2D", 1,
+                                                  domain.size(), domain.size());
+    ws->mutableX(0) = domain.toVector();
+    ws->mutableY(0) = values.toVector();
+    ws->mutableE(0) = 1.0;
+
+    auto fn = getIkedaCarpenterPVPawley(2.502);
+    for (size_t i = 0; i < fn->getPeakCount(); ++i) {
+      auto peak = fn->getPeakFunction(i);
+      peak->setParameter("I", 0.9 * peak->getParameter("I"));
+    }
+
+    Mantid::CurveFitting::Algorithms::Fit fit;
+    fit.initialize();
+    fit.setChild(true);
+    fit.setProperty("Function", boost::dynamic_pointer_cast<IFunction>(fn));
+    fit.setProperty("InputWorkspace", ws);
+    TS_ASSERT_THROWS_NOTHING(fit.execute());
+    TS_ASSERT(fit.isExecuted());
+
+    TS_ASSERT_DELTA(fn->getPawleyParameterFunction()->getParameter("a"), 2.5,
+                    1e-5);
+    for (size_t i = 0; i < fn->getPeakCount(); ++i) {
+      const auto expected = reference->getPeakFunction(i)->getParameter("I");
+      TS_ASSERT_DELTA(fn->getPeakFunction(i)->getParameter("I"), expected,
+                      1e-4 * expected);
+    }
+  }
+
 private:
+  PawleyFunction_sptr getIkedaCarpenterPVPawley(double a) {
+    auto fn = boost::make_shared<PawleyFunction>();
+    fn->initialize();
+    fn->setLatticeSystem("Cubic");
+    fn->setProfileFunction("IkedaCarpenterPV");
+    const auto length = std::to_string(a);
+    fn->setUnitCell(length + " " + length + " " + length);
+    fn->fix(fn->parameterIndex("f0.ZeroShift"));
+
+    fn->addPeak(V3D(1, 1, 1), 0.01, 2.0);
+    fn->addPeak(V3D(2, 0, 0), 0.012, 3.0);
+    fn->addPeak(V3D(2, 2, 0), 0.015, 1.5);
+    // Decay constants on the scale of the peak widths in d-spacing, which the
+    // fit leaves alone
+    for (size_t i = 0; i < fn->getPeakCount(); ++i) {
+      auto peak = fn->getPeakFunction(i);
+      peak->setParameter("Alpha0", 0.002);
+      peak->setParameter("Alpha1", 0.0);
+      peak->setParameter("Beta0", 0.01);
+      for (const auto name : {"Alpha0", "Alpha1", "Beta0", "Kappa", "Gamma"}) {
+        peak->fix(peak->parameterIndex(name));
+      }
+    }
+    return fn;
+  }
+
   void cellParametersAre(const UnitCell &cell, double a, double b, double c,
                          double alpha, double beta, double gamma) {
     TS_ASSERT_DELTA(cell.a(), a, 1e-9);
@@ -443,4 +548,46 @@ private:
   }
 };
 
+class PawleyFunctionTestPerformance : public CxxTest::TestSuite {
+public:
+  static PawleyFunctionTestPerformance *createSuite() {
+    return new PawleyFunctionTestPerformance();
+  }
+  static void destroySuite(PawleyFunctionTestPerformance *suite) {
+    delete suite;
+  }
+
+  PawleyFunctionTestPerformance()
+      : m_domain(0.5, 3.5, 20000), m_jacobian(m_domain.size(), 1),
+        m_values(m_domain) {
+    m_fn.initialize();
+    m_fn.setLatticeSystem("Cubic");
+    m_fn.setProfileFunction("Gaussian");
+    m_fn.setUnitCell("5.43 5.43 5.43");
+    for (int h = 1; h <= 8; ++h) {
+      for (int k = 0; k <= h; ++k) {
+        for (int l = 0; l <= k; ++l) {
+          m_fn.addPeak(V3D(h, k, l), 0.005, 1.0);
+        }
+      }
+    }
+    m_jacobian = Mantid::CurveFitting::Jacobian(m_domain.size(),
+                                                m_fn.nParams());
+  }
+
+  void test_function() {
+    for (size_t i = 0; i < 10; ++i) {
+      m_fn.function(m_domain, m_values);
+    }
+  }
+
+  void test_derivatives() { m_fn.functionDeriv(m_domain, m_jacobian); }
+
+private:
+  PawleyFunction m_fn;
+  FunctionDomain1DVector m_domain;
+  Mantid::CurveFitting::Jacobian m_jacobian;
+  FunctionValues m_values;
+};
+
 #endif /* MANTID_CURVEFITTING_PAWLEYFUNCTIONTEST_H_ */
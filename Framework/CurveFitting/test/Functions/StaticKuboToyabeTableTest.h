@@ -0,0 +1,107 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_CURVEFITTING_STATICKUBOTOYABETABLETEST_H_
+#define MANTID_CURVEFITTING_STATICKUBOTOYABETABLETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidCurveFitting/Functions/StaticKuboToyabeTable.h"
+
+#include <cmath>
+#include <stdexcept>
+
+using Mantid::CurveFitting::Functions::StaticKuboToyabeTable;
+
+class StaticKuboToyabeTableTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static StaticKuboToyabeTableTest *createSuite() {
+    return new StaticKuboToyabeTableTest();
+  }
+  static void destroySuite(StaticKuboToyabeTableTest *suite) { delete suite; }
+
+  void test_integral_matches_quadrature() {
+    for (const double b : {0.2, 1.0, 3.0, 20.0, 200.0}) {
+      StaticKuboToyabeTable table(b, 12.0);
+      for (const double tau : {0.05, 0.7, 1.9, 4.3, 8.0, 12.0}) {
+        const double weight = 2.0 / (b * b * b);
+        TS_ASSERT_DELTA(weight * table.integral(tau),
+                        weight * simpson(b, tau), 1e-10);
+      }
+    }
+  }
+
+  void test_relaxation() {
+    // In the absence of the integral P(0) = 1
+    StaticKuboToyabeTable table(2.0, 5.0);
+    TS_ASSERT_DELTA(table(0.0), 1.0, 1e-15);
+    // Compare with the definition
+    const double tau = 1.3;
+    const double r = 0.25;
+    const double expected =
+        1 - 2 * r * (1 - std::exp(-tau * tau / 2) * std::cos(2.0 * tau)) +
+        r * simpson(2.0, tau);
+    TS_ASSERT_DELTA(table(tau), expected, 1e-10);
+  }
+
+  void test_integral_is_zero_for_negative_times() {
+    StaticKuboToyabeTable table(1.0, 5.0);
+    TS_ASSERT_EQUALS(table.integral(0.0), 0.0);
+    TS_ASSERT_EQUALS(table.integral(-2.0), 0.0);
+  }
+
+  void test_strong_fields_need_no_table() {
+    StaticKuboToyabeTable table(1e5, 5.0);
+    TS_ASSERT_EQUALS(table.size(), 0);
+    TS_ASSERT_DELTA(table(1.0), 1.0, 1e-9);
+  }
+
+  void test_b_must_be_positive() {
+    TS_ASSERT_THROWS(StaticKuboToyabeTable(0.0, 1.0),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(StaticKuboToyabeTable(-1.0, 1.0),
+                     const std::invalid_argument &);
+  }
+
+private:
+  /// The integral of exp(-u^2 / 2) sin(b u) from 0 to tau by Simpson's rule
+  double simpson(double b, double tau) {
+    const size_t n = 200000;
+    const double h = tau / static_cast<double>(n);
+    double sum = 0.0;
+    for (size_t i = 0; i <= n; ++i) {
+      const double u = static_cast<double>(i) * h;
+      const double f = std::exp(-u * u / 2) * std::sin(b * u);
+      sum += (i == 0 || i == n) ? f : (i % 2 == 1 ? 4 * f : 2 * f);
+    }
+    return sum * h / 3;
+  }
+};
+
+class StaticKuboToyabeTableTestPerformance : public CxxTest::TestSuite {
+public:
+  static StaticKuboToyabeTableTestPerformance *createSuite() {
+    return new StaticKuboToyabeTableTestPerformance();
+  }
+  static void destroySuite(StaticKuboToyabeTableTestPerformance *suite) {
+    delete suite;
+  }
+
+  void test_build_and_evaluate() {
+    double sum = 0.0;
+    for (size_t i = 1; i <= 200; ++i) {
+      StaticKuboToyabeTable table(0.05 * static_cast<double>(i), 10.0);
+      for (size_t k = 0; k < 1000; ++k) {
+        sum += table(0.01 * static_cast<double>(k));
+      }
+    }
+    TS_ASSERT(sum > 0.0);
+  }
+};
+
+#endif /* MANTID_CURVEFITTING_STATICKUBOTOYABETABLETEST_H_ */
@@ -11,7 +11,10 @@
 #include <cmath>
 #include <cxxtest/TestSuite.h>
 
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
 #include "MantidCurveFitting/Functions/ThermalNeutronBk2BkExpConvPVoigt.h"
+#include "MantidCurveFitting/Jacobian.h"
 
 using namespace Mantid;
 using namespace Kernel;
@@ -136,55 +139,16 @@ public:
     // 0. Mock data
     auto vecX = generateData();
 
-    // 1. Create peak
     ThermalNeutronBk2BkExpConvPVoigt peak;
-    peak.initialize();
-
-    peak.setMillerIndex(1, 1, 1);
-
-    // 2. Set up parameters
-    peak.setParameter("Dtt1", 29671.7500);
-    peak.setParameter("Dtt2", 0.0);
-    peak.setParameter("Dtt1t", 29671.750);
-    peak.setParameter("Dtt2t", 0.30);
-
-    peak.setParameter("Zero", 0.0);
-    peak.setParameter("Zerot", 33.70);
-
-    peak.setParameter("Alph0", 4.026);
-    peak.setParameter("Alph1", 7.362);
-    peak.setParameter("Beta0", 3.489);
-    peak.setParameter("Beta1", 19.535);
-
-    peak.setParameter("Alph0t", 60.683);
-    peak.setParameter("Alph1t", 39.730);
-    peak.setParameter("Beta0t", 96.864);
-    peak.setParameter("Beta1t", 96.864);
+    setUpE1Peak(peak);
 
-    peak.setParameter("Sig2", sqrt(11.380));
-    peak.setParameter("Sig1", sqrt(9.901));
-    peak.setParameter("Sig0", sqrt(17.370));
-
-    peak.setParameter("Width", 1.0055);
-    peak.setParameter("Tcross", 0.4700);
-
-    peak.setParameter("Gam0", 10.0);
-    peak.setParameter("Gam1", 0.0);
-    peak.setParameter("Gam2", 0.0);
-
-    peak.setParameter("LatticeConstant", 4.156890);
-
-    // double d1 = 2.399981; // 1 1 1
-    double h1 = 1370.0 / 0.008;
-    peak.setParameter("Height", h1);
-
-    // 3. Parameter check
+    // 1. Parameter check
     double tof_h = peak.centre();
     double fwhm = peak.fwhm();
     TS_ASSERT_DELTA(tof_h, 71229.45, 0.1);
     TS_ASSERT_DELTA(fwhm, 55.0613, 0.5);
 
-    // 3. Calculate
+    // 2. Calculate
     size_t nData = vecX.size();
     double *xvalues = new double[nData];
     double *out = new double[nData];
@@ -194,7 +158,7 @@ public:
     }
     peak.function1D(out, xvalues, nData);
 
-    // 4. Compare calculated data
+    // 3. Compare calculated data
     double y25 = 1421.27;
     TS_ASSERT_DELTA(out[25], y25, 1.0);
 
@@ -204,6 +168,47 @@ public:
     return;
   }
 
+  /** Test that only the points within the peak radius of a sorted domain are
+   * evaluated and differentiated
+   */
+  void test_function_and_derivatives_on_sorted_domain() {
+    ThermalNeutronBk2BkExpConvPVoigt peak;
+    setUpE1Peak(peak);
+    const double centre = peak.centre();
+    const double fwhm = peak.fwhm();
+
+    API::FunctionDomain1DVector domain(70500.0, 72000.0, 1501);
+    TS_ASSERT(domain.isSorted());
+    API::FunctionValues values(domain);
+    std::vector<double> expected(domain.size(), -1.0);
+    peak.function(domain, values);
+    peak.function1D(expected.data(), domain.getPointerAt(0), domain.size());
+    for (size_t i = 0; i < domain.size(); ++i) {
+      TS_ASSERT_EQUALS(values[i], expected[i]);
+    }
+
+    const size_t np = peak.nParams();
+    Mantid::CurveFitting::Jacobian local(domain.size(), np);
+    Mantid::CurveFitting::Jacobian all(domain.size(), np);
+    for (size_t iP = 0; iP < np; ++iP) {
+      local.set(0, iP, 1.0);
+    }
+    API::IFunction &fn = peak;
+    fn.functionDeriv(domain, local);
+    peak.calNumericalDeriv(domain, all);
+    for (size_t i = 0; i < domain.size(); ++i) {
+      const double distance = fabs(domain[i] - centre);
+      for (size_t iP = 0; iP < np; ++iP) {
+        if (distance < 4 * fwhm) {
+          TS_ASSERT_DELTA(local.get(i, iP), all.get(i, iP),
+                          1e-9 * (1.0 + fabs(all.get(i, iP))));
+        } else if (distance > 6 * fwhm) {
+          TS_ASSERT_EQUALS(local.get(i, iP), 0.0);
+        }
+      }
+    }
+  }
+
   /** Test on calcualte peak parameters including Gamma (i.e., E1())
    * Parameter and data is from PG3_11485, Bank 1, (200) @ TOF = 46963
    */
@@ -336,6 +341,48 @@ public:
     return vecX;
   }
 
+  /// Set up the (111) peak of PG3_11485, Bank 1
+  void setUpE1Peak(ThermalNeutronBk2BkExpConvPVoigt &peak) {
+    peak.initialize();
+
+    peak.setMillerIndex(1, 1, 1);
+
+    peak.setParameter("Dtt1", 29671.7500);
+    peak.setParameter("Dtt2", 0.0);
+    peak.setParameter("Dtt1t", 29671.750);
+    peak.setParameter("Dtt2t", 0.30);
+
+    peak.setParameter("Zero", 0.0);
+    peak.setParameter("Zerot", 33.70);
+
+    peak.setParameter("Alph0", 4.026);
+    peak.setParameter("Alph1", 7.362);
+    peak.setParameter("Beta0", 3.489);
+    peak.setParameter("Beta1", 19.535);
+
+    peak.setParameter("Alph0t", 60.683);
+    peak.setParameter("Alph1t", 39.730);
+    peak.setParameter("Beta0t", 96.864);
+    peak.setParameter("Beta1t", 96.864);
+
+    peak.setParameter("Sig2", sqrt(11.380));
+    peak.setParameter("Sig1", sqrt(9.901));
+    peak.setParameter("Sig0", sqrt(17.370));
+
+    peak.setParameter("Width", 1.0055);
+    peak.setParameter("Tcross", 0.4700);
+
+    peak.setParameter("Gam0", 10.0);
+    peak.setParameter("Gam1", 0.0);
+    peak.setParameter("Gam2", 0.0);
+
+    peak.setParameter("LatticeConstant", 4.156890);
+
+    // double d1 = 2.399981; // 1 1 1
+    double h1 = 1370.0 / 0.008;
+    peak.setParameter("Height", h1);
+  }
+
   /** Generate data from PG3_11485 Jason refined .prf file
    * @param vecX:   x-values
    * @param dataY:  experimental y-values
@@ -10,6 +10,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
 #include "MantidAPI/Jacobian.h"
 #include "MantidCurveFitting/Functions/UserFunction.h"
 
@@ -84,6 +85,87 @@ public:
     TS_ASSERT(categories.size() == 1);
     TS_ASSERT(categories[0] == "General");
   }
+
+  void test_derivatives_are_exact() {
+    UserFunction fun;
+    fun.setAttribute("Formula", UserFunction::Attribute("h*sin(a*x-c)"));
+    fun.setParameter("h", 2.2);
+    fun.setParameter("a", 2.0);
+    fun.setParameter("c", 1.2);
+
+    const size_t nData = 10;
+    std::vector<double> x(nData);
+    for (size_t i = 0; i < nData; i++) {
+      x[i] = 0.1 * static_cast<double>(i);
+    }
+    FunctionDomain1DVector domain(x);
+    UserTestJacobian J(nData, 3);
+    fun.functionDeriv(domain, J);
+
+    for (size_t i = 0; i < nData; i++) {
+      TS_ASSERT_DELTA(J.get(i, 0), sin(2 * x[i] - 1.2), 1e-14);
+      TS_ASSERT_DELTA(J.get(i, 1), 2.2 * cos(2 * x[i] - 1.2) * x[i], 1e-14);
+      TS_ASSERT_DELTA(J.get(i, 2), -2.2 * cos(2 * x[i] - 1.2), 1e-14);
+    }
+  }
+
+  void test_formula_that_cannot_be_compiled() {
+    UserFunction fun;
+    fun.setAttribute("Formula", UserFunction::Attribute("x > 1 ? a*x : a"));
+    fun.setParameter("a", 3.0);
+
+    const size_t nData = 4;
+    std::vector<double> x{0., 1., 2., 3.}, y(nData);
+    fun.function1D(&y[0], &x[0], nData);
+    TS_ASSERT_DELTA(y[0], 3., 1e-15);
+    TS_ASSERT_DELTA(y[1], 3., 1e-15);
+    TS_ASSERT_DELTA(y[2], 6., 1e-15);
+    TS_ASSERT_DELTA(y[3], 9., 1e-15);
+
+    FunctionDomain1DVector domain(x);
+    UserTestJacobian J(nData, 1);
+    fun.functionDeriv(domain, J);
+    TS_ASSERT_DELTA(J.get(0, 0), 1., 1e-6);
+    TS_ASSERT_DELTA(J.get(3, 0), 3., 1e-6);
+  }
+};
+
+class UserFunctionTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static UserFunctionTestPerformance *createSuite() {
+    return new UserFunctionTestPerformance();
+  }
+  static void destroySuite(UserFunctionTestPerformance *suite) {
+    delete suite;
+  }
+
+  UserFunctionTestPerformance()
+      : m_domain(-10.0, 10.0, 1000000), m_values(m_domain),
+        m_jacobian(static_cast<int>(m_domain.size()), 5) {
+    m_fun.setAttribute("Formula", UserFunction::Attribute(
+                                      "h*exp(-(x-c)^2/(2*s^2))+a+b*x"));
+    m_fun.setParameter("h", 10.0);
+    m_fun.setParameter("c", 0.5);
+    m_fun.setParameter("s", 1.5);
+    m_fun.setParameter("a", 1.0);
+    m_fun.setParameter("b", 0.1);
+  }
+
+  void test_function() { m_fun.function(m_domain, m_values); }
+
+  void test_derivatives() { m_fun.functionDeriv(m_domain, m_jacobian); }
+
+  void test_numerical_derivatives() {
+    m_fun.calNumericalDeriv(m_domain, m_jacobian);
+  }
+
+private:
+  UserFunction m_fun;
+  FunctionDomain1DVector m_domain;
+  FunctionValues m_values;
+  UserFunctionTest::UserTestJacobian m_jacobian;
 };
 
 #endif /*USERFUNCTIONTEST_H_*/
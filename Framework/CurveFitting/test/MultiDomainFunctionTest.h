@@ -14,6 +14,7 @@
 #include "MantidCurveFitting/Algorithms/Fit.h"
 #include "MantidCurveFitting/CostFunctions/CostFuncLeastSquares.h"
 #include "MantidCurveFitting/FuncMinimizers/LevenbergMarquardtMDMinimizer.h"
+#include "MantidCurveFitting/Jacobian.h"
 
 #include "MantidTestHelpers/FakeObjects.h"
 #include "MantidTestHelpers/MultiDomainFunctionHelper.h"
@@ -71,6 +72,123 @@ public:
     TS_ASSERT_THROWS_NOTHING(
         multi = Mantid::TestHelpers::makeMultiDomainFunction3());
   }
+
+  void test_derivatives_by_domain_match_full_jacobian() {
+    auto domain = Mantid::TestHelpers::makeMultiDomainDomain3();
+    auto values = makeValues(*domain);
+
+    auto multi = Mantid::TestHelpers::makeMultiDomainFunction3();
+    multi->setAttributeValue("NumDeriv", false);
+    // Keep away from zero, where the numerical derivatives are inaccurate
+    for (size_t i = 0; i < multi->nParams(); ++i) {
+      multi->setParameter(i, 1.0 + 0.5 * static_cast<double>(i));
+    }
+    multi->getFunction(2)->fix(1);
+
+    auto denseMulti = boost::dynamic_pointer_cast<MultiDomainFunction>(
+        multi->clone());
+    denseMulti->setAttributeValue("NumDeriv", true);
+    auto byDomain = boost::make_shared<CostFuncLeastSquares>();
+    byDomain->setFittingFunction(multi, domain, values);
+
+    TS_ASSERT_EQUALS(byDomain->nParams(), 5);
+    checkDerivHessian(*byDomain, *denseMulti, *domain, *values);
+  }
+
+  void test_numerical_derivatives_by_domain_with_global_tie() {
+    auto domain = Mantid::TestHelpers::makeMultiDomainDomain3();
+    auto values = makeValues(*domain);
+
+    // Each member fits its own domain and shares A through ties, like the
+    // fits of QENSFitSimultaneous. NumDeriv is left at its default of true.
+    auto multi = boost::make_shared<MultiDomainFunction>();
+    for (size_t i = 0; i < 3; ++i) {
+      auto member = boost::make_shared<CountingFunction>();
+      member->setParameter("A", 1.0);
+      member->setParameter("B", 1.0 + 0.5 * static_cast<double>(i));
+      multi->addFunction(member);
+      multi->setDomainIndex(i, i);
+    }
+    multi->tie("f1.A", "f0.A");
+    multi->tie("f2.A", "f0.A");
+    TS_ASSERT(multi->getAttribute("NumDeriv").asBool());
+
+    auto costFunction = boost::make_shared<CostFuncLeastSquares>();
+    costFunction->setFittingFunction(multi, domain, values);
+    TS_ASSERT_EQUALS(costFunction->nParams(), 4);
+    CountingFunction::count = 0;
+    costFunction->valDerivHessian();
+    // Each member is evaluated once and once more for a step in each of the
+    // two active parameters it depends on. The full Jacobian would evaluate
+    // every member for a step in each of the four active parameters.
+    TS_ASSERT_EQUALS(CountingFunction::count, 3 * (1 + 2));
+    checkDerivHessian(*costFunction, *multi, *domain, *values);
+  }
+
+private:
+  /// A member function counting its evaluations
+  class CountingFunction : public MultiDomainFunctionTest_Function {
+  public:
+    static size_t count;
+
+  protected:
+    void function1D(double *out, const double *xValues,
+                    const size_t nData) const override {
+      ++count;
+      MultiDomainFunctionTest_Function::function1D(out, xValues, nData);
+    }
+  };
+
+  boost::shared_ptr<FunctionValues> makeValues(const FunctionDomain &domain) {
+    auto values = boost::make_shared<FunctionValues>(domain);
+    for (size_t i = 0; i < values->size(); ++i) {
+      values->setFitData(i, 0.1 * static_cast<double>(i * i));
+    }
+    values->setFitWeights(0.5);
+    return values;
+  }
+
+  /// Check the derivatives and the Hessian of a cost function against the
+  /// ones from the Jacobian of function over the whole domain
+  void checkDerivHessian(const CostFuncLeastSquares &costFunction,
+                         MultiDomainFunction &function,
+                         const FunctionDomain &domain,
+                         const FunctionValues &values) {
+    const auto &der = costFunction.getDeriv();
+    const auto &hessian = costFunction.getHessian();
+
+    FunctionValues calculated(domain);
+    function.function(domain, calculated);
+    Mantid::CurveFitting::Jacobian jacobian(domain.size(), function.nParams());
+    function.functionDeriv(domain, jacobian);
+    std::vector<size_t> active;
+    for (size_t ip = 0; ip < function.nParams(); ++ip) {
+      if (function.isActive(ip))
+        active.push_back(ip);
+    }
+    TS_ASSERT_EQUALS(der.size(), active.size());
+
+    for (size_t i = 0; i < active.size(); ++i) {
+      double expectedDer = 0.0;
+      std::vector<double> expectedHessian(active.size(), 0.0);
+      for (size_t k = 0; k < domain.size(); ++k) {
+        const double w2 = values.getFitWeight(k) * values.getFitWeight(k);
+        const double residual =
+            calculated.getCalculated(k) - values.getFitData(k);
+        expectedDer += w2 * residual * jacobian.get(k, active[i]);
+        for (size_t j = 0; j < active.size(); ++j) {
+          expectedHessian[j] +=
+              w2 * jacobian.get(k, active[i]) * jacobian.get(k, active[j]);
+        }
+      }
+      TS_ASSERT_DELTA(der[i], expectedDer, 1e-5);
+      for (size_t j = 0; j < active.size(); ++j) {
+        TS_ASSERT_DELTA(hessian.get(i, j), expectedHessian[j], 1e-5);
+      }
+    }
+  }
 };
 
+size_t MultiDomainFunctionTest::CountingFunction::count = 0;
+
 #endif /*MULTIDOMAINFUNCTIONTEST_H_*/
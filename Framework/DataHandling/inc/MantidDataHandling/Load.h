@@ -43,6 +43,8 @@ public:
   /// Override setPropertyValue
   void setPropertyValue(const std::string &name,
                         const std::string &value) override;
+  /// The concrete loader may not be thread safe
+  bool threadSafe() const override { return false; }
 
 protected:
   Parallel::ExecutionMode getParallelExecutionMode(
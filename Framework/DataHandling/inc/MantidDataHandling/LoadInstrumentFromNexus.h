@@ -70,6 +70,8 @@ public:
 
   /// Algorithm's version for identification overriding a virtual method
   int version() const override { return 1; };
+  /// The HDF5 library is not built thread safe
+  bool threadSafe() const override { return false; }
   const std::vector<std::string> seeAlso() const override {
     return {"LoadInstrument", "Load"};
   }
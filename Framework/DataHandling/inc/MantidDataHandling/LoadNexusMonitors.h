@@ -43,6 +43,8 @@ public:
 
   /// Algorithm's version for identification overriding a virtual method
   int version() const override { return 1; }
+  /// The HDF5 library is not built thread safe
+  bool threadSafe() const override { return false; }
 
   /// Algorithm's category for identification overriding a virtual method
   const std::string category() const override { return "DataHandling\\Nexus"; }
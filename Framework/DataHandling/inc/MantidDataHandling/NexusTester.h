@@ -27,6 +27,8 @@ public:
   }
 
   int version() const override;
+  /// The HDF5 library is not built thread safe
+  bool threadSafe() const override { return false; }
   const std::string category() const override;
 
 private:
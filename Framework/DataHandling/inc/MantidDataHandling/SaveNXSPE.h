@@ -51,6 +51,8 @@ public:
 
   /// Algorithm's version
   int version() const override { return (1); }
+  /// The HDF5 library is not built thread safe
+  bool threadSafe() const override { return false; }
   const std::vector<std::string> seeAlso() const override {
     return {"LoadNXSPE", "SaveSPE"};
   }
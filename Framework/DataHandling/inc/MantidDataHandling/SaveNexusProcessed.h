@@ -7,6 +7,7 @@
 #ifndef MANTID_DATAHANDLING_SAVENEXUSPROCESSED_H_
 #define MANTID_DATAHANDLING_SAVENEXUSPROCESSED_H_
 
+#include "MantidAPI/AlgorithmHistory.h"
 #include "MantidAPI/Progress.h"
 #include "MantidAPI/SerialAlgorithm.h"
 #include "MantidDataObjects/EventWorkspace.h"
@@ -47,6 +48,8 @@ public:
 
   /// Algorithm's version for identification overriding a virtual method
   int version() const override { return 1; }
+  /// The HDF5 library is not built thread safe
+  bool threadSafe() const override { return false; }
   const std::vector<std::string> seeAlso() const override {
     return {"SaveISISNexus", "SaveNexus", "LoadNexusProcessed"};
   }
@@ -101,6 +104,8 @@ private:
   double m_timeProgInit{0.0};
   /// Progress bar
   std::unique_ptr<API::Progress> m_progress;
+  /// The history groups written to the file, shared by the entries of a group
+  API::AlgorithmHistoryNexusLinks m_historyLinks;
 };
 
 } // namespace DataHandling
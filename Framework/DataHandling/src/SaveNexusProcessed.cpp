@@ -300,7 +300,7 @@ void SaveNexusProcessed::doExec(
     }
   }
 
-  inputWorkspace->history().saveNexus(&cppFile);
+  inputWorkspace->history().saveNexus(&cppFile, &m_historyLinks);
   nexusFile->closeGroup();
 }
 
@@ -314,6 +314,7 @@ void SaveNexusProcessed::exec() {
 
   // Then immediately open the file
   auto nexusFile = boost::make_shared<Mantid::NeXus::NexusFileIO>();
+  m_historyLinks.clear();
 
   // Perform the execution.
   doExec(inputWorkspace, nexusFile);
@@ -518,7 +519,9 @@ bool SaveNexusProcessed::processGroups() {
   // If we have arrived here then a WorkspaceGroup was passed to the
   // InputWorkspace property. Pull out the unrolled workspaces and append an
   // entry for each one. We only have a single input workspace property declared
-  // so there will only be a single list of unrolled workspaces
+  // so there will only be a single list of unrolled workspaces. Histories the
+  // entries share are written with the first and linked to from the others.
+  m_historyLinks.clear();
   const auto &workspaces = m_unrolledInputWorkspaces[0];
   if (!workspaces.empty()) {
     for (size_t entry = 0; entry < workspaces.size(); entry++) {
@@ -7,6 +7,8 @@
 #ifndef LOADNEXUSPROCESSEDTEST_H_
 #define LOADNEXUSPROCESSEDTEST_H_
 
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/AlgorithmHistory.h"
 #include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/FileFinder.h"
@@ -14,6 +16,7 @@
 #include "MantidAPI/NumericAxis.h"
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidAPI/WorkspaceHistory.h"
+#include "MantidAPI/WorkspaceProperty.h"
 #include "MantidDataHandling/Load.h"
 #include "MantidDataHandling/LoadInstrument.h"
 #include "MantidDataHandling/LoadNexusProcessed.h"
@@ -25,6 +28,8 @@
 #include "MantidGeometry/IDTypes.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/make_unique.h"
 
 #include "SaveNexusProcessedTest.h"
 
@@ -33,6 +38,7 @@
 #include <hdf5.h>
 
 #include <Poco/File.h>
+#include <Poco/TemporaryFile.h>
 
 #include <string>
 
@@ -44,6 +50,38 @@ using namespace Mantid::DataObjects;
 using namespace Mantid::API;
 using Mantid::detid_t;
 
+namespace {
+/// Scales its input, counting how often it runs
+class CachedScaleAlgorithm : public Algorithm {
+public:
+  const std::string name() const override { return "CachedScaleAlgorithm"; }
+  int version() const override { return 1; }
+  const std::string summary() const override { return "Test"; }
+  bool cacheable() const override { return true; }
+
+  void init() override {
+    declareProperty(
+        Mantid::Kernel::make_unique<WorkspaceProperty<MatrixWorkspace>>(
+            "InputWorkspace", "", Direction::Input));
+    declareProperty("Factor", 1.0);
+    declareProperty(
+        Mantid::Kernel::make_unique<WorkspaceProperty<MatrixWorkspace>>(
+            "OutputWorkspace", "", Direction::Output));
+  }
+  void exec() override {
+    ++executions;
+    MatrixWorkspace_const_sptr input = getProperty("InputWorkspace");
+    const double factor = getProperty("Factor");
+    MatrixWorkspace_sptr output = input->clone();
+    for (size_t i = 0; i < output->getNumberHistograms(); ++i)
+      output->mutableY(i) *= factor;
+    setProperty("OutputWorkspace", output);
+  }
+
+  int executions = 0;
+};
+} // namespace
+
 // Note that this suite tests an old version of Nexus processed files that we
 // continue to support.
 // LoadRawSaveNxsLoadNxs tests the current version of Nexus processed by loading
@@ -1110,7 +1148,201 @@ public:
     }
   }
 
+  void test_analysis_data_service_spills_and_reloads_workspaces() {
+    auto &ads = AnalysisDataService::Instance();
+    ads.clear();
+    ads.add("spill_one", createNumberedWorkspace(1.));
+    const size_t workspaceMemory = ads.memoryLedger().totalMemory();
+    TS_ASSERT(workspaceMemory > 0);
+    ads.setMemoryBudget(workspaceMemory + workspaceMemory / 2);
+
+    // Adding a second workspace goes over the budget and the least recently
+    // used one is written to disk
+    ads.add("spill_two", createNumberedWorkspace(2.));
+    const auto &ledger = ads.memoryLedger();
+    TS_ASSERT(ledger.isSpilled("spill_one"));
+    TS_ASSERT(!ledger.isSpilled("spill_two"));
+    const std::string spillFile = ledger.spillFile("spill_one");
+    TS_ASSERT(Poco::File(spillFile).exists());
+    TS_ASSERT_EQUALS(ledger.totalMemory(), workspaceMemory);
+
+    // Listing the workspaces does not load them back
+    const auto items = ads.topLevelItems();
+    TS_ASSERT_EQUALS(items.size(), 2);
+    TS_ASSERT_EQUALS(items.at("spill_one")->id(), "Workspace2D");
+    TS_ASSERT(ledger.isSpilled("spill_one"));
+
+    // Retrieving reloads the data and spills the other workspace instead
+    auto reloaded = ads.retrieveWS<MatrixWorkspace>("spill_one");
+    TS_ASSERT(reloaded);
+    TS_ASSERT(!ledger.isSpilled("spill_one"));
+    TS_ASSERT(!Poco::File(spillFile).exists());
+    TS_ASSERT(ledger.isSpilled("spill_two"));
+    checkNumberedWorkspace(*reloaded, 1.);
+
+    // getObjects returns real workspaces only
+    for (const auto &ws : ads.getObjects()) {
+      auto matrix = boost::dynamic_pointer_cast<MatrixWorkspace>(ws);
+      TS_ASSERT(matrix);
+      if (matrix && matrix->getName() == "spill_two")
+        checkNumberedWorkspace(*matrix, 2.);
+    }
+
+    ads.setMemoryBudget(0);
+    ads.clear();
+  }
+
+  void test_history_shared_by_group_members_is_linked_and_restored() {
+    auto &ads = AnalysisDataService::Instance();
+    auto first = createNumberedWorkspace(1.);
+    auto shared = boost::make_shared<AlgorithmHistory>(
+        "CreateNumbered", 1, "8c7b1f3e-shared-history");
+    shared->addProperty("Number", "1", false, Direction::Input);
+    first->history().addHistory(shared);
+    // The clone shares the history, then records one of its own
+    MatrixWorkspace_sptr second = first->clone();
+    auto own = boost::make_shared<AlgorithmHistory>("Scale", 1,
+                                                    "8c7b1f3e-own-history");
+    own->addProperty("Factor", "2", false, Direction::Input);
+    second->history().addHistory(own);
+    ads.addOrReplace("shared_history_1", first);
+    ads.addOrReplace("shared_history_2", second);
+    auto group = boost::make_shared<WorkspaceGroup>();
+    group->addWorkspace(first);
+    group->addWorkspace(second);
+    ads.addOrReplace("shared_history", group);
+
+    SaveNexusProcessed save;
+    save.initialize();
+    save.setPropertyValue("InputWorkspace", "shared_history");
+    save.setPropertyValue("Filename", "LoadNexusProcessed_SharedHistory.nxs");
+    TS_ASSERT_THROWS_NOTHING(save.execute());
+    const std::string filename = save.getPropertyValue("Filename");
+
+    // The second entry links to the history group written with the first
+    const std::string sharedPath = "/process/MantidAlgorithm_1";
+    TS_ASSERT_EQUALS(
+        objectAddress(filename, "/mantid_workspace_2" + sharedPath),
+        objectAddress(filename, "/mantid_workspace_1" + sharedPath));
+
+    LoadNexusProcessed load;
+    load.initialize();
+    load.setPropertyValue("Filename", filename);
+    load.setPropertyValue("OutputWorkspace", "shared_history_loaded");
+    TS_ASSERT_THROWS_NOTHING(load.execute());
+    Poco::File(filename).remove();
+
+    auto loaded = ads.retrieveWS<WorkspaceGroup>("shared_history_loaded");
+    TS_ASSERT(loaded);
+    if (!loaded)
+      return;
+    TS_ASSERT_EQUALS(loaded->getNumberOfEntries(), 2);
+    for (int i = 0; i < 2; ++i) {
+      const auto &history = loaded->getItem(i)->getHistory();
+      // The loaded histories end with LoadNexusProcessed
+      TS_ASSERT_EQUALS(history.size(), static_cast<size_t>(i + 2));
+      const auto restored = history.getAlgorithmHistory(0);
+      TS_ASSERT_EQUALS(restored->name(), "CreateNumbered");
+      TS_ASSERT_EQUALS(restored->getPropertyValue("Number"), "1");
+    }
+    const auto restoredOwn =
+        loaded->getItem(1)->getHistory().getAlgorithmHistory(1);
+    TS_ASSERT_EQUALS(restoredOwn->name(), "Scale");
+    TS_ASSERT_EQUALS(restoredOwn->getPropertyValue("Factor"), "2");
+    ads.clear();
+  }
+
+  void test_algorithm_result_cache_restores_workspace_outputs() {
+    auto &config = ConfigService::Instance();
+    const std::string directory =
+        config.getString("algorithms.cache.directory");
+    const std::string cacheDirectory = Poco::TemporaryFile::tempName();
+    config.setString("algorithms.cache.directory", cacheDirectory);
+    auto input = createNumberedWorkspace(1.);
+
+    // The first execution saves its output with SaveNexusProcessed, the
+    // second loads it with LoadNexusProcessed instead of running
+    CachedScaleAlgorithm computed;
+    runCachedScale(computed, input);
+    CachedScaleAlgorithm restored;
+    runCachedScale(restored, input);
+    config.setString("algorithms.cache.directory", directory);
+
+    TS_ASSERT_EQUALS(computed.executions, 1);
+    TS_ASSERT_EQUALS(restored.executions, 0);
+    TS_ASSERT(restored.isExecuted());
+    MatrixWorkspace_sptr computedWS = computed.getProperty("OutputWorkspace");
+    MatrixWorkspace_sptr restoredWS = restored.getProperty("OutputWorkspace");
+    TS_ASSERT(computedWS);
+    TS_ASSERT(restoredWS);
+    if (computedWS && restoredWS) {
+      TS_ASSERT_DIFFERS(restoredWS, computedWS);
+      checkSameData(*restoredWS, *computedWS);
+      TS_ASSERT_EQUALS(restoredWS->y(2)[3], 2. * (1000. + 200. + 3.));
+    }
+    Poco::File(cacheDirectory).remove(true);
+  }
+
 private:
+  void runCachedScale(CachedScaleAlgorithm &alg,
+                      const MatrixWorkspace_sptr &input) {
+    alg.initialize();
+    alg.setChild(true);
+    alg.setRethrows(true);
+    alg.setProperty("InputWorkspace", input);
+    alg.setProperty("Factor", 2.);
+    alg.setPropertyValue("OutputWorkspace", "cached_scale");
+    alg.execute();
+  }
+
+  /// A small workspace whose values identify the workspace, spectrum and bin
+  MatrixWorkspace_sptr createNumberedWorkspace(double number) {
+    auto ws = WorkspaceCreationHelper::create2DWorkspaceBinned(5, 20);
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i) {
+      auto &y = ws->mutableY(i);
+      for (size_t j = 0; j < y.size(); ++j)
+        y[j] = 1000. * number + 100. * static_cast<double>(i) +
+               static_cast<double>(j);
+    }
+    return ws;
+  }
+
+  void checkNumberedWorkspace(const MatrixWorkspace &ws, double number) {
+    TS_ASSERT_EQUALS(ws.getNumberHistograms(), 5);
+    for (size_t i = 0; i < ws.getNumberHistograms(); ++i) {
+      const auto &y = ws.y(i);
+      TS_ASSERT_EQUALS(y.size(), 20);
+      for (size_t j = 0; j < y.size(); ++j)
+        TS_ASSERT_EQUALS(y[j], 1000. * number + 100. * static_cast<double>(i) +
+                                   static_cast<double>(j));
+    }
+  }
+
+  /// The address of the object at path in a file, which links share
+  haddr_t objectAddress(const std::string &filename, const std::string &path) {
+    auto fid = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    H5O_info_t info;
+    const auto status =
+        H5Oget_info_by_name(fid, path.c_str(), &info, H5P_DEFAULT);
+    H5Fclose(fid);
+    TSM_ASSERT(path + " not found", status >= 0);
+    return status >= 0 ? info.addr : HADDR_UNDEF;
+  }
+
+  /// Compare the data and spectra of two workspaces
+  void checkSameData(const MatrixWorkspace &ws, const MatrixWorkspace &other) {
+    TS_ASSERT_EQUALS(ws.getNumberHistograms(), other.getNumberHistograms());
+    for (size_t i = 0; i < ws.getNumberHistograms(); ++i) {
+      TS_ASSERT_EQUALS(ws.x(i).rawData(), other.x(i).rawData());
+      TS_ASSERT_EQUALS(ws.y(i).rawData(), other.y(i).rawData());
+      TS_ASSERT_EQUALS(ws.e(i).rawData(), other.e(i).rawData());
+      TS_ASSERT_EQUALS(ws.getSpectrum(i).getSpectrumNo(),
+                       other.getSpectrum(i).getSpectrumNo());
+      TS_ASSERT_EQUALS(ws.getSpectrum(i).getDetectorIDs(),
+                       other.getSpectrum(i).getDetectorIDs());
+    }
+  }
+
   void doHistoryTest(MatrixWorkspace_sptr matrix_ws) {
     const WorkspaceHistory history = matrix_ws->getHistory();
     int nalgs = static_cast<int>(history.size());
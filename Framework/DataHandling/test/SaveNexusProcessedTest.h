@@ -79,6 +79,12 @@ public:
     TS_ASSERT(algToBeTested.isInitialized());
   }
 
+  void testNotThreadSafe() {
+    // HDF5 must not be called from two algorithms at once
+    SaveNexusProcessed algToBeTested;
+    TS_ASSERT(!algToBeTested.threadSafe());
+  }
+
   void testExec() {
     auto useXErrors = false;
     std::string outputFile = "SaveNexusProcessedTest_testExec.nxs";
@@ -12,6 +12,7 @@
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/cow_ptr.h"
+#include <boost/shared_ptr.hpp>
 #include <iosfwd>
 #include <vector>
 
@@ -59,7 +60,7 @@ class DLLExport EventList : public Mantid::API::IEventList {
 public:
   EventList();
 
-  EventList(EventWorkspaceMRU *mru, specnum_t specNo);
+  EventList(boost::shared_ptr<EventWorkspaceMRU> mru, specnum_t specNo);
 
   EventList(const EventList &rhs);
 
@@ -147,7 +148,7 @@ public:
   void clear(const bool removeDetIDs = true) override;
   void clearUnused();
 
-  void setMRU(EventWorkspaceMRU *newMRU);
+  void setMRU(const boost::shared_ptr<EventWorkspaceMRU> &newMRU);
 
   void clearData() override;
 
@@ -382,8 +383,9 @@ private:
   /// Last sorting order
   mutable EventSortType order;
 
-  /// MRU lists of the parent EventWorkspace
-  mutable EventWorkspaceMRU *mru;
+  /// MRU lists of the EventWorkspace that created or last modified the list.
+  /// Held jointly as an unmodified list may outlive that workspace in a clone.
+  mutable boost::shared_ptr<EventWorkspaceMRU> mru;
 
   /// Mutex that is locked while sorting an event list
   mutable std::mutex m_sortMutex;
@@ -11,6 +11,7 @@
 #include "MantidAPI/ISpectrum.h"
 #include "MantidDataObjects/EventList.h"
 #include "MantidKernel/System.h"
+#include "MantidKernel/cow_ptr.h"
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <string>
 
@@ -68,6 +69,7 @@ public:
   std::size_t blocksize() const override;
 
   size_t getMemorySize() const override;
+  void getMemoryBlocks(std::vector<MemoryBlock> &blocks) const override;
 
   // Get the number of histograms. aka the number of pixels or detectors.
   std::size_t getNumberHistograms() const override;
@@ -77,6 +79,7 @@ public:
     return getSpectrumWithoutInvalidation(index);
   }
   const EventList &getSpectrum(const size_t index) const override;
+  void clearEventList(const size_t index);
 
   //------------------------------------------------------------
 
@@ -166,13 +169,18 @@ private:
 
   EventList &getSpectrumWithoutInvalidation(const size_t index) override;
 
+  EventList &mutableEventList(const size_t index);
+
   /** A vector that holds the event list for each spectrum; the key is
-   * the workspace index, which is not necessarily the pixelid.
+   * the workspace index, which is not necessarily the pixelid. Clones share
+   * the lists until one of them is modified.
    */
-  std::vector<EventList *> data;
+  std::vector<Kernel::cow_ptr<EventList>> data;
 
-  /// Container for the MRU lists of the event lists contained.
-  mutable EventWorkspaceMRU *mru;
+  /// Container for the MRU lists of the event lists this workspace created or
+  /// modified. Lists still shared with the workspace this was cloned from use
+  /// the MRU of that workspace.
+  boost::shared_ptr<EventWorkspaceMRU> mru;
 };
 
 /// shared pointer to the EventWorkspace class
@@ -55,6 +55,8 @@ public:
   std::size_t size() const override;
   std::size_t blocksize() const override;
 
+  void getMemoryBlocks(std::vector<MemoryBlock> &blocks) const override;
+
   Histogram1D &getSpectrum(const size_t index) override {
     invalidateCommonBinsFlag();
     return getSpectrumWithoutInvalidation(index);
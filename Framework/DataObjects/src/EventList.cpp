@@ -157,13 +157,14 @@ EventList::EventList()
       eventType(TOF), order(UNSORTED), mru(nullptr) {}
 
 /** Constructor with a MRU list
- * @param mru :: pointer to the MRU of the parent EventWorkspace
+ * @param mru :: the MRU of the parent EventWorkspace
  * @param specNo :: the spectrum number for the event list
  */
-EventList::EventList(EventWorkspaceMRU *mru, specnum_t specNo)
+EventList::EventList(boost::shared_ptr<EventWorkspaceMRU> mru,
+                     specnum_t specNo)
     : IEventList(specNo), m_histogram(HistogramData::Histogram::XMode::BinEdges,
                                       HistogramData::Histogram::YMode::Counts),
-      eventType(TOF), order(UNSORTED), mru(mru) {}
+      eventType(TOF), order(UNSORTED), mru(std::move(mru)) {}
 
 /** Constructor copying from an existing event list
  * @param rhs :: EventList object to copy*/
@@ -334,6 +335,11 @@ void EventList::createFromHistogram(const ISpectrum *inSpec, bool GenerateZeros,
  * @return reference to this
  * */
 EventList &EventList::operator=(const EventList &rhs) {
+  if (this == &rhs)
+    return *this;
+  // The events of rhs may be sorted through const access while they are
+  // copied, e.g. when rhs is shared by several workspaces
+  std::lock_guard<std::mutex> _lock(rhs.m_sortMutex);
   // Note that we are NOT copying the MRU pointer.
   IEventList::operator=(rhs);
   m_histogram = rhs.m_histogram;
@@ -928,11 +934,18 @@ void EventList::clearUnused() {
 /// Mask the spectrum to this value. Removes all events.
 void EventList::clearData() { this->clear(false); }
 
-/** Sets the MRU list for this event list
+/** Sets the MRU list for this event list. Histograms cached in the previous
+ * MRU are removed from it.
  *
  * @param newMRU :: new MRU for the workspace containing this EventList
  */
-void EventList::setMRU(EventWorkspaceMRU *newMRU) { mru = newMRU; }
+void EventList::setMRU(const boost::shared_ptr<EventWorkspaceMRU> &newMRU) {
+  if (newMRU == mru)
+    return;
+  if (mru)
+    mru->deleteIndex(this);
+  mru = newMRU;
+}
 
 /** Reserve a certain number of entries in the (NOT-WEIGHTED) event list. Do NOT
  *call
@@ -45,24 +45,20 @@ using std::size_t;
 using namespace Mantid::Kernel;
 
 EventWorkspace::EventWorkspace(const Parallel::StorageMode storageMode)
-    : IEventWorkspace(storageMode), mru(new EventWorkspaceMRU) {}
-
+    : IEventWorkspace(storageMode),
+      mru(boost::make_shared<EventWorkspaceMRU>()) {}
+
+/** Copy constructor. The event lists are shared with other and only copied
+ * when either workspace modifies them, so cloning does not copy any events.
+ * The copy has its own, empty, MRU. Shared lists keep caching their
+ * histograms in the MRU of other until they are copied.
+ * @param other :: The workspace to copy
+ */
 EventWorkspace::EventWorkspace(const EventWorkspace &other)
-    : IEventWorkspace(other), mru(new EventWorkspaceMRU) {
-  for (const auto &el : other.data) {
-    // Create a new event list, copying over the events
-    auto newel = new EventList(*el);
-    // Make sure to update the MRU to point to THIS event workspace.
-    newel->setMRU(this->mru);
-    this->data.push_back(newel);
-  }
-}
+    : IEventWorkspace(other), data(other.data),
+      mru(boost::make_shared<EventWorkspaceMRU>()) {}
 
-EventWorkspace::~EventWorkspace() {
-  for (auto &eventList : data)
-    delete eventList;
-  delete mru;
-}
+EventWorkspace::~EventWorkspace() = default;
 
 /** Returns true if the EventWorkspace is safe for multithreaded operations.
  * WARNING: This is only true for OpenMP threading. EventWorkspace is NOT thread
@@ -100,14 +96,16 @@ void EventWorkspace::init(const std::size_t &NVectors,
   HistogramData::BinEdges edges{0.0, std::numeric_limits<double>::min()};
 
   // Initialize the data
-  data.resize(NVectors, nullptr);
+  data.clear();
+  data.reserve(NVectors);
   // Make sure SOMETHING exists for all initialized spots.
   EventList el;
   el.setHistogram(edges);
   for (size_t i = 0; i < NVectors; i++) {
-    data[i] = new EventList(el);
-    data[i]->setMRU(mru);
-    data[i]->setSpectrumNo(specnum_t(i));
+    auto list = boost::make_shared<EventList>(el);
+    list->setMRU(mru);
+    list->setSpectrumNo(specnum_t(i));
+    data.emplace_back(std::move(list));
   }
 
   // Create axes.
@@ -125,13 +123,16 @@ void EventWorkspace::init(const HistogramData::Histogram &histogram) {
     throw std::runtime_error(
         "EventWorkspace cannot be initialized non-NULL Y or E data");
 
-  data.resize(numberOfDetectorGroups(), nullptr);
+  const size_t numberOfSpectra = numberOfDetectorGroups();
+  data.clear();
+  data.reserve(numberOfSpectra);
   EventList el;
   el.setHistogram(histogram);
-  for (size_t i = 0; i < data.size(); i++) {
-    data[i] = new EventList(el);
-    data[i]->setMRU(mru);
-    data[i]->setSpectrumNo(specnum_t(i));
+  for (size_t i = 0; i < numberOfSpectra; i++) {
+    auto list = boost::make_shared<EventList>(el);
+    list->setMRU(mru);
+    list->setSpectrumNo(specnum_t(i));
+    data.emplace_back(std::move(list));
   }
 
   m_axes.resize(2);
@@ -143,7 +144,7 @@ void EventWorkspace::init(const HistogramData::Histogram &histogram) {
 /// @returns the number of single indexable items in the workspace
 size_t EventWorkspace::size() const {
   return std::accumulate(data.begin(), data.end(), static_cast<size_t>(0),
-                         [](size_t value, EventList *histo) {
+                         [](size_t value, const cow_ptr<EventList> &histo) {
                            return value + histo->histogram_size();
                          });
 }
@@ -156,7 +157,7 @@ size_t EventWorkspace::blocksize() const {
                            "therefore cannot determine blocksize (# of bins).");
   } else {
     size_t numBins = data[0]->histogram_size();
-    for (const auto *iter : data)
+    for (const auto &iter : data)
       if (numBins != iter->histogram_size())
         throw std::length_error(
             "blocksize undefined because size of histograms is not equal");
@@ -170,14 +171,28 @@ size_t EventWorkspace::blocksize() const {
  */
 size_t EventWorkspace::getNumberHistograms() const { return this->data.size(); }
 
-/// Return const reference to EventList at the given workspace index.
+/// Return reference to EventList at the given workspace index.
 EventList &EventWorkspace::getSpectrumWithoutInvalidation(const size_t index) {
-  auto &spec = const_cast<EventList &>(
-      static_cast<const EventWorkspace &>(*this).getSpectrum(index));
+  if (index >= data.size())
+    throw std::range_error(
+        "EventWorkspace::getSpectrum, workspace index out of range");
+  auto &spec = mutableEventList(index);
   spec.setMatrixWorkspace(this, index);
   return spec;
 }
 
+/** Return the EventList at the given workspace index for modification. It is
+ * copied first if it is shared with another workspace.
+ * @param index :: The workspace index, which must be in range
+ * @return The event list, owned only by this workspace
+ */
+EventList &EventWorkspace::mutableEventList(const size_t index) {
+  // A copy, or a list this workspace was cloned with, does not use our MRU
+  auto &list = data[index].access();
+  list.setMRU(mru);
+  return list;
+}
+
 /// Return const reference to EventList at the given workspace index.
 const EventList &EventWorkspace::getSpectrum(const size_t index) const {
   if (index >= data.size())
@@ -186,6 +201,25 @@ const EventList &EventWorkspace::getSpectrum(const size_t index) const {
   return *data[index];
 }
 
+/** Replace the EventList at the given workspace index with an empty one that
+ * keeps its spectrum number, detector IDs, X values and event type. Unlike
+ * clearing the list from getSpectrum(), a list shared with another workspace
+ * is released instead of being copied first.
+ * @param index :: The workspace index
+ */
+void EventWorkspace::clearEventList(const size_t index) {
+  if (index >= data.size())
+    throw std::range_error(
+        "EventWorkspace::clearEventList, workspace index out of range");
+  const auto &old = *data[index];
+  auto list = boost::make_shared<EventList>(mru, old.getSpectrumNo());
+  list->setDetectorIDs(old.getDetectorIDs());
+  list->setSharedX(old.sharedX());
+  list->switchTo(old.getEventType());
+  list->setMatrixWorkspace(this, index);
+  data[index] = std::move(list);
+}
+
 double EventWorkspace::getTofMin() const { return this->getEventXMin(); }
 
 double EventWorkspace::getTofMax() const { return this->getEventXMax(); }
@@ -405,7 +439,7 @@ void EventWorkspace::getEventXMinMax(double &xmin, double &xmax) const {
 /// @returns The total number of events
 size_t EventWorkspace::getNumberEvents() const {
   return std::accumulate(data.begin(), data.end(), size_t{0},
-                         [](size_t total, EventList *list) {
+                         [](size_t total, const cow_ptr<EventList> &list) {
                            return total + list->getNumberEvents();
                          });
 }
@@ -416,7 +450,7 @@ size_t EventWorkspace::getNumberEvents() const {
  */
 Mantid::API::EventType EventWorkspace::getEventType() const {
   Mantid::API::EventType out = Mantid::API::TOF;
-  for (auto list : this->data) {
+  for (const auto &list : this->data) {
     Mantid::API::EventType thisType = list->getEventType();
     if (static_cast<int>(out) < static_cast<int>(thisType)) {
       out = thisType;
@@ -433,8 +467,8 @@ Mantid::API::EventType EventWorkspace::getEventType() const {
  * @param type :: EventType to switch to
  */
 void EventWorkspace::switchEventType(const Mantid::API::EventType type) {
-  for (auto &eventList : this->data)
-    eventList->switchTo(type);
+  for (size_t i = 0; i < data.size(); ++i)
+    mutableEventList(i).switchTo(type);
 }
 
 /// Returns true always - an EventWorkspace always represents histogramm-able
@@ -457,7 +491,8 @@ size_t EventWorkspace::getMemorySize() const {
 
   // Add the memory from all the event lists
   size_t total = std::accumulate(data.begin(), data.end(), size_t{0},
-                                 [](size_t total, EventList *list) {
+                                 [](size_t total,
+                                    const cow_ptr<EventList> &list) {
                                    return total + list->getMemorySize();
                                  });
 
@@ -578,6 +613,17 @@ void EventWorkspace::generateHistogramPulseTime(const std::size_t index,
   this->data[index]->generateHistogramPulseTime(X, Y, E, skipError);
 }
 
+/**
+ * Append the memory blocks of the workspace. Each event list is reported
+ * separately so that lists shared with clones can be counted once.
+ * @param blocks :: A list to append the blocks to
+ */
+void EventWorkspace::getMemoryBlocks(std::vector<MemoryBlock> &blocks) const {
+  blocks.push_back({{}, run().getMemorySize() + getMemorySizeForXAxes()});
+  for (const auto &list : data)
+    blocks.push_back({list.weak(), list->getMemorySize()});
+}
+
 /** Set all histogram X vectors.
  * @param x :: The X vector of histogram bins to use.
  */
@@ -586,8 +632,8 @@ void EventWorkspace::setAllX(const HistogramData::BinEdges &x) {
   // the MRU below, i.e., we avoid the size check of Histogram::setBinEdges and
   // just reset the whole Histogram.
   invalidateCommonBinsFlag();
-  for (auto &eventList : this->data)
-    eventList->setHistogram(x);
+  for (size_t i = 0; i < data.size(); ++i)
+    mutableEventList(i).setHistogram(x);
 
   // Clear MRU lists now, free up memory
   this->clearMRU();
@@ -695,7 +741,7 @@ void EventWorkspace::getIntegratedSpectra(std::vector<double> &out,
   for (int wksp_index = 0; wksp_index < int(this->getNumberHistograms());
        wksp_index++) {
     // Get Handle to data
-    EventList *el = this->data[wksp_index];
+    const EventList *el = this->data[wksp_index].get();
 
     // Let the eventList do the integration
     out[wksp_index] = el->integrate(minX, maxX, entireRange);
@@ -7,6 +7,7 @@
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidAPI/ISpectrum.h"
 #include "MantidAPI/RefAxis.h"
+#include "MantidAPI/Run.h"
 #include "MantidAPI/SpectraAxis.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidHistogramData/LinearGenerator.h"
@@ -152,6 +153,26 @@ size_t Workspace2D::blocksize() const {
   }
 }
 
+/**
+ * Append the memory blocks of the workspace. Each X, Y, E and Dx array is
+ * reported separately so that arrays shared between spectra or between
+ * workspaces through Kernel::cow_ptr can be counted once.
+ * @param blocks :: A list to append the blocks to
+ */
+void Workspace2D::getMemoryBlocks(std::vector<MemoryBlock> &blocks) const {
+  blocks.push_back({{}, run().getMemorySize()});
+  const auto addBlock = [&blocks](const auto &array) {
+    if (array)
+      blocks.push_back({array.weak(), array->size() * sizeof(double)});
+  };
+  for (const auto *histo : data) {
+    addBlock(histo->sharedX());
+    addBlock(histo->sharedY());
+    addBlock(histo->sharedE());
+    addBlock(histo->sharedDx());
+  }
+}
+
 /**
  * Copy the data (Y's) from an image to this workspace.
  * @param image :: An image to copy the data from.
@@ -20,6 +20,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include <string>
+#include <thread>
 
 #include "MantidAPI/Axis.h"
 #include "MantidAPI/SpectrumInfo.h"
@@ -807,6 +808,32 @@ public:
     TS_ASSERT_EQUALS(y.use_count(), 1);
   }
 
+  void test_clearEventList_releases_a_shared_list() {
+    auto ws = WorkspaceCreationHelper::createRandomEventWorkspace(2, 2);
+    ws->getSpectrum(0).setSpectrumNo(7);
+    ws->getSpectrum(0).setDetectorIDs({3, 4});
+    const auto &constWs = static_cast<const EventWorkspace &>(*ws);
+    const auto x = constWs.getSpectrum(0).sharedX();
+    auto clone = ws->clone();
+    const auto &constClone = *clone;
+    const auto *shared = &constClone.getSpectrum(0);
+    const size_t events = shared->getNumberEvents();
+    TS_ASSERT(events > 0);
+
+    ws->clearEventList(0);
+    const auto &cleared = constWs.getSpectrum(0);
+    TS_ASSERT_DIFFERS(&cleared, shared);
+    TS_ASSERT_EQUALS(cleared.getNumberEvents(), 0);
+    TS_ASSERT_EQUALS(cleared.getSpectrumNo(), 7);
+    TS_ASSERT_EQUALS(cleared.getDetectorIDs(), std::set<detid_t>({3, 4}));
+    TS_ASSERT_EQUALS(cleared.sharedX(), x);
+    TS_ASSERT_EQUALS(ws->y(0)[0], 0.);
+    // The clone keeps the events
+    TS_ASSERT_EQUALS(&constClone.getSpectrum(0), shared);
+    TS_ASSERT_EQUALS(shared->getNumberEvents(), events);
+    TS_ASSERT_THROWS(ws->clearEventList(2), const std::range_error &);
+  }
+
   void test_swapping_spectrum_numbers_does_not_break_MRU() {
     int numEvents = 2;
     int numHistograms = 2;
@@ -828,6 +855,76 @@ public:
     TS_ASSERT_DIFFERS(&(ws->y(0)), &yOld1);
   }
 
+  void test_clone_shares_event_lists_until_they_are_modified() {
+    auto ws = WorkspaceCreationHelper::createRandomEventWorkspace(2, 2);
+    const size_t events = ws->getSpectrum(0).getNumberEvents();
+    auto clone = ws->clone();
+    const auto &constClone = *clone;
+    TS_ASSERT_EQUALS(&constClone.getSpectrum(0),
+                     &static_cast<const EventWorkspace &>(*ws).getSpectrum(0));
+
+    clone->getSpectrum(0).addEventQuickly(TofEvent(0.5, 0));
+    TS_ASSERT_DIFFERS(&constClone.getSpectrum(0),
+                      &static_cast<const EventWorkspace &>(*ws).getSpectrum(0));
+    TS_ASSERT_EQUALS(clone->getSpectrum(0).getNumberEvents(), events + 1);
+    TS_ASSERT_EQUALS(ws->getSpectrum(0).getNumberEvents(), events);
+    // The other spectrum is still shared
+    TS_ASSERT_EQUALS(&constClone.getSpectrum(1),
+                     &static_cast<const EventWorkspace &>(*ws).getSpectrum(1));
+    // The histograms are not mixed up between the MRUs
+    TS_ASSERT_EQUALS(clone->y(0)[0], ws->y(0)[0] + 1.);
+
+    ws.reset();
+    TS_ASSERT_EQUALS(clone->getSpectrum(1).getNumberEvents(), events);
+  }
+
+  void test_clone_has_its_own_MRU() {
+    auto ws = WorkspaceCreationHelper::createRandomEventWorkspace(2, 2);
+    ws->y(0);
+    ws->y(1);
+    TS_ASSERT_EQUALS(ws->MRUSize(), 2);
+    auto clone = ws->clone();
+    TS_ASSERT_EQUALS(clone->MRUSize(), 0);
+
+    // Clearing the MRU of the clone leaves the original's alone
+    clone->y(1);
+    clone->clearMRU();
+    TS_ASSERT_EQUALS(ws->MRUSize(), 2);
+
+    // A modified list is cached in the MRU of the clone
+    clone->getSpectrum(0).addEventQuickly(TofEvent(0.5, 0));
+    TS_ASSERT_EQUALS(clone->y(0)[0], ws->y(0)[0] + 1.);
+    TS_ASSERT_EQUALS(clone->MRUSize(), 1);
+
+    // Lists still shared can make histograms once the original is gone
+    const auto y1 = ws->y(1).rawData();
+    ws.reset();
+    TS_ASSERT_EQUALS(clone->y(1).rawData(), y1);
+  }
+
+  void test_copy_on_write_while_the_shared_lists_are_sorted() {
+    auto ws = WorkspaceCreationHelper::createRandomEventWorkspace(5000, 20);
+    const size_t events = ws->getSpectrum(0).getNumberEvents();
+    auto clone = ws->clone();
+    const EventWorkspace &constWS = *ws;
+
+    // Sort the shared lists through the original while the clone copies them
+    std::thread sorter([&constWS]() { constWS.sortAll(TOF_SORT, nullptr); });
+    for (size_t i = 0; i < clone->getNumberHistograms(); ++i)
+      clone->getSpectrum(i).getNumberEvents();
+    sorter.join();
+
+    for (size_t i = 0; i < clone->getNumberHistograms(); ++i) {
+      const auto &list = clone->getSpectrum(i);
+      TS_ASSERT_EQUALS(list.getNumberEvents(), events);
+      // A copy made after the sort carries the sorted order with it
+      if (list.getSortType() == TOF_SORT) {
+        const auto &copied = list.getEvents();
+        TS_ASSERT(std::is_sorted(copied.cbegin(), copied.cend()));
+      }
+    }
+  }
+
   void test_deleting_spectra_removes_them_from_MRU() {
     auto ws = WorkspaceCreationHelper::createRandomEventWorkspace(2, 1);
     auto y = ws->sharedY(0);
@@ -51,6 +51,8 @@ private:
   /// Shapes for each component
   boost::shared_ptr<std::vector<boost::shared_ptr<const Geometry::IObject>>>
       m_shapes;
+  /// The number of changes made through this object
+  size_t m_changeCount{0};
 
   BoundingBox componentBoundingBox(const size_t index,
                                    const BoundingBox *reference) const;
@@ -141,6 +143,9 @@ public:
                                        Types::Core::DateAndTime> &interval);
   size_t scanCount() const;
   void merge(const ComponentInfo &other);
+  /// The number of changes made through this object, for caches of values
+  /// derived from it to tell whether they are out of date
+  size_t changeCount() const { return m_changeCount; }
 
   ComponentInfoIterator<ComponentInfo> begin();
   ComponentInfoIterator<ComponentInfo> end();
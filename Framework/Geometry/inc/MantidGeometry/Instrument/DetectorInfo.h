@@ -108,6 +108,10 @@ public:
       std::pair<Types::Core::DateAndTime, Types::Core::DateAndTime>>
   scanIntervals() const;
 
+  /// The number of changes made through this object, for caches of values
+  /// derived from it to tell whether they are out of date
+  size_t changeCount() const { return m_changeCount; }
+
   friend class API::SpectrumInfo;
   friend class Instrument;
 
@@ -131,6 +135,7 @@ private:
   mutable std::vector<boost::shared_ptr<const Geometry::IDetector>>
       m_lastDetector;
   mutable std::vector<size_t> m_lastIndex;
+  size_t m_changeCount{0};
 };
 
 using DetectorInfoIt = DetectorInfoIterator<DetectorInfo>;
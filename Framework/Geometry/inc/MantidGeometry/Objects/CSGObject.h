@@ -12,6 +12,7 @@
 //----------------------------------------------------------------------
 #include "MantidGeometry/DllConfig.h"
 #include "MantidGeometry/Objects/BoundingBox.h"
+#include "MantidGeometry/Objects/CompiledRule.h"
 #include "MantidGeometry/Objects/IObject.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidGeometry/Rendering/ShapeInfo.h"
@@ -33,6 +34,7 @@ class V3D;
 namespace Geometry {
 class CompGrp;
 class GeometryHandler;
+class LineIntersectVisit;
 class Rule;
 class Surface;
 class Track;
@@ -130,6 +132,7 @@ public:
 
   // INTERSECTION
   int interceptSurface(Geometry::Track &) const override;
+  int interceptSurfaces(std::vector<Geometry::Track> &tracks) const;
 
   // Solid angle - uses triangleSolidAngle unless many (>30000) triangles
   double solidAngle(const Kernel::V3D &observer) const override;
@@ -196,6 +199,7 @@ private:
                int &compUnit) const;
   std::unique_ptr<CompGrp> procComp(std::unique_ptr<Rule>) const;
   int checkSurfaceValid(const Kernel::V3D &, const Kernel::V3D &) const;
+  void addIntersections(const LineIntersectVisit &LI, Track &UT) const;
 
   /// Calculate bounding box using Rule system
   void calcBoundingBoxByRule();
@@ -231,6 +235,8 @@ private:
                                     const size_t seed) const;
   /// Top rule [ Geometric scope of object]
   std::unique_ptr<Rule> TopRule;
+  /// TopRule flattened for quick tests of points
+  CompiledRule m_compiledRule;
   /// Object's bounding box
   BoundingBox m_boundingBox;
   // -- DEPRECATED --
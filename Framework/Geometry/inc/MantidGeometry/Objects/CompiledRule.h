@@ -0,0 +1,74 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_GEOMETRY_COMPILEDRULE_H_
+#define MANTID_GEOMETRY_COMPILEDRULE_H_
+
+#include "MantidGeometry/DllConfig.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+class V3D;
+}
+namespace Geometry {
+class Rule;
+class Surface;
+
+/** CompiledRule is a rule tree flattened into a program that tells whether a
+  point is inside an object.
+
+  Each instruction tests the side of the point to one surface and names the
+  instruction to go to next when the test passes and when it fails, or the
+  answer itself. An intersection goes on to its second rule only when the
+  first passes and a union only when it fails, so the surfaces are tested in
+  the same order as by the tree and as few of them as by the tree, but
+  without a virtual call per rule or any recursion.
+
+  Trees of intersections, unions, complements of groups, constant values and
+  surfaces are compiled. A tree that holds a complement of another object is
+  left uncompiled, and the object evaluates its tree instead.
+*/
+class MANTID_GEOMETRY_DLL CompiledRule {
+public:
+  /// An empty, uncompiled rule
+  CompiledRule() = default;
+  explicit CompiledRule(const Rule &rule);
+
+  /// Whether the rule could be compiled
+  bool isCompiled() const { return m_compiled; }
+  /// Whether the point is inside the object or on its surface
+  bool isValid(const Kernel::V3D &point) const;
+  /// The number of instructions of the program
+  size_t size() const { return m_program.size(); }
+
+private:
+  struct Instruction {
+    const Surface *surface;
+    /// The side of the surface that passes the test, +1 or -1
+    int sign;
+    /// The next instruction when the point is on that side or on the surface
+    uint32_t onValid;
+    /// The next instruction otherwise
+    uint32_t onInvalid;
+  };
+
+  bool compile(const Rule &rule, uint32_t onValid, uint32_t onInvalid,
+               uint32_t &entry);
+
+  /// The program, the instructions following the one they jump to
+  std::vector<Instruction> m_program;
+  /// The first instruction, or the answer for a program without one
+  uint32_t m_entry = 0;
+  bool m_compiled = false;
+};
+
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_COMPILEDRULE_H_ */
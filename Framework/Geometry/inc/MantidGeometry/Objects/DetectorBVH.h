@@ -0,0 +1,77 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_GEOMETRY_DETECTORBVH_H_
+#define MANTID_GEOMETRY_DETECTORBVH_H_
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidGeometry/Objects/MeshBVH.h"
+#include "MantidKernel/Quat.h"
+#include "MantidKernel/V3D.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+class ComponentInfo;
+class DetectorInfo;
+class IObject;
+
+/** DetectorBVH is a bounding volume hierarchy over the shapes of all the
+  detectors of an instrument, monitors excluded.
+
+  It is built from the flat ComponentInfo and DetectorInfo of the instrument,
+  taking the position, rotation, scale factor and shape of each detector once,
+  so that finding the detector a ray hits tests the ray against the shapes of
+  the few detectors whose boxes it passes through rather than walking the
+  component tree. A hierarchy is immutable once built and can be used from
+  several threads at once. The shapes belong to the instrument, which has to
+  outlive the hierarchy.
+*/
+class MANTID_GEOMETRY_DLL DetectorBVH {
+public:
+  DetectorBVH(const ComponentInfo &componentInfo,
+              const DetectorInfo &detectorInfo);
+
+  /// The index returned for a ray that hits no detector
+  static const size_t NO_DETECTOR;
+
+  /// The index of the first detector hit by the ray from start along the unit
+  /// vector direction, or NO_DETECTOR
+  size_t firstDetectorHit(const Kernel::V3D &start,
+                          const Kernel::V3D &direction) const;
+  /// The number of detectors in the hierarchy
+  size_t numberOfDetectors() const { return m_detectors.size(); }
+
+private:
+  struct Detector {
+    const IObject *shape;
+    Kernel::V3D position;
+    Kernel::Quat rotation;
+    Kernel::Quat inverseRotation;
+    Kernel::V3D scaleFactor;
+    /// The index in DetectorInfo
+    size_t index;
+  };
+
+  static std::vector<double>
+  collectDetectors(const ComponentInfo &componentInfo,
+                   const DetectorInfo &detectorInfo,
+                   std::vector<Detector> &detectors);
+  bool entryDistance(const Detector &detector, const Kernel::V3D &start,
+                     const Kernel::V3D &direction, double &distance) const;
+
+  /// The detectors with a valid shape, in the order of their boxes. Declared
+  /// before the hierarchy, which is built as they are collected.
+  std::vector<Detector> m_detectors;
+  /// The hierarchy over the boxes of the detectors
+  MeshBVH m_hierarchy;
+};
+
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_DETECTORBVH_H_ */
@@ -14,13 +14,16 @@
 #include <boost/unordered_map.hpp>
 #include <deque>
 #include <list>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace Mantid {
 namespace Kernel {
 class V3D;
 }
 namespace Geometry {
+class DetectorBVH;
 class IComponent;
 struct Link;
 class Track;
@@ -32,6 +35,11 @@ This class is responsible for tracking rays and accumulating a list of objects
 that are
 intersected along the way.
 
+The traceDetector methods find only the first detector, not a monitor, that
+each ray from the sample hits. They search a bounding volume hierarchy over all
+the detectors, built when first needed, instead of the component tree, keep no
+results in the object and can be called from several threads at once.
+
 @author Martyn Gigg, Tessella plc
 @date 22/10/2010
 */
@@ -39,6 +47,7 @@ class MANTID_GEOMETRY_DLL InstrumentRayTracer {
 public:
   /// Constructor taking an instrument
   InstrumentRayTracer(Instrument_const_sptr instrument);
+  ~InstrumentRayTracer();
   /// Trace a given track from the instrument source in the given direction
   /// and compile a list of results that this track intersects.
   void trace(const Kernel::V3D &dir) const;
@@ -49,11 +58,19 @@ public:
 
   IDetector_const_sptr getDetectorResult() const;
 
+  /// Find the index of the first detector hit by a ray from the sample
+  size_t traceDetectorFromSample(const Kernel::V3D &dir) const;
+  /// Find the index of the first detector hit by each ray from the sample
+  std::vector<size_t>
+  traceDetectorsFromSample(const std::vector<Kernel::V3D> &dirs) const;
+
 private:
   /// Default constructor
   InstrumentRayTracer();
   /// Fire the given track at the instrument
   void fireRay(Track &testRay) const;
+  /// The hierarchy over the detectors, built on first use
+  const DetectorBVH &detectorBVH() const;
 
   /// Pointer to the instrument
   Instrument_const_sptr m_instrument;
@@ -64,6 +81,10 @@ private:
   mutable boost::unordered_map<IComponent *, BoundingBox> m_boxCache;
   /// Mutex to lock box cache
   mutable std::mutex m_mutex;
+  /// Hierarchy over the detectors for the traceDetector methods
+  mutable std::unique_ptr<const DetectorBVH> m_detectorBVH;
+  /// Flag to build the hierarchy once
+  mutable std::once_flag m_detectorBVHFlag;
 };
 } // namespace Geometry
 } // namespace Mantid
@@ -0,0 +1,134 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_GEOMETRY_MESHBVH_H_
+#define MANTID_GEOMETRY_MESHBVH_H_
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/V3D.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+
+/** MeshBVH is a bounding volume hierarchy over the triangles of a mesh, or
+  over any other items given by their bounding boxes.
+
+  The items are split recursively at the median of the centroids of their
+  boxes along the longest axis of the centroids' bounds until at most a few
+  items are left in each leaf. The nodes are stored in depth first order in a
+  single array, the second child of a node being the only one that needs an
+  index. A ray is tested against the items of the leaves whose boxes it
+  passes through rather than against every item.
+
+  The boxes are padded slightly so that no triangle the ray meets at or just
+  behind its start, within the tolerance of the ray-triangle test, is missed.
+  A hierarchy is immutable once built and can be shared between threads.
+*/
+class MANTID_GEOMETRY_DLL MeshBVH {
+public:
+  MeshBVH(const std::vector<uint32_t> &triangles,
+          const std::vector<Kernel::V3D> &vertices);
+  explicit MeshBVH(const std::vector<double> &bounds);
+
+  /// Call visit(index) for the index of each triangle, or item, that the ray
+  /// from start along direction may intersect
+  template <typename Visitor>
+  void forEachCandidate(const Kernel::V3D &start, const Kernel::V3D &direction,
+                        Visitor &&visit) const;
+
+  /// The number of nodes in the hierarchy
+  size_t numberOfNodes() const { return m_nodes.size(); }
+  /// The number of levels of the hierarchy
+  size_t depth() const { return m_depth; }
+
+private:
+  struct Node {
+    double lower[3];
+    double upper[3];
+    /// For a leaf the position of its first item in m_order, otherwise the
+    /// index of the second child
+    uint32_t first;
+    /// The number of items of a leaf, 0 for an inner node
+    uint32_t count;
+  };
+
+  uint32_t build(const std::vector<double> &bounds,
+                 const std::vector<double> &centroids, size_t begin,
+                 size_t end, size_t depth);
+  static bool hits(const Node &node, const double *start,
+                   const double *direction, const double *inverse);
+
+  /// The nodes in depth first order, the root first
+  std::vector<Node> m_nodes;
+  /// The item indices in the order the leaves refer to them
+  std::vector<uint32_t> m_order;
+  /// The padding of the boxes
+  double m_padding;
+  /// The number of levels
+  size_t m_depth;
+};
+
+template <typename Visitor>
+void MeshBVH::forEachCandidate(const Kernel::V3D &start,
+                               const Kernel::V3D &direction,
+                               Visitor &&visit) const {
+  if (m_nodes.empty())
+    return;
+  const double origin[3] = {start.X(), start.Y(), start.Z()};
+  const double dir[3] = {direction.X(), direction.Y(), direction.Z()};
+  const double inverse[3] = {1.0 / dir[0], 1.0 / dir[1], 1.0 / dir[2]};
+  // The depth of a median split tree of 2^32 triangles is well below this
+  uint32_t stack[64];
+  size_t top = 0;
+  stack[top++] = 0;
+  while (top > 0) {
+    const uint32_t index = stack[--top];
+    const Node &node = m_nodes[index];
+    if (!hits(node, origin, dir, inverse))
+      continue;
+    if (node.count > 0) {
+      for (uint32_t i = node.first; i < node.first + node.count; ++i)
+        visit(static_cast<size_t>(m_order[i]));
+    } else {
+      stack[top++] = node.first;
+      stack[top++] = index + 1;
+    }
+  }
+}
+
+/// Whether the ray from start along direction passes through the box of node
+inline bool MeshBVH::hits(const Node &node, const double *start,
+                          const double *direction, const double *inverse) {
+  double tmin = 0.0;
+  double tmax = std::numeric_limits<double>::max();
+  for (size_t axis = 0; axis < 3; ++axis) {
+    if (direction[axis] == 0.0) {
+      if (start[axis] < node.lower[axis] || start[axis] > node.upper[axis])
+        return false;
+      continue;
+    }
+    double t1 = (node.lower[axis] - start[axis]) * inverse[axis];
+    double t2 = (node.upper[axis] - start[axis]) * inverse[axis];
+    if (t1 > t2)
+      std::swap(t1, t2);
+    tmin = std::max(tmin, t1);
+    tmax = std::min(tmax, t2);
+    if (tmin > tmax)
+      return false;
+  }
+  return true;
+}
+
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_MESHBVH_H_ */
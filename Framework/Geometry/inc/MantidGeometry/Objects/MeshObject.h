@@ -18,6 +18,7 @@
 #include "MantidKernel/Material.h"
 #include <map>
 #include <memory>
+#include <mutex>
 
 namespace Mantid {
 //----------------------------------------------------------------------
@@ -31,6 +32,7 @@ class V3D;
 namespace Geometry {
 class CompGrp;
 class GeometryHandler;
+class MeshBVH;
 class Track;
 class vtkGeometryCacheReader;
 class vtkGeometryCacheWriter;
@@ -64,12 +66,8 @@ public:
   /// Destructor
   virtual ~MeshObject() = default;
   /// Clone
-  IObject *clone() const override {
-    return new MeshObject(m_triangles, m_vertices, m_material);
-  }
-  IObject *cloneWithMaterial(const Kernel::Material &material) const override {
-    return new MeshObject(m_triangles, m_vertices, material);
-  }
+  IObject *clone() const override;
+  IObject *cloneWithMaterial(const Kernel::Material &material) const override;
 
   const std::string &id() const override { return m_id; }
 
@@ -152,9 +150,15 @@ private:
                    Kernel::V3D &v3) const;
   /// Search object for valid point
   bool searchForObject(Kernel::V3D &point) const;
+  /// Get the bounding volume hierarchy of the triangles
+  const MeshBVH &bvh() const;
 
   /// Cache for object's bounding box
   mutable BoundingBox m_boundingBox;
+  /// Bounding volume hierarchy, built when first needed
+  mutable std::shared_ptr<const MeshBVH> m_bvh;
+  /// Serializes building the bounding volume hierarchy
+  mutable std::mutex m_bvhMutex;
 
   /// Tolerence distance
   const double M_TOLERANCE = 0.000001;
@@ -9,6 +9,7 @@
 
 #include <boost/shared_ptr.hpp>
 #include <map>
+#include <string>
 
 class TopoDS_Shape;
 
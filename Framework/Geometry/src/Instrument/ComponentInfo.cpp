@@ -192,11 +192,13 @@ ComponentInfo::relativeRotation(const size_t componentIndex) const {
 void ComponentInfo::setPosition(const std::pair<size_t, size_t> index,
                                 const Kernel::V3D &newPosition) {
   m_componentInfo->setPosition(index, Kernel::toVector3d(newPosition));
+  ++m_changeCount;
 }
 
 void ComponentInfo::setRotation(const std::pair<size_t, size_t> index,
                                 const Kernel::Quat &newRotation) {
   m_componentInfo->setRotation(index, Kernel::toQuaterniond(newRotation));
+  ++m_changeCount;
 }
 
 size_t ComponentInfo::parent(const size_t componentIndex) const {
@@ -234,12 +236,14 @@ size_t ComponentInfo::root() const { return m_componentInfo->root(); }
 void ComponentInfo::setPosition(const size_t componentIndex,
                                 const Kernel::V3D &newPosition) {
   m_componentInfo->setPosition(componentIndex, Kernel::toVector3d(newPosition));
+  ++m_changeCount;
 }
 
 void ComponentInfo::setRotation(const size_t componentIndex,
                                 const Kernel::Quat &newRotation) {
   m_componentInfo->setRotation(componentIndex,
                                Kernel::toQuaterniond(newRotation));
+  ++m_changeCount;
 }
 
 const IObject &ComponentInfo::shape(const size_t componentIndex) const {
@@ -258,6 +262,7 @@ void ComponentInfo::setScaleFactor(const size_t componentIndex,
                                    const Kernel::V3D &scaleFactor) {
   m_componentInfo->setScaleFactor(componentIndex,
                                   Kernel::toVector3d(scaleFactor));
+  ++m_changeCount;
 }
 
 double ComponentInfo::solidAngle(const size_t componentIndex,
@@ -432,12 +437,14 @@ void ComponentInfo::setScanInterval(
         &interval) {
   m_componentInfo->setScanInterval(
       {interval.first.totalNanoseconds(), interval.second.totalNanoseconds()});
+  ++m_changeCount;
 }
 
 size_t ComponentInfo::scanCount() const { return m_componentInfo->scanCount(); }
 
 void ComponentInfo::merge(const ComponentInfo &other) {
   m_componentInfo->merge(*other.m_componentInfo);
+  ++m_changeCount;
 }
 
 ComponentInfoIt ComponentInfo::begin() {
@@ -66,6 +66,7 @@ DetectorInfo &DetectorInfo::operator=(const DetectorInfo &rhs) {
   // Do NOT assign anything in the "wrapping" part of DetectorInfo. We simply
   // assign the underlying Beamline::DetectorInfo.
   *m_detectorInfo = *rhs.m_detectorInfo;
+  ++m_changeCount;
   return *this;
 }
 
@@ -254,12 +255,14 @@ DetectorInfo::rotation(const std::pair<size_t, size_t> &index) const {
 /// Set the mask flag of the detector with given index. Not thread safe.
 void DetectorInfo::setMasked(const size_t index, bool masked) {
   m_detectorInfo->setMasked(index, masked);
+  ++m_changeCount;
 }
 
 /// Set the mask flag of the detector with given index. Not thread safe.
 void DetectorInfo::setMasked(const std::pair<size_t, size_t> &index,
                              bool masked) {
   m_detectorInfo->setMasked(index, masked);
+  ++m_changeCount;
 }
 
 /** Sets all mask flags to false (unmasked). Not thread safe.
@@ -269,30 +272,35 @@ void DetectorInfo::setMasked(const std::pair<size_t, size_t> &index,
 void DetectorInfo::clearMaskFlags() {
   for (size_t i = 0; i < size(); ++i)
     m_detectorInfo->setMasked(i, false);
+  ++m_changeCount;
 }
 
 /// Set the absolute position of the detector with given index. Not thread safe.
 void DetectorInfo::setPosition(const size_t index,
                                const Kernel::V3D &position) {
   m_detectorInfo->setPosition(index, Kernel::toVector3d(position));
+  ++m_changeCount;
 }
 
 /// Set the absolute position of the detector with given index. Not thread safe.
 void DetectorInfo::setPosition(const std::pair<size_t, size_t> &index,
                                const Kernel::V3D &position) {
   m_detectorInfo->setPosition(index, Kernel::toVector3d(position));
+  ++m_changeCount;
 }
 
 /// Set the absolute rotation of the detector with given index. Not thread safe.
 void DetectorInfo::setRotation(const size_t index,
                                const Kernel::Quat &rotation) {
   m_detectorInfo->setRotation(index, Kernel::toQuaterniond(rotation));
+  ++m_changeCount;
 }
 
 /// Set the absolute rotation of the detector with given index. Not thread safe.
 void DetectorInfo::setRotation(const std::pair<size_t, size_t> &index,
                                const Kernel::Quat &rotation) {
   m_detectorInfo->setRotation(index, Kernel::toQuaterniond(rotation));
+  ++m_changeCount;
 }
 
 /// Return a const reference to the detector with given index.
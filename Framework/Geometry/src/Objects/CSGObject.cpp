@@ -83,6 +83,7 @@ CSGObject::CSGObject(const CSGObject &A) : CSGObject() { *this = A; }
 CSGObject &CSGObject::operator=(const CSGObject &A) {
   if (this != &A) {
     TopRule = (A.TopRule) ? A.TopRule->clone() : nullptr;
+    m_compiledRule = CompiledRule();
     AABBxMax = A.AABBxMax;
     AABByMax = A.AABByMax;
     AABBzMax = A.AABBzMax;
@@ -474,6 +475,8 @@ int CSGObject::checkSurfaceValid(const Kernel::V3D &C,
 bool CSGObject::isValid(const Kernel::V3D &point) const {
   if (!TopRule)
     return false;
+  if (m_compiledRule.isCompiled())
+    return m_compiledRule.isValid(point);
   return TopRule->isValid(point);
 }
 
@@ -529,6 +532,7 @@ int CSGObject::createSurfaceList(const int outFlag) {
       logger.debug() << (*vc)->getName() << '\n';
     }
   }
+  m_compiledRule = CompiledRule(*TopRule);
   return 1;
 }
 
@@ -622,6 +626,7 @@ void CSGObject::print() const {
 void CSGObject::makeComplement() {
   std::unique_ptr<Rule> NCG = procComp(std::move(TopRule));
   TopRule = std::move(NCG);
+  m_compiledRule = CompiledRule();
 }
 
 /**
@@ -678,6 +683,7 @@ void CSGObject::write(std::ostream &OX) const {
  */
 int CSGObject::procString(const std::string &Line) {
   TopRule = nullptr;
+  m_compiledRule = CompiledRule();
   std::map<int, std::unique_ptr<Rule>> RuleList; // List for the rules
   int Ridx = 0; // Current index (not necessary size of RuleList
   // SURFACE REPLACEMENT
@@ -768,6 +774,47 @@ int CSGObject::interceptSurface(Geometry::Track &UT) const {
   for (vc = m_SurList.begin(); vc != m_SurList.end(); ++vc) {
     (*vc)->acceptVisitor(LI);
   }
+  addIntersections(LI, UT);
+  // Return number of track segments added
+  return (UT.count() - originalCount);
+}
+
+/**
+ * Given a set of tracks, fill each track with its valid sections. Every
+ * track is intersected with one surface before moving on to the next, so
+ * the surfaces are visited once for the whole set rather than once per track.
+ * @param tracks :: Initial tracks
+ * @return Number of segments added to all the tracks
+ */
+int CSGObject::interceptSurfaces(std::vector<Geometry::Track> &tracks) const {
+  int originalCount(0);
+  std::vector<LineIntersectVisit> intersections;
+  intersections.reserve(tracks.size());
+  for (const auto &track : tracks) {
+    originalCount += track.count();
+    intersections.emplace_back(track.startPoint(), track.direction());
+  }
+  for (const auto surface : m_SurList) {
+    for (auto &LI : intersections) {
+      surface->acceptVisitor(LI);
+    }
+  }
+  int count(0);
+  for (size_t i = 0; i < tracks.size(); ++i) {
+    addIntersections(intersections[i], tracks[i]);
+    count += tracks[i].count();
+  }
+  return count - originalCount;
+}
+
+/**
+ * Add the valid forward going intersections of a line with the surfaces to a
+ * track and build its links
+ * @param LI :: The line of the track after visiting all the surfaces
+ * @param UT :: The track
+ */
+void CSGObject::addIntersections(const LineIntersectVisit &LI,
+                                 Geometry::Track &UT) const {
   const auto &IPoints(LI.getPoints());
   const auto &dPoints(LI.getDistance());
 
@@ -783,8 +830,6 @@ int CSGObject::interceptSurface(Geometry::Track &UT) const {
     }
   }
   UT.buildLink();
-  // Return number of track segments added
-  return (UT.count() - originalCount);
 }
 
 /**
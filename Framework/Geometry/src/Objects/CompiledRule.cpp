@@ -0,0 +1,122 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Objects/CompiledRule.h"
+#include "MantidGeometry/Objects/Rules.h"
+#include "MantidGeometry/Surfaces/Surface.h"
+#include "MantidKernel/V3D.h"
+
+#include <limits>
+
+namespace Mantid {
+namespace Geometry {
+
+namespace {
+/// The target of a jump that ends the program with the point inside
+const uint32_t VALID = std::numeric_limits<uint32_t>::max();
+/// The target of a jump that ends the program with the point outside
+const uint32_t INVALID = VALID - 1;
+} // namespace
+
+/**
+ * Compile a rule tree
+ * @param rule :: The top rule of the tree
+ */
+CompiledRule::CompiledRule(const Rule &rule) {
+  m_compiled = compile(rule, VALID, INVALID, m_entry);
+  if (!m_compiled)
+    m_program.clear();
+}
+
+/**
+ * Append the instructions of a rule and of the rules below it. The rules
+ * are compiled last to first so that each knows where to jump once done.
+ * @param rule :: The rule
+ * @param onValid :: Where to go when the point is valid for the rule
+ * @param onInvalid :: Where to go when the point is not valid for the rule
+ * @param entry :: Set to the first instruction of the rule
+ * @return Whether the rule could be compiled
+ */
+bool CompiledRule::compile(const Rule &rule, uint32_t onValid,
+                           uint32_t onInvalid, uint32_t &entry) {
+  const Rule *first = rule.leaf(0);
+  const Rule *second = rule.leaf(1);
+  if (dynamic_cast<const Intersection *>(&rule)) {
+    if (!first || !second) {
+      entry = onInvalid;
+      return true;
+    }
+    uint32_t secondEntry(0);
+    return compile(*second, onValid, onInvalid, secondEntry) &&
+           compile(*first, secondEntry, onInvalid, entry);
+  }
+  if (dynamic_cast<const Union *>(&rule)) {
+    if (first && second) {
+      uint32_t secondEntry(0);
+      return compile(*second, onValid, onInvalid, secondEntry) &&
+             compile(*first, onValid, secondEntry, entry);
+    }
+    if (first || second)
+      return compile(first ? *first : *second, onValid, onInvalid, entry);
+    entry = onInvalid;
+    return true;
+  }
+  if (dynamic_cast<const CompGrp *>(&rule)) {
+    if (!first) {
+      entry = onValid;
+      return true;
+    }
+    return compile(*first, onInvalid, onValid, entry);
+  }
+  if (const auto *surfPoint = dynamic_cast<const SurfPoint *>(&rule)) {
+    if (!surfPoint->getKey()) {
+      entry = onInvalid;
+      return true;
+    }
+    entry = static_cast<uint32_t>(m_program.size());
+    if (entry >= INVALID)
+      return false;
+    const int sign = surfPoint->getSign() >= 0 ? 1 : -1;
+    m_program.push_back({surfPoint->getKey(), sign, onValid, onInvalid});
+    return true;
+  }
+  if (dynamic_cast<const BoolValue *>(&rule)) {
+    // The value of a constant does not depend on the point
+    entry = rule.isValid(Kernel::V3D()) ? onValid : onInvalid;
+    return true;
+  }
+  // A complement of another object
+  return false;
+}
+
+/**
+ * Determines whether a point is within the object or on its surface
+ * @param point :: The point to test
+ * @return true if the point is valid
+ */
+bool CompiledRule::isValid(const Kernel::V3D &point) const {
+  const Instruction *program = m_program.data();
+  const auto size = static_cast<uint32_t>(m_program.size());
+  uint32_t next = m_entry;
+  while (next < size) {
+    const Instruction &instruction = program[next];
+    // Kept as a branch rather than a select, so that the next test can start
+    // before the side to this surface is known
+    if (instruction.surface->side(point) * instruction.sign >= 0) {
+      next = instruction.onValid;
+      if (next >= size)
+        break;
+    } else {
+      next = instruction.onInvalid;
+      if (next >= size)
+        break;
+    }
+  }
+  return next == VALID;
+}
+
+} // namespace Geometry
+} // namespace Mantid
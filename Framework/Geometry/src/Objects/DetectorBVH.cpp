@@ -0,0 +1,125 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Objects/DetectorBVH.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Objects/BoundingBox.h"
+#include "MantidGeometry/Objects/IObject.h"
+#include "MantidGeometry/Objects/Track.h"
+
+#include <limits>
+#include <stdexcept>
+
+namespace Mantid {
+namespace Geometry {
+
+using Kernel::V3D;
+
+const size_t DetectorBVH::NO_DETECTOR = std::numeric_limits<size_t>::max();
+
+/**
+ * Build the hierarchy over the detectors
+ * @param componentInfo :: The components of the instrument
+ * @param detectorInfo :: The detectors of the instrument
+ */
+DetectorBVH::DetectorBVH(const ComponentInfo &componentInfo,
+                         const DetectorInfo &detectorInfo)
+    : m_hierarchy(collectDetectors(componentInfo, detectorInfo,
+                                   m_detectors)) {}
+
+/**
+ * Take the geometry of each detector that can be hit
+ * @param componentInfo :: The components of the instrument
+ * @param detectorInfo :: The detectors of the instrument
+ * @param detectors :: Filled with the detectors
+ * @return The bounds, lower x, y, z then upper x, y, z, of each detector
+ */
+std::vector<double>
+DetectorBVH::collectDetectors(const ComponentInfo &componentInfo,
+                              const DetectorInfo &detectorInfo,
+                              std::vector<Detector> &detectors) {
+  std::vector<double> bounds;
+  for (size_t i = 0; i < detectorInfo.size(); ++i) {
+    if (detectorInfo.isMonitor(i) || !componentInfo.hasValidShape(i))
+      continue;
+    // Also sets up any box the shape caches, before the shape is shared
+    // between threads
+    const BoundingBox box = componentInfo.boundingBox(i);
+    if (box.isNull())
+      continue;
+    bounds.insert(bounds.end(), {box.xMin(), box.yMin(), box.zMin(),
+                                 box.xMax(), box.yMax(), box.zMax()});
+    Kernel::Quat inverseRotation = componentInfo.rotation(i);
+    inverseRotation.inverse();
+    detectors.push_back({&componentInfo.shape(i), componentInfo.position(i),
+                         componentInfo.rotation(i), inverseRotation,
+                         componentInfo.scaleFactor(i), i});
+  }
+  return bounds;
+}
+
+/**
+ * Find the detector a ray hits first
+ * @param start :: The start of the ray
+ * @param direction :: The direction of the ray, a unit vector
+ * @return The index of the detector in DetectorInfo, or NO_DETECTOR
+ * @throw std::invalid_argument if the direction is not a unit vector
+ */
+size_t DetectorBVH::firstDetectorHit(const V3D &start,
+                                     const V3D &direction) const {
+  if (!direction.unitVector())
+    throw std::invalid_argument(
+        "DetectorBVH: the direction of a ray has to be a unit vector.");
+  size_t hit = NO_DETECTOR;
+  double nearest = std::numeric_limits<double>::max();
+  m_hierarchy.forEachCandidate(start, direction, [&](size_t i) {
+    const Detector &detector = m_detectors[i];
+    double distance(0.0);
+    if (!entryDistance(detector, start, direction, distance))
+      return;
+    // The lower index wins a tie, whatever order the candidates come in
+    if (distance < nearest || (distance == nearest && detector.index < hit)) {
+      nearest = distance;
+      hit = detector.index;
+    }
+  });
+  return hit;
+}
+
+/**
+ * Intersect a ray with the shape of a detector
+ * @param detector :: The detector
+ * @param start :: The start of the ray
+ * @param direction :: The direction of the ray, a unit vector
+ * @param distance :: Set to the distance from the start to where the ray
+ * enters the detector
+ * @return Whether the ray hits the detector
+ */
+bool DetectorBVH::entryDistance(const Detector &detector, const V3D &start,
+                                const V3D &direction, double &distance) const {
+  // Move the ray into the frame of the shape
+  V3D localStart = start - detector.position;
+  detector.inverseRotation.rotate(localStart);
+  localStart /= detector.scaleFactor;
+  V3D localDirection = direction;
+  detector.inverseRotation.rotate(localDirection);
+  localDirection /= detector.scaleFactor;
+  localDirection.normalize();
+
+  Track track(localStart, localDirection);
+  if (detector.shape->interceptSurface(track) == 0)
+    return false;
+  V3D entry = track.front().entryPoint;
+  entry *= detector.scaleFactor;
+  detector.rotation.rotate(entry);
+  entry += detector.position;
+  distance = entry.distance(start);
+  return true;
+}
+
+} // namespace Geometry
+} // namespace Mantid
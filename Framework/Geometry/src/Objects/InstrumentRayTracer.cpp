@@ -9,10 +9,16 @@
 //-------------------------------------------------------------
 #include "MantidGeometry/Objects/InstrumentRayTracer.h"
 #include "MantidGeometry/IComponent.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidGeometry/Instrument/InstrumentVisitor.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
+#include "MantidGeometry/Objects/DetectorBVH.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/V3D.h"
+#include "MantidKernel/make_unique.h"
 #include <deque>
 #include <iterator>
 
@@ -48,6 +54,9 @@ InstrumentRayTracer::InstrumentRayTracer(Instrument_const_sptr instrument)
   }
 }
 
+// Defined here where DetectorBVH is a complete type
+InstrumentRayTracer::~InstrumentRayTracer() = default;
+
 /**
  * Trace a given track from the instrument source in the given direction. For
  * performance reasons the
@@ -114,9 +123,81 @@ IDetector_const_sptr InstrumentRayTracer::getDetectorResult() const {
   return IDetector_const_sptr();
 }
 
+/**
+ * Find the first detector, that is not a monitor, hit by a ray from the
+ * sample position. Unlike trace, this keeps no results in the object and may
+ * be called from several threads at once.
+ * @param dir :: The direction of the ray, a unit vector
+ * @return The index of the detector in DetectorInfo, or
+ * DetectorBVH::NO_DETECTOR if the ray hits none
+ */
+size_t InstrumentRayTracer::traceDetectorFromSample(const V3D &dir) const {
+  return detectorBVH().firstDetectorHit(m_instrument->getSample()->getPos(),
+                                        dir);
+}
+
+/**
+ * Find the first detector, that is not a monitor, hit by each of many rays
+ * from the sample position. The rays are traced in parallel.
+ * @param dirs :: The directions of the rays, unit vectors
+ * @return The index of the detector in DetectorInfo hit by each ray, or
+ * DetectorBVH::NO_DETECTOR for a ray that hits none
+ * @throw std::invalid_argument if a direction is not a unit vector
+ */
+std::vector<size_t> InstrumentRayTracer::traceDetectorsFromSample(
+    const std::vector<V3D> &dirs) const {
+  const auto &bvh = detectorBVH();
+  const V3D samplePos = m_instrument->getSample()->getPos();
+  std::vector<size_t> detectors(dirs.size(), DetectorBVH::NO_DETECTOR);
+  // Check the directions first so that nothing throws within the loop
+  for (const auto &dir : dirs) {
+    if (!dir.unitVector())
+      throw std::invalid_argument("InstrumentRayTracer: the direction of a "
+                                  "ray has to be a unit vector.");
+  }
+  const auto numberOfRays = static_cast<int64_t>(dirs.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numberOfRays; ++i) {
+    detectors[i] = bvh.firstDetectorHit(samplePos, dirs[i]);
+  }
+  return detectors;
+}
+
 //-------------------------------------------------------------
 // Private member functions
 //-------------------------------------------------------------
+/**
+ * Build the hierarchy over the detectors the first time it is needed. The
+ * geometry is taken from the ComponentInfo of the instrument if it has one,
+ * otherwise from its component tree.
+ * @return The hierarchy
+ */
+const DetectorBVH &InstrumentRayTracer::detectorBVH() const {
+  std::call_once(m_detectorBVHFlag, [this]() {
+    if (m_instrument->isParametrized()) {
+      const auto &pmap = *m_instrument->getParameterMap();
+      if (pmap.hasComponentInfo(m_instrument->baseInstrument().get())) {
+        m_detectorBVH = Kernel::make_unique<DetectorBVH>(pmap.componentInfo(),
+                                                         pmap.detectorInfo());
+        return;
+      }
+    }
+    // The shapes are shared with the instrument so the beamline objects need
+    // not outlive the hierarchy
+    auto pmap = Kernel::make_unique<ParameterMap>();
+    auto base = m_instrument;
+    if (m_instrument->isParametrized()) {
+      pmap =
+          Kernel::make_unique<ParameterMap>(*m_instrument->getParameterMap());
+      base = m_instrument->baseInstrument();
+    }
+    const auto beamline = base->makeBeamline(*pmap);
+    m_detectorBVH =
+        Kernel::make_unique<DetectorBVH>(*beamline.first, *beamline.second);
+  });
+  return *m_detectorBVH;
+}
+
 /**
  * Fire the test ray at the instrument and perform a bread-first search of the
  * object tree to find the objects that were intersected.
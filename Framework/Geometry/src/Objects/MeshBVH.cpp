@@ -0,0 +1,160 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Objects/MeshBVH.h"
+
+#include <cmath>
+#include <numeric>
+
+namespace Mantid {
+namespace Geometry {
+
+namespace {
+/// The largest number of items in a leaf
+const size_t MAX_LEAF_SIZE = 4;
+/// The padding of the boxes relative to the size of the mesh. It exceeds the
+/// tolerance of the ray-triangle intersection, 1e-7 of an edge length.
+const double RELATIVE_PADDING = 1e-6;
+
+/// The bounds (lower x, y, z then upper x, y, z) of each triangle
+std::vector<double> triangleBounds(const std::vector<uint32_t> &triangles,
+                                   const std::vector<Kernel::V3D> &vertices) {
+  const size_t numberOfTriangles = triangles.size() / 3;
+  std::vector<double> bounds(6 * numberOfTriangles);
+  for (size_t i = 0; i < numberOfTriangles; ++i) {
+    double *lower = &bounds[6 * i];
+    double *upper = lower + 3;
+    std::fill(lower, lower + 3, std::numeric_limits<double>::max());
+    std::fill(upper, upper + 3, std::numeric_limits<double>::lowest());
+    for (size_t corner = 0; corner < 3; ++corner) {
+      const Kernel::V3D &vertex = vertices[triangles[3 * i + corner]];
+      for (size_t axis = 0; axis < 3; ++axis) {
+        lower[axis] = std::min(lower[axis], vertex[axis]);
+        upper[axis] = std::max(upper[axis], vertex[axis]);
+      }
+    }
+  }
+  return bounds;
+}
+} // namespace
+
+/**
+ * Build the hierarchy over the triangles of a mesh
+ * @param triangles :: The indices into vertices of the corners of each
+ * triangle, three per triangle
+ * @param vertices :: The vertices of the mesh
+ */
+MeshBVH::MeshBVH(const std::vector<uint32_t> &triangles,
+                 const std::vector<Kernel::V3D> &vertices)
+    : MeshBVH(triangleBounds(triangles, vertices)) {}
+
+/**
+ * Build the hierarchy over items given by their bounds
+ * @param bounds :: The lower x, y, z then the upper x, y, z of each item
+ */
+MeshBVH::MeshBVH(const std::vector<double> &bounds)
+    : m_padding(0.0), m_depth(0) {
+  const size_t numberOfItems = bounds.size() / 6;
+  if (numberOfItems == 0)
+    return;
+
+  // The centroid of each item's box
+  std::vector<double> centroids(3 * numberOfItems);
+  double meshLower[3], meshUpper[3];
+  std::fill(meshLower, meshLower + 3, std::numeric_limits<double>::max());
+  std::fill(meshUpper, meshUpper + 3, std::numeric_limits<double>::lowest());
+  for (size_t i = 0; i < numberOfItems; ++i) {
+    const double *lower = &bounds[6 * i];
+    const double *upper = lower + 3;
+    for (size_t axis = 0; axis < 3; ++axis) {
+      centroids[3 * i + axis] = 0.5 * (lower[axis] + upper[axis]);
+      meshLower[axis] = std::min(meshLower[axis], lower[axis]);
+      meshUpper[axis] = std::max(meshUpper[axis], upper[axis]);
+    }
+  }
+  double diagonal = 0.0;
+  for (size_t axis = 0; axis < 3; ++axis)
+    diagonal += (meshUpper[axis] - meshLower[axis]) *
+                (meshUpper[axis] - meshLower[axis]);
+  m_padding = RELATIVE_PADDING * std::sqrt(diagonal) +
+              std::numeric_limits<double>::min();
+
+  m_order.resize(numberOfItems);
+  std::iota(m_order.begin(), m_order.end(), 0);
+  // A median split tree has fewer than 2 * n / MAX_LEAF_SIZE nodes
+  m_nodes.reserve(2 * numberOfItems / MAX_LEAF_SIZE + 1);
+  build(bounds, centroids, 0, numberOfItems, 1);
+}
+
+/**
+ * Build the node over a range of m_order and, below it, its children
+ * @param bounds :: The bounds of each item
+ * @param centroids :: The centroid of each item
+ * @param begin :: The start of the range of m_order
+ * @param end :: The end of the range of m_order
+ * @param depth :: The level of the node, 1 for the root
+ * @return The index of the node
+ */
+uint32_t MeshBVH::build(const std::vector<double> &bounds,
+                        const std::vector<double> &centroids, size_t begin,
+                        size_t end, size_t depth) {
+  m_depth = std::max(m_depth, depth);
+  const auto index = static_cast<uint32_t>(m_nodes.size());
+  Node node;
+  std::fill(node.lower, node.lower + 3, std::numeric_limits<double>::max());
+  std::fill(node.upper, node.upper + 3, std::numeric_limits<double>::lowest());
+  double centroidLower[3], centroidUpper[3];
+  std::copy(node.lower, node.lower + 3, centroidLower);
+  std::copy(node.upper, node.upper + 3, centroidUpper);
+  for (size_t i = begin; i < end; ++i) {
+    const double *lower = &bounds[6 * m_order[i]];
+    const double *upper = lower + 3;
+    const double *centroid = &centroids[3 * m_order[i]];
+    for (size_t axis = 0; axis < 3; ++axis) {
+      node.lower[axis] = std::min(node.lower[axis], lower[axis]);
+      node.upper[axis] = std::max(node.upper[axis], upper[axis]);
+      centroidLower[axis] = std::min(centroidLower[axis], centroid[axis]);
+      centroidUpper[axis] = std::max(centroidUpper[axis], centroid[axis]);
+    }
+  }
+  for (size_t axis = 0; axis < 3; ++axis) {
+    node.lower[axis] -= m_padding;
+    node.upper[axis] += m_padding;
+  }
+
+  // Split along the axis over which the centroids spread the most
+  size_t splitAxis = 0;
+  for (size_t axis = 1; axis < 3; ++axis) {
+    if (centroidUpper[axis] - centroidLower[axis] >
+        centroidUpper[splitAxis] - centroidLower[splitAxis])
+      splitAxis = axis;
+  }
+  // Items sharing one centroid cannot be separated
+  if (end - begin <= MAX_LEAF_SIZE ||
+      !(centroidUpper[splitAxis] > centroidLower[splitAxis])) {
+    node.first = static_cast<uint32_t>(begin);
+    node.count = static_cast<uint32_t>(end - begin);
+    m_nodes.push_back(node);
+    return index;
+  }
+
+  node.count = 0;
+  m_nodes.push_back(node);
+  const size_t middle = begin + (end - begin) / 2;
+  std::nth_element(m_order.begin() + begin, m_order.begin() + middle,
+                   m_order.begin() + end,
+                   [&centroids, splitAxis](uint32_t a, uint32_t b) {
+                     return centroids[3 * a + splitAxis] <
+                            centroids[3 * b + splitAxis];
+                   });
+  build(bounds, centroids, begin, middle, depth + 1);
+  const uint32_t second = build(bounds, centroids, middle, end, depth + 1);
+  m_nodes[index].first = second;
+  return index;
+}
+
+} // namespace Geometry
+} // namespace Mantid
@@ -5,6 +5,7 @@
 //     & Institut Laue - Langevin
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidGeometry/Objects/MeshObject.h"
+#include "MantidGeometry/Objects/MeshBVH.h"
 #include "MantidGeometry/Objects/MeshObjectCommon.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidGeometry/RandomPoint.h"
@@ -45,6 +46,22 @@ void MeshObject::initialize() {
   m_handler = boost::make_shared<GeometryHandler>(*this);
 }
 
+/**
+ * @return A copy of this object, sharing its bounding volume hierarchy
+ */
+IObject *MeshObject::clone() const { return cloneWithMaterial(m_material); }
+
+/**
+ * @param material :: The material of the copy
+ * @return A copy of this object made of another material, sharing its
+ * bounding volume hierarchy
+ */
+IObject *MeshObject::cloneWithMaterial(const Kernel::Material &material) const {
+  auto copy = new MeshObject(m_triangles, m_vertices, material);
+  copy->m_bvh = std::atomic_load(&m_bvh);
+  return copy;
+}
+
 /**
  * @return The Material that the object is composed from
  */
@@ -182,17 +199,37 @@ void MeshObject::getIntersections(
 
   Kernel::V3D vertex1, vertex2, vertex3, intersection;
   TrackDirection entryExit;
-  for (size_t i = 0; getTriangle(i, vertex1, vertex2, vertex3); ++i) {
+  // Only test the triangles in the boxes of the hierarchy the ray crosses
+  bvh().forEachCandidate(start, direction, [&](size_t i) {
+    getTriangle(i, vertex1, vertex2, vertex3);
     if (MeshObjectCommon::rayIntersectsTriangle(start, direction, vertex1,
                                                 vertex2, vertex3, intersection,
                                                 entryExit)) {
       intersectionPoints.push_back(intersection);
       entryExitFlags.push_back(entryExit);
     }
-  }
+  });
   // still need to deal with edge cases
 }
 
+/**
+ * Get the bounding volume hierarchy of the triangles, building it on first
+ * use. It is kept until the vertices are moved.
+ * @returns The hierarchy
+ */
+const MeshBVH &MeshObject::bvh() const {
+  auto tree = std::atomic_load(&m_bvh);
+  if (!tree) {
+    std::lock_guard<std::mutex> lock(m_bvhMutex);
+    tree = std::atomic_load(&m_bvh);
+    if (!tree) {
+      tree = std::make_shared<const MeshBVH>(m_triangles, m_vertices);
+      std::atomic_store(&m_bvh, tree);
+    }
+  }
+  return *tree;
+}
+
 /*
  * Get a triangle - useful for iterating over triangles
  * @param index :: Index of triangle in MeshObject
@@ -472,12 +509,16 @@ void MeshObject::rotate(const Kernel::Matrix<double> &rotationMatrix) {
   for (Kernel::V3D &vertex : m_vertices) {
     vertex.rotate(rotationMatrix);
   }
+  m_boundingBox = BoundingBox();
+  std::atomic_store(&m_bvh, std::shared_ptr<const MeshBVH>());
 }
 
 void MeshObject::translate(Kernel::V3D translationVector) {
   for (Kernel::V3D &vertex : m_vertices) {
     vertex = vertex + translationVector;
   }
+  m_boundingBox = BoundingBox();
+  std::atomic_store(&m_bvh, std::shared_ptr<const MeshBVH>());
 }
 
 /**
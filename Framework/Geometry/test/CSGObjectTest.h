@@ -397,6 +397,29 @@ public:
     checkTrackIntercept(geom_obj, track, expectedResults);
   }
 
+  void testInterceptSurfacesMatchesInterceptSurfaceOfEachTrack() {
+    auto geom_obj = createCappedCylinder();
+    V3D diagonal(1., 1., 0.);
+    diagonal.normalize();
+    std::vector<Track> tracks{Track(V3D(0, -10, 0), V3D(0, 1, 0)),
+                              Track(V3D(-10, 0, 0), V3D(1, 0, 0)),
+                              Track(V3D(-10, 0, 0), diagonal),
+                              Track(V3D(0, 0, 0), V3D(1, 0, 0))};
+    auto expectedTracks = tracks;
+    int expectedCount(0);
+    for (auto &track : expectedTracks) {
+      expectedCount += geom_obj->interceptSurface(track);
+    }
+
+    TS_ASSERT_EQUALS(expectedCount, geom_obj->interceptSurfaces(tracks));
+    TS_ASSERT_EQUALS(3, expectedCount);
+    for (size_t i = 0; i < tracks.size(); ++i) {
+      const std::vector<Link> expectedResults(expectedTracks[i].cbegin(),
+                                              expectedTracks[i].cend());
+      checkTrackIntercept(tracks[i], expectedResults);
+    }
+  }
+
   void checkTrackIntercept(Track &track,
                            const std::vector<Link> &expectedResults) {
     size_t index = 0;
@@ -0,0 +1,179 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_GEOMETRY_COMPILEDRULETEST_H_
+#define MANTID_GEOMETRY_COMPILEDRULETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/CompiledRule.h"
+#include "MantidGeometry/Objects/Rules.h"
+#include "MantidGeometry/Surfaces/Plane.h"
+#include "MantidGeometry/Surfaces/Sphere.h"
+#include "MantidKernel/MersenneTwister.h"
+
+#include <boost/make_shared.hpp>
+
+using namespace Mantid::Geometry;
+using Mantid::Kernel::V3D;
+
+namespace {
+/// The planes of a cube of side 2 centred at the origin, a sphere of radius
+/// 0.5 at the origin and a sphere of radius 1 at (1, 1, 1)
+std::map<int, boost::shared_ptr<Surface>> createSurfaces() {
+  std::map<int, boost::shared_ptr<Surface>> surfaces;
+  const std::vector<std::string> definitions{
+      "px -1", "px 1", "py -1", "py 1", "pz -1", "pz 1"};
+  for (size_t i = 0; i < definitions.size(); ++i) {
+    auto plane = boost::make_shared<Plane>();
+    plane->setSurface(definitions[i]);
+    surfaces[static_cast<int>(i) + 1] = plane;
+  }
+  auto inner = boost::make_shared<Sphere>();
+  inner->setSurface("so 0.5");
+  surfaces[7] = inner;
+  auto outer = boost::make_shared<Sphere>();
+  outer->setSurface("s 1 1 1 1");
+  surfaces[8] = outer;
+  for (auto &surface : surfaces)
+    surface.second->setName(surface.first);
+  return surfaces;
+}
+} // namespace
+
+class CompiledRuleTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompiledRuleTest *createSuite() { return new CompiledRuleTest(); }
+  static void destroySuite(CompiledRuleTest *suite) { delete suite; }
+
+  void test_default_rule_is_not_compiled() {
+    CompiledRule rule;
+    TS_ASSERT(!rule.isCompiled());
+    TS_ASSERT_EQUALS(rule.size(), 0);
+  }
+
+  void test_intersection_agrees_with_tree() {
+    // A cube of side 2 centred at the origin
+    checkAgreesWithTree("1 -2 3 -4 5 -6", 6);
+  }
+
+  void test_union_and_complement_agree_with_tree() {
+    // The cube without the sphere, joined with a second sphere
+    checkAgreesWithTree("(1 -2 3 -4 5 -6 #(-7)) : -8", 8);
+  }
+
+  void test_constant_values_need_no_instructions() {
+    BoolValue value;
+    value.setStatus(1);
+    CompiledRule always(value);
+    TS_ASSERT(always.isCompiled());
+    TS_ASSERT_EQUALS(always.size(), 0);
+    TS_ASSERT(always.isValid(V3D(1.0, 2.0, 3.0)));
+    value.setStatus(0);
+    CompiledRule never(value);
+    TS_ASSERT(never.isCompiled());
+    TS_ASSERT(!never.isValid(V3D(1.0, 2.0, 3.0)));
+  }
+
+  void test_points_on_surfaces_are_valid() {
+    CSGObject object;
+    object.setObject(1, "1 -2 3 -4 5 -6 7");
+    object.populate(createSurfaces());
+    CompiledRule rule(*object.topRule());
+    TS_ASSERT(rule.isCompiled());
+    // On a face of the cube, on the sphere and at a corner
+    TS_ASSERT(rule.isValid(V3D(1.0, 0.9, 0.9)));
+    TS_ASSERT(rule.isValid(V3D(0.5, 0.0, 0.0)));
+    TS_ASSERT(rule.isValid(V3D(-1.0, -1.0, -1.0)));
+    TS_ASSERT(!rule.isValid(V3D(0.0, 0.0, 0.0)));
+    TS_ASSERT(!rule.isValid(V3D(1.0 + 1e-3, 0.9, 0.9)));
+  }
+
+  void test_complement_of_object_is_not_compiled() {
+    CompObj complement;
+    CompiledRule rule(complement);
+    TS_ASSERT(!rule.isCompiled());
+    TS_ASSERT_EQUALS(rule.size(), 0);
+  }
+
+  void test_surfaces_that_are_not_set_are_invalid() {
+    CSGObject object;
+    object.setObject(1, "1 : #(2)");
+    CompiledRule rule(*object.topRule());
+    TS_ASSERT(rule.isCompiled());
+    TS_ASSERT_EQUALS(rule.size(), 0);
+    const V3D point(0.0, 0.0, 0.0);
+    TS_ASSERT_EQUALS(rule.isValid(point), object.topRule()->isValid(point));
+  }
+
+private:
+  void checkAgreesWithTree(const std::string &objectString,
+                           size_t expectedSize) {
+    CSGObject object;
+    object.setObject(1, objectString);
+    object.populate(createSurfaces());
+    CompiledRule rule(*object.topRule());
+    TS_ASSERT(rule.isCompiled());
+    TS_ASSERT_EQUALS(rule.size(), expectedSize);
+
+    Mantid::Kernel::MersenneTwister rng(12345, -2.5, 2.5);
+    size_t inside = 0;
+    for (size_t i = 0; i < 10000; ++i) {
+      const V3D point(rng.nextValue(), rng.nextValue(), rng.nextValue());
+      const bool expected = object.topRule()->isValid(point);
+      TS_ASSERT_EQUALS(rule.isValid(point), expected);
+      TS_ASSERT_EQUALS(object.isValid(point), expected);
+      if (expected)
+        ++inside;
+    }
+    TS_ASSERT(inside > 0);
+  }
+};
+
+class CompiledRuleTestPerformance : public CxxTest::TestSuite {
+public:
+  static CompiledRuleTestPerformance *createSuite() {
+    return new CompiledRuleTestPerformance();
+  }
+  static void destroySuite(CompiledRuleTestPerformance *suite) {
+    delete suite;
+  }
+
+  CompiledRuleTestPerformance() {
+    m_object.setObject(1, "(1 -2 3 -4 5 -6 #(-7)) : -8");
+    m_object.populate(createSurfaces());
+    Mantid::Kernel::MersenneTwister rng(12345, -2.5, 2.5);
+    m_points.reserve(NPOINTS);
+    for (size_t i = 0; i < NPOINTS; ++i)
+      m_points.emplace_back(rng.nextValue(), rng.nextValue(), rng.nextValue());
+  }
+
+  void test_isValid_with_compiled_rule() {
+    size_t inside = 0;
+    for (const auto &point : m_points)
+      inside += m_object.isValid(point);
+    TS_ASSERT(inside > 0);
+  }
+
+  /// The same points through the rule tree, for comparison
+  void test_isValid_with_rule_tree() {
+    const auto &tree = *m_object.topRule();
+    size_t inside = 0;
+    for (const auto &point : m_points)
+      inside += tree.isValid(point);
+    TS_ASSERT(inside > 0);
+  }
+
+private:
+  static constexpr size_t NPOINTS = 2000000;
+  CSGObject m_object;
+  std::vector<V3D> m_points;
+};
+
+#endif /* MANTID_GEOMETRY_COMPILEDRULETEST_H_ */
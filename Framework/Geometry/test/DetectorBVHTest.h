@@ -0,0 +1,117 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_GEOMETRY_DETECTORBVHTEST_H_
+#define MANTID_GEOMETRY_DETECTORBVHTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
+#include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/InstrumentVisitor.h"
+#include "MantidGeometry/Objects/DetectorBVH.h"
+#include "MantidGeometry/Objects/InstrumentRayTracer.h"
+#include "MantidKernel/MersenneTwister.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
+
+#include <boost/make_shared.hpp>
+
+using namespace Mantid::Geometry;
+using Mantid::Kernel::V3D;
+
+class DetectorBVHTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static DetectorBVHTest *createSuite() { return new DetectorBVHTest(); }
+  static void destroySuite(DetectorBVHTest *suite) { delete suite; }
+
+  void test_monitors_are_not_included() {
+    auto instrument = createInstrumentAlongBeam();
+    auto wrappers = InstrumentVisitor::makeWrappers(*instrument);
+    DetectorBVH bvh(*wrappers.first, *wrappers.second);
+    TS_ASSERT_EQUALS(bvh.numberOfDetectors(), 2);
+  }
+
+  void test_nearest_detector_is_hit() {
+    auto instrument = createInstrumentAlongBeam();
+    auto wrappers = InstrumentVisitor::makeWrappers(*instrument);
+    const auto &detectorInfo = *wrappers.second;
+    DetectorBVH bvh(*wrappers.first, detectorInfo);
+    // The monitor at 3 m is passed through
+    const auto hit = bvh.firstDetectorHit(V3D(0, 0, 0), V3D(0, 0, 1));
+    TS_ASSERT_EQUALS(hit, detectorInfo.indexOf(2));
+    // Starting beyond the first detector
+    TS_ASSERT_EQUALS(bvh.firstDetectorHit(V3D(0, 0, 4.5), V3D(0, 0, 1)),
+                     detectorInfo.indexOf(3));
+    TS_ASSERT_EQUALS(bvh.firstDetectorHit(V3D(0, 0, 0), V3D(0, 0, -1)),
+                     DetectorBVH::NO_DETECTOR);
+    TS_ASSERT_EQUALS(bvh.firstDetectorHit(V3D(0, 0.2, 0), V3D(0, 0, 1)),
+                     DetectorBVH::NO_DETECTOR);
+  }
+
+  void test_direction_has_to_be_a_unit_vector() {
+    auto instrument = createInstrumentAlongBeam();
+    auto wrappers = InstrumentVisitor::makeWrappers(*instrument);
+    DetectorBVH bvh(*wrappers.first, *wrappers.second);
+    TS_ASSERT_THROWS(bvh.firstDetectorHit(V3D(0, 0, 0), V3D(0, 0, 2)),
+                     std::invalid_argument);
+  }
+
+  void test_agrees_with_tracing_the_component_tree() {
+    auto instrument =
+        ComponentCreationHelper::createTestInstrumentRectangular(2, 20);
+    auto wrappers = InstrumentVisitor::makeWrappers(*instrument);
+    const auto &detectorInfo = *wrappers.second;
+    DetectorBVH bvh(*wrappers.first, detectorInfo);
+    TS_ASSERT_EQUALS(bvh.numberOfDetectors(), 800);
+
+    InstrumentRayTracer tracer(instrument);
+    Mantid::Kernel::MersenneTwister rng(12345, -0.01, 0.04);
+    const V3D samplePos = instrument->getSample()->getPos();
+    size_t hits = 0;
+    for (size_t i = 0; i < 1000; ++i) {
+      V3D direction(rng.nextValue(), rng.nextValue(), 1.0);
+      direction.normalize();
+      tracer.traceFromSample(direction);
+      const auto det = tracer.getDetectorResult();
+      const auto hit = bvh.firstDetectorHit(samplePos, direction);
+      if (det) {
+        TS_ASSERT_EQUALS(hit, detectorInfo.indexOf(det->getID()));
+        ++hits;
+      } else {
+        TS_ASSERT_EQUALS(hit, DetectorBVH::NO_DETECTOR);
+      }
+    }
+    TS_ASSERT(hits > 0);
+  }
+
+private:
+  /// A monitor at 3 m and detectors at 4 m and 5 m along the beam from the
+  /// sample
+  Instrument_sptr createInstrumentAlongBeam() {
+    auto instrument = boost::make_shared<Instrument>("along_beam");
+    ComponentCreationHelper::addSourceToInstrument(instrument,
+                                                   V3D(0, 0, -10));
+    ComponentCreationHelper::addSampleToInstrument(instrument, V3D(0, 0, 0));
+    auto shape = ComponentCreationHelper::createSphere(0.1);
+    for (int id = 1; id <= 3; ++id) {
+      auto detector = new Detector("det" + std::to_string(id), id, shape,
+                                   instrument.get());
+      detector->setPos(V3D(0, 0, 2.0 + id));
+      instrument->add(detector);
+      if (id == 1)
+        instrument->markAsMonitor(detector);
+      else
+        instrument->markAsDetector(detector);
+    }
+    return instrument;
+  }
+};
+
+#endif /* MANTID_GEOMETRY_DETECTORBVHTEST_H_ */
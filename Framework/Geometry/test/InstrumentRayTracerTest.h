@@ -7,7 +7,9 @@
 #ifndef INSTRUMENTRAYTRACERTEST_H_
 #define INSTRUMENTRAYTRACERTEST_H_
 
+#include "MantidGeometry/Instrument/ParameterMap.h"
 #include "MantidGeometry/Instrument/RectangularDetector.h"
+#include "MantidGeometry/Objects/DetectorBVH.h"
 #include "MantidGeometry/Objects/InstrumentRayTracer.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidTestHelpers/ComponentCreationHelper.h"
@@ -224,6 +226,52 @@ public:
                               V3D(0.0, 1.0, 0.0), -1, -1);
   }
 
+  void test_traceDetectorFromSample_finds_the_first_detector() {
+    Instrument_sptr inst =
+        ComponentCreationHelper::createTestInstrumentRectangular(2, 100);
+    InstrumentRayTracer tracker(inst);
+    const double w = 0.008;
+    const std::vector<V3D> dirs{V3D(0.0, 0.0, 1.0), V3D(w, 2 * w, 5.0),
+                                V3D(w * 99, w * 99, 5.0), V3D(-w, 0, 5.0),
+                                V3D(1.0, 0.0, 0.0)};
+    std::vector<size_t> expected;
+    for (auto dir : dirs) {
+      dir.normalize();
+      tracker.traceFromSample(dir);
+      const auto det = tracker.getDetectorResult();
+      expected.push_back(det ? inst->detectorIndex(det->getID())
+                             : DetectorBVH::NO_DETECTOR);
+      TS_ASSERT_EQUALS(tracker.traceDetectorFromSample(dir), expected.back());
+    }
+    // Only the last two miss, and the first bank is in front of the second
+    TS_ASSERT_EQUALS(expected[0], 0);
+    TS_ASSERT_EQUALS(expected[3], DetectorBVH::NO_DETECTOR);
+    TS_ASSERT_EQUALS(expected[4], DetectorBVH::NO_DETECTOR);
+
+    std::vector<V3D> unitDirs(dirs);
+    for (auto &dir : unitDirs)
+      dir.normalize();
+    TS_ASSERT_EQUALS(tracker.traceDetectorsFromSample(unitDirs), expected);
+    TS_ASSERT_THROWS(tracker.traceDetectorsFromSample(dirs),
+                     std::invalid_argument);
+  }
+
+  void test_traceDetectorFromSample_uses_the_parametrized_positions() {
+    Instrument_sptr base =
+        ComponentCreationHelper::createTestInstrumentRectangular(1, 10);
+    auto pmap = boost::make_shared<ParameterMap>();
+    auto inst = boost::make_shared<Instrument>(base, pmap);
+    // Move the bank off the beam
+    pmap->addV3D(base->getComponentByName("bank1").get(), "pos",
+                 V3D(1.0, 0.0, 5.0));
+    InstrumentRayTracer tracker(inst);
+    TS_ASSERT_EQUALS(tracker.traceDetectorFromSample(V3D(0.0, 0.0, 1.0)),
+                     DetectorBVH::NO_DETECTOR);
+    V3D dir(1.0, 0.0, 5.0);
+    dir.normalize();
+    TS_ASSERT_EQUALS(tracker.traceDetectorFromSample(dir), 0);
+  }
+
 private:
   /// Setup the shared test instrument
   Instrument_sptr setupInstrument() {
@@ -0,0 +1,135 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_GEOMETRY_MESHBVHTEST_H_
+#define MANTID_GEOMETRY_MESHBVHTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Objects/MeshBVH.h"
+#include "MantidGeometry/Objects/MeshObjectCommon.h"
+#include "MantidKernel/MersenneTwister.h"
+
+#include <set>
+
+using Mantid::Geometry::MeshBVH;
+using Mantid::Kernel::V3D;
+
+class MeshBVHTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MeshBVHTest *createSuite() { return new MeshBVHTest(); }
+  static void destroySuite(MeshBVHTest *suite) { delete suite; }
+
+  void test_empty_mesh_has_no_candidates() {
+    MeshBVH bvh({}, {});
+    TS_ASSERT_EQUALS(bvh.numberOfNodes(), 0);
+    size_t count = 0;
+    bvh.forEachCandidate(V3D(0, 0, 0), V3D(0, 0, 1),
+                         [&count](size_t) { ++count; });
+    TS_ASSERT_EQUALS(count, 0);
+  }
+
+  void test_depth_grows_with_the_logarithm_of_the_size() {
+    std::vector<uint32_t> triangles;
+    std::vector<V3D> vertices;
+    createTriangles(4096, triangles, vertices);
+    MeshBVH bvh(triangles, vertices);
+    // 4096 triangles in leaves of at most 4 need 10 levels below the root
+    TS_ASSERT_EQUALS(bvh.depth(), 11);
+    TS_ASSERT_EQUALS(bvh.numberOfNodes(), 2047);
+  }
+
+  void test_candidates_include_every_intersected_triangle() {
+    std::vector<uint32_t> triangles;
+    std::vector<V3D> vertices;
+    createTriangles(2000, triangles, vertices);
+    MeshBVH bvh(triangles, vertices);
+
+    Mantid::Kernel::MersenneTwister rng(12345, -2.0, 2.0);
+    size_t totalHits = 0, totalCandidates = 0;
+    for (size_t ray = 0; ray < 200; ++ray) {
+      const V3D start(rng.nextValue(), rng.nextValue(), rng.nextValue());
+      V3D direction(rng.nextValue(), rng.nextValue(), rng.nextValue());
+      // some rays parallel to the axes
+      if (ray % 4 == 0)
+        direction = V3D(0, 0, ray % 8 == 0 ? 1 : -1);
+      direction.normalize();
+
+      std::set<size_t> candidates;
+      bvh.forEachCandidate(start, direction, [&candidates](size_t i) {
+        TS_ASSERT(candidates.insert(i).second);
+      });
+      totalCandidates += candidates.size();
+      for (size_t i = 0; i < triangles.size() / 3; ++i) {
+        V3D intersection;
+        Mantid::Geometry::TrackDirection entryExit;
+        if (Mantid::Geometry::MeshObjectCommon::rayIntersectsTriangle(
+                start, direction, vertices[triangles[3 * i]],
+                vertices[triangles[3 * i + 1]], vertices[triangles[3 * i + 2]],
+                intersection, entryExit)) {
+          ++totalHits;
+          TS_ASSERT_EQUALS(candidates.count(i), 1);
+        }
+      }
+    }
+    TS_ASSERT(totalHits > 0);
+    // The hierarchy has to prune most of the triangles
+    TS_ASSERT_LESS_THAN(totalCandidates, 200 * 2000 / 10);
+  }
+
+  void test_triangle_just_behind_the_start_is_a_candidate() {
+    const std::vector<V3D> vertices{V3D(0, 0, 0), V3D(1, 0, 0), V3D(0, 1, 0)};
+    MeshBVH bvh({0, 1, 2}, vertices);
+    size_t count = 0;
+    bvh.forEachCandidate(V3D(0.25, 0.25, 1e-8), V3D(0, 0, 1),
+                         [&count](size_t) { ++count; });
+    TS_ASSERT_EQUALS(count, 1);
+    count = 0;
+    bvh.forEachCandidate(V3D(0.25, 0.25, 1e-3), V3D(0, 0, 1),
+                         [&count](size_t) { ++count; });
+    TS_ASSERT_EQUALS(count, 0);
+  }
+
+  void test_hierarchy_over_boxes() {
+    // A row of unit cubes along x
+    std::vector<double> bounds;
+    for (size_t i = 0; i < 100; ++i) {
+      const auto x = static_cast<double>(2 * i);
+      bounds.insert(bounds.end(), {x, 0.0, 0.0, x + 1.0, 1.0, 1.0});
+    }
+    MeshBVH bvh(bounds);
+    TS_ASSERT_EQUALS(bvh.depth(), 6);
+    std::set<size_t> candidates;
+    bvh.forEachCandidate(V3D(40.5, 0.5, -1.0), V3D(0, 0, 1),
+                         [&candidates](size_t i) { candidates.insert(i); });
+    // Only the cubes of the leaf holding the one hit
+    TS_ASSERT_EQUALS(candidates.count(20), 1);
+    TS_ASSERT_LESS_THAN_EQUALS(candidates.size(), 4);
+    candidates.clear();
+    bvh.forEachCandidate(V3D(-1.0, 0.5, 0.5), V3D(1, 0, 0),
+                         [&candidates](size_t i) { candidates.insert(i); });
+    TS_ASSERT_EQUALS(candidates.size(), 100);
+  }
+
+private:
+  /// Small triangles scattered over a cube of side 2 centred at the origin
+  void createTriangles(size_t number, std::vector<uint32_t> &triangles,
+                       std::vector<V3D> &vertices) {
+    Mantid::Kernel::MersenneTwister rng(54321, -1.0, 1.0);
+    for (size_t i = 0; i < number; ++i) {
+      const V3D corner(rng.nextValue(), rng.nextValue(), rng.nextValue());
+      const auto first = static_cast<uint32_t>(vertices.size());
+      vertices.emplace_back(corner);
+      vertices.emplace_back(corner + V3D(0.1 * rng.nextValue(), 0.1, 0.0));
+      vertices.emplace_back(corner + V3D(0.0, 0.1 * rng.nextValue(), 0.1));
+      triangles.insert(triangles.end(), {first, first + 1, first + 2});
+    }
+  }
+};
+
+#endif /* MANTID_GEOMETRY_MESHBVHTEST_H_ */
@@ -79,6 +79,33 @@ std::unique_ptr<MeshObject> createCube(const double size) {
   return createCube(size, V3D(0.5 * size, 0.5 * size, 0.5 * size));
 }
 
+std::unique_ptr<MeshObject> createCubeGrid(const size_t number,
+                                           const double size,
+                                           const double spacing) {
+  /**
+   * Create a mesh of number^3 separate cubes of side length size,
+   * parallel to axes, whose centres lie on a grid of the given spacing
+   * starting at the origin.
+   */
+  std::vector<V3D> vertices;
+  std::vector<uint32_t> triangles;
+  for (size_t i = 0; i < number * number * number; ++i) {
+    const V3D centre(static_cast<double>(i % number) * spacing,
+                     static_cast<double>(i / number % number) * spacing,
+                     static_cast<double>(i / number / number) * spacing);
+    const auto cube = createCube(size, centre);
+    const auto offset = static_cast<uint32_t>(vertices.size());
+    const auto cubeVertices = cube->getVertices();
+    for (size_t j = 0; j < cubeVertices.size(); j += 3)
+      vertices.emplace_back(cubeVertices[j], cubeVertices[j + 1],
+                            cubeVertices[j + 2]);
+    for (const auto index : cube->getTriangles())
+      triangles.push_back(offset + index);
+  }
+  return Mantid::Kernel::make_unique<MeshObject>(
+      std::move(triangles), std::move(vertices), Mantid::Kernel::Material());
+}
+
 std::unique_ptr<MeshObject> createOctahedron() {
   /**
    * Create octahedron with vertices on the axes at -1 & +1.
@@ -385,6 +412,37 @@ public:
     checkTrackIntercept(std::move(geom_obj), track, expectedResults);
   }
 
+  void testInterceptCubeGrid() {
+    // 1000 cubes, enough for the ray to skip most of the triangles
+    auto geom_obj = createCubeGrid(10, 1.0, 2.0);
+    Track track(V3D(-5, 4.1, 6.2), V3D(1, 0, 0));
+
+    // format = startPoint, endPoint, total distance so far
+    std::vector<Link> expectedResults;
+    for (size_t i = 0; i < 10; ++i) {
+      const double x = 2.0 * static_cast<double>(i);
+      expectedResults.emplace_back(Link(V3D(x - 0.5, 4.1, 6.2),
+                                        V3D(x + 0.5, 4.1, 6.2), x + 5.5,
+                                        *geom_obj));
+    }
+    checkTrackIntercept(std::move(geom_obj), track, expectedResults);
+  }
+
+  void testInterceptAfterTranslation() {
+    auto geom_obj = createCube(4.0);
+    Track before(V3D(-10, 1, 1), V3D(1, 0, 0));
+    TS_ASSERT_EQUALS(geom_obj->interceptSurface(before), 1);
+
+    geom_obj->translate(V3D(0, 10, 0));
+    Track miss(V3D(-10, 1, 1), V3D(1, 0, 0));
+    TS_ASSERT_EQUALS(geom_obj->interceptSurface(miss), 0);
+    std::vector<Link> expectedResults;
+    expectedResults.emplace_back(
+        Link(V3D(0, 11, 1), V3D(4, 11, 1), 14.0, *geom_obj));
+    Track after(V3D(-10, 11, 1), V3D(1, 0, 0));
+    checkTrackIntercept(std::move(geom_obj), after, expectedResults);
+  }
+
   void testTrackTwoIsolatedCubes()
   /**
   Test a track going through two objects
@@ -981,7 +1039,7 @@ public:
 
   MeshObjectTestPerformance()
       : rng(200000), octahedron(createOctahedron()), lShape(createLShape()),
-        smallCube(createCube(0.2)) {
+        smallCube(createCube(0.2)), cubeGrid(createCubeGrid(20, 1.0, 2.0)) {
     testPoints = create_test_points();
     testRays = create_test_rays();
     translation = create_translation_vector();
@@ -1033,6 +1091,27 @@ public:
     }
   }
 
+  void test_interceptSurface_large_mesh() {
+    // 96000 triangles, the size of a detailed sample environment
+    const size_t number(10000);
+    for (size_t i = 0; i < number; ++i) {
+      V3D direction(1.0, rng.nextValue() - 0.5, rng.nextValue() - 0.5);
+      direction.normalize();
+      Track track(V3D(-10.0, 40.0 * rng.nextValue() - 1.0,
+                      40.0 * rng.nextValue() - 1.0),
+                  direction);
+      cubeGrid->interceptSurface(track);
+    }
+  }
+
+  void test_generatePointInside_large_mesh() {
+    const size_t npoints(6000);
+    const size_t maxAttempts(500);
+    for (size_t i = 0; i < npoints; ++i) {
+      cubeGrid->generatePointInObject(rng, maxAttempts);
+    }
+  }
+
   void test_solid_angle() {
     const size_t number(10000);
     for (size_t i = 0; i < number; ++i) {
@@ -1157,6 +1236,7 @@ private:
   std::unique_ptr<MeshObject> octahedron;
   std::unique_ptr<MeshObject> lShape;
   std::unique_ptr<MeshObject> smallCube;
+  std::unique_ptr<MeshObject> cubeGrid;
   std::vector<V3D> testPoints;
   std::vector<Track> testRays;
   V3D translation;
@@ -17,10 +17,18 @@
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
+#include "MantidKernel/NotificationDispatcher.h"
 #include <Poco/Notification.h>
 #include <Poco/NotificationCenter.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <map>
 #include <mutex>
+#include <shared_mutex>
+#include <vector>
 
 #ifdef _WIN32
 #define strcasecmp _stricmp
@@ -68,6 +76,9 @@ private:
   using svc_constit = typename svcmap::const_iterator;
 
 public:
+  /// A name and the object stored under it
+  using NamedObject = std::pair<std::string, boost::shared_ptr<T>>;
+
   /// Class for named object notifications
   class NamedObjectNotification : public Poco::Notification {
   public:
@@ -105,8 +116,8 @@ public:
         : DataServiceNotification(name, obj) {} ///< Constructor
   };
 
-  /// BeforeReplaceNotification is sent before an object is replaced in the
-  /// addOrReplace() function.
+  /// BeforeReplaceNotification is sent when an object is replaced in the
+  /// addOrReplace() function, ahead of the AfterReplaceNotification.
   class BeforeReplaceNotification : public DataServiceNotification {
   public:
     /** Constructor.
@@ -208,12 +219,13 @@ public:
     bool success = false;
     {
       // Make DataService access thread-safe
-      std::lock_guard<std::recursive_mutex> lock(m_mutex);
+      auto &shard = shardFor(name);
+      WriteGuard lock(shard.mutex);
       // At the moment, you can't overwrite an object (i.e. pass in a name
       // that's already in the map with a pointer to a different object).
       // Also, there's nothing to stop the same object from being added
       // more than once with different names.
-      success = datamap.insert(std::make_pair(name, Tobject)).second;
+      success = shard.datamap.insert(std::make_pair(name, Tobject)).second;
     }
     if (!success) {
       std::string error =
@@ -222,13 +234,57 @@ public:
       throw std::runtime_error(error);
     } else {
       g_log.debug() << "Add Data Object " << name << " successful\n";
-      notificationCenter.postNotification(new AddNotification(name, Tobject));
+      postNotification(new AddNotification(name, Tobject));
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  /** Add several objects to the service, locking each part of the store
+   * once. Objects whose name is already in use are not added.
+   * @param objects :: pairs of names and shared pointers to the objects
+   * @throw std::runtime_error if a name is empty or a pointer is null, in
+   * which case nothing is added
+   * @throw std::runtime_error if any name exists in the map, after the
+   * other objects have been added
+   */
+  virtual void addBatch(const std::vector<NamedObject> &objects) {
+    for (const auto &item : objects) {
+      checkForEmptyName(item.first);
+      checkForNullPointer(item.second);
+    }
+
+    std::vector<char> added(objects.size(), 0);
+    for (size_t s = 0; s < m_shards.size(); ++s) {
+      auto &shard = m_shards[s];
+      WriteGuard lock(shard.mutex);
+      for (size_t i = 0; i < objects.size(); ++i) {
+        if (shardIndex(objects[i].first) == s)
+          added[i] = shard.datamap.insert(objects[i]).second;
+      }
+    }
+
+    std::string failed;
+    for (size_t i = 0; i < objects.size(); ++i) {
+      if (added[i])
+        postNotification(
+            new AddNotification(objects[i].first, objects[i].second));
+      else
+        failed += " '" + objects[i].first + "'";
+    }
+    if (!failed.empty()) {
+      std::string error = " addBatch : Unable to insert Data Objects :" + failed;
+      g_log.error(error);
+      throw std::runtime_error(error);
     }
   }
 
   //--------------------------------------------------------------------------
   /** Add or replace an object to the service.
-   * Does NOT throw if the name was already used.
+   * Does NOT throw if the name was already used. As in earlier versions, the
+   * BeforeReplaceNotification is sent while the old object is still stored.
+   * The object is only stored if the name still holds the object the
+   * notification was sent for; if another call changed it in between, the
+   * notifications are sent again for what is now stored.
    *
    * @param name :: name of the object
    * @param Tobject :: shared pointer to object to add
@@ -236,30 +292,37 @@ public:
    */
   virtual void addOrReplace(const std::string &name,
                             const boost::shared_ptr<T> &Tobject) {
+    checkForEmptyName(name);
     checkForNullPointer(Tobject);
 
-    // Make DataService access thread-safe
-    std::unique_lock<std::recursive_mutex> lock(m_mutex);
-
-    // find if the Tobject already exists
-    auto it = datamap.find(name);
-    if (it != datamap.end()) {
-      lock.unlock();
-      g_log.debug("Data Object '" + name + "' replaced in data service.\n");
-
-      notificationCenter.postNotification(
-          new BeforeReplaceNotification(name, it->second, Tobject));
-
-      lock.lock();
-      it->second = Tobject;
-      lock.unlock();
+    auto &shard = shardFor(name);
+    auto existing = find(name);
+    while (true) {
+      if (existing) {
+        g_log.debug("Data Object '" + name + "' replaced in data service.\n");
+        postNotification(
+            new BeforeReplaceNotification(name, existing, Tobject));
+      }
+      {
+        WriteGuard lock(shard.mutex);
+        auto &stored = shard.datamap[name];
+        if (stored == existing) {
+          stored = Tobject;
+          break;
+        }
+        // Changed by another call since it was looked up
+        existing = stored;
+        if (!existing)
+          shard.datamap.erase(name);
+      }
+    }
 
-      notificationCenter.postNotification(
-          new AfterReplaceNotification(name, Tobject));
+    if (existing) {
+      postNotification(new AfterReplaceNotification(name, Tobject),
+                       afterReplaceKey(name));
     } else {
-      // Avoid double-locking
-      lock.unlock();
-      DataService::add(name, Tobject);
+      g_log.debug() << "Add Data Object " << name << " successful\n";
+      postNotification(new AddNotification(name, Tobject));
     }
   }
 
@@ -267,32 +330,61 @@ public:
   /** Remove an object from the service.
    * @param name :: name of the object */
   void remove(const std::string &name) {
-    // Make DataService access thread-safe
-    std::unique_lock<std::recursive_mutex> lock(m_mutex);
+    boost::shared_ptr<T> data;
+    {
+      // Make DataService access thread-safe
+      auto &shard = shardFor(name);
+      WriteGuard lock(shard.mutex);
 
-    auto it = datamap.find(name);
-    if (it == datamap.end()) {
-      lock.unlock();
-      g_log.debug(" remove '" + name + "' cannot be found");
-      return;
+      auto it = shard.datamap.find(name);
+      if (it == shard.datamap.end()) {
+        g_log.debug(" remove '" + name + "' cannot be found");
+        return;
+      }
+      // The map is shared across threads so the item is erased from the map
+      // before unlocking the mutex and is held in a local stack variable.
+      // This protects it from being modified by another thread.
+      data = std::move(it->second);
+      shard.datamap.erase(it);
     }
-    // The map is shared across threads so the item is erased from the map
-    // before unlocking the mutex and is held in a local stack variable.
-    // This protects it from being modified by another thread.
-    auto data = std::move(it->second);
-    datamap.erase(it);
-
-    // Do NOT use "it" iterator after this point. Other threads may modify the
-    // map
-    lock.unlock();
-    notificationCenter.postNotification(new PreDeleteNotification(name, data));
+
+    postNotification(new PreDeleteNotification(name, data));
     data.reset(); // DataService now has no references to the object
     g_log.debug("Data Object '" + name + "' deleted from data service.");
-    notificationCenter.postNotification(new PostDeleteNotification(name));
+    postNotification(new PostDeleteNotification(name));
+  }
+
+  //--------------------------------------------------------------------------
+  /** Remove several objects from the service, locking each part of the store
+   * once. Names that cannot be found are ignored.
+   * @param names :: names of the objects */
+  virtual void removeBatch(const std::vector<std::string> &names) {
+    std::vector<NamedObject> removed;
+    removed.reserve(names.size());
+    for (size_t s = 0; s < m_shards.size(); ++s) {
+      auto &shard = m_shards[s];
+      WriteGuard lock(shard.mutex);
+      for (const auto &name : names) {
+        if (shardIndex(name) != s)
+          continue;
+        auto it = shard.datamap.find(name);
+        if (it == shard.datamap.end())
+          continue;
+        removed.emplace_back(name, std::move(it->second));
+        shard.datamap.erase(it);
+      }
+    }
+
+    for (auto &item : removed) {
+      postNotification(new PreDeleteNotification(item.first, item.second));
+      item.second.reset();
+      postNotification(new PostDeleteNotification(item.first));
+    }
   }
 
   //--------------------------------------------------------------------------
-  /** Rename an object within the service.
+  /** Rename an object within the service. If an object is stored under the
+   * new name, the BeforeReplaceNotification is sent before it is replaced.
    * @param oldName :: The old name of the object
    * @param newName :: The new name of the object
    */
@@ -304,74 +396,94 @@ public:
       return;
     }
 
-    // Make DataService access thread-safe
-    std::unique_lock<std::recursive_mutex> lock(m_mutex);
-
-    auto existingNameIter = datamap.find(oldName);
-    if (existingNameIter == datamap.end()) {
-      lock.unlock();
-      g_log.warning(" rename '" + oldName + "' cannot be found");
-      return;
-    }
-
-    auto existingNameObject = std::move(existingNameIter->second);
-    auto targetNameIter = datamap.find(newName);
+    // A change of case only renames the existing entry
+    const CaseInsensitiveCmp less;
+    const bool sameEntry =
+        !less(oldName, newName) && !less(newName, oldName);
+    auto &oldShard = shardFor(oldName);
+    auto &newShard = shardFor(newName);
+    auto existingObject = find(oldName);
+    auto targetObject = sameEntry ? boost::shared_ptr<T>() : find(newName);
+    while (true) {
+      if (!existingObject) {
+        g_log.warning(" rename '" + oldName + "' cannot be found");
+        return;
+      }
+      // If we are overriding send a notification for observers
+      if (targetObject) {
+        // As we are renaming the existing name turns into the new name
+        postNotification(new BeforeReplaceNotification(newName, targetObject,
+                                                        existingObject));
+      }
 
-    // If we are overriding send a notification for observers
-    if (targetNameIter != datamap.end()) {
-      auto targetNameObject = targetNameIter->second;
-      // As we are renaming the existing name turns into the new name
-      notificationCenter.postNotification(new BeforeReplaceNotification(
-          newName, targetNameObject, existingNameObject));
+      // Both names are locked for the whole move so that no other change to
+      // either of them can come in between
+      std::unique_lock<std::shared_timed_mutex> oldLock(oldShard.mutex,
+                                                        std::defer_lock);
+      std::unique_lock<std::shared_timed_mutex> newLock(newShard.mutex,
+                                                        std::defer_lock);
+      if (&oldShard == &newShard)
+        oldLock.lock();
+      else
+        std::lock(oldLock, newLock);
+
+      auto existingNameIter = oldShard.datamap.find(oldName);
+      const auto currentExisting = existingNameIter != oldShard.datamap.end()
+                                       ? existingNameIter->second
+                                       : boost::shared_ptr<T>();
+      boost::shared_ptr<T> currentTarget;
+      if (!sameEntry) {
+        auto targetNameIter = newShard.datamap.find(newName);
+        if (targetNameIter != newShard.datamap.end())
+          currentTarget = targetNameIter->second;
+      }
+      if (currentExisting == existingObject && currentTarget == targetObject) {
+        oldShard.datamap.erase(existingNameIter);
+        newShard.datamap[newName] = existingObject;
+        break;
+      }
+      // Changed by another call since they were looked up
+      existingObject = currentExisting;
+      targetObject = currentTarget;
     }
 
-    datamap.erase(existingNameIter);
-
-    if (targetNameIter != datamap.end()) {
-      targetNameIter->second = std::move(existingNameObject);
-      notificationCenter.postNotification(
-          new AfterReplaceNotification(newName, targetNameIter->second));
-    } else {
-      if (!(datamap.emplace(newName, std::move(existingNameObject)).second)) {
-        // should never happen
-        lock.unlock();
-        std::string error =
-            " add : Unable to insert Data Object : '" + newName + "'";
-        g_log.error(error);
-        throw std::runtime_error(error);
-      }
+    if (targetObject) {
+      postNotification(new AfterReplaceNotification(newName, existingObject),
+                       afterReplaceKey(newName));
     }
-    lock.unlock();
     g_log.debug("Data Object '" + oldName + "' renamed to '" + newName + "'");
-    notificationCenter.postNotification(
-        new RenameNotification(oldName, newName));
+    postNotification(new RenameNotification(oldName, newName));
   }
 
   //--------------------------------------------------------------------------
   /// Empty the service
-  void clear() {
-    {
+  virtual void clear() {
+    std::vector<svcmap> cleared(m_shards.size());
+    for (size_t s = 0; s < m_shards.size(); ++s) {
       // Make DataService access thread-safe
-      std::lock_guard<std::recursive_mutex> lock(m_mutex);
-      datamap.clear();
+      WriteGuard lock(m_shards[s].mutex);
+      cleared[s].swap(m_shards[s].datamap);
     }
-    notificationCenter.postNotification(new ClearNotification());
+    // Release the objects outside of the locks
+    cleared.clear();
+    postNotification(new ClearNotification());
     g_log.debug() << typeid(this).name() << " cleared.\n";
   }
 
-  /// Prepare for shutdown
-  virtual void shutdown() { clear(); }
+  /// Prepare for shutdown. Pending notifications are delivered and any sent
+  /// later are delivered synchronously.
+  virtual void shutdown() {
+    clear();
+    setAsynchronousNotifications(false);
+  }
 
   //--------------------------------------------------------------------------
   /** Get a shared pointer to a stored data object
    * @param name :: name of the object */
-  boost::shared_ptr<T> retrieve(const std::string &name) const {
-    // Make DataService access thread-safe
-    std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-
-    auto it = datamap.find(name);
-    if (it != datamap.end()) {
-      return it->second;
+  virtual boost::shared_ptr<T> retrieve(const std::string &name) const {
+    auto object = find(name);
+    if (object) {
+      return object;
     } else {
       throw Kernel::Exception::NotFoundError(
           "Unable to find Data Object type with name '" + name +
@@ -392,25 +504,27 @@ public:
   /// Check to see if a data object exists in the store
   bool doesExist(const std::string &name) const {
     // Make DataService access thread-safe
-    std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-    auto it = datamap.find(name);
-    return it != datamap.end();
+    const auto &shard = shardFor(name);
+    ReadGuard _lock(shard.mutex);
+    return shard.datamap.find(name) != shard.datamap.end();
   }
 
   /// Return the number of objects stored by the data service
   size_t size() const {
-    std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-
-    if (showingHiddenObjects()) {
-      return datamap.size();
-    } else {
-      size_t count = 0;
-      for (auto &it : datamap) {
-        if (!isHiddenDataServiceObject(it.first))
-          ++count;
+    const bool showingHidden = showingHiddenObjects();
+    size_t count = 0;
+    for (const auto &shard : m_shards) {
+      ReadGuard _lock(shard.mutex);
+      if (showingHidden) {
+        count += shard.datamap.size();
+      } else {
+        for (auto &it : shard.datamap) {
+          if (!isHiddenDataServiceObject(it.first))
+            ++count;
+        }
       }
-      return count;
     }
+    return count;
   }
 
   /**
@@ -426,35 +540,8 @@ public:
       DataServiceHidden hiddenState = DataServiceHidden::Auto) const {
 
     std::vector<std::string> foundNames;
-
-    // First test if auto flag is set whether to include hidden
-    if (hiddenState == DataServiceHidden::Auto) {
-      if (showingHiddenObjects()) {
-        hiddenState = DataServiceHidden::Include;
-      } else {
-        hiddenState = DataServiceHidden::Exclude;
-      }
-    }
-
-    // Use the scoping of an if to handle our lock for duration
-    if (hiddenState == DataServiceHidden::Include) {
-      // Getting hidden items
-      std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-      foundNames.reserve(datamap.size());
-      for (const auto &item : datamap) {
-        foundNames.push_back(item.first);
-      }
-      // Lock released at end of scope here
-    } else {
-      std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-      foundNames.reserve(datamap.size());
-      for (const auto &item : datamap) {
-        if (!isHiddenDataServiceObject(item.first)) {
-          // This item is not hidden add it
-          foundNames.push_back(item.first);
-        }
-      }
-      // Lock released at end of scope here
+    for (auto &item : namedObjects(hiddenState)) {
+      foundNames.push_back(std::move(item.first));
     }
 
     // Now sort if told to
@@ -466,27 +553,50 @@ public:
   }
 
   /// Get a vector of the pointers to the data objects stored by the service
-  std::vector<boost::shared_ptr<T>>
+  virtual std::vector<boost::shared_ptr<T>>
   getObjects(DataServiceHidden includeHidden = DataServiceHidden::Auto) const {
-    std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-
-    const bool alwaysIncludeHidden =
-        includeHidden == DataServiceHidden::Include;
-    const bool usingAuto =
-        includeHidden == DataServiceHidden::Auto && showingHiddenObjects();
-
-    const bool showingHidden = alwaysIncludeHidden || usingAuto;
-
     std::vector<boost::shared_ptr<T>> objects;
-    objects.reserve(datamap.size());
-    for (const auto &it : datamap) {
-      if (showingHidden || !isHiddenDataServiceObject(it.first)) {
-        objects.push_back(it.second);
-      }
+    for (auto &item : namedObjects(includeHidden)) {
+      objects.push_back(std::move(item.second));
     }
     return objects;
   }
 
+  //--------------------------------------------------------------------------
+  /** Choose how notifications are delivered. When asynchronous, the calls
+   * modifying the service return without waiting for observers: the
+   * notifications are delivered in order on a dispatcher thread and repeated
+   * AfterReplaceNotifications for the same name that have not yet been
+   * delivered are coalesced into one. The objects carried by the
+   * notifications stay alive until they are delivered.
+   * @param asynchronous :: true to deliver notifications asynchronously
+   */
+  void setAsynchronousNotifications(bool asynchronous) {
+    if (!asynchronous)
+      flushNotifications();
+    m_asynchronous = asynchronous;
+  }
+
+  /// @return true if notifications are delivered asynchronously
+  bool asynchronousNotifications() const { return m_asynchronous; }
+
+  /// Wait until all notifications posted so far have been delivered
+  void flushNotifications() { m_dispatcher.flush(); }
+
+  /** Send a notification to the observers, either directly or through the
+   * dispatcher thread.
+   * @param notification :: The notification. Ownership is taken.
+   * @param coalesceKey :: Key identifying notifications that may be coalesced
+   * when delivered asynchronously
+   */
+  void postNotification(Poco::Notification *notification,
+                        const std::string &coalesceKey = "") {
+    if (m_asynchronous)
+      m_dispatcher.enqueue(notification, coalesceKey);
+    else
+      notificationCenter.postNotification(notification);
+  }
+
   inline static std::string prefixToHide() { return "__"; }
 
   inline static bool isHiddenDataServiceObject(const std::string &name) {
@@ -511,10 +621,100 @@ public:
 
 protected:
   /// Protected constructor (singleton)
-  DataService(const std::string &name) : svcName(name), g_log(svcName) {}
+  DataService(const std::string &name)
+      : svcName(name), m_asynchronous(false), m_dispatcher(notificationCenter),
+        g_log(svcName) {}
   virtual ~DataService() = default;
 
+  /** Replace the object stored under an existing name without sending any
+   * notifications. This allows a derived service to change how an object is
+   * held, e.g. moving it out of memory, without observers seeing a change.
+   * @param name :: name of the object
+   * @param Tobject :: shared pointer to the object to store
+   * @return false if no object is stored under the name
+   */
+  bool replaceSilently(const std::string &name,
+                       const boost::shared_ptr<T> &Tobject) {
+    checkForNullPointer(Tobject);
+    auto &shard = shardFor(name);
+    WriteGuard _lock(shard.mutex);
+    auto it = shard.datamap.find(name);
+    if (it == shard.datamap.end())
+      return false;
+    it->second = Tobject;
+    return true;
+  }
+
 private:
+  /// Exclusive lock on a shard
+  using WriteGuard = std::lock_guard<std::shared_timed_mutex>;
+  /// Shared lock on a shard
+  using ReadGuard = std::shared_lock<std::shared_timed_mutex>;
+
+  /// A part of the store with its own lock. Objects are spread over the
+  /// shards by name so that threads working on different names rarely
+  /// contend and lookups can proceed concurrently.
+  struct Shard {
+    svcmap datamap;
+    mutable std::shared_timed_mutex mutex;
+  };
+
+  /// Index of the shard holding a name, independent of its case
+  size_t shardIndex(const std::string &name) const {
+    // FNV-1a hash of the lower case name
+    size_t hash = 2166136261u;
+    for (const char c : name) {
+      hash ^= static_cast<size_t>(
+          std::tolower(static_cast<unsigned char>(c)));
+      hash *= 16777619u;
+    }
+    return hash % m_shards.size();
+  }
+  Shard &shardFor(const std::string &name) {
+    return m_shards[shardIndex(name)];
+  }
+  const Shard &shardFor(const std::string &name) const {
+    return m_shards[shardIndex(name)];
+  }
+
+  /// The key coalescing the AfterReplaceNotifications for a name, which is
+  /// independent of its case as the names are
+  static std::string afterReplaceKey(const std::string &name) {
+    return "AfterReplace:" + boost::algorithm::to_lower_copy(name);
+  }
+
+  /// Return the object stored under a name or null if there is none
+  boost::shared_ptr<T> find(const std::string &name) const {
+    const auto &shard = shardFor(name);
+    ReadGuard _lock(shard.mutex);
+    auto it = shard.datamap.find(name);
+    return it != shard.datamap.end() ? it->second : boost::shared_ptr<T>();
+  }
+
+  /// Return the stored names and objects ordered case-insensitively by name
+  std::vector<NamedObject> namedObjects(DataServiceHidden hiddenState) const {
+    // First test if auto flag is set whether to include hidden
+    if (hiddenState == DataServiceHidden::Auto) {
+      hiddenState = showingHiddenObjects() ? DataServiceHidden::Include
+                                           : DataServiceHidden::Exclude;
+    }
+    std::vector<NamedObject> found;
+    for (const auto &shard : m_shards) {
+      ReadGuard _lock(shard.mutex);
+      for (const auto &item : shard.datamap) {
+        if (hiddenState == DataServiceHidden::Include ||
+            !isHiddenDataServiceObject(item.first)) {
+          found.push_back(item);
+        }
+      }
+    }
+    std::sort(found.begin(), found.end(),
+              [](const NamedObject &lhs, const NamedObject &rhs) {
+                return CaseInsensitiveCmp()(lhs.first, rhs.first);
+              });
+    return found;
+  }
+
   void checkForEmptyName(const std::string &name) {
     if (name.empty()) {
       const std::string error = "Add Data Object with empty name";
@@ -534,10 +734,12 @@ private:
   /// DataService name. This is set only at construction. DataService name
   /// should be provided when construction of derived classes
   const std::string svcName;
-  /// Map of objects in the data service
-  svcmap datamap;
-  /// Recursive mutex to avoid simultaneous access or notifications
-  mutable std::recursive_mutex m_mutex;
+  /// Objects in the data service, spread over independently locked shards
+  std::array<Shard, 16> m_shards;
+  /// True if notifications are delivered by the dispatcher thread
+  std::atomic<bool> m_asynchronous;
+  /// Delivers notifications asynchronously
+  NotificationDispatcher m_dispatcher;
   /// Logger for this DataService
   Logger g_log;
 }; // End Class Data service
@@ -28,6 +28,9 @@
 // std
 #include <functional>
 #include <iterator>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
 #include <vector>
 
 namespace Mantid {
@@ -46,6 +49,10 @@ using CaseSensitiveStringComparator = std::less<std::string>;
    response
     to requests from other classes.
 
+    The registrations are guarded by a lock so that classes may be
+   subscribed, e.g. by a plugin library opened on demand, while other threads
+   look them up.
+
     @author Nick Draper, Tessella Support Services plc
     @date 10/10/2007
 */
@@ -97,12 +104,7 @@ public:
   /// @param className :: the name of the class you wish to create
   /// @return a shared pointer ot the base class
   virtual boost::shared_ptr<Base> create(const std::string &className) const {
-    auto it = _map.find(className);
-    if (it != _map.end())
-      return it->second->createInstance();
-    else
-      throw Exception::NotFoundError(
-          "DynamicFactory: " + className + " is not registered.\n", className);
+    return findInstantiator(className)->createInstance();
   }
 
   /// Creates a new instance of the class with the given name, which
@@ -115,12 +117,7 @@ public:
   /// @param className :: the name of the class you wish to create
   /// @return a pointer to the base class
   virtual Base *createUnwrapped(const std::string &className) const {
-    auto it = _map.find(className);
-    if (it != _map.end())
-      return it->second->createUnwrappedInstance();
-    else
-      throw Exception::NotFoundError(
-          "DynamicFactory: " + className + " is not registered.\n", className);
+    return findInstantiator(className)->createUnwrappedInstance();
   }
 
   /// Registers the instantiator for the given class with the DynamicFactory.
@@ -152,16 +149,18 @@ public:
       throw std::invalid_argument("Cannot register empty class name");
     }
 
-    auto it = _map.find(className);
-    if (it == _map.end() || replace == OverwriteCurrent) {
+    {
+      std::lock_guard<std::shared_timed_mutex> lock(m_mutex);
+      auto it = _map.find(className);
+      if (it != _map.end() && replace != OverwriteCurrent) {
+        delete pAbstractFactory;
+        throw std::runtime_error(className + " is already registered.\n");
+      }
       if (it != _map.end() && it->second)
         delete it->second;
       _map[className] = pAbstractFactory;
-      sendUpdateNotificationIfEnabled();
-    } else {
-      delete pAbstractFactory;
-      throw std::runtime_error(className + " is already registered.\n");
     }
+    sendUpdateNotificationIfEnabled();
   }
 
   /// Unregisters the given class and deletes the instantiator
@@ -169,27 +168,31 @@ public:
   /// Throws a NotFoundException if the class has not been registered.
   /// @param className :: the name of the class you wish to unsubscribe
   void unsubscribe(const std::string &className) {
-    auto it = _map.find(className);
-    if (!className.empty() && it != _map.end()) {
+    {
+      std::lock_guard<std::shared_timed_mutex> lock(m_mutex);
+      auto it = _map.find(className);
+      if (className.empty() || it == _map.end())
+        throw Exception::NotFoundError(
+            "DynamicFactory:" + className + " is not registered.\n",
+            className);
       delete it->second;
       _map.erase(it);
-      sendUpdateNotificationIfEnabled();
-    } else {
-      throw Exception::NotFoundError(
-          "DynamicFactory:" + className + " is not registered.\n", className);
     }
+    sendUpdateNotificationIfEnabled();
   }
 
   /// Returns true if the given class is currently registered.
   /// @param className :: the name of the class you wish to check
   /// @returns true is the class is subscribed
   bool exists(const std::string &className) const {
+    std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
     return _map.find(className) != _map.end();
   }
 
   /// Returns the keys in the map
   /// @return A string vector of keys
   virtual const std::vector<std::string> getKeys() const {
+    std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
     std::vector<std::string> names;
     names.reserve(_map.size());
     std::transform(
@@ -211,6 +214,19 @@ protected:
   DynamicFactory() : notificationCenter(), _map(), m_notifyStatus(Disabled) {}
 
 private:
+  /// Find the instantiator of a class. Instantiators are only deleted when
+  /// the class is unsubscribed so it can be used once the lock is released.
+  /// @param className :: the name of the class
+  /// @return the instantiator registered for the class
+  AbstractFactory *findInstantiator(const std::string &className) const {
+    std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
+    auto it = _map.find(className);
+    if (it == _map.end())
+      throw Exception::NotFoundError(
+          "DynamicFactory: " + className + " is not registered.\n", className);
+    return it->second;
+  }
+
   /// Send an update notification if they are enabled
   void sendUpdateNotificationIfEnabled() {
     if (m_notifyStatus == Enabled)
@@ -227,6 +243,8 @@ private:
   FactoryMap _map;
   /// Flag marking whether we should dispatch notifications
   NotificationStatus m_notifyStatus;
+  /// Guards the map of registered classes
+  mutable std::shared_timed_mutex m_mutex;
 };
 
 } // namespace Kernel
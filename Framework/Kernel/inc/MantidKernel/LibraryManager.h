@@ -10,6 +10,7 @@
 //----------------------------------------------------------------------
 // Includes
 //----------------------------------------------------------------------
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -36,6 +37,12 @@ public:
   enum LoadLibraries { Recursive, NonRecursive };
   int openLibraries(const std::string &libpath, LoadLibraries loadingBehaviour,
                     const std::vector<std::string> &excludes);
+  /// Find the libraries on a path that openLibraries would open
+  std::vector<std::string>
+  findLibraries(const std::string &libpath, LoadLibraries loadingBehaviour,
+                const std::vector<std::string> &excludes) const;
+  /// Open a single library given its full path
+  bool openLibrary(const std::string &filepath);
   LibraryManagerImpl(const LibraryManagerImpl &) = delete;
   LibraryManagerImpl &operator=(const LibraryManagerImpl &) = delete;
 
@@ -51,6 +58,10 @@ private:
   /// Private so Poco::File doesn't leak to the public interface
   int openLibraries(const Poco::File &libpath, LoadLibraries loadingBehaviour,
                     const std::vector<std::string> &excludes);
+  /// Find the libraries on the given Poco::File path
+  void findLibraries(const Poco::File &libpath, LoadLibraries loadingBehaviour,
+                     const std::vector<std::string> &excludes,
+                     std::vector<std::string> &libraries) const;
   /// Check if the library should be loaded
   bool shouldBeLoaded(const std::string &filename,
                       const std::vector<std::string> &excludes) const;
@@ -64,6 +75,8 @@ private:
 
   /// Storage for the LibraryWrappers.
   std::unordered_map<std::string, LibraryWrapper> m_openedLibs;
+  /// Serializes opening libraries, which may happen on demand from any thread
+  mutable std::recursive_mutex m_mutex;
 };
 
 EXTERN_MANTID_KERNEL template class MANTID_KERNEL_DLL
@@ -0,0 +1,65 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_KERNEL_LOGMESSAGEBUFFER_H_
+#define MANTID_KERNEL_LOGMESSAGEBUFFER_H_
+
+#include "MantidKernel/DllConfig.h"
+
+#include <Poco/Message.h>
+
+#include <utility>
+#include <vector>
+
+namespace Poco {
+class Logger;
+}
+
+namespace Mantid {
+namespace Kernel {
+
+/** LogMessageBuffer holds back log messages so that the output of work done
+  concurrently can be sent in a fixed order rather than interleaved.
+
+  While a Capture is in scope, the messages that would be published on its
+  thread by any Logger are stored in the buffer instead. flush() then sends
+  them, in the order they were logged, from whichever thread calls it.
+  Messages below the level of their logger are dropped as usual rather than
+  stored. Threads started by the captured work log directly.
+*/
+class MANTID_KERNEL_DLL LogMessageBuffer {
+public:
+  /// Redirects the messages logged on the constructing thread to a buffer
+  /// until it goes out of scope
+  class MANTID_KERNEL_DLL Capture {
+  public:
+    explicit Capture(LogMessageBuffer &buffer);
+    ~Capture();
+    Capture(const Capture &) = delete;
+    Capture &operator=(const Capture &) = delete;
+
+  private:
+    /// The buffer that was capturing on this thread before, if any
+    LogMessageBuffer *m_previous;
+  };
+
+  /// Sends the held messages to their loggers and empties the buffer
+  void flush();
+  /// The number of messages held
+  size_t size() const { return m_messages.size(); }
+
+  /// Stores the message if a buffer is capturing on the calling thread.
+  /// Returns false if the message should be published as usual.
+  static bool hold(Poco::Logger &logger, const Poco::Message &message);
+
+private:
+  std::vector<std::pair<Poco::Logger *, Poco::Message>> m_messages;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_LOGMESSAGEBUFFER_H_ */
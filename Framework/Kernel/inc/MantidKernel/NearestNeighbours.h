@@ -7,20 +7,33 @@
 #ifndef MANTID_KERNEL_NEARESTNEIGHBOURS_H_
 #define MANTID_KERNEL_NEARESTNEIGHBOURS_H_
 
-#include "MantidKernel/ANN/ANN.h"
 #include "MantidKernel/DllConfig.h"
-#include "MantidKernel/make_unique.h"
+#include "MantidKernel/MultiThreaded.h"
 
 #include <Eigen/Core>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 /**
-  NearestNeighbours is a thin wrapper class around the ANN library for finding
-  the k nearest neighbours.
+  NearestNeighbours finds the k nearest neighbours of, or all neighbours within
+  a radius of, a position in a fixed set of points.
 
   Given a vector of Eigen::Vectors this class will generate a KDTree. The tree
   can then be interrogated to find the closest k neighbours to a given position.
 
+  The tree is stored flat: the points are copied into one contiguous array in
+  tree order and the nodes are laid out depth first so that a query walks
+  through memory mostly forwards. Subtrees are built in parallel. Queries do
+  not modify the tree so any number of threads may query it at once, and the
+  batched overloads of the queries answer a whole set of positions in
+  parallel.
+
+  All distances returned are squared Euclidean distances.
+
   This classes is templated with a parameter N which defines the dimensionality
   of the vector type used. i.e. if N = 3 then Eigen::Vector3d is used.
 
@@ -31,149 +44,324 @@
 namespace Mantid {
 namespace Kernel {
 
-//------------------------------------------------------------------------------
-// Helper classes
-//------------------------------------------------------------------------------
+template <int N = 3> class DLLExport NearestNeighbours {
 
-/**
- * NNDataPoints is a thin RAII wrapper class around the ANNpointArray type. This
- * takes care of the proper allocation and deallocation of memory.
- */
-class NNDataPoints {
 public:
-  /** Construct a new set of data points
+  // typedefs for code brevity
+  using VectorType = Eigen::Matrix<double, N, 1>;
+  using NearestNeighbourResults =
+      std::vector<std::tuple<VectorType, size_t, double>>;
+
+  /** Create a nearest neighbour search object
    *
-   * @param nPts :: the number of data points
-   * @param nElems :: the number of elements for each point
+   * @param points :: vector of Eigen::Vectors to search through
    */
-  NNDataPoints(const int nPts, const int nElems) : m_nPts(nPts) {
-    m_data = annAllocPts(m_nPts, nElems);
+  NearestNeighbours(const std::vector<VectorType> &points)
+      : m_coords(), m_indices(points.size()), m_nodes() {
+    for (size_t i = 0; i < m_indices.size(); ++i)
+      m_indices[i] = i;
+    if (!points.empty())
+      build(points);
   }
 
-  ~NNDataPoints() { annDeallocPts(m_data); }
+  NearestNeighbours(const NearestNeighbours &) = delete;
+
+  /// @return the number of points in the tree
+  size_t size() const { return m_indices.size(); }
+
+  /** Find the k nearest neighbours to a given point
+   *
+   * @param pos :: the position to find th k nearest neighbours of
+   * @param k :: the number of neighbours to find
+   * @param error :: error term for finding approximate nearest neighbours. if
+   * 	zero then exact neighbours will be found. (default = 0.0).
+   * @return vector neighbours as tuples of (position, index, distance),
+   * nearest first. Fewer than k are returned if the tree holds fewer points.
+   */
+  NearestNeighbourResults findNearest(const VectorType &pos, const size_t k = 1,
+                                      const double error = 0.0) const {
+    const auto numNeighbours = std::min(k, size());
+    Candidates best;
+    if (numNeighbours > 0) {
+      best.reserve(numNeighbours);
+      std::array<double, N> offsets;
+      offsets.fill(0.);
+      const double errorFactor = (1. + error) * (1. + error);
+      searchNearest(0, pos, numNeighbours, errorFactor, offsets, 0., best);
+      std::sort_heap(best.begin(), best.end());
+    }
+    return makeResults(best);
+  }
 
-  /** Return a handle to the raw ANNpointArray wrapped by this class
+  /** Find the k nearest neighbours of each of a set of points. The points are
+   * searched for in parallel.
    *
-   * @return handle to the raw ANNpointArray
+   * @param positions :: the positions to find the k nearest neighbours of
+   * @param k :: the number of neighbours to find
+   * @param error :: error term for finding approximate nearest neighbours.
+   * @return the neighbours of each position, as returned by findNearest
    */
-  ANNpointArray rawData() { return m_data; }
+  std::vector<NearestNeighbourResults>
+  findNearest(const std::vector<VectorType> &positions, const size_t k = 1,
+              const double error = 0.0) const {
+    std::vector<NearestNeighbourResults> results(positions.size());
+    const auto numPositions = static_cast<int64_t>(positions.size());
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < numPositions; ++i) {
+      results[i] = findNearest(positions[i], k, error);
+    }
+    return results;
+  }
 
-  /** Access a raw point in the collection of points
+  /** Find all points within a given distance of a point
    *
-   * This will check the index used is within bounds and return nullptr if
-   * outside of those bounds
+   * @param pos :: the position to find the neighbours of
+   * @param radius :: the largest distance to a neighbour
+   * @return vector neighbours as tuples of (position, index, distance),
+   * nearest first.
+   */
+  NearestNeighbourResults findInRadius(const VectorType &pos,
+                                       const double radius) const {
+    Candidates found;
+    if (!m_nodes.empty() && radius >= 0.)
+      searchRadius(0, pos, radius * radius, found);
+    std::sort(found.begin(), found.end());
+    return makeResults(found);
+  }
+
+  /** Find all points within a given distance of each of a set of points. The
+   * points are searched for in parallel.
    *
-   * @param i :: the index of the point to return a handle to
-   * @return handle to a single point in the collection of points
+   * @param positions :: the positions to find the neighbours of
+   * @param radius :: the largest distance to a neighbour
+   * @return the neighbours of each position, as returned by findInRadius
    */
-  ANNcoord *mutablePoint(const int i) {
-    if (i < m_nPts)
-      return m_data[i];
-    else
-      return nullptr;
+  std::vector<NearestNeighbourResults>
+  findInRadius(const std::vector<VectorType> &positions,
+               const double radius) const {
+    std::vector<NearestNeighbourResults> results(positions.size());
+    const auto numPositions = static_cast<int64_t>(positions.size());
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < numPositions; ++i) {
+      results[i] = findInRadius(positions[i], radius);
+    }
+    return results;
   }
 
 private:
-  /// Number of points stored
-  const int m_nPts;
-  /// Array of points for use with NN search
-  ANNpointArray m_data;
-};
+  /// Candidate neighbours as (squared distance, slot in tree order)
+  using Candidates = std::vector<std::pair<double, size_t>>;
 
-//------------------------------------------------------------------------------
-// NearestNeighbours implementation
-//------------------------------------------------------------------------------
+  /// A node of the tree covering the points in slots [begin, end)
+  struct Node {
+    size_t begin;
+    size_t end;
+    /// Index of the right child, or zero for a leaf. The left child always
+    /// follows its parent.
+    size_t right;
+    /// The dimension the node is split along
+    int dim;
+    /// The coordinate separating the children
+    double split;
+  };
 
-template <int N = 3> class DLLExport NearestNeighbours {
+  /// The most points held by a leaf
+  static constexpr size_t leafSize = 8;
+  /// Subtrees with fewer points than this are built serially
+  static constexpr size_t serialBuildSize = 4096;
 
-public:
-  // typedefs for code brevity
-  using VectorType = Eigen::Matrix<double, N, 1>;
-  using NearestNeighbourResults =
-      std::vector<std::tuple<VectorType, size_t, double>>;
+  /// @return the number of nodes in a subtree holding the given number of
+  /// points
+  static size_t nodeCount(const size_t numPoints) {
+    if (numPoints <= leafSize)
+      return 1;
+    const auto left = numPoints / 2;
+    return 1 + nodeCount(left) + nodeCount(numPoints - left);
+  }
 
-  /** Create a nearest neighbour search object
+  /** Build the tree. The split of every node is known from the number of
+   * points it holds so each subtree is written to its own range of nodes and
+   * subtrees can be built independently of each other.
    *
-   * @param points :: vector of Eigen::Vectors to search through
+   * @param points :: the points to build the tree over
    */
-  NearestNeighbours(const std::vector<VectorType> &points) {
-    const auto numPoints = static_cast<int>(points.size());
-    if (numPoints == 0)
-      std::runtime_error(
-          "Need at least one point to initialise NearestNeighbours.");
+  void build(const std::vector<VectorType> &points) {
+    m_nodes.resize(nodeCount(points.size()));
+    // Split the top of the tree serially until there is enough work to share
+    // between threads
+    std::vector<std::array<size_t, 3>> subtrees{{{0, 0, points.size()}}};
+    const auto minSubtrees =
+        static_cast<size_t>(4 * std::max(PARALLEL_GET_MAX_THREADS, 1));
+    while (subtrees.size() < minSubtrees) {
+      std::vector<std::array<size_t, 3>> next;
+      bool split = false;
+      for (const auto &subtree : subtrees) {
+        if (subtree[2] - subtree[1] < serialBuildSize) {
+          next.push_back(subtree);
+          continue;
+        }
+        const auto mid = splitNode(subtree[0], subtree[1], subtree[2], points);
+        const auto &node = m_nodes[subtree[0]];
+        next.push_back({{subtree[0] + 1, subtree[1], mid}});
+        next.push_back({{node.right, mid, subtree[2]}});
+        split = true;
+      }
+      subtrees.swap(next);
+      if (!split)
+        break;
+    }
 
-    m_dataPoints = make_unique<NNDataPoints>(numPoints, static_cast<int>(N));
+    const auto numSubtrees = static_cast<int64_t>(subtrees.size());
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < numSubtrees; ++i) {
+      const auto &subtree = subtrees[i];
+      buildSubtree(subtree[0], subtree[1], subtree[2], points);
+    }
 
-    for (size_t i = 0; i < points.size(); ++i) {
-      Eigen::Map<VectorType>(m_dataPoints->mutablePoint(static_cast<int>(i)), N,
-                             1) = points[i];
+    // Store the coordinates in tree order so that leaves are contiguous
+    m_coords.resize(N * points.size());
+    for (size_t slot = 0; slot < m_indices.size(); ++slot) {
+      Eigen::Map<VectorType>(&m_coords[N * slot], N, 1) =
+          points[m_indices[slot]];
     }
-    m_kdTree = make_unique<ANNkd_tree>(m_dataPoints->rawData(), numPoints,
-                                       static_cast<int>(N));
   }
 
-  ~NearestNeighbours() { annClose(); }
-
-  NearestNeighbours(const NearestNeighbours &) = delete;
+  /// Build the subtree rooted at a node serially
+  void buildSubtree(const size_t nodeIndex, const size_t begin,
+                    const size_t end, const std::vector<VectorType> &points) {
+    if (end - begin <= leafSize) {
+      m_nodes[nodeIndex] = Node{begin, end, 0, 0, 0.};
+      return;
+    }
+    const auto mid = splitNode(nodeIndex, begin, end, points);
+    buildSubtree(nodeIndex + 1, begin, mid, points);
+    buildSubtree(m_nodes[nodeIndex].right, mid, end, points);
+  }
 
-  /** Find the k nearest neighbours to a given point
+  /** Split the points of an inner node at the median of its widest dimension
    *
-   * This is a thin wrapper around the ANN library annkSearch method
+   * @param nodeIndex :: the index of the node
+   * @param begin :: the first slot of the node's points
+   * @param end :: one past the last slot of the node's points
+   * @param points :: the points the tree is built over
+   * @return the first slot of the right child
+   */
+  size_t splitNode(const size_t nodeIndex, const size_t begin,
+                   const size_t end, const std::vector<VectorType> &points) {
+    VectorType lower = points[m_indices[begin]];
+    VectorType upper = lower;
+    for (auto slot = begin + 1; slot < end; ++slot) {
+      lower = lower.cwiseMin(points[m_indices[slot]]);
+      upper = upper.cwiseMax(points[m_indices[slot]]);
+    }
+    int dim;
+    (upper - lower).maxCoeff(&dim);
+
+    const auto mid = begin + (end - begin) / 2;
+    const auto first = m_indices.begin();
+    std::nth_element(first + begin, first + mid, first + end,
+                     [&points, dim](const size_t a, const size_t b) {
+                       return points[a][dim] < points[b][dim];
+                     });
+    m_nodes[nodeIndex] = Node{begin, end, nodeIndex + 1 + nodeCount(mid - begin),
+                              dim, points[m_indices[mid]][dim]};
+    return mid;
+  }
+
+  /// @return the squared distance between a position and the point in a slot
+  double distanceSquared(const VectorType &pos, const size_t slot) const {
+    return (Eigen::Map<const VectorType>(&m_coords[N * slot], N, 1) - pos)
+        .squaredNorm();
+  }
+
+  /** Find the k nearest neighbours in a subtree. Uses incremental distance
+   * calculation: the lower bound on the distance to a node is kept up to date
+   * from the offset of the position from the node's cell along each dimension.
    *
-   * @param pos :: the position to find th k nearest neighbours of
+   * @param nodeIndex :: the root of the subtree
+   * @param pos :: the position to find the neighbours of
    * @param k :: the number of neighbours to find
-   * @param error :: error term for finding approximate nearest neighbours. if
-   * 	zero then exact neighbours will be found. (default = 0.0).
-   * @return vector neighbours as tuples of (position, index, distance)
+   * @param errorFactor :: the factor a cell must be closer by to be visited
+   * @param offsets :: offset from the current cell along each dimension
+   * @param cellDistance :: lower bound on the squared distance to the cell
+   * @param best :: max-heap of the nearest candidates found so far
    */
-  NearestNeighbourResults findNearest(const VectorType &pos, const size_t k = 1,
-                                      const double error = 0.0) {
-    const auto numNeighbours = static_cast<int>(k);
-    // create arrays to store the indices & distances of nearest neighbours
-    auto nnIndexList = std::unique_ptr<ANNidx[]>(new ANNidx[numNeighbours]);
-    auto nnDistList = std::unique_ptr<ANNdist[]>(new ANNdist[numNeighbours]);
+  void searchNearest(const size_t nodeIndex, const VectorType &pos,
+                     const size_t k, const double errorFactor,
+                     std::array<double, N> &offsets, const double cellDistance,
+                     Candidates &best) const {
+    const auto &node = m_nodes[nodeIndex];
+    if (node.right == 0) {
+      for (auto slot = node.begin; slot < node.end; ++slot) {
+        const auto distance = distanceSquared(pos, slot);
+        if (best.size() < k) {
+          best.emplace_back(distance, slot);
+          std::push_heap(best.begin(), best.end());
+        } else if (distance < best.front().first) {
+          std::pop_heap(best.begin(), best.end());
+          best.back() = std::make_pair(distance, slot);
+          std::push_heap(best.begin(), best.end());
+        }
+      }
+      return;
+    }
 
-    // create ANNpoint from Eigen array
-    auto point = std::unique_ptr<ANNcoord[]>(annAllocPt(N));
-    Eigen::Map<VectorType>(point.get(), N, 1) = pos;
+    const auto diff = pos[node.dim] - node.split;
+    const auto nearChild = diff < 0. ? nodeIndex + 1 : node.right;
+    const auto farChild = diff < 0. ? node.right : nodeIndex + 1;
+    searchNearest(nearChild, pos, k, errorFactor, offsets, cellDistance, best);
 
-    // find the k nearest neighbours
-    m_kdTree->annkSearch(point.get(), numNeighbours, nnIndexList.get(),
-                         nnDistList.get(), error);
+    const auto oldOffset = offsets[node.dim];
+    const auto farDistance = cellDistance - oldOffset * oldOffset + diff * diff;
+    if (best.size() < k || farDistance * errorFactor < best.front().first) {
+      offsets[node.dim] = diff;
+      searchNearest(farChild, pos, k, errorFactor, offsets, farDistance, best);
+      offsets[node.dim] = oldOffset;
+    }
+  }
 
-    return makeResults(k, std::move(nnIndexList), std::move(nnDistList));
+  /// Collect the points of a subtree within a squared distance of a position
+  void searchRadius(const size_t nodeIndex, const VectorType &pos,
+                    const double radiusSquared, Candidates &found) const {
+    const auto &node = m_nodes[nodeIndex];
+    if (node.right == 0) {
+      for (auto slot = node.begin; slot < node.end; ++slot) {
+        const auto distance = distanceSquared(pos, slot);
+        if (distance <= radiusSquared)
+          found.emplace_back(distance, slot);
+      }
+      return;
+    }
+    const auto diff = pos[node.dim] - node.split;
+    if (diff < 0. || diff * diff <= radiusSquared)
+      searchRadius(nodeIndex + 1, pos, radiusSquared, found);
+    if (diff >= 0. || diff * diff <= radiusSquared)
+      searchRadius(node.right, pos, radiusSquared, found);
   }
 
-private:
   /** Helper function to create a instance of NearestNeighbourResults
    *
-   * @param k :: the number of neighbours searched for
-   * @param nnIndexList :: the ordered list of indicies matching the closest k
-   *neighbours
-   * @param nnDistList :: the ordered list of distances matching the closest k
-   *neighbours
+   * @param candidates :: the neighbours found as (distance, slot) pairs,
+   * nearest first
    * @return a new NearestNeighbourResults object from the found items
    */
-  NearestNeighbourResults
-  makeResults(const size_t k, const std::unique_ptr<ANNidx[]> nnIndexList,
-              const std::unique_ptr<ANNdist[]> nnDistList) {
+  NearestNeighbourResults makeResults(const Candidates &candidates) const {
     NearestNeighbourResults results;
-    results.reserve(k);
-
-    for (size_t i = 0; i < k; ++i) {
-      // create Eigen array from ANNpoint
-      auto pos = m_dataPoints->mutablePoint(nnIndexList[i]);
-      VectorType point = Eigen::Map<VectorType>(pos, N, 1);
-      results.emplace_back(point, nnIndexList[i], nnDistList[i]);
+    results.reserve(candidates.size());
+    for (const auto &candidate : candidates) {
+      const auto slot = candidate.second;
+      VectorType point = Eigen::Map<const VectorType>(&m_coords[N * slot], N, 1);
+      results.emplace_back(point, m_indices[slot], candidate.first);
     }
-
     return results;
   }
 
-  /// handle to the list of data points to search through
-  std::unique_ptr<NNDataPoints> m_dataPoints;
-  /// handle to the ANN KD-tree used for searching
-  std::unique_ptr<ANNkd_tree> m_kdTree;
+  /// Coordinates of the points in tree order
+  std::vector<double> m_coords;
+  /// Index in the original points of the point in each slot
+  std::vector<size_t> m_indices;
+  /// The nodes of the tree, depth first
+  std::vector<Node> m_nodes;
 };
 } // namespace Kernel
 } // namespace Mantid
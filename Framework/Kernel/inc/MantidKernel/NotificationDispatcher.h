@@ -0,0 +1,79 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_KERNEL_NOTIFICATIONDISPATCHER_H_
+#define MANTID_KERNEL_NOTIFICATIONDISPATCHER_H_
+
+#include "MantidKernel/DllConfig.h"
+
+#include <Poco/AutoPtr.h>
+#include <Poco/Notification.h>
+#include <Poco/NotificationCenter.h>
+
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace Mantid {
+namespace Kernel {
+
+/** NotificationDispatcher delivers notifications to the observers of a
+  Poco::NotificationCenter from a dedicated thread so that the code posting
+  them does not wait for the observers.
+
+  Notifications are delivered in the order they were queued. A notification
+  may be queued with a coalescing key: if a notification with the same key is
+  still waiting to be delivered it is discarded and the new one is queued at
+  the end, after any notification posted in between. This collapses bursts of notifications that observers
+  only need to see once, e.g. repeated replacements of the same object.
+*/
+class MANTID_KERNEL_DLL NotificationDispatcher {
+public:
+  NotificationDispatcher(Poco::NotificationCenter &center);
+  ~NotificationDispatcher();
+  NotificationDispatcher(const NotificationDispatcher &) = delete;
+  NotificationDispatcher &operator=(const NotificationDispatcher &) = delete;
+
+  void enqueue(Poco::Notification *notification,
+               const std::string &coalesceKey = "");
+  void flush();
+  void stop();
+  size_t pending() const;
+
+private:
+  /// A queued notification and its coalescing key
+  struct Item {
+    Poco::AutoPtr<Poco::Notification> notification;
+    std::string key;
+  };
+  void run();
+
+  /// The center whose observers receive the notifications
+  Poco::NotificationCenter &m_center;
+  /// Notifications waiting to be delivered
+  std::list<Item> m_queue;
+  /// Queued items that carry a coalescing key
+  std::unordered_map<std::string, std::list<Item>::iterator> m_keyed;
+  /// Number of notifications taken from the queue but not yet delivered
+  size_t m_inFlight;
+  /// True when the dispatcher thread should exit
+  bool m_stopping;
+  mutable std::mutex m_mutex;
+  /// Signalled when items are queued or the dispatcher is stopped
+  std::condition_variable m_wakeUp;
+  /// Signalled when the queue has been drained
+  std::condition_variable m_drained;
+  /// The dispatcher thread, started with the first notification
+  std::thread m_thread;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_NOTIFICATIONDISPATCHER_H_ */
@@ -29,6 +29,10 @@ class Property;
 
     This class stores information about the parameters used by an algorithm.
 
+    The name, value and type strings are interned: histories holding equal
+    strings share a single copy of them, which keeps the many histories of
+    a long processing chain, mostly repeating the same values, small.
+
     @author Dickon Champion, ISIS, RAL
     @date 21/01/2008
 */
@@ -43,13 +47,13 @@ public:
   /// destructor
   virtual ~PropertyHistory() = default;
   /// get name of algorithm parameter const
-  const std::string &name() const { return m_name; };
+  const std::string &name() const { return *m_name; };
   /// get value of algorithm parameter const
-  const std::string &value() const { return m_value; };
+  const std::string &value() const { return *m_value; };
   /// set value of algorithm parameter
-  void setValue(const std::string &value) { m_value = value; };
+  void setValue(const std::string &value);
   /// get type of algorithm parameter const
-  const std::string &type() const { return m_type; };
+  const std::string &type() const { return *m_type; };
   /// get isdefault flag of algorithm parameter const
   bool isDefault() const { return m_isDefault; };
   /// get direction flag of algorithm parameter const
@@ -69,11 +73,11 @@ public:
 
 private:
   /// The name of the parameter
-  std::string m_name;
+  boost::shared_ptr<const std::string> m_name;
   /// The value of the parameter
-  std::string m_value;
+  boost::shared_ptr<const std::string> m_value;
   /// The type of the parameter
-  std::string m_type;
+  boost::shared_ptr<const std::string> m_type;
   /// flag defining if the parameter is a default or a user-defined parameter
   bool m_isDefault;
   /// direction of parameter
@@ -46,6 +46,40 @@ void MANTID_KERNEL_DLL rebinHistogram(const std::vector<double> &xold,
                                       std::vector<double> &ynew,
                                       std::vector<double> &enew, bool addition);
 
+/** Precomputed bin overlap weights for rebinning from one set of bin
+ * boundaries to another. Spectra that share their old and new X can be
+ * rebinned with the same weights, so the overlaps are found only once and
+ * rebinning each spectrum is reduced to a short weighted sum per new bin.
+ * Results are the same as from rebin without addition.
+ */
+class MANTID_KERNEL_DLL RebinWeights {
+public:
+  RebinWeights(const std::vector<double> &xold, const std::vector<double> &xnew,
+               bool distribution);
+
+  void apply(const std::vector<double> &yold, const std::vector<double> &eold,
+             std::vector<double> &ynew, std::vector<double> &enew) const;
+  void apply(const double *yold, const double *eold, double *ynew,
+             double *enew) const;
+
+  /// @return The number of old bins the weights apply to
+  size_t oldSize() const { return m_oldSize; }
+  /// @return The number of new bins the weights produce
+  size_t newSize() const { return m_first.size(); }
+
+private:
+  /// Number of old bins
+  size_t m_oldSize;
+  /// The first old bin overlapping each new bin
+  std::vector<size_t> m_first;
+  /// The weights of new bin i are at [m_offsets[i], m_offsets[i+1])
+  std::vector<size_t> m_offsets;
+  /// Weight of each overlapping old value
+  std::vector<double> m_yWeights;
+  /// Weight of each overlapping old squared error
+  std::vector<double> m_eWeights;
+};
+
 /// Convert an array of bin boundaries to bin center values.
 void MANTID_KERNEL_DLL convertToBinCentre(const std::vector<double> &bin_edges,
                                           std::vector<double> &bin_centres);
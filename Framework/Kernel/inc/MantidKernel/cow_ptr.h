@@ -12,6 +12,7 @@
 #ifndef Q_MOC_RUN
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
 #endif
 
 #include <mutex>
@@ -81,6 +82,10 @@ public:
   /// object, i.e. whether use_count() == 1.
   bool unique() const noexcept { return Data.unique(); }
 
+  /// Returns a weak reference to the managed object. It does not count as an
+  /// owner, so a later access() does not copy because of it.
+  boost::weak_ptr<const DataType> weak() const noexcept { return Data; }
+
   const DataType &operator*() const {
     return *Data;
   } ///< Pointer dereference access
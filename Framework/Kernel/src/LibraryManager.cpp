@@ -40,6 +40,7 @@ int LibraryManagerImpl::openLibraries(
     const std::string &filepath, LoadLibraries loadingBehaviour,
     const std::vector<std::string> &excludes) {
   g_log.debug("Opening all libraries in " + filepath + "\n");
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
   try {
     return openLibraries(Poco::File(filepath), loadingBehaviour, excludes);
   } catch (std::exception &exc) {
@@ -52,6 +53,44 @@ int LibraryManagerImpl::openLibraries(
   }
 }
 
+/**
+ * Find the libraries on a given path that openLibraries would open, without
+ * opening them.
+ *  @param filepath The filepath to the directory where the libraries are.
+ *  @param loadingBehaviour Control how libraries are searched for
+ *  @param excludes If not empty then each string is considered as a substring
+ * to search within each library name. If the substring is found then the
+ * library is skipped.
+ *  @return The full paths of the libraries that are not already open.
+ */
+std::vector<std::string> LibraryManagerImpl::findLibraries(
+    const std::string &filepath, LoadLibraries loadingBehaviour,
+    const std::vector<std::string> &excludes) const {
+  std::vector<std::string> libraries;
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  try {
+    findLibraries(Poco::File(filepath), loadingBehaviour, excludes, libraries);
+  } catch (std::exception &exc) {
+    g_log.debug() << "Error occurred while finding libraries: " << exc.what()
+                  << "\n";
+  }
+  return libraries;
+}
+
+/**
+ * Open a single library. Nothing is done if a library with the same file name
+ * is already open.
+ *  @param filepath The full path to the library
+ *  @return True if the library is open
+ */
+bool LibraryManagerImpl::openLibrary(const std::string &filepath) {
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  const Poco::Path path(filepath);
+  if (isLoaded(path.getFileName()))
+    return true;
+  return openLibrary(Poco::File(path), path.getFileName()) == 1;
+}
+
 //-------------------------------------------------------------------------
 // Private members
 //-------------------------------------------------------------------------
@@ -92,6 +131,36 @@ int LibraryManagerImpl::openLibraries(
   return libCount;
 }
 
+/**
+ * Find suitable DLLs on a given path.
+ *  @param libpath A Poco::File object pointing to a directory where the
+ * libraries are.
+ *  @param loadingBehaviour Control how libraries are searched for
+ *  @param excludes Substrings of library names to skip
+ *  @param libraries Full paths of the libraries found are appended here
+ */
+void LibraryManagerImpl::findLibraries(
+    const Poco::File &libpath,
+    LibraryManagerImpl::LoadLibraries loadingBehaviour,
+    const std::vector<std::string> &excludes,
+    std::vector<std::string> &libraries) const {
+  if (!libpath.exists() || !libpath.isDirectory()) {
+    g_log.error("In findLibraries: " + libpath.path() +
+                " must be a directory.");
+    return;
+  }
+  Poco::DirectoryIterator end_itr;
+  for (Poco::DirectoryIterator itr(libpath); itr != end_itr; ++itr) {
+    const Poco::File &item = *itr;
+    if (item.isFile()) {
+      if (shouldBeLoaded(itr.path().getFileName(), excludes))
+        libraries.emplace_back(itr.path().toString());
+    } else if (loadingBehaviour == LoadLibraries::Recursive) {
+      findLibraries(item, LoadLibraries::Recursive, excludes, libraries);
+    }
+  }
+}
+
 /**
  * Check if the library should be loaded
  * @param filename The filename of the library, i.e no directory
@@ -0,0 +1,51 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/LogMessageBuffer.h"
+
+#include <Poco/Logger.h>
+
+namespace Mantid {
+namespace Kernel {
+namespace {
+/// The buffer capturing the messages of this thread, if any
+thread_local LogMessageBuffer *CAPTURING = nullptr;
+} // namespace
+
+/**
+ * @param buffer :: The buffer to store the messages of this thread in
+ */
+LogMessageBuffer::Capture::Capture(LogMessageBuffer &buffer)
+    : m_previous(CAPTURING) {
+  CAPTURING = &buffer;
+}
+
+/// Restores whatever was capturing before
+LogMessageBuffer::Capture::~Capture() { CAPTURING = m_previous; }
+
+void LogMessageBuffer::flush() {
+  for (const auto &message : m_messages)
+    message.first->log(message.second);
+  m_messages.clear();
+}
+
+/**
+ * @param logger :: The logger publishing the message
+ * @param message :: The message
+ * @return True if the message was stored or dropped by the logger's level
+ * while capturing, false if it should be published now
+ */
+bool LogMessageBuffer::hold(Poco::Logger &logger,
+                            const Poco::Message &message) {
+  if (!CAPTURING)
+    return false;
+  if (logger.is(message.getPriority()))
+    CAPTURING->m_messages.emplace_back(&logger, message);
+  return true;
+}
+
+} // namespace Kernel
+} // namespace Mantid
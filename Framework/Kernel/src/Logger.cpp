@@ -6,6 +6,7 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidKernel/Logger.h"
 
+#include "MantidKernel/LogMessageBuffer.h"
 #include "MantidKernel/ThreadSafeLogStream.h"
 
 #include <Poco/Logger.h>
@@ -295,7 +296,11 @@ void Logger::log(const std::string &message, Logger::Priority priority) {
     return;
 
   try {
-    switch (applyLevelOffset(priority)) {
+    const auto level = applyLevelOffset(priority);
+    if (LogMessageBuffer::hold(
+            *m_log, Poco::Message(m_log->name(), message, level)))
+      return;
+    switch (level) {
     case Poco::Message::PRIO_FATAL:
       m_log->fatal(message);
       break;
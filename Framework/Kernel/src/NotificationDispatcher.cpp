@@ -0,0 +1,126 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/NotificationDispatcher.h"
+#include "MantidKernel/Logger.h"
+
+#include <ostream>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Logger
+Logger g_log("NotificationDispatcher");
+} // namespace
+
+/**
+ * Constructor. The dispatcher thread is only started when the first
+ * notification is queued.
+ * @param center :: The notification center to deliver notifications through
+ */
+NotificationDispatcher::NotificationDispatcher(Poco::NotificationCenter &center)
+    : m_center(center), m_queue(), m_keyed(), m_inFlight(0),
+      m_stopping(false) {}
+
+/// Destructor. Delivers any pending notifications and stops the thread.
+NotificationDispatcher::~NotificationDispatcher() { stop(); }
+
+/**
+ * Queue a notification for delivery. Ownership of the notification is taken
+ * as for Poco::NotificationCenter::postNotification.
+ * @param notification :: The notification to deliver
+ * @param coalesceKey :: If not empty, a pending notification queued with the
+ * same key is discarded
+ */
+void NotificationDispatcher::enqueue(Poco::Notification *notification,
+                                     const std::string &coalesceKey) {
+  Poco::AutoPtr<Poco::Notification> owned(notification);
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (m_stopping) {
+    // Deliver directly once stopped rather than losing the notification
+    lock.unlock();
+    m_center.postNotification(owned);
+    return;
+  }
+  if (!coalesceKey.empty()) {
+    // The pending notification is dropped and the new one queued behind
+    // everything posted since, so observers never see it out of order
+    auto pending = m_keyed.find(coalesceKey);
+    if (pending != m_keyed.end()) {
+      m_queue.erase(pending->second);
+      m_keyed.erase(pending);
+    }
+  }
+  m_queue.push_back(Item{owned, coalesceKey});
+  if (!coalesceKey.empty())
+    m_keyed.emplace(coalesceKey, std::prev(m_queue.end()));
+  if (!m_thread.joinable())
+    m_thread = std::thread(&NotificationDispatcher::run, this);
+  m_wakeUp.notify_one();
+}
+
+/**
+ * Block until all notifications queued so far have been delivered. Returns
+ * immediately if called from an observer on the dispatcher thread.
+ */
+void NotificationDispatcher::flush() {
+  if (std::this_thread::get_id() == m_thread.get_id())
+    return;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_drained.wait(lock, [this] { return m_queue.empty() && m_inFlight == 0; });
+}
+
+/**
+ * Deliver any pending notifications and stop the dispatcher thread. Later
+ * notifications are delivered synchronously.
+ */
+void NotificationDispatcher::stop() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+    m_wakeUp.notify_one();
+  }
+  if (m_thread.joinable() && std::this_thread::get_id() != m_thread.get_id())
+    m_thread.join();
+}
+
+/// @return The number of notifications waiting to be delivered
+size_t NotificationDispatcher::pending() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_queue.size() + m_inFlight;
+}
+
+/// The loop run by the dispatcher thread
+void NotificationDispatcher::run() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_wakeUp.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+    if (m_queue.empty()) // only when stopping
+      break;
+    auto item = std::move(m_queue.front());
+    m_queue.pop_front();
+    if (!item.key.empty())
+      m_keyed.erase(item.key);
+    ++m_inFlight;
+    lock.unlock();
+    try {
+      m_center.postNotification(item.notification);
+    } catch (std::exception &exc) {
+      g_log.error() << "Observer failed handling notification '"
+                    << item.notification->name() << "': " << exc.what()
+                    << '\n';
+    }
+    lock.lock();
+    --m_inFlight;
+    if (m_queue.empty() && m_inFlight == 0)
+      m_drained.notify_all();
+  }
+  m_drained.notify_all();
+}
+
+} // namespace Kernel
+} // namespace Mantid
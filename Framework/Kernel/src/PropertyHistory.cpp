@@ -13,26 +13,150 @@
 #include "MantidKernel/Strings.h"
 
 #include <algorithm>
+#include <array>
+#include <boost/functional/hash.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/weak_ptr.hpp>
 #include <cstdint>
+#include <mutex>
 #include <ostream>
+#include <unordered_map>
 
 namespace Mantid {
 namespace Kernel {
+namespace {
+/// The characters of a pooled string, used as its key in the pool
+struct StringKey {
+  const char *data;
+  size_t size;
+  bool operator==(const StringKey &other) const {
+    return size == other.size && std::equal(data, data + size, other.data);
+  }
+};
+
+struct StringKeyHasher {
+  size_t operator()(const StringKey &key) const {
+    return boost::hash_range(key.data, key.data + key.size);
+  }
+};
+
+/**
+ * A pool of the strings held by the histories. Each string is shared by
+ * all the histories holding it and leaves the pool with its last holder.
+ * The pool is split into shards by hash, each with its own lock, and the
+ * locks are held only to look up, add and remove entries. Hashing and
+ * copying the strings happen outside them.
+ */
+class StringPool {
+public:
+  boost::shared_ptr<const std::string> intern(const std::string &value) {
+    const StringKey key{value.data(), value.size()};
+    const size_t hash = StringKeyHasher()(key);
+    auto &shard = m_shards[hash % NUMBER_OF_SHARDS];
+    if (auto pooled = shard.find(key, hash))
+      return pooled;
+    auto *copy = new std::string(value);
+    boost::shared_ptr<const std::string> pooled(
+        copy, [&shard, hash](const std::string *str) {
+          shard.release(str, hash);
+        });
+    // Another thread may have added the same string in the meantime
+    return shard.add(pooled, hash);
+  }
+
+private:
+  /// Hashes are computed once, outside the locks
+  struct PrecomputedHash {
+    size_t operator()(const std::pair<StringKey, size_t> &key) const {
+      return key.second;
+    }
+  };
+  struct KeyEqual {
+    bool operator()(const std::pair<StringKey, size_t> &lhs,
+                    const std::pair<StringKey, size_t> &rhs) const {
+      return lhs.second == rhs.second && lhs.first == rhs.first;
+    }
+  };
+
+  class Shard {
+  public:
+    boost::shared_ptr<const std::string> find(const StringKey &key,
+                                              size_t hash) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      const auto entry = m_strings.find(std::make_pair(key, hash));
+      if (entry == m_strings.end())
+        return nullptr;
+      // Empty if the last holder has yet to remove the entry
+      return entry->second.lock();
+    }
+
+    boost::shared_ptr<const std::string>
+    add(const boost::shared_ptr<const std::string> &pooled, size_t hash) {
+      const auto key =
+          std::make_pair(StringKey{pooled->data(), pooled->size()}, hash);
+      std::lock_guard<std::mutex> lock(m_mutex);
+      const auto entry = m_strings.find(key);
+      if (entry != m_strings.end()) {
+        if (auto existing = entry->second.lock())
+          return existing;
+        m_strings.erase(entry);
+      }
+      m_strings.emplace(key, pooled);
+      return pooled;
+    }
+
+    void release(const std::string *str, size_t hash) {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto entry = m_strings.find(
+            std::make_pair(StringKey{str->data(), str->size()}, hash));
+        // The entry may belong to another copy of the same string
+        if (entry != m_strings.end() && entry->first.first.data == str->data())
+          m_strings.erase(entry);
+      }
+      delete str;
+    }
+
+  private:
+    std::mutex m_mutex;
+    std::unordered_map<std::pair<StringKey, size_t>,
+                       boost::weak_ptr<const std::string>, PrecomputedHash,
+                       KeyEqual>
+        m_strings;
+  };
+
+  static constexpr size_t NUMBER_OF_SHARDS = 64;
+  std::array<Shard, NUMBER_OF_SHARDS> m_shards;
+};
+
+boost::shared_ptr<const std::string> intern(const std::string &value) {
+  // Never destroyed so that histories outliving static destruction are safe
+  static auto *pool = new StringPool;
+  return pool->intern(value);
+}
+} // namespace
 
 /// Constructor
 PropertyHistory::PropertyHistory(const std::string &name,
                                  const std::string &value,
                                  const std::string &type, const bool isdefault,
                                  const unsigned int direction)
-    : m_name(name), m_value(value), m_type(type), m_isDefault(isdefault),
-      m_direction(direction) {}
+    : m_name(intern(name)), m_value(intern(value)), m_type(intern(type)),
+      m_isDefault(isdefault), m_direction(direction) {}
 
 PropertyHistory::PropertyHistory(Property const *const prop)
-    : m_name(prop->name()), m_value(prop->valueAsPrettyStr(0, true)),
-      m_type(prop->type()), m_isDefault(prop->isDefault()),
+    : m_name(intern(prop->name())),
+      m_value(intern(prop->valueAsPrettyStr(0, true))),
+      m_type(intern(prop->type())), m_isDefault(prop->isDefault()),
       m_direction(prop->direction()) {}
 
+/** Set the value of the parameter
+ *  @param value :: The new value
+ */
+void PropertyHistory::setValue(const std::string &value) {
+  m_value = intern(value);
+}
+
 /** Prints a text representation of itself
  *  @param os :: The output stream to write to
  *  @param indent :: an indentation value to make pretty printing of object and
@@ -42,11 +166,11 @@ PropertyHistory::PropertyHistory(Property const *const prop)
  */
 void PropertyHistory::printSelf(std::ostream &os, const int indent,
                                 const size_t maxPropertyLength) const {
-  os << std::string(indent, ' ') << "Name: " << m_name;
-  if ((maxPropertyLength > 0) && (m_value.size() > maxPropertyLength)) {
-    os << ", Value: " << Strings::shorten(m_value, maxPropertyLength);
+  os << std::string(indent, ' ') << "Name: " << name();
+  if ((maxPropertyLength > 0) && (value().size() > maxPropertyLength)) {
+    os << ", Value: " << Strings::shorten(value(), maxPropertyLength);
   } else {
-    os << ", Value: " << m_value;
+    os << ", Value: " << value();
   }
   os << ", Default?: " << (m_isDefault ? "Yes" : "No");
   os << ", Direction: " << Kernel::Direction::asText(m_direction) << '\n';
@@ -85,9 +209,9 @@ bool PropertyHistory::isEmptyDefault() const {
 
   // If default, input, number type and matches empty value then return true
   if (m_isDefault && m_direction != Direction::Output) {
-    if (std::find(numberTypes.begin(), numberTypes.end(), m_type) !=
+    if (std::find(numberTypes.begin(), numberTypes.end(), type()) !=
         numberTypes.end()) {
-      if (std::find(emptyValues.begin(), emptyValues.end(), m_value) !=
+      if (std::find(emptyValues.begin(), emptyValues.end(), value()) !=
           emptyValues.end()) {
         emptyDefault = true;
       }
@@ -8,6 +8,7 @@
 // Includes
 //-----------------------------------------------
 #include "MantidKernel/ThreadSafeLogStream.h"
+#include "MantidKernel/LogMessageBuffer.h"
 
 #include <Poco/Logger.h>
 #include <Poco/StreamUtil.h>
@@ -42,7 +43,8 @@ int ThreadSafeLogStreamBuf::writeToDevice(char c) {
     Poco::Message msg(logger().name(), m_messages[Poco::Thread::currentTid()],
                       getPriority());
     m_messages[Poco::Thread::currentTid()] = "";
-    logger().log(msg);
+    if (!LogMessageBuffer::hold(logger(), msg))
+      logger().log(msg);
   } else {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_messages[Poco::Thread::currentTid()] += c;
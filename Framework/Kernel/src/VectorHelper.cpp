@@ -349,6 +349,106 @@ void rebinHistogram(const std::vector<double> &xold,
   }
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Compute the overlap weights for rebinning between two sets of bin
+ *boundaries.
+ *  @param[in] xold Old X array of data.
+ *  @param[in] xnew X array of data to rebin to.
+ *  @param[in] distribution Flag defining if distribution data (true) or not
+ *(false).
+ *  @throw invalid_argument Thrown if either X array contains a bin of zero or
+ *negative width.
+ **/
+RebinWeights::RebinWeights(const std::vector<double> &xold,
+                           const std::vector<double> &xnew,
+                           bool distribution)
+    : m_oldSize(xold.empty() ? 0 : xold.size() - 1),
+      m_first(xnew.empty() ? 0 : xnew.size() - 1, 0), m_offsets(1, 0) {
+  const auto hasPositiveWidths = [](const std::vector<double> &x) {
+    return std::adjacent_find(x.cbegin(), x.cend(),
+                              [](double low, double high) {
+                                return !(high > low);
+                              }) == x.cend();
+  };
+  if (!hasPositiveWidths(xold) || !hasPositiveWidths(xnew))
+    throw std::invalid_argument(
+        "RebinWeights: bin widths must be positive in both X arrays");
+
+  const size_t size_ynew = m_first.size();
+  m_offsets.reserve(size_ynew + 1);
+  size_t iold = 0;
+  for (size_t inew = 0; inew < size_ynew; ++inew) {
+    const double xn_low = xnew[inew];
+    const double xn_high = xnew[inew + 1];
+    const double nwidth = xn_high - xn_low;
+    // Skip old bins that end before this new bin starts
+    while (iold < m_oldSize && xold[iold + 1] <= xn_low)
+      ++iold;
+    m_first[inew] = iold;
+    for (auto i = iold; i < m_oldSize && xold[i] < xn_high; ++i) {
+      const double xo_low = xold[i];
+      const double xo_high = xold[i + 1];
+      const double owidth = xo_high - xo_low;
+      const double delta =
+          std::min(xo_high, xn_high) - std::max(xo_low, xn_low);
+      if (distribution) {
+        m_yWeights.push_back(delta / nwidth);
+        m_eWeights.push_back(delta * owidth / (nwidth * nwidth));
+      } else {
+        m_yWeights.push_back(delta / owidth);
+        m_eWeights.push_back(delta / owidth);
+      }
+    }
+    m_offsets.push_back(m_yWeights.size());
+  }
+}
+
+/** Rebin one spectrum with the weights.
+ *  @param[in] yold Old Y array of data.
+ *  @param[in] eold Old error array of data. Must be same length as yold.
+ *  @param[out] ynew Rebinned data.
+ *  @param[out] enew Rebinned errors. Must be same length as ynew.
+ *  @throw runtime_error Thrown if vector sizes do not match the weights
+ **/
+void RebinWeights::apply(const std::vector<double> &yold,
+                         const std::vector<double> &eold,
+                         std::vector<double> &ynew,
+                         std::vector<double> &enew) const {
+  if (yold.size() != m_oldSize || eold.size() != m_oldSize)
+    throw std::runtime_error("RebinWeights: old y and error vectors do not "
+                             "match the old X");
+  if (ynew.size() != newSize() || enew.size() != newSize())
+    throw std::runtime_error("RebinWeights: new y and error vectors do not "
+                             "match the new X");
+  apply(yold.data(), eold.data(), ynew.data(), enew.data());
+}
+
+/** Rebin one spectrum with the weights. The arrays are not checked.
+ *  @param[in] yold Old Y array of oldSize() values.
+ *  @param[in] eold Old error array of oldSize() values.
+ *  @param[out] ynew Rebinned data, newSize() values.
+ *  @param[out] enew Rebinned errors, newSize() values.
+ **/
+void RebinWeights::apply(const double *yold, const double *eold, double *ynew,
+                         double *enew) const {
+  const size_t size_ynew = m_first.size();
+  const double *yWeights = m_yWeights.data();
+  const double *eWeights = m_eWeights.data();
+  for (size_t inew = 0; inew < size_ynew; ++inew) {
+    const size_t begin = m_offsets[inew];
+    const size_t count = m_offsets[inew + 1] - begin;
+    const double *y = yold + m_first[inew];
+    const double *e = eold + m_first[inew];
+    double ysum = 0.0, esum = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+      ysum += yWeights[begin + i] * y[i];
+      esum += eWeights[begin + i] * e[i] * e[i];
+    }
+    ynew[inew] = ysum;
+    enew[inew] = std::sqrt(esum);
+  }
+}
+
 //-------------------------------------------------------------------------------------------------
 /**
  * Convert the given set of bin boundaries into bin centre values
@@ -13,6 +13,7 @@
 #include <boost/make_shared.hpp>
 #include <cxxtest/TestSuite.h>
 
+#include <condition_variable>
 #include <mutex>
 #include <sstream>
 
@@ -33,6 +34,10 @@ private:
   int notificationFlag; // A flag to help with testing notifications
   std::vector<int> vector;
   std::mutex m_vectorMutex;
+  // Used to hold up the delivery of asynchronous notifications
+  std::condition_variable m_handlerCondition;
+  bool m_handlerEntered = false;
+  bool m_handlerReleased = false;
 
 public:
   static DataServiceTest *createSuite() { return new DataServiceTest(); }
@@ -494,6 +499,198 @@ public:
     TS_ASSERT_EQUALS(*svc.retrieve("item2345"), 2345);
   }
 
+  void test_addBatch() {
+    Poco::NObserver<DataServiceTest, FakeDataService::AddNotification> observer(
+        *this, &DataServiceTest::handleAddNotification);
+    svc.notificationCenter.addObserver(observer);
+
+    std::vector<FakeDataService::NamedObject> objects;
+    for (int i = 0; i < 50; ++i) {
+      objects.emplace_back("item" + std::to_string(i),
+                           boost::make_shared<int>(i));
+    }
+    TS_ASSERT_THROWS_NOTHING(svc.addBatch(objects));
+    TS_ASSERT_EQUALS(svc.size(), 50);
+    TS_ASSERT_EQUALS(notificationFlag, 50);
+    TS_ASSERT_EQUALS(*svc.retrieve("ITEM42"), 42);
+
+    // Existing names are reported but the others are still added
+    std::vector<FakeDataService::NamedObject> clash{
+        {"item1", boost::make_shared<int>(1)},
+        {"new", boost::make_shared<int>(2)}};
+    TS_ASSERT_THROWS(svc.addBatch(clash), std::runtime_error);
+    TS_ASSERT(svc.doesExist("new"));
+    TS_ASSERT_EQUALS(notificationFlag, 51);
+
+    // Invalid input adds nothing
+    std::vector<FakeDataService::NamedObject> invalid{
+        {"valid", boost::make_shared<int>(1)},
+        {"null", boost::shared_ptr<int>()}};
+    TS_ASSERT_THROWS(svc.addBatch(invalid), std::runtime_error);
+    TS_ASSERT(!svc.doesExist("valid"));
+    svc.notificationCenter.removeObserver(observer);
+  }
+
+  void test_removeBatch() {
+    Poco::NObserver<DataServiceTest, FakeDataService::PreDeleteNotification>
+        observer(*this, &DataServiceTest::handlePreDeleteNotification);
+    svc.notificationCenter.addObserver(observer);
+    svc.add("one", boost::make_shared<int>(1));
+    svc.add("two", boost::make_shared<int>(2));
+    svc.add("three", boost::make_shared<int>(3));
+
+    TS_ASSERT_THROWS_NOTHING(svc.removeBatch({"ONE", "three", "missing"}));
+    TS_ASSERT_EQUALS(svc.size(), 1);
+    TS_ASSERT(svc.doesExist("two"));
+    TS_ASSERT_EQUALS(notificationFlag, 2);
+    svc.notificationCenter.removeObserver(observer);
+  }
+
+  void test_rename_changing_case_only() {
+    auto one = boost::make_shared<int>(1);
+    svc.add("one", one);
+    svc.rename("one", "ONE");
+    TS_ASSERT_EQUALS(svc.size(), 1);
+    TS_ASSERT_EQUALS(svc.getObjectNames(), std::vector<std::string>{"ONE"});
+    TS_ASSERT_EQUALS(svc.retrieve("One"), one);
+  }
+
+  void test_getObjectNames_is_ordered_case_insensitively() {
+    for (const auto &name : {"b", "C", "a", "D"}) {
+      svc.add(name, boost::make_shared<int>(1));
+    }
+    const std::vector<std::string> unsorted{"a", "b", "C", "D"};
+    TS_ASSERT_EQUALS(svc.getObjectNames(), unsorted);
+    const std::vector<std::string> sorted{"C", "D", "a", "b"};
+    TS_ASSERT_EQUALS(svc.getObjectNames(DataServiceSort::Sorted), sorted);
+  }
+
+  // Handler that holds up the dispatcher thread on the first notification
+  // until the test releases it
+  void handleAfterReplaceNotification(
+      const Poco::AutoPtr<FakeDataService::AfterReplaceNotification>
+          &notification) {
+    std::unique_lock<std::mutex> lock(m_vectorMutex);
+    vector.push_back(*notification->object());
+    ++notificationFlag;
+    m_handlerEntered = true;
+    m_handlerCondition.notify_all();
+    m_handlerCondition.wait(lock, [this] { return m_handlerReleased; });
+  }
+
+  void test_asynchronous_notifications_are_delivered_in_order() {
+    Poco::NObserver<DataServiceTest, FakeDataService::AddNotification> observer(
+        *this, &DataServiceTest::handleAddNotification);
+    svc.notificationCenter.addObserver(observer);
+    vector.clear();
+    svc.setAsynchronousNotifications(true);
+    TS_ASSERT(svc.asynchronousNotifications());
+
+    for (int i = 0; i < 100; ++i) {
+      svc.add("item" + std::to_string(i), boost::make_shared<int>(i));
+    }
+    svc.flushNotifications();
+    TS_ASSERT_EQUALS(vector.size(), 100);
+    TS_ASSERT_EQUALS(notificationFlag, 100);
+
+    svc.setAsynchronousNotifications(false);
+    svc.notificationCenter.removeObserver(observer);
+  }
+
+  void test_asynchronous_replace_notifications_are_coalesced() {
+    Poco::NObserver<DataServiceTest, FakeDataService::AfterReplaceNotification>
+        observer(*this, &DataServiceTest::handleAfterReplaceNotification);
+    svc.notificationCenter.addObserver(observer);
+    svc.add("one", boost::make_shared<int>(0));
+    vector.clear();
+    m_handlerEntered = false;
+    m_handlerReleased = false;
+    svc.setAsynchronousNotifications(true);
+
+    // Wait until the first replacement is being delivered
+    svc.addOrReplace("one", boost::make_shared<int>(1));
+    {
+      std::unique_lock<std::mutex> lock(m_vectorMutex);
+      m_handlerCondition.wait(lock, [this] { return m_handlerEntered; });
+    }
+    // These all wait behind it and collapse into one, whatever the case of
+    // the name
+    for (int i = 2; i <= 20; ++i) {
+      svc.addOrReplace(i % 2 == 0 ? "one" : "ONE", boost::make_shared<int>(i));
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_vectorMutex);
+      m_handlerReleased = true;
+    }
+    m_handlerCondition.notify_all();
+    svc.setAsynchronousNotifications(false);
+
+    TS_ASSERT_EQUALS(notificationFlag, 2);
+    TS_ASSERT_EQUALS(vector, std::vector<int>({1, 20}));
+    svc.notificationCenter.removeObserver(observer);
+  }
+
+  void test_shutdown_delivers_pending_notifications() {
+    Poco::NObserver<DataServiceTest, FakeDataService::AddNotification> observer(
+        *this, &DataServiceTest::handleAddNotification);
+    svc.notificationCenter.addObserver(observer);
+    svc.setAsynchronousNotifications(true);
+    for (int i = 0; i < 10; ++i) {
+      svc.add("item" + std::to_string(i), boost::make_shared<int>(i));
+    }
+    svc.shutdown();
+    TS_ASSERT_EQUALS(notificationFlag, 10);
+    TS_ASSERT(!svc.asynchronousNotifications());
+    svc.notificationCenter.removeObserver(observer);
+  }
+
+  void test_concurrent_addOrReplace_of_a_new_name_does_not_throw() {
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < 100; ++i) {
+      TS_ASSERT_THROWS_NOTHING(
+          svc.addOrReplace("shared", boost::make_shared<int>(i)));
+    }
+    TS_ASSERT_EQUALS(svc.size(), 1);
+  }
+
+  void test_rename_sends_replace_notifications_for_an_overwritten_object() {
+    Poco::NObserver<DataServiceTest, FakeDataService::AfterReplaceNotification>
+        observer(*this, &DataServiceTest::handleAfterReplaceNotification);
+    svc.notificationCenter.addObserver(observer);
+    vector.clear();
+    m_handlerReleased = true;
+    svc.add("one", boost::make_shared<int>(1));
+    svc.add("two", boost::make_shared<int>(2));
+    svc.rename("one", "TWO");
+    TS_ASSERT_EQUALS(svc.size(), 1);
+    TS_ASSERT_EQUALS(*svc.retrieve("two"), 1);
+    TS_ASSERT_EQUALS(vector, std::vector<int>(1, 1));
+    svc.notificationCenter.removeObserver(observer);
+  }
+
+  // Records the object stored under the name when the replacement is
+  // announced
+  void handleBeforeReplaceStoredObject(
+      const Poco::AutoPtr<FakeDataService::BeforeReplaceNotification>
+          &notification) {
+    vector.push_back(*svc.retrieve(notification->objectName()));
+  }
+
+  void test_before_replace_is_sent_while_the_old_object_is_stored() {
+    Poco::NObserver<DataServiceTest, FakeDataService::BeforeReplaceNotification>
+        observer(*this, &DataServiceTest::handleBeforeReplaceStoredObject);
+    svc.notificationCenter.addObserver(observer);
+    vector.clear();
+    svc.add("one", boost::make_shared<int>(1));
+    svc.add("two", boost::make_shared<int>(2));
+
+    svc.addOrReplace("one", boost::make_shared<int>(3));
+    svc.rename("one", "two");
+    TS_ASSERT_EQUALS(vector, std::vector<int>({1, 2}));
+    TS_ASSERT_EQUALS(*svc.retrieve("two"), 3);
+    svc.notificationCenter.removeObserver(observer);
+  }
+
   void test_prefixToHide() {
     TS_ASSERT_EQUALS(FakeDataService::prefixToHide(), "__");
   }
@@ -528,4 +725,68 @@ public:
   }
 };
 
+class DataServiceTestPerformance : public CxxTest::TestSuite {
+public:
+  static DataServiceTestPerformance *createSuite() {
+    return new DataServiceTestPerformance();
+  }
+  static void destroySuite(DataServiceTestPerformance *suite) { delete suite; }
+
+  DataServiceTestPerformance() {
+    for (int i = 0; i < m_nitems; ++i) {
+      m_names.emplace_back("item" + std::to_string(i));
+    }
+  }
+
+  void setUp() override { m_svc.clear(); }
+
+  void test_add_retrieve_remove_under_contention() {
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < m_nitems; ++i) {
+      const auto &name = m_names[i];
+      m_svc.add(name, boost::make_shared<int>(i));
+      for (int j = 0; j < 10; ++j) {
+        m_svc.retrieve(m_names[(i + j) % (i + 1)]);
+      }
+    }
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < m_nitems; ++i) {
+      m_svc.remove(m_names[i]);
+    }
+  }
+
+  void test_retrieve_under_contention() {
+    m_svc.add("object", boost::make_shared<int>(1));
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < 10 * m_nitems; ++i) {
+      m_svc.retrieve("object");
+    }
+  }
+
+  void test_batched_add_and_remove() {
+    std::vector<FakeDataService::NamedObject> objects;
+    objects.reserve(m_names.size());
+    for (const auto &name : m_names) {
+      objects.emplace_back(name, boost::make_shared<int>(1));
+    }
+    m_svc.addBatch(objects);
+    m_svc.removeBatch(m_names);
+  }
+
+  void test_add_and_remove_with_asynchronous_notifications() {
+    m_svc.setAsynchronousNotifications(true);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < m_nitems; ++i) {
+      m_svc.add(m_names[i], boost::make_shared<int>(i));
+      m_svc.remove(m_names[i]);
+    }
+    m_svc.setAsynchronousNotifications(false);
+  }
+
+private:
+  const int m_nitems = 200000;
+  std::vector<std::string> m_names;
+  FakeDataService m_svc;
+};
+
 #endif /* MANTID_KERNEL_DATASERVICETEST_H_ */
@@ -8,6 +8,7 @@
 #define DYNAMICFACTORYTEST_H_
 
 #include "MantidKernel/DynamicFactory.h"
+#include "MantidKernel/MultiThreaded.h"
 #include <cxxtest/TestSuite.h>
 
 #include <Poco/NObserver.h>
@@ -188,6 +189,25 @@ public:
     factory.unsubscribe(testKey);
   }
 
+  void testSubscribeWhileOtherThreadsLookUp() {
+    factory.subscribe<int>("existing");
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < 200; ++i) {
+      if (i % 4 == 0) {
+        factory.subscribe<int>("concurrent" + std::to_string(i));
+      } else {
+        TS_ASSERT(factory.create("existing"));
+        TS_ASSERT(factory.exists("existing"));
+      }
+    }
+    for (int i = 0; i < 200; i += 4) {
+      const auto name = "concurrent" + std::to_string(i);
+      TS_ASSERT(factory.exists(name));
+      factory.unsubscribe(name);
+    }
+    factory.unsubscribe("existing");
+  }
+
 private:
   void
   handleFactoryUpdate(const Poco::AutoPtr<IntFactory::UpdateNotification> &) {
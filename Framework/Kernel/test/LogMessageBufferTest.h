@@ -0,0 +1,152 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_KERNEL_LOGMESSAGEBUFFERTEST_H_
+#define MANTID_KERNEL_LOGMESSAGEBUFFERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/LogMessageBuffer.h"
+#include "MantidKernel/Logger.h"
+
+#include <Poco/AutoPtr.h>
+#include <Poco/Channel.h>
+#include <Poco/Logger.h>
+
+#include <mutex>
+#include <thread>
+
+using Mantid::Kernel::LogMessageBuffer;
+using Mantid::Kernel::Logger;
+
+namespace {
+const std::string LOGGER_NAME = "LogMessageBufferTest";
+
+/// Keeps the text of every message it is sent
+class RecordingChannel : public Poco::Channel {
+public:
+  void log(const Poco::Message &msg) override {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_texts.emplace_back(msg.getText());
+  }
+  std::vector<std::string> texts() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_texts;
+  }
+
+private:
+  std::mutex m_mutex;
+  std::vector<std::string> m_texts;
+};
+} // namespace
+
+class LogMessageBufferTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LogMessageBufferTest *createSuite() {
+    return new LogMessageBufferTest();
+  }
+  static void destroySuite(LogMessageBufferTest *suite) { delete suite; }
+
+  void setUp() override {
+    auto &pocoLogger = Poco::Logger::get(LOGGER_NAME);
+    m_previousChannel = pocoLogger.getChannel();
+    m_previousLevel = pocoLogger.getLevel();
+    m_channel = new RecordingChannel;
+    pocoLogger.setChannel(m_channel);
+    pocoLogger.setLevel(Poco::Message::PRIO_INFORMATION);
+  }
+
+  void tearDown() override {
+    auto &pocoLogger = Poco::Logger::get(LOGGER_NAME);
+    pocoLogger.setChannel(m_previousChannel);
+    pocoLogger.setLevel(m_previousLevel);
+  }
+
+  void test_messages_are_held_until_flushed() {
+    Logger logger(LOGGER_NAME);
+    LogMessageBuffer buffer;
+    {
+      LogMessageBuffer::Capture capture(buffer);
+      logger.information("first");
+      logger.warning() << "second\n";
+      TS_ASSERT(m_channel->texts().empty());
+    }
+    TS_ASSERT_EQUALS(buffer.size(), 2);
+    logger.information("third");
+
+    buffer.flush();
+    TS_ASSERT_EQUALS(buffer.size(), 0);
+    const std::vector<std::string> expected{"third", "first", "second"};
+    TS_ASSERT_EQUALS(m_channel->texts(), expected);
+  }
+
+  void test_messages_below_the_level_are_dropped() {
+    Logger logger(LOGGER_NAME);
+    LogMessageBuffer buffer;
+    {
+      LogMessageBuffer::Capture capture(buffer);
+      logger.debug("dropped");
+    }
+    TS_ASSERT_EQUALS(buffer.size(), 0);
+    buffer.flush();
+    TS_ASSERT(m_channel->texts().empty());
+  }
+
+  void test_other_threads_are_not_captured() {
+    Logger logger(LOGGER_NAME);
+    LogMessageBuffer buffer;
+    LogMessageBuffer::Capture capture(buffer);
+    std::thread other([&logger]() { logger.information("other"); });
+    other.join();
+    TS_ASSERT_EQUALS(m_channel->texts(), std::vector<std::string>(1, "other"));
+    TS_ASSERT_EQUALS(buffer.size(), 0);
+  }
+
+  void test_buffers_from_several_threads_are_flushed_in_the_chosen_order() {
+    Logger logger(LOGGER_NAME);
+    std::vector<LogMessageBuffer> buffers(4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      threads.emplace_back([&logger, &buffers, i]() {
+        LogMessageBuffer::Capture capture(buffers[i]);
+        for (int j = 0; j < 100; ++j)
+          logger.information() << i << '\n';
+      });
+    }
+    for (auto &thread : threads)
+      thread.join();
+    TS_ASSERT(m_channel->texts().empty());
+
+    for (auto &buffer : buffers)
+      buffer.flush();
+    const auto texts = m_channel->texts();
+    TS_ASSERT_EQUALS(texts.size(), 400);
+    for (size_t i = 0; i < texts.size(); ++i)
+      TS_ASSERT_EQUALS(texts[i], std::to_string(i / 100));
+  }
+
+  void test_nested_captures_restore_the_outer_buffer() {
+    Logger logger(LOGGER_NAME);
+    LogMessageBuffer outer, inner;
+    LogMessageBuffer::Capture outerCapture(outer);
+    {
+      LogMessageBuffer::Capture innerCapture(inner);
+      logger.information("inner");
+    }
+    logger.information("outer");
+    TS_ASSERT_EQUALS(inner.size(), 1);
+    TS_ASSERT_EQUALS(outer.size(), 1);
+  }
+
+private:
+  Poco::AutoPtr<RecordingChannel> m_channel;
+  Poco::Channel *m_previousChannel;
+  int m_previousLevel;
+};
+
+#endif /* MANTID_KERNEL_LOGMESSAGEBUFFERTEST_H_ */
@@ -10,6 +10,9 @@
 #include "MantidKernel/NearestNeighbours.h"
 #include <cxxtest/TestSuite.h>
 
+#include <cmath>
+#include <random>
+
 using Mantid::Kernel::NearestNeighbours;
 using namespace Eigen;
 
@@ -72,6 +75,134 @@ public:
     TS_ASSERT_EQUALS(index, 1)
     TS_ASSERT_DELTA(dist, 2.21, 0.01)
   }
+
+  void test_find_nearest_returns_at_most_the_number_of_points() {
+    std::vector<Vector2d> pts = {Vector2d(1, 1), Vector2d(2, 2)};
+    NearestNeighbours<2> nn(pts);
+    TS_ASSERT_EQUALS(nn.findNearest(Vector2d(0, 0), 5).size(), 2)
+  }
+
+  void test_empty_tree_finds_nothing() {
+    NearestNeighbours<3> nn(std::vector<Vector3d>{});
+    TS_ASSERT_EQUALS(nn.size(), 0)
+    TS_ASSERT(nn.findNearest(Vector3d(0, 0, 0)).empty())
+    TS_ASSERT(nn.findInRadius(Vector3d(0, 0, 0), 1.).empty())
+  }
+
+  void test_find_nearest_matches_brute_force() {
+    const auto pts = randomPoints(5000, 1);
+    const auto queries = randomPoints(200, 2);
+    NearestNeighbours<3> nn(pts);
+    const size_t k = 7;
+    for (const auto &query : queries) {
+      const auto results = nn.findNearest(query, k);
+      const auto expected = bruteForceDistances(pts, query);
+      TS_ASSERT_EQUALS(results.size(), k)
+      for (size_t i = 0; i < k; ++i) {
+        const auto index = std::get<1>(results[i]);
+        TS_ASSERT_DELTA(std::get<2>(results[i]), expected[i], 1e-12)
+        TS_ASSERT_DELTA((pts[index] - query).squaredNorm(), expected[i], 1e-12)
+        TS_ASSERT(std::get<0>(results[i]) == pts[index])
+      }
+    }
+  }
+
+  void test_batched_find_nearest_matches_single_queries() {
+    const auto pts = randomPoints(10000, 3);
+    const auto queries = randomPoints(500, 4);
+    NearestNeighbours<3> nn(pts);
+    const auto batched = nn.findNearest(queries, 4);
+    TS_ASSERT_EQUALS(batched.size(), queries.size())
+    for (size_t i = 0; i < queries.size(); ++i) {
+      const auto single = nn.findNearest(queries[i], 4);
+      TS_ASSERT_EQUALS(batched[i].size(), single.size())
+      for (size_t j = 0; j < single.size(); ++j)
+        TS_ASSERT_EQUALS(std::get<1>(batched[i][j]), std::get<1>(single[j]))
+    }
+  }
+
+  void test_find_in_radius_matches_brute_force() {
+    const auto pts = randomPoints(5000, 5);
+    const auto queries = randomPoints(100, 6);
+    NearestNeighbours<3> nn(pts);
+    const double radius = 0.1;
+    const auto batched = nn.findInRadius(queries, radius);
+    for (size_t i = 0; i < queries.size(); ++i) {
+      const auto expected = bruteForceDistances(pts, queries[i]);
+      const auto numInside = static_cast<size_t>(
+          std::upper_bound(expected.begin(), expected.end(), radius * radius) -
+          expected.begin());
+      TS_ASSERT_EQUALS(batched[i].size(), numInside)
+      for (size_t j = 0; j < batched[i].size(); ++j)
+        TS_ASSERT_DELTA(std::get<2>(batched[i][j]), expected[j], 1e-12)
+    }
+  }
+
+  void test_duplicate_points_are_all_found() {
+    std::vector<Vector3d> pts(50, Vector3d(1, 2, 3));
+    pts.emplace_back(5, 5, 5);
+    NearestNeighbours<3> nn(pts);
+    TS_ASSERT_EQUALS(nn.findInRadius(Vector3d(1, 2, 3), 0.).size(), 50)
+    const auto results = nn.findNearest(Vector3d(5, 5, 5.1), 2);
+    TS_ASSERT_EQUALS(std::get<1>(results[0]), 50)
+  }
+
+private:
+  /// @return points spread uniformly through the unit cube
+  static std::vector<Vector3d> randomPoints(const size_t count,
+                                            const unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    std::vector<Vector3d> pts(count);
+    for (auto &pt : pts)
+      pt = Vector3d(uniform(generator), uniform(generator), uniform(generator));
+    return pts;
+  }
+
+  /// @return the sorted squared distances from a position to every point
+  static std::vector<double>
+  bruteForceDistances(const std::vector<Vector3d> &pts, const Vector3d &pos) {
+    std::vector<double> distances;
+    distances.reserve(pts.size());
+    for (const auto &pt : pts)
+      distances.push_back((pt - pos).squaredNorm());
+    std::sort(distances.begin(), distances.end());
+    return distances;
+  }
+};
+
+class NearestNeighboursTestPerformance : public CxxTest::TestSuite {
+public:
+  static NearestNeighboursTestPerformance *createSuite() {
+    return new NearestNeighboursTestPerformance();
+  }
+  static void destroySuite(NearestNeighboursTestPerformance *suite) {
+    delete suite;
+  }
+
+  NearestNeighboursTestPerformance() {
+    // A million detectors on a cylinder, as in a large instrument
+    const size_t nTubes = 1000, nPixels = 1000;
+    m_points.reserve(nTubes * nPixels);
+    for (size_t tube = 0; tube < nTubes; ++tube) {
+      const double angle = 2. * M_PI * static_cast<double>(tube) / nTubes;
+      for (size_t pixel = 0; pixel < nPixels; ++pixel)
+        m_points.emplace_back(3. * std::cos(angle),
+                              -1. + 2. * static_cast<double>(pixel) / nPixels,
+                              3. * std::sin(angle));
+    }
+  }
+
+  void test_build() { NearestNeighbours<3> nn(m_points); }
+
+  void test_batched_eight_nearest_of_every_point() {
+    NearestNeighbours<3> nn(m_points);
+    const auto results = nn.findNearest(m_points, 9);
+    TS_ASSERT_EQUALS(results.size(), m_points.size())
+  }
+
+private:
+  std::vector<Vector3d> m_points;
 };
 
 #endif
@@ -0,0 +1,126 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_KERNEL_NOTIFICATIONDISPATCHERTEST_H_
+#define MANTID_KERNEL_NOTIFICATIONDISPATCHERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/NotificationDispatcher.h"
+#include <Poco/NObserver.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+using Mantid::Kernel::NotificationDispatcher;
+
+namespace {
+class NumberedNotification : public Poco::Notification {
+public:
+  NumberedNotification(int number) : Poco::Notification(), number(number) {}
+  const int number;
+};
+} // namespace
+
+class NotificationDispatcherTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static NotificationDispatcherTest *createSuite() {
+    return new NotificationDispatcherTest();
+  }
+  static void destroySuite(NotificationDispatcherTest *suite) { delete suite; }
+
+  void setUp() override {
+    m_received.clear();
+    m_hold = false;
+    m_held = false;
+  }
+
+  // Records the notification. While m_hold is set the handler signals that
+  // it has been entered and waits until m_hold is cleared.
+  void handleNotification(const Poco::AutoPtr<NumberedNotification> &nf) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_received.push_back(nf->number);
+    m_held = true;
+    m_condition.notify_all();
+    m_condition.wait(lock, [this] { return !m_hold; });
+  }
+
+  void test_notifications_are_delivered_in_order_on_another_thread() {
+    Poco::NotificationCenter center;
+    Poco::NObserver<NotificationDispatcherTest, NumberedNotification> observer(
+        *this, &NotificationDispatcherTest::handleNotification);
+    center.addObserver(observer);
+    NotificationDispatcher dispatcher(center);
+
+    std::vector<int> expected;
+    for (int i = 0; i < 100; ++i) {
+      dispatcher.enqueue(new NumberedNotification(i));
+      expected.push_back(i);
+    }
+    dispatcher.flush();
+    TS_ASSERT_EQUALS(dispatcher.pending(), 0);
+    TS_ASSERT_EQUALS(m_received, expected);
+    center.removeObserver(observer);
+  }
+
+  void test_pending_notifications_with_the_same_key_are_coalesced() {
+    Poco::NotificationCenter center;
+    Poco::NObserver<NotificationDispatcherTest, NumberedNotification> observer(
+        *this, &NotificationDispatcherTest::handleNotification);
+    center.addObserver(observer);
+    NotificationDispatcher dispatcher(center);
+    m_hold = true;
+
+    // The first is taken by the dispatcher thread while the rest queue up
+    dispatcher.enqueue(new NumberedNotification(0), "key");
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [this] { return m_held; });
+    }
+    dispatcher.enqueue(new NumberedNotification(1), "key");
+    dispatcher.enqueue(new NumberedNotification(2), "other");
+    dispatcher.enqueue(new NumberedNotification(3), "key");
+    dispatcher.enqueue(new NumberedNotification(4));
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_hold = false;
+    }
+    m_condition.notify_all();
+    dispatcher.flush();
+
+    // 1 is dropped and 3 is delivered after 2, which was queued before it
+    const std::vector<int> expected{0, 2, 3, 4};
+    TS_ASSERT_EQUALS(m_received, expected);
+    center.removeObserver(observer);
+  }
+
+  void test_stop_delivers_pending_and_later_notifications() {
+    Poco::NotificationCenter center;
+    Poco::NObserver<NotificationDispatcherTest, NumberedNotification> observer(
+        *this, &NotificationDispatcherTest::handleNotification);
+    center.addObserver(observer);
+    NotificationDispatcher dispatcher(center);
+
+    dispatcher.enqueue(new NumberedNotification(0));
+    dispatcher.stop();
+    TS_ASSERT_EQUALS(m_received.size(), 1);
+    dispatcher.enqueue(new NumberedNotification(1));
+    TS_ASSERT_EQUALS(m_received.size(), 2);
+    center.removeObserver(observer);
+  }
+
+private:
+  std::vector<int> m_received;
+  bool m_hold = false;
+  bool m_held = false;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+};
+
+#endif /* MANTID_KERNEL_NOTIFICATIONDISPATCHERTEST_H_ */
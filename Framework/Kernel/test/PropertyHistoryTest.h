@@ -111,6 +111,23 @@ public:
         "number", true, Direction::Input);
     TS_ASSERT_EQUALS(prop.isEmptyDefault(), false);
   }
+
+  /**
+   * Test that histories holding equal strings share them
+   */
+  void testEqualStringsAreShared() {
+    PropertyHistory first("arg", "a long value", "number", true,
+                          Direction::Input);
+    PropertyHistory second(std::string("arg"), std::string("a long value"),
+                           "string", false, Direction::Input);
+    TS_ASSERT_EQUALS(&first.name(), &second.name());
+    TS_ASSERT_EQUALS(&first.value(), &second.value());
+    TS_ASSERT_DIFFERS(&first.type(), &second.type());
+
+    second.setValue("another value");
+    TS_ASSERT_EQUALS(first.value(), "a long value");
+    TS_ASSERT_EQUALS(second.value(), "another value");
+  }
 };
 
 #endif /* PROPERTYHISTORYTEST_H_*/
@@ -11,6 +11,7 @@
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/VectorHelper.h"
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <cxxtest/TestSuite.h>
 #include <numeric>
@@ -517,7 +518,77 @@ public:
     TS_ASSERT(inputData[indOfMax + 1] < output[indOfMax]);
   }
 
+  void test_RebinWeights_matches_rebin_for_counts() {
+    checkRebinWeightsMatchRebin(false);
+  }
+
+  void test_RebinWeights_matches_rebin_for_distributions() {
+    checkRebinWeightsMatchRebin(true);
+  }
+
+  void test_RebinWeights_new_bins_outside_old_range_are_zero() {
+    const std::vector<double> xold{1, 2, 3};
+    const std::vector<double> xnew{-2, -1, 2.5, 10, 11};
+    VectorHelper::RebinWeights weights(xold, xnew, false);
+    TS_ASSERT_EQUALS(weights.oldSize(), 2);
+    TS_ASSERT_EQUALS(weights.newSize(), 4);
+    std::vector<double> ynew(4, -1.), enew(4, -1.);
+    weights.apply({4., 2.}, {4., 2.}, ynew, enew);
+    TS_ASSERT_EQUALS(ynew[0], 0.);
+    TS_ASSERT_DELTA(ynew[1], 5., 1e-12);
+    TS_ASSERT_DELTA(ynew[2], 1., 1e-12);
+    TS_ASSERT_EQUALS(ynew[3], 0.);
+    TS_ASSERT_DELTA(enew[1], std::sqrt(18.), 1e-12);
+    TS_ASSERT_EQUALS(enew[3], 0.);
+  }
+
+  void test_RebinWeights_throws_for_non_positive_bin_widths() {
+    TS_ASSERT_THROWS(VectorHelper::RebinWeights({1, 2, 2, 3}, {1, 3}, false),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(VectorHelper::RebinWeights({1, 3}, {3, 2}, true),
+                     const std::invalid_argument &);
+  }
+
+  void test_RebinWeights_apply_throws_for_wrong_sizes() {
+    VectorHelper::RebinWeights weights({1, 2, 3}, {1, 3}, false);
+    std::vector<double> ynew(1), enew(1);
+    TS_ASSERT_THROWS(weights.apply({1.}, {1.}, ynew, enew),
+                     const std::runtime_error &);
+    std::vector<double> tooLong(2);
+    TS_ASSERT_THROWS(weights.apply({1., 1.}, {1., 1.}, tooLong, enew),
+                     const std::runtime_error &);
+  }
+
 private:
+  /// Compare RebinWeights with rebin over irregular, partly overlapping bins
+  void checkRebinWeightsMatchRebin(const bool distribution) {
+    std::vector<double> xold{0.5};
+    for (size_t i = 0; i < 200; ++i)
+      xold.push_back(xold.back() + 0.1 + 0.05 * static_cast<double>(i % 7));
+    std::vector<double> yold(xold.size() - 1), eold(xold.size() - 1);
+    for (size_t i = 0; i < yold.size(); ++i) {
+      yold[i] = static_cast<double>((i * 37) % 101);
+      eold[i] = std::sqrt(yold[i]) + 0.5;
+    }
+    for (const double step : {0.03, 0.27, 1.9}) {
+      std::vector<double> xnew;
+      for (double x = 0.; x < xold.back() + 2.; x += step)
+        xnew.push_back(x);
+      std::vector<double> yexpected(xnew.size() - 1),
+          eexpected(xnew.size() - 1);
+      VectorHelper::rebin(xold, yold, eold, xnew, yexpected, eexpected,
+                          distribution);
+
+      VectorHelper::RebinWeights weights(xold, xnew, distribution);
+      std::vector<double> ynew(xnew.size() - 1), enew(xnew.size() - 1);
+      weights.apply(yold, eold, ynew, enew);
+      for (size_t i = 0; i < ynew.size(); ++i) {
+        TS_ASSERT_DELTA(ynew[i], yexpected[i], 1e-10);
+        TS_ASSERT_DELTA(enew[i], eexpected[i], 1e-10);
+      }
+    }
+  }
+
   /// Testing bins
   std::vector<double> m_test_bins;
 };
@@ -574,6 +645,26 @@ public:
     }
   }
 
+  void testRebinWeightsSmaller() {
+    auto size = smallerBinEdges.size() - 1;
+    VectorHelper::RebinWeights weights(binEdges, smallerBinEdges, false);
+    for (size_t i = 0; i < nIters; i++) {
+      std::vector<double> yout(size);
+      std::vector<double> eout(size);
+      weights.apply(counts, errors, yout, eout);
+    }
+  }
+
+  void testRebinWeightsLarger() {
+    auto size = largerBinEdges.size() - 1;
+    VectorHelper::RebinWeights weights(binEdges, largerBinEdges, false);
+    for (size_t i = 0; i < nIters; i++) {
+      std::vector<double> yout(size);
+      std::vector<double> eout(size);
+      weights.apply(counts, errors, yout, eout);
+    }
+  }
+
 private:
   const size_t binSize = 10000;
   const size_t nIters = 10000;
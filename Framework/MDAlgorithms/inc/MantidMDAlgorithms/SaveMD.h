@@ -31,6 +31,8 @@ public:
 
   /// Algorithm's version for identification
   int version() const override { return 1; };
+  /// The HDF5 library is not built thread safe
+  bool threadSafe() const override { return false; }
   /// Algorithm's category for identification
   const std::string category() const override {
     return "MDAlgorithms\\DataHandling";
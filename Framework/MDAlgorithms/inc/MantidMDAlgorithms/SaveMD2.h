@@ -28,6 +28,8 @@ public:
 
   /// Algorithm's version for identification
   int version() const override { return 2; };
+  /// The HDF5 library is not built thread safe
+  bool threadSafe() const override { return false; }
   const std::vector<std::string> seeAlso() const override {
     return {"LoadMD", "SaveZODS"};
   }
@@ -10,6 +10,7 @@
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidAPI/NumericAxis.h"
 #include "MantidAPI/Run.h"
+#include "MantidAPI/SpectrumGeometry.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidKernel/CompositeValidator.h"
@@ -240,6 +241,7 @@ void PreprocessDetectorsToMD::processDetectorsPositions(
   //// Loop over the spectra
   uint32_t liveDetectorsCount(0);
   const auto &spectrumInfo = inputWS->spectrumInfo();
+  const auto geometry = spectrumInfo.geometry();
   for (size_t i = 0; i < nHist; i++) {
     sp2detMap[i] = std::numeric_limits<uint64_t>::quiet_NaN();
     detId[i] = std::numeric_limits<int32_t>::quiet_NaN();
@@ -249,11 +251,11 @@ void PreprocessDetectorsToMD::processDetectorsPositions(
     Azimuthal[i] = std::numeric_limits<double>::quiet_NaN();
     //     detMask[i]  = true;
 
-    if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i))
+    if (!geometry->hasDetectors()[i] || geometry->isMonitor()[i])
       continue;
 
     // if masked detectors state is not used, masked detectors just ignored;
-    bool maskDetector = spectrumInfo.isMasked(i);
+    bool maskDetector = geometry->isMasked()[i] != 0;
     if (m_getIsMasked)
       *(pMasksArray + liveDetectorsCount) = maskDetector ? 1 : 0;
     else if (maskDetector)
@@ -265,10 +267,10 @@ void PreprocessDetectorsToMD::processDetectorsPositions(
     sp2detMap[i] = liveDetectorsCount;
     detId[liveDetectorsCount] = int32_t(spDet.getID());
     detIDMap[liveDetectorsCount] = i;
-    L2[liveDetectorsCount] = spectrumInfo.l2(i);
+    L2[liveDetectorsCount] = geometry->l2(i);
 
-    double polar = spectrumInfo.twoTheta(i);
-    double azim = spDet.getPhi();
+    double polar = geometry->twoTheta(i);
+    double azim = geometry->phi()[i];
     TwoTheta[liveDetectorsCount] = polar;
     Azimuthal[liveDetectorsCount] = azim;
 
@@ -41,9 +41,12 @@ namespace {
  * @param self :: Enables it to be called as a member function on the
  * AlgorithmFactory class
  * @param includeHidden :: If true hidden algorithms are included
+ * @param openDeferred :: If false the algorithms of plugin libraries that
+ * have not been opened yet are left out
  */
-dict getRegisteredAlgorithms(AlgorithmFactoryImpl &self, bool includeHidden) {
-  std::vector<std::string> keys = self.getKeys(includeHidden);
+dict getRegisteredAlgorithms(AlgorithmFactoryImpl &self, bool includeHidden,
+                             bool openDeferred) {
+  std::vector<std::string> keys = self.getKeys(includeHidden, openDeferred);
   const size_t nkeys = keys.size();
   dict inventory;
   for (size_t i = 0; i < nkeys; ++i) {
@@ -80,6 +83,19 @@ list getDescriptors(AlgorithmFactoryImpl &self, bool includeHidden) {
   return pyDescriptors;
 }
 
+/**
+ * Return the algorithms whose plugin libraries have not been opened yet as a
+ * python list.
+ * @param self :: An instance of AlgorithmFactory.
+ */
+list getDeferredAlgorithms(AlgorithmFactoryImpl &self) {
+  list pyAlgorithms;
+  for (auto &algorithm : self.getDeferredAlgorithms()) {
+    pyAlgorithms.append(boost::python::object(algorithm));
+  }
+  return pyAlgorithms;
+}
+
 //------------------------------------------------------------------------------
 // Python algorithm subscription
 //------------------------------------------------------------------------------
@@ -145,6 +161,15 @@ void export_AlgorithmFactory() {
       .def_readonly("category", &AlgorithmDescriptor::category)
       .def_readonly("version", &AlgorithmDescriptor::version);
 
+  class_<DeferredAlgorithm>("DeferredAlgorithm")
+      .def_readonly("name", &DeferredAlgorithm::name)
+      .def_readonly("alias", &DeferredAlgorithm::alias)
+      .def_readonly("workspaceMethodName",
+                    &DeferredAlgorithm::workspaceMethodName)
+      .def_readonly("workspaceMethodOn", &DeferredAlgorithm::workspaceMethodOn)
+      .def_readonly("workspaceMethodInputProperty",
+                    &DeferredAlgorithm::workspaceMethodInputProperty);
+
   class_<AlgorithmFactoryImpl, boost::noncopyable>("AlgorithmFactoryImpl",
                                                    no_init)
       .def("exists", &AlgorithmFactoryImpl::exists,
@@ -153,8 +178,14 @@ void export_AlgorithmFactory() {
                             "an option to specify the version"))
 
       .def("getRegisteredAlgorithms", &getRegisteredAlgorithms,
-           (arg("self"), arg("include_hidden")),
-           "Returns a Python dictionary of currently registered algorithms")
+           (arg("self"), arg("include_hidden"), arg("open_deferred") = true),
+           "Returns a Python dictionary of currently registered algorithms. "
+           "Plugin libraries that have not been opened yet are only opened "
+           "if open_deferred is True")
+      .def("getDeferredAlgorithms", &getDeferredAlgorithms, arg("self"),
+           "Return a list of the algorithms whose plugin libraries have not "
+           "been opened yet. Each is described by its name, alias and "
+           "workspace method.")
       .def("highestVersion", &AlgorithmFactoryImpl::highestVersion,
            (arg("self"), arg("algorithm_name")),
            "Returns the highest version of the named algorithm. Throws "
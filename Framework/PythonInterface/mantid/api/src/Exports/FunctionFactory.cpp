@@ -75,10 +75,12 @@ namespace {
  * A Python friendly version that returns the registered functions as a list.
  * @param self :: Enables it to be called as a member function on the
  * FunctionFactory class
+ * @param openDeferred :: If false the functions of plugin libraries that
+ * have not been opened yet are left out
  */
-PyObject *getFunctionNames(FunctionFactoryImpl &self) {
+PyObject *getFunctionNames(FunctionFactoryImpl &self, bool openDeferred) {
   const std::vector<std::string> &names =
-      self.getFunctionNames<Mantid::API::IFunction>();
+      self.getFunctionNames<Mantid::API::IFunction>(openDeferred);
 
   PyObject *registered = PyList_New(0);
   for (const auto &name : names) {
@@ -161,8 +163,15 @@ void export_FunctionFactory() {
 
   class_<FunctionFactoryImpl, boost::noncopyable>("FunctionFactoryImpl",
                                                   no_init)
-      .def("getFunctionNames", &getFunctionNames, arg("self"),
-           "Returns a list of the currently available functions")
+      .def("getFunctionNames", &getFunctionNames,
+           (arg("self"), arg("open_deferred") = true),
+           "Returns a list of the currently available functions. Plugin "
+           "libraries that have not been opened yet are only opened if "
+           "open_deferred is True")
+      .def("getDeferredFunctionNames",
+           &FunctionFactoryImpl::getDeferredFunctionNames, arg("self"),
+           "Returns a list of the functions whose plugin libraries have not "
+           "been opened yet")
       .def("createCompositeFunction", &createCompositeFunction,
            (arg("self"), arg("name")),
            "Return a pointer to the requested function")
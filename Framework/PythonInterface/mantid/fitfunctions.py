@@ -769,8 +769,11 @@ def _create_wrapper_function(name):
 
 
 def _wrappers():
-    wrappers = []
-    for name in FunctionFactory.getFunctionNames():
+    # Functions of plugin libraries that have not been opened yet are wrapped by
+    # name. Their library is opened when one of them is first created.
+    names = list(FunctionFactory.getFunctionNames(False))
+    names += list(FunctionFactory.getDeferredFunctionNames())
+    for name in names:
         # Wrap all registered functions which are not in the black list
         if name not in _do_not_wrap:
             yield name, _create_wrapper_function(name)
@@ -1132,6 +1132,49 @@ def _create_algorithm_function(name, version, algm_object):
 # -------------------------------------------------------------------------------------------------------------
 
 
+def _create_deferred_algorithm_function(deferred):
+    """
+        Create the functions for an algorithm whose plugin library has not been
+        opened yet, without creating the algorithm. The first call opens the library
+        and replaces them with the full functions, which have the signature and help
+        of the algorithm.
+        :param deferred: the DeferredAlgorithm describing the algorithm
+        :returns: the function running the algorithm
+    """
+    name = deferred.name
+    resolved = {}
+
+    def resolve():
+        if not resolved:
+            algm_object = AlgorithmManager.createUnmanaged(name)
+            algm_object.initialize()
+            resolved['function'] = _create_algorithm_function(name, algm_object.version(), algm_object)
+            _create_algorithm_dialog(name, algm_object.version(), algm_object)
+            resolved['dialog'] = globals()["{}Dialog".format(name)]
+        return resolved
+
+    def algorithm_wrapper(*args, **kwargs):
+        import inspect
+        # The assignment the outputs are named after is in the caller's frame
+        kwargs.setdefault("__LHS_FRAME_OBJECT__", inspect.currentframe().f_back)
+        return resolve()['function'](*args, **kwargs)
+
+    def dialog_wrapper(*args, **kwargs):
+        return resolve()['dialog'](*args, **kwargs)
+
+    algorithm_wrapper.__name__ = name
+    algorithm_wrapper.__doc__ = ("Runs the {} algorithm. Its plugin library is opened, and its full help "
+                                 "becomes available, when it is first called.".format(name))
+    dialog_wrapper.__name__ = "{}Dialog".format(name)
+    dialog_wrapper.__doc__ = "{} dialog".format(name)
+    for func_name in [name] + deferred.alias.strip().split():
+        globals()[func_name] = algorithm_wrapper
+        globals()["{}Dialog".format(func_name)] = dialog_wrapper
+    return algorithm_wrapper
+
+# -------------------------------------------------------------------------------------------------------------
+
+
 def _create_algorithm_object(name, version=-1, startProgress=None, endProgress=None):
     """
     Create and initialize the named algorithm of the given version. This
@@ -1357,7 +1400,9 @@ def _translate():
     # on different algorithms, which is an error
     new_methods = {}
 
-    algs = AlgorithmFactory.getRegisteredAlgorithms(True)
+    # Libraries that have not been opened yet are left closed. Their algorithms are
+    # wrapped below from what the plugin manifest recorded.
+    algs = AlgorithmFactory.getRegisteredAlgorithms(True, False)
     algorithm_mgr = AlgorithmManager
     for name, versions in iteritems(algs):
         if specialization_exists(name):
@@ -1387,6 +1432,25 @@ def _translate():
         # Dialog variant
         _create_algorithm_dialog(name, max(versions), algm_object)
 
+    for deferred in AlgorithmFactory.getDeferredAlgorithms():
+        name = deferred.name
+        if specialization_exists(name):
+            continue
+        algorithm_wrapper = _create_deferred_algorithm_function(deferred)
+        method_name = deferred.workspaceMethodName
+        if len(method_name) > 0:
+            if method_name in new_methods:
+                raise RuntimeError("simpleapi: Trying to attach '%s' as method to point to '%s' algorithm but "
+                                   "it has already been attached to point to the '%s' algorithm.\n"
+                                   "Does one inherit from the other? "
+                                   "Please check and update one of the algorithms accordingly."
+                                   % (method_name, name, new_methods[method_name]))
+            _api._workspaceops.attach_func_as_method(method_name, algorithm_wrapper,
+                                                     deferred.workspaceMethodInputProperty,
+                                                     deferred.workspaceMethodOn)
+            new_methods[method_name] = name
+        new_func_attrs.append(name)
+
     return new_func_attrs
 
 # -------------------------------------------------------------------------------------------------------------
@@ -6,6 +6,7 @@
 # SPDX - License - Identifier: GPL - 3.0 +
 from __future__ import (absolute_import, division, print_function)
 
+from collections import namedtuple
 import unittest
 from mantid.api import (AlgorithmFactory, AlgorithmProxy, IAlgorithm, IEventWorkspace, ITableWorkspace,
                         PythonAlgorithm, MatrixWorkspace, mtd)
@@ -475,5 +476,23 @@ class SimpleAPITest(unittest.TestCase):
         mtd.remove('ws')
         self.assertTrue(ws)
 
+    def test_deferred_algorithm_function_creates_the_algorithm_when_called(self):
+        Deferred = namedtuple('Deferred', ['name', 'alias', 'workspaceMethodName', 'workspaceMethodOn',
+                                           'workspaceMethodInputProperty'])
+        deferred = Deferred('CreateSampleWorkspace', 'DeferredTestAlias', '', [], '')
+        try:
+            wrapper = simpleapi._create_deferred_algorithm_function(deferred)
+            self.assertTrue(simpleapi.DeferredTestAlias is wrapper)
+            self.assertTrue(simpleapi.CreateSampleWorkspace is wrapper)
+            sample = wrapper(StoreInADS=True) # noqa F841
+            self.assertTrue('sample' in mtd)
+            # The full function replaces the deferred one once called
+            self.assertTrue(simpleapi.CreateSampleWorkspace is not wrapper)
+            self.assertTrue('Property descriptions' in simpleapi.CreateSampleWorkspace.__doc__)
+        finally:
+            for name in ['DeferredTestAlias', 'DeferredTestAliasDialog']:
+                if hasattr(simpleapi, name):
+                    delattr(simpleapi, name)
+
 if __name__ == '__main__':
     unittest.main()
@@ -27,13 +27,17 @@ private:
   void exec() override;
   double clarifyAngleStep(API::MatrixWorkspace const &ws);
   API::MatrixWorkspace_sptr convertToConstantL2(API::MatrixWorkspace_sptr &ws);
-  API::MatrixWorkspace_sptr convertToTwoTheta(API::MatrixWorkspace_sptr &ws);
-  API::MatrixWorkspace_sptr groupByTwoTheta(API::MatrixWorkspace_sptr &ws,
-                                            double const twoThetaStep);
-  API::MatrixWorkspace_sptr
-  maskEmptyBins(API::MatrixWorkspace_sptr &maskable,
-                API::MatrixWorkspace_sptr &comparison);
-  API::MatrixWorkspace_sptr rebinToNonRagged(API::MatrixWorkspace_sptr &ws);
+  boost::shared_ptr<API::Algorithm> convertToTwoTheta();
+  boost::shared_ptr<API::Algorithm>
+  generateGrouping(API::MatrixWorkspace_sptr &ws, double const twoThetaStep,
+                   std::string const &filename);
+  boost::shared_ptr<API::Algorithm>
+  groupByTwoTheta(std::string const &filename);
+  std::string groupingFilename();
+  boost::shared_ptr<API::Algorithm>
+  maskEmptyBins(API::MatrixWorkspace_sptr &comparison);
+  boost::shared_ptr<API::Algorithm>
+  rebinToNonRagged(API::MatrixWorkspace_sptr &ws);
 };
 
 } // namespace WorkflowAlgorithms
@@ -6,6 +6,7 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidWorkflowAlgorithms/SofTwoThetaTOF.h"
 
+#include "MantidAPI/DataflowExecutor.h"
 #include "MantidAPI/FileProperty.h"
 #include "MantidAPI/HistogramValidator.h"
 #include "MantidAPI/InstrumentValidator.h"
@@ -134,15 +135,35 @@ void SofTwoThetaTOF::init() {
                   "file wille be created as well.");
 }
 
-/** Execute the algorithm.
+/** Execute the algorithm. The grouping file is generated while the bins are
+ * made equal.
  */
 void SofTwoThetaTOF::exec() {
   API::MatrixWorkspace_sptr in = getProperty(Prop::INPUT_WS);
+  auto const angleStep = clarifyAngleStep(*in);
   auto ragged = convertToConstantL2(in);
-  auto equalBinning = rebinToNonRagged(ragged);
-  auto ws = maskEmptyBins(equalBinning, ragged);
-  ws = groupByTwoTheta(ws, clarifyAngleStep(*in));
-  ws = convertToTwoTheta(ws);
+  auto const filename = groupingFilename();
+  RemoveFileAtScopeExit deleteThisLater;
+  if (isDefault(Prop::FILENAME)) {
+    // Make sure the temporary file gets deleted at scope exit.
+    deleteThisLater.name = filename;
+  }
+
+  API::DataflowExecutor graph;
+  auto const rebin = graph.add(rebinToNonRagged(ragged));
+  auto const mask = graph.add(maskEmptyBins(ragged));
+  graph.connect(rebin, "OutputWorkspace", mask, "InputWorkspace");
+  auto const generate =
+      graph.add(generateGrouping(ragged, angleStep, filename));
+  auto const group = graph.add(groupByTwoTheta(filename));
+  graph.connect(mask, "OutputWorkspace", group, "InputWorkspace");
+  graph.addDependency(group, generate);
+  auto const convert = graph.add(convertToTwoTheta());
+  graph.connect(group, "OutputWorkspace", convert, "InputWorkspace");
+  executeDataflow(graph);
+
+  API::MatrixWorkspace_sptr ws =
+      graph.algorithm(convert)->getProperty("OutputWorkspace");
   setProperty(Prop::OUTPUT_WS, ws);
 }
 
@@ -175,25 +196,39 @@ SofTwoThetaTOF::convertToConstantL2(API::MatrixWorkspace_sptr &ws) {
   return toConstantL2->getProperty("OutputWorkspace");
 }
 
-API::MatrixWorkspace_sptr
-SofTwoThetaTOF::convertToTwoTheta(API::MatrixWorkspace_sptr &ws) {
+boost::shared_ptr<API::Algorithm> SofTwoThetaTOF::convertToTwoTheta() {
   auto convertAxis = createChildAlgorithm("ConvertSpectrumAxis", 0.9, 1.0);
-  convertAxis->setProperty("InputWorkspace", ws);
   convertAxis->setProperty("OutputWorkspace", "out");
   convertAxis->setProperty("Target", "Theta");
-  convertAxis->execute();
-  return convertAxis->getProperty("OutputWorkspace");
+  return convertAxis;
 }
 
-API::MatrixWorkspace_sptr
-SofTwoThetaTOF::groupByTwoTheta(API::MatrixWorkspace_sptr &ws,
-                                double const twoThetaStep) {
+boost::shared_ptr<API::Algorithm>
+SofTwoThetaTOF::generateGrouping(API::MatrixWorkspace_sptr &ws,
+                                 double const twoThetaStep,
+                                 std::string const &filename) {
   auto generateGrouping =
       createChildAlgorithm("GenerateGroupingPowder", 0.2, 0.5);
   generateGrouping->setProperty("InputWorkspace", ws);
   generateGrouping->setProperty("AngleStep", twoThetaStep);
+  if (isDefault(Prop::FILENAME)) {
+    generateGrouping->setProperty("GenerateParFile", false);
+  }
+  generateGrouping->setProperty("GroupingFilename", filename);
+  return generateGrouping;
+}
+
+boost::shared_ptr<API::Algorithm>
+SofTwoThetaTOF::groupByTwoTheta(std::string const &filename) {
+  auto groupDetectors = createChildAlgorithm("GroupDetectors", 0.7, 0.9);
+  groupDetectors->setProperty("OutputWorkspace", "out");
+  groupDetectors->setProperty("MapFile", filename);
+  groupDetectors->setProperty("Behaviour", "Average");
+  return groupDetectors;
+}
+
+std::string SofTwoThetaTOF::groupingFilename() {
   std::string filename;
-  RemoveFileAtScopeExit deleteThisLater;
   if (isDefault(Prop::FILENAME)) {
     auto tempPath = boost::filesystem::temp_directory_path();
     tempPath /= boost::filesystem::unique_path(
@@ -205,40 +240,26 @@ SofTwoThetaTOF::groupByTwoTheta(API::MatrixWorkspace_sptr &ws,
 #else
     filename = tempPath.native();
 #endif
-    generateGrouping->setProperty("GenerateParFile", false);
-    // Make sure the file gets deleted at scope exit.
-    deleteThisLater.name = filename;
   } else {
     filename = static_cast<std::string>(getProperty(Prop::FILENAME));
     filename = ensureXMLExtension(filename);
   }
-  generateGrouping->setProperty("GroupingFilename", filename);
-  generateGrouping->execute();
-  auto groupDetectors = createChildAlgorithm("GroupDetectors", 0.7, 0.9);
-  groupDetectors->setProperty("InputWorkspace", ws);
-  groupDetectors->setProperty("OutputWorkspace", "out");
-  groupDetectors->setProperty("MapFile", filename);
-  groupDetectors->setProperty("Behaviour", "Average");
-  groupDetectors->execute();
-  return groupDetectors->getProperty("OutputWorkspace");
+  return filename;
 }
 
-API::MatrixWorkspace_sptr
-SofTwoThetaTOF::maskEmptyBins(API::MatrixWorkspace_sptr &maskable,
-                              API::MatrixWorkspace_sptr &comparison) {
+boost::shared_ptr<API::Algorithm>
+SofTwoThetaTOF::maskEmptyBins(API::MatrixWorkspace_sptr &comparison) {
   auto maskNonOverlapping =
       createChildAlgorithm("MaskNonOverlappingBins", 0.6, 0.7);
-  maskNonOverlapping->setProperty("InputWorkspace", maskable);
   maskNonOverlapping->setProperty("OutputWorkspace", "out");
   maskNonOverlapping->setProperty("ComparisonWorkspace", comparison);
   maskNonOverlapping->setProperty("MaskPartiallyOverlapping", true);
   maskNonOverlapping->setProperty("RaggedInputs", "Ragged");
   maskNonOverlapping->setProperty("CheckSortedX", false);
-  maskNonOverlapping->execute();
-  return maskNonOverlapping->getProperty("OutputWorkspace");
+  return maskNonOverlapping;
 }
 
-API::MatrixWorkspace_sptr
+boost::shared_ptr<API::Algorithm>
 SofTwoThetaTOF::rebinToNonRagged(API::MatrixWorkspace_sptr &ws) {
   auto const xRange = minMaxX(*ws);
   std::vector<double> const rebinParams{xRange.min, binWidth(*ws), xRange.max};
@@ -247,8 +268,7 @@ SofTwoThetaTOF::rebinToNonRagged(API::MatrixWorkspace_sptr &ws) {
   rebin->setProperty("OutputWorkspace", "out");
   rebin->setProperty("Params", rebinParams);
   rebin->setProperty("FullBinsOnly", true);
-  rebin->execute();
-  return rebin->getProperty("OutputWorkspace");
+  return rebin;
 }
 
 } // namespace WorkflowAlgorithms
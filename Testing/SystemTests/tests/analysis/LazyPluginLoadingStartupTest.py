@@ -0,0 +1,68 @@
+# Mantid Repository : https://github.com/mantidproject/mantid
+#
+# Copyright &copy; 2019 ISIS Rutherford Appleton Laboratory UKRI,
+#     NScD Oak Ridge National Laboratory, European Spallation Source
+#     & Institut Laue - Langevin
+# SPDX - License - Identifier: GPL - 3.0 +
+from __future__ import (absolute_import, division, print_function)
+import os
+import subprocess
+import sys
+import systemtesting
+import mantid
+
+# Imports the simple API, which starts the framework, and runs one algorithm.
+# Prints the time taken.
+STARTUP_SCRIPT = '''
+import time
+start = time.time()
+from mantid.simpleapi import CreateSingleValuedWorkspace
+CreateSingleValuedWorkspace(DataValue=1.0, StoreInADS=False)
+print("STARTUP_SECONDS", time.time() - start)
+'''
+
+REPEATS = 3
+
+
+class LazyPluginLoadingStartupTest(systemtesting.MantidSystemTest):
+    '''Benchmarks the cold start of a fresh Python process with the plugin
+    libraries opened at start up and with them opened when first used,
+    framework.plugins.lazy = 1. The median time of each is reported.
+    '''
+
+    def __init__(self):
+        super(LazyPluginLoadingStartupTest, self).__init__()
+        self.save_dir = mantid.config.getString('defaultsave.directory')
+        self.properties = os.path.join(self.save_dir, 'LazyPluginLoadingStartupTest.properties')
+        self.manifest = os.path.join(mantid.config.getUserPropertiesDir(), 'PluginManifest.txt')
+
+    def cleanup(self):
+        if os.path.exists(self.properties):
+            os.remove(self.properties)
+
+    def runTest(self):
+        eager = self._median_startup(lazy=False)
+        # The first lazy start records what each library registers
+        self._startup(lazy=True)
+        self.assertTrue(os.path.exists(self.manifest))
+        lazy = self._median_startup(lazy=True)
+        print('Cold start with plugins opened at start up: {0:.3f} s'.format(eager))
+        print('Cold start with plugins opened when used: {0:.3f} s'.format(lazy))
+        self.assertLessThan(lazy, eager, 'Opening plugins when used did not speed up start up')
+
+    def _median_startup(self, lazy):
+        times = sorted(self._startup(lazy) for _ in range(REPEATS))
+        return times[len(times) // 2]
+
+    def _startup(self, lazy):
+        with open(self.properties, 'w') as f:
+            f.write('framework.plugins.lazy = {0}\n'.format(1 if lazy else 0))
+        env = dict(os.environ, MANTIDPROPERTIES=self.properties)
+        p = subprocess.Popen([sys.executable, '-c', STARTUP_SCRIPT], env=env,
+                             stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+        out, err = p.communicate()
+        self.assertEqual(p.returncode, 0, err)
+        for line in out.decode().splitlines():
+            if line.startswith('STARTUP_SECONDS'):
+                return float(line.split()[1])
+        self.fail('No start up time reported: ' + out.decode())